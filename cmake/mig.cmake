@@ -85,6 +85,29 @@ function(mig defFileName)
 				"-I" "${CMAKE_SOURCE_DIR}/src/xtrace/include"
 				"-Wno-extern-initializer")
 			install(TARGETS ${bareName}_xtrace_mig DESTINATION "libexec/darling/usr/lib/darling/xtrace-mig/")
+			set_property(GLOBAL APPEND PROPERTY XTRACE_MIG_TARGETS ${bareName}_xtrace_mig)
 		endif (NOT TARGET ${bareName}_xtrace_mig AND NOT MIG_NO_XTRACE)
 	endforeach()
 endfunction(mig)
+
+# Generates the index of all xtrace-mig subsystems that libxtrace maps instead of loading each of them;
+# has to be called once every mig() call has been made.
+# The index records the size and mtime of each dylib, which install() preserves.
+function(xtrace_mig_index)
+	get_property(targets GLOBAL PROPERTY XTRACE_MIG_TARGETS)
+	set(index "${CMAKE_BINARY_DIR}/src/xtrace/xtrace-mig.index")
+
+	set(files "")
+	foreach (target ${targets})
+		list(APPEND files "$<TARGET_FILE:${target}>")
+	endforeach (target)
+
+	add_custom_command(OUTPUT ${index}
+		COMMAND $<TARGET_FILE:xtrace-mig-index> ${index} ${files}
+		DEPENDS xtrace-mig-index ${targets}
+		COMMENT "Generating the xtrace MIG index"
+	)
+	add_custom_target(xtrace_mig_index ALL DEPENDS ${index})
+
+	install(FILES ${index} DESTINATION "libexec/darling/usr/lib/darling")
+endfunction(xtrace_mig_index)
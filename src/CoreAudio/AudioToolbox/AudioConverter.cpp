@@ -22,6 +22,7 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #include <CarbonCore/MacErrors.h>
 #include <stdexcept>
 #include <cstring>
+#include <algorithm>
 
 OSStatus AudioConverterNew(const AudioStreamBasicDescription* inSourceFormat, const AudioStreamBasicDescription* inDestinationFormat, AudioConverterRef* outAudioConverter)
 {
@@ -97,20 +98,29 @@ OSStatus AudioConverterConvertComplexBuffer(AudioConverterRef inAudioConverter,
 {
 	OSStatus status;
 	UInt32 dataPacketSize;
-	int64_t totalOutBytes = 0;
+	__block bool supplied = false;
 	typedef OSStatus (^CallbackBlock)(AudioConverterRef audioConverter, UInt32* numberDataPackets, AudioBufferList* data, AudioStreamPacketDescription** dataPacketDescription);
 	
 	CallbackBlock callbackBlock =
 		^ OSStatus (AudioConverterRef audioConverter, UInt32* numberDataPackets, AudioBufferList* data, AudioStreamPacketDescription** dataPacketDescription)
 	{
-		const AudioBufferList *inInputData = (AudioBufferList*) inInputData;
-
 		if (dataPacketDescription)
 			*dataPacketDescription = nullptr;
-		
-		// TODO
 
-		return unimpErr;
+		// The whole input is handed over at once, after that we're at the end of the stream
+		if (supplied)
+		{
+			*numberDataPackets = 0;
+			return noErr;
+		}
+		supplied = true;
+
+		const UInt32 count = std::min(data->mNumberBuffers, inInputData->mNumberBuffers);
+		for (UInt32 i = 0; i < count; i++)
+			data->mBuffers[i] = inInputData->mBuffers[i];
+
+		*numberDataPackets = inNumberPCMFrames;
+		return noErr;
 	};
 
 	// Squeezing a block through a function pointer
@@ -120,11 +130,9 @@ OSStatus AudioConverterConvertComplexBuffer(AudioConverterRef inAudioConverter,
 		return callbackBlock(audioConverter, numberDataPackets, data, dataPacketDescription);
 	};
 
-	for (UInt32 i = 0; i < outOutputData->mNumberBuffers; i++)
-		totalOutBytes += outOutputData->mBuffers[i].mDataByteSize;
-
-	dataPacketSize = totalOutBytes / ((AudioConverter*)inAudioConverter)->frameSize();
+	// This call doesn't do sample rate conversion, so there are as many frames out as there are in
+	dataPacketSize = inNumberPCMFrames;
 
-	status = AudioConverterFillComplexBuffer(inAudioConverter, proc, (void*) inInputData, &dataPacketSize, outOutputData, nullptr);
+	status = AudioConverterFillComplexBuffer(inAudioConverter, proc, (void*) callbackBlock, &dataPacketSize, outOutputData, nullptr);
 	return status;
 }
@@ -34,6 +34,9 @@ extern "C" {
 
 static constexpr int ENCODER_FRAME_SAMPLES = 1024;
 
+// How many encoder frames fit in the resampler output buffer
+static constexpr int PREBUF_ENCODER_FRAMES = 4;
+
 // http://blinkingblip.wordpress.com/
 
 static void throwFFMPEGError(int errnum, const char* function)
@@ -54,21 +57,42 @@ AudioConverter::AudioConverter(const AudioStreamBasicDescription* inSourceFormat
 {
 	memset(&m_avpkt, 0, sizeof(m_avpkt));
 	memset(&m_avpktOut, 0, sizeof(m_avpktOut));
+
+#ifdef HAVE_AV_FRAME_ALLOC
+	m_decodedFrame = av_frame_alloc();
+#else
+	m_decodedFrame = avcodec_alloc_frame();
+#endif
+	if (!m_decodedFrame)
+		throw std::bad_alloc();
 }
 
 void AudioConverter::flush()
 {
 	TRACE();
+	if (m_pcm)
+	{
+		m_pcm->reset();
+		return;
+	}
 	avcodec_flush_buffers(m_decoder);
 	avcodec_flush_buffers(m_encoder);
+	m_audioFramePrebuf.clear();
 	//avcodec_close(m_encoder);
 }
 
 OSStatus AudioConverter::create(const AudioStreamBasicDescription* inSourceFormat, const AudioStreamBasicDescription* inDestinationFormat, AudioConverter** out)
 {
 	TRACE2(inSourceFormat, inDestinationFormat);
-	
-	// TODO: non-interleaved audio
+
+	// PCM format changes (including non-interleaved audio) are done natively;
+	// only compressed formats go through libavcodec, which needs interleaved audio
+	if (PCMConverter::canConvert(inSourceFormat, inDestinationFormat))
+	{
+		*out = new AudioConverter(inSourceFormat, inDestinationFormat);
+		(*out)->m_pcm.reset(new PCMConverter(*inSourceFormat, *inDestinationFormat));
+		return noErr;
+	}
 
 	const AVCodec *codecIn, *codecOut;
 	AVCodecContext *cIn;
@@ -181,31 +205,23 @@ void AudioConverter::allocateBuffers()
 #if LIBAVCODEC_VERSION_MAJOR >= 61
 	m_audioFrame->ch_layout.order = m_encoder->ch_layout.order;
 	m_audioFrame->ch_layout.nb_channels = m_encoder->ch_layout.nb_channels;
-	int audioSampleBuffer_size = av_samples_get_buffer_size(nullptr, m_encoder->ch_layout.nb_channels, m_audioFrame->nb_samples, m_encoder->sample_fmt, 0);
 #else
 	m_audioFrame->channel_layout = m_encoder->channel_layout;
-	int audioSampleBuffer_size = av_samples_get_buffer_size(nullptr, m_encoder->channels, m_audioFrame->nb_samples, m_encoder->sample_fmt, 0);
+	m_audioFrame->channels = m_encoder->channels;
 #endif
-	void* audioSampleBuffer = (uint8_t*) av_malloc(audioSampleBuffer_size);
-
-	if (!audioSampleBuffer)
-	{
-		std::cerr << "AudioConverter::allocateBuffers(): Failed to allocate sample buffer\n";
-		throw std::runtime_error("AudioConverter::allocateBuffers(): Failed to allocate sample buffer");
-	}
 
-	// Setup the data pointers in the AVFrame
-#if LIBAVCODEC_VERSION_MAJOR >= 61
-	if (int err = avcodec_fill_audio_frame(m_audioFrame, m_encoder->ch_layout.nb_channels, m_encoder->sample_fmt,
-		(const uint8_t*) audioSampleBuffer, audioSampleBuffer_size, 0 ); err < 0)
-#else
-	if (int err = avcodec_fill_audio_frame(m_audioFrame, m_encoder->channels, m_encoder->sample_fmt,
-		(const uint8_t*) audioSampleBuffer, audioSampleBuffer_size, 0 ); err < 0)
-#endif
+	// A reference-counted buffer (rather than one we'd point the frame at) lets the encoder take a reference
+	// instead of copying the samples into a new buffer every time
+	if (int err = av_frame_get_buffer(m_audioFrame, 0); err < 0)
 	{
 		std::cerr << "AudioConverter::allocateBuffers(): Could not set up audio frame\n";
-		throw std::runtime_error("AudioConverter::allocateBuffers(): Could not set up audio frame");
+		throwFFMPEGError(err, "av_frame_get_buffer()");
 	}
+
+	const size_t bytesPerFrame = m_destinationFormat.mChannelsPerFrame * av_get_bytes_per_sample(m_encoder->sample_fmt);
+
+	m_audioFramePrebuf.reserve(bytesPerFrame * ENCODER_FRAME_SAMPLES * PREBUF_ENCODER_FRAMES);
+	m_straddleFrame.reset(new uint8_t[bytesPerFrame]);
 }
 
 AudioConverter::~AudioConverter()
@@ -215,8 +231,14 @@ AudioConverter::~AudioConverter()
 		avcodec_close(m_decoder);
 	if (m_encoder)
 		avcodec_close(m_encoder);
-	if (m_audioFrame)
-		av_free(m_audioFrame);
+#ifdef HAVE_AV_FRAME_ALLOC
+	av_frame_free(&m_audioFrame);
+	av_frame_free(&m_decodedFrame);
+#else
+	avcodec_free_frame(&m_audioFrame);
+	avcodec_free_frame(&m_decodedFrame);
+#endif
+	av_packet_unref(&m_avpktOut);
 	if (m_resampler)
 		swr_free(&m_resampler);
 }
@@ -240,6 +262,32 @@ OSStatus AudioConverter::setProperty(AudioConverterPropertyID inPropertyID, UInt
 		{
 			return setPropertyT(inPropertyDataSize, &m_outBitRate, inPropertyData);
 		}
+		case kAudioConverterPropertyDithering:
+		case kAudioConverterPropertyDitherBitDepth:
+		case kAudioConverterSampleRateConverterQuality:
+		{
+			UInt32 value;
+
+			if (!m_pcm)
+				return kAudioConverterErr_PropertyNotSupported;
+			if (OSStatus err = setPropertyT(inPropertyDataSize, &value, inPropertyData); err != noErr)
+				return err;
+
+			if (inPropertyID == kAudioConverterPropertyDithering)
+				return m_pcm->setDithering(value);
+			else if (inPropertyID == kAudioConverterPropertyDitherBitDepth)
+				return m_pcm->setDitherBitDepth(value);
+			else
+				return m_pcm->setQuality(value);
+		}
+		case kAudioConverterChannelMap:
+		{
+			if (!m_pcm)
+				return kAudioConverterErr_PropertyNotSupported;
+			if (inPropertyDataSize % sizeof(SInt32))
+				return kAudioConverterErr_BadPropertySizeError;
+			return m_pcm->setChannelMap(static_cast<const SInt32*>(inPropertyData), inPropertyDataSize / sizeof(SInt32));
+		}
 		case kAudioConverterInputChannelLayout:
 		{
 		}
@@ -300,6 +348,36 @@ OSStatus AudioConverter::getProperty(AudioConverterPropertyID inPropertyID, UInt
 		{
 			return getPropertyT(ioPropertyDataSize, &m_destinationFormat, outPropertyData);
 		}
+		case kAudioConverterPropertyDithering:
+		case kAudioConverterPropertyDitherBitDepth:
+		case kAudioConverterSampleRateConverterQuality:
+		{
+			if (!m_pcm)
+				return kAudioConverterErr_PropertyNotSupported;
+
+			UInt32 value;
+			if (inPropertyID == kAudioConverterPropertyDithering)
+				value = m_pcm->dithering();
+			else if (inPropertyID == kAudioConverterPropertyDitherBitDepth)
+				value = m_pcm->ditherBitDepth();
+			else
+				value = m_pcm->quality();
+
+			return getPropertyT(ioPropertyDataSize, &value, outPropertyData);
+		}
+		case kAudioConverterChannelMap:
+		{
+			const UInt32 size = m_destinationFormat.mChannelsPerFrame * sizeof(SInt32);
+
+			if (!m_pcm)
+				return kAudioConverterErr_PropertyNotSupported;
+			if (*ioPropertyDataSize < size)
+				return kAudioConverterErr_BadPropertySizeError;
+
+			*ioPropertyDataSize = size;
+			m_pcm->getChannelMap(static_cast<SInt32*>(outPropertyData));
+			return noErr;
+		}
 		default:
 		{
 			STUB();
@@ -369,16 +447,9 @@ void AudioConverter::setupResampler(const AVFrame* frame)
 OSStatus AudioConverter::fillComplex(AudioConverterComplexInputDataProc dataProc, void* opaque,
 	UInt32* ioOutputDataPacketSize, AudioBufferList *outOutputData, AudioStreamPacketDescription* outPacketDescription)
 {
-	AVFrame* srcaudio;
+	if (m_pcm)
+		return m_pcm->fillComplex(AudioConverterRef(this), dataProc, opaque, ioOutputDataPacketSize, outOutputData);
 
-#ifdef HAVE_AV_FRAME_ALLOC
-	srcaudio = av_frame_alloc();
-	av_frame_unref(srcaudio);
-#else
-	srcaudio = avcodec_alloc_frame();
-	avcodec_get_frame_defaults(srcaudio);
-#endif
-	
 	try
 	{
 		for (uint32_t i = 0; i < outOutputData->mNumberBuffers; i++)
@@ -413,38 +484,23 @@ OSStatus AudioConverter::fillComplex(AudioConverterComplexInputDataProc dataProc
 				{
 					while (!feedEncoder())
 					{
-						if (!feedDecoder(dataProc, opaque, srcaudio))
+						if (!feedDecoder(dataProc, opaque, m_decodedFrame))
 							goto end;
 					}
 				}
 			}
 		}
 end:
-		
-#ifdef HAVE_AV_FRAME_ALLOC
-		av_frame_free(&srcaudio);
-#else
-		avcodec_free_frame(&srcaudio);
-#endif
+		;
 	}
 	catch (const std::exception& e)
 	{
 		std::cerr << "AudioConverter::fillComplex(): Exception: " << e.what();
-#ifdef HAVE_AV_FRAME_ALLOC
-		av_frame_free(&srcaudio);
-#else
-		avcodec_free_frame(&srcaudio);
-#endif
 		return ioErr;
 	}
 	catch (OSStatus err)
 	{
 		std::cerr << "AudioConverter::fillComplex(): OSStatus error: " << err;
-#ifdef HAVE_AV_FRAME_ALLOC
-		av_frame_free(&srcaudio);
-#else
-		avcodec_free_frame(&srcaudio);
-#endif
 		return err;
 	}
 	
@@ -537,8 +593,6 @@ bool AudioConverter::feedDecoder(AudioConverterComplexInputDataProc dataProc, vo
 bool AudioConverter::feedEncoder()
 {
 	int gotFrame = 0, err;
-	uint8_t *output;
-	int out_linesize;
 	int avail;
 
 	if (!m_resampler)
@@ -549,28 +603,39 @@ bool AudioConverter::feedEncoder()
 	
 	assert(m_avpktOutUsed == m_avpktOut.size);
 
-	const size_t bytesPerSample = m_destinationFormat.mBitsPerChannel / 8;
+	const size_t bytesPerSample = av_get_bytes_per_sample(m_targetFormat);
 	const size_t bytesPerFrame = m_destinationFormat.mChannelsPerFrame * bytesPerSample;
 	const size_t requiredBytes = bytesPerFrame * ENCODER_FRAME_SAMPLES;
 
-	while (m_audioFramePrebuf.size() < requiredBytes && (avail = swr_get_out_samples(m_resampler, 0)) > 0)
+	// Resample straight into the ring buffer; whatever doesn't fit stays buffered in the resampler
+	while (m_audioFramePrebuf.size() < requiredBytes && m_audioFramePrebuf.space() >= bytesPerFrame
+		&& swr_get_out_samples(m_resampler, 0) > 0)
 	{
-		av_samples_alloc(&output, &out_linesize, m_destinationFormat.mChannelsPerFrame,
-			avail, m_encoder->sample_fmt, 0);
+		size_t spanBytes;
+		uint8_t* output = m_audioFramePrebuf.writeSpan(spanBytes);
+		int frames = spanBytes / bytesPerFrame;
 
-		if ((avail = swr_convert(m_resampler, &output, avail, nullptr, 0)) < 0)
+		if (frames == 0)
 		{
-			av_freep(&output);
-			throwFFMPEGError(err, "swr_convert()");
+			// the free space wraps around in the middle of a frame
+			output = m_straddleFrame.get();
+			frames = 1;
 		}
 
+		if ((avail = swr_convert(m_resampler, &output, frames, nullptr, 0)) < 0)
+			throwFFMPEGError(avail, "swr_convert()");
+		if (avail == 0)
+			break;
+
 #ifdef DEBUG_AUDIOCONVERTER
 		m_resamplerOutput.write((char*) output, avail * bytesPerFrame);
 		m_resamplerOutput.flush();
 #endif
 
-		m_audioFramePrebuf.push(output, avail * bytesPerFrame);
-		av_freep(&output);
+		if (output == m_straddleFrame.get())
+			m_audioFramePrebuf.push(output, avail * bytesPerFrame);
+		else
+			m_audioFramePrebuf.commit(avail * bytesPerFrame);
 	}
 
 	av_init_packet(&m_avpktOut);
@@ -582,11 +647,12 @@ bool AudioConverter::feedEncoder()
 	{
 		try
 		{
-			err = avcodec_fill_audio_frame(m_audioFrame, m_destinationFormat.mChannelsPerFrame,
-					m_targetFormat, m_audioFramePrebuf.data(), requiredBytes, 0);
-			
+			// The encoder may still hold a reference to the previous frame's buffer; if it does, this is the only case where we allocate
+			err = av_frame_make_writable(m_audioFrame);
 			if (err < 0)
-				throwFFMPEGError(err, "avcodec_fill_audio_frame()");
+				throwFFMPEGError(err, "av_frame_make_writable()");
+
+			m_audioFramePrebuf.peek(m_audioFrame->data[0], requiredBytes);
 
 #if 0
 			err = avcodec_encode_audio2(m_encoder, &m_avpktOut, m_audioFrame, &gotFrame);
@@ -607,7 +673,7 @@ bool AudioConverter::feedEncoder()
 				}
 			}
 
-			err = avcodec_receive_packet(m_encoder, &m_avpkt);
+			err = avcodec_receive_packet(m_encoder, &m_avpktOut);
 
 			if (err < 0) {
 				gotFrame = false;
@@ -2,8 +2,10 @@
 #define AUDIOCONVERTERINTERNAL_H
 #include "AudioConverter.h"
 #include "ConsumableBuffer.h"
+#include "PCMConverter.h"
 #include <stdint.h>
 #include <fstream>
+#include <memory>
 
 extern "C" {
 #include <libswresample/swresample.h>
@@ -43,6 +45,8 @@ private:
 	bool feedEncoder();
 private:
 	AudioStreamBasicDescription m_sourceFormat, m_destinationFormat;
+	// Set for PCM to PCM conversions, which don't use libavcodec at all
+	std::unique_ptr<PCMConverter> m_pcm;
 	UInt32 m_inputChannelLayout, m_outputChannelLayout;
 	AVSampleFormat m_targetFormat;
 	AVCodecContext* m_decoder;
@@ -50,8 +54,13 @@ private:
 	AVPacket m_avpkt, m_avpktOut;
 	UInt32 m_avpktOutUsed = 0;
 
+	// Reused across fillComplex() calls, so that steady-state conversion doesn't allocate
+	AVFrame* m_decodedFrame = nullptr;
 	AVFrame* m_audioFrame = nullptr;
+	// Resampled audio waiting for the encoder, sized in allocateBuffers()
 	ConsumableBuffer m_audioFramePrebuf;
+	// Holds a resampled frame that would straddle the end of m_audioFramePrebuf
+	std::unique_ptr<uint8_t[]> m_straddleFrame;
 
 	SwrContext* m_resampler = nullptr;
 	UInt32 m_outBitRate = 128000;
@@ -102,3 +102,26 @@ OSStatus AudioQueueOfflineRender(AudioQueueRef inAQ, const AudioTimeStamp *inTim
 {
 	return inAQ->offlineRender(inTimestamp, ioBuffer, inNumberFrames);
 }
+
+OSStatus AudioQueueAllocateBuffer(AudioQueueRef inAQ, UInt32 inBufferByteSize, AudioQueueBufferRef *outBuffer)
+{
+	return inAQ->allocateBuffer(inBufferByteSize, 0, outBuffer);
+}
+
+OSStatus AudioQueueAllocateBufferWithPacketDescriptions(AudioQueueRef inAQ,
+		UInt32 inBufferByteSize, UInt32 inNumberPacketDescriptions,
+		AudioQueueBufferRef *outBuffer)
+{
+	return inAQ->allocateBuffer(inBufferByteSize, inNumberPacketDescriptions, outBuffer);
+}
+
+OSStatus AudioQueueFreeBuffer(AudioQueueRef inAQ, AudioQueueBufferRef inBuffer)
+{
+	return inAQ->freeBuffer(inBuffer);
+}
+
+OSStatus AudioQueueEnqueueBuffer(AudioQueueRef inAQ, AudioQueueBufferRef inBuffer,
+		UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs)
+{
+	return inAQ->enqueueBuffer(inBuffer, inNumPacketDescs, inPacketDescs);
+}
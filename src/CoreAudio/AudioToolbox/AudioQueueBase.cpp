@@ -1,19 +1,139 @@
 #include "AudioQueueBase.h"
 #include "stub.h"
 #include <CarbonCore/MacErrors.h>
+#include <new>
+#include <algorithm>
+#include <cstring>
 
 AudioQueue::AudioQueue(const AudioStreamBasicDescription* format, void* userData,
 			CFRunLoopRef runloop, CFStringRef runloopMode, UInt32 flags)
 : m_format(*format), m_userData(userData), m_flags(flags)
 {
-	m_runloop = (CFRunLoopRef) CFRetain(runloop);
-	m_runloopMode = (CFStringRef) CFRetain(runloopMode);
+	// A NULL run loop means callbacks are made on an internal thread
+	m_runloop = runloop ? (CFRunLoopRef) CFRetain(runloop) : nullptr;
+	m_runloopMode = (CFStringRef) CFRetain(runloopMode ? runloopMode : kCFRunLoopCommonModes);
 }
 
 AudioQueue::~AudioQueue()
 {
-	CFRelease(m_runloop);
+	if (m_runloop)
+		CFRelease(m_runloop);
 	CFRelease(m_runloopMode);
+
+	for (AudioQueueBufferImpl* buf : m_buffers)
+	{
+		buf->~AudioQueueBufferImpl();
+		free(buf);
+	}
+}
+
+OSStatus AudioQueue::allocateBuffer(UInt32 inBufferByteSize, UInt32 inNumberPacketDescriptions, AudioQueueBufferRef *outBuffer)
+{
+	if (!outBuffer)
+		return kAudioQueueErr_InvalidParameter;
+
+	// The audio data goes last and is 16-byte aligned for SIMD code
+	const size_t descOffset = sizeof(AudioQueueBufferImpl);
+	const size_t dataOffset = (descOffset + inNumberPacketDescriptions * sizeof(AudioStreamPacketDescription) + 15) & ~size_t(15);
+	void* mem;
+
+	if (posix_memalign(&mem, 16, dataOffset + inBufferByteSize) != 0)
+		return memFullErr;
+
+	uint8_t* base = static_cast<uint8_t*>(mem);
+	AudioQueueBufferImpl* buf = new (mem) AudioQueueBufferImpl(this, inBufferByteSize, base + dataOffset,
+		inNumberPacketDescriptions, inNumberPacketDescriptions ? reinterpret_cast<AudioStreamPacketDescription*>(base + descOffset) : nullptr);
+
+	{
+		std::lock_guard<std::mutex> guard(m_buffersMutex);
+		m_buffers.push_back(buf);
+	}
+
+	*outBuffer = &buf->buffer;
+	return noErr;
+}
+
+OSStatus AudioQueue::freeBuffer(AudioQueueBufferRef inBuffer)
+{
+	AudioQueueBufferImpl* buf = AudioQueueBufferImpl::fromRef(inBuffer);
+
+	if (!inBuffer || buf->owner != this)
+		return kAudioQueueErr_InvalidBuffer;
+	if (buf->enqueued.load())
+		return kAudioQueueErr_BufferInQueue;
+
+	{
+		std::lock_guard<std::mutex> guard(m_buffersMutex);
+		auto it = std::find(m_buffers.begin(), m_buffers.end(), buf);
+
+		if (it == m_buffers.end())
+			return kAudioQueueErr_InvalidBuffer;
+		m_buffers.erase(it);
+	}
+
+	buf->~AudioQueueBufferImpl();
+	free(buf);
+	return noErr;
+}
+
+OSStatus AudioQueue::enqueueBuffer(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs)
+{
+	STUB();
+	return unimpErr;
+}
+
+OSStatus AudioQueue::validateEnqueue(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs)
+{
+	AudioQueueBufferImpl* buf = AudioQueueBufferImpl::fromRef(inBuffer);
+
+	if (!inBuffer || buf->owner != this)
+		return kAudioQueueErr_InvalidBuffer;
+	if (inBuffer->mAudioDataByteSize > inBuffer->mAudioDataBytesCapacity)
+		return kAudioQueueErr_InvalidBuffer;
+
+	// VBR formats can't be played without packet descriptions
+	if (m_format.mBytesPerPacket == 0 && !inNumPacketDescs && !inBuffer->mPacketDescriptionCount)
+		return kAudioQueueErr_InvalidParameter;
+
+	if (buf->enqueued.exchange(true))
+		return kAudioQueueErr_BufferEnqueuedTwice;
+
+	if (inNumPacketDescs && inPacketDescs)
+	{
+		if (inPacketDescs == inBuffer->mPacketDescriptions)
+		{
+			buf->queuedDescriptions = inBuffer->mPacketDescriptions;
+		}
+		else if (inNumPacketDescs <= inBuffer->mPacketDescriptionCapacity)
+		{
+			memcpy(inBuffer->mPacketDescriptions, inPacketDescs, inNumPacketDescs * sizeof(*inPacketDescs));
+			buf->queuedDescriptions = inBuffer->mPacketDescriptions;
+		}
+		else
+		{
+			if (inNumPacketDescs > buf->extraDescriptionsCapacity)
+			{
+				void* mem = realloc(buf->extraDescriptions, inNumPacketDescs * sizeof(*inPacketDescs));
+				if (!mem)
+				{
+					buf->enqueued = false;
+					return memFullErr;
+				}
+				buf->extraDescriptions = static_cast<AudioStreamPacketDescription*>(mem);
+				buf->extraDescriptionsCapacity = inNumPacketDescs;
+			}
+			memcpy(buf->extraDescriptions, inPacketDescs, inNumPacketDescs * sizeof(*inPacketDescs));
+			buf->queuedDescriptions = buf->extraDescriptions;
+		}
+		buf->queuedDescriptionCount = inNumPacketDescs;
+	}
+	else
+	{
+		buf->queuedDescriptions = inBuffer->mPacketDescriptionCount ? inBuffer->mPacketDescriptions : nullptr;
+		buf->queuedDescriptionCount = inBuffer->mPacketDescriptionCount;
+	}
+
+	return noErr;
 }
 
 OSStatus AudioQueue::getParameter(AudioQueueParameterID inParamID, AudioQueueParameterValue *outValue)
@@ -1,6 +1,79 @@
 #ifndef AUDIOQUEUEBASE_H
 #define	AUDIOQUEUEBASE_H
 #include "AudioQueue.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdlib.h>
+
+class AudioQueue;
+
+// What AudioQueueAllocateBuffer() really allocates: the public AudioQueueBuffer, our bookkeeping,
+// then the packet descriptions and the audio data in the same block
+struct AudioQueueBufferImpl
+{
+	AudioQueueBuffer buffer;
+	AudioQueue* owner;
+	// link in whichever AudioQueueBufferStack (or render list) the buffer is currently on
+	AudioQueueBufferImpl* next = nullptr;
+	// between AudioQueueEnqueueBuffer() and the callback returning it to the client
+	std::atomic<bool> enqueued { false };
+
+	// The packet descriptions passed to AudioQueueEnqueueBuffer(), if there were more than mPacketDescriptionCapacity.
+	// Players commonly allocate buffers without room for them and pass their own.
+	AudioStreamPacketDescription* extraDescriptions = nullptr;
+	UInt32 extraDescriptionsCapacity = 0;
+	const AudioStreamPacketDescription* queuedDescriptions = nullptr;
+	UInt32 queuedDescriptionCount = 0;
+
+	AudioQueueBufferImpl(AudioQueue* owner, UInt32 capacity, void* data, UInt32 descriptionCapacity, AudioStreamPacketDescription* descriptions)
+	: buffer { capacity, data, 0, nullptr, descriptionCapacity, descriptions, 0 }, owner(owner)
+	{
+	}
+	~AudioQueueBufferImpl()
+	{
+		free(extraDescriptions);
+	}
+
+	static AudioQueueBufferImpl* fromRef(AudioQueueBufferRef ref) { return reinterpret_cast<AudioQueueBufferImpl*>(ref); }
+};
+
+// Lock-free list of buffers with any number of producers and a single consumer.
+// The consumer always takes the whole list, so there is no ABA problem.
+class AudioQueueBufferStack
+{
+public:
+	void push(AudioQueueBufferImpl* buf)
+	{
+		AudioQueueBufferImpl* head = m_head.load(std::memory_order_relaxed);
+		do
+			buf->next = head;
+		while (!m_head.compare_exchange_weak(head, buf, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// Takes everything pushed so far, oldest first
+	AudioQueueBufferImpl* takeAll()
+	{
+		AudioQueueBufferImpl* list = m_head.exchange(nullptr, std::memory_order_acquire);
+		AudioQueueBufferImpl* reversed = nullptr;
+
+		while (list)
+		{
+			AudioQueueBufferImpl* next = list->next;
+			list->next = reversed;
+			reversed = list;
+			list = next;
+		}
+		return reversed;
+	}
+
+	bool empty() const
+	{
+		return m_head.load(std::memory_order_relaxed) == nullptr;
+	}
+private:
+	std::atomic<AudioQueueBufferImpl*> m_head { nullptr };
+};
 
 class AudioQueue
 {
@@ -8,7 +81,7 @@ public:
 	AudioQueue(const AudioStreamBasicDescription* format, void* userData,
 			CFRunLoopRef runloop, CFStringRef runloopMode, UInt32 flags);
 	virtual ~AudioQueue();
-	
+
 	virtual OSStatus start(const AudioTimeStamp *inStartTime) = 0;
 	virtual OSStatus prime(UInt32 inNumberOfFramesToPrepare, UInt32 *outNumberOfFramesPrepared) = 0;
 	virtual OSStatus flush() = 0;
@@ -30,12 +103,23 @@ public:
 
 	virtual OSStatus setOfflineRenderFormat(const AudioStreamBasicDescription *inFormat, const AudioChannelLayout *inLayout) = 0;
 	virtual OSStatus offlineRender(const AudioTimeStamp *inTimestamp, AudioQueueBufferRef ioBuffer, UInt32 inNumberFrames) = 0;
+
+	OSStatus allocateBuffer(UInt32 inBufferByteSize, UInt32 inNumberPacketDescriptions, AudioQueueBufferRef *outBuffer);
+	OSStatus freeBuffer(AudioQueueBufferRef inBuffer);
+	virtual OSStatus enqueueBuffer(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs);
+protected:
+	// Checks that the buffer belongs to this queue and isn't enqueued yet
+	OSStatus validateEnqueue(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs);
 protected:
 	AudioStreamBasicDescription m_format;
 	void* m_userData;
 	CFRunLoopRef m_runloop;
 	CFStringRef m_runloopMode;
 	UInt32 m_flags;
+
+	// all buffers allocated on this queue, freed along with it
+	std::mutex m_buffersMutex;
+	std::vector<AudioQueueBufferImpl*> m_buffers;
 };
 
 #endif	/* AUDIOQUEUEBASE_H */
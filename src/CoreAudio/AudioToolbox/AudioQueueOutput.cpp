@@ -1,6 +1,30 @@
 #include "AudioQueueOutput.h"
+#include "AudioFormat.h"
 #include "stub.h"
 #include <CarbonCore/MacErrors.h>
+#include <algorithm>
+#include <cstring>
+
+// Identifies the private callback queue in dispatch_get_specific()
+static char kCallbackQueueKey;
+
+// What we ask the output device for: the queue's rate and channels as native float,
+// so that the only conversion left to the sound server is resampling to the hardware rate, if any
+static AudioStreamBasicDescription deviceFormatFor(const AudioStreamBasicDescription& format)
+{
+	AudioStreamBasicDescription desc;
+
+	memset(&desc, 0, sizeof(desc));
+	desc.mSampleRate = format.mSampleRate;
+	desc.mFormatID = kAudioFormatLinearPCM;
+	desc.mFormatFlags = kAudioFormatFlagsNativeFloatPacked;
+	desc.mChannelsPerFrame = format.mChannelsPerFrame;
+	desc.mBitsPerChannel = 32;
+	desc.mFramesPerPacket = 1;
+	desc.mBytesPerFrame = desc.mBytesPerPacket = desc.mChannelsPerFrame * sizeof(float);
+
+	return desc;
+}
 
 AudioQueueOutput::AudioQueueOutput(const AudioStreamBasicDescription *inFormat,
 		AudioQueueOutputCallback inCallbackProc,
@@ -9,74 +33,637 @@ AudioQueueOutput::AudioQueueOutput(const AudioStreamBasicDescription *inFormat,
 : AudioQueue(inFormat, inUserData, inCallbackRunLoop, inCallbackRunLoopMode, inFlags),
 		m_callback(inCallbackProc)
 {
-	
+	memset(&m_renderFormat, 0, sizeof(m_renderFormat));
+	memset(&m_packetDescription, 0, sizeof(m_packetDescription));
+
+	if (m_runloop)
+	{
+		CFRunLoopSourceContext context;
+
+		memset(&context, 0, sizeof(context));
+		context.info = this;
+		context.perform = performCallbacks;
+
+		m_callbackSource = CFRunLoopSourceCreate(kCFAllocatorDefault, 0, &context);
+		CFRunLoopAddSource(m_runloop, m_callbackSource, m_runloopMode);
+	}
+	else
+	{
+		m_callbackQueue = dispatch_queue_create("org.darlinghq.AudioQueue.callbacks", DISPATCH_QUEUE_SERIAL);
+		dispatch_queue_set_specific(m_callbackQueue, &kCallbackQueueKey, this, nullptr);
+	}
 }
 
 AudioQueueOutput::~AudioQueueOutput()
 {
-	
+	stopDevice();
+	if (m_ioProcID)
+		AudioDeviceDestroyIOProcID(m_device, m_ioProcID);
+	if (m_converter)
+		AudioConverterDispose(m_converter);
+
+	if (m_callbackSource)
+	{
+		CFRunLoopSourceInvalidate(m_callbackSource);
+		CFRelease(m_callbackSource);
+	}
+	if (m_callbackQueue)
+	{
+		// Let callbacks that are already scheduled finish before the queue goes away
+		if (!onCallbackThread())
+			dispatch_sync_f(m_callbackQueue, nullptr, [](void*) {});
+		dispatch_release(m_callbackQueue);
+	}
+}
+
+OSStatus AudioQueueOutput::setupConverter(const AudioStreamBasicDescription& renderFormat)
+{
+	if (m_converter)
+	{
+		if (memcmp(&renderFormat, &m_renderFormat, sizeof(renderFormat)) == 0)
+			return noErr;
+
+		AudioConverterDispose(m_converter);
+		m_converter = nullptr;
+	}
+
+	OSStatus err = AudioConverterNew(&m_format, &renderFormat, &m_converter);
+	if (err != noErr)
+	{
+		m_converter = nullptr;
+		return err;
+	}
+
+	m_renderFormat = renderFormat;
+	return noErr;
+}
+
+OSStatus AudioQueueOutput::startDevice()
+{
+	OSStatus err;
+
+	if (m_deviceRunning)
+		return noErr;
+
+	if (m_device == kAudioDeviceUnknown)
+	{
+		UInt32 size = sizeof(m_device);
+
+		err = AudioHardwareGetProperty(kAudioHardwarePropertyDefaultOutputDevice, &size, &m_device);
+		if (err != noErr || m_device == kAudioDeviceUnknown)
+			return kAudioQueueErr_InvalidDevice;
+	}
+
+	const AudioStreamBasicDescription desc = deviceFormatFor(m_format);
+
+	err = AudioDeviceSetProperty(m_device, nullptr, 0, false, kAudioDevicePropertyStreamFormat, sizeof(desc), &desc);
+	if (err != noErr)
+		return kAudioQueueErr_CannotStart;
+
+	err = setupConverter(desc);
+	if (err != noErr)
+		return err;
+
+	if (!m_ioProcID)
+	{
+		err = AudioDeviceCreateIOProcID(m_device, deviceIOProc, this, &m_ioProcID);
+		if (err != noErr)
+			return kAudioQueueErr_CannotStart;
+	}
+
+	err = AudioDeviceStart(m_device, m_ioProcID);
+	if (err != noErr)
+		return kAudioQueueErr_CannotStart;
+
+	m_deviceRunning = true;
+	return noErr;
+}
+
+void AudioQueueOutput::stopDevice()
+{
+	// Once this returns, the IO proc isn't running and won't be called again
+	if (m_deviceRunning)
+	{
+		AudioDeviceStop(m_device, m_ioProcID);
+		m_deviceRunning = false;
+	}
 }
 
 OSStatus AudioQueueOutput::start(const AudioTimeStamp *inStartTime)
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+
+	if (m_disposePending)
+		return kAudioQueueErr_DisposalPending;
+	if (m_running && !m_paused && !m_stopRequested)
+		return noErr;
+
+	// TODO: inStartTime
+	m_stopRequested = false;
+	m_finished = false;
+
+	if (!m_offline)
+	{
+		OSStatus err = startDevice();
+		if (err != noErr)
+			return err;
+	}
+
+	m_running = true;
+	m_paused = false;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::prime(UInt32 inNumberOfFramesToPrepare, UInt32 *outNumberOfFramesPrepared)
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+	UInt64 frames = 0;
+
+	// Buffers are converted as they are played, so all there is to do here is to report
+	// how much audio is waiting. While the device is playing, the render state isn't ours to look at.
+	if (!m_deviceRunning)
+	{
+		if (!m_playHead)
+			m_playHead = m_enqueued.takeAll();
+
+		for (AudioQueueBufferImpl* buf = m_playHead; buf != nullptr; buf = buf->next)
+		{
+			if (m_format.mBytesPerFrame)
+				frames += buf->buffer.mAudioDataByteSize / m_format.mBytesPerFrame;
+			else
+				frames += UInt64(packetCount(buf)) * m_format.mFramesPerPacket;
+		}
+	}
+
+	if (inNumberOfFramesToPrepare && frames > inNumberOfFramesToPrepare)
+		frames = inNumberOfFramesToPrepare;
+	if (outNumberOfFramesPrepared)
+		*outNumberOfFramesPrepared = UInt32(frames);
+
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::flush()
 {
-	STUB();
-	return unimpErr;
+	// The render thread drains the converter once it runs out of buffers
+	m_flushRequested = true;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::stop(Boolean inImmediate)
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+
+	if (!inImmediate && m_running && !m_paused)
+	{
+		// Play what's enqueued; the render thread then sets m_finished and finishStop() does the rest
+		m_stopRequested = true;
+		return noErr;
+	}
+
+	stopDevice();
+	returnAllBuffers();
+	if (m_converter)
+		AudioConverterReset(m_converter);
+
+	m_running = m_paused = false;
+	m_stopRequested = m_flushRequested = m_finished = false;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::pause()
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+
+	if (!m_running || m_paused)
+		return noErr;
+
+	stopDevice();
+	m_paused = true;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::reset()
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+	const bool wasRunning = m_deviceRunning;
+
+	stopDevice();
+	returnAllBuffers();
+	if (m_converter)
+		AudioConverterReset(m_converter);
+
+	m_stopRequested = m_flushRequested = m_finished = false;
+
+	if (wasRunning)
+		return startDevice();
+	return noErr;
+}
+
+OSStatus AudioQueueOutput::getParameter(AudioQueueParameterID inParamID, AudioQueueParameterValue *outValue)
+{
+	switch (inParamID)
+	{
+		case kAudioQueueParam_Volume:
+			*outValue = m_volume;
+			return noErr;
+		default:
+			return kAudioQueueErr_InvalidParameter;
+	}
+}
+
+OSStatus AudioQueueOutput::setParameter(AudioQueueParameterID inParamID, AudioQueueParameterValue inValue)
+{
+	switch (inParamID)
+	{
+		case kAudioQueueParam_Volume:
+			if (inValue < 0 || inValue > 1)
+				return kAudioQueueErr_InvalidParameter;
+			m_volume = inValue;
+			return noErr;
+		default:
+			return kAudioQueueErr_InvalidParameter;
+	}
+}
+
+OSStatus AudioQueueOutput::enqueueBuffer(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs)
+{
+	if (m_disposePending)
+		return kAudioQueueErr_DisposalPending;
+
+	OSStatus err = validateEnqueue(inBuffer, inNumPacketDescs, inPacketDescs);
+	if (err != noErr)
+		return err;
+
+	m_enqueued.push(AudioQueueBufferImpl::fromRef(inBuffer));
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::dispose(Boolean inImmediate)
 {
-	if (inImmediate)
+	std::unique_lock<std::recursive_mutex> lock(m_controlMutex);
+
+	if (m_disposePending)
+		return kAudioQueueErr_DisposalPending;
+
+	if (!inImmediate && m_running && !m_paused)
 	{
-		delete this;
+		// Goes away in finishStop(), once everything has been played
+		m_disposePending = true;
+		m_stopRequested = true;
 		return noErr;
 	}
-	else
+
+	stopDevice();
+	m_running = false;
+
+	// Called from our own callback, let deliverCallbacks() delete us once it's done
+	if (m_inCallbacks && onCallbackThread())
 	{
-		STUB();
-		return unimpErr;
+		m_deleteAfterCallbacks = true;
+		return noErr;
 	}
+
+	lock.unlock();
+	delete this;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::setOfflineRenderFormat(const AudioStreamBasicDescription *inFormat, const AudioChannelLayout *inLayout)
 {
-	STUB();
-	return unimpErr;
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+
+	if (m_deviceRunning)
+		return kAudioQueueErr_InvalidRunState;
+
+	if (!inFormat)
+	{
+		m_offline = false;
+		return noErr;
+	}
+
+	// TODO: inLayout; channels are mapped in order
+	if (inFormat->mFormatID != kAudioFormatLinearPCM || (inFormat->mFormatFlags & kAudioFormatFlagIsNonInterleaved) || !inFormat->mBytesPerFrame)
+		return kAudioQueueErr_InvalidParameter;
+
+	OSStatus err = setupConverter(*inFormat);
+	if (err != noErr)
+		return err;
+
+	m_offline = true;
+	return noErr;
 }
 
 OSStatus AudioQueueOutput::offlineRender(const AudioTimeStamp *inTimestamp, AudioQueueBufferRef ioBuffer, UInt32 inNumberFrames)
 {
-	STUB();
-	return unimpErr;
+	if (!m_offline)
+		return kAudioQueueErr_InvalidOfflineMode;
+	if (!ioBuffer)
+		return kAudioQueueErr_InvalidBuffer;
+	if (!m_running || m_paused)
+		return kAudioQueueErr_InvalidRunState;
+	if (UInt64(inNumberFrames) * m_renderFormat.mBytesPerFrame > ioBuffer->mAudioDataBytesCapacity)
+		return kAudioQueueErr_InvalidBuffer;
+
+	// Rendering is sequential, inTimestamp is only a hint
+	UInt32 produced = 0;
+
+	if (inNumberFrames > 0)
+	{
+		AudioBufferList abl;
+
+		abl.mNumberBuffers = 1;
+		abl.mBuffers[0].mNumberChannels = m_renderFormat.mChannelsPerFrame;
+		abl.mBuffers[0].mData = ioBuffer->mAudioData;
+		abl.mBuffers[0].mDataByteSize = inNumberFrames * m_renderFormat.mBytesPerFrame;
+
+		produced = render(&abl, inNumberFrames);
+	}
+	ioBuffer->mAudioDataByteSize = produced * m_renderFormat.mBytesPerFrame;
+
+	// Without a device, played buffers go back to the client right away.
+	// This may delete the queue if it was disposed of asynchronously.
+	deliverCallbacks();
+	return noErr;
+}
+
+OSStatus AudioQueueOutput::deviceIOProc(AudioObjectID inDevice, const AudioTimeStamp* inNow,
+	const AudioBufferList* inInputData, const AudioTimeStamp* inInputTime,
+	AudioBufferList* outOutputData, const AudioTimeStamp* inOutputTime, void* inClientData)
+{
+	AudioQueueOutput* This = static_cast<AudioQueueOutput*>(inClientData);
+	AudioBuffer& out = outOutputData->mBuffers[0];
+	const UInt32 frameSize = This->m_renderFormat.mBytesPerFrame;
+	const UInt32 frames = out.mDataByteSize / frameSize;
+
+	// Everything has been played after a stop request, an empty buffer corks the stream until finishStop() stops it
+	if (This->m_finished)
+	{
+		out.mDataByteSize = 0;
+		return noErr;
+	}
+
+	const UInt32 produced = This->render(outOutputData, frames);
+
+	if (produced == 0 && This->m_finished)
+	{
+		out.mDataByteSize = 0;
+		return noErr;
+	}
+
+	// On underrun, play silence rather than stopping the stream
+	if (produced < frames)
+		memset(static_cast<uint8_t*>(out.mData) + produced * frameSize, 0, (frames - produced) * frameSize);
+	out.mDataByteSize = frames * frameSize;
+
+	return noErr;
+}
+
+UInt32 AudioQueueOutput::render(AudioBufferList* abl, UInt32 frames)
+{
+	UInt32 produced = frames;
+
+	if (!m_converter)
+		return 0;
+
+	OSStatus status = AudioConverterFillComplexBuffer(m_converter, converterInputProc, this, &produced, abl, nullptr);
+	if (status != noErr && status != kAudioQueueErr_BufferEmpty)
+		produced = 0;
+
+	const float volume = m_volume.load(std::memory_order_relaxed);
+	if (volume != 1.0f && (m_renderFormat.mFormatFlags & kAudioFormatFlagIsFloat) && m_renderFormat.mBitsPerChannel == 32)
+	{
+		for (UInt32 i = 0; i < abl->mNumberBuffers; i++)
+		{
+			float* samples = static_cast<float*>(abl->mBuffers[i].mData);
+			const UInt32 count = produced * abl->mBuffers[i].mNumberChannels;
+
+			for (UInt32 j = 0; j < count; j++)
+				samples[j] *= volume;
+		}
+	}
+
+	// Ran out of input after a stop or flush request and the converter has nothing left either
+	if (produced < frames && !m_current && !m_playHead && m_enqueued.empty())
+	{
+		if (m_stopRequested)
+		{
+			m_finished = true;
+			if (!m_offline)
+				scheduleCallbacks();
+		}
+		else if (m_flushRequested)
+		{
+			AudioConverterReset(m_converter);
+			m_flushRequested = false;
+		}
+	}
+
+	return produced;
+}
+
+OSStatus AudioQueueOutput::converterInputProc(AudioConverterRef inAudioConverter, UInt32* ioNumberDataPackets,
+	AudioBufferList* ioData, AudioStreamPacketDescription** outDataPacketDescription, void* inUserData)
+{
+	return static_cast<AudioQueueOutput*>(inUserData)->provideInput(ioNumberDataPackets, ioData, outDataPacketDescription);
+}
+
+OSStatus AudioQueueOutput::provideInput(UInt32* ioNumberDataPackets, AudioBufferList* ioData, AudioStreamPacketDescription** outDataPacketDescription)
+{
+	// The converter is done with whatever we gave it last time, so finished buffers can go back to the client
+	while (true)
+	{
+		if (!m_current)
+		{
+			m_current = nextQueuedBuffer();
+			m_currentPacket = 0;
+
+			if (!m_current)
+				break;
+		}
+
+		if (m_currentPacket < packetCount(m_current))
+			break;
+
+		completeBuffer(m_current);
+		m_current = nullptr;
+	}
+
+	if (outDataPacketDescription)
+		*outDataPacketDescription = nullptr;
+
+	if (!m_current)
+	{
+		*ioNumberDataPackets = 0;
+
+		// No packets and no error means end of stream, which makes the converter drain
+		if (m_stopRequested || m_flushRequested)
+			return noErr;
+		return kAudioQueueErr_BufferEmpty;
+	}
+
+	uint8_t* data = static_cast<uint8_t*>(m_current->buffer.mAudioData);
+
+	ioData->mNumberBuffers = 1;
+	ioData->mBuffers[0].mNumberChannels = m_format.mChannelsPerFrame;
+
+	if (m_current->queuedDescriptions)
+	{
+		// Compressed packets go one at a time, which is also what the decoder wants
+		const AudioStreamPacketDescription& desc = m_current->queuedDescriptions[m_currentPacket];
+
+		ioData->mBuffers[0].mData = data + desc.mStartOffset;
+		ioData->mBuffers[0].mDataByteSize = desc.mDataByteSize;
+
+		m_packetDescription = desc;
+		m_packetDescription.mStartOffset = 0;
+		if (outDataPacketDescription)
+			*outDataPacketDescription = &m_packetDescription;
+
+		*ioNumberDataPackets = 1;
+		m_currentPacket++;
+	}
+	else
+	{
+		const UInt32 available = packetCount(m_current) - m_currentPacket;
+		const UInt32 packets = *ioNumberDataPackets ? std::min(*ioNumberDataPackets, available) : available;
+
+		ioData->mBuffers[0].mData = data + m_currentPacket * m_format.mBytesPerPacket;
+		ioData->mBuffers[0].mDataByteSize = packets * m_format.mBytesPerPacket;
+
+		*ioNumberDataPackets = packets;
+		m_currentPacket += packets;
+	}
+
+	return noErr;
+}
+
+AudioQueueBufferImpl* AudioQueueOutput::nextQueuedBuffer()
+{
+	// Buffers enqueued since the last time are all newer than what we have
+	if (!m_playHead)
+		m_playHead = m_enqueued.takeAll();
+
+	AudioQueueBufferImpl* buf = m_playHead;
+	if (buf)
+		m_playHead = buf->next;
+	return buf;
+}
+
+UInt32 AudioQueueOutput::packetCount(const AudioQueueBufferImpl* buf) const
+{
+	if (buf->queuedDescriptions)
+		return buf->queuedDescriptionCount;
+	if (!m_format.mBytesPerPacket)
+		return 0;
+	return buf->buffer.mAudioDataByteSize / m_format.mBytesPerPacket;
+}
+
+void AudioQueueOutput::completeBuffer(AudioQueueBufferImpl* buf)
+{
+	m_completed.push(buf);
+
+	// Offline, offlineRender() returns them itself
+	if (!m_offline)
+		scheduleCallbacks();
+}
+
+void AudioQueueOutput::returnAllBuffers()
+{
+	if (m_current)
+	{
+		m_completed.push(m_current);
+		m_current = nullptr;
+	}
+
+	while (AudioQueueBufferImpl* buf = nextQueuedBuffer())
+		m_completed.push(buf);
+
+	scheduleCallbacks();
+}
+
+void AudioQueueOutput::scheduleCallbacks()
+{
+	// Already pending, that one will pick up the new buffers too
+	if (m_callbacksScheduled.exchange(true))
+		return;
+
+	if (m_callbackSource)
+	{
+		CFRunLoopSourceSignal(m_callbackSource);
+		CFRunLoopWakeUp(m_runloop);
+	}
+	else
+		dispatch_async_f(m_callbackQueue, this, performCallbacks);
+}
+
+void AudioQueueOutput::performCallbacks(void* info)
+{
+	AudioQueueOutput* This = static_cast<AudioQueueOutput*>(info);
+
+	if (This->m_destroying)
+		return;
+
+	This->m_callbacksScheduled = false;
+	This->deliverCallbacks();
+}
+
+void AudioQueueOutput::deliverCallbacks()
+{
+	AudioQueueBufferImpl* list = m_completed.takeAll();
+
+	m_inCallbacks = true;
+	while (list)
+	{
+		AudioQueueBufferImpl* next = list->next;
+
+		list->enqueued = false;
+		if (!m_disposePending && !m_deleteAfterCallbacks)
+			m_callback(m_userData, this, &list->buffer);
+
+		list = next;
+	}
+	m_inCallbacks = false;
+
+	bool destroy = m_deleteAfterCallbacks;
+	if (!destroy && m_finished.exchange(false))
+		destroy = finishStop();
+
+	if (destroy)
+	{
+		m_destroying = true;
+
+		// Callbacks scheduled before the device stopped may still be waiting on the queue
+		if (m_callbackQueue && onCallbackThread())
+			dispatch_async_f(m_callbackQueue, this, [](void* p) { delete static_cast<AudioQueueOutput*>(p); });
+		else
+			delete this;
+	}
+}
+
+bool AudioQueueOutput::finishStop()
+{
+	std::lock_guard<std::recursive_mutex> guard(m_controlMutex);
+
+	// stop(true) or reset() got there first
+	if (!m_stopRequested)
+		return false;
+
+	stopDevice();
+	if (m_converter)
+		AudioConverterReset(m_converter);
+
+	m_running = false;
+	m_stopRequested = m_flushRequested = false;
+
+	return m_disposePending;
+}
+
+bool AudioQueueOutput::onCallbackThread() const
+{
+	if (m_callbackQueue)
+		return dispatch_get_specific(&kCallbackQueueKey) == this;
+	return CFRunLoopGetCurrent() == m_runloop;
 }
 
 OSStatus AudioQueueOutput::create(const AudioStreamBasicDescription *inFormat,
@@ -85,9 +672,24 @@ OSStatus AudioQueueOutput::create(const AudioStreamBasicDescription *inFormat,
 		CFStringRef inCallbackRunLoopMode, UInt32 inFlags,
 			AudioQueueOutput** newQueue)
 {
-	// TODO: check arguments
-	*newQueue = new AudioQueueOutput(inFormat, inCallbackProc, inUserData,
+	if (!inFormat || !inCallbackProc || !newQueue)
+		return paramErr;
+
+	*newQueue = nullptr;
+	if (inFormat->mChannelsPerFrame == 0 || inFormat->mSampleRate <= 0)
+		return kAudioQueueErr_InvalidParameter;
+
+	AudioQueueOutput* queue = new AudioQueueOutput(inFormat, inCallbackProc, inUserData,
 			inCallbackRunLoop, inCallbackRunLoopMode,
 			inFlags);
+
+	// Find out now whether we can decode the format at all
+	if (queue->setupConverter(deviceFormatFor(*inFormat)) != noErr)
+	{
+		delete queue;
+		return kAudioFormatUnsupportedDataFormatError;
+	}
+
+	*newQueue = queue;
 	return noErr;
 }
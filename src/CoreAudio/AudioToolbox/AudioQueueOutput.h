@@ -1,7 +1,19 @@
 #ifndef AUDIOQUEUEOUTPUT_H
 #define	AUDIOQUEUEOUTPUT_H
 #include "AudioQueueBase.h"
+#include "AudioConverter.h"
+#include <CoreAudio/AudioHardware.h>
+#include <dispatch/dispatch.h>
+#include <atomic>
+#include <mutex>
 
+// Plays enqueued buffers either on the default output device or, after setOfflineRenderFormat(),
+// into buffers handed to offlineRender().
+//
+// Clients enqueue buffers without taking locks. Rendering happens on the device's IO thread
+// (or the offlineRender() caller), which converts the queue's format with an AudioConverter.
+// Played buffers are handed back to the client on the requested run loop, or on a private
+// dispatch queue if there is none.
 class AudioQueueOutput : public AudioQueue
 {
 public:
@@ -9,28 +21,102 @@ public:
 			AudioQueueOutputCallback inCallbackProc,
 		void *inUserData, CFRunLoopRef inCallbackRunLoop,
 		CFStringRef inCallbackRunLoopMode, UInt32 inFlags);
-	
+
 	virtual ~AudioQueueOutput();
-	
+
 	virtual OSStatus start(const AudioTimeStamp *inStartTime) override;
 	virtual OSStatus prime(UInt32 inNumberOfFramesToPrepare, UInt32 *outNumberOfFramesPrepared) override;
 	virtual OSStatus flush() override;
 	virtual OSStatus stop(Boolean inImmediate) override;
 	virtual OSStatus pause() override;
 	virtual OSStatus reset() override;
-	
+
+	virtual OSStatus getParameter(AudioQueueParameterID inParamID, AudioQueueParameterValue *outValue) override;
+	virtual OSStatus setParameter(AudioQueueParameterID inParamID, AudioQueueParameterValue inValue) override;
+
 	virtual OSStatus setOfflineRenderFormat(const AudioStreamBasicDescription *inFormat, const AudioChannelLayout *inLayout) override;
 	virtual OSStatus offlineRender(const AudioTimeStamp *inTimestamp, AudioQueueBufferRef ioBuffer, UInt32 inNumberFrames) override;
-	
+
+	virtual OSStatus enqueueBuffer(AudioQueueBufferRef inBuffer, UInt32 inNumPacketDescs, const AudioStreamPacketDescription *inPacketDescs) override;
+
 	virtual OSStatus dispose(Boolean inImmediate) override;
-	
+
 	static OSStatus create(const AudioStreamBasicDescription *inFormat,
 			AudioQueueOutputCallback inCallbackProc,
 		void *inUserData, CFRunLoopRef inCallbackRunLoop,
 		CFStringRef inCallbackRunLoopMode, UInt32 inFlags,
 			AudioQueueOutput** newQueue);
+private:
+	// Creates the converter from the queue's format to renderFormat
+	OSStatus setupConverter(const AudioStreamBasicDescription& renderFormat);
+	OSStatus startDevice();
+	void stopDevice();
+
+	static OSStatus deviceIOProc(AudioObjectID inDevice, const AudioTimeStamp* inNow,
+		const AudioBufferList* inInputData, const AudioTimeStamp* inInputTime,
+		AudioBufferList* outOutputData, const AudioTimeStamp* inOutputTime, void* inClientData);
+	static OSStatus converterInputProc(AudioConverterRef inAudioConverter, UInt32* ioNumberDataPackets,
+		AudioBufferList* ioData, AudioStreamPacketDescription** outDataPacketDescription, void* inUserData);
+
+	// Render thread: fills abl with up to `frames` frames in m_renderFormat, returns how many there were
+	UInt32 render(AudioBufferList* abl, UInt32 frames);
+	OSStatus provideInput(UInt32* ioNumberDataPackets, AudioBufferList* ioData, AudioStreamPacketDescription** outDataPacketDescription);
+	AudioQueueBufferImpl* nextQueuedBuffer();
+	UInt32 packetCount(const AudioQueueBufferImpl* buf) const;
+	void completeBuffer(AudioQueueBufferImpl* buf);
+
+	// Hands everything enqueued back to the client. The render thread must not be running.
+	void returnAllBuffers();
+
+	// Callback side
+	void scheduleCallbacks();
+	void deliverCallbacks();
+	// Returns true if the queue should now be deleted
+	bool finishStop();
+	static void performCallbacks(void* info);
+	bool onCallbackThread() const;
 private:
 	AudioQueueOutputCallback m_callback;
+
+	// Buffers enqueued by the client that the render thread hasn't picked up yet
+	AudioQueueBufferStack m_enqueued;
+	// Played buffers waiting for the callback
+	AudioQueueBufferStack m_completed;
+
+	// Owned by the render thread: buffers in play order, and the one the converter is reading
+	AudioQueueBufferImpl* m_playHead = nullptr;
+	AudioQueueBufferImpl* m_current = nullptr;
+	UInt32 m_currentPacket = 0;
+	// what we hand to the converter along with a compressed packet
+	AudioStreamPacketDescription m_packetDescription;
+
+	AudioConverterRef m_converter = nullptr;
+	AudioStreamBasicDescription m_renderFormat;
+	std::atomic<float> m_volume { 1.0f };
+
+	// Serializes start/stop/pause/reset/dispose; never taken by the render thread
+	std::recursive_mutex m_controlMutex;
+	bool m_running = false, m_paused = false;
+	bool m_offline = false;
+	std::atomic<bool> m_disposePending { false };
+
+	// AudioQueueStop(false) or AudioQueueFlush(): play what's enqueued, then drain the converter
+	std::atomic<bool> m_stopRequested { false };
+	std::atomic<bool> m_flushRequested { false };
+	// The render thread has played everything after a stop request
+	std::atomic<bool> m_finished { false };
+
+	AudioDeviceID m_device = kAudioDeviceUnknown;
+	AudioDeviceIOProcID m_ioProcID = nullptr;
+	bool m_deviceRunning = false;
+
+	CFRunLoopSourceRef m_callbackSource = nullptr;
+	dispatch_queue_t m_callbackQueue = nullptr;
+	std::atomic<bool> m_callbacksScheduled { false };
+	// dispose() was called from inside one of our callbacks
+	bool m_inCallbacks = false;
+	bool m_deleteAfterCallbacks = false;
+	bool m_destroying = false;
 };
 
 #endif	/* AUDIOQUEUEOUTPUT_H */
@@ -19,37 +19,129 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 
 #ifndef _CA_CONSUMABLE_BUFFER_H
 #define _CA_CONSUMABLE_BUFFER_H
-#include <vector>
 #include <stdexcept>
+#include <algorithm>
 #include <cstring>
 #include <stdint.h>
 
+// A fixed-capacity byte ring buffer.
+// The capacity is set up front with reserve(); after that, nothing here allocates,
+// so it can be used on realtime threads.
+// Producers may write straight into writeSpan() and then commit(); consumers may read straight from readSpan().
 class ConsumableBuffer
 {
 public:
-	void push(const void* mem, size_t bytes)
+	ConsumableBuffer() = default;
+	explicit ConsumableBuffer(size_t capacity)
 	{
-		const uint8_t* ptr = static_cast<const uint8_t*>(mem);
-		m_data.insert(m_data.end(), ptr, ptr + bytes);
+		reserve(capacity);
+	}
+	~ConsumableBuffer()
+	{
+		delete [] m_data;
+	}
+
+	ConsumableBuffer(const ConsumableBuffer&) = delete;
+	ConsumableBuffer& operator=(const ConsumableBuffer&) = delete;
+
+	// Sets the capacity (rounded up to a power of two) and drops the contents
+	void reserve(size_t capacity)
+	{
+		size_t rounded = 1;
+		while (rounded < capacity)
+			rounded <<= 1;
+
+		delete [] m_data;
+		m_data = new uint8_t[rounded];
+		m_mask = rounded - 1;
+		clear();
+	}
+	size_t capacity() const
+	{
+		return m_data ? m_mask + 1 : 0;
 	}
 	size_t size() const
 	{
-		return m_data.size();
+		return m_write - m_read;
+	}
+	size_t space() const
+	{
+		return capacity() - size();
+	}
+	void clear()
+	{
+		m_read = m_write = 0;
+	}
+
+	// The longest run of readable bytes that doesn't wrap around
+	const uint8_t* readSpan(size_t& bytes) const
+	{
+		const size_t offset = m_read & m_mask;
+		bytes = std::min(size(), capacity() - offset);
+		return m_data + offset;
+	}
+	// The longest run of free bytes that doesn't wrap around; call commit() after writing into it
+	uint8_t* writeSpan(size_t& bytes)
+	{
+		const size_t offset = m_write & m_mask;
+		bytes = std::min(space(), capacity() - offset);
+		return m_data + offset;
+	}
+	void commit(size_t bytes)
+	{
+		if (bytes > space())
+			throw std::logic_error("ConsumableBuffer::commit() bytes > space()");
+		m_write += bytes;
+	}
+
+	void push(const void* mem, size_t bytes)
+	{
+		if (bytes > space())
+			throw std::logic_error("ConsumableBuffer::push() bytes > space()");
+
+		const uint8_t* ptr = static_cast<const uint8_t*>(mem);
+		while (bytes > 0)
+		{
+			size_t span;
+			uint8_t* dst = writeSpan(span);
+
+			span = std::min(span, bytes);
+			std::memcpy(dst, ptr, span);
+			m_write += span;
+			ptr += span;
+			bytes -= span;
+		}
 	}
-	const uint8_t* data()
+	// Copies out the first `bytes` bytes without consuming them
+	void peek(void* mem, size_t bytes) const
 	{
-		return m_data.data();
+		if (bytes > size())
+			throw std::logic_error("ConsumableBuffer::peek() bytes > size()");
+
+		uint8_t* ptr = static_cast<uint8_t*>(mem);
+		size_t offset = m_read;
+		while (bytes > 0)
+		{
+			const size_t span = std::min(bytes, capacity() - (offset & m_mask));
+
+			std::memcpy(ptr, m_data + (offset & m_mask), span);
+			offset += span;
+			ptr += span;
+			bytes -= span;
+		}
 	}
 	void consume(size_t bytes)
 	{
 		if (bytes > size())
 			throw std::logic_error("ConsumableBuffer::consume() bytes > size()");
 
-		std::memmove(m_data.data(), m_data.data() + bytes, m_data.size() - bytes);
-		m_data.resize(m_data.size() - bytes);
+		m_read += bytes;
 	}
 private:
-	std::vector<uint8_t> m_data;
+	uint8_t* m_data = nullptr;
+	size_t m_mask = 0;
+	// free-running positions; only their difference and their low bits matter
+	size_t m_read = 0, m_write = 0;
 };
 
 #endif
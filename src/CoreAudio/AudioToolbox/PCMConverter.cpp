@@ -0,0 +1,1038 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2020 Lubos Dolezel
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PCMConverter.h"
+#include <CarbonCore/MacErrors.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#ifdef __SSE2__
+#	include <emmintrin.h>
+#endif
+
+// Frames converted in one step; the scratch buffers are sized for this
+static constexpr UInt32 BLOCK_FRAMES = 1024;
+static constexpr UInt32 MAX_CHANNELS = 64;
+
+// How many frames we ask the input callback for at most
+static constexpr UInt32 MAX_INPUT_REQUEST = 16384;
+
+static constexpr UInt32 RESAMPLER_PHASES = 256;
+static constexpr UInt32 RESAMPLER_MAX_TAPS = 1024;
+static constexpr double RESAMPLER_KAISER_BETA = 8.0;
+
+typedef PCMConverter::SampleFormat SampleFormat;
+
+static constexpr bool HOST_BIG_ENDIAN = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+static inline uint16_t swap16(uint16_t v) { return __builtin_bswap16(v); }
+static inline uint32_t swap32(uint32_t v) { return __builtin_bswap32(v); }
+static inline uint64_t swap64(uint64_t v) { return __builtin_bswap64(v); }
+
+template <typename T> static inline T load(const uint8_t* p)
+{
+	T v;
+	std::memcpy(&v, p, sizeof(T));
+	return v;
+}
+
+template <typename T> static inline void store(uint8_t* p, T v)
+{
+	std::memcpy(p, &v, sizeof(T));
+}
+
+static inline int32_t quantize(float v, float scale, float min, float max)
+{
+	return int32_t(std::lrint(std::min(std::max(v * scale, min), max)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sample format kernels
+////////////////////////////////////////////////////////////////////////////////
+
+static void decodeS16(const uint8_t* src, bool swap, float* dst, size_t count)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	const __m128 scale = _mm_set1_ps(1.0f / 32768);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+
+		if (swap)
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+#endif
+	for (; i < count; i++)
+	{
+		uint16_t v = load<uint16_t>(src + i * 2);
+		if (swap)
+			v = swap16(v);
+		dst[i] = int16_t(v) * (1.0f / 32768);
+	}
+}
+
+static void encodeS16(const float* src, const float* noise, bool swap, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	const __m128 scale = _mm_set1_ps(32768.0f);
+	const __m128 min = _mm_set1_ps(-32768.0f);
+	const __m128 max = _mm_set1_ps(32767.0f);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128 a = _mm_mul_ps(_mm_loadu_ps(src + i), scale);
+		__m128 b = _mm_mul_ps(_mm_loadu_ps(src + i + 4), scale);
+
+		if (noise)
+		{
+			a = _mm_add_ps(a, _mm_loadu_ps(noise + i));
+			b = _mm_add_ps(b, _mm_loadu_ps(noise + i + 4));
+		}
+
+		// out-of-range values would turn into INT_MIN in cvtps, so clamp first
+		a = _mm_min_ps(_mm_max_ps(a, min), max);
+		b = _mm_min_ps(_mm_max_ps(b, min), max);
+
+		__m128i v = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+
+		if (swap)
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), v);
+	}
+#endif
+	for (; i < count; i++)
+	{
+		uint16_t v = uint16_t(quantize(src[i] + (noise ? noise[i] / 32768 : 0), 32768.0f, -32768.0f, 32767.0f));
+		store(dst + i * 2, swap ? swap16(v) : v);
+	}
+}
+
+static void decodeS32(const uint8_t* src, bool swap, float* dst, size_t count)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	const __m128 scale = _mm_set1_ps(1.0f / 2147483648.0f);
+
+	if (!swap)
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+		}
+	}
+#endif
+	for (; i < count; i++)
+	{
+		uint32_t v = load<uint32_t>(src + i * 4);
+		if (swap)
+			v = swap32(v);
+		dst[i] = int32_t(v) * (1.0f / 2147483648.0f);
+	}
+}
+
+// the largest float below 2^31
+static constexpr float S32_MAX_FLOAT = 2147483520.0f;
+
+static void encodeS32(const float* src, bool swap, uint8_t* dst, size_t count)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	const __m128 scale = _mm_set1_ps(2147483648.0f);
+	const __m128 min = _mm_set1_ps(-2147483648.0f);
+	const __m128 max = _mm_set1_ps(S32_MAX_FLOAT);
+
+	if (!swap)
+	{
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), min), max);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_cvtps_epi32(v));
+		}
+	}
+#endif
+	for (; i < count; i++)
+	{
+		uint32_t v = uint32_t(quantize(src[i], 2147483648.0f, -2147483648.0f, S32_MAX_FLOAT));
+		store(dst + i * 4, swap ? swap32(v) : v);
+	}
+}
+
+static void decodeSamples(SampleFormat format, bool bigEndian, const uint8_t* src, float* dst, size_t count)
+{
+	const bool swap = bigEndian != HOST_BIG_ENDIAN;
+
+	switch (format)
+	{
+		case SampleFormat::S8:
+			for (size_t i = 0; i < count; i++)
+				dst[i] = int8_t(src[i]) * (1.0f / 128);
+			break;
+		case SampleFormat::U8:
+			for (size_t i = 0; i < count; i++)
+				dst[i] = (int(src[i]) - 128) * (1.0f / 128);
+			break;
+		case SampleFormat::S16:
+			decodeS16(src, swap, dst, count);
+			break;
+		case SampleFormat::S24:
+			for (size_t i = 0; i < count; i++, src += 3)
+			{
+				const uint32_t v = bigEndian ? (uint32_t(src[0]) << 24 | uint32_t(src[1]) << 16 | uint32_t(src[2]) << 8)
+					: (uint32_t(src[2]) << 24 | uint32_t(src[1]) << 16 | uint32_t(src[0]) << 8);
+				dst[i] = int32_t(v) * (1.0f / 2147483648.0f);
+			}
+			break;
+		case SampleFormat::S24In32:
+			for (size_t i = 0; i < count; i++)
+			{
+				uint32_t v = load<uint32_t>(src + i * 4);
+				if (swap)
+					v = swap32(v);
+				dst[i] = int32_t(v << 8) * (1.0f / 2147483648.0f);
+			}
+			break;
+		case SampleFormat::S32:
+			decodeS32(src, swap, dst, count);
+			break;
+		case SampleFormat::F32:
+			if (!swap)
+				std::memcpy(dst, src, count * sizeof(float));
+			else
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					const uint32_t v = swap32(load<uint32_t>(src + i * 4));
+					std::memcpy(&dst[i], &v, sizeof(float));
+				}
+			}
+			break;
+		case SampleFormat::F64:
+			for (size_t i = 0; i < count; i++)
+			{
+				uint64_t v = load<uint64_t>(src + i * 8);
+				double d;
+
+				if (swap)
+					v = swap64(v);
+				std::memcpy(&d, &v, sizeof(d));
+				dst[i] = float(d);
+			}
+			break;
+	}
+}
+
+// `noise` (if any) is in units of the output's least significant bit
+static void encodeSamples(SampleFormat format, bool bigEndian, const float* src, const float* noise, uint8_t* dst, size_t count)
+{
+	const bool swap = bigEndian != HOST_BIG_ENDIAN;
+
+	switch (format)
+	{
+		case SampleFormat::S8:
+			for (size_t i = 0; i < count; i++)
+				dst[i] = uint8_t(quantize(src[i] + (noise ? noise[i] / 128 : 0), 128.0f, -128.0f, 127.0f));
+			break;
+		case SampleFormat::U8:
+			for (size_t i = 0; i < count; i++)
+				dst[i] = uint8_t(quantize(src[i] + (noise ? noise[i] / 128 : 0), 128.0f, -128.0f, 127.0f) + 128);
+			break;
+		case SampleFormat::S16:
+			encodeS16(src, noise, swap, dst, count);
+			break;
+		case SampleFormat::S24:
+			for (size_t i = 0; i < count; i++, dst += 3)
+			{
+				const uint32_t v = uint32_t(quantize(src[i] + (noise ? noise[i] / 8388608 : 0), 8388608.0f, -8388608.0f, 8388607.0f));
+
+				if (bigEndian)
+				{
+					dst[0] = v >> 16;
+					dst[1] = v >> 8;
+					dst[2] = v;
+				}
+				else
+				{
+					dst[0] = v;
+					dst[1] = v >> 8;
+					dst[2] = v >> 16;
+				}
+			}
+			break;
+		case SampleFormat::S24In32:
+			for (size_t i = 0; i < count; i++)
+			{
+				const uint32_t v = uint32_t(quantize(src[i] + (noise ? noise[i] / 8388608 : 0), 8388608.0f, -8388608.0f, 8388607.0f));
+				store(dst + i * 4, swap ? swap32(v) : v);
+			}
+			break;
+		case SampleFormat::S32:
+			encodeS32(src, swap, dst, count);
+			break;
+		case SampleFormat::F32:
+			if (!swap)
+				std::memcpy(dst, src, count * sizeof(float));
+			else
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					uint32_t v;
+					std::memcpy(&v, &src[i], sizeof(v));
+					store(dst + i * 4, swap32(v));
+				}
+			}
+			break;
+		case SampleFormat::F64:
+			for (size_t i = 0; i < count; i++)
+			{
+				const double d = src[i];
+				uint64_t v;
+
+				std::memcpy(&v, &d, sizeof(v));
+				store(dst + i * 8, swap ? swap64(v) : v);
+			}
+			break;
+	}
+}
+
+static void interleave(const float* planar, UInt32 channels, float* dst, size_t frames)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	if (channels == 2)
+	{
+		const float* left = planar;
+		const float* right = planar + BLOCK_FRAMES;
+
+		for (; i + 4 <= frames; i += 4)
+		{
+			const __m128 l = _mm_loadu_ps(left + i);
+			const __m128 r = _mm_loadu_ps(right + i);
+
+			_mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(l, r));
+			_mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(l, r));
+		}
+	}
+#endif
+	for (; i < frames; i++)
+	{
+		for (UInt32 c = 0; c < channels; c++)
+			dst[i * channels + c] = planar[c * BLOCK_FRAMES + i];
+	}
+}
+
+static void deinterleave(const float* src, UInt32 channels, float* planar, size_t frames)
+{
+	size_t i = 0;
+#ifdef __SSE2__
+	if (channels == 2)
+	{
+		float* left = planar;
+		float* right = planar + BLOCK_FRAMES;
+
+		for (; i + 4 <= frames; i += 4)
+		{
+			const __m128 a = _mm_loadu_ps(src + i * 2);
+			const __m128 b = _mm_loadu_ps(src + i * 2 + 4);
+
+			_mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+		}
+	}
+#endif
+	for (; i < frames; i++)
+	{
+		for (UInt32 c = 0; c < channels; c++)
+			planar[c * BLOCK_FRAMES + i] = src[i * channels + c];
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Polyphase resampler
+////////////////////////////////////////////////////////////////////////////////
+
+// A windowed-sinc resampler working on interleaved float frames.
+// The filter is tabulated for RESAMPLER_PHASES fractional positions, and coefficients for positions
+// in between are interpolated linearly, so any ratio works (not just rational ones with small terms).
+class PCMConverter::Resampler
+{
+public:
+	Resampler(double inRate, double outRate, UInt32 channels, UInt32 quality);
+
+	void reset();
+	UInt32 space() const { return m_capacity - m_frames; }
+	void push(const float* src, UInt32 frames);
+	// pushes enough silence for the last input frames to come out
+	void drain();
+	UInt32 produce(float* dst, UInt32 maxFrames);
+private:
+	void interpolateRow(uint32_t frac);
+private:
+	UInt32 m_channels, m_taps, m_capacity;
+	UInt32 m_frames = 0;
+	// input frames per output frame, and the position of the next output frame in m_buffer (32.32 fixed point)
+	uint64_t m_step, m_position = 0;
+	// RESAMPLER_PHASES + 1 rows of m_taps coefficients
+	std::vector<float> m_coefficients;
+	std::vector<float> m_row;
+	// m_capacity interleaved frames
+	std::vector<float> m_buffer;
+};
+
+static double besselI0(double x)
+{
+	double sum = 1, term = 1;
+
+	for (int k = 1; k < 50 && term > sum * 1e-12; k++)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+PCMConverter::Resampler::Resampler(double inRate, double outRate, UInt32 channels, UInt32 quality)
+	: m_channels(channels)
+{
+	UInt32 baseTaps;
+	double passband;
+
+	if (quality >= kAudioConverterQuality_Max)
+		baseTaps = 64, passband = 0.97;
+	else if (quality >= kAudioConverterQuality_High)
+		baseTaps = 48, passband = 0.95;
+	else if (quality >= kAudioConverterQuality_Medium)
+		baseTaps = 32, passband = 0.93;
+	else if (quality >= kAudioConverterQuality_Low)
+		baseTaps = 16, passband = 0.90;
+	else
+		baseTaps = 8, passband = 0.85;
+
+	// when downsampling, the cutoff goes down and the filter has to get longer to keep the same transition band
+	const double ratio = std::min(1.0, outRate / inRate);
+	const double cutoff = ratio * passband;
+
+	m_taps = UInt32(std::ceil(baseTaps / ratio / 4)) * 4;
+	m_taps = std::min(m_taps, RESAMPLER_MAX_TAPS);
+	m_capacity = m_taps + 2 * BLOCK_FRAMES;
+	m_step = uint64_t(std::llround(inRate / outRate * 4294967296.0));
+
+	const double half = m_taps / 2.0;
+	const double norm = besselI0(RESAMPLER_KAISER_BETA);
+
+	m_coefficients.resize((RESAMPLER_PHASES + 1) * m_taps);
+	for (UInt32 p = 0; p <= RESAMPLER_PHASES; p++)
+	{
+		const double frac = double(p) / RESAMPLER_PHASES;
+
+		for (UInt32 j = 0; j < m_taps; j++)
+		{
+			// distance of tap j from the output position
+			const double x = (double(j) - half + 1) - frac;
+			const double r = x / half;
+			double h = cutoff;
+
+			if (x != 0)
+				h = std::sin(M_PI * cutoff * x) / (M_PI * x);
+			h *= (std::fabs(r) < 1) ? besselI0(RESAMPLER_KAISER_BETA * std::sqrt(1 - r * r)) / norm : 0;
+
+			m_coefficients[p * m_taps + j] = float(h);
+		}
+	}
+
+	m_row.resize(m_taps);
+	m_buffer.resize(size_t(m_capacity) * m_channels);
+	reset();
+}
+
+void PCMConverter::Resampler::reset()
+{
+	// silence before the first frame, so that the filter can be centered on it
+	const UInt32 history = m_taps / 2 - 1;
+
+	std::fill(m_buffer.begin(), m_buffer.begin() + size_t(history) * m_channels, 0.0f);
+	m_frames = history;
+	m_position = uint64_t(history) << 32;
+}
+
+void PCMConverter::Resampler::push(const float* src, UInt32 frames)
+{
+	std::memcpy(&m_buffer[size_t(m_frames) * m_channels], src, size_t(frames) * m_channels * sizeof(float));
+	m_frames += frames;
+}
+
+void PCMConverter::Resampler::drain()
+{
+	const UInt32 frames = std::min(m_taps / 2, space());
+
+	std::fill(m_buffer.begin() + size_t(m_frames) * m_channels, m_buffer.begin() + size_t(m_frames + frames) * m_channels, 0.0f);
+	m_frames += frames;
+}
+
+void PCMConverter::Resampler::interpolateRow(uint32_t frac)
+{
+	// the top bits pick the phase, the rest is the weight of the next one
+	const UInt32 phase = uint64_t(frac) * RESAMPLER_PHASES >> 32;
+	const float weight = float(uint32_t(frac * RESAMPLER_PHASES)) * (1.0f / 4294967296.0f);
+	const float* a = &m_coefficients[phase * m_taps];
+	const float* b = a + m_taps;
+	UInt32 j = 0;
+
+#ifdef __SSE2__
+	const __m128 w = _mm_set1_ps(weight);
+	for (; j + 4 <= m_taps; j += 4)
+	{
+		const __m128 va = _mm_loadu_ps(a + j);
+		const __m128 vb = _mm_loadu_ps(b + j);
+		_mm_storeu_ps(&m_row[j], _mm_add_ps(va, _mm_mul_ps(w, _mm_sub_ps(vb, va))));
+	}
+#endif
+	for (; j < m_taps; j++)
+		m_row[j] = a[j] + weight * (b[j] - a[j]);
+}
+
+UInt32 PCMConverter::Resampler::produce(float* dst, UInt32 maxFrames)
+{
+	const UInt32 half = m_taps / 2;
+	UInt32 produced = 0;
+
+	while (produced < maxFrames)
+	{
+		const UInt32 index = UInt32(m_position >> 32);
+
+		// the last tap needs frame index + half
+		if (index + half >= m_frames)
+			break;
+
+		interpolateRow(uint32_t(m_position));
+
+		const float* src = &m_buffer[size_t(index + 1 - half) * m_channels];
+		float* out = dst + size_t(produced) * m_channels;
+		UInt32 j = 0;
+
+		if (m_channels == 1)
+		{
+#ifdef __SSE2__
+			__m128 acc = _mm_setzero_ps();
+			for (; j + 4 <= m_taps; j += 4)
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&m_row[j]), _mm_loadu_ps(src + j)));
+
+			float sums[4];
+			_mm_storeu_ps(sums, acc);
+			out[0] = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+#else
+			out[0] = 0;
+#endif
+			for (; j < m_taps; j++)
+				out[0] += m_row[j] * src[j];
+		}
+		else if (m_channels == 2)
+		{
+#ifdef __SSE2__
+			// two frames (L R L R) per step, with each coefficient duplicated for both channels
+			__m128 acc = _mm_setzero_ps();
+			for (; j + 4 <= m_taps; j += 4)
+			{
+				const __m128 h = _mm_loadu_ps(&m_row[j]);
+
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_unpacklo_ps(h, h), _mm_loadu_ps(src + j * 2)));
+				acc = _mm_add_ps(acc, _mm_mul_ps(_mm_unpackhi_ps(h, h), _mm_loadu_ps(src + j * 2 + 4)));
+			}
+
+			float sums[4];
+			_mm_storeu_ps(sums, acc);
+			out[0] = sums[0] + sums[2];
+			out[1] = sums[1] + sums[3];
+#else
+			out[0] = out[1] = 0;
+#endif
+			for (; j < m_taps; j++)
+			{
+				out[0] += m_row[j] * src[j * 2];
+				out[1] += m_row[j] * src[j * 2 + 1];
+			}
+		}
+		else
+		{
+			std::fill(out, out + m_channels, 0.0f);
+			for (; j < m_taps; j++)
+			{
+				for (UInt32 c = 0; c < m_channels; c++)
+					out[c] += m_row[j] * src[j * m_channels + c];
+			}
+		}
+
+		m_position += m_step;
+		produced++;
+	}
+
+	// drop the frames no future output frame needs
+	const UInt32 first = std::min(UInt32(m_position >> 32) + 1 - half, m_frames);
+	if (first > 0)
+	{
+		std::memmove(&m_buffer[0], &m_buffer[size_t(first) * m_channels], size_t(m_frames - first) * m_channels * sizeof(float));
+		m_frames -= first;
+		m_position -= uint64_t(first) << 32;
+	}
+
+	return produced;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PCMConverter
+////////////////////////////////////////////////////////////////////////////////
+
+bool PCMConverter::parseFormat(const AudioStreamBasicDescription& desc, Format& out)
+{
+	if (desc.mFormatID != kAudioFormatLinearPCM || desc.mFramesPerPacket > 1)
+		return false;
+	if (desc.mChannelsPerFrame == 0 || desc.mChannelsPerFrame > MAX_CHANNELS || !(desc.mSampleRate > 0))
+		return false;
+
+	out.interleaved = !(desc.mFormatFlags & kAudioFormatFlagIsNonInterleaved);
+	out.channels = desc.mChannelsPerFrame;
+	out.bitsPerChannel = desc.mBitsPerChannel;
+	out.bigEndian = desc.mFormatFlags & kAudioFormatFlagIsBigEndian;
+	out.sampleRate = desc.mSampleRate;
+
+	if (out.interleaved)
+	{
+		if (desc.mBytesPerFrame % desc.mChannelsPerFrame)
+			return false;
+		out.bytesPerSample = desc.mBytesPerFrame / desc.mChannelsPerFrame;
+	}
+	else
+		out.bytesPerSample = desc.mBytesPerFrame;
+
+	const UInt32 bits = desc.mBitsPerChannel;
+	const UInt32 bytes = out.bytesPerSample;
+
+	if (desc.mFormatFlags & kAudioFormatFlagIsFloat)
+	{
+		if (bits == 32 && bytes == 4)
+			out.sample = SampleFormat::F32;
+		else if (bits == 64 && bytes == 8)
+			out.sample = SampleFormat::F64;
+		else
+			return false;
+	}
+	else if (desc.mFormatFlags & kAudioFormatFlagIsSignedInteger)
+	{
+		if (bits == 8 && bytes == 1)
+			out.sample = SampleFormat::S8;
+		else if (bits == 16 && bytes == 2)
+			out.sample = SampleFormat::S16;
+		else if (bits == 24 && bytes == 3)
+			out.sample = SampleFormat::S24;
+		else if (bits == 24 && bytes == 4)
+			out.sample = (desc.mFormatFlags & kAudioFormatFlagIsAlignedHigh) ? SampleFormat::S32 : SampleFormat::S24In32;
+		else if (bits == 32 && bytes == 4)
+			out.sample = SampleFormat::S32;
+		else
+			return false;
+	}
+	else
+	{
+		// unsigned is only common for 8 bits; libavcodec can deal with the rest
+		if (bits == 8 && bytes == 1)
+			out.sample = SampleFormat::U8;
+		else
+			return false;
+	}
+
+	return true;
+}
+
+bool PCMConverter::canConvert(const AudioStreamBasicDescription* inSourceFormat, const AudioStreamBasicDescription* inDestinationFormat)
+{
+	Format in, out;
+	return parseFormat(*inSourceFormat, in) && parseFormat(*inDestinationFormat, out);
+}
+
+PCMConverter::PCMConverter(const AudioStreamBasicDescription& sourceFormat, const AudioStreamBasicDescription& destinationFormat)
+{
+	parseFormat(sourceFormat, m_in);
+	parseFormat(destinationFormat, m_out);
+
+	m_passthrough = m_in.sample == m_out.sample && m_in.bigEndian == m_out.bigEndian && m_in.interleaved == m_out.interleaved
+		&& m_in.channels == m_out.channels && m_in.sampleRate == m_out.sampleRate && m_in.bytesPerSample == m_out.bytesPerSample;
+
+	m_channelMap.resize(m_out.channels);
+	for (UInt32 c = 0; c < m_out.channels; c++)
+	{
+		if (c < m_in.channels)
+			m_channelMap[c] = c;
+		else
+			m_channelMap[c] = (m_in.channels == 1) ? 0 : -1;
+	}
+	m_identityMap = m_in.channels == m_out.channels;
+	m_downmix = m_out.channels == 1 && m_in.channels > 1;
+
+	m_quality = kAudioConverterQuality_High;
+	if (m_in.sampleRate != m_out.sampleRate)
+		m_resampler.reset(new Resampler(m_in.sampleRate, m_out.sampleRate, m_out.channels, m_quality));
+
+	const UInt32 inBuffers = m_in.bufferCount();
+	m_inputListStorage.reset(new uint8_t[offsetof(AudioBufferList, mBuffers) + sizeof(AudioBuffer) * inBuffers]);
+	m_inputList = reinterpret_cast<AudioBufferList*>(m_inputListStorage.get());
+
+	const UInt32 maxChannels = std::max(m_in.channels, m_out.channels);
+	m_decoded.reset(new float[BLOCK_FRAMES * m_in.channels]);
+	m_mixed.reset(new float[BLOCK_FRAMES * m_out.channels]);
+	m_pending.reset(new float[BLOCK_FRAMES * m_out.channels]);
+	m_planar.reset(new float[BLOCK_FRAMES * maxChannels]);
+	m_noise.reset(new float[BLOCK_FRAMES * m_out.channels]);
+}
+
+PCMConverter::~PCMConverter()
+{
+}
+
+void PCMConverter::reset()
+{
+	m_inputFrames = m_inputOffset = 0;
+	m_pendingFrames = m_pendingOffset = 0;
+	m_drained = false;
+
+	if (m_resampler)
+		m_resampler->reset();
+}
+
+OSStatus PCMConverter::setDithering(UInt32 algorithm)
+{
+	if (algorithm != 0 && algorithm != kDitherAlgorithm_TPDF && algorithm != kDitherAlgorithm_NoiseShaping)
+		return kAudioConverterErr_PropertyNotSupported;
+
+	// noise shaping is treated as plain TPDF dither
+	m_ditherAlgorithm = algorithm;
+	return noErr;
+}
+
+OSStatus PCMConverter::setDitherBitDepth(UInt32 bits)
+{
+	m_ditherBitDepth = bits;
+	return noErr;
+}
+
+OSStatus PCMConverter::setQuality(UInt32 quality)
+{
+	if (quality > kAudioConverterQuality_Max)
+		return kAudioConverterErr_PropertyNotSupported;
+
+	m_quality = quality;
+	if (m_resampler)
+	{
+		m_resampler.reset(new Resampler(m_in.sampleRate, m_out.sampleRate, m_out.channels, m_quality));
+		reset();
+	}
+	return noErr;
+}
+
+OSStatus PCMConverter::setChannelMap(const SInt32* map, UInt32 count)
+{
+	if (count != m_out.channels)
+		return kAudioConverterErr_BadPropertySizeError;
+
+	for (UInt32 c = 0; c < count; c++)
+	{
+		if (map[c] < -1 || map[c] >= SInt32(m_in.channels))
+			return kAudioConverterErr_PropertyNotSupported;
+	}
+
+	m_identityMap = m_in.channels == m_out.channels;
+	for (UInt32 c = 0; c < count; c++)
+	{
+		m_channelMap[c] = map[c];
+		if (map[c] != SInt32(c))
+			m_identityMap = false;
+	}
+	m_downmix = false;
+	m_passthrough = m_passthrough && m_identityMap;
+
+	return noErr;
+}
+
+void PCMConverter::getChannelMap(SInt32* map) const
+{
+	for (UInt32 c = 0; c < m_out.channels; c++)
+		map[c] = m_channelMap[c];
+}
+
+OSStatus PCMConverter::pullInput(AudioConverterRef converter, AudioConverterComplexInputDataProc dataProc, void* opaque, UInt32 outputFramesWanted)
+{
+	const UInt32 buffers = m_in.bufferCount();
+	AudioStreamPacketDescription* aspd = nullptr;
+
+	m_inputList->mNumberBuffers = buffers;
+	for (UInt32 i = 0; i < buffers; i++)
+	{
+		m_inputList->mBuffers[i].mNumberChannels = m_in.interleaved ? m_in.channels : 1;
+		m_inputList->mBuffers[i].mDataByteSize = 0;
+		m_inputList->mBuffers[i].mData = nullptr;
+	}
+
+	UInt32 packets = UInt32(std::min<double>(std::ceil(outputFramesWanted * m_in.sampleRate / m_out.sampleRate), MAX_INPUT_REQUEST));
+	packets = std::max<UInt32>(packets, 1);
+
+	m_inputFrames = m_inputOffset = 0;
+
+	OSStatus err = dataProc(converter, &packets, m_inputList, &aspd, opaque);
+	if (err != noErr)
+		return err;
+
+	// the packet count isn't always trustworthy; the buffer sizes are
+	for (UInt32 i = 0; i < buffers; i++)
+	{
+		if (m_inputList->mBuffers[i].mData == nullptr)
+			packets = 0;
+		else
+			packets = std::min(packets, m_inputList->mBuffers[i].mDataByteSize / m_in.bufferFrameSize());
+	}
+
+	m_inputFrames = packets;
+	return noErr;
+}
+
+void PCMConverter::decodeInput(float* dst, UInt32 frames)
+{
+	if (m_in.interleaved)
+	{
+		const uint8_t* src = static_cast<const uint8_t*>(m_inputList->mBuffers[0].mData) + size_t(m_inputOffset) * m_in.bufferFrameSize();
+		decodeSamples(m_in.sample, m_in.bigEndian, src, dst, size_t(frames) * m_in.channels);
+	}
+	else if (m_in.channels == 1)
+	{
+		const uint8_t* src = static_cast<const uint8_t*>(m_inputList->mBuffers[0].mData) + size_t(m_inputOffset) * m_in.bytesPerSample;
+		decodeSamples(m_in.sample, m_in.bigEndian, src, dst, frames);
+	}
+	else
+	{
+		for (UInt32 c = 0; c < m_in.channels; c++)
+		{
+			const uint8_t* src = static_cast<const uint8_t*>(m_inputList->mBuffers[c].mData) + size_t(m_inputOffset) * m_in.bytesPerSample;
+			decodeSamples(m_in.sample, m_in.bigEndian, src, m_planar.get() + c * BLOCK_FRAMES, frames);
+		}
+		interleave(m_planar.get(), m_in.channels, dst, frames);
+	}
+}
+
+void PCMConverter::mapChannels(const float* src, float* dst, UInt32 frames)
+{
+	const UInt32 inChannels = m_in.channels, outChannels = m_out.channels;
+
+	if (m_downmix)
+	{
+		const float scale = 1.0f / inChannels;
+
+		for (UInt32 i = 0; i < frames; i++)
+		{
+			float sum = 0;
+			for (UInt32 c = 0; c < inChannels; c++)
+				sum += src[i * inChannels + c];
+			dst[i] = sum * scale;
+		}
+		return;
+	}
+
+	for (UInt32 i = 0; i < frames; i++)
+	{
+		for (UInt32 c = 0; c < outChannels; c++)
+		{
+			const int from = m_channelMap[c];
+			dst[i * outChannels + c] = (from >= 0) ? src[i * inChannels + from] : 0.0f;
+		}
+	}
+}
+
+void PCMConverter::generateDither(float* noise, size_t count)
+{
+	// triangular noise, +-1 LSB of the dither bit depth (or of the output)
+	float amplitude = 1.0f / 4294967296.0f;
+
+	if (m_ditherBitDepth != 0 && m_ditherBitDepth < m_out.bitsPerChannel)
+		amplitude *= float(1u << std::min<UInt32>(m_out.bitsPerChannel - m_ditherBitDepth, 24));
+
+	uint32_t state = m_ditherState;
+	for (size_t i = 0; i < count; i++)
+	{
+		state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+		const uint32_t a = state;
+		state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+		const uint32_t b = state;
+
+		noise[i] = (float(a) - float(b)) * amplitude;
+	}
+	m_ditherState = state;
+}
+
+void PCMConverter::writeOutput(const float* src, AudioBufferList* outOutputData, UInt32 frameOffset, UInt32 frames)
+{
+	const bool dither = m_ditherAlgorithm != 0 && m_out.sample != SampleFormat::F32 && m_out.sample != SampleFormat::F64
+		&& m_out.bitsPerChannel <= 16;
+	const float* noise = nullptr;
+
+	if (dither)
+	{
+		generateDither(m_noise.get(), size_t(frames) * m_out.channels);
+		noise = m_noise.get();
+	}
+
+	if (m_out.interleaved)
+	{
+		uint8_t* dst = static_cast<uint8_t*>(outOutputData->mBuffers[0].mData) + size_t(frameOffset) * m_out.bufferFrameSize();
+		encodeSamples(m_out.sample, m_out.bigEndian, src, noise, dst, size_t(frames) * m_out.channels);
+	}
+	else if (m_out.channels == 1)
+	{
+		uint8_t* dst = static_cast<uint8_t*>(outOutputData->mBuffers[0].mData) + size_t(frameOffset) * m_out.bytesPerSample;
+		encodeSamples(m_out.sample, m_out.bigEndian, src, noise, dst, frames);
+	}
+	else
+	{
+		deinterleave(src, m_out.channels, m_planar.get(), frames);
+
+		for (UInt32 c = 0; c < m_out.channels; c++)
+		{
+			uint8_t* dst = static_cast<uint8_t*>(outOutputData->mBuffers[c].mData) + size_t(frameOffset) * m_out.bytesPerSample;
+			encodeSamples(m_out.sample, m_out.bigEndian, m_planar.get() + c * BLOCK_FRAMES, noise ? noise + c * frames : nullptr, dst, frames);
+		}
+	}
+}
+
+void PCMConverter::copyThrough(AudioBufferList* outOutputData, UInt32 frameOffset, UInt32 frames)
+{
+	const UInt32 frameSize = m_in.bufferFrameSize();
+
+	for (UInt32 i = 0; i < m_in.bufferCount(); i++)
+	{
+		std::memcpy(static_cast<uint8_t*>(outOutputData->mBuffers[i].mData) + size_t(frameOffset) * frameSize,
+			static_cast<const uint8_t*>(m_inputList->mBuffers[i].mData) + size_t(m_inputOffset) * frameSize,
+			size_t(frames) * frameSize);
+	}
+}
+
+OSStatus PCMConverter::fillComplex(AudioConverterRef converter, AudioConverterComplexInputDataProc dataProc, void* opaque,
+	UInt32* ioOutputDataPacketSize, AudioBufferList* outOutputData)
+{
+	if (outOutputData->mNumberBuffers < m_out.bufferCount())
+		return kAudioConverterErr_InvalidOutputSize;
+
+	UInt32 wanted = *ioOutputDataPacketSize;
+	for (UInt32 i = 0; i < m_out.bufferCount(); i++)
+		wanted = std::min(wanted, outOutputData->mBuffers[i].mDataByteSize / m_out.bufferFrameSize());
+
+	UInt32 produced = 0;
+	OSStatus status = noErr;
+
+	while (produced < wanted)
+	{
+		if (m_pendingFrames > 0)
+		{
+			const UInt32 frames = std::min(m_pendingFrames, wanted - produced);
+
+			writeOutput(m_pending.get() + size_t(m_pendingOffset) * m_out.channels, outOutputData, produced, frames);
+			produced += frames;
+			m_pendingOffset += frames;
+			m_pendingFrames -= frames;
+			continue;
+		}
+		m_pendingOffset = 0;
+
+		if (m_resampler)
+		{
+			const UInt32 frames = m_resampler->produce(m_pending.get(), BLOCK_FRAMES);
+			if (frames > 0)
+			{
+				m_pendingFrames = frames;
+				continue;
+			}
+		}
+
+		if (m_inputFrames == 0)
+		{
+			status = pullInput(converter, dataProc, opaque, wanted - produced);
+			if (status != noErr)
+				break;
+
+			if (m_inputFrames == 0)
+			{
+				// end of input; let the resampler's tail out once
+				if (m_resampler && !m_drained)
+				{
+					m_resampler->drain();
+					m_drained = true;
+					continue;
+				}
+				break;
+			}
+			m_drained = false;
+		}
+
+		if (m_passthrough)
+		{
+			const UInt32 frames = std::min(m_inputFrames, wanted - produced);
+
+			copyThrough(outOutputData, produced, frames);
+			produced += frames;
+			m_inputOffset += frames;
+			m_inputFrames -= frames;
+			continue;
+		}
+
+		UInt32 frames = std::min(m_inputFrames, BLOCK_FRAMES);
+		if (m_resampler)
+			frames = std::min(frames, m_resampler->space());
+
+		float* target = m_resampler ? m_mixed.get() : m_pending.get();
+
+		if (m_identityMap)
+			decodeInput(target, frames);
+		else
+		{
+			decodeInput(m_decoded.get(), frames);
+			mapChannels(m_decoded.get(), target, frames);
+		}
+
+		if (m_resampler)
+			m_resampler->push(target, frames);
+		else
+			m_pendingFrames = frames;
+
+		m_inputOffset += frames;
+		m_inputFrames -= frames;
+	}
+
+	for (UInt32 i = 0; i < m_out.bufferCount(); i++)
+		outOutputData->mBuffers[i].mDataByteSize = produced * m_out.bufferFrameSize();
+	*ioOutputDataPacketSize = produced;
+
+	return (produced > 0) ? noErr : status;
+}
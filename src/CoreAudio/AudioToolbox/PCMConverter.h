@@ -0,0 +1,119 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2020 Lubos Dolezel
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _CA_PCM_CONVERTER_H
+#define _CA_PCM_CONVERTER_H
+#include "AudioConverter.h"
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+// Converts between two linear PCM formats without libavcodec: sample format and endianness,
+// interleaved and non-interleaved buffers, channel count and sample rate (with a polyphase resampler).
+// Samples go through interleaved float32; the kernels for the common formats use SSE2.
+// All buffers are allocated up front, so fillComplex() doesn't allocate.
+class __attribute__((visibility("hidden"))) PCMConverter
+{
+public:
+	enum class SampleFormat
+	{
+		S8, U8, S16,
+		// packed in 3 bytes
+		S24,
+		// in the low 24 bits of 4 bytes
+		S24In32,
+		S32, F32, F64,
+	};
+
+	// Returns false if either format isn't linear PCM we can handle here
+	static bool canConvert(const AudioStreamBasicDescription* inSourceFormat, const AudioStreamBasicDescription* inDestinationFormat);
+
+	PCMConverter(const AudioStreamBasicDescription& sourceFormat, const AudioStreamBasicDescription& destinationFormat);
+	~PCMConverter();
+
+	void reset();
+	OSStatus fillComplex(AudioConverterRef converter, AudioConverterComplexInputDataProc dataProc, void* opaque,
+		UInt32* ioOutputDataPacketSize, AudioBufferList* outOutputData);
+
+	UInt32 dithering() const { return m_ditherAlgorithm; }
+	UInt32 ditherBitDepth() const { return m_ditherBitDepth; }
+	UInt32 quality() const { return m_quality; }
+
+	OSStatus setDithering(UInt32 algorithm);
+	OSStatus setDitherBitDepth(UInt32 bits);
+	OSStatus setQuality(UInt32 quality);
+	// One input channel (or -1 for silence) per output channel
+	OSStatus setChannelMap(const SInt32* map, UInt32 count);
+	void getChannelMap(SInt32* map) const;
+private:
+	struct Format
+	{
+		SampleFormat sample;
+		bool bigEndian;
+		bool interleaved;
+		UInt32 channels;
+		UInt32 bitsPerChannel;
+		UInt32 bytesPerSample;
+		double sampleRate;
+
+		// the stride of a frame in one AudioBuffer
+		UInt32 bufferFrameSize() const { return interleaved ? bytesPerSample * channels : bytesPerSample; }
+		UInt32 bufferCount() const { return interleaved ? 1 : channels; }
+	};
+	class Resampler;
+
+	static bool parseFormat(const AudioStreamBasicDescription& desc, Format& out);
+
+	OSStatus pullInput(AudioConverterRef converter, AudioConverterComplexInputDataProc dataProc, void* opaque, UInt32 outputFramesWanted);
+	void decodeInput(float* dst, UInt32 frames);
+	void mapChannels(const float* src, float* dst, UInt32 frames);
+	void writeOutput(const float* src, AudioBufferList* outOutputData, UInt32 frameOffset, UInt32 frames);
+	void copyThrough(AudioBufferList* outOutputData, UInt32 frameOffset, UInt32 frames);
+	void generateDither(float* noise, size_t count);
+private:
+	Format m_in, m_out;
+	// the formats are the same, so fillComplex() is a copy
+	bool m_passthrough;
+
+	std::vector<int> m_channelMap;
+	bool m_identityMap;
+	// downmix everything into mono, unless the client has set a channel map
+	bool m_downmix;
+
+	UInt32 m_quality;
+	std::unique_ptr<Resampler> m_resampler;
+	// the input has ended and the resampler's tail has been pushed out
+	bool m_drained = false;
+
+	UInt32 m_ditherAlgorithm = 0;
+	UInt32 m_ditherBitDepth = 0;
+	uint32_t m_ditherState = 0x9e3779b9;
+
+	// the AudioBufferList we give to the input callback, and what's left of the data it gave us
+	std::unique_ptr<uint8_t[]> m_inputListStorage;
+	AudioBufferList* m_inputList;
+	UInt32 m_inputFrames = 0, m_inputOffset = 0;
+
+	// converted frames that didn't fit into the caller's buffers yet
+	UInt32 m_pendingFrames = 0, m_pendingOffset = 0;
+
+	std::unique_ptr<float[]> m_decoded, m_mixed, m_pending, m_planar, m_noise;
+};
+
+#endif
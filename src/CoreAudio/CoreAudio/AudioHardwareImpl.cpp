@@ -83,8 +83,11 @@ OSStatus AudioHardwareImpl::start(AudioDeviceIOProcID inProcID,
 	AudioHardwareStream* stream;
 	std::lock_guard<std::mutex> guard(m_procMutex);
 	
-	if (m_streams.find(inProcID) != m_streams.end())
-		return paramErr;
+	{
+		std::lock_guard<std::mutex> streamsGuard(m_streamsMutex);
+		if (m_streams.find(inProcID) != m_streams.end())
+			return paramErr;
+	}
 
 	auto it = m_proc.find(inProcID);
 	
@@ -94,6 +97,7 @@ OSStatus AudioHardwareImpl::start(AudioDeviceIOProcID inProcID,
 	stream = createStream(it->second.first, it->second.second);
 	if (!stream)
 		return kAudioHardwareBadStreamError;
+	std::lock_guard<std::mutex> streamsGuard(m_streamsMutex);
 	m_streams.emplace(std::make_pair(inProcID, std::unique_ptr<AudioHardwareStream>(stream)));
 	
 	// TODO: time
@@ -103,15 +107,21 @@ OSStatus AudioHardwareImpl::start(AudioDeviceIOProcID inProcID,
 
 OSStatus AudioHardwareImpl::stop(AudioDeviceIOProcID inProcID)
 {
-	auto it = m_streams.find(inProcID);
-	if (it == m_streams.end())
-		return kAudioHardwareNotRunningError;
-	
-	AudioHardwareStream* stream = it->second.release();
+	AudioHardwareStream* stream;
+	{
+		std::lock_guard<std::mutex> guard(m_streamsMutex);
+		auto it = m_streams.find(inProcID);
+		if (it == m_streams.end())
+			return kAudioHardwareNotRunningError;
+
+		stream = it->second.release();
+		m_streams.erase(it);
+	}
+
+	// Not under m_streamsMutex: this waits for the IO proc, which may be asking for the current time
 	stream->stop();
 
 	delete stream;
-	m_streams.erase(it);
 	return noErr;
 }
 
@@ -314,20 +324,50 @@ OSStatus AudioHardwareImpl::setBufferSize(uint32_t bufferSize)
 	return noErr;
 }
 
+// The device's clock is the clock of whichever of its streams is running
 OSStatus AudioHardwareImpl::getCurrentTime(AudioTimeStamp* outTime)
 {
+	std::lock_guard<std::mutex> guard(m_streamsMutex);
+
+	for (auto& [procId, stream] : m_streams)
+	{
+		if (stream->getCurrentTime(outTime))
+			return noErr;
+	}
+
 	std::memset(outTime, 0, sizeof(*outTime));
-	return noErr;
+	return kAudioHardwareNotRunningError;
 }
 	
 OSStatus AudioHardwareImpl::translateTime(const AudioTimeStamp* inTime, AudioTimeStamp* outTime)
 {
+	std::lock_guard<std::mutex> guard(m_streamsMutex);
+
+	for (auto& [procId, stream] : m_streams)
+	{
+		if (stream->translateTime(inTime, outTime))
+			return noErr;
+	}
+
 	*outTime = *inTime;
-	return noErr;
+	return kAudioHardwareNotRunningError;
 }
 
 OSStatus AudioHardwareImpl::getNearestStartTime(AudioTimeStamp* ioRequestedStartTime, UInt32 inFlags)
 {
-	std::memset(ioRequestedStartTime, 0, sizeof(*ioRequestedStartTime));
-	return noErr;
+	AudioTimeStamp now;
+	OSStatus err = getCurrentTime(&now);
+
+	if (err != noErr)
+		return err;
+
+	// IO can start on any sample from now on
+	if (!(ioRequestedStartTime->mFlags & kAudioTimeStampSampleTimeValid) || ioRequestedStartTime->mSampleTime < now.mSampleTime)
+	{
+		*ioRequestedStartTime = now;
+		return noErr;
+	}
+
+	AudioTimeStamp requested = *ioRequestedStartTime;
+	return translateTime(&requested, ioRequestedStartTime);
 }
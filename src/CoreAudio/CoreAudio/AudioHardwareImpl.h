@@ -22,6 +22,7 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #include <CoreAudio/AudioHardware.h>
 #include <CoreFoundation/CFString.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include "AudioHardwareStream.h"
 
@@ -82,6 +83,8 @@ protected:
 	std::map<AudioDeviceIOProcID, std::pair<AudioDeviceIOProc, void*>> m_proc;
 	int m_nextProcId = 1;
 	
+	// guards m_streams only; never held while waiting for a stream
+	std::mutex m_streamsMutex;
 	std::map<AudioDeviceIOProcID, std::unique_ptr<AudioHardwareStream>> m_streams;
 	uint32_t m_bufferSize = 8192;
 
@@ -22,11 +22,18 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #include <condition_variable>
 #include <mutex>
 #include <iostream>
+#include <algorithm>
+#include <CoreAudio/HostTime.h>
+
+// How long the rate scalar is measured over, and how much each measurement counts
+static const double RATE_WINDOW_SECONDS = 1.0;
+static const double RATE_SMOOTHING = 0.2;
 
 AudioHardwareStream::AudioHardwareStream(AudioHardwareImpl* hw, bool needBuffer)
 : m_hw(hw)
 {
 	m_bufferSize = hw->bufferSize();
+	m_sampleRate = hw->asbd().mSampleRate;
 
 	if (needBuffer)
 		m_buffer = new uint8_t[m_bufferSize];
@@ -38,3 +45,87 @@ AudioHardwareStream::~AudioHardwareStream()
 {
 	delete m_buffer;
 }
+
+void AudioHardwareStream::updateClock(Float64 sampleTime, uint64_t hostTime)
+{
+	std::lock_guard<std::mutex> guard(m_clockMutex);
+
+	if (!m_clockValid || sampleTime < m_windowSample)
+	{
+		m_windowSample = sampleTime;
+		m_windowHost = hostTime;
+		m_clockValid = true;
+	}
+	else
+	{
+		const double elapsed = AudioConvertHostTimeToNanos(hostTime - m_windowHost) / 1e9;
+
+		if (elapsed >= RATE_WINDOW_SECONDS)
+		{
+			const double measured = (sampleTime - m_windowSample) / (elapsed * m_sampleRate);
+
+			// Ignore nonsense from underruns or a stalled sound server
+			if (measured > 0.95 && measured < 1.05)
+				m_rateScalar += (measured - m_rateScalar) * RATE_SMOOTHING;
+
+			m_windowSample = sampleTime;
+			m_windowHost = hostTime;
+		}
+	}
+
+	m_anchorSample = sampleTime;
+	m_anchorHost = hostTime;
+}
+
+bool AudioHardwareStream::getCurrentTime(AudioTimeStamp* outTime)
+{
+	AudioTimeStamp now = {};
+
+	now.mHostTime = AudioGetCurrentHostTime();
+	now.mFlags = kAudioTimeStampHostTimeValid;
+
+	return translateTime(&now, outTime);
+}
+
+bool AudioHardwareStream::translateTime(const AudioTimeStamp* inTime, AudioTimeStamp* outTime)
+{
+	std::lock_guard<std::mutex> guard(m_clockMutex);
+
+	if (!m_clockValid)
+		return false;
+
+	const Float64 rate = m_sampleRate * m_rateScalar;
+	AudioTimeStamp result = {};
+
+	if (inTime->mFlags & kAudioTimeStampSampleTimeValid)
+	{
+		const Float64 seconds = (inTime->mSampleTime - m_anchorSample) / rate;
+		const int64_t nanos = int64_t(seconds * 1e9);
+
+		result.mSampleTime = inTime->mSampleTime;
+		if (nanos >= 0)
+			result.mHostTime = m_anchorHost + AudioConvertNanosToHostTime(nanos);
+		else
+			result.mHostTime = m_anchorHost - std::min<uint64_t>(m_anchorHost, AudioConvertNanosToHostTime(-nanos));
+	}
+	else if (inTime->mFlags & kAudioTimeStampHostTimeValid)
+	{
+		Float64 seconds;
+
+		if (inTime->mHostTime >= m_anchorHost)
+			seconds = AudioConvertHostTimeToNanos(inTime->mHostTime - m_anchorHost) / 1e9;
+		else
+			seconds = -(AudioConvertHostTimeToNanos(m_anchorHost - inTime->mHostTime) / 1e9);
+
+		result.mHostTime = inTime->mHostTime;
+		result.mSampleTime = m_anchorSample + seconds * rate;
+	}
+	else
+		return false;
+
+	result.mRateScalar = m_rateScalar;
+	result.mFlags = kAudioTimeStampSampleHostTimeValid | kAudioTimeStampRateScalarValid;
+
+	*outTime = result;
+	return true;
+}
@@ -20,6 +20,8 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef AUDIOHARDWARESTREAM_H
 #define AUDIOHARDWARESTREAM_H
 #include <stdint.h>
+#include <mutex>
+#include <CoreAudio/CoreAudioTypes.h>
 
 class AudioHardwareImpl;
 
@@ -31,10 +33,28 @@ public:
 
 	virtual void stop(/*void(^cbDone)()*/) = 0;
 	//void stop();
+
+	// The device's sample time right now, extrapolated from the last IO cycle
+	bool getCurrentTime(AudioTimeStamp* outTime);
+	// Converts between sample time and host time using the stream's clock
+	bool translateTime(const AudioTimeStamp* inTime, AudioTimeStamp* outTime);
+protected:
+	// Called by the IO thread on every cycle: the sample being played or recorded at hostTime
+	void updateClock(Float64 sampleTime, uint64_t hostTime);
 protected:
 	AudioHardwareImpl* m_hw;
 	uint32_t m_bufferSize;
 	uint8_t* m_buffer;
+
+	// Ratio of the device's actual sample rate to the nominal one, measured against the host clock
+	Float64 m_rateScalar = 1.0;
+private:
+	std::mutex m_clockMutex;
+	bool m_clockValid = false;
+	Float64 m_sampleRate;
+	// the most recent clock sample, and the start of the rate measurement window
+	Float64 m_anchorSample = 0, m_windowSample = 0;
+	uint64_t m_anchorHost = 0, m_windowHost = 0;
 };
 
 #endif /* AUDIOHARDWARESTREAM_H */
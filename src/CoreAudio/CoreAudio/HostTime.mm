@@ -1,8 +1,49 @@
 #include "CoreAudio/HostTime.h"
-#include "stub.h"
+#include <mach/mach_time.h>
+
+// mach_absolute_time() is read from the commpage, so it's as cheap as a clock can get.
+// The timebase never changes, so look it up only once.
+static const mach_timebase_info_data_t& hostTimebase()
+{
+	static const mach_timebase_info_data_t timebase = [] {
+		mach_timebase_info_data_t info;
+		if (mach_timebase_info(&info) != KERN_SUCCESS || !info.numer || !info.denom)
+			info.numer = info.denom = 1;
+		return info;
+	}();
+	return timebase;
+}
 
 UInt64 AudioGetCurrentHostTime(void)
 {
-    STUB();
-    return 0;
+	return mach_absolute_time();
+}
+
+Float64 AudioGetHostClockFrequency(void)
+{
+	const mach_timebase_info_data_t& timebase = hostTimebase();
+	return 1e9 * timebase.denom / timebase.numer;
+}
+
+UInt32 AudioGetHostClockMinimumTimeDelta(void)
+{
+	return 1;
+}
+
+UInt64 AudioConvertHostTimeToNanos(UInt64 inHostTime)
+{
+	const mach_timebase_info_data_t& timebase = hostTimebase();
+
+	if (timebase.numer == timebase.denom)
+		return inHostTime;
+	return UInt64((unsigned __int128) inHostTime * timebase.numer / timebase.denom);
+}
+
+UInt64 AudioConvertNanosToHostTime(UInt64 inNanos)
+{
+	const mach_timebase_info_data_t& timebase = hostTimebase();
+
+	if (timebase.numer == timebase.denom)
+		return inNanos;
+	return UInt64((unsigned __int128) inNanos * timebase.denom / timebase.numer);
 }
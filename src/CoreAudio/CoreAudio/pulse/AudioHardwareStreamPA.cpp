@@ -22,6 +22,8 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 #include <type_traits>
 #include <limits>
+#include <algorithm>
+#include <CoreAudio/HostTime.h>
 
 AudioHardwareStreamPA::AudioHardwareStreamPA(AudioHardwareImplPA* hw, AudioDeviceIOProc callback, void* clientData)
 : AudioHardwareStream(hw, false), m_callback(callback), m_clientData(clientData)
@@ -41,6 +43,7 @@ AudioHardwareStreamPA::AudioHardwareStreamPA(AudioHardwareImplPA* hw, AudioDevic
 			return;
 		}
 
+		m_frameSize = pa_frame_size(&spec);
 		m_stream = pa_stream_new(context, "CoreAudio", &spec, nullptr);
 
 		//pa_stream_set_state_callback(m_stream, [](pa_stream *s, void *userdata) {
@@ -68,6 +71,43 @@ void AudioHardwareStreamPA::start()
 	m_running = true;
 }
 
+void AudioHardwareStreamPA::makeTimeStamps(AudioTimeStamp& now, AudioTimeStamp& ioTime, bool output)
+{
+	const uint64_t hostNow = AudioGetCurrentHostTime();
+	pa_usec_t latency = 0;
+	int negative = 0;
+
+	// PA_STREAM_AUTO_TIMING_UPDATE keeps the timing info fresh; until the first update, assume no latency
+	if (pa_stream_get_latency(m_stream, &latency, &negative) != 0 || negative)
+		latency = 0;
+
+	const Float64 latencyFrames = latency * m_hw->asbd().mSampleRate / 1e6;
+	const uint64_t latencyHost = AudioConvertNanosToHostTime(latency * 1000);
+
+	now = {};
+	ioTime = {};
+
+	// Output: what we write now is heard after the latency.
+	// Input: what we read now was captured the latency ago.
+	ioTime.mSampleTime = Float64(m_framesTransferred);
+	if (output)
+	{
+		ioTime.mHostTime = hostNow + latencyHost;
+		now.mSampleTime = ioTime.mSampleTime - latencyFrames;
+	}
+	else
+	{
+		ioTime.mHostTime = hostNow - std::min(hostNow, latencyHost);
+		now.mSampleTime = ioTime.mSampleTime + latencyFrames;
+	}
+	now.mHostTime = hostNow;
+
+	updateClock(now.mSampleTime, hostNow);
+
+	now.mRateScalar = ioTime.mRateScalar = m_rateScalar;
+	now.mFlags = ioTime.mFlags = kAudioTimeStampSampleHostTimeValid | kAudioTimeStampRateScalarValid;
+}
+
 void AudioHardwareStreamPA::stop()
 {
 	std::unique_lock<std::mutex> l(m_stopMutex);
@@ -36,12 +36,17 @@ public:
 protected:
 	virtual void start();
 	void transformSignedUnsigned(AudioBufferList* abl) const;
+	// Timestamps for an IO cycle transferring the frame at m_framesTransferred, based on the stream's latency.
+	// Must be called on the PA main loop.
+	void makeTimeStamps(AudioTimeStamp& now, AudioTimeStamp& ioTime, bool output);
 protected:
 	AudioDeviceIOProc m_callback;
 	void* m_clientData;
 	pa_stream* m_stream;
 	void(^m_cbDone)();
 	bool m_convertSignedUnsigned = false;
+	size_t m_frameSize = 0;
+	uint64_t m_framesTransferred = 0;
 
 	bool m_running = false;
 	std::mutex m_stopMutex;
@@ -37,7 +37,7 @@ void AudioHardwareStreamPAInput::paStreamReadCB(pa_stream* s, size_t length, voi
 	if (!This->m_running)
 		return;
 
-	AudioTimeStamp fake = {0};
+	AudioTimeStamp now, inputTime;
 	AudioBufferList* abl = static_cast<AudioBufferList*>(alloca(sizeof(AudioBufferList) + sizeof(AudioBuffer)));
 	std::vector<uint8_t> hole;
 
@@ -72,9 +72,11 @@ void AudioHardwareStreamPAInput::paStreamReadCB(pa_stream* s, size_t length, voi
 			This->transformSignedUnsigned(abl);
 
 		// std::cout << "AudioHardwareStreamPAInput::paStreamReadCB(): bytes=" << nbytes << std::endl;
-		OSStatus status = This->m_callback(This->m_hw->id(), &fake, abl, &fake, nullptr, nullptr, This->m_clientData);
+		This->makeTimeStamps(now, inputTime, false);
+		OSStatus status = This->m_callback(This->m_hw->id(), &now, abl, &inputTime, nullptr, nullptr, This->m_clientData);
 
 		pa_stream_drop(This->m_stream);
+		This->m_framesTransferred += nbytes / This->m_frameSize;
 
 		if (status != noErr)
 		{
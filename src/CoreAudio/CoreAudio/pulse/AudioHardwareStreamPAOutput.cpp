@@ -40,7 +40,7 @@ void AudioHardwareStreamPAOutput::paStreamWriteCB(pa_stream* s, size_t length, v
 
 	// std::cout << "AudioHardwareStreamPAOutput::paStreamWriteCB()\n";
 
-	AudioTimeStamp fake = {0};
+	AudioTimeStamp now, outputTime;
 	AudioBufferList* abl = static_cast<AudioBufferList*>(alloca(sizeof(AudioBufferList) + sizeof(AudioBuffer)));
 
 	size_t done = 0;
@@ -60,7 +60,8 @@ void AudioHardwareStreamPAOutput::paStreamWriteCB(pa_stream* s, size_t length, v
 		abl->mBuffers[0].mDataByteSize = rqsize;
 
 		// Call the client for more data
-		OSStatus status = This->m_callback(This->m_hw->id(), &fake, nullptr, nullptr, abl, &fake, This->m_clientData);
+		This->makeTimeStamps(now, outputTime, true);
+		OSStatus status = This->m_callback(This->m_hw->id(), &now, nullptr, nullptr, abl, &outputTime, This->m_clientData);
 		if (status != noErr || !abl->mBuffers[0].mDataByteSize)
 		{
 			// std::cerr << "AudioDeviceIOProc returned " << status << ", corking...\n";
@@ -82,6 +83,7 @@ void AudioHardwareStreamPAOutput::paStreamWriteCB(pa_stream* s, size_t length, v
 			}
 			//else
 			//	std::cout << "pa_stream_write() OK\n";
+			This->m_framesTransferred += abl->mBuffers[0].mDataByteSize / This->m_frameSize;
 		}
 
 		done += abl->mBuffers[0].mDataByteSize;
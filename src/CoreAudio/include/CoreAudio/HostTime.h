@@ -3,6 +3,20 @@
 
 #include "MacTypes.h"
 
-extern "C" UInt64 AudioGetCurrentHostTime(void);
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Host time is mach_absolute_time()
+UInt64 AudioGetCurrentHostTime(void);
+Float64 AudioGetHostClockFrequency(void);
+UInt32 AudioGetHostClockMinimumTimeDelta(void);
+
+UInt64 AudioConvertHostTimeToNanos(UInt64 inHostTime);
+UInt64 AudioConvertNanosToHostTime(UInt64 inNanos);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif // COREAUDIOHOSTTIME_H
@@ -0,0 +1,313 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2026 Darling Developers
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <mach-o/loader.h>
+#include <mach-o/fat.h>
+#include <mach-o/nlist.h>
+#include <string.h>
+#include <libgen.h>
+#include <errno.h>
+#include "../xtrace/mig_index.h"
+
+// Generates the index of the xtrace-mig subsystems (see src/xtrace/mig_index.h) from the built dylibs.
+// The dylibs can't be loaded here, so their xtrace_mig_subsystem is read straight out of the x86_64 slice,
+// relying on the pointers in the file being the unslid addresses they point to (i.e. no chained fixups).
+
+#ifndef LC_DYLD_CHAINED_FIXUPS
+#	define LC_DYLD_CHAINED_FIXUPS 0x80000034
+#endif
+
+// struct xtrace_mig_subsystem and struct xtrace_mig_routine_desc, as laid out for x86_64
+struct subsystem64
+{
+	uint64_t name;
+	int32_t base;
+	uint32_t padding;
+	uint64_t routine_cnt;
+	uint64_t routines;
+};
+
+struct routine_desc64
+{
+	int32_t present;
+	int32_t reply_present;
+	uint64_t name;
+	uint64_t routine;
+};
+
+struct image
+{
+	const uint8_t* data;
+	size_t size;
+	const struct mach_header_64* mhdr;
+};
+
+static const struct mach_header_64* findSlice(const uint8_t* data, size_t size);
+static const void* addressToPointer(const struct image* image, uint64_t address, uint64_t length);
+static const char* addressToString(const struct image* image, uint64_t address);
+static bool readSubsystem(const char* path, const struct image* image, struct xtrace_mig_index_subsystem_input* input);
+
+int main(int argc, const char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "xtrace-mig-index: Generates the index of the xtrace MIG subsystems\n");
+		fprintf(stderr, "Usage: xtrace-mig-index <output> <xtrace-mig-dylib>...\n");
+		return EXIT_FAILURE;
+	}
+
+	const size_t cnt = argc - 2;
+	struct xtrace_mig_index_file_input* files = (struct xtrace_mig_index_file_input*) calloc(cnt ? cnt : 1, sizeof(*files));
+	struct xtrace_mig_index_subsystem_input* subsystems = (struct xtrace_mig_index_subsystem_input*) calloc(cnt ? cnt : 1, sizeof(*subsystems));
+	size_t subsystemCount = 0;
+
+	if (!files || !subsystems)
+	{
+		perror("calloc");
+		return EXIT_FAILURE;
+	}
+
+	for (size_t i = 0; i < cnt; i++)
+	{
+		const char* path = argv[i + 2];
+		struct stat st;
+
+		int fd = open(path, O_RDONLY);
+		if (fd == -1 || fstat(fd, &st) == -1)
+		{
+			fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+			return EXIT_FAILURE;
+		}
+
+		char* pathCopy = strdup(path);
+		files[i].name = strdup(basename(pathCopy));
+		files[i].size = st.st_size;
+		files[i].mtime = st.st_mtim.tv_sec;
+		free(pathCopy);
+
+		void* mem = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (mem == MAP_FAILED)
+		{
+			perror("mmap");
+			return EXIT_FAILURE;
+		}
+
+		struct image image = { (const uint8_t*) mem, (size_t) st.st_size, findSlice((const uint8_t*) mem, st.st_size) };
+
+		// like at runtime, a file without a usable subsystem is still part of the directory, it just isn't indexed;
+		// the strings stay in the mapping until the index has been built
+		if (image.mhdr != NULL)
+		{
+			subsystems[subsystemCount].file_name = files[i].name;
+			if (readSubsystem(path, &image, &subsystems[subsystemCount]))
+				subsystemCount++;
+		}
+		else
+			fprintf(stderr, "xtrace-mig-index: %s: no x86_64 Mach-O image\n", path);
+	}
+
+	const struct xtrace_mig_index_header* index = xtrace_mig_index_build(subsystems, subsystemCount, files, cnt);
+	if (!index)
+	{
+		fprintf(stderr, "xtrace-mig-index: failed to build the index\n");
+		return EXIT_FAILURE;
+	}
+
+	FILE* out = fopen(argv[1], "wb");
+	if (!out)
+	{
+		fprintf(stderr, "Cannot open %s: %s\n", argv[1], strerror(errno));
+		return EXIT_FAILURE;
+	}
+
+	if (fwrite(index, index->size, 1, out) != 1 || fclose(out) != 0)
+	{
+		fprintf(stderr, "Cannot write %s: %s\n", argv[1], strerror(errno));
+		unlink(argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static const struct mach_header_64* findSlice(const uint8_t* data, size_t size)
+{
+	const struct fat_header* fhdr = (const struct fat_header*) data;
+
+	if (size < sizeof(struct mach_header_64))
+		return NULL;
+
+	if (fhdr->magic == FAT_CIGAM || fhdr->magic == FAT_MAGIC)
+	{
+		const bool swap = fhdr->magic == FAT_CIGAM;
+		const struct fat_arch* fa = (const struct fat_arch*) (fhdr + 1);
+		const uint32_t count = swap ? __builtin_bswap32(fhdr->nfat_arch) : fhdr->nfat_arch;
+
+		for (uint32_t i = 0; i < count && (const uint8_t*) (fa + i + 1) <= data + size; i++)
+		{
+			const uint32_t cputype = swap ? __builtin_bswap32(fa[i].cputype) : (uint32_t) fa[i].cputype;
+			const uint32_t offset = swap ? __builtin_bswap32(fa[i].offset) : fa[i].offset;
+
+			if (cputype == CPU_TYPE_X86_64 && offset <= size - sizeof(struct mach_header_64))
+				return findSlice(data + offset, size - offset);
+		}
+		return NULL;
+	}
+
+	const struct mach_header_64* mhdr = (const struct mach_header_64*) data;
+	if (mhdr->magic != MH_MAGIC_64 || mhdr->cputype != CPU_TYPE_X86_64 || mhdr->sizeofcmds > size - sizeof(*mhdr))
+		return NULL;
+
+	return mhdr;
+}
+
+// returns NULL unless `length` bytes at `address` are backed by the file
+static const void* addressToPointer(const struct image* image, uint64_t address, uint64_t length)
+{
+	const uint8_t* command = (const uint8_t*) (image->mhdr + 1);
+	const size_t sliceSize = image->size - ((const uint8_t*) image->mhdr - image->data);
+
+	for (uint32_t i = 0; i < image->mhdr->ncmds; i++)
+	{
+		const struct load_command* lc = (const struct load_command*) command;
+
+		if (lc->cmd == LC_SEGMENT_64)
+		{
+			const struct segment_command_64* seg = (const struct segment_command_64*) lc;
+
+			if (address >= seg->vmaddr && address - seg->vmaddr <= seg->filesize && length <= seg->filesize - (address - seg->vmaddr)
+				&& seg->fileoff + seg->filesize <= sliceSize)
+			{
+				return (const uint8_t*) image->mhdr + seg->fileoff + (address - seg->vmaddr);
+			}
+		}
+
+		command += lc->cmdsize;
+	}
+
+	return NULL;
+}
+
+static const char* addressToString(const struct image* image, uint64_t address)
+{
+	const char* string = (const char*) addressToPointer(image, address, 1);
+	if (!string)
+		return NULL;
+
+	// it has to end within the file
+	const char* end = (const char*) image->data + image->size;
+	if (memchr(string, '\0', end - string) == NULL)
+		return NULL;
+
+	return string;
+}
+
+static bool readSubsystem(const char* path, const struct image* image, struct xtrace_mig_index_subsystem_input* input)
+{
+	const uint8_t* command = (const uint8_t*) (image->mhdr + 1);
+	const uint8_t* slice = (const uint8_t*) image->mhdr;
+	const struct symtab_command* symtab = NULL;
+
+	for (uint32_t i = 0; i < image->mhdr->ncmds; i++)
+	{
+		const struct load_command* lc = (const struct load_command*) command;
+
+		if (lc->cmd == LC_SYMTAB)
+			symtab = (const struct symtab_command*) lc;
+		else if (lc->cmd == LC_DYLD_CHAINED_FIXUPS)
+		{
+			fprintf(stderr, "xtrace-mig-index: %s: chained fixups are not supported\n", path);
+			return false;
+		}
+
+		command += lc->cmdsize;
+	}
+
+	if (!symtab || symtab->symoff + (uint64_t) symtab->nsyms * sizeof(struct nlist_64) > image->size || symtab->stroff + (uint64_t) symtab->strsize > image->size)
+	{
+		fprintf(stderr, "xtrace-mig-index: %s: no symbol table\n", path);
+		return false;
+	}
+
+	const struct nlist_64* symbols = (const struct nlist_64*) (slice + symtab->symoff);
+	const char* strings = (const char*) (slice + symtab->stroff);
+	const struct subsystem64* subsystem = NULL;
+
+	for (uint32_t i = 0; i < symtab->nsyms; i++)
+	{
+		if ((symbols[i].n_type & N_STAB) || (symbols[i].n_type & N_TYPE) != N_SECT || symbols[i].n_un.n_strx >= symtab->strsize)
+			continue;
+		if (strncmp(strings + symbols[i].n_un.n_strx, "_xtrace_mig_subsystem", symtab->strsize - symbols[i].n_un.n_strx) == 0)
+		{
+			subsystem = (const struct subsystem64*) addressToPointer(image, symbols[i].n_value, sizeof(struct subsystem64));
+			break;
+		}
+	}
+
+	if (!subsystem)
+	{
+		fprintf(stderr, "xtrace-mig-index: %s: no xtrace_mig_subsystem\n", path);
+		return false;
+	}
+
+	if (subsystem->routine_cnt > UINT32_MAX)
+	{
+		fprintf(stderr, "xtrace-mig-index: %s: malformed xtrace_mig_subsystem\n", path);
+		return false;
+	}
+
+	const struct routine_desc64* routines = (const struct routine_desc64*) addressToPointer(image, subsystem->routines, subsystem->routine_cnt * sizeof(struct routine_desc64));
+	struct xtrace_mig_index_routine_input* inputs = (struct xtrace_mig_index_routine_input*) calloc(subsystem->routine_cnt ? subsystem->routine_cnt : 1, sizeof(*inputs));
+
+	input->name = addressToString(image, subsystem->name);
+	input->base = subsystem->base;
+	input->routine_cnt = (uint32_t) subsystem->routine_cnt;
+	input->routines = inputs;
+
+	if (!input->name || (!routines && subsystem->routine_cnt > 0) || !inputs)
+	{
+		fprintf(stderr, "xtrace-mig-index: %s: malformed xtrace_mig_subsystem\n", path);
+		free(inputs);
+		return false;
+	}
+
+	for (uint64_t i = 0; i < subsystem->routine_cnt; i++)
+	{
+		inputs[i].present = routines[i].present != 0;
+		inputs[i].reply_present = routines[i].reply_present != 0;
+		inputs[i].name = inputs[i].present ? addressToString(image, routines[i].name) : "";
+
+		if (!inputs[i].name)
+		{
+			fprintf(stderr, "xtrace-mig-index: %s: malformed routine %llu\n", path, (unsigned long long) i);
+			free(inputs);
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -21,6 +21,23 @@
 #ifndef _BLAS_H_
 #define _BLAS_H_
 
+enum CBLAS_ORDER { CblasRowMajor = 101, CblasColMajor = 102 };
+enum CBLAS_TRANSPOSE { CblasNoTrans = 111, CblasTrans = 112, CblasConjTrans = 113, AtlasConj = 114 };
+enum CBLAS_UPLO { CblasUpper = 121, CblasLower = 122 };
+enum CBLAS_DIAG { CblasNonUnit = 131, CblasUnit = 132 };
+enum CBLAS_SIDE { CblasLeft = 141, CblasRight = 142 };
+
+typedef enum CBLAS_ORDER CBLAS_ORDER;
+typedef enum CBLAS_TRANSPOSE CBLAS_TRANSPOSE;
+typedef enum CBLAS_UPLO CBLAS_UPLO;
+typedef enum CBLAS_DIAG CBLAS_DIAG;
+typedef enum CBLAS_SIDE CBLAS_SIDE;
+
+#define CBLAS_INDEX int
+
+// Called with the routine and the offending parameter instead of printing an error and aborting
+typedef void (*BLASParamErrorProc)(const char *funcName, const char *paramName, const int *paramPos, const int *paramValue);
+
 void* APL_dgemm(void);
 void* APL_dgemm_LU(void);
 void* APL_dgemm_QR(void);
@@ -29,7 +46,7 @@ void* APL_sgemm(void);
 void* APL_sgemm_LU(void);
 void* APL_sgemm_QR(void);
 void* APL_strsm(void);
-void* APPLE_NTHREADS(void);
+int APPLE_NTHREADS(void);
 void* ATLU_DestroyThreadMemory(void);
 void* CAXPY(void);
 void* CAXPY_(void);
@@ -101,163 +118,163 @@ void* CTRSM(void);
 void* CTRSM_(void);
 void* CTRSV(void);
 void* CTRSV_(void);
-void* DASUM(void);
-void* DASUM_(void);
-void* DAXPY(void);
-void* DAXPY_(void);
+double DASUM(const int *__N, const double *__X, const int *__incX);
+double DASUM_(const int *__N, const double *__X, const int *__incX);
+void DAXPY(const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Y, const int *__incY);
+void DAXPY_(const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Y, const int *__incY);
 void* DCABS1(void);
 void* DCABS1_(void);
-void* DCOPY(void);
-void* DCOPY_(void);
-void* DDOT(void);
-void* DDOT_(void);
-void* DGBMV(void);
-void* DGBMV_(void);
-void* DGEMM(void);
-void* DGEMM_(void);
-void* DGEMV(void);
-void* DGEMV_(void);
-void* DGER(void);
-void* DGER_(void);
-void* DNRM2(void);
-void* DNRM2_(void);
-void* DROT(void);
-void* DROTG(void);
-void* DROTG_(void);
-void* DROTM(void);
-void* DROTMG(void);
-void* DROTMG_(void);
-void* DROTM_(void);
-void* DROT_(void);
-void* DSBMV(void);
-void* DSBMV_(void);
-void* DSCAL(void);
-void* DSCAL_(void);
-void* DSDOT(void);
-void* DSDOT_(void);
-void* DSPMV(void);
-void* DSPMV_(void);
-void* DSPR(void);
-void* DSPR2(void);
-void* DSPR2_(void);
-void* DSPR_(void);
-void* DSWAP(void);
-void* DSWAP_(void);
-void* DSYMM(void);
-void* DSYMM_(void);
-void* DSYMV(void);
-void* DSYMV_(void);
-void* DSYR(void);
-void* DSYR2(void);
-void* DSYR2K(void);
-void* DSYR2K_(void);
-void* DSYR2_(void);
-void* DSYRK(void);
-void* DSYRK_(void);
-void* DSYR_(void);
-void* DTBMV(void);
-void* DTBMV_(void);
-void* DTBSV(void);
-void* DTBSV_(void);
-void* DTPMV(void);
-void* DTPMV_(void);
-void* DTPSV(void);
-void* DTPSV_(void);
-void* DTRMM(void);
-void* DTRMM_(void);
-void* DTRMV(void);
-void* DTRMV_(void);
-void* DTRSM(void);
-void* DTRSM_(void);
-void* DTRSV(void);
-void* DTRSV_(void);
+void DCOPY(const int *__N, const double *__X, const int *__incX, double *__Y, const int *__incY);
+void DCOPY_(const int *__N, const double *__X, const int *__incX, double *__Y, const int *__incY);
+double DDOT(const int *__N, const double *__X, const int *__incX, const double *__Y, const int *__incY);
+double DDOT_(const int *__N, const double *__X, const int *__incX, const double *__Y, const int *__incY);
+void DGBMV(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DGBMV_(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DGEMM(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DGEMM_(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DGEMV(const char *__Trans, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DGEMV_(const char *__Trans, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DGER(const int *__M, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void DGER_(const int *__M, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+double DNRM2(const int *__N, const double *__X, const int *__incX);
+double DNRM2_(const int *__N, const double *__X, const int *__incX);
+void DROT(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__c, const double *__s);
+void DROTG(double *__a, double *__b, double *__c, double *__s);
+void DROTG_(double *__a, double *__b, double *__c, double *__s);
+void DROTM(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__P);
+void DROTMG(double *__d1, double *__d2, double *__b1, const double *__b2, double *__P);
+void DROTMG_(double *__d1, double *__d2, double *__b1, const double *__b2, double *__P);
+void DROTM_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__P);
+void DROT_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__c, const double *__s);
+void DSBMV(const char *__Uplo, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSBMV_(const char *__Uplo, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSCAL(const int *__N, const double *__alpha, double *__X, const int *__incX);
+void DSCAL_(const int *__N, const double *__alpha, double *__X, const int *__incX);
+double DSDOT(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double DSDOT_(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+void DSPMV(const char *__Uplo, const int *__N, const double *__alpha, const double *__Ap, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSPMV_(const char *__Uplo, const int *__N, const double *__alpha, const double *__Ap, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSPR(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Ap);
+void DSPR2(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__Ap);
+void DSPR2_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__Ap);
+void DSPR_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Ap);
+void DSWAP(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY);
+void DSWAP_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY);
+void DSYMM(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DSYMM_(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DSYMV(const char *__Uplo, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSYMV_(const char *__Uplo, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void DSYR(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__A, const int *__lda);
+void DSYR2(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void DSYR2K(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DSYR2K_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void DSYR2_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void DSYRK(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__beta, double *__C, const int *__ldc);
+void DSYRK_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__beta, double *__C, const int *__ldc);
+void DSYR_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__A, const int *__lda);
+void DTBMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTBMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTBSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTBSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTPMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void DTPMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void DTPSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void DTPSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void DTRMM(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void DTRMM_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void DTRMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTRMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTRSM(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void DTRSM_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void DTRSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void DTRSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
 void* DZASUM(void);
 void* DZASUM_(void);
 void* DZNRM2(void);
 void* DZNRM2_(void);
 void* ICAMAX(void);
 void* ICAMAX_(void);
-void* IDAMAX(void);
-void* IDAMAX_(void);
-void* ISAMAX(void);
-void* ISAMAX_(void);
+int IDAMAX(const int *__N, const double *__X, const int *__incX);
+int IDAMAX_(const int *__N, const double *__X, const int *__incX);
+int ISAMAX(const int *__N, const float *__X, const int *__incX);
+int ISAMAX_(const int *__N, const float *__X, const int *__incX);
 void* IZAMAX(void);
 void* IZAMAX_(void);
-void* SASUM(void);
-void* SASUM_(void);
-void* SAXPY(void);
-void* SAXPY_(void);
+double SASUM(const int *__N, const float *__X, const int *__incX);
+double SASUM_(const int *__N, const float *__X, const int *__incX);
+void SAXPY(const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Y, const int *__incY);
+void SAXPY_(const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Y, const int *__incY);
 void* SCASUM(void);
 void* SCASUM_(void);
 void* SCNRM2(void);
 void* SCNRM2_(void);
-void* SCOPY(void);
-void* SCOPY_(void);
-void* SDOT(void);
-void* SDOT_(void);
-void* SDSDOT(void);
-void* SDSDOT_(void);
-void* SGBMV(void);
-void* SGBMV_(void);
-void* SGEMM(void);
-void* SGEMM_(void);
-void* SGEMV(void);
-void* SGEMV_(void);
-void* SGER(void);
-void* SGER_(void);
-void* SNRM2(void);
-void* SNRM2_(void);
-void* SROT(void);
-void* SROTG(void);
-void* SROTG_(void);
-void* SROTM(void);
-void* SROTMG(void);
-void* SROTMG_(void);
-void* SROTM_(void);
-void* SROT_(void);
-void* SSBMV(void);
-void* SSBMV_(void);
-void* SSCAL(void);
-void* SSCAL_(void);
-void* SSPMV(void);
-void* SSPMV_(void);
-void* SSPR(void);
-void* SSPR2(void);
-void* SSPR2_(void);
-void* SSPR_(void);
-void* SSWAP(void);
-void* SSWAP_(void);
-void* SSYMM(void);
-void* SSYMM_(void);
-void* SSYMV(void);
-void* SSYMV_(void);
-void* SSYR(void);
-void* SSYR2(void);
-void* SSYR2K(void);
-void* SSYR2K_(void);
-void* SSYR2_(void);
-void* SSYRK(void);
-void* SSYRK_(void);
-void* SSYR_(void);
-void* STBMV(void);
-void* STBMV_(void);
-void* STBSV(void);
-void* STBSV_(void);
-void* STPMV(void);
-void* STPMV_(void);
-void* STPSV(void);
-void* STPSV_(void);
-void* STRMM(void);
-void* STRMM_(void);
-void* STRMV(void);
-void* STRMV_(void);
-void* STRSM(void);
-void* STRSM_(void);
-void* STRSV(void);
-void* STRSV_(void);
-void* SetBLASParamErrorProc(void);
-void* XERBLA(void);
-void* XERBLA_(void);
+void SCOPY(const int *__N, const float *__X, const int *__incX, float *__Y, const int *__incY);
+void SCOPY_(const int *__N, const float *__X, const int *__incX, float *__Y, const int *__incY);
+double SDOT(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double SDOT_(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double SDSDOT(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double SDSDOT_(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+void SGBMV(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SGBMV_(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SGEMM(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SGEMM_(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SGEMV(const char *__Trans, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SGEMV_(const char *__Trans, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SGER(const int *__M, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void SGER_(const int *__M, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+double SNRM2(const int *__N, const float *__X, const int *__incX);
+double SNRM2_(const int *__N, const float *__X, const int *__incX);
+void SROT(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__c, const float *__s);
+void SROTG(float *__a, float *__b, float *__c, float *__s);
+void SROTG_(float *__a, float *__b, float *__c, float *__s);
+void SROTM(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__P);
+void SROTMG(float *__d1, float *__d2, float *__b1, const float *__b2, float *__P);
+void SROTMG_(float *__d1, float *__d2, float *__b1, const float *__b2, float *__P);
+void SROTM_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__P);
+void SROT_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__c, const float *__s);
+void SSBMV(const char *__Uplo, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSBMV_(const char *__Uplo, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSCAL(const int *__N, const float *__alpha, float *__X, const int *__incX);
+void SSCAL_(const int *__N, const float *__alpha, float *__X, const int *__incX);
+void SSPMV(const char *__Uplo, const int *__N, const float *__alpha, const float *__Ap, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSPMV_(const char *__Uplo, const int *__N, const float *__alpha, const float *__Ap, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSPR(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Ap);
+void SSPR2(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__Ap);
+void SSPR2_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__Ap);
+void SSPR_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Ap);
+void SSWAP(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY);
+void SSWAP_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY);
+void SSYMM(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SSYMM_(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SSYMV(const char *__Uplo, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSYMV_(const char *__Uplo, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void SSYR(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__A, const int *__lda);
+void SSYR2(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void SSYR2K(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SSYR2K_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void SSYR2_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void SSYRK(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__beta, float *__C, const int *__ldc);
+void SSYRK_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__beta, float *__C, const int *__ldc);
+void SSYR_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__A, const int *__lda);
+void STBMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STBMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STBSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STBSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STPMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void STPMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void STPSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void STPSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void STRMM(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void STRMM_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void STRMV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STRMV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STRSM(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void STRSM_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void STRSV(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void STRSV_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void SetBLASParamErrorProc(BLASParamErrorProc __ErrorProc);
+void XERBLA(const char *__srname, const int *__info);
+void XERBLA_(const char *__srname, const int *__info);
 void* ZAXPY(void);
 void* ZAXPY_(void);
 void* ZCOPY(void);
@@ -375,84 +392,84 @@ void* cblas_ctrmm(void);
 void* cblas_ctrmv(void);
 void* cblas_ctrsm(void);
 void* cblas_ctrsv(void);
-void* cblas_dasum(void);
-void* cblas_daxpy(void);
-void* cblas_dcopy(void);
-void* cblas_ddot(void);
-void* cblas_dgbmv(void);
-void* cblas_dgemm(void);
-void* cblas_dgemv(void);
-void* cblas_dger(void);
-void* cblas_dnrm2(void);
-void* cblas_drot(void);
-void* cblas_drotg(void);
-void* cblas_drotm(void);
-void* cblas_drotmg(void);
-void* cblas_dsbmv(void);
-void* cblas_dscal(void);
-void* cblas_dsdot(void);
-void* cblas_dspmv(void);
-void* cblas_dspr(void);
-void* cblas_dspr2(void);
-void* cblas_dswap(void);
-void* cblas_dsymm(void);
-void* cblas_dsymv(void);
-void* cblas_dsyr(void);
-void* cblas_dsyr2(void);
-void* cblas_dsyr2k(void);
-void* cblas_dsyrk(void);
-void* cblas_dtbmv(void);
-void* cblas_dtbsv(void);
-void* cblas_dtpmv(void);
-void* cblas_dtpsv(void);
-void* cblas_dtrmm(void);
-void* cblas_dtrmv(void);
-void* cblas_dtrsm(void);
-void* cblas_dtrsv(void);
+double cblas_dasum(const int __N, const double *__X, const int __incX);
+void cblas_daxpy(const int __N, const double __alpha, const double *__X, const int __incX, double *__Y, const int __incY);
+void cblas_dcopy(const int __N, const double *__X, const int __incX, double *__Y, const int __incY);
+double cblas_ddot(const int __N, const double *__X, const int __incX, const double *__Y, const int __incY);
+void cblas_dgbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const int __KL, const int __KU, const double __alpha, const double *__A, const int __lda, const double *__X, const int __incX, const double __beta, double *__Y, const int __incY);
+void cblas_dgemm(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_TRANSPOSE __TransB, const int __M, const int __N, const int __K, const double __alpha, const double *__A, const int __lda, const double *__B, const int __ldb, const double __beta, double *__C, const int __ldc);
+void cblas_dgemv(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const double __alpha, const double *__A, const int __lda, const double *__X, const int __incX, const double __beta, double *__Y, const int __incY);
+void cblas_dger(const enum CBLAS_ORDER __Order, const int __M, const int __N, const double __alpha, const double *__X, const int __incX, const double *__Y, const int __incY, double *__A, const int __lda);
+double cblas_dnrm2(const int __N, const double *__X, const int __incX);
+void cblas_drot(const int __N, double *__X, const int __incX, double *__Y, const int __incY, const double __c, const double __s);
+void cblas_drotg(double *__a, double *__b, double *__c, double *__s);
+void cblas_drotm(const int __N, double *__X, const int __incX, double *__Y, const int __incY, const double *__P);
+void cblas_drotmg(double *__d1, double *__d2, double *__b1, const double __b2, double *__P);
+void cblas_dsbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const int __K, const double __alpha, const double *__A, const int __lda, const double *__X, const int __incX, const double __beta, double *__Y, const int __incY);
+void cblas_dscal(const int __N, const double __alpha, double *__X, const int __incX);
+double cblas_dsdot(const int __N, const float *__X, const int __incX, const float *__Y, const int __incY);
+void cblas_dspmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__Ap, const double *__X, const int __incX, const double __beta, double *__Y, const int __incY);
+void cblas_dspr(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__X, const int __incX, double *__Ap);
+void cblas_dspr2(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__X, const int __incX, const double *__Y, const int __incY, double *__A);
+void cblas_dswap(const int __N, double *__X, const int __incX, double *__Y, const int __incY);
+void cblas_dsymm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const int __M, const int __N, const double __alpha, const double *__A, const int __lda, const double *__B, const int __ldb, const double __beta, double *__C, const int __ldc);
+void cblas_dsymv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__A, const int __lda, const double *__X, const int __incX, const double __beta, double *__Y, const int __incY);
+void cblas_dsyr(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__X, const int __incX, double *__A, const int __lda);
+void cblas_dsyr2(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const double __alpha, const double *__X, const int __incX, const double *__Y, const int __incY, double *__A, const int __lda);
+void cblas_dsyr2k(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const double __alpha, const double *__A, const int __lda, const double *__B, const int __ldb, const double __beta, double *__C, const int __ldc);
+void cblas_dsyrk(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const double __alpha, const double *__A, const int __lda, const double __beta, double *__C, const int __ldc);
+void cblas_dtbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const double *__A, const int __lda, double *__X, const int __incX);
+void cblas_dtbsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const double *__A, const int __lda, double *__X, const int __incX);
+void cblas_dtpmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const double *__Ap, double *__X, const int __incX);
+void cblas_dtpsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const double *__Ap, double *__X, const int __incX);
+void cblas_dtrmm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const double __alpha, const double *__A, const int __lda, double *__B, const int __ldb);
+void cblas_dtrmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const double *__A, const int __lda, double *__X, const int __incX);
+void cblas_dtrsm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const double __alpha, const double *__A, const int __lda, double *__B, const int __ldb);
+void cblas_dtrsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const double *__A, const int __lda, double *__X, const int __incX);
 void* cblas_dzasum(void);
 void* cblas_dznrm2(void);
-void* cblas_errprn(void);
+int cblas_errprn(int __ierr, int __info, const char *__form, ...);
 void* cblas_icamax(void);
-void* cblas_idamax(void);
-void* cblas_isamax(void);
+CBLAS_INDEX cblas_idamax(const int __N, const double *__X, const int __incX);
+CBLAS_INDEX cblas_isamax(const int __N, const float *__X, const int __incX);
 void* cblas_izamax(void);
-void* cblas_sasum(void);
-void* cblas_saxpy(void);
+float cblas_sasum(const int __N, const float *__X, const int __incX);
+void cblas_saxpy(const int __N, const float __alpha, const float *__X, const int __incX, float *__Y, const int __incY);
 void* cblas_scasum(void);
 void* cblas_scnrm2(void);
-void* cblas_scopy(void);
-void* cblas_sdot(void);
-void* cblas_sdsdot(void);
-void* cblas_sgbmv(void);
-void* cblas_sgemm(void);
-void* cblas_sgemv(void);
-void* cblas_sger(void);
-void* cblas_snrm2(void);
-void* cblas_srot(void);
-void* cblas_srotg(void);
-void* cblas_srotm(void);
-void* cblas_srotmg(void);
-void* cblas_ssbmv(void);
-void* cblas_sscal(void);
-void* cblas_sspmv(void);
-void* cblas_sspr(void);
-void* cblas_sspr2(void);
-void* cblas_sswap(void);
-void* cblas_ssymm(void);
-void* cblas_ssymv(void);
-void* cblas_ssyr(void);
-void* cblas_ssyr2(void);
-void* cblas_ssyr2k(void);
-void* cblas_ssyrk(void);
-void* cblas_stbmv(void);
-void* cblas_stbsv(void);
-void* cblas_stpmv(void);
-void* cblas_stpsv(void);
-void* cblas_strmm(void);
-void* cblas_strmv(void);
-void* cblas_strsm(void);
-void* cblas_strsv(void);
-void* cblas_xerbla(void);
+void cblas_scopy(const int __N, const float *__X, const int __incX, float *__Y, const int __incY);
+float cblas_sdot(const int __N, const float *__X, const int __incX, const float *__Y, const int __incY);
+float cblas_sdsdot(const int __N, const float __alpha, const float *__X, const int __incX, const float *__Y, const int __incY);
+void cblas_sgbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const int __KL, const int __KU, const float __alpha, const float *__A, const int __lda, const float *__X, const int __incX, const float __beta, float *__Y, const int __incY);
+void cblas_sgemm(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_TRANSPOSE __TransB, const int __M, const int __N, const int __K, const float __alpha, const float *__A, const int __lda, const float *__B, const int __ldb, const float __beta, float *__C, const int __ldc);
+void cblas_sgemv(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const float __alpha, const float *__A, const int __lda, const float *__X, const int __incX, const float __beta, float *__Y, const int __incY);
+void cblas_sger(const enum CBLAS_ORDER __Order, const int __M, const int __N, const float __alpha, const float *__X, const int __incX, const float *__Y, const int __incY, float *__A, const int __lda);
+float cblas_snrm2(const int __N, const float *__X, const int __incX);
+void cblas_srot(const int __N, float *__X, const int __incX, float *__Y, const int __incY, const float __c, const float __s);
+void cblas_srotg(float *__a, float *__b, float *__c, float *__s);
+void cblas_srotm(const int __N, float *__X, const int __incX, float *__Y, const int __incY, const float *__P);
+void cblas_srotmg(float *__d1, float *__d2, float *__b1, const float __b2, float *__P);
+void cblas_ssbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const int __K, const float __alpha, const float *__A, const int __lda, const float *__X, const int __incX, const float __beta, float *__Y, const int __incY);
+void cblas_sscal(const int __N, const float __alpha, float *__X, const int __incX);
+void cblas_sspmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__Ap, const float *__X, const int __incX, const float __beta, float *__Y, const int __incY);
+void cblas_sspr(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__X, const int __incX, float *__Ap);
+void cblas_sspr2(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__X, const int __incX, const float *__Y, const int __incY, float *__A);
+void cblas_sswap(const int __N, float *__X, const int __incX, float *__Y, const int __incY);
+void cblas_ssymm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const int __M, const int __N, const float __alpha, const float *__A, const int __lda, const float *__B, const int __ldb, const float __beta, float *__C, const int __ldc);
+void cblas_ssymv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__A, const int __lda, const float *__X, const int __incX, const float __beta, float *__Y, const int __incY);
+void cblas_ssyr(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__X, const int __incX, float *__A, const int __lda);
+void cblas_ssyr2(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const float __alpha, const float *__X, const int __incX, const float *__Y, const int __incY, float *__A, const int __lda);
+void cblas_ssyr2k(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const float __alpha, const float *__A, const int __lda, const float *__B, const int __ldb, const float __beta, float *__C, const int __ldc);
+void cblas_ssyrk(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const float __alpha, const float *__A, const int __lda, const float __beta, float *__C, const int __ldc);
+void cblas_stbmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const float *__A, const int __lda, float *__X, const int __incX);
+void cblas_stbsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const float *__A, const int __lda, float *__X, const int __incX);
+void cblas_stpmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const float *__Ap, float *__X, const int __incX);
+void cblas_stpsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const float *__Ap, float *__X, const int __incX);
+void cblas_strmm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const float __alpha, const float *__A, const int __lda, float *__B, const int __ldb);
+void cblas_strmv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const float *__A, const int __lda, float *__X, const int __incX);
+void cblas_strsm(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const float __alpha, const float *__A, const int __lda, float *__B, const int __ldb);
+void cblas_strsv(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const float *__A, const int __lda, float *__X, const int __incX);
+void cblas_xerbla(int __p, const char *__rout, const char *__form, ...);
 void* cblas_zaxpy(void);
 void* cblas_zcopy(void);
 void* cblas_zdotc_sub(void);
@@ -556,32 +573,32 @@ void* ctrsm(void);
 void* ctrsm_(void);
 void* ctrsv(void);
 void* ctrsv_(void);
-void* dasum(void);
-void* dasum_(void);
-void* daxpy(void);
-void* daxpy_(void);
+double dasum(const int *__N, const double *__X, const int *__incX);
+double dasum_(const int *__N, const double *__X, const int *__incX);
+void daxpy(const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Y, const int *__incY);
+void daxpy_(const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Y, const int *__incY);
 void* dcabs1(void);
 void* dcabs1_(void);
-void* dcopy(void);
-void* dcopy_(void);
-void* ddot(void);
-void* ddot_(void);
-void* dgbmv(void);
-void* dgbmv_(void);
+void dcopy(const int *__N, const double *__X, const int *__incX, double *__Y, const int *__incY);
+void dcopy_(const int *__N, const double *__X, const int *__incX, double *__Y, const int *__incY);
+double ddot(const int *__N, const double *__X, const int *__incX, const double *__Y, const int *__incY);
+double ddot_(const int *__N, const double *__X, const int *__incX, const double *__Y, const int *__incY);
+void dgbmv(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dgbmv_(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
 void* dgeCopy(void);
 void* dgePack_A_NoTran(void);
 void* dgePack_A_Tran(void);
 void* dgePack_B_NoTran(void);
 void* dgePack_B_Tran(void);
 void* dgeSetZero(void);
-void* dgemm(void);
-void* dgemm_(void);
-void* dgemv(void);
-void* dgemv_(void);
-void* dger(void);
-void* dger_(void);
-void* dnrm2(void);
-void* dnrm2_(void);
+void dgemm(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dgemm_(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dgemv(const char *__Trans, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dgemv_(const char *__Trans, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dger(const int *__M, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void dger_(const int *__M, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+double dnrm2(const int *__N, const double *__X, const int *__incX);
+double dnrm2_(const int *__N, const double *__X, const int *__incX);
 void* double_general_add(void);
 void* double_general_add_scalar(void);
 void* double_general_elementwise_product(void);
@@ -593,58 +610,58 @@ void* double_general_sub_scalar(void);
 void* double_general_transpose(void);
 void* double_inner_product_scalar(void);
 void* double_outer_product_scalar(void);
-void* drot(void);
-void* drot_(void);
-void* drotg(void);
-void* drotg_(void);
-void* drotm(void);
-void* drotm_(void);
-void* drotmg(void);
-void* drotmg_(void);
-void* dsbmv(void);
-void* dsbmv_(void);
-void* dscal(void);
-void* dscal_(void);
-void* dsdot(void);
-void* dsdot_(void);
-void* dspmv(void);
-void* dspmv_(void);
-void* dspr(void);
-void* dspr2(void);
-void* dspr2_(void);
-void* dspr_(void);
-void* dswap(void);
-void* dswap_(void);
-void* dsymm(void);
-void* dsymm_(void);
-void* dsymv(void);
-void* dsymv_(void);
-void* dsyr(void);
-void* dsyr2(void);
-void* dsyr2_(void);
-void* dsyr2k(void);
-void* dsyr2k_(void);
-void* dsyr_(void);
-void* dsyrk(void);
-void* dsyrk_(void);
-void* dtbmv(void);
-void* dtbmv_(void);
-void* dtbsv(void);
-void* dtbsv_(void);
-void* dtpmv(void);
-void* dtpmv_(void);
-void* dtpsv(void);
-void* dtpsv_(void);
+void drot(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__c, const double *__s);
+void drot_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__c, const double *__s);
+void drotg(double *__a, double *__b, double *__c, double *__s);
+void drotg_(double *__a, double *__b, double *__c, double *__s);
+void drotm(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__P);
+void drotm_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY, const double *__P);
+void drotmg(double *__d1, double *__d2, double *__b1, const double *__b2, double *__P);
+void drotmg_(double *__d1, double *__d2, double *__b1, const double *__b2, double *__P);
+void dsbmv(const char *__Uplo, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dsbmv_(const char *__Uplo, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dscal(const int *__N, const double *__alpha, double *__X, const int *__incX);
+void dscal_(const int *__N, const double *__alpha, double *__X, const int *__incX);
+double dsdot(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double dsdot_(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+void dspmv(const char *__Uplo, const int *__N, const double *__alpha, const double *__Ap, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dspmv_(const char *__Uplo, const int *__N, const double *__alpha, const double *__Ap, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dspr(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Ap);
+void dspr2(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__Ap);
+void dspr2_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__Ap);
+void dspr_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__Ap);
+void dswap(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY);
+void dswap_(const int *__N, double *__X, const int *__incX, double *__Y, const int *__incY);
+void dsymm(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dsymm_(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dsymv(const char *__Uplo, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dsymv_(const char *__Uplo, const int *__N, const double *__alpha, const double *__A, const int *__lda, const double *__X, const int *__incX, const double *__beta, double *__Y, const int *__incY);
+void dsyr(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__A, const int *__lda);
+void dsyr2(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void dsyr2_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, const double *__Y, const int *__incY, double *__A, const int *__lda);
+void dsyr2k(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dsyr2k_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__B, const int *__ldb, const double *__beta, double *__C, const int *__ldc);
+void dsyr_(const char *__Uplo, const int *__N, const double *__alpha, const double *__X, const int *__incX, double *__A, const int *__lda);
+void dsyrk(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__beta, double *__C, const int *__ldc);
+void dsyrk_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const double *__alpha, const double *__A, const int *__lda, const double *__beta, double *__C, const int *__ldc);
+void dtbmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtbmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtbsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtbsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtpmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void dtpmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void dtpsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
+void dtpsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__Ap, double *__X, const int *__incX);
 void* dtrCopyLower(void);
 void* dtrSetZeroLower(void);
-void* dtrmm(void);
-void* dtrmm_(void);
-void* dtrmv(void);
-void* dtrmv_(void);
-void* dtrsm(void);
-void* dtrsm_(void);
-void* dtrsv(void);
-void* dtrsv_(void);
+void dtrmm(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void dtrmm_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void dtrmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtrmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtrsm(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void dtrsm_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const double *__alpha, const double *__A, const int *__lda, double *__B, const int *__ldb);
+void dtrsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
+void dtrsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const double *__A, const int *__lda, double *__X, const int *__incX);
 void* dzasum(void);
 void* dzasum_(void);
 void* dznrm2(void);
@@ -663,95 +680,95 @@ void* float_outer_product_scalar(void);
 void* getHardwareInfo(void);
 void* icamax(void);
 void* icamax_(void);
-void* idamax(void);
-void* idamax_(void);
-void* isamax(void);
-void* isamax_(void);
+int idamax(const int *__N, const double *__X, const int *__incX);
+int idamax_(const int *__N, const double *__X, const int *__incX);
+int isamax(const int *__N, const float *__X, const int *__incX);
+int isamax_(const int *__N, const float *__X, const int *__incX);
 void* izamax(void);
 void* izamax_(void);
-void* lsame_(void);
-void* sasum(void);
-void* sasum_(void);
-void* saxpy(void);
-void* saxpy_(void);
+int lsame_(const char *__ca, const char *__cb);
+double sasum(const int *__N, const float *__X, const int *__incX);
+double sasum_(const int *__N, const float *__X, const int *__incX);
+void saxpy(const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Y, const int *__incY);
+void saxpy_(const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Y, const int *__incY);
 void* scasum(void);
 void* scasum_(void);
 void* scnrm2(void);
 void* scnrm2_(void);
-void* scopy(void);
-void* scopy_(void);
-void* sdot(void);
-void* sdot_(void);
-void* sdsdot(void);
-void* sdsdot_(void);
-void* sgbmv(void);
-void* sgbmv_(void);
+void scopy(const int *__N, const float *__X, const int *__incX, float *__Y, const int *__incY);
+void scopy_(const int *__N, const float *__X, const int *__incX, float *__Y, const int *__incY);
+double sdot(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double sdot_(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double sdsdot(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+double sdsdot_(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY);
+void sgbmv(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sgbmv_(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
 void* sgeCopy(void);
 void* sgePack_A_NoTran(void);
 void* sgePack_A_Tran(void);
 void* sgePack_B_NoTran(void);
 void* sgePack_B_Tran(void);
 void* sgeSetZero(void);
-void* sgemm(void);
-void* sgemm_(void);
-void* sgemv(void);
-void* sgemv_(void);
-void* sger(void);
-void* sger_(void);
-void* snrm2(void);
-void* snrm2_(void);
-void* srot(void);
-void* srot_(void);
-void* srotg(void);
-void* srotg_(void);
-void* srotm(void);
-void* srotm_(void);
-void* srotmg(void);
-void* srotmg_(void);
-void* ssbmv(void);
-void* ssbmv_(void);
-void* sscal(void);
-void* sscal_(void);
-void* sspmv(void);
-void* sspmv_(void);
-void* sspr(void);
-void* sspr2(void);
-void* sspr2_(void);
-void* sspr_(void);
-void* sswap(void);
-void* sswap_(void);
-void* ssymm(void);
-void* ssymm_(void);
-void* ssymv(void);
-void* ssymv_(void);
-void* ssyr(void);
-void* ssyr2(void);
-void* ssyr2_(void);
-void* ssyr2k(void);
-void* ssyr2k_(void);
-void* ssyr_(void);
-void* ssyrk(void);
-void* ssyrk_(void);
-void* stbmv(void);
-void* stbmv_(void);
-void* stbsv(void);
-void* stbsv_(void);
-void* stpmv(void);
-void* stpmv_(void);
-void* stpsv(void);
-void* stpsv_(void);
+void sgemm(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void sgemm_(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void sgemv(const char *__Trans, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sgemv_(const char *__Trans, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sger(const int *__M, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void sger_(const int *__M, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+double snrm2(const int *__N, const float *__X, const int *__incX);
+double snrm2_(const int *__N, const float *__X, const int *__incX);
+void srot(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__c, const float *__s);
+void srot_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__c, const float *__s);
+void srotg(float *__a, float *__b, float *__c, float *__s);
+void srotg_(float *__a, float *__b, float *__c, float *__s);
+void srotm(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__P);
+void srotm_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY, const float *__P);
+void srotmg(float *__d1, float *__d2, float *__b1, const float *__b2, float *__P);
+void srotmg_(float *__d1, float *__d2, float *__b1, const float *__b2, float *__P);
+void ssbmv(const char *__Uplo, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void ssbmv_(const char *__Uplo, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sscal(const int *__N, const float *__alpha, float *__X, const int *__incX);
+void sscal_(const int *__N, const float *__alpha, float *__X, const int *__incX);
+void sspmv(const char *__Uplo, const int *__N, const float *__alpha, const float *__Ap, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sspmv_(const char *__Uplo, const int *__N, const float *__alpha, const float *__Ap, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void sspr(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Ap);
+void sspr2(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__Ap);
+void sspr2_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__Ap);
+void sspr_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__Ap);
+void sswap(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY);
+void sswap_(const int *__N, float *__X, const int *__incX, float *__Y, const int *__incY);
+void ssymm(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void ssymm_(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void ssymv(const char *__Uplo, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void ssymv_(const char *__Uplo, const int *__N, const float *__alpha, const float *__A, const int *__lda, const float *__X, const int *__incX, const float *__beta, float *__Y, const int *__incY);
+void ssyr(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__A, const int *__lda);
+void ssyr2(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void ssyr2_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, const float *__Y, const int *__incY, float *__A, const int *__lda);
+void ssyr2k(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void ssyr2k_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__B, const int *__ldb, const float *__beta, float *__C, const int *__ldc);
+void ssyr_(const char *__Uplo, const int *__N, const float *__alpha, const float *__X, const int *__incX, float *__A, const int *__lda);
+void ssyrk(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__beta, float *__C, const int *__ldc);
+void ssyrk_(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const float *__alpha, const float *__A, const int *__lda, const float *__beta, float *__C, const int *__ldc);
+void stbmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void stbmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void stbsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void stbsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const float *__A, const int *__lda, float *__X, const int *__incX);
+void stpmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void stpmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void stpsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
+void stpsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__Ap, float *__X, const int *__incX);
 void* strCopyLower(void);
 void* strSetZeroLower(void);
-void* strmm(void);
-void* strmm_(void);
-void* strmv(void);
-void* strmv_(void);
-void* strsm(void);
-void* strsm_(void);
-void* strsv(void);
-void* strsv_(void);
-void* xerbla(void);
-void* xerbla_(void);
+void strmm(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void strmm_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void strmv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void strmv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void strsm(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void strsm_(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const float *__alpha, const float *__A, const int *__lda, float *__B, const int *__ldb);
+void strsv(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void strsv_(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const float *__A, const int *__lda, float *__X, const int *__incX);
+void xerbla(const char *__srname, const int *__info);
+void xerbla_(const char *__srname, const int *__info);
 void* xerbla_array__(void);
 void* zaxpy(void);
 void* zaxpy_(void);
@@ -77,11 +77,13 @@ void* APL_strsm(void)
     return NULL;
 }
 
+/*
 void* APPLE_NTHREADS(void)
 {
     if (verbose) puts("STUB: APPLE_NTHREADS called");
     return NULL;
 }
+*/
 
 void* ATLU_DestroyThreadMemory(void)
 {
@@ -509,29 +511,37 @@ void* CTRSV_(void)
     return NULL;
 }
 
+/*
 void* DASUM(void)
 {
     if (verbose) puts("STUB: DASUM called");
     return NULL;
 }
+*/
 
+/*
 void* DASUM_(void)
 {
     if (verbose) puts("STUB: DASUM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DAXPY(void)
 {
     if (verbose) puts("STUB: DAXPY called");
     return NULL;
 }
+*/
 
+/*
 void* DAXPY_(void)
 {
     if (verbose) puts("STUB: DAXPY_ called");
     return NULL;
 }
+*/
 
 void* DCABS1(void)
 {
@@ -545,389 +555,517 @@ void* DCABS1_(void)
     return NULL;
 }
 
+/*
 void* DCOPY(void)
 {
     if (verbose) puts("STUB: DCOPY called");
     return NULL;
 }
+*/
 
+/*
 void* DCOPY_(void)
 {
     if (verbose) puts("STUB: DCOPY_ called");
     return NULL;
 }
+*/
 
+/*
 void* DDOT(void)
 {
     if (verbose) puts("STUB: DDOT called");
     return NULL;
 }
+*/
 
+/*
 void* DDOT_(void)
 {
     if (verbose) puts("STUB: DDOT_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGBMV(void)
 {
     if (verbose) puts("STUB: DGBMV called");
     return NULL;
 }
+*/
 
+/*
 void* DGBMV_(void)
 {
     if (verbose) puts("STUB: DGBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGEMM(void)
 {
     if (verbose) puts("STUB: DGEMM called");
     return NULL;
 }
+*/
 
+/*
 void* DGEMM_(void)
 {
     if (verbose) puts("STUB: DGEMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGEMV(void)
 {
     if (verbose) puts("STUB: DGEMV called");
     return NULL;
 }
+*/
 
+/*
 void* DGEMV_(void)
 {
     if (verbose) puts("STUB: DGEMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGER(void)
 {
     if (verbose) puts("STUB: DGER called");
     return NULL;
 }
+*/
 
+/*
 void* DGER_(void)
 {
     if (verbose) puts("STUB: DGER_ called");
     return NULL;
 }
+*/
 
+/*
 void* DNRM2(void)
 {
     if (verbose) puts("STUB: DNRM2 called");
     return NULL;
 }
+*/
 
+/*
 void* DNRM2_(void)
 {
     if (verbose) puts("STUB: DNRM2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DROT(void)
 {
     if (verbose) puts("STUB: DROT called");
     return NULL;
 }
+*/
 
+/*
 void* DROTG(void)
 {
     if (verbose) puts("STUB: DROTG called");
     return NULL;
 }
+*/
 
+/*
 void* DROTG_(void)
 {
     if (verbose) puts("STUB: DROTG_ called");
     return NULL;
 }
+*/
 
+/*
 void* DROTM(void)
 {
     if (verbose) puts("STUB: DROTM called");
     return NULL;
 }
+*/
 
+/*
 void* DROTMG(void)
 {
     if (verbose) puts("STUB: DROTMG called");
     return NULL;
 }
+*/
 
+/*
 void* DROTMG_(void)
 {
     if (verbose) puts("STUB: DROTMG_ called");
     return NULL;
 }
+*/
 
+/*
 void* DROTM_(void)
 {
     if (verbose) puts("STUB: DROTM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DROT_(void)
 {
     if (verbose) puts("STUB: DROT_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSBMV(void)
 {
     if (verbose) puts("STUB: DSBMV called");
     return NULL;
 }
+*/
 
+/*
 void* DSBMV_(void)
 {
     if (verbose) puts("STUB: DSBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSCAL(void)
 {
     if (verbose) puts("STUB: DSCAL called");
     return NULL;
 }
+*/
 
+/*
 void* DSCAL_(void)
 {
     if (verbose) puts("STUB: DSCAL_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSDOT(void)
 {
     if (verbose) puts("STUB: DSDOT called");
     return NULL;
 }
+*/
 
+/*
 void* DSDOT_(void)
 {
     if (verbose) puts("STUB: DSDOT_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSPMV(void)
 {
     if (verbose) puts("STUB: DSPMV called");
     return NULL;
 }
+*/
 
+/*
 void* DSPMV_(void)
 {
     if (verbose) puts("STUB: DSPMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSPR(void)
 {
     if (verbose) puts("STUB: DSPR called");
     return NULL;
 }
+*/
 
+/*
 void* DSPR2(void)
 {
     if (verbose) puts("STUB: DSPR2 called");
     return NULL;
 }
+*/
 
+/*
 void* DSPR2_(void)
 {
     if (verbose) puts("STUB: DSPR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSPR_(void)
 {
     if (verbose) puts("STUB: DSPR_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSWAP(void)
 {
     if (verbose) puts("STUB: DSWAP called");
     return NULL;
 }
+*/
 
+/*
 void* DSWAP_(void)
 {
     if (verbose) puts("STUB: DSWAP_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYMM(void)
 {
     if (verbose) puts("STUB: DSYMM called");
     return NULL;
 }
+*/
 
+/*
 void* DSYMM_(void)
 {
     if (verbose) puts("STUB: DSYMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYMV(void)
 {
     if (verbose) puts("STUB: DSYMV called");
     return NULL;
 }
+*/
 
+/*
 void* DSYMV_(void)
 {
     if (verbose) puts("STUB: DSYMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR(void)
 {
     if (verbose) puts("STUB: DSYR called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR2(void)
 {
     if (verbose) puts("STUB: DSYR2 called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR2K(void)
 {
     if (verbose) puts("STUB: DSYR2K called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR2K_(void)
 {
     if (verbose) puts("STUB: DSYR2K_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR2_(void)
 {
     if (verbose) puts("STUB: DSYR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYRK(void)
 {
     if (verbose) puts("STUB: DSYRK called");
     return NULL;
 }
+*/
 
+/*
 void* DSYRK_(void)
 {
     if (verbose) puts("STUB: DSYRK_ called");
     return NULL;
 }
+*/
 
+/*
 void* DSYR_(void)
 {
     if (verbose) puts("STUB: DSYR_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTBMV(void)
 {
     if (verbose) puts("STUB: DTBMV called");
     return NULL;
 }
+*/
 
+/*
 void* DTBMV_(void)
 {
     if (verbose) puts("STUB: DTBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTBSV(void)
 {
     if (verbose) puts("STUB: DTBSV called");
     return NULL;
 }
+*/
 
+/*
 void* DTBSV_(void)
 {
     if (verbose) puts("STUB: DTBSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTPMV(void)
 {
     if (verbose) puts("STUB: DTPMV called");
     return NULL;
 }
+*/
 
+/*
 void* DTPMV_(void)
 {
     if (verbose) puts("STUB: DTPMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTPSV(void)
 {
     if (verbose) puts("STUB: DTPSV called");
     return NULL;
 }
+*/
 
+/*
 void* DTPSV_(void)
 {
     if (verbose) puts("STUB: DTPSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTRMM(void)
 {
     if (verbose) puts("STUB: DTRMM called");
     return NULL;
 }
+*/
 
+/*
 void* DTRMM_(void)
 {
     if (verbose) puts("STUB: DTRMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTRMV(void)
 {
     if (verbose) puts("STUB: DTRMV called");
     return NULL;
 }
+*/
 
+/*
 void* DTRMV_(void)
 {
     if (verbose) puts("STUB: DTRMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTRSM(void)
 {
     if (verbose) puts("STUB: DTRSM called");
     return NULL;
 }
+*/
 
+/*
 void* DTRSM_(void)
 {
     if (verbose) puts("STUB: DTRSM_ called");
     return NULL;
 }
+*/
 
+/*
 void* DTRSV(void)
 {
     if (verbose) puts("STUB: DTRSV called");
     return NULL;
 }
+*/
 
+/*
 void* DTRSV_(void)
 {
     if (verbose) puts("STUB: DTRSV_ called");
     return NULL;
 }
+*/
 
 void* DZASUM(void)
 {
@@ -965,29 +1103,37 @@ void* ICAMAX_(void)
     return NULL;
 }
 
+/*
 void* IDAMAX(void)
 {
     if (verbose) puts("STUB: IDAMAX called");
     return NULL;
 }
+*/
 
+/*
 void* IDAMAX_(void)
 {
     if (verbose) puts("STUB: IDAMAX_ called");
     return NULL;
 }
+*/
 
+/*
 void* ISAMAX(void)
 {
     if (verbose) puts("STUB: ISAMAX called");
     return NULL;
 }
+*/
 
+/*
 void* ISAMAX_(void)
 {
     if (verbose) puts("STUB: ISAMAX_ called");
     return NULL;
 }
+*/
 
 void* IZAMAX(void)
 {
@@ -1001,29 +1147,37 @@ void* IZAMAX_(void)
     return NULL;
 }
 
+/*
 void* SASUM(void)
 {
     if (verbose) puts("STUB: SASUM called");
     return NULL;
 }
+*/
 
+/*
 void* SASUM_(void)
 {
     if (verbose) puts("STUB: SASUM_ called");
     return NULL;
 }
+*/
 
+/*
 void* SAXPY(void)
 {
     if (verbose) puts("STUB: SAXPY called");
     return NULL;
 }
+*/
 
+/*
 void* SAXPY_(void)
 {
     if (verbose) puts("STUB: SAXPY_ called");
     return NULL;
 }
+*/
 
 void* SCASUM(void)
 {
@@ -1049,407 +1203,541 @@ void* SCNRM2_(void)
     return NULL;
 }
 
+/*
 void* SCOPY(void)
 {
     if (verbose) puts("STUB: SCOPY called");
     return NULL;
 }
+*/
 
+/*
 void* SCOPY_(void)
 {
     if (verbose) puts("STUB: SCOPY_ called");
     return NULL;
 }
+*/
 
+/*
 void* SDOT(void)
 {
     if (verbose) puts("STUB: SDOT called");
     return NULL;
 }
+*/
 
+/*
 void* SDOT_(void)
 {
     if (verbose) puts("STUB: SDOT_ called");
     return NULL;
 }
+*/
 
+/*
 void* SDSDOT(void)
 {
     if (verbose) puts("STUB: SDSDOT called");
     return NULL;
 }
+*/
 
+/*
 void* SDSDOT_(void)
 {
     if (verbose) puts("STUB: SDSDOT_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGBMV(void)
 {
     if (verbose) puts("STUB: SGBMV called");
     return NULL;
 }
+*/
 
+/*
 void* SGBMV_(void)
 {
     if (verbose) puts("STUB: SGBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGEMM(void)
 {
     if (verbose) puts("STUB: SGEMM called");
     return NULL;
 }
+*/
 
+/*
 void* SGEMM_(void)
 {
     if (verbose) puts("STUB: SGEMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGEMV(void)
 {
     if (verbose) puts("STUB: SGEMV called");
     return NULL;
 }
+*/
 
+/*
 void* SGEMV_(void)
 {
     if (verbose) puts("STUB: SGEMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGER(void)
 {
     if (verbose) puts("STUB: SGER called");
     return NULL;
 }
+*/
 
+/*
 void* SGER_(void)
 {
     if (verbose) puts("STUB: SGER_ called");
     return NULL;
 }
+*/
 
+/*
 void* SNRM2(void)
 {
     if (verbose) puts("STUB: SNRM2 called");
     return NULL;
 }
+*/
 
+/*
 void* SNRM2_(void)
 {
     if (verbose) puts("STUB: SNRM2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SROT(void)
 {
     if (verbose) puts("STUB: SROT called");
     return NULL;
 }
+*/
 
+/*
 void* SROTG(void)
 {
     if (verbose) puts("STUB: SROTG called");
     return NULL;
 }
+*/
 
+/*
 void* SROTG_(void)
 {
     if (verbose) puts("STUB: SROTG_ called");
     return NULL;
 }
+*/
 
+/*
 void* SROTM(void)
 {
     if (verbose) puts("STUB: SROTM called");
     return NULL;
 }
+*/
 
+/*
 void* SROTMG(void)
 {
     if (verbose) puts("STUB: SROTMG called");
     return NULL;
 }
+*/
 
+/*
 void* SROTMG_(void)
 {
     if (verbose) puts("STUB: SROTMG_ called");
     return NULL;
 }
+*/
 
+/*
 void* SROTM_(void)
 {
     if (verbose) puts("STUB: SROTM_ called");
     return NULL;
 }
+*/
 
+/*
 void* SROT_(void)
 {
     if (verbose) puts("STUB: SROT_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSBMV(void)
 {
     if (verbose) puts("STUB: SSBMV called");
     return NULL;
 }
+*/
 
+/*
 void* SSBMV_(void)
 {
     if (verbose) puts("STUB: SSBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSCAL(void)
 {
     if (verbose) puts("STUB: SSCAL called");
     return NULL;
 }
+*/
 
+/*
 void* SSCAL_(void)
 {
     if (verbose) puts("STUB: SSCAL_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSPMV(void)
 {
     if (verbose) puts("STUB: SSPMV called");
     return NULL;
 }
+*/
 
+/*
 void* SSPMV_(void)
 {
     if (verbose) puts("STUB: SSPMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSPR(void)
 {
     if (verbose) puts("STUB: SSPR called");
     return NULL;
 }
+*/
 
+/*
 void* SSPR2(void)
 {
     if (verbose) puts("STUB: SSPR2 called");
     return NULL;
 }
+*/
 
+/*
 void* SSPR2_(void)
 {
     if (verbose) puts("STUB: SSPR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSPR_(void)
 {
     if (verbose) puts("STUB: SSPR_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSWAP(void)
 {
     if (verbose) puts("STUB: SSWAP called");
     return NULL;
 }
+*/
 
+/*
 void* SSWAP_(void)
 {
     if (verbose) puts("STUB: SSWAP_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYMM(void)
 {
     if (verbose) puts("STUB: SSYMM called");
     return NULL;
 }
+*/
 
+/*
 void* SSYMM_(void)
 {
     if (verbose) puts("STUB: SSYMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYMV(void)
 {
     if (verbose) puts("STUB: SSYMV called");
     return NULL;
 }
+*/
 
+/*
 void* SSYMV_(void)
 {
     if (verbose) puts("STUB: SSYMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR(void)
 {
     if (verbose) puts("STUB: SSYR called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR2(void)
 {
     if (verbose) puts("STUB: SSYR2 called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR2K(void)
 {
     if (verbose) puts("STUB: SSYR2K called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR2K_(void)
 {
     if (verbose) puts("STUB: SSYR2K_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR2_(void)
 {
     if (verbose) puts("STUB: SSYR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYRK(void)
 {
     if (verbose) puts("STUB: SSYRK called");
     return NULL;
 }
+*/
 
+/*
 void* SSYRK_(void)
 {
     if (verbose) puts("STUB: SSYRK_ called");
     return NULL;
 }
+*/
 
+/*
 void* SSYR_(void)
 {
     if (verbose) puts("STUB: SSYR_ called");
     return NULL;
 }
+*/
 
+/*
 void* STBMV(void)
 {
     if (verbose) puts("STUB: STBMV called");
     return NULL;
 }
+*/
 
+/*
 void* STBMV_(void)
 {
     if (verbose) puts("STUB: STBMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* STBSV(void)
 {
     if (verbose) puts("STUB: STBSV called");
     return NULL;
 }
+*/
 
+/*
 void* STBSV_(void)
 {
     if (verbose) puts("STUB: STBSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* STPMV(void)
 {
     if (verbose) puts("STUB: STPMV called");
     return NULL;
 }
+*/
 
+/*
 void* STPMV_(void)
 {
     if (verbose) puts("STUB: STPMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* STPSV(void)
 {
     if (verbose) puts("STUB: STPSV called");
     return NULL;
 }
+*/
 
+/*
 void* STPSV_(void)
 {
     if (verbose) puts("STUB: STPSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* STRMM(void)
 {
     if (verbose) puts("STUB: STRMM called");
     return NULL;
 }
+*/
 
+/*
 void* STRMM_(void)
 {
     if (verbose) puts("STUB: STRMM_ called");
     return NULL;
 }
+*/
 
+/*
 void* STRMV(void)
 {
     if (verbose) puts("STUB: STRMV called");
     return NULL;
 }
+*/
 
+/*
 void* STRMV_(void)
 {
     if (verbose) puts("STUB: STRMV_ called");
     return NULL;
 }
+*/
 
+/*
 void* STRSM(void)
 {
     if (verbose) puts("STUB: STRSM called");
     return NULL;
 }
+*/
 
+/*
 void* STRSM_(void)
 {
     if (verbose) puts("STUB: STRSM_ called");
     return NULL;
 }
+*/
 
+/*
 void* STRSV(void)
 {
     if (verbose) puts("STUB: STRSV called");
     return NULL;
 }
+*/
 
+/*
 void* STRSV_(void)
 {
     if (verbose) puts("STUB: STRSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SetBLASParamErrorProc(void)
 {
     if (verbose) puts("STUB: SetBLASParamErrorProc called");
     return NULL;
 }
+*/
 
+/*
 void* XERBLA(void)
 {
     if (verbose) puts("STUB: XERBLA called");
     return NULL;
 }
+*/
 
+/*
 void* XERBLA_(void)
 {
     if (verbose) puts("STUB: XERBLA_ called");
     return NULL;
 }
+*/
 
 void* ZAXPY(void)
 {
@@ -2153,209 +2441,277 @@ void* cblas_ctrsv(void)
     return NULL;
 }
 
+/*
 void* cblas_dasum(void)
 {
     if (verbose) puts("STUB: cblas_dasum called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_daxpy(void)
 {
     if (verbose) puts("STUB: cblas_daxpy called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dcopy(void)
 {
     if (verbose) puts("STUB: cblas_dcopy called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ddot(void)
 {
     if (verbose) puts("STUB: cblas_ddot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dgbmv(void)
 {
     if (verbose) puts("STUB: cblas_dgbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dgemm(void)
 {
     if (verbose) puts("STUB: cblas_dgemm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dgemv(void)
 {
     if (verbose) puts("STUB: cblas_dgemv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dger(void)
 {
     if (verbose) puts("STUB: cblas_dger called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dnrm2(void)
 {
     if (verbose) puts("STUB: cblas_dnrm2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_drot(void)
 {
     if (verbose) puts("STUB: cblas_drot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_drotg(void)
 {
     if (verbose) puts("STUB: cblas_drotg called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_drotm(void)
 {
     if (verbose) puts("STUB: cblas_drotm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_drotmg(void)
 {
     if (verbose) puts("STUB: cblas_drotmg called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsbmv(void)
 {
     if (verbose) puts("STUB: cblas_dsbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dscal(void)
 {
     if (verbose) puts("STUB: cblas_dscal called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsdot(void)
 {
     if (verbose) puts("STUB: cblas_dsdot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dspmv(void)
 {
     if (verbose) puts("STUB: cblas_dspmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dspr(void)
 {
     if (verbose) puts("STUB: cblas_dspr called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dspr2(void)
 {
     if (verbose) puts("STUB: cblas_dspr2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dswap(void)
 {
     if (verbose) puts("STUB: cblas_dswap called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsymm(void)
 {
     if (verbose) puts("STUB: cblas_dsymm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsymv(void)
 {
     if (verbose) puts("STUB: cblas_dsymv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsyr(void)
 {
     if (verbose) puts("STUB: cblas_dsyr called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsyr2(void)
 {
     if (verbose) puts("STUB: cblas_dsyr2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsyr2k(void)
 {
     if (verbose) puts("STUB: cblas_dsyr2k called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dsyrk(void)
 {
     if (verbose) puts("STUB: cblas_dsyrk called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtbmv(void)
 {
     if (verbose) puts("STUB: cblas_dtbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtbsv(void)
 {
     if (verbose) puts("STUB: cblas_dtbsv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtpmv(void)
 {
     if (verbose) puts("STUB: cblas_dtpmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtpsv(void)
 {
     if (verbose) puts("STUB: cblas_dtpsv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtrmm(void)
 {
     if (verbose) puts("STUB: cblas_dtrmm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtrmv(void)
 {
     if (verbose) puts("STUB: cblas_dtrmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtrsm(void)
 {
     if (verbose) puts("STUB: cblas_dtrsm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_dtrsv(void)
 {
     if (verbose) puts("STUB: cblas_dtrsv called");
     return NULL;
 }
+*/
 
 void* cblas_dzasum(void)
 {
@@ -2369,11 +2725,13 @@ void* cblas_dznrm2(void)
     return NULL;
 }
 
+/*
 void* cblas_errprn(void)
 {
     if (verbose) puts("STUB: cblas_errprn called");
     return NULL;
 }
+*/
 
 void* cblas_icamax(void)
 {
@@ -2381,17 +2739,21 @@ void* cblas_icamax(void)
     return NULL;
 }
 
+/*
 void* cblas_idamax(void)
 {
     if (verbose) puts("STUB: cblas_idamax called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_isamax(void)
 {
     if (verbose) puts("STUB: cblas_isamax called");
     return NULL;
 }
+*/
 
 void* cblas_izamax(void)
 {
@@ -2399,17 +2761,21 @@ void* cblas_izamax(void)
     return NULL;
 }
 
+/*
 void* cblas_sasum(void)
 {
     if (verbose) puts("STUB: cblas_sasum called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_saxpy(void)
 {
     if (verbose) puts("STUB: cblas_saxpy called");
     return NULL;
 }
+*/
 
 void* cblas_scasum(void)
 {
@@ -2423,203 +2789,269 @@ void* cblas_scnrm2(void)
     return NULL;
 }
 
+/*
 void* cblas_scopy(void)
 {
     if (verbose) puts("STUB: cblas_scopy called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sdot(void)
 {
     if (verbose) puts("STUB: cblas_sdot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sdsdot(void)
 {
     if (verbose) puts("STUB: cblas_sdsdot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sgbmv(void)
 {
     if (verbose) puts("STUB: cblas_sgbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sgemm(void)
 {
     if (verbose) puts("STUB: cblas_sgemm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sgemv(void)
 {
     if (verbose) puts("STUB: cblas_sgemv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sger(void)
 {
     if (verbose) puts("STUB: cblas_sger called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_snrm2(void)
 {
     if (verbose) puts("STUB: cblas_snrm2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_srot(void)
 {
     if (verbose) puts("STUB: cblas_srot called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_srotg(void)
 {
     if (verbose) puts("STUB: cblas_srotg called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_srotm(void)
 {
     if (verbose) puts("STUB: cblas_srotm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_srotmg(void)
 {
     if (verbose) puts("STUB: cblas_srotmg called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssbmv(void)
 {
     if (verbose) puts("STUB: cblas_ssbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sscal(void)
 {
     if (verbose) puts("STUB: cblas_sscal called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sspmv(void)
 {
     if (verbose) puts("STUB: cblas_sspmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sspr(void)
 {
     if (verbose) puts("STUB: cblas_sspr called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sspr2(void)
 {
     if (verbose) puts("STUB: cblas_sspr2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_sswap(void)
 {
     if (verbose) puts("STUB: cblas_sswap called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssymm(void)
 {
     if (verbose) puts("STUB: cblas_ssymm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssymv(void)
 {
     if (verbose) puts("STUB: cblas_ssymv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssyr(void)
 {
     if (verbose) puts("STUB: cblas_ssyr called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssyr2(void)
 {
     if (verbose) puts("STUB: cblas_ssyr2 called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssyr2k(void)
 {
     if (verbose) puts("STUB: cblas_ssyr2k called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_ssyrk(void)
 {
     if (verbose) puts("STUB: cblas_ssyrk called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_stbmv(void)
 {
     if (verbose) puts("STUB: cblas_stbmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_stbsv(void)
 {
     if (verbose) puts("STUB: cblas_stbsv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_stpmv(void)
 {
     if (verbose) puts("STUB: cblas_stpmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_stpsv(void)
 {
     if (verbose) puts("STUB: cblas_stpsv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_strmm(void)
 {
     if (verbose) puts("STUB: cblas_strmm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_strmv(void)
 {
     if (verbose) puts("STUB: cblas_strmv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_strsm(void)
 {
     if (verbose) puts("STUB: cblas_strsm called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_strsv(void)
 {
     if (verbose) puts("STUB: cblas_strsv called");
     return NULL;
 }
+*/
 
+/*
 void* cblas_xerbla(void)
 {
     if (verbose) puts("STUB: cblas_xerbla called");
     return NULL;
 }
+*/
 
 void* cblas_zaxpy(void)
 {
@@ -3239,29 +3671,37 @@ void* ctrsv_(void)
     return NULL;
 }
 
+/*
 void* dasum(void)
 {
     if (verbose) puts("STUB: dasum called");
     return NULL;
 }
+*/
 
+/*
 void* dasum_(void)
 {
     if (verbose) puts("STUB: dasum_ called");
     return NULL;
 }
+*/
 
+/*
 void* daxpy(void)
 {
     if (verbose) puts("STUB: daxpy called");
     return NULL;
 }
+*/
 
+/*
 void* daxpy_(void)
 {
     if (verbose) puts("STUB: daxpy_ called");
     return NULL;
 }
+*/
 
 void* dcabs1(void)
 {
@@ -3275,41 +3715,53 @@ void* dcabs1_(void)
     return NULL;
 }
 
+/*
 void* dcopy(void)
 {
     if (verbose) puts("STUB: dcopy called");
     return NULL;
 }
+*/
 
+/*
 void* dcopy_(void)
 {
     if (verbose) puts("STUB: dcopy_ called");
     return NULL;
 }
+*/
 
+/*
 void* ddot(void)
 {
     if (verbose) puts("STUB: ddot called");
     return NULL;
 }
+*/
 
+/*
 void* ddot_(void)
 {
     if (verbose) puts("STUB: ddot_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgbmv(void)
 {
     if (verbose) puts("STUB: dgbmv called");
     return NULL;
 }
+*/
 
+/*
 void* dgbmv_(void)
 {
     if (verbose) puts("STUB: dgbmv_ called");
     return NULL;
 }
+*/
 
 void* dgeCopy(void)
 {
@@ -3347,53 +3799,69 @@ void* dgeSetZero(void)
     return NULL;
 }
 
+/*
 void* dgemm(void)
 {
     if (verbose) puts("STUB: dgemm called");
     return NULL;
 }
+*/
 
+/*
 void* dgemm_(void)
 {
     if (verbose) puts("STUB: dgemm_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgemv(void)
 {
     if (verbose) puts("STUB: dgemv called");
     return NULL;
 }
+*/
 
+/*
 void* dgemv_(void)
 {
     if (verbose) puts("STUB: dgemv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dger(void)
 {
     if (verbose) puts("STUB: dger called");
     return NULL;
 }
+*/
 
+/*
 void* dger_(void)
 {
     if (verbose) puts("STUB: dger_ called");
     return NULL;
 }
+*/
 
+/*
 void* dnrm2(void)
 {
     if (verbose) puts("STUB: dnrm2 called");
     return NULL;
 }
+*/
 
+/*
 void* dnrm2_(void)
 {
     if (verbose) puts("STUB: dnrm2_ called");
     return NULL;
 }
+*/
 
 void* double_general_add(void)
 {
@@ -3461,257 +3929,341 @@ void* double_outer_product_scalar(void)
     return NULL;
 }
 
+/*
 void* drot(void)
 {
     if (verbose) puts("STUB: drot called");
     return NULL;
 }
+*/
 
+/*
 void* drot_(void)
 {
     if (verbose) puts("STUB: drot_ called");
     return NULL;
 }
+*/
 
+/*
 void* drotg(void)
 {
     if (verbose) puts("STUB: drotg called");
     return NULL;
 }
+*/
 
+/*
 void* drotg_(void)
 {
     if (verbose) puts("STUB: drotg_ called");
     return NULL;
 }
+*/
 
+/*
 void* drotm(void)
 {
     if (verbose) puts("STUB: drotm called");
     return NULL;
 }
+*/
 
+/*
 void* drotm_(void)
 {
     if (verbose) puts("STUB: drotm_ called");
     return NULL;
 }
+*/
 
+/*
 void* drotmg(void)
 {
     if (verbose) puts("STUB: drotmg called");
     return NULL;
 }
+*/
 
+/*
 void* drotmg_(void)
 {
     if (verbose) puts("STUB: drotmg_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsbmv(void)
 {
     if (verbose) puts("STUB: dsbmv called");
     return NULL;
 }
+*/
 
+/*
 void* dsbmv_(void)
 {
     if (verbose) puts("STUB: dsbmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dscal(void)
 {
     if (verbose) puts("STUB: dscal called");
     return NULL;
 }
+*/
 
+/*
 void* dscal_(void)
 {
     if (verbose) puts("STUB: dscal_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsdot(void)
 {
     if (verbose) puts("STUB: dsdot called");
     return NULL;
 }
+*/
 
+/*
 void* dsdot_(void)
 {
     if (verbose) puts("STUB: dsdot_ called");
     return NULL;
 }
+*/
 
+/*
 void* dspmv(void)
 {
     if (verbose) puts("STUB: dspmv called");
     return NULL;
 }
+*/
 
+/*
 void* dspmv_(void)
 {
     if (verbose) puts("STUB: dspmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dspr(void)
 {
     if (verbose) puts("STUB: dspr called");
     return NULL;
 }
+*/
 
+/*
 void* dspr2(void)
 {
     if (verbose) puts("STUB: dspr2 called");
     return NULL;
 }
+*/
 
+/*
 void* dspr2_(void)
 {
     if (verbose) puts("STUB: dspr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* dspr_(void)
 {
     if (verbose) puts("STUB: dspr_ called");
     return NULL;
 }
+*/
 
+/*
 void* dswap(void)
 {
     if (verbose) puts("STUB: dswap called");
     return NULL;
 }
+*/
 
+/*
 void* dswap_(void)
 {
     if (verbose) puts("STUB: dswap_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsymm(void)
 {
     if (verbose) puts("STUB: dsymm called");
     return NULL;
 }
+*/
 
+/*
 void* dsymm_(void)
 {
     if (verbose) puts("STUB: dsymm_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsymv(void)
 {
     if (verbose) puts("STUB: dsymv called");
     return NULL;
 }
+*/
 
+/*
 void* dsymv_(void)
 {
     if (verbose) puts("STUB: dsymv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr(void)
 {
     if (verbose) puts("STUB: dsyr called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr2(void)
 {
     if (verbose) puts("STUB: dsyr2 called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr2_(void)
 {
     if (verbose) puts("STUB: dsyr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr2k(void)
 {
     if (verbose) puts("STUB: dsyr2k called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr2k_(void)
 {
     if (verbose) puts("STUB: dsyr2k_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsyr_(void)
 {
     if (verbose) puts("STUB: dsyr_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsyrk(void)
 {
     if (verbose) puts("STUB: dsyrk called");
     return NULL;
 }
+*/
 
+/*
 void* dsyrk_(void)
 {
     if (verbose) puts("STUB: dsyrk_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtbmv(void)
 {
     if (verbose) puts("STUB: dtbmv called");
     return NULL;
 }
+*/
 
+/*
 void* dtbmv_(void)
 {
     if (verbose) puts("STUB: dtbmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtbsv(void)
 {
     if (verbose) puts("STUB: dtbsv called");
     return NULL;
 }
+*/
 
+/*
 void* dtbsv_(void)
 {
     if (verbose) puts("STUB: dtbsv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtpmv(void)
 {
     if (verbose) puts("STUB: dtpmv called");
     return NULL;
 }
+*/
 
+/*
 void* dtpmv_(void)
 {
     if (verbose) puts("STUB: dtpmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtpsv(void)
 {
     if (verbose) puts("STUB: dtpsv called");
     return NULL;
 }
+*/
 
+/*
 void* dtpsv_(void)
 {
     if (verbose) puts("STUB: dtpsv_ called");
     return NULL;
 }
+*/
 
 void* dtrCopyLower(void)
 {
@@ -3725,53 +4277,69 @@ void* dtrSetZeroLower(void)
     return NULL;
 }
 
+/*
 void* dtrmm(void)
 {
     if (verbose) puts("STUB: dtrmm called");
     return NULL;
 }
+*/
 
+/*
 void* dtrmm_(void)
 {
     if (verbose) puts("STUB: dtrmm_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtrmv(void)
 {
     if (verbose) puts("STUB: dtrmv called");
     return NULL;
 }
+*/
 
+/*
 void* dtrmv_(void)
 {
     if (verbose) puts("STUB: dtrmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtrsm(void)
 {
     if (verbose) puts("STUB: dtrsm called");
     return NULL;
 }
+*/
 
+/*
 void* dtrsm_(void)
 {
     if (verbose) puts("STUB: dtrsm_ called");
     return NULL;
 }
+*/
 
+/*
 void* dtrsv(void)
 {
     if (verbose) puts("STUB: dtrsv called");
     return NULL;
 }
+*/
 
+/*
 void* dtrsv_(void)
 {
     if (verbose) puts("STUB: dtrsv_ called");
     return NULL;
 }
+*/
 
 void* dzasum(void)
 {
@@ -3881,29 +4449,37 @@ void* icamax_(void)
     return NULL;
 }
 
+/*
 void* idamax(void)
 {
     if (verbose) puts("STUB: idamax called");
     return NULL;
 }
+*/
 
+/*
 void* idamax_(void)
 {
     if (verbose) puts("STUB: idamax_ called");
     return NULL;
 }
+*/
 
+/*
 void* isamax(void)
 {
     if (verbose) puts("STUB: isamax called");
     return NULL;
 }
+*/
 
+/*
 void* isamax_(void)
 {
     if (verbose) puts("STUB: isamax_ called");
     return NULL;
 }
+*/
 
 void* izamax(void)
 {
@@ -3917,35 +4493,45 @@ void* izamax_(void)
     return NULL;
 }
 
+/*
 void* lsame_(void)
 {
     if (verbose) puts("STUB: lsame_ called");
     return NULL;
 }
+*/
 
+/*
 void* sasum(void)
 {
     if (verbose) puts("STUB: sasum called");
     return NULL;
 }
+*/
 
+/*
 void* sasum_(void)
 {
     if (verbose) puts("STUB: sasum_ called");
     return NULL;
 }
+*/
 
+/*
 void* saxpy(void)
 {
     if (verbose) puts("STUB: saxpy called");
     return NULL;
 }
+*/
 
+/*
 void* saxpy_(void)
 {
     if (verbose) puts("STUB: saxpy_ called");
     return NULL;
 }
+*/
 
 void* scasum(void)
 {
@@ -3971,53 +4557,69 @@ void* scnrm2_(void)
     return NULL;
 }
 
+/*
 void* scopy(void)
 {
     if (verbose) puts("STUB: scopy called");
     return NULL;
 }
+*/
 
+/*
 void* scopy_(void)
 {
     if (verbose) puts("STUB: scopy_ called");
     return NULL;
 }
+*/
 
+/*
 void* sdot(void)
 {
     if (verbose) puts("STUB: sdot called");
     return NULL;
 }
+*/
 
+/*
 void* sdot_(void)
 {
     if (verbose) puts("STUB: sdot_ called");
     return NULL;
 }
+*/
 
+/*
 void* sdsdot(void)
 {
     if (verbose) puts("STUB: sdsdot called");
     return NULL;
 }
+*/
 
+/*
 void* sdsdot_(void)
 {
     if (verbose) puts("STUB: sdsdot_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgbmv(void)
 {
     if (verbose) puts("STUB: sgbmv called");
     return NULL;
 }
+*/
 
+/*
 void* sgbmv_(void)
 {
     if (verbose) puts("STUB: sgbmv_ called");
     return NULL;
 }
+*/
 
 void* sgeCopy(void)
 {
@@ -4055,293 +4657,389 @@ void* sgeSetZero(void)
     return NULL;
 }
 
+/*
 void* sgemm(void)
 {
     if (verbose) puts("STUB: sgemm called");
     return NULL;
 }
+*/
 
+/*
 void* sgemm_(void)
 {
     if (verbose) puts("STUB: sgemm_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgemv(void)
 {
     if (verbose) puts("STUB: sgemv called");
     return NULL;
 }
+*/
 
+/*
 void* sgemv_(void)
 {
     if (verbose) puts("STUB: sgemv_ called");
     return NULL;
 }
+*/
 
+/*
 void* sger(void)
 {
     if (verbose) puts("STUB: sger called");
     return NULL;
 }
+*/
 
+/*
 void* sger_(void)
 {
     if (verbose) puts("STUB: sger_ called");
     return NULL;
 }
+*/
 
+/*
 void* snrm2(void)
 {
     if (verbose) puts("STUB: snrm2 called");
     return NULL;
 }
+*/
 
+/*
 void* snrm2_(void)
 {
     if (verbose) puts("STUB: snrm2_ called");
     return NULL;
 }
+*/
 
+/*
 void* srot(void)
 {
     if (verbose) puts("STUB: srot called");
     return NULL;
 }
+*/
 
+/*
 void* srot_(void)
 {
     if (verbose) puts("STUB: srot_ called");
     return NULL;
 }
+*/
 
+/*
 void* srotg(void)
 {
     if (verbose) puts("STUB: srotg called");
     return NULL;
 }
+*/
 
+/*
 void* srotg_(void)
 {
     if (verbose) puts("STUB: srotg_ called");
     return NULL;
 }
+*/
 
+/*
 void* srotm(void)
 {
     if (verbose) puts("STUB: srotm called");
     return NULL;
 }
+*/
 
+/*
 void* srotm_(void)
 {
     if (verbose) puts("STUB: srotm_ called");
     return NULL;
 }
+*/
 
+/*
 void* srotmg(void)
 {
     if (verbose) puts("STUB: srotmg called");
     return NULL;
 }
+*/
 
+/*
 void* srotmg_(void)
 {
     if (verbose) puts("STUB: srotmg_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssbmv(void)
 {
     if (verbose) puts("STUB: ssbmv called");
     return NULL;
 }
+*/
 
+/*
 void* ssbmv_(void)
 {
     if (verbose) puts("STUB: ssbmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* sscal(void)
 {
     if (verbose) puts("STUB: sscal called");
     return NULL;
 }
+*/
 
+/*
 void* sscal_(void)
 {
     if (verbose) puts("STUB: sscal_ called");
     return NULL;
 }
+*/
 
+/*
 void* sspmv(void)
 {
     if (verbose) puts("STUB: sspmv called");
     return NULL;
 }
+*/
 
+/*
 void* sspmv_(void)
 {
     if (verbose) puts("STUB: sspmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* sspr(void)
 {
     if (verbose) puts("STUB: sspr called");
     return NULL;
 }
+*/
 
+/*
 void* sspr2(void)
 {
     if (verbose) puts("STUB: sspr2 called");
     return NULL;
 }
+*/
 
+/*
 void* sspr2_(void)
 {
     if (verbose) puts("STUB: sspr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* sspr_(void)
 {
     if (verbose) puts("STUB: sspr_ called");
     return NULL;
 }
+*/
 
+/*
 void* sswap(void)
 {
     if (verbose) puts("STUB: sswap called");
     return NULL;
 }
+*/
 
+/*
 void* sswap_(void)
 {
     if (verbose) puts("STUB: sswap_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssymm(void)
 {
     if (verbose) puts("STUB: ssymm called");
     return NULL;
 }
+*/
 
+/*
 void* ssymm_(void)
 {
     if (verbose) puts("STUB: ssymm_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssymv(void)
 {
     if (verbose) puts("STUB: ssymv called");
     return NULL;
 }
+*/
 
+/*
 void* ssymv_(void)
 {
     if (verbose) puts("STUB: ssymv_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr(void)
 {
     if (verbose) puts("STUB: ssyr called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr2(void)
 {
     if (verbose) puts("STUB: ssyr2 called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr2_(void)
 {
     if (verbose) puts("STUB: ssyr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr2k(void)
 {
     if (verbose) puts("STUB: ssyr2k called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr2k_(void)
 {
     if (verbose) puts("STUB: ssyr2k_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssyr_(void)
 {
     if (verbose) puts("STUB: ssyr_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssyrk(void)
 {
     if (verbose) puts("STUB: ssyrk called");
     return NULL;
 }
+*/
 
+/*
 void* ssyrk_(void)
 {
     if (verbose) puts("STUB: ssyrk_ called");
     return NULL;
 }
+*/
 
+/*
 void* stbmv(void)
 {
     if (verbose) puts("STUB: stbmv called");
     return NULL;
 }
+*/
 
+/*
 void* stbmv_(void)
 {
     if (verbose) puts("STUB: stbmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* stbsv(void)
 {
     if (verbose) puts("STUB: stbsv called");
     return NULL;
 }
+*/
 
+/*
 void* stbsv_(void)
 {
     if (verbose) puts("STUB: stbsv_ called");
     return NULL;
 }
+*/
 
+/*
 void* stpmv(void)
 {
     if (verbose) puts("STUB: stpmv called");
     return NULL;
 }
+*/
 
+/*
 void* stpmv_(void)
 {
     if (verbose) puts("STUB: stpmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* stpsv(void)
 {
     if (verbose) puts("STUB: stpsv called");
     return NULL;
 }
+*/
 
+/*
 void* stpsv_(void)
 {
     if (verbose) puts("STUB: stpsv_ called");
     return NULL;
 }
+*/
 
 void* strCopyLower(void)
 {
@@ -4355,65 +5053,85 @@ void* strSetZeroLower(void)
     return NULL;
 }
 
+/*
 void* strmm(void)
 {
     if (verbose) puts("STUB: strmm called");
     return NULL;
 }
+*/
 
+/*
 void* strmm_(void)
 {
     if (verbose) puts("STUB: strmm_ called");
     return NULL;
 }
+*/
 
+/*
 void* strmv(void)
 {
     if (verbose) puts("STUB: strmv called");
     return NULL;
 }
+*/
 
+/*
 void* strmv_(void)
 {
     if (verbose) puts("STUB: strmv_ called");
     return NULL;
 }
+*/
 
+/*
 void* strsm(void)
 {
     if (verbose) puts("STUB: strsm called");
     return NULL;
 }
+*/
 
+/*
 void* strsm_(void)
 {
     if (verbose) puts("STUB: strsm_ called");
     return NULL;
 }
+*/
 
+/*
 void* strsv(void)
 {
     if (verbose) puts("STUB: strsv called");
     return NULL;
 }
+*/
 
+/*
 void* strsv_(void)
 {
     if (verbose) puts("STUB: strsv_ called");
     return NULL;
 }
+*/
 
+/*
 void* xerbla(void)
 {
     if (verbose) puts("STUB: xerbla called");
     return NULL;
 }
+*/
 
+/*
 void* xerbla_(void)
 {
     if (verbose) puts("STUB: xerbla_ called");
     return NULL;
 }
+*/
 
 void* xerbla_array__(void)
 {
@@ -0,0 +1,67 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Declarations of the column-major implementations, included by blas_internal.h with
+// REAL and PFX(name) defined for float and double.
+//
+// Vector increments may be negative, with the usual BLAS meaning. Arguments have been
+// validated by the caller.
+
+// Level 2. `storage` picks between the general/band/packed variants (GEMV/GBMV, SYMV/SBMV/SPMV,
+// TRMV/TBMV/TPMV...), k, kl and ku are only used for band matrices and lda isn't used for
+// packed ones.
+void PFX(gemv_impl)(enum blas_storage storage, bool trans, int m, int n, int kl, int ku,
+	REAL alpha, const REAL* a, int lda, const REAL* x, int incx, REAL beta, REAL* y, int incy);
+void PFX(ger_impl)(int m, int n, REAL alpha, const REAL* x, int incx, const REAL* y, int incy, REAL* a, int lda);
+void PFX(symv_impl)(enum blas_storage storage, bool upper, int n, int k,
+	REAL alpha, const REAL* a, int lda, const REAL* x, int incx, REAL beta, REAL* y, int incy);
+void PFX(syr_impl)(enum blas_storage storage, bool upper, int n, REAL alpha, const REAL* x, int incx, REAL* a, int lda);
+void PFX(syr2_impl)(enum blas_storage storage, bool upper, int n, REAL alpha,
+	const REAL* x, int incx, const REAL* y, int incy, REAL* a, int lda);
+void PFX(trmv_impl)(enum blas_storage storage, bool upper, bool trans, bool unit, int n, int k,
+	const REAL* a, int lda, REAL* x, int incx);
+void PFX(trsv_impl)(enum blas_storage storage, bool upper, bool trans, bool unit, int n, int k,
+	const REAL* a, int lda, REAL* x, int incx);
+
+// Level 3
+
+struct PFX(operand)
+{
+	const REAL* p;
+	int ld;
+	enum blas_operand_mode mode;
+};
+
+// C := alpha * A * B + beta * C with C being m x n and k the inner dimension; the blocked and
+// threaded product all level 3 routines are built on
+void PFX(gemm_operands)(int m, int n, int k, REAL alpha, const struct PFX(operand)* a, const struct PFX(operand)* b,
+	REAL beta, REAL* c, int ldc);
+
+void PFX(gemm_impl)(bool transa, bool transb, int m, int n, int k, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc);
+void PFX(symm_impl)(bool left, bool upper, int m, int n, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc);
+void PFX(syrk_impl)(bool upper, bool trans, int n, int k, REAL alpha, const REAL* a, int lda,
+	REAL beta, REAL* c, int ldc);
+void PFX(syr2k_impl)(bool upper, bool trans, int n, int k, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc);
+void PFX(trmm_impl)(bool left, bool upper, bool trans, bool unit, int m, int n, REAL alpha,
+	const REAL* a, int lda, REAL* b, int ldb);
+void PFX(trsm_impl)(bool left, bool upper, bool trans, bool unit, int m, int n, REAL alpha,
+	const REAL* a, int lda, REAL* b, int ldb);
@@ -0,0 +1,89 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _BLAS_INTERNAL_H_
+#define _BLAS_INTERNAL_H_
+
+#include <BLAS/BLAS.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Nothing declared here is part of the library's interface, only the CBLAS and Fortran entry points are exported
+#pragma GCC visibility push(hidden)
+
+// The CBLAS and Fortran entry points validate their arguments and translate them into calls
+// of the *_impl functions below, which work on column-major data only.
+
+// Where a vector with a negative increment starts, relative to the pointer passed in
+#define BLAS_START(n, inc) ((inc) < 0 ? (ptrdiff_t) (1 - (n)) * (inc) : 0)
+
+// Runs fn(ctx, 0) ... fn(ctx, tasks - 1) on the thread pool, the caller takes part.
+// Calls made from inside a task, or while another thread is using the pool, run serially.
+void blas_parallel_for(int tasks, void (*fn)(void* ctx, int task), void* ctx);
+
+// Per-thread memory for packing, 64-byte aligned. There are BLAS_SCRATCH_SLOTS independent
+// buffers per thread, each valid until the next call for the same slot on the same thread.
+#define BLAS_SCRATCH_SLOTS 3
+void* blas_scratch(int slot, size_t size);
+
+// Reports an invalid argument to the handler set with SetBLASParamErrorProc(),
+// or prints an error and aborts if there is none. `pos` is 1-based.
+void blas_param_error(const char* routine, const char* param, int pos, int value);
+
+// How the matrix of a level 2 routine is stored
+enum blas_storage
+{
+	blas_dense,
+	// LAPACK band storage, with kl sub- and ku super-diagonals
+	blas_band,
+	// packed triangle, column by column
+	blas_packed,
+};
+
+// How the blocked matrix product reads one of its operands: as stored, transposed,
+// or as a symmetric matrix of which only the upper or lower triangle is stored
+enum blas_operand_mode
+{
+	blas_operand_normal,
+	blas_operand_trans,
+	blas_operand_sym_upper,
+	blas_operand_sym_lower,
+};
+
+// Tuning parameters for GEMM: the micro-kernels compute MR x BLAS_NR tiles of C from packed
+// panels. MR depends on the vector width picked at runtime.
+#define BLAS_NR 6
+#define BLAS_KC 256
+#define BLAS_NC 1536
+
+#define REAL float
+#define PFX(name) s##name
+#include "blas_impl.h"
+#undef REAL
+#undef PFX
+
+#define REAL double
+#define PFX(name) d##name
+#include "blas_impl.h"
+#undef REAL
+#undef PFX
+
+#pragma GCC visibility pop
+
+#endif
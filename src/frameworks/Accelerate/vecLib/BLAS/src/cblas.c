@@ -0,0 +1,88 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+
+static inline bool valid_order(enum CBLAS_ORDER order)
+{
+	return order == CblasRowMajor || order == CblasColMajor;
+}
+
+// AtlasConj (conjugate without transposing) is accepted too, it means nothing for real matrices
+static inline bool valid_trans(enum CBLAS_TRANSPOSE trans)
+{
+	return trans == CblasNoTrans || trans == CblasTrans || trans == CblasConjTrans || trans == AtlasConj;
+}
+
+static inline bool valid_uplo(enum CBLAS_UPLO uplo)
+{
+	return uplo == CblasUpper || uplo == CblasLower;
+}
+
+static inline bool valid_diag(enum CBLAS_DIAG diag)
+{
+	return diag == CblasNonUnit || diag == CblasUnit;
+}
+
+static inline bool valid_side(enum CBLAS_SIDE side)
+{
+	return side == CblasLeft || side == CblasRight;
+}
+
+static inline bool is_trans(enum CBLAS_TRANSPOSE trans)
+{
+	return trans == CblasTrans || trans == CblasConjTrans;
+}
+
+// Whether the column-major matrix the implementations see has its upper triangle stored
+static inline bool is_upper(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo)
+{
+	return (uplo == CblasUpper) == (order == CblasColMajor);
+}
+
+#define MAX1(x) ((x) > 1 ? (x) : 1)
+
+#define CHECK(cond, pos, param, value) \
+	do { \
+		if (!(cond)) \
+		{ \
+			blas_param_error(routine, param, pos, value); \
+			return; \
+		} \
+	} while (0)
+
+#define REAL float
+#define CBLAS(name) cblas_s##name
+#define ROUTINE(name) "cblas_s" #name
+#define PFX(name) s##name
+#include "cblas_template.h"
+#undef REAL
+#undef CBLAS
+#undef ROUTINE
+#undef PFX
+
+#define REAL double
+#define CBLAS(name) cblas_d##name
+#define ROUTINE(name) "cblas_d" #name
+#define PFX(name) d##name
+#include "cblas_template.h"
+#undef REAL
+#undef CBLAS
+#undef ROUTINE
+#undef PFX
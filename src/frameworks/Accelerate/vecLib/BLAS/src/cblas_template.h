@@ -0,0 +1,368 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Level 2 and 3 CBLAS routines, included by cblas.c with REAL, CBLAS(name), ROUTINE(name)
+// for the routine's name as a string and PFX(name) for the implementations defined.
+//
+// Arguments are checked first, with positions counted like the reference CBLAS does (Order
+// being 1). Row-major calls are then turned into column-major ones: a row-major matrix is
+// its transpose in column-major order, which swaps the triangle of symmetric and triangular
+// matrices and the side they are applied from.
+
+void CBLAS(gemv)(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__X, const int __incX, const REAL __beta, REAL *__Y, const int __incY)
+{
+	static const char routine[] = ROUTINE(gemv);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_trans(__TransA), 2, "TransA", __TransA);
+	CHECK(__M >= 0, 3, "M", __M);
+	CHECK(__N >= 0, 4, "N", __N);
+	CHECK(__lda >= MAX1(__Order == CblasColMajor ? __M : __N), 7, "lda", __lda);
+	CHECK(__incX != 0, 9, "incX", __incX);
+	CHECK(__incY != 0, 12, "incY", __incY);
+
+	if (__Order == CblasColMajor)
+		PFX(gemv_impl)(blas_dense, is_trans(__TransA), __M, __N, 0, 0, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+	else
+		PFX(gemv_impl)(blas_dense, !is_trans(__TransA), __N, __M, 0, 0, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+}
+
+void CBLAS(gbmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const int __M, const int __N, const int __KL, const int __KU, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__X, const int __incX, const REAL __beta, REAL *__Y, const int __incY)
+{
+	static const char routine[] = ROUTINE(gbmv);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_trans(__TransA), 2, "TransA", __TransA);
+	CHECK(__M >= 0, 3, "M", __M);
+	CHECK(__N >= 0, 4, "N", __N);
+	CHECK(__KL >= 0, 5, "KL", __KL);
+	CHECK(__KU >= 0, 6, "KU", __KU);
+	CHECK(__lda >= __KL + __KU + 1, 9, "lda", __lda);
+	CHECK(__incX != 0, 11, "incX", __incX);
+	CHECK(__incY != 0, 14, "incY", __incY);
+
+	// the transposed band matrix has its sub- and super-diagonals swapped
+	if (__Order == CblasColMajor)
+		PFX(gemv_impl)(blas_band, is_trans(__TransA), __M, __N, __KL, __KU, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+	else
+		PFX(gemv_impl)(blas_band, !is_trans(__TransA), __N, __M, __KU, __KL, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+}
+
+void CBLAS(ger)(const enum CBLAS_ORDER __Order, const int __M, const int __N, const REAL __alpha, const REAL *__X, const int __incX, const REAL *__Y, const int __incY, REAL *__A, const int __lda)
+{
+	static const char routine[] = ROUTINE(ger);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(__M >= 0, 2, "M", __M);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 6, "incX", __incX);
+	CHECK(__incY != 0, 8, "incY", __incY);
+	CHECK(__lda >= MAX1(__Order == CblasColMajor ? __M : __N), 10, "lda", __lda);
+
+	if (__Order == CblasColMajor)
+		PFX(ger_impl)(__M, __N, __alpha, __X, __incX, __Y, __incY, __A, __lda);
+	else
+		PFX(ger_impl)(__N, __M, __alpha, __Y, __incY, __X, __incX, __A, __lda);
+}
+
+void CBLAS(symv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__X, const int __incX, const REAL __beta, REAL *__Y, const int __incY)
+{
+	static const char routine[] = ROUTINE(symv);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__lda >= MAX1(__N), 6, "lda", __lda);
+	CHECK(__incX != 0, 8, "incX", __incX);
+	CHECK(__incY != 0, 11, "incY", __incY);
+
+	PFX(symv_impl)(blas_dense, is_upper(__Order, __Uplo), __N, 0, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+}
+
+void CBLAS(sbmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const int __K, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__X, const int __incX, const REAL __beta, REAL *__Y, const int __incY)
+{
+	static const char routine[] = ROUTINE(sbmv);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__K >= 0, 4, "K", __K);
+	CHECK(__lda >= __K + 1, 7, "lda", __lda);
+	CHECK(__incX != 0, 9, "incX", __incX);
+	CHECK(__incY != 0, 12, "incY", __incY);
+
+	PFX(symv_impl)(blas_band, is_upper(__Order, __Uplo), __N, __K, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY);
+}
+
+void CBLAS(spmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__Ap, const REAL *__X, const int __incX, const REAL __beta, REAL *__Y, const int __incY)
+{
+	static const char routine[] = ROUTINE(spmv);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 7, "incX", __incX);
+	CHECK(__incY != 0, 10, "incY", __incY);
+
+	PFX(symv_impl)(blas_packed, is_upper(__Order, __Uplo), __N, 0, __alpha, __Ap, 0, __X, __incX, __beta, __Y, __incY);
+}
+
+void CBLAS(syr)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__X, const int __incX, REAL *__A, const int __lda)
+{
+	static const char routine[] = ROUTINE(syr);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 6, "incX", __incX);
+	CHECK(__lda >= MAX1(__N), 8, "lda", __lda);
+
+	PFX(syr_impl)(blas_dense, is_upper(__Order, __Uplo), __N, __alpha, __X, __incX, __A, __lda);
+}
+
+void CBLAS(spr)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__X, const int __incX, REAL *__Ap)
+{
+	static const char routine[] = ROUTINE(spr);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 6, "incX", __incX);
+
+	PFX(syr_impl)(blas_packed, is_upper(__Order, __Uplo), __N, __alpha, __X, __incX, __Ap, 0);
+}
+
+void CBLAS(syr2)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__X, const int __incX, const REAL *__Y, const int __incY, REAL *__A, const int __lda)
+{
+	static const char routine[] = ROUTINE(syr2);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 6, "incX", __incX);
+	CHECK(__incY != 0, 8, "incY", __incY);
+	CHECK(__lda >= MAX1(__N), 10, "lda", __lda);
+
+	PFX(syr2_impl)(blas_dense, is_upper(__Order, __Uplo), __N, __alpha, __X, __incX, __Y, __incY, __A, __lda);
+}
+
+void CBLAS(spr2)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const int __N, const REAL __alpha, const REAL *__X, const int __incX, const REAL *__Y, const int __incY, REAL *__A)
+{
+	static const char routine[] = ROUTINE(spr2);
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(__N >= 0, 3, "N", __N);
+	CHECK(__incX != 0, 6, "incX", __incX);
+	CHECK(__incY != 0, 8, "incY", __incY);
+
+	PFX(syr2_impl)(blas_packed, is_upper(__Order, __Uplo), __N, __alpha, __X, __incX, __Y, __incY, __A, 0);
+}
+
+// The triangular solves and products share their checks, `k_pos` is 0 for routines without K
+// and `lda_pos` for those without lda
+#define CHECK_TRIANGULAR(k_pos, lda_pos, lda_min, incx_pos) \
+	CHECK(valid_order(__Order), 1, "Order", __Order); \
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo); \
+	CHECK(valid_trans(__TransA), 3, "TransA", __TransA); \
+	CHECK(valid_diag(__Diag), 4, "Diag", __Diag); \
+	CHECK(__N >= 0, 5, "N", __N); \
+	CHECK(k_pos == 0 || k >= 0, k_pos, "K", k); \
+	CHECK(lda_pos == 0 || lda >= (lda_min), lda_pos, "lda", lda); \
+	CHECK(__incX != 0, incx_pos, "incX", __incX)
+
+// Row-major matrices are transposed, with their other triangle stored
+#define TRIANGULAR(fn, storage) \
+	fn(storage, is_upper(__Order, __Uplo), is_trans(__TransA) != (__Order == CblasRowMajor), __Diag == CblasUnit, \
+		__N, k, a, lda, __X, __incX)
+
+void CBLAS(trmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const REAL *__A, const int __lda, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(trmv);
+	const REAL* a = __A;
+	const int k = 0, lda = __lda;
+
+	CHECK_TRIANGULAR(0, 7, MAX1(__N), 9);
+	TRIANGULAR(PFX(trmv_impl), blas_dense);
+}
+
+void CBLAS(tbmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const REAL *__A, const int __lda, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(tbmv);
+	const REAL* a = __A;
+	const int k = __K, lda = __lda;
+
+	CHECK_TRIANGULAR(6, 8, __K + 1, 10);
+	TRIANGULAR(PFX(trmv_impl), blas_band);
+}
+
+void CBLAS(tpmv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const REAL *__Ap, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(tpmv);
+	const REAL* a = __Ap;
+	const int k = 0, lda = 0;
+
+	CHECK_TRIANGULAR(0, 0, 0, 8);
+	TRIANGULAR(PFX(trmv_impl), blas_packed);
+}
+
+void CBLAS(trsv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const REAL *__A, const int __lda, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(trsv);
+	const REAL* a = __A;
+	const int k = 0, lda = __lda;
+
+	CHECK_TRIANGULAR(0, 7, MAX1(__N), 9);
+	TRIANGULAR(PFX(trsv_impl), blas_dense);
+}
+
+void CBLAS(tbsv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const int __K, const REAL *__A, const int __lda, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(tbsv);
+	const REAL* a = __A;
+	const int k = __K, lda = __lda;
+
+	CHECK_TRIANGULAR(6, 8, __K + 1, 10);
+	TRIANGULAR(PFX(trsv_impl), blas_band);
+}
+
+void CBLAS(tpsv)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __N, const REAL *__Ap, REAL *__X, const int __incX)
+{
+	static const char routine[] = ROUTINE(tpsv);
+	const REAL* a = __Ap;
+	const int k = 0, lda = 0;
+
+	CHECK_TRIANGULAR(0, 0, 0, 8);
+	TRIANGULAR(PFX(trsv_impl), blas_packed);
+}
+
+#undef CHECK_TRIANGULAR
+#undef TRIANGULAR
+
+void CBLAS(gemm)(const enum CBLAS_ORDER __Order, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_TRANSPOSE __TransB, const int __M, const int __N, const int __K, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__B, const int __ldb, const REAL __beta, REAL *__C, const int __ldc)
+{
+	static const char routine[] = ROUTINE(gemm);
+	const bool col = __Order == CblasColMajor;
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_trans(__TransA), 2, "TransA", __TransA);
+	CHECK(valid_trans(__TransB), 3, "TransB", __TransB);
+	CHECK(__M >= 0, 4, "M", __M);
+	CHECK(__N >= 0, 5, "N", __N);
+	CHECK(__K >= 0, 6, "K", __K);
+	CHECK(__lda >= MAX1((is_trans(__TransA) == col) ? __K : __M), 9, "lda", __lda);
+	CHECK(__ldb >= MAX1((is_trans(__TransB) == col) ? __N : __K), 11, "ldb", __ldb);
+	CHECK(__ldc >= MAX1(col ? __M : __N), 14, "ldc", __ldc);
+
+	// C^T = op(B)^T * op(A)^T
+	if (col)
+		PFX(gemm_impl)(is_trans(__TransA), is_trans(__TransB), __M, __N, __K, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc);
+	else
+		PFX(gemm_impl)(is_trans(__TransB), is_trans(__TransA), __N, __M, __K, __alpha, __B, __ldb, __A, __lda, __beta, __C, __ldc);
+}
+
+void CBLAS(symm)(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const int __M, const int __N, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__B, const int __ldb, const REAL __beta, REAL *__C, const int __ldc)
+{
+	static const char routine[] = ROUTINE(symm);
+	const bool col = __Order == CblasColMajor;
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_side(__Side), 2, "Side", __Side);
+	CHECK(valid_uplo(__Uplo), 3, "Uplo", __Uplo);
+	CHECK(__M >= 0, 4, "M", __M);
+	CHECK(__N >= 0, 5, "N", __N);
+	CHECK(__lda >= MAX1(__Side == CblasLeft ? __M : __N), 8, "lda", __lda);
+	CHECK(__ldb >= MAX1(col ? __M : __N), 10, "ldb", __ldb);
+	CHECK(__ldc >= MAX1(col ? __M : __N), 13, "ldc", __ldc);
+
+	if (col)
+		PFX(symm_impl)(__Side == CblasLeft, __Uplo == CblasUpper, __M, __N, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc);
+	else
+		PFX(symm_impl)(__Side != CblasLeft, __Uplo != CblasUpper, __N, __M, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc);
+}
+
+void CBLAS(syrk)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const REAL __alpha, const REAL *__A, const int __lda, const REAL __beta, REAL *__C, const int __ldc)
+{
+	static const char routine[] = ROUTINE(syrk);
+	const bool col = __Order == CblasColMajor;
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(valid_trans(__Trans), 3, "Trans", __Trans);
+	CHECK(__N >= 0, 4, "N", __N);
+	CHECK(__K >= 0, 5, "K", __K);
+	CHECK(__lda >= MAX1((is_trans(__Trans) == col) ? __K : __N), 8, "lda", __lda);
+	CHECK(__ldc >= MAX1(__N), 11, "ldc", __ldc);
+
+	PFX(syrk_impl)(is_upper(__Order, __Uplo), is_trans(__Trans) == col, __N, __K, __alpha, __A, __lda, __beta, __C, __ldc);
+}
+
+void CBLAS(syr2k)(const enum CBLAS_ORDER __Order, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __Trans, const int __N, const int __K, const REAL __alpha, const REAL *__A, const int __lda, const REAL *__B, const int __ldb, const REAL __beta, REAL *__C, const int __ldc)
+{
+	static const char routine[] = ROUTINE(syr2k);
+	const bool col = __Order == CblasColMajor;
+
+	CHECK(valid_order(__Order), 1, "Order", __Order);
+	CHECK(valid_uplo(__Uplo), 2, "Uplo", __Uplo);
+	CHECK(valid_trans(__Trans), 3, "Trans", __Trans);
+	CHECK(__N >= 0, 4, "N", __N);
+	CHECK(__K >= 0, 5, "K", __K);
+	CHECK(__lda >= MAX1((is_trans(__Trans) == col) ? __K : __N), 8, "lda", __lda);
+	CHECK(__ldb >= MAX1((is_trans(__Trans) == col) ? __K : __N), 10, "ldb", __ldb);
+	CHECK(__ldc >= MAX1(__N), 13, "ldc", __ldc);
+
+	PFX(syr2k_impl)(is_upper(__Order, __Uplo), is_trans(__Trans) == col, __N, __K, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc);
+}
+
+#define CHECK_TRIANGULAR_MATRIX() \
+	CHECK(valid_order(__Order), 1, "Order", __Order); \
+	CHECK(valid_side(__Side), 2, "Side", __Side); \
+	CHECK(valid_uplo(__Uplo), 3, "Uplo", __Uplo); \
+	CHECK(valid_trans(__TransA), 4, "TransA", __TransA); \
+	CHECK(valid_diag(__Diag), 5, "Diag", __Diag); \
+	CHECK(__M >= 0, 6, "M", __M); \
+	CHECK(__N >= 0, 7, "N", __N); \
+	CHECK(__lda >= MAX1(__Side == CblasLeft ? __M : __N), 10, "lda", __lda); \
+	CHECK(__ldb >= MAX1(__Order == CblasColMajor ? __M : __N), 12, "ldb", __ldb)
+
+// B^T := alpha * B^T * op(A)^T, where the stored A^T has the other triangle and the same op
+#define TRIANGULAR_MATRIX(fn) \
+	if (__Order == CblasColMajor) \
+		fn(__Side == CblasLeft, __Uplo == CblasUpper, is_trans(__TransA), __Diag == CblasUnit, __M, __N, __alpha, __A, __lda, __B, __ldb); \
+	else \
+		fn(__Side != CblasLeft, __Uplo != CblasUpper, is_trans(__TransA), __Diag == CblasUnit, __N, __M, __alpha, __A, __lda, __B, __ldb)
+
+void CBLAS(trmm)(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const REAL __alpha, const REAL *__A, const int __lda, REAL *__B, const int __ldb)
+{
+	static const char routine[] = ROUTINE(trmm);
+
+	CHECK_TRIANGULAR_MATRIX();
+	TRIANGULAR_MATRIX(PFX(trmm_impl));
+}
+
+void CBLAS(trsm)(const enum CBLAS_ORDER __Order, const enum CBLAS_SIDE __Side, const enum CBLAS_UPLO __Uplo, const enum CBLAS_TRANSPOSE __TransA, const enum CBLAS_DIAG __Diag, const int __M, const int __N, const REAL __alpha, const REAL *__A, const int __lda, REAL *__B, const int __ldb)
+{
+	static const char routine[] = ROUTINE(trsm);
+
+	CHECK_TRIANGULAR_MATRIX();
+	TRIANGULAR_MATRIX(PFX(trsm_impl));
+}
+
+#undef CHECK_TRIANGULAR_MATRIX
+#undef TRIANGULAR_MATRIX
@@ -0,0 +1,104 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ctype.h>
+
+static BLASParamErrorProc error_proc = NULL;
+
+void SetBLASParamErrorProc(BLASParamErrorProc __ErrorProc)
+{
+	error_proc = __ErrorProc;
+}
+
+void blas_param_error(const char* routine, const char* param, int pos, int value)
+{
+	if (error_proc)
+	{
+		error_proc(routine, param, &pos, &value);
+		return;
+	}
+
+	fprintf(stderr, "BLAS error: Parameter number %d passed to %s (%s) had an invalid value: %d\n",
+		pos, routine, param, value);
+	abort();
+}
+
+void cblas_xerbla(int __p, const char *__rout, const char *__form, ...)
+{
+	va_list args;
+
+	if (__p)
+		fprintf(stderr, "Parameter %d to routine %s was incorrect\n", __p, __rout);
+
+	va_start(args, __form);
+	vfprintf(stderr, __form, args);
+	va_end(args);
+
+	abort();
+}
+
+int cblas_errprn(int __ierr, int __info, const char *__form, ...)
+{
+	va_list args;
+
+	va_start(args, __form);
+	vfprintf(stderr, __form, args);
+	va_end(args);
+
+	return (__ierr < __info) ? __ierr : __info;
+}
+
+void xerbla_(const char *__srname, const int *__info)
+{
+	// Fortran strings aren't terminated, routine names are at most 6 characters
+	char name[7];
+	size_t len = strnlen(__srname, 6);
+
+	memcpy(name, __srname, len);
+	name[len] = '\0';
+	while (len > 0 && name[len - 1] == ' ')
+		name[--len] = '\0';
+
+	blas_param_error(name, "", *__info, 0);
+}
+
+void xerbla(const char *__srname, const int *__info)
+{
+	xerbla_(__srname, __info);
+}
+
+void XERBLA(const char *__srname, const int *__info)
+{
+	xerbla_(__srname, __info);
+}
+
+void XERBLA_(const char *__srname, const int *__info)
+{
+	xerbla_(__srname, __info);
+}
+
+int lsame_(const char *__ca, const char *__cb)
+{
+	return toupper((unsigned char) *__ca) == toupper((unsigned char) *__cb);
+}
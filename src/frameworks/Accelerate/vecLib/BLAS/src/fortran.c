@@ -0,0 +1,125 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+
+static inline bool valid_trans(const char* trans)
+{
+	return lsame_(trans, "N") || lsame_(trans, "T") || lsame_(trans, "C");
+}
+
+static inline bool valid_uplo(const char* uplo)
+{
+	return lsame_(uplo, "U") || lsame_(uplo, "L");
+}
+
+static inline bool valid_diag(const char* diag)
+{
+	return lsame_(diag, "U") || lsame_(diag, "N");
+}
+
+static inline bool valid_side(const char* side)
+{
+	return lsame_(side, "L") || lsame_(side, "R");
+}
+
+#define MAX1(x) ((x) > 1 ? (x) : 1)
+
+#define CHECK(cond, pos, param, value) \
+	do { \
+		if (!(cond)) \
+		{ \
+			blas_param_error(routine, param, pos, value); \
+			return; \
+		} \
+	} while (0)
+
+// Every routine is exported as name_, name, NAME and NAME_
+#define FORTRAN_ALIASES(impl, lower, upper, upper_, params, args) \
+	void lower params { impl args; } \
+	void upper params { impl args; } \
+	void upper_ params { impl args; }
+
+#define FORTRAN_FUNCTION_ALIASES(type, impl, lower, upper, upper_, params, args) \
+	type lower params { return impl args; } \
+	type upper params { return impl args; } \
+	type upper_ params { return impl args; }
+
+#define REAL float
+#define F(name) s##name
+#define FU(name) S##name
+#define ROUTINE(name) "S" #name
+#define CBLAS(name) cblas_s##name
+#define PFX(name) s##name
+#include "fortran_template.h"
+#undef REAL
+#undef F
+#undef FU
+#undef ROUTINE
+#undef CBLAS
+#undef PFX
+
+#define REAL double
+#define F(name) d##name
+#define FU(name) D##name
+#define ROUTINE(name) "D" #name
+#define CBLAS(name) cblas_d##name
+#define PFX(name) d##name
+#include "fortran_template.h"
+#undef REAL
+#undef F
+#undef FU
+#undef ROUTINE
+#undef CBLAS
+#undef PFX
+
+// Fortran indices are 1-based, with 0 meaning that there are no elements
+int isamax_(const int *__N, const float *__X, const int *__incX)
+{
+	if (*__N <= 0 || *__incX <= 0)
+		return 0;
+	return cblas_isamax(*__N, __X, *__incX) + 1;
+}
+FORTRAN_FUNCTION_ALIASES(int, isamax_, isamax, ISAMAX, ISAMAX_,
+	(const int *__N, const float *__X, const int *__incX), (__N, __X, __incX))
+
+int idamax_(const int *__N, const double *__X, const int *__incX)
+{
+	if (*__N <= 0 || *__incX <= 0)
+		return 0;
+	return cblas_idamax(*__N, __X, *__incX) + 1;
+}
+FORTRAN_FUNCTION_ALIASES(int, idamax_, idamax, IDAMAX, IDAMAX_,
+	(const int *__N, const double *__X, const int *__incX), (__N, __X, __incX))
+
+double sdsdot_(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY)
+{
+	return cblas_sdsdot(*__N, *__sb, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_FUNCTION_ALIASES(double, sdsdot_, sdsdot, SDSDOT, SDSDOT_,
+	(const int *__N, const float *__sb, const float *__X, const int *__incX, const float *__Y, const int *__incY),
+	(__N, __sb, __X, __incX, __Y, __incY))
+
+double dsdot_(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY)
+{
+	return cblas_dsdot(*__N, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_FUNCTION_ALIASES(double, dsdot_, dsdot, DSDOT, DSDOT_,
+	(const int *__N, const float *__X, const int *__incX, const float *__Y, const int *__incY),
+	(__N, __X, __incX, __Y, __incY))
@@ -0,0 +1,478 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The Fortran BLAS interface, included by fortran.c with REAL, F(name) and FU(name) for the
+// lower- and upper-case names, ROUTINE(name) for the name reported on errors and PFX(name)
+// for the implementations defined.
+//
+// Everything is passed by reference, and following the f2c convention functions returning
+// REAL return a double. Arguments are checked like the reference BLAS does, with the same
+// parameter positions.
+
+// Level 1
+
+double F(asum_)(const int *__N, const REAL *__X, const int *__incX)
+{
+	return CBLAS(asum)(*__N, __X, *__incX);
+}
+FORTRAN_FUNCTION_ALIASES(double, F(asum_), F(asum), FU(ASUM), FU(ASUM_),
+	(const int *__N, const REAL *__X, const int *__incX), (__N, __X, __incX))
+
+void F(axpy_)(const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__Y, const int *__incY)
+{
+	CBLAS(axpy)(*__N, *__alpha, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(axpy_), F(axpy), FU(AXPY), FU(AXPY_),
+	(const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__Y, const int *__incY),
+	(__N, __alpha, __X, __incX, __Y, __incY))
+
+void F(copy_)(const int *__N, const REAL *__X, const int *__incX, REAL *__Y, const int *__incY)
+{
+	CBLAS(copy)(*__N, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(copy_), F(copy), FU(COPY), FU(COPY_),
+	(const int *__N, const REAL *__X, const int *__incX, REAL *__Y, const int *__incY),
+	(__N, __X, __incX, __Y, __incY))
+
+double F(dot_)(const int *__N, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY)
+{
+	return CBLAS(dot)(*__N, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_FUNCTION_ALIASES(double, F(dot_), F(dot), FU(DOT), FU(DOT_),
+	(const int *__N, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY),
+	(__N, __X, __incX, __Y, __incY))
+
+double F(nrm2_)(const int *__N, const REAL *__X, const int *__incX)
+{
+	return CBLAS(nrm2)(*__N, __X, *__incX);
+}
+FORTRAN_FUNCTION_ALIASES(double, F(nrm2_), F(nrm2), FU(NRM2), FU(NRM2_),
+	(const int *__N, const REAL *__X, const int *__incX), (__N, __X, __incX))
+
+void F(rot_)(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY, const REAL *__c, const REAL *__s)
+{
+	CBLAS(rot)(*__N, __X, *__incX, __Y, *__incY, *__c, *__s);
+}
+FORTRAN_ALIASES(F(rot_), F(rot), FU(ROT), FU(ROT_),
+	(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY, const REAL *__c, const REAL *__s),
+	(__N, __X, __incX, __Y, __incY, __c, __s))
+
+void F(rotg_)(REAL *__a, REAL *__b, REAL *__c, REAL *__s)
+{
+	CBLAS(rotg)(__a, __b, __c, __s);
+}
+FORTRAN_ALIASES(F(rotg_), F(rotg), FU(ROTG), FU(ROTG_),
+	(REAL *__a, REAL *__b, REAL *__c, REAL *__s), (__a, __b, __c, __s))
+
+void F(rotm_)(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY, const REAL *__P)
+{
+	CBLAS(rotm)(*__N, __X, *__incX, __Y, *__incY, __P);
+}
+FORTRAN_ALIASES(F(rotm_), F(rotm), FU(ROTM), FU(ROTM_),
+	(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY, const REAL *__P),
+	(__N, __X, __incX, __Y, __incY, __P))
+
+void F(rotmg_)(REAL *__d1, REAL *__d2, REAL *__b1, const REAL *__b2, REAL *__P)
+{
+	CBLAS(rotmg)(__d1, __d2, __b1, *__b2, __P);
+}
+FORTRAN_ALIASES(F(rotmg_), F(rotmg), FU(ROTMG), FU(ROTMG_),
+	(REAL *__d1, REAL *__d2, REAL *__b1, const REAL *__b2, REAL *__P), (__d1, __d2, __b1, __b2, __P))
+
+void F(scal_)(const int *__N, const REAL *__alpha, REAL *__X, const int *__incX)
+{
+	CBLAS(scal)(*__N, *__alpha, __X, *__incX);
+}
+FORTRAN_ALIASES(F(scal_), F(scal), FU(SCAL), FU(SCAL_),
+	(const int *__N, const REAL *__alpha, REAL *__X, const int *__incX), (__N, __alpha, __X, __incX))
+
+void F(swap_)(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY)
+{
+	CBLAS(swap)(*__N, __X, *__incX, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(swap_), F(swap), FU(SWAP), FU(SWAP_),
+	(const int *__N, REAL *__X, const int *__incX, REAL *__Y, const int *__incY), (__N, __X, __incX, __Y, __incY))
+
+// Level 2
+
+void F(gemv_)(const char *__Trans, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY)
+{
+	static const char routine[] = ROUTINE(GEMV);
+
+	CHECK(valid_trans(__Trans), 1, "TRANS", *__Trans);
+	CHECK(*__M >= 0, 2, "M", *__M);
+	CHECK(*__N >= 0, 3, "N", *__N);
+	CHECK(*__lda >= MAX1(*__M), 6, "LDA", *__lda);
+	CHECK(*__incX != 0, 8, "INCX", *__incX);
+	CHECK(*__incY != 0, 11, "INCY", *__incY);
+
+	PFX(gemv_impl)(blas_dense, !lsame_(__Trans, "N"), *__M, *__N, 0, 0, *__alpha, __A, *__lda, __X, *__incX, *__beta, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(gemv_), F(gemv), FU(GEMV), FU(GEMV_),
+	(const char *__Trans, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY),
+	(__Trans, __M, __N, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY))
+
+void F(gbmv_)(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY)
+{
+	static const char routine[] = ROUTINE(GBMV);
+
+	CHECK(valid_trans(__Trans), 1, "TRANS", *__Trans);
+	CHECK(*__M >= 0, 2, "M", *__M);
+	CHECK(*__N >= 0, 3, "N", *__N);
+	CHECK(*__KL >= 0, 4, "KL", *__KL);
+	CHECK(*__KU >= 0, 5, "KU", *__KU);
+	CHECK(*__lda >= *__KL + *__KU + 1, 8, "LDA", *__lda);
+	CHECK(*__incX != 0, 10, "INCX", *__incX);
+	CHECK(*__incY != 0, 13, "INCY", *__incY);
+
+	PFX(gemv_impl)(blas_band, !lsame_(__Trans, "N"), *__M, *__N, *__KL, *__KU, *__alpha, __A, *__lda, __X, *__incX, *__beta, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(gbmv_), F(gbmv), FU(GBMV), FU(GBMV_),
+	(const char *__Trans, const int *__M, const int *__N, const int *__KL, const int *__KU, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY),
+	(__Trans, __M, __N, __KL, __KU, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY))
+
+void F(ger_)(const int *__M, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__A, const int *__lda)
+{
+	static const char routine[] = ROUTINE(GER);
+
+	CHECK(*__M >= 0, 1, "M", *__M);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 5, "INCX", *__incX);
+	CHECK(*__incY != 0, 7, "INCY", *__incY);
+	CHECK(*__lda >= MAX1(*__M), 9, "LDA", *__lda);
+
+	PFX(ger_impl)(*__M, *__N, *__alpha, __X, *__incX, __Y, *__incY, __A, *__lda);
+}
+FORTRAN_ALIASES(F(ger_), F(ger), FU(GER), FU(GER_),
+	(const int *__M, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__A, const int *__lda),
+	(__M, __N, __alpha, __X, __incX, __Y, __incY, __A, __lda))
+
+void F(symv_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY)
+{
+	static const char routine[] = ROUTINE(SYMV);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__lda >= MAX1(*__N), 5, "LDA", *__lda);
+	CHECK(*__incX != 0, 7, "INCX", *__incX);
+	CHECK(*__incY != 0, 10, "INCY", *__incY);
+
+	PFX(symv_impl)(blas_dense, lsame_(__Uplo, "U"), *__N, 0, *__alpha, __A, *__lda, __X, *__incX, *__beta, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(symv_), F(symv), FU(SYMV), FU(SYMV_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY),
+	(__Uplo, __N, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY))
+
+void F(sbmv_)(const char *__Uplo, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY)
+{
+	static const char routine[] = ROUTINE(SBMV);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__K >= 0, 3, "K", *__K);
+	CHECK(*__lda >= *__K + 1, 6, "LDA", *__lda);
+	CHECK(*__incX != 0, 8, "INCX", *__incX);
+	CHECK(*__incY != 0, 11, "INCY", *__incY);
+
+	PFX(symv_impl)(blas_band, lsame_(__Uplo, "U"), *__N, *__K, *__alpha, __A, *__lda, __X, *__incX, *__beta, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(sbmv_), F(sbmv), FU(SBMV), FU(SBMV_),
+	(const char *__Uplo, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY),
+	(__Uplo, __N, __K, __alpha, __A, __lda, __X, __incX, __beta, __Y, __incY))
+
+void F(spmv_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__Ap, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY)
+{
+	static const char routine[] = ROUTINE(SPMV);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 6, "INCX", *__incX);
+	CHECK(*__incY != 0, 9, "INCY", *__incY);
+
+	PFX(symv_impl)(blas_packed, lsame_(__Uplo, "U"), *__N, 0, *__alpha, __Ap, 0, __X, *__incX, *__beta, __Y, *__incY);
+}
+FORTRAN_ALIASES(F(spmv_), F(spmv), FU(SPMV), FU(SPMV_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__Ap, const REAL *__X, const int *__incX, const REAL *__beta, REAL *__Y, const int *__incY),
+	(__Uplo, __N, __alpha, __Ap, __X, __incX, __beta, __Y, __incY))
+
+void F(syr_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__A, const int *__lda)
+{
+	static const char routine[] = ROUTINE(SYR);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 5, "INCX", *__incX);
+	CHECK(*__lda >= MAX1(*__N), 7, "LDA", *__lda);
+
+	PFX(syr_impl)(blas_dense, lsame_(__Uplo, "U"), *__N, *__alpha, __X, *__incX, __A, *__lda);
+}
+FORTRAN_ALIASES(F(syr_), F(syr), FU(SYR), FU(SYR_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__A, const int *__lda),
+	(__Uplo, __N, __alpha, __X, __incX, __A, __lda))
+
+void F(spr_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__Ap)
+{
+	static const char routine[] = ROUTINE(SPR);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 5, "INCX", *__incX);
+
+	PFX(syr_impl)(blas_packed, lsame_(__Uplo, "U"), *__N, *__alpha, __X, *__incX, __Ap, 0);
+}
+FORTRAN_ALIASES(F(spr_), F(spr), FU(SPR), FU(SPR_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, REAL *__Ap),
+	(__Uplo, __N, __alpha, __X, __incX, __Ap))
+
+void F(syr2_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__A, const int *__lda)
+{
+	static const char routine[] = ROUTINE(SYR2);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 5, "INCX", *__incX);
+	CHECK(*__incY != 0, 7, "INCY", *__incY);
+	CHECK(*__lda >= MAX1(*__N), 9, "LDA", *__lda);
+
+	PFX(syr2_impl)(blas_dense, lsame_(__Uplo, "U"), *__N, *__alpha, __X, *__incX, __Y, *__incY, __A, *__lda);
+}
+FORTRAN_ALIASES(F(syr2_), F(syr2), FU(SYR2), FU(SYR2_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__A, const int *__lda),
+	(__Uplo, __N, __alpha, __X, __incX, __Y, __incY, __A, __lda))
+
+void F(spr2_)(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__Ap)
+{
+	static const char routine[] = ROUTINE(SPR2);
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(*__N >= 0, 2, "N", *__N);
+	CHECK(*__incX != 0, 5, "INCX", *__incX);
+	CHECK(*__incY != 0, 7, "INCY", *__incY);
+
+	PFX(syr2_impl)(blas_packed, lsame_(__Uplo, "U"), *__N, *__alpha, __X, *__incX, __Y, *__incY, __Ap, 0);
+}
+FORTRAN_ALIASES(F(spr2_), F(spr2), FU(SPR2), FU(SPR2_),
+	(const char *__Uplo, const int *__N, const REAL *__alpha, const REAL *__X, const int *__incX, const REAL *__Y, const int *__incY, REAL *__Ap),
+	(__Uplo, __N, __alpha, __X, __incX, __Y, __incY, __Ap))
+
+// The triangular solves and products share their checks, `k_pos` is 0 for routines without K
+// and `lda_pos` for those without lda
+#define CHECK_TRIANGULAR(k_pos, lda_pos, lda_min, incx_pos) \
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo); \
+	CHECK(valid_trans(__TransA), 2, "TRANS", *__TransA); \
+	CHECK(valid_diag(__Diag), 3, "DIAG", *__Diag); \
+	CHECK(*__N >= 0, 4, "N", *__N); \
+	CHECK(k_pos == 0 || k >= 0, k_pos, "K", k); \
+	CHECK(lda_pos == 0 || lda >= (lda_min), lda_pos, "LDA", lda); \
+	CHECK(*__incX != 0, incx_pos, "INCX", *__incX)
+
+#define TRIANGULAR(fn, storage) \
+	fn(storage, lsame_(__Uplo, "U"), !lsame_(__TransA, "N"), lsame_(__Diag, "U"), *__N, k, a, lda, __X, *__incX)
+
+void F(trmv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__A, const int *__lda, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TRMV);
+	const REAL* a = __A;
+	const int k = 0, lda = *__lda;
+
+	CHECK_TRIANGULAR(0, 6, MAX1(*__N), 8);
+	TRIANGULAR(PFX(trmv_impl), blas_dense);
+}
+FORTRAN_ALIASES(F(trmv_), F(trmv), FU(TRMV), FU(TRMV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__A, const int *__lda, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __A, __lda, __X, __incX))
+
+void F(tbmv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const REAL *__A, const int *__lda, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TBMV);
+	const REAL* a = __A;
+	const int k = *__K, lda = *__lda;
+
+	CHECK_TRIANGULAR(5, 7, k + 1, 9);
+	TRIANGULAR(PFX(trmv_impl), blas_band);
+}
+FORTRAN_ALIASES(F(tbmv_), F(tbmv), FU(TBMV), FU(TBMV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const REAL *__A, const int *__lda, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __K, __A, __lda, __X, __incX))
+
+void F(tpmv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__Ap, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TPMV);
+	const REAL* a = __Ap;
+	const int k = 0, lda = 0;
+
+	CHECK_TRIANGULAR(0, 0, 0, 7);
+	TRIANGULAR(PFX(trmv_impl), blas_packed);
+}
+FORTRAN_ALIASES(F(tpmv_), F(tpmv), FU(TPMV), FU(TPMV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__Ap, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __Ap, __X, __incX))
+
+void F(trsv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__A, const int *__lda, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TRSV);
+	const REAL* a = __A;
+	const int k = 0, lda = *__lda;
+
+	CHECK_TRIANGULAR(0, 6, MAX1(*__N), 8);
+	TRIANGULAR(PFX(trsv_impl), blas_dense);
+}
+FORTRAN_ALIASES(F(trsv_), F(trsv), FU(TRSV), FU(TRSV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__A, const int *__lda, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __A, __lda, __X, __incX))
+
+void F(tbsv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const REAL *__A, const int *__lda, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TBSV);
+	const REAL* a = __A;
+	const int k = *__K, lda = *__lda;
+
+	CHECK_TRIANGULAR(5, 7, k + 1, 9);
+	TRIANGULAR(PFX(trsv_impl), blas_band);
+}
+FORTRAN_ALIASES(F(tbsv_), F(tbsv), FU(TBSV), FU(TBSV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const int *__K, const REAL *__A, const int *__lda, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __K, __A, __lda, __X, __incX))
+
+void F(tpsv_)(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__Ap, REAL *__X, const int *__incX)
+{
+	static const char routine[] = ROUTINE(TPSV);
+	const REAL* a = __Ap;
+	const int k = 0, lda = 0;
+
+	CHECK_TRIANGULAR(0, 0, 0, 7);
+	TRIANGULAR(PFX(trsv_impl), blas_packed);
+}
+FORTRAN_ALIASES(F(tpsv_), F(tpsv), FU(TPSV), FU(TPSV_),
+	(const char *__Uplo, const char *__TransA, const char *__Diag, const int *__N, const REAL *__Ap, REAL *__X, const int *__incX),
+	(__Uplo, __TransA, __Diag, __N, __Ap, __X, __incX))
+
+#undef CHECK_TRIANGULAR
+#undef TRIANGULAR
+
+// Level 3
+
+void F(gemm_)(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc)
+{
+	static const char routine[] = ROUTINE(GEMM);
+	const bool transa = !lsame_(__TransA, "N");
+	const bool transb = !lsame_(__TransB, "N");
+
+	CHECK(valid_trans(__TransA), 1, "TRANSA", *__TransA);
+	CHECK(valid_trans(__TransB), 2, "TRANSB", *__TransB);
+	CHECK(*__M >= 0, 3, "M", *__M);
+	CHECK(*__N >= 0, 4, "N", *__N);
+	CHECK(*__K >= 0, 5, "K", *__K);
+	CHECK(*__lda >= MAX1(transa ? *__K : *__M), 8, "LDA", *__lda);
+	CHECK(*__ldb >= MAX1(transb ? *__N : *__K), 10, "LDB", *__ldb);
+	CHECK(*__ldc >= MAX1(*__M), 13, "LDC", *__ldc);
+
+	PFX(gemm_impl)(transa, transb, *__M, *__N, *__K, *__alpha, __A, *__lda, __B, *__ldb, *__beta, __C, *__ldc);
+}
+FORTRAN_ALIASES(F(gemm_), F(gemm), FU(GEMM), FU(GEMM_),
+	(const char *__TransA, const char *__TransB, const int *__M, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc),
+	(__TransA, __TransB, __M, __N, __K, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc))
+
+void F(symm_)(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc)
+{
+	static const char routine[] = ROUTINE(SYMM);
+	const bool left = lsame_(__Side, "L");
+
+	CHECK(valid_side(__Side), 1, "SIDE", *__Side);
+	CHECK(valid_uplo(__Uplo), 2, "UPLO", *__Uplo);
+	CHECK(*__M >= 0, 3, "M", *__M);
+	CHECK(*__N >= 0, 4, "N", *__N);
+	CHECK(*__lda >= MAX1(left ? *__M : *__N), 7, "LDA", *__lda);
+	CHECK(*__ldb >= MAX1(*__M), 9, "LDB", *__ldb);
+	CHECK(*__ldc >= MAX1(*__M), 12, "LDC", *__ldc);
+
+	PFX(symm_impl)(left, lsame_(__Uplo, "U"), *__M, *__N, *__alpha, __A, *__lda, __B, *__ldb, *__beta, __C, *__ldc);
+}
+FORTRAN_ALIASES(F(symm_), F(symm), FU(SYMM), FU(SYMM_),
+	(const char *__Side, const char *__Uplo, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc),
+	(__Side, __Uplo, __M, __N, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc))
+
+void F(syrk_)(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__beta, REAL *__C, const int *__ldc)
+{
+	static const char routine[] = ROUTINE(SYRK);
+	const bool trans = !lsame_(__Trans, "N");
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(valid_trans(__Trans), 2, "TRANS", *__Trans);
+	CHECK(*__N >= 0, 3, "N", *__N);
+	CHECK(*__K >= 0, 4, "K", *__K);
+	CHECK(*__lda >= MAX1(trans ? *__K : *__N), 7, "LDA", *__lda);
+	CHECK(*__ldc >= MAX1(*__N), 10, "LDC", *__ldc);
+
+	PFX(syrk_impl)(lsame_(__Uplo, "U"), trans, *__N, *__K, *__alpha, __A, *__lda, *__beta, __C, *__ldc);
+}
+FORTRAN_ALIASES(F(syrk_), F(syrk), FU(SYRK), FU(SYRK_),
+	(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__beta, REAL *__C, const int *__ldc),
+	(__Uplo, __Trans, __N, __K, __alpha, __A, __lda, __beta, __C, __ldc))
+
+void F(syr2k_)(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc)
+{
+	static const char routine[] = ROUTINE(SYR2K);
+	const bool trans = !lsame_(__Trans, "N");
+
+	CHECK(valid_uplo(__Uplo), 1, "UPLO", *__Uplo);
+	CHECK(valid_trans(__Trans), 2, "TRANS", *__Trans);
+	CHECK(*__N >= 0, 3, "N", *__N);
+	CHECK(*__K >= 0, 4, "K", *__K);
+	CHECK(*__lda >= MAX1(trans ? *__K : *__N), 7, "LDA", *__lda);
+	CHECK(*__ldb >= MAX1(trans ? *__K : *__N), 9, "LDB", *__ldb);
+	CHECK(*__ldc >= MAX1(*__N), 12, "LDC", *__ldc);
+
+	PFX(syr2k_impl)(lsame_(__Uplo, "U"), trans, *__N, *__K, *__alpha, __A, *__lda, __B, *__ldb, *__beta, __C, *__ldc);
+}
+FORTRAN_ALIASES(F(syr2k_), F(syr2k), FU(SYR2K), FU(SYR2K_),
+	(const char *__Uplo, const char *__Trans, const int *__N, const int *__K, const REAL *__alpha, const REAL *__A, const int *__lda, const REAL *__B, const int *__ldb, const REAL *__beta, REAL *__C, const int *__ldc),
+	(__Uplo, __Trans, __N, __K, __alpha, __A, __lda, __B, __ldb, __beta, __C, __ldc))
+
+#define TRIANGULAR_MATRIX(fn) \
+	const bool left = lsame_(__Side, "L"); \
+	CHECK(valid_side(__Side), 1, "SIDE", *__Side); \
+	CHECK(valid_uplo(__Uplo), 2, "UPLO", *__Uplo); \
+	CHECK(valid_trans(__TransA), 3, "TRANSA", *__TransA); \
+	CHECK(valid_diag(__Diag), 4, "DIAG", *__Diag); \
+	CHECK(*__M >= 0, 5, "M", *__M); \
+	CHECK(*__N >= 0, 6, "N", *__N); \
+	CHECK(*__lda >= MAX1(left ? *__M : *__N), 9, "LDA", *__lda); \
+	CHECK(*__ldb >= MAX1(*__M), 11, "LDB", *__ldb); \
+	fn(left, lsame_(__Uplo, "U"), !lsame_(__TransA, "N"), lsame_(__Diag, "U"), *__M, *__N, *__alpha, __A, *__lda, __B, *__ldb)
+
+void F(trmm_)(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, REAL *__B, const int *__ldb)
+{
+	static const char routine[] = ROUTINE(TRMM);
+	TRIANGULAR_MATRIX(PFX(trmm_impl));
+}
+FORTRAN_ALIASES(F(trmm_), F(trmm), FU(TRMM), FU(TRMM_),
+	(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, REAL *__B, const int *__ldb),
+	(__Side, __Uplo, __TransA, __Diag, __M, __N, __alpha, __A, __lda, __B, __ldb))
+
+void F(trsm_)(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, REAL *__B, const int *__ldb)
+{
+	static const char routine[] = ROUTINE(TRSM);
+	TRIANGULAR_MATRIX(PFX(trsm_impl));
+}
+FORTRAN_ALIASES(F(trsm_), F(trsm), FU(TRSM), FU(TRSM_),
+	(const char *__Side, const char *__Uplo, const char *__TransA, const char *__Diag, const int *__M, const int *__N, const REAL *__alpha, const REAL *__A, const int *__lda, REAL *__B, const int *__ldb),
+	(__Side, __Uplo, __TransA, __Diag, __M, __N, __alpha, __A, __lda, __B, __ldb))
+
+#undef TRIANGULAR_MATRIX
@@ -0,0 +1,181 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define GEMM_HAVE_AVX2 1
+#endif
+
+// The largest MR of all micro-kernels
+#define BLAS_MR_MAX 16
+
+static bool gemm_have_avx2 = false;
+static bool gemm_have_fma = false;
+
+__attribute__((constructor))
+static void gemm_detect_cpu(void)
+{
+#ifdef GEMM_HAVE_AVX2
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return;
+
+	// the OS has to save the YMM registers too
+	if (!(ecx & bit_OSXSAVE))
+		return;
+
+	unsigned int xcr0_lo, xcr0_hi;
+	__asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+	if ((xcr0_lo & 6) != 6)
+		return;
+
+	const bool fma = (ecx & bit_FMA) != 0;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return;
+
+	gemm_have_avx2 = (ebx & bit_AVX2) != 0;
+	gemm_have_fma = gemm_have_avx2 && fma;
+#endif
+}
+
+// Micro-kernel instances: 128-bit vectors (SSE2, the baseline on x86-64), 256-bit vectors
+// (AVX2) and 256-bit vectors with the multiply-adds contracted into FMA instructions
+
+#define REAL float
+
+#define VW 4
+#define KFN(name) gemm_v128_f_##name
+#define KATTR
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#ifdef GEMM_HAVE_AVX2
+#define VW 8
+#define KFN(name) gemm_avx2_f_##name
+#define KATTR __attribute__((target("avx2")))
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#define VW 8
+#define KFN(name) gemm_fma_f_##name
+#define KATTR __attribute__((target("avx2,fma")))
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#endif
+
+#undef REAL
+#define REAL double
+
+#define VW 2
+#define KFN(name) gemm_v128_d_##name
+#define KATTR
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#ifdef GEMM_HAVE_AVX2
+#define VW 4
+#define KFN(name) gemm_avx2_d_##name
+#define KATTR __attribute__((target("avx2")))
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#define VW 4
+#define KFN(name) gemm_fma_d_##name
+#define KATTR __attribute__((target("avx2,fma")))
+#include "gemm_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#endif
+
+#undef REAL
+
+struct sgemm_kernel
+{
+	int mr;
+	void (*fn)(int k, float alpha, const float* a, const float* b, float beta, float* c, int ldc);
+};
+
+struct dgemm_kernel
+{
+	int mr;
+	void (*fn)(int k, double alpha, const double* a, const double* b, double beta, double* c, int ldc);
+};
+
+static const struct sgemm_kernel* sgemm_select_kernel(void)
+{
+	static const struct sgemm_kernel v128 = { 8, gemm_v128_f_kernel };
+#ifdef GEMM_HAVE_AVX2
+	static const struct sgemm_kernel avx2 = { 16, gemm_avx2_f_kernel };
+	static const struct sgemm_kernel fma = { 16, gemm_fma_f_kernel };
+
+	if (gemm_have_fma)
+		return &fma;
+	if (gemm_have_avx2)
+		return &avx2;
+#endif
+	return &v128;
+}
+
+static const struct dgemm_kernel* dgemm_select_kernel(void)
+{
+	static const struct dgemm_kernel v128 = { 4, gemm_v128_d_kernel };
+#ifdef GEMM_HAVE_AVX2
+	static const struct dgemm_kernel avx2 = { 8, gemm_avx2_d_kernel };
+	static const struct dgemm_kernel fma = { 8, gemm_fma_d_kernel };
+
+	if (gemm_have_fma)
+		return &fma;
+	if (gemm_have_avx2)
+		return &avx2;
+#endif
+	return &v128;
+}
+
+// MC keeps a packed block of A at about 128 KiB, a typical L2 size
+#define REAL float
+#define PFX(name) s##name
+#define MC 128
+#include "gemm_template.h"
+#undef REAL
+#undef PFX
+#undef MC
+
+#define REAL double
+#define PFX(name) d##name
+#define MC 64
+#include "gemm_template.h"
+#undef REAL
+#undef PFX
+#undef MC
@@ -0,0 +1,89 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// GEMM micro-kernel, included by gemm.c once per element type and instruction set.
+//
+// The includer defines REAL, VW (the number of elements per vector), KFN(name) to name the
+// instance and KATTR for its function attributes. The kernel computes a (2 * VW) x BLAS_NR
+// tile of C from a panel of A packed as k columns of 2 * VW elements and a panel of B packed
+// as k rows of BLAS_NR elements, keeping the whole tile in 12 vector registers.
+
+typedef REAL KFN(vec) __attribute__((vector_size(VW * sizeof(REAL))));
+
+#define KFN_LOADU(p) ({ KFN(vec) __v; memcpy(&__v, (p), sizeof(__v)); __v; })
+#define KFN_STOREU(p, v) ({ KFN(vec) __v = (v); memcpy((p), &__v, sizeof(__v)); })
+
+#define KFN_STEP(j) \
+	{ \
+		const KFN(vec) bj = (KFN(vec)) {0} + b[j]; \
+		c##j##0 += a0 * bj; \
+		c##j##1 += a1 * bj; \
+	}
+
+#define KFN_STORE(j) \
+	{ \
+		REAL* cj = c + (size_t) j * ldc; \
+		if (beta == 0) \
+		{ \
+			KFN_STOREU(cj, alpha * c##j##0); \
+			KFN_STOREU(cj + VW, alpha * c##j##1); \
+		} \
+		else \
+		{ \
+			KFN_STOREU(cj, alpha * c##j##0 + beta * KFN_LOADU(cj)); \
+			KFN_STOREU(cj + VW, alpha * c##j##1 + beta * KFN_LOADU(cj + VW)); \
+		} \
+	}
+
+// C := alpha * A * B + beta * C, C isn't read if beta is 0
+KATTR static void KFN(kernel)(int k, REAL alpha, const REAL* restrict a, const REAL* restrict b,
+	REAL beta, REAL* restrict c, int ldc)
+{
+	KFN(vec) c00 = {0}, c01 = {0}, c10 = {0}, c11 = {0}, c20 = {0}, c21 = {0};
+	KFN(vec) c30 = {0}, c31 = {0}, c40 = {0}, c41 = {0}, c50 = {0}, c51 = {0};
+
+	for (int p = 0; p < k; p++)
+	{
+		// packed panels are aligned to the vector size
+		const KFN(vec) a0 = *(const KFN(vec)*) a;
+		const KFN(vec) a1 = *(const KFN(vec)*) (a + VW);
+
+		KFN_STEP(0)
+		KFN_STEP(1)
+		KFN_STEP(2)
+		KFN_STEP(3)
+		KFN_STEP(4)
+		KFN_STEP(5)
+
+		a += 2 * VW;
+		b += BLAS_NR;
+	}
+
+	KFN_STORE(0)
+	KFN_STORE(1)
+	KFN_STORE(2)
+	KFN_STORE(3)
+	KFN_STORE(4)
+	KFN_STORE(5)
+}
+
+#undef KFN_LOADU
+#undef KFN_STOREU
+#undef KFN_STEP
+#undef KFN_STORE
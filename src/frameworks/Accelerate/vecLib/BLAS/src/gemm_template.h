@@ -0,0 +1,367 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The blocked matrix product, included by gemm.c with REAL, PFX(name) and MC defined.
+//
+// The usual GotoBLAS/BLIS structure: C is computed in column blocks of BLAS_NC, the inner
+// dimension is split into blocks of BLAS_KC and A into row blocks of MC. For each of those,
+// a KC x NC block of B is packed into panels of BLAS_NR columns (sized for L3) and an MC x KC
+// block of A into panels of mr rows (sized for L2), and the micro-kernel walks the panels.
+//
+// Threads get 2D blocks of C and work on them independently, with their own packed copies.
+
+static inline REAL PFX(operand_at)(const struct PFX(operand)* op, int i, int j)
+{
+	switch (op->mode)
+	{
+		case blas_operand_normal:
+			return op->p[i + (size_t) j * op->ld];
+		case blas_operand_trans:
+			return op->p[j + (size_t) i * op->ld];
+		case blas_operand_sym_upper:
+			return (i <= j) ? op->p[i + (size_t) j * op->ld] : op->p[j + (size_t) i * op->ld];
+		default:
+			return (i >= j) ? op->p[i + (size_t) j * op->ld] : op->p[j + (size_t) i * op->ld];
+	}
+}
+
+// Packs rows [i0, i0 + mc) and columns [p0, p0 + kc) of A into panels of mr rows, zero padded
+static void PFX(pack_a)(const struct PFX(operand)* op, int i0, int p0, int mc, int kc, int mr, REAL* dst)
+{
+	for (int ir = 0; ir < mc; ir += mr)
+	{
+		const int rows = (mc - ir < mr) ? mc - ir : mr;
+		const int i = i0 + ir;
+
+		if (op->mode == blas_operand_normal)
+		{
+			for (int p = 0; p < kc; p++)
+			{
+				const REAL* src = op->p + i + (size_t) (p0 + p) * op->ld;
+				int r = 0;
+
+				for (; r < rows; r++)
+					dst[r] = src[r];
+				for (; r < mr; r++)
+					dst[r] = 0;
+				dst += mr;
+			}
+		}
+		else if (op->mode == blas_operand_trans)
+		{
+			for (int r = 0; r < mr; r++)
+			{
+				if (r < rows)
+				{
+					const REAL* src = op->p + p0 + (size_t) (i + r) * op->ld;
+					for (int p = 0; p < kc; p++)
+						dst[p * mr + r] = src[p];
+				}
+				else
+				{
+					for (int p = 0; p < kc; p++)
+						dst[p * mr + r] = 0;
+				}
+			}
+			dst += (size_t) mr * kc;
+		}
+		else
+		{
+			for (int p = 0; p < kc; p++)
+			{
+				int r = 0;
+
+				for (; r < rows; r++)
+					dst[r] = PFX(operand_at)(op, i + r, p0 + p);
+				for (; r < mr; r++)
+					dst[r] = 0;
+				dst += mr;
+			}
+		}
+	}
+}
+
+// Packs rows [p0, p0 + kc) and columns [j0, j0 + nc) of B into panels of BLAS_NR columns
+static void PFX(pack_b)(const struct PFX(operand)* op, int p0, int j0, int kc, int nc, REAL* dst)
+{
+	for (int jr = 0; jr < nc; jr += BLAS_NR)
+	{
+		const int cols = (nc - jr < BLAS_NR) ? nc - jr : BLAS_NR;
+		const int j = j0 + jr;
+
+		if (op->mode == blas_operand_normal)
+		{
+			for (int c = 0; c < BLAS_NR; c++)
+			{
+				if (c < cols)
+				{
+					const REAL* src = op->p + p0 + (size_t) (j + c) * op->ld;
+					for (int p = 0; p < kc; p++)
+						dst[p * BLAS_NR + c] = src[p];
+				}
+				else
+				{
+					for (int p = 0; p < kc; p++)
+						dst[p * BLAS_NR + c] = 0;
+				}
+			}
+			dst += (size_t) BLAS_NR * kc;
+		}
+		else
+		{
+			for (int p = 0; p < kc; p++)
+			{
+				int c = 0;
+
+				if (op->mode == blas_operand_trans)
+				{
+					const REAL* src = op->p + j + (size_t) (p0 + p) * op->ld;
+					for (; c < cols; c++)
+						dst[c] = src[c];
+				}
+				else
+				{
+					for (; c < cols; c++)
+						dst[c] = PFX(operand_at)(op, p0 + p, j + c);
+				}
+				for (; c < BLAS_NR; c++)
+					dst[c] = 0;
+				dst += BLAS_NR;
+			}
+		}
+	}
+}
+
+static void PFX(scale_matrix)(int m, int n, REAL beta, REAL* c, int ldc)
+{
+	if (beta == 1)
+		return;
+
+	for (int j = 0; j < n; j++)
+	{
+		REAL* col = c + (size_t) j * ldc;
+
+		if (beta == 0)
+		{
+			memset(col, 0, (size_t) m * sizeof(REAL));
+		}
+		else
+		{
+			#pragma clang loop vectorize(enable)
+			for (int i = 0; i < m; i++)
+				col[i] *= beta;
+		}
+	}
+}
+
+// Rows [m0, m1) and columns [n0, n1) of the product without packing, for small products
+static void PFX(gemm_small)(int m0, int m1, int n0, int n1, int k, REAL alpha, const struct PFX(operand)* a,
+	const struct PFX(operand)* b, REAL beta, REAL* c, int ldc)
+{
+	for (int j = n0; j < n1; j++)
+	{
+		for (int i = m0; i < m1; i++)
+		{
+			REAL sum = 0;
+
+			for (int p = 0; p < k; p++)
+				sum += PFX(operand_at)(a, i, p) * PFX(operand_at)(b, p, j);
+
+			REAL* cij = c + i + (size_t) j * ldc;
+			*cij = (beta == 0) ? alpha * sum : alpha * sum + beta * *cij;
+		}
+	}
+}
+
+struct PFX(gemm_job)
+{
+	int m, n, k;
+	REAL alpha, beta;
+	const struct PFX(operand)* a;
+	const struct PFX(operand)* b;
+	REAL* c;
+	int ldc;
+
+	const struct PFX(gemm_kernel)* kernel;
+	// the grid of blocks of C handed out to threads
+	int tm, tn;
+};
+
+// Rows [m0, m1) and columns [n0, n1) of C
+static void PFX(gemm_block)(const struct PFX(gemm_job)* job, int m0, int m1, int n0, int n1)
+{
+	const int mr = job->kernel->mr;
+	const int kc_max = (job->k < BLAS_KC) ? job->k : BLAS_KC;
+	const int nc_max = (n1 - n0 < BLAS_NC) ? n1 - n0 : BLAS_NC;
+	const int mc_max = (m1 - m0 < MC) ? m1 - m0 : MC;
+
+	REAL* packed_a = (REAL*) blas_scratch(0, (size_t) (mc_max + mr) * kc_max * sizeof(REAL));
+	REAL* packed_b = (REAL*) blas_scratch(1, (size_t) (nc_max + BLAS_NR) * kc_max * sizeof(REAL));
+
+	if (!packed_a || !packed_b)
+	{
+		// out of memory, slow but correct
+		PFX(gemm_small)(m0, m1, n0, n1, job->k, job->alpha, job->a, job->b, job->beta, job->c, job->ldc);
+		return;
+	}
+
+	REAL tile[BLAS_MR_MAX * BLAS_NR] __attribute__((aligned(64)));
+
+	for (int jc = n0; jc < n1; jc += BLAS_NC)
+	{
+		const int nc = (n1 - jc < BLAS_NC) ? n1 - jc : BLAS_NC;
+
+		for (int pc = 0; pc < job->k; pc += BLAS_KC)
+		{
+			const int kc = (job->k - pc < BLAS_KC) ? job->k - pc : BLAS_KC;
+			// the first block of the inner dimension applies beta, the others accumulate
+			const REAL beta = (pc == 0) ? job->beta : 1;
+
+			PFX(pack_b)(job->b, pc, jc, kc, nc, packed_b);
+
+			for (int ic = m0; ic < m1; ic += MC)
+			{
+				const int mc = (m1 - ic < MC) ? m1 - ic : MC;
+
+				PFX(pack_a)(job->a, ic, pc, mc, kc, mr, packed_a);
+
+				for (int jr = 0; jr < nc; jr += BLAS_NR)
+				{
+					const int cols = (nc - jr < BLAS_NR) ? nc - jr : BLAS_NR;
+					const REAL* pb = packed_b + (size_t) jr * kc;
+
+					for (int ir = 0; ir < mc; ir += mr)
+					{
+						const int rows = (mc - ir < mr) ? mc - ir : mr;
+						const REAL* pa = packed_a + (size_t) ir * kc;
+						REAL* c = job->c + (ic + ir) + (size_t) (jc + jr) * job->ldc;
+
+						if (rows == mr && cols == BLAS_NR)
+						{
+							job->kernel->fn(kc, job->alpha, pa, pb, beta, c, job->ldc);
+							continue;
+						}
+
+						// edge tiles go through a buffer
+						job->kernel->fn(kc, job->alpha, pa, pb, 0, tile, mr);
+						for (int j = 0; j < cols; j++)
+						{
+							for (int i = 0; i < rows; i++)
+							{
+								REAL* cij = c + i + (size_t) j * job->ldc;
+								*cij = (beta == 0) ? tile[i + j * mr] : tile[i + j * mr] + beta * *cij;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+// Splits [0, total) into `parts` ranges whose boundaries are multiples of `unit`
+static void PFX(split_range)(int total, int parts, int index, int unit, int* start, int* end)
+{
+	const int units = (total + unit - 1) / unit;
+
+	*start = (int) ((long long) units * index / parts) * unit;
+	*end = (int) ((long long) units * (index + 1) / parts) * unit;
+	if (*end > total)
+		*end = total;
+}
+
+static void PFX(gemm_task)(void* ctx, int task)
+{
+	const struct PFX(gemm_job)* job = (const struct PFX(gemm_job)*) ctx;
+	int m0, m1, n0, n1;
+
+	PFX(split_range)(job->m, job->tm, task % job->tm, job->kernel->mr, &m0, &m1);
+	PFX(split_range)(job->n, job->tn, task / job->tm, BLAS_NR, &n0, &n1);
+
+	if (m0 < m1 && n0 < n1)
+		PFX(gemm_block)(job, m0, m1, n0, n1);
+}
+
+void PFX(gemm_operands)(int m, int n, int k, REAL alpha, const struct PFX(operand)* a, const struct PFX(operand)* b,
+	REAL beta, REAL* c, int ldc)
+{
+	if (m == 0 || n == 0)
+		return;
+
+	if (alpha == 0 || k == 0)
+	{
+		PFX(scale_matrix)(m, n, beta, c, ldc);
+		return;
+	}
+
+	const double work = (double) m * n * k;
+	if (work < 4096)
+	{
+		PFX(gemm_small)(0, m, 0, n, k, alpha, a, b, beta, c, ldc);
+		return;
+	}
+
+	struct PFX(gemm_job) job = {
+		.m = m, .n = n, .k = k,
+		.alpha = alpha, .beta = beta,
+		.a = a, .b = b,
+		.c = c, .ldc = ldc,
+		.kernel = PFX(gemm_select_kernel)(),
+	};
+
+	// Give each thread at least 64^3 multiply-adds, then pick the grid that packs the least:
+	// every column of blocks packs all of A's rows and every row of blocks all of B's columns.
+	int threads = APPLE_NTHREADS();
+	if (threads > work / (64.0 * 64 * 64))
+		threads = (int) (work / (64.0 * 64 * 64));
+	if (threads < 1)
+		threads = 1;
+
+	const int max_tm = (m + job.kernel->mr - 1) / job.kernel->mr;
+	const int max_tn = (n + BLAS_NR - 1) / BLAS_NR;
+	double best = -1;
+
+	job.tm = job.tn = 1;
+	for (int tn = 1; tn <= threads; tn++)
+	{
+		const int tm = threads / tn;
+
+		if (tm * tn != threads || tm > max_tm || tn > max_tn)
+			continue;
+
+		const double cost = (double) m * tn + (double) n * tm;
+		if (best < 0 || cost < best)
+		{
+			best = cost;
+			job.tm = tm;
+			job.tn = tn;
+		}
+	}
+
+	blas_parallel_for(job.tm * job.tn, PFX(gemm_task), &job);
+}
+
+void PFX(gemm_impl)(bool transa, bool transb, int m, int n, int k, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc)
+{
+	const struct PFX(operand) opa = { a, lda, transa ? blas_operand_trans : blas_operand_normal };
+	const struct PFX(operand) opb = { b, ldb, transb ? blas_operand_trans : blas_operand_normal };
+
+	PFX(gemm_operands)(m, n, k, alpha, &opa, &opb, beta, c, ldc);
+}
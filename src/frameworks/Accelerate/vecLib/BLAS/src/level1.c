@@ -0,0 +1,111 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+#include <math.h>
+#include <string.h>
+
+#define REAL float
+#define CBLAS(name) cblas_s##name
+#define CBLAS_IAMAX cblas_isamax
+#define ABS(x) fabsf(x)
+#define SQRT(x) sqrtf(x)
+#include "level1_template.h"
+#undef REAL
+#undef CBLAS
+#undef CBLAS_IAMAX
+#undef ABS
+#undef SQRT
+
+#define REAL double
+#define CBLAS(name) cblas_d##name
+#define CBLAS_IAMAX cblas_idamax
+#define ABS(x) fabs(x)
+#define SQRT(x) sqrt(x)
+#include "level1_template.h"
+#undef REAL
+#undef CBLAS
+#undef CBLAS_IAMAX
+#undef ABS
+#undef SQRT
+
+// Squares of floats can't overflow a double
+float cblas_snrm2(const int __N, const float *__X, const int __incX)
+{
+	double sum = 0;
+
+	if (__N <= 0 || __incX <= 0)
+		return 0;
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < __N; i++)
+	{
+		const double x = __X[(size_t) i * __incX];
+		sum += x * x;
+	}
+	return sqrt(sum);
+}
+
+// Scales by the largest element first, so that squaring neither overflows nor underflows
+double cblas_dnrm2(const int __N, const double *__X, const int __incX)
+{
+	double max = 0, sum = 0;
+
+	if (__N <= 0 || __incX <= 0)
+		return 0;
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < __N; i++)
+		max = fmax(max, fabs(__X[(size_t) i * __incX]));
+
+	if (max == 0 || isinf(max))
+		return max;
+
+	const double scale = 1 / max;
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < __N; i++)
+	{
+		const double x = __X[(size_t) i * __incX] * scale;
+		sum += x * x;
+	}
+	return max * sqrt(sum);
+}
+
+// Accumulated in double precision
+double cblas_dsdot(const int __N, const float *__X, const int __incX, const float *__Y, const int __incY)
+{
+	double sum = 0;
+
+	if (__N <= 0)
+		return 0;
+
+	const float* x = __X + BLAS_START(__N, __incX);
+	const float* y = __Y + BLAS_START(__N, __incY);
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < __N; i++)
+		sum += (double) x[(ptrdiff_t) i * __incX] * y[(ptrdiff_t) i * __incY];
+	return sum;
+}
+
+float cblas_sdsdot(const int __N, const float __alpha, const float *__X, const int __incX, const float *__Y, const int __incY)
+{
+	return (float) (__alpha + cblas_dsdot(__N, __X, __incX, __Y, __incY));
+}
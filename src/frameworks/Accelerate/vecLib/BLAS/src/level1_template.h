@@ -0,0 +1,418 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Level 1 CBLAS routines, included by level1.c with REAL, CBLAS(name), CBLAS_IAMAX, ABS(x)
+// and SQRT(x) defined.
+// Unit strides get their own loops so that they vectorize.
+
+REAL CBLAS(asum)(const int __N, const REAL *__X, const int __incX)
+{
+	REAL sum = 0;
+
+	if (__N <= 0 || __incX <= 0)
+		return 0;
+
+	if (__incX == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+			sum += ABS(__X[i]);
+	}
+	else
+	{
+		for (int i = 0; i < __N; i++)
+			sum += ABS(__X[(size_t) i * __incX]);
+	}
+	return sum;
+}
+
+void CBLAS(axpy)(const int __N, const REAL __alpha, const REAL *__X, const int __incX, REAL *__Y, const int __incY)
+{
+	if (__N <= 0 || __alpha == 0)
+		return;
+
+	if (__incX == 1 && __incY == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+			__Y[i] += __alpha * __X[i];
+	}
+	else
+	{
+		const REAL* x = __X + BLAS_START(__N, __incX);
+		REAL* y = __Y + BLAS_START(__N, __incY);
+
+		for (int i = 0; i < __N; i++)
+			y[(ptrdiff_t) i * __incY] += __alpha * x[(ptrdiff_t) i * __incX];
+	}
+}
+
+void CBLAS(copy)(const int __N, const REAL *__X, const int __incX, REAL *__Y, const int __incY)
+{
+	if (__N <= 0)
+		return;
+
+	if (__incX == 1 && __incY == 1)
+	{
+		memmove(__Y, __X, (size_t) __N * sizeof(REAL));
+	}
+	else
+	{
+		const REAL* x = __X + BLAS_START(__N, __incX);
+		REAL* y = __Y + BLAS_START(__N, __incY);
+
+		for (int i = 0; i < __N; i++)
+			y[(ptrdiff_t) i * __incY] = x[(ptrdiff_t) i * __incX];
+	}
+}
+
+REAL CBLAS(dot)(const int __N, const REAL *__X, const int __incX, const REAL *__Y, const int __incY)
+{
+	REAL sum = 0;
+
+	if (__N <= 0)
+		return 0;
+
+	if (__incX == 1 && __incY == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+			sum += __X[i] * __Y[i];
+	}
+	else
+	{
+		const REAL* x = __X + BLAS_START(__N, __incX);
+		const REAL* y = __Y + BLAS_START(__N, __incY);
+
+		for (int i = 0; i < __N; i++)
+			sum += x[(ptrdiff_t) i * __incX] * y[(ptrdiff_t) i * __incY];
+	}
+	return sum;
+}
+
+void CBLAS(rot)(const int __N, REAL *__X, const int __incX, REAL *__Y, const int __incY, const REAL __c, const REAL __s)
+{
+	if (__N <= 0)
+		return;
+
+	if (__incX == 1 && __incY == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+		{
+			const REAL x = __X[i], y = __Y[i];
+			__X[i] = __c * x + __s * y;
+			__Y[i] = __c * y - __s * x;
+		}
+	}
+	else
+	{
+		REAL* px = __X + BLAS_START(__N, __incX);
+		REAL* py = __Y + BLAS_START(__N, __incY);
+
+		for (int i = 0; i < __N; i++)
+		{
+			const REAL x = px[(ptrdiff_t) i * __incX], y = py[(ptrdiff_t) i * __incY];
+			px[(ptrdiff_t) i * __incX] = __c * x + __s * y;
+			py[(ptrdiff_t) i * __incY] = __c * y - __s * x;
+		}
+	}
+}
+
+void CBLAS(rotg)(REAL *__a, REAL *__b, REAL *__c, REAL *__s)
+{
+	const REAL a = *__a, b = *__b;
+	const REAL roe = (ABS(a) > ABS(b)) ? a : b;
+	const REAL scale = ABS(a) + ABS(b);
+	REAL r, z;
+
+	if (scale == 0)
+	{
+		*__c = 1;
+		*__s = 0;
+		r = z = 0;
+	}
+	else
+	{
+		const REAL as = a / scale, bs = b / scale;
+
+		r = scale * SQRT(as * as + bs * bs);
+		if (roe < 0)
+			r = -r;
+
+		*__c = a / r;
+		*__s = b / r;
+
+		z = 1;
+		if (ABS(a) > ABS(b))
+			z = *__s;
+		else if (*__c != 0)
+			z = 1 / *__c;
+	}
+
+	*__a = r;
+	*__b = z;
+}
+
+void CBLAS(rotm)(const int __N, REAL *__X, const int __incX, REAL *__Y, const int __incY, const REAL *__P)
+{
+	const REAL flag = __P[0];
+	REAL h11, h21, h12, h22;
+
+	if (__N <= 0 || flag == -2)
+		return;
+
+	if (flag < 0)
+	{
+		h11 = __P[1]; h21 = __P[2]; h12 = __P[3]; h22 = __P[4];
+	}
+	else if (flag == 0)
+	{
+		h11 = 1; h21 = __P[2]; h12 = __P[3]; h22 = 1;
+	}
+	else
+	{
+		h11 = __P[1]; h21 = -1; h12 = 1; h22 = __P[4];
+	}
+
+	REAL* px = __X + BLAS_START(__N, __incX);
+	REAL* py = __Y + BLAS_START(__N, __incY);
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < __N; i++)
+	{
+		const REAL x = px[(ptrdiff_t) i * __incX], y = py[(ptrdiff_t) i * __incY];
+		px[(ptrdiff_t) i * __incX] = h11 * x + h12 * y;
+		py[(ptrdiff_t) i * __incY] = h21 * x + h22 * y;
+	}
+}
+
+// Follows the reference implementation, including its rescaling by powers of 4096
+void CBLAS(rotmg)(REAL *__d1, REAL *__d2, REAL *__b1, const REAL __b2, REAL *__P)
+{
+	const REAL gam = 4096, gamsq = gam * gam, rgamsq = 1 / gamsq;
+	REAL d1 = *__d1, d2 = *__d2, x1 = *__b1;
+	REAL flag, h11 = 0, h12 = 0, h21 = 0, h22 = 0;
+
+	if (d1 < 0)
+	{
+		flag = -1;
+		d1 = d2 = x1 = 0;
+	}
+	else
+	{
+		const REAL p2 = d2 * __b2;
+
+		if (p2 == 0)
+		{
+			__P[0] = -2;
+			return;
+		}
+
+		const REAL p1 = d1 * x1;
+		const REAL q2 = p2 * __b2;
+		const REAL q1 = p1 * x1;
+
+		if (ABS(q1) > ABS(q2))
+		{
+			h21 = -__b2 / x1;
+			h12 = p2 / p1;
+
+			const REAL u = 1 - h12 * h21;
+			if (u > 0)
+			{
+				flag = 0;
+				d1 /= u;
+				d2 /= u;
+				x1 *= u;
+			}
+			else
+			{
+				flag = -1;
+				h11 = h12 = h21 = h22 = 0;
+				d1 = d2 = x1 = 0;
+			}
+		}
+		else if (q2 < 0)
+		{
+			flag = -1;
+			d1 = d2 = x1 = 0;
+		}
+		else
+		{
+			flag = 1;
+			h11 = p1 / p2;
+			h22 = x1 / __b2;
+
+			const REAL u = 1 + h11 * h22;
+			const REAL temp = d2 / u;
+			d2 = d1 / u;
+			d1 = temp;
+			x1 = __b2 * u;
+		}
+
+		if (d1 != 0)
+		{
+			while (d1 <= rgamsq || d1 >= gamsq)
+			{
+				if (flag == 0)
+				{
+					h11 = h22 = 1;
+				}
+				else if (flag > 0)
+				{
+					h21 = -1;
+					h12 = 1;
+				}
+				flag = -1;
+
+				if (d1 <= rgamsq)
+				{
+					d1 *= gamsq;
+					x1 /= gam;
+					h11 /= gam;
+					h12 /= gam;
+				}
+				else
+				{
+					d1 /= gamsq;
+					x1 *= gam;
+					h11 *= gam;
+					h12 *= gam;
+				}
+			}
+		}
+
+		if (d2 != 0)
+		{
+			while (ABS(d2) <= rgamsq || ABS(d2) >= gamsq)
+			{
+				if (flag == 0)
+				{
+					h11 = h22 = 1;
+				}
+				else if (flag > 0)
+				{
+					h21 = -1;
+					h12 = 1;
+				}
+				flag = -1;
+
+				if (ABS(d2) <= rgamsq)
+				{
+					d2 *= gamsq;
+					h21 /= gam;
+					h22 /= gam;
+				}
+				else
+				{
+					d2 /= gamsq;
+					h21 *= gam;
+					h22 *= gam;
+				}
+			}
+		}
+	}
+
+	if (flag < 0)
+	{
+		__P[1] = h11; __P[2] = h21; __P[3] = h12; __P[4] = h22;
+	}
+	else if (flag == 0)
+	{
+		__P[2] = h21; __P[3] = h12;
+	}
+	else
+	{
+		__P[1] = h11; __P[4] = h22;
+	}
+	__P[0] = flag;
+
+	*__d1 = d1;
+	*__d2 = d2;
+	*__b1 = x1;
+}
+
+void CBLAS(scal)(const int __N, const REAL __alpha, REAL *__X, const int __incX)
+{
+	if (__N <= 0 || __incX <= 0)
+		return;
+
+	if (__incX == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+			__X[i] *= __alpha;
+	}
+	else
+	{
+		for (int i = 0; i < __N; i++)
+			__X[(size_t) i * __incX] *= __alpha;
+	}
+}
+
+void CBLAS(swap)(const int __N, REAL *__X, const int __incX, REAL *__Y, const int __incY)
+{
+	if (__N <= 0)
+		return;
+
+	if (__incX == 1 && __incY == 1)
+	{
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < __N; i++)
+		{
+			const REAL t = __X[i];
+			__X[i] = __Y[i];
+			__Y[i] = t;
+		}
+	}
+	else
+	{
+		REAL* x = __X + BLAS_START(__N, __incX);
+		REAL* y = __Y + BLAS_START(__N, __incY);
+
+		for (int i = 0; i < __N; i++)
+		{
+			const REAL t = x[(ptrdiff_t) i * __incX];
+			x[(ptrdiff_t) i * __incX] = y[(ptrdiff_t) i * __incY];
+			y[(ptrdiff_t) i * __incY] = t;
+		}
+	}
+}
+
+// 0-based, the first one wins on ties
+CBLAS_INDEX CBLAS_IAMAX(const int __N, const REAL *__X, const int __incX)
+{
+	if (__N <= 0 || __incX <= 0)
+		return 0;
+
+	int best = 0;
+	REAL max = ABS(__X[0]);
+
+	for (int i = 1; i < __N; i++)
+	{
+		const REAL v = ABS(__X[(size_t) i * __incX]);
+		if (v > max)
+		{
+			max = v;
+			best = i;
+		}
+	}
+	return best;
+}
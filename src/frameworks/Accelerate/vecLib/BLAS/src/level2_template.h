@@ -0,0 +1,411 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Level 2 implementations, included by level2.c with REAL and PFX(name) defined.
+//
+// Strided vectors are gathered into scratch memory so that the loops below only deal with
+// contiguous ones. The dense, band and packed variants of each routine share their code
+// through the column accessors: they return a pointer p and a row range [lo, hi) such that
+// A(i, j) is p[i] for i in that range.
+
+static const REAL* PFX(vector_in)(int n, const REAL* x, int incx, int slot)
+{
+	if (incx == 1)
+		return x;
+
+	REAL* buf = (REAL*) blas_scratch(slot, (size_t) n * sizeof(REAL));
+	if (!buf)
+		return NULL;
+
+	x += BLAS_START(n, incx);
+	for (int i = 0; i < n; i++)
+		buf[i] = x[(ptrdiff_t) i * incx];
+	return buf;
+}
+
+static void PFX(vector_out)(int n, const REAL* buf, REAL* x, int incx)
+{
+	if (buf == x)
+		return;
+
+	x += BLAS_START(n, incx);
+	for (int i = 0; i < n; i++)
+		x[(ptrdiff_t) i * incx] = buf[i];
+}
+
+static inline const REAL* PFX(general_column)(enum blas_storage storage, int m, int kl, int ku,
+	const REAL* a, int lda, int j, int* lo, int* hi)
+{
+	if (storage == blas_band)
+	{
+		*lo = (j > ku) ? j - ku : 0;
+		*hi = (j + kl + 1 < m) ? j + kl + 1 : m;
+		return a + (size_t) j * lda + ku - j;
+	}
+
+	*lo = 0;
+	*hi = m;
+	return a + (size_t) j * lda;
+}
+
+static inline REAL* PFX(tri_column)(enum blas_storage storage, bool upper, int n, int k,
+	const REAL* a, int lda, int j, int* lo, int* hi)
+{
+	REAL* p;
+
+	switch (storage)
+	{
+		case blas_band:
+			if (upper)
+				p = (REAL*) a + (size_t) j * lda + k - j;
+			else
+				p = (REAL*) a + (size_t) j * lda - j;
+			break;
+		case blas_packed:
+			if (upper)
+				p = (REAL*) a + (size_t) j * (j + 1) / 2;
+			else
+				p = (REAL*) a + (size_t) j * (2 * (size_t) n - j + 1) / 2 - j;
+			break;
+		default:
+			p = (REAL*) a + (size_t) j * lda;
+			break;
+	}
+
+	if (upper)
+	{
+		*lo = (storage == blas_band && j > k) ? j - k : 0;
+		*hi = j + 1;
+	}
+	else
+	{
+		*lo = j;
+		*hi = (storage == blas_band && j + k + 1 < n) ? j + k + 1 : n;
+	}
+	return p;
+}
+
+static void PFX(scale_vector)(int n, REAL beta, REAL* y)
+{
+	if (beta == 1)
+		return;
+
+	if (beta == 0)
+	{
+		memset(y, 0, (size_t) n * sizeof(REAL));
+		return;
+	}
+
+	#pragma clang loop vectorize(enable)
+	for (int i = 0; i < n; i++)
+		y[i] *= beta;
+}
+
+void PFX(gemv_impl)(enum blas_storage storage, bool trans, int m, int n, int kl, int ku,
+	REAL alpha, const REAL* a, int lda, const REAL* x, int incx, REAL beta, REAL* y, int incy)
+{
+	const int lenx = trans ? m : n;
+	const int leny = trans ? n : m;
+
+	if (m == 0 || n == 0 || (alpha == 0 && beta == 1))
+		return;
+
+	const REAL* xb = PFX(vector_in)(lenx, x, incx, 0);
+	REAL* yb = (REAL*) PFX(vector_in)(leny, y, incy, 1);
+	if (!xb || !yb)
+		return;
+
+	PFX(scale_vector)(leny, beta, yb);
+
+	if (alpha != 0)
+	{
+		int j = 0;
+
+		// four columns at a time, so that y (or x) goes through the cache a quarter as often
+		if (storage == blas_dense)
+		{
+			for (; j + 4 <= n; j += 4)
+			{
+				const REAL* c0 = a + (size_t) j * lda;
+				const REAL* c1 = c0 + lda;
+				const REAL* c2 = c1 + lda;
+				const REAL* c3 = c2 + lda;
+
+				if (!trans)
+				{
+					const REAL t0 = alpha * xb[j], t1 = alpha * xb[j + 1];
+					const REAL t2 = alpha * xb[j + 2], t3 = alpha * xb[j + 3];
+
+					#pragma clang loop vectorize(enable)
+					for (int i = 0; i < m; i++)
+						yb[i] += t0 * c0[i] + t1 * c1[i] + t2 * c2[i] + t3 * c3[i];
+				}
+				else
+				{
+					REAL s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+					#pragma clang loop vectorize(enable)
+					for (int i = 0; i < m; i++)
+					{
+						s0 += c0[i] * xb[i];
+						s1 += c1[i] * xb[i];
+						s2 += c2[i] * xb[i];
+						s3 += c3[i] * xb[i];
+					}
+					yb[j] += alpha * s0;
+					yb[j + 1] += alpha * s1;
+					yb[j + 2] += alpha * s2;
+					yb[j + 3] += alpha * s3;
+				}
+			}
+		}
+
+		for (; j < n; j++)
+		{
+			int lo, hi;
+			const REAL* col = PFX(general_column)(storage, m, kl, ku, a, lda, j, &lo, &hi);
+
+			if (!trans)
+			{
+				const REAL t = alpha * xb[j];
+
+				#pragma clang loop vectorize(enable)
+				for (int i = lo; i < hi; i++)
+					yb[i] += t * col[i];
+			}
+			else
+			{
+				REAL s = 0;
+
+				#pragma clang loop vectorize(enable)
+				for (int i = lo; i < hi; i++)
+					s += col[i] * xb[i];
+				yb[j] += alpha * s;
+			}
+		}
+	}
+
+	PFX(vector_out)(leny, yb, y, incy);
+}
+
+void PFX(ger_impl)(int m, int n, REAL alpha, const REAL* x, int incx, const REAL* y, int incy, REAL* a, int lda)
+{
+	if (m == 0 || n == 0 || alpha == 0)
+		return;
+
+	const REAL* xb = PFX(vector_in)(m, x, incx, 0);
+	if (!xb)
+		return;
+
+	y += BLAS_START(n, incy);
+	for (int j = 0; j < n; j++)
+	{
+		const REAL t = alpha * y[(ptrdiff_t) j * incy];
+		REAL* col = a + (size_t) j * lda;
+
+		#pragma clang loop vectorize(enable)
+		for (int i = 0; i < m; i++)
+			col[i] += t * xb[i];
+	}
+}
+
+void PFX(symv_impl)(enum blas_storage storage, bool upper, int n, int k,
+	REAL alpha, const REAL* a, int lda, const REAL* x, int incx, REAL beta, REAL* y, int incy)
+{
+	if (n == 0 || (alpha == 0 && beta == 1))
+		return;
+
+	const REAL* xb = PFX(vector_in)(n, x, incx, 0);
+	REAL* yb = (REAL*) PFX(vector_in)(n, y, incy, 1);
+	if (!xb || !yb)
+		return;
+
+	PFX(scale_vector)(n, beta, yb);
+
+	if (alpha != 0)
+	{
+		// each stored column contributes to y through A(i, j) and through A(j, i)
+		for (int j = 0; j < n; j++)
+		{
+			int lo, hi;
+			const REAL* col = PFX(tri_column)(storage, upper, n, k, a, lda, j, &lo, &hi);
+			const REAL t = alpha * xb[j];
+			REAL s = 0;
+
+			if (upper)
+				hi--;
+			else
+				lo++;
+
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+			{
+				yb[i] += t * col[i];
+				s += col[i] * xb[i];
+			}
+			yb[j] += t * col[j] + alpha * s;
+		}
+	}
+
+	PFX(vector_out)(n, yb, y, incy);
+}
+
+void PFX(syr_impl)(enum blas_storage storage, bool upper, int n, REAL alpha, const REAL* x, int incx, REAL* a, int lda)
+{
+	if (n == 0 || alpha == 0)
+		return;
+
+	const REAL* xb = PFX(vector_in)(n, x, incx, 0);
+	if (!xb)
+		return;
+
+	for (int j = 0; j < n; j++)
+	{
+		int lo, hi;
+		REAL* col = PFX(tri_column)(storage, upper, n, 0, a, lda, j, &lo, &hi);
+		const REAL t = alpha * xb[j];
+
+		#pragma clang loop vectorize(enable)
+		for (int i = lo; i < hi; i++)
+			col[i] += t * xb[i];
+	}
+}
+
+void PFX(syr2_impl)(enum blas_storage storage, bool upper, int n, REAL alpha,
+	const REAL* x, int incx, const REAL* y, int incy, REAL* a, int lda)
+{
+	if (n == 0 || alpha == 0)
+		return;
+
+	const REAL* xb = PFX(vector_in)(n, x, incx, 0);
+	const REAL* yb = PFX(vector_in)(n, y, incy, 1);
+	if (!xb || !yb)
+		return;
+
+	for (int j = 0; j < n; j++)
+	{
+		int lo, hi;
+		REAL* col = PFX(tri_column)(storage, upper, n, 0, a, lda, j, &lo, &hi);
+		const REAL tx = alpha * xb[j], ty = alpha * yb[j];
+
+		#pragma clang loop vectorize(enable)
+		for (int i = lo; i < hi; i++)
+			col[i] += ty * xb[i] + tx * yb[i];
+	}
+}
+
+// x := op(A) * x. Columns are visited in the order that only reads elements of x that
+// haven't been overwritten yet.
+void PFX(trmv_impl)(enum blas_storage storage, bool upper, bool trans, bool unit, int n, int k,
+	const REAL* a, int lda, REAL* x, int incx)
+{
+	if (n == 0)
+		return;
+
+	REAL* xb = (REAL*) PFX(vector_in)(n, x, incx, 0);
+	if (!xb)
+		return;
+
+	// going forward is right for upper/no transpose and for lower/transpose
+	const bool forward = (upper != trans);
+
+	for (int jj = 0; jj < n; jj++)
+	{
+		const int j = forward ? jj : n - 1 - jj;
+		int lo, hi;
+		const REAL* col = PFX(tri_column)(storage, upper, n, k, a, lda, j, &lo, &hi);
+
+		if (upper)
+			hi--;
+		else
+			lo++;
+
+		if (!trans)
+		{
+			const REAL t = xb[j];
+
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+				xb[i] += t * col[i];
+			if (!unit)
+				xb[j] *= col[j];
+		}
+		else
+		{
+			REAL s = unit ? xb[j] : xb[j] * col[j];
+
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+				s += col[i] * xb[i];
+			xb[j] = s;
+		}
+	}
+
+	PFX(vector_out)(n, xb, x, incx);
+}
+
+// Solves op(A) * x = b, b is passed in x
+void PFX(trsv_impl)(enum blas_storage storage, bool upper, bool trans, bool unit, int n, int k,
+	const REAL* a, int lda, REAL* x, int incx)
+{
+	if (n == 0)
+		return;
+
+	REAL* xb = (REAL*) PFX(vector_in)(n, x, incx, 0);
+	if (!xb)
+		return;
+
+	// the opposite order of trmv
+	const bool forward = (upper == trans);
+
+	for (int jj = 0; jj < n; jj++)
+	{
+		const int j = forward ? jj : n - 1 - jj;
+		int lo, hi;
+		const REAL* col = PFX(tri_column)(storage, upper, n, k, a, lda, j, &lo, &hi);
+
+		if (upper)
+			hi--;
+		else
+			lo++;
+
+		if (!trans)
+		{
+			if (!unit)
+				xb[j] /= col[j];
+
+			const REAL t = xb[j];
+
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+				xb[i] -= t * col[i];
+		}
+		else
+		{
+			REAL s = xb[j];
+
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+				s -= col[i] * xb[i];
+			xb[j] = unit ? s : s / col[j];
+		}
+	}
+
+	PFX(vector_out)(n, xb, x, incx);
+}
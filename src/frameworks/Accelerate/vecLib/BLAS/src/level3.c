@@ -0,0 +1,37 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+#include <string.h>
+
+// The block size for splitting triangular matrices; the diagonal blocks are handled by level 2
+// routines or computed in full, so this trades those costs against the efficiency of GEMM
+#define BLAS_TRI_NB 64
+
+#define REAL float
+#define PFX(name) s##name
+#include "level3_template.h"
+#undef REAL
+#undef PFX
+
+#define REAL double
+#define PFX(name) d##name
+#include "level3_template.h"
+#undef REAL
+#undef PFX
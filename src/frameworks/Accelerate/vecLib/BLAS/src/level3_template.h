@@ -0,0 +1,353 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Level 3 implementations besides GEMM, included by level3.c with REAL and PFX(name) defined.
+//
+// All of them are expressed in terms of gemm_operands() so that they get its blocking and
+// threading: SYMM directly, SYRK/SYR2K by splitting the triangular matrix into blocks of
+// BLAS_TRI_NB and TRMM/TRSM by halving it recursively down to that size. The off-diagonal
+// blocks are plain matrix products, the small diagonal blocks are done on their own.
+
+static void PFX(scale_block)(int m, int n, REAL beta, REAL* c, int ldc)
+{
+	if (beta == 1)
+		return;
+
+	for (int j = 0; j < n; j++)
+	{
+		REAL* col = c + (size_t) j * ldc;
+
+		if (beta == 0)
+		{
+			memset(col, 0, (size_t) m * sizeof(REAL));
+		}
+		else
+		{
+			#pragma clang loop vectorize(enable)
+			for (int i = 0; i < m; i++)
+				col[i] *= beta;
+		}
+	}
+}
+
+void PFX(symm_impl)(bool left, bool upper, int m, int n, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc)
+{
+	const struct PFX(operand) opa = { a, lda, upper ? blas_operand_sym_upper : blas_operand_sym_lower };
+	const struct PFX(operand) opb = { b, ldb, blas_operand_normal };
+
+	if (left)
+		PFX(gemm_operands)(m, n, m, alpha, &opa, &opb, beta, c, ldc);
+	else
+		PFX(gemm_operands)(m, n, n, alpha, &opb, &opa, beta, c, ldc);
+}
+
+// For SYRK and SYR2K, X = op(A) is n x k. These return rows [r0, ...) of X and
+// columns [c0, ...) of X^T.
+static struct PFX(operand) PFX(rows_of)(bool trans, const REAL* a, int lda, int r0)
+{
+	if (trans)
+		return (struct PFX(operand)) { a + (size_t) r0 * lda, lda, blas_operand_trans };
+	return (struct PFX(operand)) { a + r0, lda, blas_operand_normal };
+}
+
+static struct PFX(operand) PFX(columns_of_transpose)(bool trans, const REAL* a, int lda, int c0)
+{
+	if (trans)
+		return (struct PFX(operand)) { a + (size_t) c0 * lda, lda, blas_operand_normal };
+	return (struct PFX(operand)) { a + c0, lda, blas_operand_trans };
+}
+
+// C := beta * C + tmp on the stored triangle of a diagonal block
+static void PFX(merge_triangle)(bool upper, int nb, REAL beta, const REAL* tmp, REAL* c, int ldc)
+{
+	for (int j = 0; j < nb; j++)
+	{
+		const int lo = upper ? 0 : j;
+		const int hi = upper ? j + 1 : nb;
+		REAL* col = c + (size_t) j * ldc;
+		const REAL* t = tmp + (size_t) j * nb;
+
+		if (beta == 0)
+		{
+			for (int i = lo; i < hi; i++)
+				col[i] = t[i];
+		}
+		else
+		{
+			#pragma clang loop vectorize(enable)
+			for (int i = lo; i < hi; i++)
+				col[i] = beta * col[i] + t[i];
+		}
+	}
+}
+
+static inline REAL PFX(x_at)(bool trans, const REAL* a, int lda, int i, int p)
+{
+	return trans ? a[p + (size_t) i * lda] : a[i + (size_t) p * lda];
+}
+
+// C := alpha * X * Y^T (+ alpha * Y * X^T if b isn't NULL) + beta * C on one triangle of C,
+// with X = op(A) and Y = op(B)
+static void PFX(rank_k_update)(bool upper, bool trans, int n, int k, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc)
+{
+	if (n == 0)
+		return;
+
+	if (alpha == 0 || k == 0)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			if (upper)
+				PFX(scale_block)(j + 1, 1, beta, c + (size_t) j * ldc, ldc);
+			else
+				PFX(scale_block)(n - j, 1, beta, c + j + (size_t) j * ldc, ldc);
+		}
+		return;
+	}
+
+	for (int j0 = 0; j0 < n; j0 += BLAS_TRI_NB)
+	{
+		const int nb = (n - j0 < BLAS_TRI_NB) ? n - j0 : BLAS_TRI_NB;
+		// the part of this block column of the triangle that is outside the diagonal block
+		const int r0 = upper ? 0 : j0 + nb;
+		const int rows = upper ? j0 : n - j0 - nb;
+		REAL* cj = c + (size_t) j0 * ldc;
+
+		const struct PFX(operand) x_rows = PFX(rows_of)(trans, a, lda, r0);
+		const struct PFX(operand) x_diag = PFX(rows_of)(trans, a, lda, j0);
+		const struct PFX(operand) xt = PFX(columns_of_transpose)(trans, a, lda, j0);
+		struct PFX(operand) y_rows, y_diag, yt;
+
+		if (b)
+		{
+			y_rows = PFX(rows_of)(trans, b, ldb, r0);
+			y_diag = PFX(rows_of)(trans, b, ldb, j0);
+			yt = PFX(columns_of_transpose)(trans, b, ldb, j0);
+		}
+
+		if (rows > 0)
+		{
+			if (b)
+			{
+				PFX(gemm_operands)(rows, nb, k, alpha, &x_rows, &yt, beta, cj + r0, ldc);
+				PFX(gemm_operands)(rows, nb, k, alpha, &y_rows, &xt, 1, cj + r0, ldc);
+			}
+			else
+			{
+				PFX(gemm_operands)(rows, nb, k, alpha, &x_rows, &xt, beta, cj + r0, ldc);
+			}
+		}
+
+		// The diagonal block is computed in full and then merged, wasting a few flops
+		// to keep it in the fast path
+		REAL* tmp = (REAL*) blas_scratch(2, (size_t) nb * nb * sizeof(REAL));
+		if (tmp)
+		{
+			if (b)
+			{
+				PFX(gemm_operands)(nb, nb, k, alpha, &x_diag, &yt, 0, tmp, nb);
+				PFX(gemm_operands)(nb, nb, k, alpha, &y_diag, &xt, 1, tmp, nb);
+			}
+			else
+			{
+				PFX(gemm_operands)(nb, nb, k, alpha, &x_diag, &xt, 0, tmp, nb);
+			}
+			PFX(merge_triangle)(upper, nb, beta, tmp, cj + j0, ldc);
+			continue;
+		}
+
+		// out of memory
+		for (int j = j0; j < j0 + nb; j++)
+		{
+			const int lo = upper ? j0 : j;
+			const int hi = upper ? j + 1 : j0 + nb;
+
+			for (int i = lo; i < hi; i++)
+			{
+				REAL sum = 0;
+
+				for (int p = 0; p < k; p++)
+				{
+					sum += PFX(x_at)(trans, a, lda, i, p) * (b ? PFX(x_at)(trans, b, ldb, j, p) : PFX(x_at)(trans, a, lda, j, p));
+					if (b)
+						sum += PFX(x_at)(trans, b, ldb, i, p) * PFX(x_at)(trans, a, lda, j, p);
+				}
+
+				REAL* cij = c + i + (size_t) j * ldc;
+				*cij = (beta == 0) ? alpha * sum : alpha * sum + beta * *cij;
+			}
+		}
+	}
+}
+
+void PFX(syrk_impl)(bool upper, bool trans, int n, int k, REAL alpha, const REAL* a, int lda,
+	REAL beta, REAL* c, int ldc)
+{
+	PFX(rank_k_update)(upper, trans, n, k, alpha, a, lda, NULL, 0, beta, c, ldc);
+}
+
+void PFX(syr2k_impl)(bool upper, bool trans, int n, int k, REAL alpha, const REAL* a, int lda,
+	const REAL* b, int ldb, REAL beta, REAL* c, int ldc)
+{
+	PFX(rank_k_update)(upper, trans, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+// For TRMM and TRSM, T = op(A). The block of T starting at row r0 and column c0.
+static struct PFX(operand) PFX(tri_block)(bool trans, const REAL* a, int lda, int r0, int c0)
+{
+	if (trans)
+		return (struct PFX(operand)) { a + c0 + (size_t) r0 * lda, lda, blas_operand_trans };
+	return (struct PFX(operand)) { a + r0 + (size_t) c0 * lda, lda, blas_operand_normal };
+}
+
+// B := T_kk * B_k (left) or B_k * T_kk (right) for the diagonal block starting at k0, or the
+// same with the inverse of T_kk. Rows of B are vectors x with x^T * T = (T^T * x)^T.
+static void PFX(tri_diagonal)(bool solve, bool left, bool upper, bool trans, bool unit, int m, int n,
+	int k0, int nb, const REAL* a, int lda, REAL* b, int ldb)
+{
+	const REAL* akk = a + k0 + (size_t) k0 * lda;
+
+	if (left)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			REAL* x = b + k0 + (size_t) j * ldb;
+
+			if (solve)
+				PFX(trsv_impl)(blas_dense, upper, trans, unit, nb, 0, akk, lda, x, 1);
+			else
+				PFX(trmv_impl)(blas_dense, upper, trans, unit, nb, 0, akk, lda, x, 1);
+		}
+	}
+	else
+	{
+		for (int i = 0; i < m; i++)
+		{
+			REAL* x = b + i + (size_t) k0 * ldb;
+
+			if (solve)
+				PFX(trsv_impl)(blas_dense, upper, !trans, unit, nb, 0, akk, lda, x, ldb);
+			else
+				PFX(trmv_impl)(blas_dense, upper, !trans, unit, nb, 0, akk, lda, x, ldb);
+		}
+	}
+}
+
+// TRMM and TRSM halve the range [k0, k0 + size) of T until it's at most BLAS_TRI_NB, so that
+// most of the work is done by a few large products. The half that has to be done first is
+// `first`, the other one is updated with the product of the off-diagonal block of T.
+static void PFX(tri_halves)(bool first_low, int k0, int size, int* f0, int* fn, int* s0, int* sn)
+{
+	const int low = size / 2;
+
+	*f0 = first_low ? k0 : k0 + low;
+	*fn = first_low ? low : size - low;
+	*s0 = first_low ? k0 + low : k0;
+	*sn = size - *fn;
+}
+
+// B_k := T_kk * B_k + T_k,>k * B_>k for upper T, which needs B_>k unchanged so the top half
+// goes first; the other way around for lower T and on the right
+static void PFX(trmm_recursive)(bool left, bool upper, bool trans, bool unit, int m, int n,
+	int k0, int size, const REAL* a, int lda, REAL* b, int ldb)
+{
+	if (size <= BLAS_TRI_NB)
+	{
+		PFX(tri_diagonal)(false, left, upper, trans, unit, m, n, k0, size, a, lda, b, ldb);
+		return;
+	}
+
+	const bool tu = upper != trans;
+	int f0, fn, s0, sn;
+
+	PFX(tri_halves)(left ? tu : !tu, k0, size, &f0, &fn, &s0, &sn);
+	PFX(trmm_recursive)(left, upper, trans, unit, m, n, f0, fn, a, lda, b, ldb);
+
+	if (left)
+	{
+		const struct PFX(operand) t = PFX(tri_block)(trans, a, lda, f0, s0);
+		const struct PFX(operand) bs = { b + s0, ldb, blas_operand_normal };
+		PFX(gemm_operands)(fn, n, sn, 1, &t, &bs, 1, b + f0, ldb);
+	}
+	else
+	{
+		const struct PFX(operand) t = PFX(tri_block)(trans, a, lda, s0, f0);
+		const struct PFX(operand) bs = { b + (size_t) s0 * ldb, ldb, blas_operand_normal };
+		PFX(gemm_operands)(m, fn, sn, 1, &bs, &t, 1, b + (size_t) f0 * ldb, ldb);
+	}
+
+	PFX(trmm_recursive)(left, upper, trans, unit, m, n, s0, sn, a, lda, b, ldb);
+}
+
+// B := alpha * T * B (left) or alpha * B * T (right)
+void PFX(trmm_impl)(bool left, bool upper, bool trans, bool unit, int m, int n, REAL alpha,
+	const REAL* a, int lda, REAL* b, int ldb)
+{
+	PFX(scale_block)(m, n, alpha, b, ldb);
+	if (alpha == 0 || m == 0 || n == 0)
+		return;
+
+	PFX(trmm_recursive)(left, upper, trans, unit, m, n, 0, left ? m : n, a, lda, b, ldb);
+}
+
+// X_k depends on X_>k for upper T on the left, so the bottom half is solved first and
+// subtracted from the top half; the other way around for lower T and on the right
+static void PFX(trsm_recursive)(bool left, bool upper, bool trans, bool unit, int m, int n,
+	int k0, int size, const REAL* a, int lda, REAL* b, int ldb)
+{
+	if (size <= BLAS_TRI_NB)
+	{
+		PFX(tri_diagonal)(true, left, upper, trans, unit, m, n, k0, size, a, lda, b, ldb);
+		return;
+	}
+
+	const bool tu = upper != trans;
+	int f0, fn, s0, sn;
+
+	PFX(tri_halves)(left ? !tu : tu, k0, size, &f0, &fn, &s0, &sn);
+	PFX(trsm_recursive)(left, upper, trans, unit, m, n, f0, fn, a, lda, b, ldb);
+
+	if (left)
+	{
+		const struct PFX(operand) t = PFX(tri_block)(trans, a, lda, s0, f0);
+		const struct PFX(operand) xf = { b + f0, ldb, blas_operand_normal };
+		PFX(gemm_operands)(sn, n, fn, -1, &t, &xf, 1, b + s0, ldb);
+	}
+	else
+	{
+		const struct PFX(operand) t = PFX(tri_block)(trans, a, lda, f0, s0);
+		const struct PFX(operand) xf = { b + (size_t) f0 * ldb, ldb, blas_operand_normal };
+		PFX(gemm_operands)(m, sn, fn, -1, &xf, &t, 1, b + (size_t) s0 * ldb, ldb);
+	}
+
+	PFX(trsm_recursive)(left, upper, trans, unit, m, n, s0, sn, a, lda, b, ldb);
+}
+
+// Solves T * X = alpha * B (left) or X * T = alpha * B (right), overwriting B with X
+void PFX(trsm_impl)(bool left, bool upper, bool trans, bool unit, int m, int n, REAL alpha,
+	const REAL* a, int lda, REAL* b, int ldb)
+{
+	PFX(scale_block)(m, n, alpha, b, ldb);
+	if (alpha == 0 || m == 0 || n == 0)
+		return;
+
+	PFX(trsm_recursive)(left, upper, trans, unit, m, n, 0, left ? m : n, a, lda, b, ldb);
+}
@@ -0,0 +1,220 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "blas_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static pthread_once_t nthreads_once = PTHREAD_ONCE_INIT;
+static int nthreads = 1;
+
+static void nthreads_init(void)
+{
+	// Apple's documented way of limiting vecLib's threads
+	const char* env = getenv("VECLIB_MAXIMUM_THREADS");
+	long count = 0;
+
+	if (env)
+		count = strtol(env, NULL, 10);
+	if (count <= 0)
+		count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count <= 0)
+		count = 1;
+
+	nthreads = (count > 64) ? 64 : (int) count;
+}
+
+// The number of threads the level 3 routines use, caller included
+int APPLE_NTHREADS(void)
+{
+	pthread_once(&nthreads_once, nthreads_init);
+	return nthreads;
+}
+
+// The pool runs one job at a time. Workers sleep on `wakeup` until the job generation changes,
+// then grab task indices until there are none left.
+struct blas_pool
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t wakeup;
+	pthread_cond_t done;
+
+	// held by whoever is running a job
+	pthread_mutex_t busy;
+
+	unsigned long generation;
+	void (*fn)(void* ctx, int task);
+	void* ctx;
+	int tasks;
+	atomic_int next_task;
+	// workers still working on the current job
+	int active;
+};
+
+static struct blas_pool pool = {
+	.mutex = PTHREAD_MUTEX_INITIALIZER,
+	.wakeup = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER,
+	.busy = PTHREAD_MUTEX_INITIALIZER,
+};
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static int pool_workers = 0;
+
+static __thread bool in_pool_task = false;
+
+static void run_tasks(void (*fn)(void* ctx, int task), void* ctx, int tasks)
+{
+	int task;
+
+	in_pool_task = true;
+	while ((task = atomic_fetch_add_explicit(&pool.next_task, 1, memory_order_relaxed)) < tasks)
+		fn(ctx, task);
+	in_pool_task = false;
+}
+
+static void* pool_worker(void* unused)
+{
+	unsigned long seen = 0;
+
+	(void)unused;
+
+	pthread_mutex_lock(&pool.mutex);
+	while (1)
+	{
+		while (pool.generation == seen)
+			pthread_cond_wait(&pool.wakeup, &pool.mutex);
+		seen = pool.generation;
+
+		void (*fn)(void*, int) = pool.fn;
+		void* ctx = pool.ctx;
+		const int tasks = pool.tasks;
+
+		pthread_mutex_unlock(&pool.mutex);
+		run_tasks(fn, ctx, tasks);
+		pthread_mutex_lock(&pool.mutex);
+
+		if (--pool.active == 0)
+			pthread_cond_signal(&pool.done);
+	}
+	return NULL;
+}
+
+static void pool_init(void)
+{
+	const int count = APPLE_NTHREADS() - 1;
+	pthread_attr_t attr;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	for (int i = 0; i < count; i++)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, &attr, pool_worker, NULL) != 0)
+			break;
+		pool_workers++;
+	}
+
+	pthread_attr_destroy(&attr);
+}
+
+void blas_parallel_for(int tasks, void (*fn)(void* ctx, int task), void* ctx)
+{
+	if (tasks > 1 && !in_pool_task)
+		pthread_once(&pool_once, pool_init);
+
+	if (tasks <= 1 || in_pool_task || pool_workers == 0 || pthread_mutex_trylock(&pool.busy) != 0)
+	{
+		for (int i = 0; i < tasks; i++)
+			fn(ctx, i);
+		return;
+	}
+
+	pthread_mutex_lock(&pool.mutex);
+	pool.fn = fn;
+	pool.ctx = ctx;
+	pool.tasks = tasks;
+	atomic_store_explicit(&pool.next_task, 0, memory_order_relaxed);
+	pool.active = pool_workers;
+	pool.generation++;
+	pthread_cond_broadcast(&pool.wakeup);
+	pthread_mutex_unlock(&pool.mutex);
+
+	run_tasks(fn, ctx, tasks);
+
+	// the job's context lives on our stack, so every worker has to be done with it
+	pthread_mutex_lock(&pool.mutex);
+	while (pool.active > 0)
+		pthread_cond_wait(&pool.done, &pool.mutex);
+	pthread_mutex_unlock(&pool.mutex);
+
+	pthread_mutex_unlock(&pool.busy);
+}
+
+static pthread_key_t scratch_key;
+static pthread_once_t scratch_once = PTHREAD_ONCE_INIT;
+
+struct blas_scratch_block
+{
+	size_t size[BLAS_SCRATCH_SLOTS];
+	void* memory[BLAS_SCRATCH_SLOTS];
+};
+
+static void scratch_free(void* ptr)
+{
+	struct blas_scratch_block* block = (struct blas_scratch_block*) ptr;
+
+	for (int i = 0; i < BLAS_SCRATCH_SLOTS; i++)
+		free(block->memory[i]);
+	free(block);
+}
+
+static void scratch_init(void)
+{
+	pthread_key_create(&scratch_key, scratch_free);
+}
+
+void* blas_scratch(int slot, size_t size)
+{
+	pthread_once(&scratch_once, scratch_init);
+
+	struct blas_scratch_block* block = (struct blas_scratch_block*) pthread_getspecific(scratch_key);
+	if (!block)
+	{
+		block = (struct blas_scratch_block*) calloc(1, sizeof(*block));
+		if (!block)
+			return NULL;
+		pthread_setspecific(scratch_key, block);
+	}
+
+	if (block->size[slot] < size)
+	{
+		void* memory;
+
+		if (posix_memalign(&memory, 64, size) != 0)
+			return NULL;
+		free(block->memory[slot]);
+		block->memory[slot] = memory;
+		block->size[slot] = size;
+	}
+
+	return block->memory[slot];
+}
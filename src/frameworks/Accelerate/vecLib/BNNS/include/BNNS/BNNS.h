@@ -21,17 +21,178 @@
 #ifndef _BNNS_H_
 #define _BNNS_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum
+{
+	BNNSDataTypeFloatBit = 0x10000,
+	BNNSDataTypeFloat16 = BNNSDataTypeFloatBit | 16,
+	BNNSDataTypeFloat32 = BNNSDataTypeFloatBit | 32,
+
+	BNNSDataTypeIntBit = 0x20000,
+	BNNSDataTypeInt8 = BNNSDataTypeIntBit | 8,
+	BNNSDataTypeInt16 = BNNSDataTypeIntBit | 16,
+	BNNSDataTypeInt32 = BNNSDataTypeIntBit | 32,
+
+	BNNSDataTypeUIntBit = 0x40000,
+	BNNSDataTypeUInt8 = BNNSDataTypeUIntBit | 8,
+	BNNSDataTypeUInt16 = BNNSDataTypeUIntBit | 16,
+	BNNSDataTypeUInt32 = BNNSDataTypeUIntBit | 32,
+
+	// indices into a table of float values
+	BNNSDataTypeIndexedBit = 0x80000,
+	BNNSDataTypeIndexed8 = BNNSDataTypeIndexedBit | 8,
+} BNNSDataType;
+
+typedef enum
+{
+	BNNSPoolingFunctionMax = 0,
+	BNNSPoolingFunctionAverage = 1,
+} BNNSPoolingFunction;
+
+typedef enum
+{
+	BNNSActivationFunctionIdentity = 0,
+	BNNSActivationFunctionRectifiedLinear = 1,
+	BNNSActivationFunctionLeakyRectifiedLinear = 2,
+	BNNSActivationFunctionSigmoid = 3,
+	BNNSActivationFunctionTanh = 4,
+	BNNSActivationFunctionScaledTanh = 5,
+	BNNSActivationFunctionAbs = 6,
+	BNNSActivationFunctionLinear = 7,
+	BNNSActivationFunctionClamp = 8,
+	BNNSActivationFunctionIntegerLinearSaturate = 9,
+	BNNSActivationFunctionIntegerLinearSaturatePerChannel = 10,
+	BNNSActivationFunctionSoftmax = 11,
+} BNNSActivationFunction;
+
+typedef enum
+{
+	// keep pointers to the layer data instead of copying it
+	BNNSFlagsUseClientPtr = 0x0001,
+} BNNSFlags;
+
+// Value (x, y, c) of an image stack is at x + y * row_stride + c * image_stride.
+// Integer data stands for data_scale * value + data_bias.
+typedef struct
+{
+	size_t width;
+	size_t height;
+	size_t channels;
+	size_t row_stride;
+	size_t image_stride;
+	BNNSDataType data_type;
+	float data_scale;
+	float data_bias;
+} BNNSImageStackDescriptor;
+
+typedef struct
+{
+	size_t size;
+	BNNSDataType data_type;
+	float data_scale;
+	float data_bias;
+} BNNSVectorDescriptor;
+
+// Weights or biases. Integer data stands for data_scale * value + data_bias,
+// indexed data for data_table[value].
+typedef struct
+{
+	const void* data;
+	BNNSDataType data_type;
+	float data_scale;
+	float data_bias;
+	const float* data_table;
+} BNNSLayerData;
+
+typedef struct
+{
+	BNNSActivationFunction function;
+	float alpha;
+	float beta;
+
+	// for the integer functions
+	int32_t iscale;
+	int32_t ioffset;
+	int32_t ishift;
+	const int32_t* iscale_per_channel;
+	const int32_t* ioffset_per_channel;
+	const int32_t* ishift_per_channel;
+} BNNSActivation;
+
+// The weights are out_channels x in_channels x k_height x k_width values, weight (x, y, i, o)
+// is at x + k_width * (y + k_height * (i + in_channels * o)). The bias has out_channels values.
+typedef struct
+{
+	size_t x_stride;
+	size_t y_stride;
+	size_t x_padding;
+	size_t y_padding;
+	size_t k_width;
+	size_t k_height;
+	size_t in_channels;
+	size_t out_channels;
+	BNNSLayerData weights;
+	BNNSLayerData bias;
+	BNNSActivation activation;
+} BNNSConvolutionLayerParameters;
+
+// The weights are an out_size x in_size matrix, weight (i, o) is at i + in_size * o.
+// The bias has out_size values.
+typedef struct
+{
+	size_t in_size;
+	size_t out_size;
+	BNNSLayerData weights;
+	BNNSLayerData bias;
+	BNNSActivation activation;
+} BNNSFullyConnectedLayerParameters;
+
+typedef struct
+{
+	size_t x_stride;
+	size_t y_stride;
+	size_t x_padding;
+	size_t y_padding;
+	size_t k_width;
+	size_t k_height;
+	size_t in_channels;
+	size_t out_channels;
+	BNNSPoolingFunction pooling_function;
+	BNNSLayerData bias;
+	BNNSActivation activation;
+} BNNSPoolingLayerParameters;
+
+typedef int (*BNNSAlloc)(void** __memptr, size_t __alignment, size_t __size);
+typedef void (*BNNSFree)(void* __ptr);
+
+typedef struct
+{
+	uint32_t flags;
+	// 0 for the default
+	size_t n_threads;
+	BNNSAlloc alloc_memory;
+	BNNSFree free_memory;
+} BNNSFilterParameters;
+
+typedef void* BNNSFilter;
+
+BNNSFilter BNNSFilterCreateConvolutionLayer(const BNNSImageStackDescriptor *__in_desc, const BNNSImageStackDescriptor *__out_desc, const BNNSConvolutionLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params);
+BNNSFilter BNNSFilterCreateFullyConnectedLayer(const BNNSVectorDescriptor *__in_desc, const BNNSVectorDescriptor *__out_desc, const BNNSFullyConnectedLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params);
+BNNSFilter BNNSFilterCreatePoolingLayer(const BNNSImageStackDescriptor *__in_desc, const BNNSImageStackDescriptor *__out_desc, const BNNSPoolingLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params);
+BNNSFilter BNNSFilterCreateVectorActivationLayer(const BNNSVectorDescriptor *__in_desc, const BNNSVectorDescriptor *__out_desc, const BNNSActivation *__activation, const BNNSFilterParameters *__filter_params);
+int BNNSFilterApply(BNNSFilter __filter, const void *__in, void *__out);
+int BNNSFilterApplyBatch(BNNSFilter __filter, size_t __batch_size, const void *__in, size_t __in_stride, void *__out, size_t __out_stride);
+void BNNSFilterDestroy(BNNSFilter __filter);
+
+// Converts `__count` values of layer data to float, as the filters do with their weights.
+// Returns 0 on success, -1 if the data type can't be converted.
+int BNNSDequantize(const BNNSLayerData *__in, float *__out, size_t __count);
+
 void* BNNSApplyVectorActivationLayer(void);
-void* BNNSDequantize(void);
-void* BNNSFilterApply(void);
-void* BNNSFilterApplyBatch(void);
-void* BNNSFilterCreateConvolutionLayer(void);
 void* BNNSFilterCreateConvolutionWeightsTensorConversionLayer(void);
-void* BNNSFilterCreateFullyConnectedLayer(void);
 void* BNNSFilterCreateImageTensorConversionLayer(void);
-void* BNNSFilterCreatePoolingLayer(void);
 void* BNNSFilterCreateTensorConvolutionLayer(void);
-void* BNNSFilterCreateVectorActivationLayer(void);
-void* BNNSFilterDestroy(void);
 
 #endif
@@ -35,29 +35,37 @@ void* BNNSApplyVectorActivationLayer(void)
     return NULL;
 }
 
+/*
 void* BNNSDequantize(void)
 {
     if (verbose) puts("STUB: BNNSDequantize called");
     return NULL;
 }
+*/
 
+/*
 void* BNNSFilterApply(void)
 {
     if (verbose) puts("STUB: BNNSFilterApply called");
     return NULL;
 }
+*/
 
+/*
 void* BNNSFilterApplyBatch(void)
 {
     if (verbose) puts("STUB: BNNSFilterApplyBatch called");
     return NULL;
 }
+*/
 
+/*
 void* BNNSFilterCreateConvolutionLayer(void)
 {
     if (verbose) puts("STUB: BNNSFilterCreateConvolutionLayer called");
     return NULL;
 }
+*/
 
 void* BNNSFilterCreateConvolutionWeightsTensorConversionLayer(void)
 {
@@ -65,11 +73,13 @@ void* BNNSFilterCreateConvolutionWeightsTensorConversionLayer(void)
     return NULL;
 }
 
+/*
 void* BNNSFilterCreateFullyConnectedLayer(void)
 {
     if (verbose) puts("STUB: BNNSFilterCreateFullyConnectedLayer called");
     return NULL;
 }
+*/
 
 void* BNNSFilterCreateImageTensorConversionLayer(void)
 {
@@ -77,11 +87,13 @@ void* BNNSFilterCreateImageTensorConversionLayer(void)
     return NULL;
 }
 
+/*
 void* BNNSFilterCreatePoolingLayer(void)
 {
     if (verbose) puts("STUB: BNNSFilterCreatePoolingLayer called");
     return NULL;
 }
+*/
 
 void* BNNSFilterCreateTensorConvolutionLayer(void)
 {
@@ -89,14 +101,18 @@ void* BNNSFilterCreateTensorConvolutionLayer(void)
     return NULL;
 }
 
+/*
 void* BNNSFilterCreateVectorActivationLayer(void)
 {
     if (verbose) puts("STUB: BNNSFilterCreateVectorActivationLayer called");
     return NULL;
 }
+*/
 
+/*
 void* BNNSFilterDestroy(void)
 {
     if (verbose) puts("STUB: BNNSFilterDestroy called");
     return NULL;
 }
+*/
@@ -0,0 +1,201 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <libvMisc/libvMisc.h>
+#include <math.h>
+#include <string.h>
+
+// The integer functions work on integer data only, which filters never compute in.
+// Softmax needs a whole vector, so only layers producing vectors have it.
+bool bnns_activation_supported(const BNNSActivation* activation, bool vector)
+{
+	switch (activation->function)
+	{
+		case BNNSActivationFunctionIdentity:
+		case BNNSActivationFunctionRectifiedLinear:
+		case BNNSActivationFunctionLeakyRectifiedLinear:
+		case BNNSActivationFunctionSigmoid:
+		case BNNSActivationFunctionTanh:
+		case BNNSActivationFunctionScaledTanh:
+		case BNNSActivationFunctionAbs:
+		case BNNSActivationFunctionLinear:
+		case BNNSActivationFunctionClamp:
+			return true;
+		case BNNSActivationFunctionSoftmax:
+			return vector;
+		default:
+			return false;
+	}
+}
+
+// vForce takes int counts
+#define VFORCE_CHUNK ((size_t) 1 << 30)
+
+static void vexp(float* x, size_t n)
+{
+	for (size_t i = 0; i < n; i += VFORCE_CHUNK)
+	{
+		const int count = (int) ((n - i < VFORCE_CHUNK) ? n - i : VFORCE_CHUNK);
+		vvexpf(x + i, x + i, &count);
+	}
+}
+
+static void vtanh(float* x, size_t n)
+{
+	for (size_t i = 0; i < n; i += VFORCE_CHUNK)
+	{
+		const int count = (int) ((n - i < VFORCE_CHUNK) ? n - i : VFORCE_CHUNK);
+		vvtanhf(x + i, x + i, &count);
+	}
+}
+
+static void softmax(float* x, size_t n)
+{
+	float max = -INFINITY, sum = 0;
+
+	for (size_t i = 0; i < n; i++)
+		max = fmaxf(max, x[i]);
+	for (size_t i = 0; i < n; i++)
+		x[i] -= max;
+
+	vexp(x, n);
+
+	for (size_t i = 0; i < n; i++)
+		sum += x[i];
+
+	const float scale = 1.0f / sum;
+	for (size_t i = 0; i < n; i++)
+		x[i] *= scale;
+}
+
+void bnns_activate(const BNNSActivation* activation, float* x, size_t n)
+{
+	const float alpha = activation->alpha, beta = activation->beta;
+
+	switch (activation->function)
+	{
+		case BNNSActivationFunctionRectifiedLinear:
+			for (size_t i = 0; i < n; i++)
+				x[i] = (x[i] > 0) ? x[i] : 0;
+			break;
+		case BNNSActivationFunctionLeakyRectifiedLinear:
+			for (size_t i = 0; i < n; i++)
+				x[i] = (x[i] < 0) ? alpha * x[i] : x[i];
+			break;
+		case BNNSActivationFunctionSigmoid:
+			for (size_t i = 0; i < n; i++)
+				x[i] = -x[i];
+			vexp(x, n);
+			for (size_t i = 0; i < n; i++)
+				x[i] = 1.0f / (1.0f + x[i]);
+			break;
+		case BNNSActivationFunctionTanh:
+			vtanh(x, n);
+			break;
+		case BNNSActivationFunctionScaledTanh:
+			for (size_t i = 0; i < n; i++)
+				x[i] *= beta;
+			vtanh(x, n);
+			for (size_t i = 0; i < n; i++)
+				x[i] *= alpha;
+			break;
+		case BNNSActivationFunctionAbs:
+			for (size_t i = 0; i < n; i++)
+				x[i] = fabsf(x[i]);
+			break;
+		case BNNSActivationFunctionLinear:
+			for (size_t i = 0; i < n; i++)
+				x[i] *= alpha;
+			break;
+		case BNNSActivationFunctionClamp:
+			for (size_t i = 0; i < n; i++)
+				x[i] = fminf(fmaxf(x[i], alpha), beta);
+			break;
+		case BNNSActivationFunctionSoftmax:
+			softmax(x, n);
+			break;
+		default:
+			break;
+	}
+}
+
+void bnns_bias_activate(const BNNSActivation* activation, float* x, size_t rows, size_t n, size_t row_stride, float bias)
+{
+	// contiguous rows are done in one go
+	if (row_stride == n)
+	{
+		n *= rows;
+		rows = 1;
+	}
+
+	for (size_t r = 0; r < rows; r++)
+	{
+		float* row = x + r * row_stride;
+
+		if (bias != 0)
+		{
+			for (size_t i = 0; i < n; i++)
+				row[i] += bias;
+		}
+		bnns_activate(activation, row, n);
+	}
+}
+
+static int vector_activation_apply(const struct bnns_filter* f, struct bnns_workspace* ws, const void* in, void* out)
+{
+	const size_t n = f->in_vector.size;
+	float* values = (float*) out;
+
+	if (f->out_vector.data_type != BNNSDataTypeFloat32)
+	{
+		values = (float*) bnns_workspace_get(f, ws, n * sizeof(float));
+		if (!values)
+			return -1;
+	}
+
+	bnns_to_float(in, f->in_vector.data_type, f->in_vector.data_scale, f->in_vector.data_bias, n, values);
+	bnns_activate(&f->activation, values, n);
+
+	if (values != out)
+		bnns_from_float(values, f->out_vector.data_type, f->out_vector.data_scale, f->out_vector.data_bias, n, out);
+	return 0;
+}
+
+BNNSFilter BNNSFilterCreateVectorActivationLayer(const BNNSVectorDescriptor *__in_desc, const BNNSVectorDescriptor *__out_desc, const BNNSActivation *__activation, const BNNSFilterParameters *__filter_params)
+{
+	if (!__in_desc || !__out_desc || !__activation)
+		return NULL;
+	if (__in_desc->size == 0 || __in_desc->size != __out_desc->size)
+		return NULL;
+	if (!bnns_io_type_supported(__in_desc->data_type) || !bnns_io_type_supported(__out_desc->data_type))
+		return NULL;
+	if (!bnns_activation_supported(__activation, true))
+		return NULL;
+
+	struct bnns_filter* f = bnns_filter_new(bnns_vector_activation, __filter_params);
+	if (!f)
+		return NULL;
+
+	f->in_vector = *__in_desc;
+	f->out_vector = *__out_desc;
+	f->activation = *__activation;
+	f->apply = vector_activation_apply;
+	return f;
+}
@@ -0,0 +1,157 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _BNNS_INTERNAL_H_
+#define _BNNS_INTERNAL_H_
+
+#include <BNNS/BNNS.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Filters compute in float whatever their data types are. Layer data is converted to float
+// when the filter is created, inputs and outputs of other types go through a float copy.
+// The heavy lifting is done by libBLAS' threaded SGEMM and by vForce.
+
+// A float image stack, value (x, y, c) is at data[x + y * row_stride + c * image_stride]
+struct bnns_image
+{
+	float* data;
+	size_t width;
+	size_t height;
+	size_t channels;
+	size_t row_stride;
+	size_t image_stride;
+};
+
+// Temporary memory that a thread reuses for all the batch items it processes
+struct bnns_workspace
+{
+	void* memory;
+	size_t size;
+};
+
+enum bnns_filter_kind
+{
+	bnns_convolution,
+	bnns_fully_connected,
+	bnns_pooling,
+	bnns_vector_activation,
+};
+
+struct bnns_filter
+{
+	enum bnns_filter_kind kind;
+	BNNSFilterParameters params;
+
+	// runs the filter on one batch item
+	int (*apply)(const struct bnns_filter* f, struct bnns_workspace* ws, const void* in, void* out);
+	// runs the filter on a whole batch, for filters that have a better way than item by item
+	int (*apply_batch)(const struct bnns_filter* f, size_t batch, const void* in, size_t in_stride, void* out, size_t out_stride);
+
+	BNNSImageStackDescriptor in_image;
+	BNNSImageStackDescriptor out_image;
+	BNNSVectorDescriptor in_vector;
+	BNNSVectorDescriptor out_vector;
+
+	// the layer's geometry, its layer data isn't used after creation
+	BNNSConvolutionLayerParameters conv;
+	BNNSFullyConnectedLayerParameters fc;
+	BNNSPoolingLayerParameters pool;
+	BNNSActivation activation;
+
+	// in the layouts described in BNNS.h, the bias is NULL if there is none
+	const float* weights;
+	const float* bias;
+	// Winograd F(2x2, 3x3) weights: 16 matrices of out_channels x in_channels, or NULL
+	float* winograd_weights;
+
+	// workspace bytes apply needs besides input and output conversions, and the number of
+	// output rows (or rows of Winograd tiles) it computes at once
+	size_t scratch_size;
+	size_t block_rows;
+
+	// what has to be freed with the filter
+	void* owned[3];
+};
+
+// Memory through the filter's allocator, 64-byte aligned
+void* bnns_alloc(const struct bnns_filter* f, size_t size);
+void bnns_free(const struct bnns_filter* f, void* ptr);
+// Memory that is freed with the filter
+void* bnns_alloc_owned(struct bnns_filter* f, size_t size);
+
+// Allocates a zeroed filter, NULL if filter_params has only one of the allocator functions
+struct bnns_filter* bnns_filter_new(enum bnns_filter_kind kind, const BNNSFilterParameters* filter_params);
+
+// At least `size` bytes from the workspace, growing it if needed
+void* bnns_workspace_get(const struct bnns_filter* f, struct bnns_workspace* ws, size_t size);
+
+// Rounds a byte count up so that workspace parts carved after it stay aligned
+#define BNNS_ALIGN(size) (((size) + 63) & ~(size_t) 63)
+
+// The number of positions of a window of k values moving by `stride` over `size` values
+// with `padding` zeros on both sides, 0 if the window doesn't fit
+static inline size_t bnns_window_count(size_t size, size_t padding, size_t k, size_t stride)
+{
+	return (size + 2 * padding < k) ? 0 : (size + 2 * padding - k) / stride + 1;
+}
+
+// The window positions [*lo, *hi) out of `count` for which element k of the window,
+// at pos * stride + k - padding, is inside the `size` values
+static inline void bnns_window_valid(size_t size, size_t padding, size_t k, size_t stride, size_t count, size_t* lo, size_t* hi)
+{
+	size_t l = (k < padding) ? (padding - k + stride - 1) / stride : 0;
+	size_t h = (size + padding <= k) ? 0 : (size + padding - k - 1) / stride + 1;
+
+	h = (h < count) ? h : count;
+	*lo = (l < h) ? l : h;
+	*hi = h;
+}
+
+// data.c
+size_t bnns_data_type_size(BNNSDataType type);
+bool bnns_io_type_supported(BNNSDataType type);
+
+// Converts `count` values of layer data to float. Returns the client's pointer if the data is
+// already float and the filter was asked to use it, otherwise newly allocated memory, which is
+// owned by the filter. NULL if the data can't be converted or there's no memory.
+const float* bnns_layer_data(struct bnns_filter* f, const BNNSLayerData* data, size_t count);
+
+void bnns_to_float(const void* src, BNNSDataType type, float scale, float bias, size_t count, float* dst);
+void bnns_from_float(const float* src, BNNSDataType type, float scale, float bias, size_t count, void* dst);
+
+bool bnns_image_valid(const BNNSImageStackDescriptor* desc);
+
+// Workspace bytes needed by bnns_image_in() or bnns_image_out()
+size_t bnns_image_scratch(const BNNSImageStackDescriptor* desc);
+// A float view of the input, converted into `scratch` unless it already is float
+void bnns_image_in(const BNNSImageStackDescriptor* desc, const void* data, float* scratch, struct bnns_image* view);
+// Where to compute the output, which is `data` itself if it's float
+void bnns_image_out(const BNNSImageStackDescriptor* desc, void* data, float* scratch, struct bnns_image* view);
+// Converts an output computed in the view from bnns_image_out() back to `data` if needed
+void bnns_image_store(const BNNSImageStackDescriptor* desc, const struct bnns_image* view, void* data);
+
+// activation.c
+bool bnns_activation_supported(const BNNSActivation* activation, bool vector);
+// Applies the activation to n values, softmax takes them as one vector
+void bnns_activate(const BNNSActivation* activation, float* x, size_t n);
+// Adds `bias` to each of the `rows` rows of n values and applies the activation to them
+void bnns_bias_activate(const BNNSActivation* activation, float* x, size_t rows, size_t n, size_t row_stride, float bias);
+
+#endif
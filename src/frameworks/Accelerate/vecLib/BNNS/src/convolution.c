@@ -0,0 +1,407 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <BLAS/BLAS.h>
+#include <limits.h>
+#include <string.h>
+
+// Convolutions are matrix products: with the weights as an out_channels x K matrix
+// (K = in_channels * k_height * k_width, which is how they're laid out already), each output
+// image is the weights times a K x (output pixels) matrix of input patches, built by im2col.
+// 3x3 kernels with unit strides use Winograd's F(2x2, 3x3) instead, which turns every 2x2
+// output tile into 16 products of 4x4 transformed tiles and cuts the multiplications by 2.25.
+
+// How much im2col and Winograd data to build before handing it to SGEMM
+#define CONV_BLOCK_BYTES (2 << 20)
+
+// Winograd needs enough channels for the transforms to cost less than what it saves
+#define WINOGRAD_MIN_CHANNELS 16
+
+static void conv_epilogue(const struct bnns_filter* f, const struct bnns_image* dst, size_t y0, size_t rows)
+{
+	if (!f->bias && f->activation.function == BNNSActivationFunctionIdentity)
+		return;
+
+	for (size_t o = 0; o < dst->channels; o++)
+	{
+		float* plane = dst->data + o * dst->image_stride + y0 * dst->row_stride;
+		bnns_bias_activate(&f->activation, plane, rows, dst->width, dst->row_stride, f->bias ? f->bias[o] : 0);
+	}
+}
+
+// Rows (c * k_height + ky) * k_width + kx of the patch matrix for output rows y0 ... y0 + rows - 1,
+// zero where the kernel reaches into the padding
+static void im2col(const struct bnns_filter* f, const struct bnns_image* src, size_t ow, size_t y0, size_t rows, float* col)
+{
+	const BNNSConvolutionLayerParameters* p = &f->conv;
+	const size_t n = rows * ow;
+
+	for (size_t c = 0; c < p->in_channels; c++)
+	{
+		const float* plane = src->data + c * src->image_stride;
+
+		for (size_t ky = 0; ky < p->k_height; ky++)
+		{
+			for (size_t kx = 0; kx < p->k_width; kx++)
+			{
+				float* row = col + ((c * p->k_height + ky) * p->k_width + kx) * n;
+				size_t lo, hi;
+
+				bnns_window_valid(src->width, p->x_padding, kx, p->x_stride, ow, &lo, &hi);
+
+				for (size_t r = 0; r < rows; r++)
+				{
+					const ptrdiff_t iy = (ptrdiff_t) ((y0 + r) * p->y_stride + ky) - (ptrdiff_t) p->y_padding;
+					float* out = row + r * ow;
+
+					if (iy < 0 || iy >= (ptrdiff_t) src->height)
+					{
+						memset(out, 0, ow * sizeof(float));
+						continue;
+					}
+
+					const float* in = plane + iy * src->row_stride + (ptrdiff_t) kx - (ptrdiff_t) p->x_padding;
+
+					memset(out, 0, lo * sizeof(float));
+					if (p->x_stride == 1)
+						memcpy(out + lo, in + lo, (hi - lo) * sizeof(float));
+					else
+					{
+						for (size_t x = lo; x < hi; x++)
+							out[x] = in[x * p->x_stride];
+					}
+					memset(out + hi, 0, (ow - hi) * sizeof(float));
+				}
+			}
+		}
+	}
+}
+
+static void conv_gemm(const struct bnns_filter* f, const struct bnns_image* src, const struct bnns_image* dst, float* work)
+{
+	const BNNSConvolutionLayerParameters* p = &f->conv;
+	const size_t ow = dst->width, oh = dst->height;
+	const size_t k = p->in_channels * p->k_height * p->k_width;
+
+	// a 1x1 kernel over a dense image needs no patches, the input planes are the matrix
+	if (k == p->in_channels && p->x_stride == 1 && p->y_stride == 1 && p->x_padding == 0 && p->y_padding == 0
+		&& src->row_stride == src->width && dst->row_stride == ow)
+	{
+		cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) p->out_channels, (int) (ow * oh), (int) k,
+			1.0f, f->weights, (int) k, src->data, (int) src->image_stride, 0.0f, dst->data, (int) dst->image_stride);
+		conv_epilogue(f, dst, 0, oh);
+		return;
+	}
+
+	for (size_t y0 = 0; y0 < oh; y0 += f->block_rows)
+	{
+		const size_t rows = (oh - y0 < f->block_rows) ? oh - y0 : f->block_rows;
+		const size_t n = rows * ow;
+		float* c = dst->data + y0 * dst->row_stride;
+		size_t ldc = dst->image_stride;
+
+		im2col(f, src, ow, y0, rows, work);
+
+		// the product's rows have to be contiguous
+		if (dst->row_stride != ow)
+		{
+			c = work + k * f->block_rows * ow;
+			ldc = n;
+		}
+
+		cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) p->out_channels, (int) n, (int) k,
+			1.0f, f->weights, (int) k, work, (int) n, 0.0f, c, (int) ldc);
+
+		if (dst->row_stride != ow)
+		{
+			for (size_t o = 0; o < p->out_channels; o++)
+			{
+				for (size_t r = 0; r < rows; r++)
+					memcpy(dst->data + o * dst->image_stride + (y0 + r) * dst->row_stride, c + o * n + r * ow, ow * sizeof(float));
+			}
+		}
+
+		conv_epilogue(f, dst, y0, rows);
+	}
+}
+
+// U = G g G^T for every 3x3 kernel g, stored as 16 out_channels x in_channels matrices
+static void winograd_weights(const struct bnns_filter* f, float* u)
+{
+	const size_t ic = f->conv.in_channels, oc = f->conv.out_channels;
+
+	for (size_t o = 0; o < oc; o++)
+	{
+		for (size_t i = 0; i < ic; i++)
+		{
+			const float* g = f->weights + (o * ic + i) * 9;
+			float t[4][3];
+
+			for (int x = 0; x < 3; x++)
+			{
+				t[0][x] = g[x];
+				t[1][x] = 0.5f * (g[x] + g[3 + x] + g[6 + x]);
+				t[2][x] = 0.5f * (g[x] - g[3 + x] + g[6 + x]);
+				t[3][x] = g[6 + x];
+			}
+
+			for (int a = 0; a < 4; a++)
+			{
+				float* out = u + (a * 4) * oc * ic + o * ic + i;
+				out[0] = t[a][0];
+				out[oc * ic] = 0.5f * (t[a][0] + t[a][1] + t[a][2]);
+				out[2 * oc * ic] = 0.5f * (t[a][0] - t[a][1] + t[a][2]);
+				out[3 * oc * ic] = t[a][2];
+			}
+		}
+	}
+}
+
+// V = B^T d B for the 4x4 input tile d of every channel and 2x2 output tile in tile rows
+// ty0 ... ty0 + trows - 1, stored as 16 in_channels x (tiles) matrices
+static void winograd_input(const struct bnns_filter* f, const struct bnns_image* src, size_t tw, size_t ty0, size_t trows, float* v)
+{
+	const size_t ic = f->conv.in_channels;
+	const size_t tiles = tw * trows;
+	const ptrdiff_t px = f->conv.x_padding, py = f->conv.y_padding;
+	const ptrdiff_t width = src->width, height = src->height;
+
+	for (size_t c = 0; c < ic; c++)
+	{
+		const float* plane = src->data + c * src->image_stride;
+
+		for (size_t ty = 0; ty < trows; ty++)
+		{
+			const ptrdiff_t y = 2 * (ptrdiff_t) (ty0 + ty) - py;
+
+			for (size_t tx = 0; tx < tw; tx++)
+			{
+				const ptrdiff_t x = 2 * (ptrdiff_t) tx - px;
+				float d[4][4], t[4][4];
+
+				if (x >= 0 && y >= 0 && x + 4 <= width && y + 4 <= height)
+				{
+					for (int r = 0; r < 4; r++)
+						memcpy(d[r], plane + (y + r) * src->row_stride + x, 4 * sizeof(float));
+				}
+				else
+				{
+					for (int r = 0; r < 4; r++)
+					{
+						for (int s = 0; s < 4; s++)
+						{
+							const bool inside = y + r >= 0 && y + r < height && x + s >= 0 && x + s < width;
+							d[r][s] = inside ? plane[(y + r) * src->row_stride + x + s] : 0;
+						}
+					}
+				}
+
+				for (int s = 0; s < 4; s++)
+				{
+					t[0][s] = d[0][s] - d[2][s];
+					t[1][s] = d[1][s] + d[2][s];
+					t[2][s] = d[2][s] - d[1][s];
+					t[3][s] = d[1][s] - d[3][s];
+				}
+
+				float* out = v + c * tiles + ty * tw + tx;
+				for (int a = 0; a < 4; a++)
+				{
+					out[(a * 4 + 0) * ic * tiles] = t[a][0] - t[a][2];
+					out[(a * 4 + 1) * ic * tiles] = t[a][1] + t[a][2];
+					out[(a * 4 + 2) * ic * tiles] = t[a][2] - t[a][1];
+					out[(a * 4 + 3) * ic * tiles] = t[a][1] - t[a][3];
+				}
+			}
+		}
+	}
+}
+
+// Y = A^T m A for the 4x4 products m of every output channel and tile
+static void winograd_output(const struct bnns_filter* f, const float* m, size_t tw, size_t ty0, size_t trows, const struct bnns_image* dst)
+{
+	const size_t oc = f->conv.out_channels;
+	const size_t tiles = tw * trows;
+
+	for (size_t o = 0; o < oc; o++)
+	{
+		float* plane = dst->data + o * dst->image_stride;
+
+		for (size_t ty = 0; ty < trows; ty++)
+		{
+			const size_t y = 2 * (ty0 + ty);
+			const size_t rows = (dst->height - y < 2) ? 1 : 2;
+
+			for (size_t tx = 0; tx < tw; tx++)
+			{
+				const size_t x = 2 * tx;
+				const float* in = m + o * tiles + ty * tw + tx;
+				float s[2][4];
+
+				for (int b = 0; b < 4; b++)
+				{
+					const float m0 = in[b * oc * tiles], m1 = in[(4 + b) * oc * tiles];
+					const float m2 = in[(8 + b) * oc * tiles], m3 = in[(12 + b) * oc * tiles];
+					s[0][b] = m0 + m1 + m2;
+					s[1][b] = m1 - m2 - m3;
+				}
+
+				for (size_t r = 0; r < rows; r++)
+				{
+					float* out = plane + (y + r) * dst->row_stride + x;
+					out[0] = s[r][0] + s[r][1] + s[r][2];
+					if (x + 1 < dst->width)
+						out[1] = s[r][1] - s[r][2] - s[r][3];
+				}
+			}
+		}
+	}
+}
+
+static void conv_winograd(const struct bnns_filter* f, const struct bnns_image* src, const struct bnns_image* dst, float* work)
+{
+	const size_t ic = f->conv.in_channels, oc = f->conv.out_channels;
+	const size_t tw = (dst->width + 1) / 2, th = (dst->height + 1) / 2;
+
+	for (size_t ty0 = 0; ty0 < th; ty0 += f->block_rows)
+	{
+		const size_t trows = (th - ty0 < f->block_rows) ? th - ty0 : f->block_rows;
+		const size_t tiles = tw * trows;
+		float* v = work;
+		float* m = work + 16 * ic * tw * f->block_rows;
+
+		winograd_input(f, src, tw, ty0, trows, v);
+
+		for (int pos = 0; pos < 16; pos++)
+		{
+			cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, (int) oc, (int) tiles, (int) ic,
+				1.0f, f->winograd_weights + pos * oc * ic, (int) ic, v + pos * ic * tiles, (int) tiles,
+				0.0f, m + pos * oc * tiles, (int) tiles);
+		}
+
+		winograd_output(f, m, tw, ty0, trows, dst);
+
+		const size_t y0 = 2 * ty0;
+		const size_t rows = (dst->height - y0 < 2 * trows) ? dst->height - y0 : 2 * trows;
+		conv_epilogue(f, dst, y0, rows);
+	}
+}
+
+static int conv_apply(const struct bnns_filter* f, struct bnns_workspace* ws, const void* in, void* out)
+{
+	const size_t in_part = bnns_image_scratch(&f->in_image);
+	const size_t out_part = bnns_image_scratch(&f->out_image);
+	struct bnns_image src, dst;
+
+	char* memory = (char*) bnns_workspace_get(f, ws, in_part + out_part + f->scratch_size);
+	if (!memory)
+		return -1;
+
+	bnns_image_in(&f->in_image, in, (float*) memory, &src);
+	bnns_image_out(&f->out_image, out, (float*) (memory + in_part), &dst);
+
+	float* work = (float*) (memory + in_part + out_part);
+	if (f->winograd_weights)
+		conv_winograd(f, &src, &dst, work);
+	else
+		conv_gemm(f, &src, &dst, work);
+
+	bnns_image_store(&f->out_image, &dst, out);
+	return 0;
+}
+
+BNNSFilter BNNSFilterCreateConvolutionLayer(const BNNSImageStackDescriptor *__in_desc, const BNNSImageStackDescriptor *__out_desc, const BNNSConvolutionLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params)
+{
+	if (!__in_desc || !__out_desc || !__layer_params)
+		return NULL;
+
+	const BNNSConvolutionLayerParameters* p = __layer_params;
+
+	if (!bnns_image_valid(__in_desc) || !bnns_image_valid(__out_desc))
+		return NULL;
+	if (p->x_stride == 0 || p->y_stride == 0 || p->k_width == 0 || p->k_height == 0)
+		return NULL;
+	if (__in_desc->channels != p->in_channels || __out_desc->channels != p->out_channels)
+		return NULL;
+	if (__out_desc->width != bnns_window_count(__in_desc->width, p->x_padding, p->k_width, p->x_stride)
+		|| __out_desc->height != bnns_window_count(__in_desc->height, p->y_padding, p->k_height, p->y_stride))
+		return NULL;
+	if (!bnns_activation_supported(&p->activation, false))
+		return NULL;
+
+	// SGEMM takes int dimensions
+	const size_t k = p->in_channels * p->k_height * p->k_width;
+	const size_t pixels = __out_desc->width * __out_desc->height;
+	if (k > INT_MAX || pixels > INT_MAX || p->out_channels > INT_MAX || __in_desc->image_stride > INT_MAX
+		|| __out_desc->image_stride > INT_MAX)
+		return NULL;
+
+	struct bnns_filter* f = bnns_filter_new(bnns_convolution, __filter_params);
+	if (!f)
+		return NULL;
+
+	f->in_image = *__in_desc;
+	f->out_image = *__out_desc;
+	f->conv = *p;
+	f->activation = p->activation;
+	f->apply = conv_apply;
+
+	f->weights = bnns_layer_data(f, &p->weights, k * p->out_channels);
+	if (p->bias.data)
+		f->bias = bnns_layer_data(f, &p->bias, p->out_channels);
+
+	if (!f->weights || (p->bias.data && !f->bias))
+		goto fail;
+
+	const size_t ow = __out_desc->width;
+	const bool winograd = p->k_width == 3 && p->k_height == 3 && p->x_stride == 1 && p->y_stride == 1
+		&& p->in_channels >= WINOGRAD_MIN_CHANNELS && p->out_channels >= WINOGRAD_MIN_CHANNELS;
+
+	if (winograd)
+	{
+		const size_t tw = (ow + 1) / 2, th = (__out_desc->height + 1) / 2;
+		const size_t row_bytes = 16 * (p->in_channels + p->out_channels) * tw * sizeof(float);
+
+		f->winograd_weights = (float*) bnns_alloc_owned(f, 16 * p->in_channels * p->out_channels * sizeof(float));
+		if (!f->winograd_weights)
+			goto fail;
+		winograd_weights(f, f->winograd_weights);
+
+		f->block_rows = CONV_BLOCK_BYTES / row_bytes;
+		f->block_rows = (f->block_rows < 1) ? 1 : (f->block_rows > th) ? th : f->block_rows;
+		f->scratch_size = f->block_rows * row_bytes;
+	}
+	else
+	{
+		// the output rows computed at once, plus room for the product if they aren't contiguous
+		const bool dense_out = __out_desc->data_type != BNNSDataTypeFloat32 || __out_desc->row_stride == ow;
+		const size_t row_bytes = (k + (dense_out ? 0 : p->out_channels)) * ow * sizeof(float);
+
+		f->block_rows = CONV_BLOCK_BYTES / row_bytes;
+		f->block_rows = (f->block_rows < 1) ? 1 : (f->block_rows > __out_desc->height) ? __out_desc->height : f->block_rows;
+		f->scratch_size = f->block_rows * row_bytes;
+	}
+
+	return f;
+
+fail:
+	BNNSFilterDestroy(f);
+	return NULL;
+}
@@ -0,0 +1,289 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+size_t bnns_data_type_size(BNNSDataType type)
+{
+	return (type & 0xff) / 8;
+}
+
+bool bnns_io_type_supported(BNNSDataType type)
+{
+	switch (type)
+	{
+		case BNNSDataTypeFloat16:
+		case BNNSDataTypeFloat32:
+		case BNNSDataTypeInt8:
+		case BNNSDataTypeInt16:
+		case BNNSDataTypeInt32:
+		case BNNSDataTypeUInt8:
+		case BNNSDataTypeUInt16:
+		case BNNSDataTypeUInt32:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static float half_to_float(uint16_t h)
+{
+	const uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+	const uint32_t exp = (h >> 10) & 0x1f;
+	const uint32_t mant = h & 0x3ff;
+	uint32_t bits;
+	float value;
+
+	if (exp == 0x1f)
+		bits = sign | 0x7f800000 | (mant << 13);
+	else if (exp != 0)
+		bits = sign | ((exp + 112) << 23) | (mant << 13);
+	else
+	{
+		// zero or subnormal, mant * 2^-24
+		value = (float) mant * 0x1p-24f;
+		return sign ? -value : value;
+	}
+
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// Rounds to nearest even
+static uint16_t float_to_half(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	const uint16_t sign = (bits >> 16) & 0x8000;
+	const uint32_t abs = bits & 0x7fffffff;
+
+	// infinities and NaNs, and whatever rounds to 65536 or more
+	if (abs > 0x7f800000)
+		return sign | 0x7e00;
+	if (abs >= 0x477ff000)
+		return sign | 0x7c00;
+
+	// below 2^-14 the result is subnormal, a multiple of 2^-24
+	if (abs < 0x38800000)
+	{
+		float a;
+		memcpy(&a, &abs, sizeof(a));
+		return sign | (uint16_t) nearbyintf(a * 0x1p24f);
+	}
+
+	uint32_t h = (abs - 0x38000000) >> 13;
+	const uint32_t rest = abs & 0x1fff;
+	if (rest > 0x1000 || (rest == 0x1000 && (h & 1)))
+		h++;
+	return sign | (uint16_t) h;
+}
+
+#define TO_FLOAT(ctype) \
+	do { \
+		const ctype* s = (const ctype*) src; \
+		for (size_t i = 0; i < count; i++) \
+			dst[i] = scale * (float) s[i] + bias; \
+	} while (0)
+
+void bnns_to_float(const void* src, BNNSDataType type, float scale, float bias, size_t count, float* dst)
+{
+	switch (type)
+	{
+		case BNNSDataTypeFloat32:
+			memmove(dst, src, count * sizeof(float));
+			break;
+		case BNNSDataTypeFloat16:
+			for (size_t i = 0; i < count; i++)
+				dst[i] = half_to_float(((const uint16_t*) src)[i]);
+			break;
+		case BNNSDataTypeInt8: TO_FLOAT(int8_t); break;
+		case BNNSDataTypeInt16: TO_FLOAT(int16_t); break;
+		case BNNSDataTypeInt32: TO_FLOAT(int32_t); break;
+		case BNNSDataTypeUInt8: TO_FLOAT(uint8_t); break;
+		case BNNSDataTypeUInt16: TO_FLOAT(uint16_t); break;
+		case BNNSDataTypeUInt32: TO_FLOAT(uint32_t); break;
+		default:
+			break;
+	}
+}
+
+// Integers are rounded to nearest and saturated, NaN becomes 0
+#define FROM_FLOAT(ctype, lo, hi) \
+	do { \
+		ctype* d = (ctype*) dst; \
+		for (size_t i = 0; i < count; i++) \
+		{ \
+			const double v = nearbyint(((double) src[i] - bias) / scale); \
+			d[i] = (v >= (hi)) ? (hi) : (v <= (lo)) ? (lo) : (v == v) ? (ctype) v : 0; \
+		} \
+	} while (0)
+
+void bnns_from_float(const float* src, BNNSDataType type, float scale, float bias, size_t count, void* dst)
+{
+	switch (type)
+	{
+		case BNNSDataTypeFloat32:
+			memmove(dst, src, count * sizeof(float));
+			break;
+		case BNNSDataTypeFloat16:
+			for (size_t i = 0; i < count; i++)
+				((uint16_t*) dst)[i] = float_to_half(src[i]);
+			break;
+		case BNNSDataTypeInt8: FROM_FLOAT(int8_t, INT8_MIN, INT8_MAX); break;
+		case BNNSDataTypeInt16: FROM_FLOAT(int16_t, INT16_MIN, INT16_MAX); break;
+		case BNNSDataTypeInt32: FROM_FLOAT(int32_t, INT32_MIN, INT32_MAX); break;
+		case BNNSDataTypeUInt8: FROM_FLOAT(uint8_t, 0, UINT8_MAX); break;
+		case BNNSDataTypeUInt16: FROM_FLOAT(uint16_t, 0, UINT16_MAX); break;
+		case BNNSDataTypeUInt32: FROM_FLOAT(uint32_t, 0, UINT32_MAX); break;
+		default:
+			break;
+	}
+}
+
+int BNNSDequantize(const BNNSLayerData *__in, float *__out, size_t __count)
+{
+	if (!__in || !__in->data || !__out)
+		return -1;
+
+	if (__in->data_type == BNNSDataTypeIndexed8)
+	{
+		const uint8_t* index = (const uint8_t*) __in->data;
+
+		if (!__in->data_table)
+			return -1;
+		for (size_t i = 0; i < __count; i++)
+			__out[i] = __in->data_table[index[i]];
+		return 0;
+	}
+
+	if (!bnns_io_type_supported(__in->data_type))
+		return -1;
+
+	bnns_to_float(__in->data, __in->data_type, __in->data_scale, __in->data_bias, __count, __out);
+	return 0;
+}
+
+const float* bnns_layer_data(struct bnns_filter* f, const BNNSLayerData* data, size_t count)
+{
+	if (!data->data)
+		return NULL;
+	if (data->data_type == BNNSDataTypeFloat32 && (f->params.flags & BNNSFlagsUseClientPtr))
+		return (const float*) data->data;
+
+	if (data->data_type == BNNSDataTypeIndexed8 ? !data->data_table : !bnns_io_type_supported(data->data_type))
+		return NULL;
+
+	float* values = (float*) bnns_alloc_owned(f, count * sizeof(float));
+	if (!values)
+		return NULL;
+
+	BNNSDequantize(data, values, count);
+	return values;
+}
+
+bool bnns_image_valid(const BNNSImageStackDescriptor* desc)
+{
+	if (desc->width == 0 || desc->height == 0 || desc->channels == 0)
+		return false;
+	if (desc->row_stride < desc->width)
+		return false;
+	if (desc->channels > 1 && desc->image_stride < desc->row_stride * (desc->height - 1) + desc->width)
+		return false;
+	return bnns_io_type_supported(desc->data_type);
+}
+
+size_t bnns_image_scratch(const BNNSImageStackDescriptor* desc)
+{
+	if (desc->data_type == BNNSDataTypeFloat32)
+		return 0;
+	return BNNS_ALIGN(desc->width * desc->height * desc->channels * sizeof(float));
+}
+
+static void dense_view(const BNNSImageStackDescriptor* desc, float* data, struct bnns_image* view)
+{
+	view->data = data;
+	view->width = desc->width;
+	view->height = desc->height;
+	view->channels = desc->channels;
+	view->row_stride = desc->width;
+	view->image_stride = desc->width * desc->height;
+}
+
+// The image stride of a single image doesn't matter to the caller, but SGEMM wants a real one
+static size_t image_stride(const BNNSImageStackDescriptor* desc)
+{
+	return (desc->channels > 1) ? desc->image_stride : desc->row_stride * desc->height;
+}
+
+void bnns_image_in(const BNNSImageStackDescriptor* desc, const void* data, float* scratch, struct bnns_image* view)
+{
+	if (desc->data_type == BNNSDataTypeFloat32)
+	{
+		view->data = (float*) data;
+		view->width = desc->width;
+		view->height = desc->height;
+		view->channels = desc->channels;
+		view->row_stride = desc->row_stride;
+		view->image_stride = image_stride(desc);
+		return;
+	}
+
+	const size_t size = bnns_data_type_size(desc->data_type);
+	dense_view(desc, scratch, view);
+
+	for (size_t c = 0; c < desc->channels; c++)
+	{
+		for (size_t y = 0; y < desc->height; y++)
+		{
+			const char* src = (const char*) data + (c * desc->image_stride + y * desc->row_stride) * size;
+			float* dst = scratch + c * view->image_stride + y * view->row_stride;
+			bnns_to_float(src, desc->data_type, desc->data_scale, desc->data_bias, desc->width, dst);
+		}
+	}
+}
+
+void bnns_image_out(const BNNSImageStackDescriptor* desc, void* data, float* scratch, struct bnns_image* view)
+{
+	if (desc->data_type == BNNSDataTypeFloat32)
+		bnns_image_in(desc, data, NULL, view);
+	else
+		dense_view(desc, scratch, view);
+}
+
+void bnns_image_store(const BNNSImageStackDescriptor* desc, const struct bnns_image* view, void* data)
+{
+	if (desc->data_type == BNNSDataTypeFloat32)
+		return;
+
+	const size_t size = bnns_data_type_size(desc->data_type);
+
+	for (size_t c = 0; c < desc->channels; c++)
+	{
+		for (size_t y = 0; y < desc->height; y++)
+		{
+			const float* src = view->data + c * view->image_stride + y * view->row_stride;
+			char* dst = (char*) data + (c * desc->image_stride + y * desc->row_stride) * size;
+			bnns_from_float(src, desc->data_type, desc->data_scale, desc->data_bias, desc->width, dst);
+		}
+	}
+}
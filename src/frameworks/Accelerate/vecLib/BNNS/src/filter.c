@@ -0,0 +1,208 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <dispatch/dispatch.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void* bnns_alloc(const struct bnns_filter* f, size_t size)
+{
+	void* memory;
+
+	if (size == 0)
+		size = 1;
+
+	if (f->params.alloc_memory)
+	{
+		if (f->params.alloc_memory(&memory, 64, size) != 0)
+			return NULL;
+	}
+	else if (posix_memalign(&memory, 64, size) != 0)
+		return NULL;
+
+	return memory;
+}
+
+void* bnns_alloc_owned(struct bnns_filter* f, size_t size)
+{
+	int slot = 0;
+
+	while (slot < sizeof(f->owned) / sizeof(f->owned[0]) && f->owned[slot])
+		slot++;
+	if (slot == sizeof(f->owned) / sizeof(f->owned[0]))
+		return NULL;
+
+	f->owned[slot] = bnns_alloc(f, size);
+	return f->owned[slot];
+}
+
+void bnns_free(const struct bnns_filter* f, void* ptr)
+{
+	if (!ptr)
+		return;
+
+	if (f->params.free_memory)
+		f->params.free_memory(ptr);
+	else
+		free(ptr);
+}
+
+struct bnns_filter* bnns_filter_new(enum bnns_filter_kind kind, const BNNSFilterParameters* filter_params)
+{
+	BNNSFilterParameters params = { 0 };
+
+	if (filter_params)
+		params = *filter_params;
+	if (!params.alloc_memory != !params.free_memory)
+		return NULL;
+
+	// the allocator has to be known before the filter itself can be allocated
+	struct bnns_filter tmp = { .params = params };
+	struct bnns_filter* f = (struct bnns_filter*) bnns_alloc(&tmp, sizeof(*f));
+	if (!f)
+		return NULL;
+
+	memset(f, 0, sizeof(*f));
+	f->kind = kind;
+	f->params = params;
+	return f;
+}
+
+void* bnns_workspace_get(const struct bnns_filter* f, struct bnns_workspace* ws, size_t size)
+{
+	if (ws->memory && ws->size >= size)
+		return ws->memory;
+
+	bnns_free(f, ws->memory);
+	ws->memory = bnns_alloc(f, size);
+	ws->size = ws->memory ? size : 0;
+	return ws->memory;
+}
+
+void BNNSFilterDestroy(BNNSFilter __filter)
+{
+	struct bnns_filter* f = (struct bnns_filter*) __filter;
+
+	if (!f)
+		return;
+
+	for (int i = 0; i < sizeof(f->owned) / sizeof(f->owned[0]); i++)
+		bnns_free(f, f->owned[i]);
+	bnns_free(f, f);
+}
+
+int BNNSFilterApply(BNNSFilter __filter, const void *__in, void *__out)
+{
+	return BNNSFilterApplyBatch(__filter, 1, __in, 0, __out, 0);
+}
+
+// The number of threads a batch is split across, following vecLib's documented knob
+static size_t default_threads(void)
+{
+	static atomic_size_t count = 0;
+	size_t n = atomic_load_explicit(&count, memory_order_relaxed);
+
+	if (n == 0)
+	{
+		const char* env = getenv("VECLIB_MAXIMUM_THREADS");
+		long value = env ? strtol(env, NULL, 10) : 0;
+
+		if (value <= 0)
+			value = sysconf(_SC_NPROCESSORS_ONLN);
+		n = (value > 0) ? (size_t) value : 1;
+		atomic_store_explicit(&count, n, memory_order_relaxed);
+	}
+
+	return n;
+}
+
+struct batch_job
+{
+	const struct bnns_filter* filter;
+	size_t batch;
+	size_t tasks;
+	const char* in;
+	size_t in_step;
+	char* out;
+	size_t out_step;
+	atomic_bool failed;
+};
+
+// Each task takes a contiguous range of items and reuses one workspace for all of them
+static void batch_task(void* ctx, size_t task)
+{
+	struct batch_job* job = (struct batch_job*) ctx;
+	const struct bnns_filter* f = job->filter;
+	const size_t first = job->batch * task / job->tasks;
+	const size_t last = job->batch * (task + 1) / job->tasks;
+	struct bnns_workspace ws = { NULL, 0 };
+
+	for (size_t i = first; i < last; i++)
+	{
+		if (f->apply(f, &ws, job->in + i * job->in_step, job->out + i * job->out_step) != 0)
+		{
+			atomic_store_explicit(&job->failed, true, memory_order_relaxed);
+			break;
+		}
+	}
+
+	bnns_free(f, ws.memory);
+}
+
+int BNNSFilterApplyBatch(BNNSFilter __filter, size_t __batch_size, const void *__in, size_t __in_stride, void *__out, size_t __out_stride)
+{
+	const struct bnns_filter* f = (const struct bnns_filter*) __filter;
+
+	if (!f || !__in || !__out)
+		return -1;
+	if (__batch_size == 0)
+		return 0;
+
+	if (f->apply_batch)
+		return f->apply_batch(f, __batch_size, __in, __in_stride, __out, __out_stride);
+
+	const bool vectors = f->kind == bnns_fully_connected || f->kind == bnns_vector_activation;
+	const BNNSDataType in_type = vectors ? f->in_vector.data_type : f->in_image.data_type;
+	const BNNSDataType out_type = vectors ? f->out_vector.data_type : f->out_image.data_type;
+
+	struct batch_job job = {
+		.filter = f,
+		.batch = __batch_size,
+		.in = (const char*) __in,
+		.in_step = __in_stride * bnns_data_type_size(in_type),
+		.out = (char*) __out,
+		.out_step = __out_stride * bnns_data_type_size(out_type),
+	};
+
+	size_t threads = f->params.n_threads ? f->params.n_threads : default_threads();
+	job.tasks = (threads < __batch_size) ? threads : __batch_size;
+	atomic_init(&job.failed, false);
+
+	// the items are independent, GEMMs running in different tasks each try libBLAS' pool and
+	// only one gets it, the others run on their task's thread
+	if (job.tasks > 1)
+		dispatch_apply_f(job.tasks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), &job, batch_task);
+	else
+		batch_task(&job, 0);
+
+	return atomic_load(&job.failed) ? -1 : 0;
+}
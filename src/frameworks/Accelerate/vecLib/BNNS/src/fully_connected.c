@@ -0,0 +1,139 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <BLAS/BLAS.h>
+#include <limits.h>
+
+// The whole batch is a single product: out (batch x out_size) = in (batch x in_size) * W^T,
+// which libBLAS spreads across its threads
+static int fc_apply_batch(const struct bnns_filter* f, size_t batch, const void* in, size_t in_stride, void* out, size_t out_stride)
+{
+	const size_t n_in = f->fc.in_size, n_out = f->fc.out_size;
+	const BNNSVectorDescriptor* in_desc = &f->in_vector;
+	const BNNSVectorDescriptor* out_desc = &f->out_vector;
+	const bool in_float = in_desc->data_type == BNNSDataTypeFloat32;
+	const bool out_float = out_desc->data_type == BNNSDataTypeFloat32;
+
+	if (batch > 1 && (in_stride < n_in || out_stride < n_out))
+		return -1;
+	if (batch > INT_MAX || in_stride > INT_MAX || out_stride > INT_MAX)
+		return -1;
+
+	const float* a = (const float*) in;
+	float* c = (float*) out;
+	size_t lda = in_stride, ldc = out_stride;
+	float* scratch = NULL;
+
+	if (!in_float || !out_float)
+	{
+		const size_t in_part = in_float ? 0 : BNNS_ALIGN(batch * n_in * sizeof(float));
+		const size_t out_part = out_float ? 0 : batch * n_out * sizeof(float);
+
+		scratch = (float*) bnns_alloc(f, in_part + out_part);
+		if (!scratch)
+			return -1;
+
+		if (!in_float)
+		{
+			const size_t size = bnns_data_type_size(in_desc->data_type);
+			for (size_t b = 0; b < batch; b++)
+			{
+				bnns_to_float((const char*) in + b * in_stride * size, in_desc->data_type,
+					in_desc->data_scale, in_desc->data_bias, n_in, scratch + b * n_in);
+			}
+			a = scratch;
+			lda = n_in;
+		}
+		if (!out_float)
+		{
+			c = (float*) ((char*) scratch + in_part);
+			ldc = n_out;
+		}
+	}
+
+	if (batch == 1)
+		cblas_sgemv(CblasRowMajor, CblasNoTrans, (int) n_out, (int) n_in, 1.0f, f->weights, (int) n_in, a, 1, 0.0f, c, 1);
+	else
+	{
+		cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, (int) batch, (int) n_out, (int) n_in,
+			1.0f, a, (int) lda, f->weights, (int) n_in, 0.0f, c, (int) ldc);
+	}
+
+	for (size_t b = 0; b < batch; b++)
+	{
+		float* row = c + b * ldc;
+
+		if (f->bias)
+		{
+			for (size_t o = 0; o < n_out; o++)
+				row[o] += f->bias[o];
+		}
+		bnns_activate(&f->activation, row, n_out);
+
+		if (!out_float)
+		{
+			const size_t size = bnns_data_type_size(out_desc->data_type);
+			bnns_from_float(row, out_desc->data_type, out_desc->data_scale, out_desc->data_bias, n_out,
+				(char*) out + b * out_stride * size);
+		}
+	}
+
+	bnns_free(f, scratch);
+	return 0;
+}
+
+BNNSFilter BNNSFilterCreateFullyConnectedLayer(const BNNSVectorDescriptor *__in_desc, const BNNSVectorDescriptor *__out_desc, const BNNSFullyConnectedLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params)
+{
+	if (!__in_desc || !__out_desc || !__layer_params)
+		return NULL;
+
+	const BNNSFullyConnectedLayerParameters* p = __layer_params;
+
+	if (p->in_size == 0 || p->out_size == 0 || p->in_size > INT_MAX || p->out_size > INT_MAX)
+		return NULL;
+	if (__in_desc->size != p->in_size || __out_desc->size != p->out_size)
+		return NULL;
+	if (!bnns_io_type_supported(__in_desc->data_type) || !bnns_io_type_supported(__out_desc->data_type))
+		return NULL;
+	if (!bnns_activation_supported(&p->activation, true))
+		return NULL;
+
+	struct bnns_filter* f = bnns_filter_new(bnns_fully_connected, __filter_params);
+	if (!f)
+		return NULL;
+
+	f->in_vector = *__in_desc;
+	f->out_vector = *__out_desc;
+	f->fc = *p;
+	f->activation = p->activation;
+	f->apply_batch = fc_apply_batch;
+
+	f->weights = bnns_layer_data(f, &p->weights, p->in_size * p->out_size);
+	if (p->bias.data)
+		f->bias = bnns_layer_data(f, &p->bias, p->out_size);
+
+	if (!f->weights || (p->bias.data && !f->bias))
+	{
+		BNNSFilterDestroy(f);
+		return NULL;
+	}
+
+	return f;
+}
@@ -0,0 +1,170 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bnns_internal.h"
+#include <math.h>
+#include <string.h>
+
+// Each output row is accumulated from the window's input rows, one kernel column at a time,
+// so that the inner loops run along the row. The padding takes part in neither the maximum
+// nor the average: the average divides by the number of inputs inside the window. Outputs
+// whose window lies entirely in the padding are 0.
+
+static void pool_row(const struct bnns_filter* f, const struct bnns_image* src, const float* plane, size_t oy, float* out, size_t ow)
+{
+	const BNNSPoolingLayerParameters* p = &f->pool;
+	const bool max = p->pooling_function == BNNSPoolingFunctionMax;
+	size_t y_lo, y_hi, x_lo, x_hi;
+
+	// the input rows in the window, and the outputs that see at least one input column
+	const ptrdiff_t y0 = (ptrdiff_t) (oy * p->y_stride) - (ptrdiff_t) p->y_padding;
+	const ptrdiff_t y1 = y0 + (ptrdiff_t) p->k_height;
+	y_lo = (y0 < 0) ? 0 : (size_t) y0;
+	y_hi = (y1 < 0) ? 0 : (y1 > (ptrdiff_t) src->height) ? src->height : (size_t) y1;
+	if (y_hi < y_lo)
+		y_hi = y_lo;
+
+	size_t any_lo, any_hi, unused;
+	bnns_window_valid(src->width, p->x_padding, p->k_width - 1, p->x_stride, ow, &any_lo, &unused);
+	bnns_window_valid(src->width, p->x_padding, 0, p->x_stride, ow, &unused, &any_hi);
+
+	for (size_t x = 0; x < ow; x++)
+		out[x] = max ? -INFINITY : 0;
+
+	for (size_t iy = y_lo; iy < y_hi; iy++)
+	{
+		const float* row = plane + iy * src->row_stride;
+
+		for (size_t kx = 0; kx < p->k_width; kx++)
+		{
+			const float* in = row + (ptrdiff_t) kx - (ptrdiff_t) p->x_padding;
+
+			bnns_window_valid(src->width, p->x_padding, kx, p->x_stride, ow, &x_lo, &x_hi);
+
+			if (max)
+			{
+				for (size_t x = x_lo; x < x_hi; x++)
+					out[x] = fmaxf(out[x], in[x * p->x_stride]);
+			}
+			else
+			{
+				for (size_t x = x_lo; x < x_hi; x++)
+					out[x] += in[x * p->x_stride];
+			}
+		}
+	}
+
+	if (max)
+	{
+		if (y_lo >= y_hi)
+			any_hi = any_lo;
+		for (size_t x = 0; x < ow; x++)
+		{
+			if (x < any_lo || x >= any_hi)
+				out[x] = 0;
+		}
+	}
+	else
+	{
+		// divide by the inputs in the window: the valid rows times the valid columns
+		const size_t rows = y_hi - y_lo;
+		for (size_t x = 0; x < ow; x++)
+		{
+			const ptrdiff_t x0 = (ptrdiff_t) (x * p->x_stride) - (ptrdiff_t) p->x_padding;
+			const ptrdiff_t x1 = x0 + (ptrdiff_t) p->k_width;
+			const ptrdiff_t cols = ((x1 > (ptrdiff_t) src->width) ? (ptrdiff_t) src->width : x1) - ((x0 < 0) ? 0 : x0);
+			const size_t count = (cols > 0) ? rows * (size_t) cols : 0;
+
+			out[x] = count ? out[x] / (float) count : 0;
+		}
+	}
+}
+
+static int pool_apply(const struct bnns_filter* f, struct bnns_workspace* ws, const void* in, void* out)
+{
+	const size_t in_part = bnns_image_scratch(&f->in_image);
+	const size_t out_part = bnns_image_scratch(&f->out_image);
+	struct bnns_image src, dst;
+
+	char* memory = (char*) bnns_workspace_get(f, ws, in_part + out_part);
+	if (!memory)
+		return -1;
+
+	bnns_image_in(&f->in_image, in, (float*) memory, &src);
+	bnns_image_out(&f->out_image, out, (float*) (memory + in_part), &dst);
+
+	for (size_t c = 0; c < dst.channels; c++)
+	{
+		const float* plane = src.data + c * src.image_stride;
+		float* out_plane = dst.data + c * dst.image_stride;
+
+		for (size_t oy = 0; oy < dst.height; oy++)
+			pool_row(f, &src, plane, oy, out_plane + oy * dst.row_stride, dst.width);
+
+		if (f->bias || f->activation.function != BNNSActivationFunctionIdentity)
+			bnns_bias_activate(&f->activation, out_plane, dst.height, dst.width, dst.row_stride, f->bias ? f->bias[c] : 0);
+	}
+
+	bnns_image_store(&f->out_image, &dst, out);
+	return 0;
+}
+
+BNNSFilter BNNSFilterCreatePoolingLayer(const BNNSImageStackDescriptor *__in_desc, const BNNSImageStackDescriptor *__out_desc, const BNNSPoolingLayerParameters *__layer_params, const BNNSFilterParameters *__filter_params)
+{
+	if (!__in_desc || !__out_desc || !__layer_params)
+		return NULL;
+
+	const BNNSPoolingLayerParameters* p = __layer_params;
+
+	if (!bnns_image_valid(__in_desc) || !bnns_image_valid(__out_desc))
+		return NULL;
+	if (p->x_stride == 0 || p->y_stride == 0 || p->k_width == 0 || p->k_height == 0)
+		return NULL;
+	if (p->pooling_function != BNNSPoolingFunctionMax && p->pooling_function != BNNSPoolingFunctionAverage)
+		return NULL;
+	if (p->in_channels != p->out_channels || __in_desc->channels != p->in_channels || __out_desc->channels != p->out_channels)
+		return NULL;
+	if (__out_desc->width != bnns_window_count(__in_desc->width, p->x_padding, p->k_width, p->x_stride)
+		|| __out_desc->height != bnns_window_count(__in_desc->height, p->y_padding, p->k_height, p->y_stride))
+		return NULL;
+	if (!bnns_activation_supported(&p->activation, false))
+		return NULL;
+
+	struct bnns_filter* f = bnns_filter_new(bnns_pooling, __filter_params);
+	if (!f)
+		return NULL;
+
+	f->in_image = *__in_desc;
+	f->out_image = *__out_desc;
+	f->pool = *p;
+	f->activation = p->activation;
+	f->apply = pool_apply;
+
+	if (p->bias.data)
+	{
+		f->bias = bnns_layer_data(f, &p->bias, p->out_channels);
+		if (!f->bias)
+		{
+			BNNSFilterDestroy(f);
+			return NULL;
+		}
+	}
+
+	return f;
+}
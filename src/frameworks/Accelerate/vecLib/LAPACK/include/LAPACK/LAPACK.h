@@ -21,6 +21,16 @@
 #ifndef _LAPACK_H_
 #define _LAPACK_H_
 
+// The types of Apple's CLAPACK interface
+typedef int __CLPK_integer;
+typedef int __CLPK_logical;
+typedef float __CLPK_real;
+typedef double __CLPK_doublereal;
+typedef __CLPK_logical (*__CLPK_L_fp)();
+typedef int __CLPK_ftnlen;
+typedef struct { __CLPK_real r, i; } __CLPK_complex;
+typedef struct { __CLPK_doublereal r, i; } __CLPK_doublecomplex;
+
 void* CBDSQR(void);
 void* CBDSQR_(void);
 void* CGBBRD(void);
@@ -764,7 +774,7 @@ void* DGELQ2(void);
 void* DGELQ2_(void);
 void* DGELQF(void);
 void* DGELQF_(void);
-void* DGELS(void);
+int DGELS(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DGELSD(void);
 void* DGELSD_(void);
 void* DGELSS(void);
@@ -773,7 +783,7 @@ void* DGELSX(void);
 void* DGELSX_(void);
 void* DGELSY(void);
 void* DGELSY_(void);
-void* DGELS_(void);
+int DGELS_(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DGEQL2(void);
 void* DGEQL2_(void);
 void* DGEQLF(void);
@@ -782,10 +792,10 @@ void* DGEQP3(void);
 void* DGEQP3_(void);
 void* DGEQPF(void);
 void* DGEQPF_(void);
-void* DGEQR2(void);
-void* DGEQR2_(void);
-void* DGEQRF(void);
-void* DGEQRF_(void);
+int DGEQR2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int DGEQR2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int DGEQRF(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DGEQRF_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DGERFS(void);
 void* DGERFS_(void);
 void* DGERQ2(void);
@@ -794,26 +804,26 @@ void* DGERQF(void);
 void* DGERQF_(void);
 void* DGESC2(void);
 void* DGESC2_(void);
-void* DGESDD(void);
-void* DGESDD_(void);
-void* DGESV(void);
-void* DGESVD(void);
-void* DGESVD_(void);
+int DGESDD(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int DGESDD_(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int DGESV(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int DGESVD(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DGESVD_(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DGESVJ(void);
 void* DGESVJ_(void);
 void* DGESVX(void);
 void* DGESVX_(void);
-void* DGESV_(void);
+int DGESV_(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* DGETC2(void);
 void* DGETC2_(void);
-void* DGETF2(void);
-void* DGETF2_(void);
-void* DGETRF(void);
-void* DGETRF_(void);
-void* DGETRI(void);
-void* DGETRI_(void);
-void* DGETRS(void);
-void* DGETRS_(void);
+int DGETF2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int DGETF2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int DGETRF(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int DGETRF_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int DGETRI(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DGETRI_(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DGETRS(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int DGETRS_(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* DGGBAK(void);
 void* DGGBAK_(void);
 void* DGGBAL(void);
@@ -952,8 +962,8 @@ void* DLAMC4(void);
 void* DLAMC4_(void);
 void* DLAMC5(void);
 void* DLAMC5_(void);
-void* DLAMCH(void);
-void* DLAMCH_(void);
+__CLPK_doublereal DLAMCH(char *__cmach);
+__CLPK_doublereal DLAMCH_(char *__cmach);
 void* DLAMRG(void);
 void* DLAMRG_(void);
 void* DLANEG(void);
@@ -1027,8 +1037,8 @@ void* DLAR2V_(void);
 void* DLARF(void);
 void* DLARFB(void);
 void* DLARFB_(void);
-void* DLARFG(void);
-void* DLARFG_(void);
+int DLARFG(__CLPK_integer *__n, __CLPK_doublereal *__alpha, __CLPK_doublereal *__x, __CLPK_integer *__incx, __CLPK_doublereal *__tau);
+int DLARFG_(__CLPK_integer *__n, __CLPK_doublereal *__alpha, __CLPK_doublereal *__x, __CLPK_integer *__incx, __CLPK_doublereal *__tau);
 void* DLARFP(void);
 void* DLARFP_(void);
 void* DLARFT(void);
@@ -1128,8 +1138,8 @@ void* DLASSQ(void);
 void* DLASSQ_(void);
 void* DLASV2(void);
 void* DLASV2_(void);
-void* DLASWP(void);
-void* DLASWP_(void);
+int DLASWP(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
+int DLASWP_(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
 void* DLASY2(void);
 void* DLASY2_(void);
 void* DLASYF(void);
@@ -1160,8 +1170,8 @@ void* DOPMTR(void);
 void* DOPMTR_(void);
 void* DORG2L(void);
 void* DORG2L_(void);
-void* DORG2R(void);
-void* DORG2R_(void);
+int DORG2R(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int DORG2R_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
 void* DORGBR(void);
 void* DORGBR_(void);
 void* DORGHR(void);
@@ -1172,8 +1182,8 @@ void* DORGLQ(void);
 void* DORGLQ_(void);
 void* DORGQL(void);
 void* DORGQL_(void);
-void* DORGQR(void);
-void* DORGQR_(void);
+int DORGQR(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DORGQR_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DORGR2(void);
 void* DORGR2_(void);
 void* DORGRQ(void);
@@ -1182,8 +1192,8 @@ void* DORGTR(void);
 void* DORGTR_(void);
 void* DORM2L(void);
 void* DORM2L_(void);
-void* DORM2R(void);
-void* DORM2R_(void);
+int DORM2R(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int DORM2R_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__info);
 void* DORMBR(void);
 void* DORMBR_(void);
 void* DORMHR(void);
@@ -1194,8 +1204,8 @@ void* DORMLQ(void);
 void* DORMLQ_(void);
 void* DORMQL(void);
 void* DORMQL_(void);
-void* DORMQR(void);
-void* DORMQR_(void);
+int DORMQR(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DORMQR_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DORMR2(void);
 void* DORMR2_(void);
 void* DORMR3(void);
@@ -1238,18 +1248,18 @@ void* DPOEQUB_(void);
 void* DPOEQU_(void);
 void* DPORFS(void);
 void* DPORFS_(void);
-void* DPOSV(void);
+int DPOSV(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* DPOSVX(void);
 void* DPOSVX_(void);
-void* DPOSV_(void);
-void* DPOTF2(void);
-void* DPOTF2_(void);
-void* DPOTRF(void);
-void* DPOTRF_(void);
+int DPOSV_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int DPOTF2(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int DPOTF2_(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int DPOTRF(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int DPOTRF_(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* DPOTRI(void);
 void* DPOTRI_(void);
-void* DPOTRS(void);
-void* DPOTRS_(void);
+int DPOTRS(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int DPOTRS_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* DPPCON(void);
 void* DPPCON_(void);
 void* DPPEQU(void);
@@ -1366,14 +1376,14 @@ void* DSYCON(void);
 void* DSYCON_(void);
 void* DSYEQUB(void);
 void* DSYEQUB_(void);
-void* DSYEV(void);
-void* DSYEVD(void);
-void* DSYEVD_(void);
+int DSYEV(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int DSYEVD(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
+int DSYEVD_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
 void* DSYEVR(void);
 void* DSYEVR_(void);
 void* DSYEVX(void);
 void* DSYEVX_(void);
-void* DSYEV_(void);
+int DSYEV_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* DSYGS2(void);
 void* DSYGS2_(void);
 void* DSYGST(void);
@@ -1460,8 +1470,8 @@ void* DTRSYL(void);
 void* DTRSYL_(void);
 void* DTRTI2(void);
 void* DTRTI2_(void);
-void* DTRTRI(void);
-void* DTRTRI_(void);
+int DTRTRI(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int DTRTRI_(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* DTRTRS(void);
 void* DTRTRS_(void);
 void* DTRTTF(void);
@@ -1488,8 +1498,8 @@ void* ILADLC(void);
 void* ILADLC_(void);
 void* ILADLR(void);
 void* ILADLR_(void);
-void* ILAENV(void);
-void* ILAENV_(void);
+__CLPK_integer ILAENV(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4);
+__CLPK_integer ILAENV_(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4);
 void* ILAPREC(void);
 void* ILAPREC_(void);
 void* ILASLC(void);
@@ -1576,7 +1586,7 @@ void* SGELQ2(void);
 void* SGELQ2_(void);
 void* SGELQF(void);
 void* SGELQF_(void);
-void* SGELS(void);
+int SGELS(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SGELSD(void);
 void* SGELSD_(void);
 void* SGELSS(void);
@@ -1585,7 +1595,7 @@ void* SGELSX(void);
 void* SGELSX_(void);
 void* SGELSY(void);
 void* SGELSY_(void);
-void* SGELS_(void);
+int SGELS_(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SGEQL2(void);
 void* SGEQL2_(void);
 void* SGEQLF(void);
@@ -1594,10 +1604,10 @@ void* SGEQP3(void);
 void* SGEQP3_(void);
 void* SGEQPF(void);
 void* SGEQPF_(void);
-void* SGEQR2(void);
-void* SGEQR2_(void);
-void* SGEQRF(void);
-void* SGEQRF_(void);
+int SGEQR2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int SGEQR2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int SGEQRF(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SGEQRF_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SGERFS(void);
 void* SGERFS_(void);
 void* SGERQ2(void);
@@ -1606,26 +1616,26 @@ void* SGERQF(void);
 void* SGERQF_(void);
 void* SGESC2(void);
 void* SGESC2_(void);
-void* SGESDD(void);
-void* SGESDD_(void);
-void* SGESV(void);
-void* SGESVD(void);
-void* SGESVD_(void);
+int SGESDD(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int SGESDD_(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int SGESV(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int SGESVD(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SGESVD_(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SGESVJ(void);
 void* SGESVJ_(void);
 void* SGESVX(void);
 void* SGESVX_(void);
-void* SGESV_(void);
+int SGESV_(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* SGETC2(void);
 void* SGETC2_(void);
-void* SGETF2(void);
-void* SGETF2_(void);
-void* SGETRF(void);
-void* SGETRF_(void);
-void* SGETRI(void);
-void* SGETRI_(void);
-void* SGETRS(void);
-void* SGETRS_(void);
+int SGETF2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int SGETF2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int SGETRF(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int SGETRF_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int SGETRI(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SGETRI_(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SGETRS(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int SGETRS_(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* SGGBAK(void);
 void* SGGBAK_(void);
 void* SGGBAL(void);
@@ -1764,8 +1774,8 @@ void* SLAMC4(void);
 void* SLAMC4_(void);
 void* SLAMC5(void);
 void* SLAMC5_(void);
-void* SLAMCH(void);
-void* SLAMCH_(void);
+__CLPK_doublereal SLAMCH(char *__cmach);
+__CLPK_doublereal SLAMCH_(char *__cmach);
 void* SLAMRG(void);
 void* SLAMRG_(void);
 void* SLANEG(void);
@@ -1839,8 +1849,8 @@ void* SLAR2V_(void);
 void* SLARF(void);
 void* SLARFB(void);
 void* SLARFB_(void);
-void* SLARFG(void);
-void* SLARFG_(void);
+int SLARFG(__CLPK_integer *__n, __CLPK_real *__alpha, __CLPK_real *__x, __CLPK_integer *__incx, __CLPK_real *__tau);
+int SLARFG_(__CLPK_integer *__n, __CLPK_real *__alpha, __CLPK_real *__x, __CLPK_integer *__incx, __CLPK_real *__tau);
 void* SLARFP(void);
 void* SLARFP_(void);
 void* SLARFT(void);
@@ -1940,8 +1950,8 @@ void* SLASSQ(void);
 void* SLASSQ_(void);
 void* SLASV2(void);
 void* SLASV2_(void);
-void* SLASWP(void);
-void* SLASWP_(void);
+int SLASWP(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
+int SLASWP_(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
 void* SLASY2(void);
 void* SLASY2_(void);
 void* SLASYF(void);
@@ -1972,8 +1982,8 @@ void* SOPMTR(void);
 void* SOPMTR_(void);
 void* SORG2L(void);
 void* SORG2L_(void);
-void* SORG2R(void);
-void* SORG2R_(void);
+int SORG2R(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int SORG2R_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
 void* SORGBR(void);
 void* SORGBR_(void);
 void* SORGHR(void);
@@ -1984,8 +1994,8 @@ void* SORGLQ(void);
 void* SORGLQ_(void);
 void* SORGQL(void);
 void* SORGQL_(void);
-void* SORGQR(void);
-void* SORGQR_(void);
+int SORGQR(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SORGQR_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SORGR2(void);
 void* SORGR2_(void);
 void* SORGRQ(void);
@@ -1994,8 +2004,8 @@ void* SORGTR(void);
 void* SORGTR_(void);
 void* SORM2L(void);
 void* SORM2L_(void);
-void* SORM2R(void);
-void* SORM2R_(void);
+int SORM2R(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__info);
+int SORM2R_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__info);
 void* SORMBR(void);
 void* SORMBR_(void);
 void* SORMHR(void);
@@ -2006,8 +2016,8 @@ void* SORMLQ(void);
 void* SORMLQ_(void);
 void* SORMQL(void);
 void* SORMQL_(void);
-void* SORMQR(void);
-void* SORMQR_(void);
+int SORMQR(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SORMQR_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SORMR2(void);
 void* SORMR2_(void);
 void* SORMR3(void);
@@ -2050,18 +2060,18 @@ void* SPOEQUB_(void);
 void* SPOEQU_(void);
 void* SPORFS(void);
 void* SPORFS_(void);
-void* SPOSV(void);
+int SPOSV(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* SPOSVX(void);
 void* SPOSVX_(void);
-void* SPOSV_(void);
-void* SPOTF2(void);
-void* SPOTF2_(void);
-void* SPOTRF(void);
-void* SPOTRF_(void);
+int SPOSV_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int SPOTF2(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int SPOTF2_(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int SPOTRF(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int SPOTRF_(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* SPOTRI(void);
 void* SPOTRI_(void);
-void* SPOTRS(void);
-void* SPOTRS_(void);
+int SPOTRS(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int SPOTRS_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* SPPCON(void);
 void* SPPCON_(void);
 void* SPPEQU(void);
@@ -2174,14 +2184,14 @@ void* SSYCON(void);
 void* SSYCON_(void);
 void* SSYEQUB(void);
 void* SSYEQUB_(void);
-void* SSYEV(void);
-void* SSYEVD(void);
-void* SSYEVD_(void);
+int SSYEV(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int SSYEVD(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
+int SSYEVD_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
 void* SSYEVR(void);
 void* SSYEVR_(void);
 void* SSYEVX(void);
 void* SSYEVX_(void);
-void* SSYEV_(void);
+int SSYEV_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* SSYGS2(void);
 void* SSYGS2_(void);
 void* SSYGST(void);
@@ -2268,8 +2278,8 @@ void* STRSYL(void);
 void* STRSYL_(void);
 void* STRTI2(void);
 void* STRTI2_(void);
-void* STRTRI(void);
-void* STRTRI_(void);
+int STRTRI(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int STRTRI_(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* STRTRS(void);
 void* STRTRS_(void);
 void* STRTTF(void);
@@ -3709,8 +3719,8 @@ void* dgelq2(void);
 void* dgelq2_(void);
 void* dgelqf(void);
 void* dgelqf_(void);
-void* dgels(void);
-void* dgels_(void);
+int dgels(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dgels_(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* dgelsd(void);
 void* dgelsd_(void);
 void* dgelss(void);
@@ -3727,10 +3737,10 @@ void* dgeqp3(void);
 void* dgeqp3_(void);
 void* dgeqpf(void);
 void* dgeqpf_(void);
-void* dgeqr2(void);
-void* dgeqr2_(void);
-void* dgeqrf(void);
-void* dgeqrf_(void);
+int dgeqr2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int dgeqr2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int dgeqrf(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dgeqrf_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* dgerfs(void);
 void* dgerfs_(void);
 void* dgerq2(void);
@@ -3739,26 +3749,26 @@ void* dgerqf(void);
 void* dgerqf_(void);
 void* dgesc2(void);
 void* dgesc2_(void);
-void* dgesdd(void);
-void* dgesdd_(void);
-void* dgesv(void);
-void* dgesv_(void);
-void* dgesvd(void);
-void* dgesvd_(void);
+int dgesdd(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int dgesdd_(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int dgesv(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int dgesv_(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int dgesvd(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dgesvd_(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__s, __CLPK_doublereal *__u, __CLPK_integer *__ldu, __CLPK_doublereal *__vt, __CLPK_integer *__ldvt, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* dgesvj(void);
 void* dgesvj_(void);
 void* dgesvx(void);
 void* dgesvx_(void);
 void* dgetc2(void);
 void* dgetc2_(void);
-void* dgetf2(void);
-void* dgetf2_(void);
-void* dgetrf(void);
-void* dgetrf_(void);
-void* dgetri(void);
-void* dgetri_(void);
-void* dgetrs(void);
-void* dgetrs_(void);
+int dgetf2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int dgetf2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int dgetrf(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int dgetrf_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int dgetri(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dgetri_(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dgetrs(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int dgetrs_(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* dggbak(void);
 void* dggbak_(void);
 void* dggbal(void);
@@ -3897,8 +3907,8 @@ void* dlamc4(void);
 void* dlamc4_(void);
 void* dlamc5(void);
 void* dlamc5_(void);
-void* dlamch(void);
-void* dlamch_(void);
+__CLPK_doublereal dlamch(char *__cmach);
+__CLPK_doublereal dlamch_(char *__cmach);
 void* dlamrg(void);
 void* dlamrg_(void);
 void* dlaneg(void);
@@ -3973,8 +3983,8 @@ void* dlarf(void);
 void* dlarf_(void);
 void* dlarfb(void);
 void* dlarfb_(void);
-void* dlarfg(void);
-void* dlarfg_(void);
+int dlarfg(__CLPK_integer *__n, __CLPK_doublereal *__alpha, __CLPK_doublereal *__x, __CLPK_integer *__incx, __CLPK_doublereal *__tau);
+int dlarfg_(__CLPK_integer *__n, __CLPK_doublereal *__alpha, __CLPK_doublereal *__x, __CLPK_integer *__incx, __CLPK_doublereal *__tau);
 void* dlarfp(void);
 void* dlarfp_(void);
 void* dlarft(void);
@@ -4073,8 +4083,8 @@ void* dlassq(void);
 void* dlassq_(void);
 void* dlasv2(void);
 void* dlasv2_(void);
-void* dlaswp(void);
-void* dlaswp_(void);
+int dlaswp(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
+int dlaswp_(__CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
 void* dlasy2(void);
 void* dlasy2_(void);
 void* dlasyf(void);
@@ -4105,8 +4115,8 @@ void* dopmtr(void);
 void* dopmtr_(void);
 void* dorg2l(void);
 void* dorg2l_(void);
-void* dorg2r(void);
-void* dorg2r_(void);
+int dorg2r(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int dorg2r_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__info);
 void* dorgbr(void);
 void* dorgbr_(void);
 void* dorghr(void);
@@ -4117,8 +4127,8 @@ void* dorglq(void);
 void* dorglq_(void);
 void* dorgql(void);
 void* dorgql_(void);
-void* dorgqr(void);
-void* dorgqr_(void);
+int dorgqr(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dorgqr_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* dorgr2(void);
 void* dorgr2_(void);
 void* dorgrq(void);
@@ -4127,8 +4137,8 @@ void* dorgtr(void);
 void* dorgtr_(void);
 void* dorm2l(void);
 void* dorm2l_(void);
-void* dorm2r(void);
-void* dorm2r_(void);
+int dorm2r(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__info);
+int dorm2r_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__info);
 void* dormbr(void);
 void* dormbr_(void);
 void* dormhr(void);
@@ -4139,8 +4149,8 @@ void* dormlq(void);
 void* dormlq_(void);
 void* dormql(void);
 void* dormql_(void);
-void* dormqr(void);
-void* dormqr_(void);
+int dormqr(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dormqr_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__tau, __CLPK_doublereal *__c, __CLPK_integer *__ldc, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* dormr2(void);
 void* dormr2_(void);
 void* dormr3(void);
@@ -4183,18 +4193,18 @@ void* dpoequb(void);
 void* dpoequb_(void);
 void* dporfs(void);
 void* dporfs_(void);
-void* dposv(void);
-void* dposv_(void);
+int dposv(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int dposv_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* dposvx(void);
 void* dposvx_(void);
-void* dpotf2(void);
-void* dpotf2_(void);
-void* dpotrf(void);
-void* dpotrf_(void);
+int dpotf2(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int dpotf2_(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int dpotrf(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int dpotrf_(char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* dpotri(void);
 void* dpotri_(void);
-void* dpotrs(void);
-void* dpotrs_(void);
+int dpotrs(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int dpotrs_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* dppcon(void);
 void* dppcon_(void);
 void* dppequ(void);
@@ -4311,10 +4321,10 @@ void* dsycon(void);
 void* dsycon_(void);
 void* dsyequb(void);
 void* dsyequb_(void);
-void* dsyev(void);
-void* dsyev_(void);
-void* dsyevd(void);
-void* dsyevd_(void);
+int dsyev(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dsyev_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int dsyevd(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
+int dsyevd_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_doublereal *__w, __CLPK_doublereal *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
 void* dsyevr(void);
 void* dsyevr_(void);
 void* dsyevx(void);
@@ -4405,8 +4415,8 @@ void* dtrsyl(void);
 void* dtrsyl_(void);
 void* dtrti2(void);
 void* dtrti2_(void);
-void* dtrtri(void);
-void* dtrtri_(void);
+int dtrtri(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int dtrtri_(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_doublereal *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* dtrtrs(void);
 void* dtrtrs_(void);
 void* dtrttf(void);
@@ -4433,8 +4443,8 @@ void* iladlc(void);
 void* iladlc_(void);
 void* iladlr(void);
 void* iladlr_(void);
-void* ilaenv(void);
-void* ilaenv_(void);
+__CLPK_integer ilaenv(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4);
+__CLPK_integer ilaenv_(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4);
 void* ilaprec(void);
 void* ilaprec_(void);
 void* ilaslc(void);
@@ -4521,8 +4531,8 @@ void* sgelq2(void);
 void* sgelq2_(void);
 void* sgelqf(void);
 void* sgelqf_(void);
-void* sgels(void);
-void* sgels_(void);
+int sgels(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sgels_(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* sgelsd(void);
 void* sgelsd_(void);
 void* sgelss(void);
@@ -4539,10 +4549,10 @@ void* sgeqp3(void);
 void* sgeqp3_(void);
 void* sgeqpf(void);
 void* sgeqpf_(void);
-void* sgeqr2(void);
-void* sgeqr2_(void);
-void* sgeqrf(void);
-void* sgeqrf_(void);
+int sgeqr2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int sgeqr2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int sgeqrf(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sgeqrf_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* sgerfs(void);
 void* sgerfs_(void);
 void* sgerq2(void);
@@ -4551,26 +4561,26 @@ void* sgerqf(void);
 void* sgerqf_(void);
 void* sgesc2(void);
 void* sgesc2_(void);
-void* sgesdd(void);
-void* sgesdd_(void);
-void* sgesv(void);
-void* sgesv_(void);
-void* sgesvd(void);
-void* sgesvd_(void);
+int sgesdd(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int sgesdd_(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info);
+int sgesv(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int sgesv_(__CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int sgesvd(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sgesvd_(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__s, __CLPK_real *__u, __CLPK_integer *__ldu, __CLPK_real *__vt, __CLPK_integer *__ldvt, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* sgesvj(void);
 void* sgesvj_(void);
 void* sgesvx(void);
 void* sgesvx_(void);
 void* sgetc2(void);
 void* sgetc2_(void);
-void* sgetf2(void);
-void* sgetf2_(void);
-void* sgetrf(void);
-void* sgetrf_(void);
-void* sgetri(void);
-void* sgetri_(void);
-void* sgetrs(void);
-void* sgetrs_(void);
+int sgetf2(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int sgetf2_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int sgetrf(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int sgetrf_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info);
+int sgetri(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sgetri_(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sgetrs(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int sgetrs_(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* sggbak(void);
 void* sggbak_(void);
 void* sggbal(void);
@@ -4709,8 +4719,8 @@ void* slamc4(void);
 void* slamc4_(void);
 void* slamc5(void);
 void* slamc5_(void);
-void* slamch(void);
-void* slamch_(void);
+__CLPK_doublereal slamch(char *__cmach);
+__CLPK_doublereal slamch_(char *__cmach);
 void* slamrg(void);
 void* slamrg_(void);
 void* slaneg(void);
@@ -4785,8 +4795,8 @@ void* slarf(void);
 void* slarf_(void);
 void* slarfb(void);
 void* slarfb_(void);
-void* slarfg(void);
-void* slarfg_(void);
+int slarfg(__CLPK_integer *__n, __CLPK_real *__alpha, __CLPK_real *__x, __CLPK_integer *__incx, __CLPK_real *__tau);
+int slarfg_(__CLPK_integer *__n, __CLPK_real *__alpha, __CLPK_real *__x, __CLPK_integer *__incx, __CLPK_real *__tau);
 void* slarfp(void);
 void* slarfp_(void);
 void* slarft(void);
@@ -4885,8 +4895,8 @@ void* slassq(void);
 void* slassq_(void);
 void* slasv2(void);
 void* slasv2_(void);
-void* slaswp(void);
-void* slaswp_(void);
+int slaswp(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
+int slaswp_(__CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx);
 void* slasy2(void);
 void* slasy2_(void);
 void* slasyf(void);
@@ -4917,8 +4927,8 @@ void* sopmtr(void);
 void* sopmtr_(void);
 void* sorg2l(void);
 void* sorg2l_(void);
-void* sorg2r(void);
-void* sorg2r_(void);
+int sorg2r(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
+int sorg2r_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__info);
 void* sorgbr(void);
 void* sorgbr_(void);
 void* sorghr(void);
@@ -4929,8 +4939,8 @@ void* sorglq(void);
 void* sorglq_(void);
 void* sorgql(void);
 void* sorgql_(void);
-void* sorgqr(void);
-void* sorgqr_(void);
+int sorgqr(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sorgqr_(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* sorgr2(void);
 void* sorgr2_(void);
 void* sorgrq(void);
@@ -4939,8 +4949,8 @@ void* sorgtr(void);
 void* sorgtr_(void);
 void* sorm2l(void);
 void* sorm2l_(void);
-void* sorm2r(void);
-void* sorm2r_(void);
+int sorm2r(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__info);
+int sorm2r_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__info);
 void* sormbr(void);
 void* sormbr_(void);
 void* sormhr(void);
@@ -4951,8 +4961,8 @@ void* sormlq(void);
 void* sormlq_(void);
 void* sormql(void);
 void* sormql_(void);
-void* sormqr(void);
-void* sormqr_(void);
+int sormqr(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int sormqr_(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__tau, __CLPK_real *__c, __CLPK_integer *__ldc, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
 void* sormr2(void);
 void* sormr2_(void);
 void* sormr3(void);
@@ -4995,18 +5005,18 @@ void* spoequb(void);
 void* spoequb_(void);
 void* sporfs(void);
 void* sporfs_(void);
-void* sposv(void);
-void* sposv_(void);
+int sposv(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int sposv_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* sposvx(void);
 void* sposvx_(void);
-void* spotf2(void);
-void* spotf2_(void);
-void* spotrf(void);
-void* spotrf_(void);
+int spotf2(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int spotf2_(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int spotrf(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int spotrf_(char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* spotri(void);
 void* spotri_(void);
-void* spotrs(void);
-void* spotrs_(void);
+int spotrs(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
+int spotrs_(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__b, __CLPK_integer *__ldb, __CLPK_integer *__info);
 void* sppcon(void);
 void* sppcon_(void);
 void* sppequ(void);
@@ -5119,10 +5129,10 @@ void* ssycon(void);
 void* ssycon_(void);
 void* ssyequb(void);
 void* ssyequb_(void);
-void* ssyev(void);
-void* ssyev_(void);
-void* ssyevd(void);
-void* ssyevd_(void);
+int ssyev(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int ssyev_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__info);
+int ssyevd(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
+int ssyevd_(char *__jobz, char *__uplo, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_real *__w, __CLPK_real *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info);
 void* ssyevr(void);
 void* ssyevr_(void);
 void* ssyevx(void);
@@ -5213,8 +5223,8 @@ void* strsyl(void);
 void* strsyl_(void);
 void* strti2(void);
 void* strti2_(void);
-void* strtri(void);
-void* strtri_(void);
+int strtri(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
+int strtri_(char *__uplo, char *__diag, __CLPK_integer *__n, __CLPK_real *__a, __CLPK_integer *__lda, __CLPK_integer *__info);
 void* strtrs(void);
 void* strtrs_(void);
 void* strttf(void);
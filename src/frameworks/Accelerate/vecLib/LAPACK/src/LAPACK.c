@@ -4487,11 +4487,13 @@ void* DGELQF_(void)
     return NULL;
 }
 
+/*
 void* DGELS(void)
 {
     if (verbose) puts("STUB: DGELS called");
     return NULL;
 }
+*/
 
 void* DGELSD(void)
 {
@@ -4541,11 +4543,13 @@ void* DGELSY_(void)
     return NULL;
 }
 
+/*
 void* DGELS_(void)
 {
     if (verbose) puts("STUB: DGELS_ called");
     return NULL;
 }
+*/
 
 void* DGEQL2(void)
 {
@@ -4595,29 +4599,37 @@ void* DGEQPF_(void)
     return NULL;
 }
 
+/*
 void* DGEQR2(void)
 {
     if (verbose) puts("STUB: DGEQR2 called");
     return NULL;
 }
+*/
 
+/*
 void* DGEQR2_(void)
 {
     if (verbose) puts("STUB: DGEQR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGEQRF(void)
 {
     if (verbose) puts("STUB: DGEQRF called");
     return NULL;
 }
+*/
 
+/*
 void* DGEQRF_(void)
 {
     if (verbose) puts("STUB: DGEQRF_ called");
     return NULL;
 }
+*/
 
 void* DGERFS(void)
 {
@@ -4667,35 +4679,45 @@ void* DGESC2_(void)
     return NULL;
 }
 
+/*
 void* DGESDD(void)
 {
     if (verbose) puts("STUB: DGESDD called");
     return NULL;
 }
+*/
 
+/*
 void* DGESDD_(void)
 {
     if (verbose) puts("STUB: DGESDD_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGESV(void)
 {
     if (verbose) puts("STUB: DGESV called");
     return NULL;
 }
+*/
 
+/*
 void* DGESVD(void)
 {
     if (verbose) puts("STUB: DGESVD called");
     return NULL;
 }
+*/
 
+/*
 void* DGESVD_(void)
 {
     if (verbose) puts("STUB: DGESVD_ called");
     return NULL;
 }
+*/
 
 void* DGESVJ(void)
 {
@@ -4721,11 +4743,13 @@ void* DGESVX_(void)
     return NULL;
 }
 
+/*
 void* DGESV_(void)
 {
     if (verbose) puts("STUB: DGESV_ called");
     return NULL;
 }
+*/
 
 void* DGETC2(void)
 {
@@ -4739,53 +4763,69 @@ void* DGETC2_(void)
     return NULL;
 }
 
+/*
 void* DGETF2(void)
 {
     if (verbose) puts("STUB: DGETF2 called");
     return NULL;
 }
+*/
 
+/*
 void* DGETF2_(void)
 {
     if (verbose) puts("STUB: DGETF2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRF(void)
 {
     if (verbose) puts("STUB: DGETRF called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRF_(void)
 {
     if (verbose) puts("STUB: DGETRF_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRI(void)
 {
     if (verbose) puts("STUB: DGETRI called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRI_(void)
 {
     if (verbose) puts("STUB: DGETRI_ called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRS(void)
 {
     if (verbose) puts("STUB: DGETRS called");
     return NULL;
 }
+*/
 
+/*
 void* DGETRS_(void)
 {
     if (verbose) puts("STUB: DGETRS_ called");
     return NULL;
 }
+*/
 
 void* DGGBAK(void)
 {
@@ -5615,17 +5655,21 @@ void* DLAMC5_(void)
     return NULL;
 }
 
+/*
 void* DLAMCH(void)
 {
     if (verbose) puts("STUB: DLAMCH called");
     return NULL;
 }
+*/
 
+/*
 void* DLAMCH_(void)
 {
     if (verbose) puts("STUB: DLAMCH_ called");
     return NULL;
 }
+*/
 
 void* DLAMRG(void)
 {
@@ -6065,17 +6109,21 @@ void* DLARFB_(void)
     return NULL;
 }
 
+/*
 void* DLARFG(void)
 {
     if (verbose) puts("STUB: DLARFG called");
     return NULL;
 }
+*/
 
+/*
 void* DLARFG_(void)
 {
     if (verbose) puts("STUB: DLARFG_ called");
     return NULL;
 }
+*/
 
 void* DLARFP(void)
 {
@@ -6671,17 +6719,21 @@ void* DLASV2_(void)
     return NULL;
 }
 
+/*
 void* DLASWP(void)
 {
     if (verbose) puts("STUB: DLASWP called");
     return NULL;
 }
+*/
 
+/*
 void* DLASWP_(void)
 {
     if (verbose) puts("STUB: DLASWP_ called");
     return NULL;
 }
+*/
 
 void* DLASY2(void)
 {
@@ -6863,17 +6915,21 @@ void* DORG2L_(void)
     return NULL;
 }
 
+/*
 void* DORG2R(void)
 {
     if (verbose) puts("STUB: DORG2R called");
     return NULL;
 }
+*/
 
+/*
 void* DORG2R_(void)
 {
     if (verbose) puts("STUB: DORG2R_ called");
     return NULL;
 }
+*/
 
 void* DORGBR(void)
 {
@@ -6935,17 +6991,21 @@ void* DORGQL_(void)
     return NULL;
 }
 
+/*
 void* DORGQR(void)
 {
     if (verbose) puts("STUB: DORGQR called");
     return NULL;
 }
+*/
 
+/*
 void* DORGQR_(void)
 {
     if (verbose) puts("STUB: DORGQR_ called");
     return NULL;
 }
+*/
 
 void* DORGR2(void)
 {
@@ -6995,17 +7055,21 @@ void* DORM2L_(void)
     return NULL;
 }
 
+/*
 void* DORM2R(void)
 {
     if (verbose) puts("STUB: DORM2R called");
     return NULL;
 }
+*/
 
+/*
 void* DORM2R_(void)
 {
     if (verbose) puts("STUB: DORM2R_ called");
     return NULL;
 }
+*/
 
 void* DORMBR(void)
 {
@@ -7067,17 +7131,21 @@ void* DORMQL_(void)
     return NULL;
 }
 
+/*
 void* DORMQR(void)
 {
     if (verbose) puts("STUB: DORMQR called");
     return NULL;
 }
+*/
 
+/*
 void* DORMQR_(void)
 {
     if (verbose) puts("STUB: DORMQR_ called");
     return NULL;
 }
+*/
 
 void* DORMR2(void)
 {
@@ -7331,11 +7399,13 @@ void* DPORFS_(void)
     return NULL;
 }
 
+/*
 void* DPOSV(void)
 {
     if (verbose) puts("STUB: DPOSV called");
     return NULL;
 }
+*/
 
 void* DPOSVX(void)
 {
@@ -7349,35 +7419,45 @@ void* DPOSVX_(void)
     return NULL;
 }
 
+/*
 void* DPOSV_(void)
 {
     if (verbose) puts("STUB: DPOSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* DPOTF2(void)
 {
     if (verbose) puts("STUB: DPOTF2 called");
     return NULL;
 }
+*/
 
+/*
 void* DPOTF2_(void)
 {
     if (verbose) puts("STUB: DPOTF2_ called");
     return NULL;
 }
+*/
 
+/*
 void* DPOTRF(void)
 {
     if (verbose) puts("STUB: DPOTRF called");
     return NULL;
 }
+*/
 
+/*
 void* DPOTRF_(void)
 {
     if (verbose) puts("STUB: DPOTRF_ called");
     return NULL;
 }
+*/
 
 void* DPOTRI(void)
 {
@@ -7391,17 +7471,21 @@ void* DPOTRI_(void)
     return NULL;
 }
 
+/*
 void* DPOTRS(void)
 {
     if (verbose) puts("STUB: DPOTRS called");
     return NULL;
 }
+*/
 
+/*
 void* DPOTRS_(void)
 {
     if (verbose) puts("STUB: DPOTRS_ called");
     return NULL;
 }
+*/
 
 void* DPPCON(void)
 {
@@ -8099,23 +8183,29 @@ void* DSYEQUB_(void)
     return NULL;
 }
 
+/*
 void* DSYEV(void)
 {
     if (verbose) puts("STUB: DSYEV called");
     return NULL;
 }
+*/
 
+/*
 void* DSYEVD(void)
 {
     if (verbose) puts("STUB: DSYEVD called");
     return NULL;
 }
+*/
 
+/*
 void* DSYEVD_(void)
 {
     if (verbose) puts("STUB: DSYEVD_ called");
     return NULL;
 }
+*/
 
 void* DSYEVR(void)
 {
@@ -8141,11 +8231,13 @@ void* DSYEVX_(void)
     return NULL;
 }
 
+/*
 void* DSYEV_(void)
 {
     if (verbose) puts("STUB: DSYEV_ called");
     return NULL;
 }
+*/
 
 void* DSYGS2(void)
 {
@@ -8663,17 +8755,21 @@ void* DTRTI2_(void)
     return NULL;
 }
 
+/*
 void* DTRTRI(void)
 {
     if (verbose) puts("STUB: DTRTRI called");
     return NULL;
 }
+*/
 
+/*
 void* DTRTRI_(void)
 {
     if (verbose) puts("STUB: DTRTRI_ called");
     return NULL;
 }
+*/
 
 void* DTRTRS(void)
 {
@@ -8831,17 +8927,21 @@ void* ILADLR_(void)
     return NULL;
 }
 
+/*
 void* ILAENV(void)
 {
     if (verbose) puts("STUB: ILAENV called");
     return NULL;
 }
+*/
 
+/*
 void* ILAENV_(void)
 {
     if (verbose) puts("STUB: ILAENV_ called");
     return NULL;
 }
+*/
 
 void* ILAPREC(void)
 {
@@ -9359,11 +9459,13 @@ void* SGELQF_(void)
     return NULL;
 }
 
+/*
 void* SGELS(void)
 {
     if (verbose) puts("STUB: SGELS called");
     return NULL;
 }
+*/
 
 void* SGELSD(void)
 {
@@ -9413,11 +9515,13 @@ void* SGELSY_(void)
     return NULL;
 }
 
+/*
 void* SGELS_(void)
 {
     if (verbose) puts("STUB: SGELS_ called");
     return NULL;
 }
+*/
 
 void* SGEQL2(void)
 {
@@ -9467,29 +9571,37 @@ void* SGEQPF_(void)
     return NULL;
 }
 
+/*
 void* SGEQR2(void)
 {
     if (verbose) puts("STUB: SGEQR2 called");
     return NULL;
 }
+*/
 
+/*
 void* SGEQR2_(void)
 {
     if (verbose) puts("STUB: SGEQR2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGEQRF(void)
 {
     if (verbose) puts("STUB: SGEQRF called");
     return NULL;
 }
+*/
 
+/*
 void* SGEQRF_(void)
 {
     if (verbose) puts("STUB: SGEQRF_ called");
     return NULL;
 }
+*/
 
 void* SGERFS(void)
 {
@@ -9539,35 +9651,45 @@ void* SGESC2_(void)
     return NULL;
 }
 
+/*
 void* SGESDD(void)
 {
     if (verbose) puts("STUB: SGESDD called");
     return NULL;
 }
+*/
 
+/*
 void* SGESDD_(void)
 {
     if (verbose) puts("STUB: SGESDD_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGESV(void)
 {
     if (verbose) puts("STUB: SGESV called");
     return NULL;
 }
+*/
 
+/*
 void* SGESVD(void)
 {
     if (verbose) puts("STUB: SGESVD called");
     return NULL;
 }
+*/
 
+/*
 void* SGESVD_(void)
 {
     if (verbose) puts("STUB: SGESVD_ called");
     return NULL;
 }
+*/
 
 void* SGESVJ(void)
 {
@@ -9593,11 +9715,13 @@ void* SGESVX_(void)
     return NULL;
 }
 
+/*
 void* SGESV_(void)
 {
     if (verbose) puts("STUB: SGESV_ called");
     return NULL;
 }
+*/
 
 void* SGETC2(void)
 {
@@ -9611,53 +9735,69 @@ void* SGETC2_(void)
     return NULL;
 }
 
+/*
 void* SGETF2(void)
 {
     if (verbose) puts("STUB: SGETF2 called");
     return NULL;
 }
+*/
 
+/*
 void* SGETF2_(void)
 {
     if (verbose) puts("STUB: SGETF2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRF(void)
 {
     if (verbose) puts("STUB: SGETRF called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRF_(void)
 {
     if (verbose) puts("STUB: SGETRF_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRI(void)
 {
     if (verbose) puts("STUB: SGETRI called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRI_(void)
 {
     if (verbose) puts("STUB: SGETRI_ called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRS(void)
 {
     if (verbose) puts("STUB: SGETRS called");
     return NULL;
 }
+*/
 
+/*
 void* SGETRS_(void)
 {
     if (verbose) puts("STUB: SGETRS_ called");
     return NULL;
 }
+*/
 
 void* SGGBAK(void)
 {
@@ -10487,17 +10627,21 @@ void* SLAMC5_(void)
     return NULL;
 }
 
+/*
 void* SLAMCH(void)
 {
     if (verbose) puts("STUB: SLAMCH called");
     return NULL;
 }
+*/
 
+/*
 void* SLAMCH_(void)
 {
     if (verbose) puts("STUB: SLAMCH_ called");
     return NULL;
 }
+*/
 
 void* SLAMRG(void)
 {
@@ -10937,17 +11081,21 @@ void* SLARFB_(void)
     return NULL;
 }
 
+/*
 void* SLARFG(void)
 {
     if (verbose) puts("STUB: SLARFG called");
     return NULL;
 }
+*/
 
+/*
 void* SLARFG_(void)
 {
     if (verbose) puts("STUB: SLARFG_ called");
     return NULL;
 }
+*/
 
 void* SLARFP(void)
 {
@@ -11543,17 +11691,21 @@ void* SLASV2_(void)
     return NULL;
 }
 
+/*
 void* SLASWP(void)
 {
     if (verbose) puts("STUB: SLASWP called");
     return NULL;
 }
+*/
 
+/*
 void* SLASWP_(void)
 {
     if (verbose) puts("STUB: SLASWP_ called");
     return NULL;
 }
+*/
 
 void* SLASY2(void)
 {
@@ -11735,17 +11887,21 @@ void* SORG2L_(void)
     return NULL;
 }
 
+/*
 void* SORG2R(void)
 {
     if (verbose) puts("STUB: SORG2R called");
     return NULL;
 }
+*/
 
+/*
 void* SORG2R_(void)
 {
     if (verbose) puts("STUB: SORG2R_ called");
     return NULL;
 }
+*/
 
 void* SORGBR(void)
 {
@@ -11807,17 +11963,21 @@ void* SORGQL_(void)
     return NULL;
 }
 
+/*
 void* SORGQR(void)
 {
     if (verbose) puts("STUB: SORGQR called");
     return NULL;
 }
+*/
 
+/*
 void* SORGQR_(void)
 {
     if (verbose) puts("STUB: SORGQR_ called");
     return NULL;
 }
+*/
 
 void* SORGR2(void)
 {
@@ -11867,17 +12027,21 @@ void* SORM2L_(void)
     return NULL;
 }
 
+/*
 void* SORM2R(void)
 {
     if (verbose) puts("STUB: SORM2R called");
     return NULL;
 }
+*/
 
+/*
 void* SORM2R_(void)
 {
     if (verbose) puts("STUB: SORM2R_ called");
     return NULL;
 }
+*/
 
 void* SORMBR(void)
 {
@@ -11939,17 +12103,21 @@ void* SORMQL_(void)
     return NULL;
 }
 
+/*
 void* SORMQR(void)
 {
     if (verbose) puts("STUB: SORMQR called");
     return NULL;
 }
+*/
 
+/*
 void* SORMQR_(void)
 {
     if (verbose) puts("STUB: SORMQR_ called");
     return NULL;
 }
+*/
 
 void* SORMR2(void)
 {
@@ -12203,11 +12371,13 @@ void* SPORFS_(void)
     return NULL;
 }
 
+/*
 void* SPOSV(void)
 {
     if (verbose) puts("STUB: SPOSV called");
     return NULL;
 }
+*/
 
 void* SPOSVX(void)
 {
@@ -12221,35 +12391,45 @@ void* SPOSVX_(void)
     return NULL;
 }
 
+/*
 void* SPOSV_(void)
 {
     if (verbose) puts("STUB: SPOSV_ called");
     return NULL;
 }
+*/
 
+/*
 void* SPOTF2(void)
 {
     if (verbose) puts("STUB: SPOTF2 called");
     return NULL;
 }
+*/
 
+/*
 void* SPOTF2_(void)
 {
     if (verbose) puts("STUB: SPOTF2_ called");
     return NULL;
 }
+*/
 
+/*
 void* SPOTRF(void)
 {
     if (verbose) puts("STUB: SPOTRF called");
     return NULL;
 }
+*/
 
+/*
 void* SPOTRF_(void)
 {
     if (verbose) puts("STUB: SPOTRF_ called");
     return NULL;
 }
+*/
 
 void* SPOTRI(void)
 {
@@ -12263,17 +12443,21 @@ void* SPOTRI_(void)
     return NULL;
 }
 
+/*
 void* SPOTRS(void)
 {
     if (verbose) puts("STUB: SPOTRS called");
     return NULL;
 }
+*/
 
+/*
 void* SPOTRS_(void)
 {
     if (verbose) puts("STUB: SPOTRS_ called");
     return NULL;
 }
+*/
 
 void* SPPCON(void)
 {
@@ -12947,23 +13131,29 @@ void* SSYEQUB_(void)
     return NULL;
 }
 
+/*
 void* SSYEV(void)
 {
     if (verbose) puts("STUB: SSYEV called");
     return NULL;
 }
+*/
 
+/*
 void* SSYEVD(void)
 {
     if (verbose) puts("STUB: SSYEVD called");
     return NULL;
 }
+*/
 
+/*
 void* SSYEVD_(void)
 {
     if (verbose) puts("STUB: SSYEVD_ called");
     return NULL;
 }
+*/
 
 void* SSYEVR(void)
 {
@@ -12989,11 +13179,13 @@ void* SSYEVX_(void)
     return NULL;
 }
 
+/*
 void* SSYEV_(void)
 {
     if (verbose) puts("STUB: SSYEV_ called");
     return NULL;
 }
+*/
 
 void* SSYGS2(void)
 {
@@ -13511,17 +13703,21 @@ void* STRTI2_(void)
     return NULL;
 }
 
+/*
 void* STRTRI(void)
 {
     if (verbose) puts("STUB: STRTRI called");
     return NULL;
 }
+*/
 
+/*
 void* STRTRI_(void)
 {
     if (verbose) puts("STUB: STRTRI_ called");
     return NULL;
 }
+*/
 
 void* STRTRS(void)
 {
@@ -22157,17 +22353,21 @@ void* dgelqf_(void)
     return NULL;
 }
 
+/*
 void* dgels(void)
 {
     if (verbose) puts("STUB: dgels called");
     return NULL;
 }
+*/
 
+/*
 void* dgels_(void)
 {
     if (verbose) puts("STUB: dgels_ called");
     return NULL;
 }
+*/
 
 void* dgelsd(void)
 {
@@ -22265,29 +22465,37 @@ void* dgeqpf_(void)
     return NULL;
 }
 
+/*
 void* dgeqr2(void)
 {
     if (verbose) puts("STUB: dgeqr2 called");
     return NULL;
 }
+*/
 
+/*
 void* dgeqr2_(void)
 {
     if (verbose) puts("STUB: dgeqr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgeqrf(void)
 {
     if (verbose) puts("STUB: dgeqrf called");
     return NULL;
 }
+*/
 
+/*
 void* dgeqrf_(void)
 {
     if (verbose) puts("STUB: dgeqrf_ called");
     return NULL;
 }
+*/
 
 void* dgerfs(void)
 {
@@ -22337,41 +22545,53 @@ void* dgesc2_(void)
     return NULL;
 }
 
+/*
 void* dgesdd(void)
 {
     if (verbose) puts("STUB: dgesdd called");
     return NULL;
 }
+*/
 
+/*
 void* dgesdd_(void)
 {
     if (verbose) puts("STUB: dgesdd_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgesv(void)
 {
     if (verbose) puts("STUB: dgesv called");
     return NULL;
 }
+*/
 
+/*
 void* dgesv_(void)
 {
     if (verbose) puts("STUB: dgesv_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgesvd(void)
 {
     if (verbose) puts("STUB: dgesvd called");
     return NULL;
 }
+*/
 
+/*
 void* dgesvd_(void)
 {
     if (verbose) puts("STUB: dgesvd_ called");
     return NULL;
 }
+*/
 
 void* dgesvj(void)
 {
@@ -22409,53 +22629,69 @@ void* dgetc2_(void)
     return NULL;
 }
 
+/*
 void* dgetf2(void)
 {
     if (verbose) puts("STUB: dgetf2 called");
     return NULL;
 }
+*/
 
+/*
 void* dgetf2_(void)
 {
     if (verbose) puts("STUB: dgetf2_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgetrf(void)
 {
     if (verbose) puts("STUB: dgetrf called");
     return NULL;
 }
+*/
 
+/*
 void* dgetrf_(void)
 {
     if (verbose) puts("STUB: dgetrf_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgetri(void)
 {
     if (verbose) puts("STUB: dgetri called");
     return NULL;
 }
+*/
 
+/*
 void* dgetri_(void)
 {
     if (verbose) puts("STUB: dgetri_ called");
     return NULL;
 }
+*/
 
+/*
 void* dgetrs(void)
 {
     if (verbose) puts("STUB: dgetrs called");
     return NULL;
 }
+*/
 
+/*
 void* dgetrs_(void)
 {
     if (verbose) puts("STUB: dgetrs_ called");
     return NULL;
 }
+*/
 
 void* dggbak(void)
 {
@@ -23285,17 +23521,21 @@ void* dlamc5_(void)
     return NULL;
 }
 
+/*
 void* dlamch(void)
 {
     if (verbose) puts("STUB: dlamch called");
     return NULL;
 }
+*/
 
+/*
 void* dlamch_(void)
 {
     if (verbose) puts("STUB: dlamch_ called");
     return NULL;
 }
+*/
 
 void* dlamrg(void)
 {
@@ -23741,17 +23981,21 @@ void* dlarfb_(void)
     return NULL;
 }
 
+/*
 void* dlarfg(void)
 {
     if (verbose) puts("STUB: dlarfg called");
     return NULL;
 }
+*/
 
+/*
 void* dlarfg_(void)
 {
     if (verbose) puts("STUB: dlarfg_ called");
     return NULL;
 }
+*/
 
 void* dlarfp(void)
 {
@@ -24341,17 +24585,21 @@ void* dlasv2_(void)
     return NULL;
 }
 
+/*
 void* dlaswp(void)
 {
     if (verbose) puts("STUB: dlaswp called");
     return NULL;
 }
+*/
 
+/*
 void* dlaswp_(void)
 {
     if (verbose) puts("STUB: dlaswp_ called");
     return NULL;
 }
+*/
 
 void* dlasy2(void)
 {
@@ -24533,17 +24781,21 @@ void* dorg2l_(void)
     return NULL;
 }
 
+/*
 void* dorg2r(void)
 {
     if (verbose) puts("STUB: dorg2r called");
     return NULL;
 }
+*/
 
+/*
 void* dorg2r_(void)
 {
     if (verbose) puts("STUB: dorg2r_ called");
     return NULL;
 }
+*/
 
 void* dorgbr(void)
 {
@@ -24605,17 +24857,21 @@ void* dorgql_(void)
     return NULL;
 }
 
+/*
 void* dorgqr(void)
 {
     if (verbose) puts("STUB: dorgqr called");
     return NULL;
 }
+*/
 
+/*
 void* dorgqr_(void)
 {
     if (verbose) puts("STUB: dorgqr_ called");
     return NULL;
 }
+*/
 
 void* dorgr2(void)
 {
@@ -24665,17 +24921,21 @@ void* dorm2l_(void)
     return NULL;
 }
 
+/*
 void* dorm2r(void)
 {
     if (verbose) puts("STUB: dorm2r called");
     return NULL;
 }
+*/
 
+/*
 void* dorm2r_(void)
 {
     if (verbose) puts("STUB: dorm2r_ called");
     return NULL;
 }
+*/
 
 void* dormbr(void)
 {
@@ -24737,17 +24997,21 @@ void* dormql_(void)
     return NULL;
 }
 
+/*
 void* dormqr(void)
 {
     if (verbose) puts("STUB: dormqr called");
     return NULL;
 }
+*/
 
+/*
 void* dormqr_(void)
 {
     if (verbose) puts("STUB: dormqr_ called");
     return NULL;
 }
+*/
 
 void* dormr2(void)
 {
@@ -25001,17 +25265,21 @@ void* dporfs_(void)
     return NULL;
 }
 
+/*
 void* dposv(void)
 {
     if (verbose) puts("STUB: dposv called");
     return NULL;
 }
+*/
 
+/*
 void* dposv_(void)
 {
     if (verbose) puts("STUB: dposv_ called");
     return NULL;
 }
+*/
 
 void* dposvx(void)
 {
@@ -25025,29 +25293,37 @@ void* dposvx_(void)
     return NULL;
 }
 
+/*
 void* dpotf2(void)
 {
     if (verbose) puts("STUB: dpotf2 called");
     return NULL;
 }
+*/
 
+/*
 void* dpotf2_(void)
 {
     if (verbose) puts("STUB: dpotf2_ called");
     return NULL;
 }
+*/
 
+/*
 void* dpotrf(void)
 {
     if (verbose) puts("STUB: dpotrf called");
     return NULL;
 }
+*/
 
+/*
 void* dpotrf_(void)
 {
     if (verbose) puts("STUB: dpotrf_ called");
     return NULL;
 }
+*/
 
 void* dpotri(void)
 {
@@ -25061,17 +25337,21 @@ void* dpotri_(void)
     return NULL;
 }
 
+/*
 void* dpotrs(void)
 {
     if (verbose) puts("STUB: dpotrs called");
     return NULL;
 }
+*/
 
+/*
 void* dpotrs_(void)
 {
     if (verbose) puts("STUB: dpotrs_ called");
     return NULL;
 }
+*/
 
 void* dppcon(void)
 {
@@ -25769,29 +26049,37 @@ void* dsyequb_(void)
     return NULL;
 }
 
+/*
 void* dsyev(void)
 {
     if (verbose) puts("STUB: dsyev called");
     return NULL;
 }
+*/
 
+/*
 void* dsyev_(void)
 {
     if (verbose) puts("STUB: dsyev_ called");
     return NULL;
 }
+*/
 
+/*
 void* dsyevd(void)
 {
     if (verbose) puts("STUB: dsyevd called");
     return NULL;
 }
+*/
 
+/*
 void* dsyevd_(void)
 {
     if (verbose) puts("STUB: dsyevd_ called");
     return NULL;
 }
+*/
 
 void* dsyevr(void)
 {
@@ -26333,17 +26621,21 @@ void* dtrti2_(void)
     return NULL;
 }
 
+/*
 void* dtrtri(void)
 {
     if (verbose) puts("STUB: dtrtri called");
     return NULL;
 }
+*/
 
+/*
 void* dtrtri_(void)
 {
     if (verbose) puts("STUB: dtrtri_ called");
     return NULL;
 }
+*/
 
 void* dtrtrs(void)
 {
@@ -26501,17 +26793,21 @@ void* iladlr_(void)
     return NULL;
 }
 
+/*
 void* ilaenv(void)
 {
     if (verbose) puts("STUB: ilaenv called");
     return NULL;
 }
+*/
 
+/*
 void* ilaenv_(void)
 {
     if (verbose) puts("STUB: ilaenv_ called");
     return NULL;
 }
+*/
 
 void* ilaprec(void)
 {
@@ -27029,17 +27325,21 @@ void* sgelqf_(void)
     return NULL;
 }
 
+/*
 void* sgels(void)
 {
     if (verbose) puts("STUB: sgels called");
     return NULL;
 }
+*/
 
+/*
 void* sgels_(void)
 {
     if (verbose) puts("STUB: sgels_ called");
     return NULL;
 }
+*/
 
 void* sgelsd(void)
 {
@@ -27137,29 +27437,37 @@ void* sgeqpf_(void)
     return NULL;
 }
 
+/*
 void* sgeqr2(void)
 {
     if (verbose) puts("STUB: sgeqr2 called");
     return NULL;
 }
+*/
 
+/*
 void* sgeqr2_(void)
 {
     if (verbose) puts("STUB: sgeqr2_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgeqrf(void)
 {
     if (verbose) puts("STUB: sgeqrf called");
     return NULL;
 }
+*/
 
+/*
 void* sgeqrf_(void)
 {
     if (verbose) puts("STUB: sgeqrf_ called");
     return NULL;
 }
+*/
 
 void* sgerfs(void)
 {
@@ -27209,41 +27517,53 @@ void* sgesc2_(void)
     return NULL;
 }
 
+/*
 void* sgesdd(void)
 {
     if (verbose) puts("STUB: sgesdd called");
     return NULL;
 }
+*/
 
+/*
 void* sgesdd_(void)
 {
     if (verbose) puts("STUB: sgesdd_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgesv(void)
 {
     if (verbose) puts("STUB: sgesv called");
     return NULL;
 }
+*/
 
+/*
 void* sgesv_(void)
 {
     if (verbose) puts("STUB: sgesv_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgesvd(void)
 {
     if (verbose) puts("STUB: sgesvd called");
     return NULL;
 }
+*/
 
+/*
 void* sgesvd_(void)
 {
     if (verbose) puts("STUB: sgesvd_ called");
     return NULL;
 }
+*/
 
 void* sgesvj(void)
 {
@@ -27281,53 +27601,69 @@ void* sgetc2_(void)
     return NULL;
 }
 
+/*
 void* sgetf2(void)
 {
     if (verbose) puts("STUB: sgetf2 called");
     return NULL;
 }
+*/
 
+/*
 void* sgetf2_(void)
 {
     if (verbose) puts("STUB: sgetf2_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgetrf(void)
 {
     if (verbose) puts("STUB: sgetrf called");
     return NULL;
 }
+*/
 
+/*
 void* sgetrf_(void)
 {
     if (verbose) puts("STUB: sgetrf_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgetri(void)
 {
     if (verbose) puts("STUB: sgetri called");
     return NULL;
 }
+*/
 
+/*
 void* sgetri_(void)
 {
     if (verbose) puts("STUB: sgetri_ called");
     return NULL;
 }
+*/
 
+/*
 void* sgetrs(void)
 {
     if (verbose) puts("STUB: sgetrs called");
     return NULL;
 }
+*/
 
+/*
 void* sgetrs_(void)
 {
     if (verbose) puts("STUB: sgetrs_ called");
     return NULL;
 }
+*/
 
 void* sggbak(void)
 {
@@ -28157,17 +28493,21 @@ void* slamc5_(void)
     return NULL;
 }
 
+/*
 void* slamch(void)
 {
     if (verbose) puts("STUB: slamch called");
     return NULL;
 }
+*/
 
+/*
 void* slamch_(void)
 {
     if (verbose) puts("STUB: slamch_ called");
     return NULL;
 }
+*/
 
 void* slamrg(void)
 {
@@ -28613,17 +28953,21 @@ void* slarfb_(void)
     return NULL;
 }
 
+/*
 void* slarfg(void)
 {
     if (verbose) puts("STUB: slarfg called");
     return NULL;
 }
+*/
 
+/*
 void* slarfg_(void)
 {
     if (verbose) puts("STUB: slarfg_ called");
     return NULL;
 }
+*/
 
 void* slarfp(void)
 {
@@ -29213,17 +29557,21 @@ void* slasv2_(void)
     return NULL;
 }
 
+/*
 void* slaswp(void)
 {
     if (verbose) puts("STUB: slaswp called");
     return NULL;
 }
+*/
 
+/*
 void* slaswp_(void)
 {
     if (verbose) puts("STUB: slaswp_ called");
     return NULL;
 }
+*/
 
 void* slasy2(void)
 {
@@ -29405,17 +29753,21 @@ void* sorg2l_(void)
     return NULL;
 }
 
+/*
 void* sorg2r(void)
 {
     if (verbose) puts("STUB: sorg2r called");
     return NULL;
 }
+*/
 
+/*
 void* sorg2r_(void)
 {
     if (verbose) puts("STUB: sorg2r_ called");
     return NULL;
 }
+*/
 
 void* sorgbr(void)
 {
@@ -29477,17 +29829,21 @@ void* sorgql_(void)
     return NULL;
 }
 
+/*
 void* sorgqr(void)
 {
     if (verbose) puts("STUB: sorgqr called");
     return NULL;
 }
+*/
 
+/*
 void* sorgqr_(void)
 {
     if (verbose) puts("STUB: sorgqr_ called");
     return NULL;
 }
+*/
 
 void* sorgr2(void)
 {
@@ -29537,17 +29893,21 @@ void* sorm2l_(void)
     return NULL;
 }
 
+/*
 void* sorm2r(void)
 {
     if (verbose) puts("STUB: sorm2r called");
     return NULL;
 }
+*/
 
+/*
 void* sorm2r_(void)
 {
     if (verbose) puts("STUB: sorm2r_ called");
     return NULL;
 }
+*/
 
 void* sormbr(void)
 {
@@ -29609,17 +29969,21 @@ void* sormql_(void)
     return NULL;
 }
 
+/*
 void* sormqr(void)
 {
     if (verbose) puts("STUB: sormqr called");
     return NULL;
 }
+*/
 
+/*
 void* sormqr_(void)
 {
     if (verbose) puts("STUB: sormqr_ called");
     return NULL;
 }
+*/
 
 void* sormr2(void)
 {
@@ -29873,17 +30237,21 @@ void* sporfs_(void)
     return NULL;
 }
 
+/*
 void* sposv(void)
 {
     if (verbose) puts("STUB: sposv called");
     return NULL;
 }
+*/
 
+/*
 void* sposv_(void)
 {
     if (verbose) puts("STUB: sposv_ called");
     return NULL;
 }
+*/
 
 void* sposvx(void)
 {
@@ -29897,29 +30265,37 @@ void* sposvx_(void)
     return NULL;
 }
 
+/*
 void* spotf2(void)
 {
     if (verbose) puts("STUB: spotf2 called");
     return NULL;
 }
+*/
 
+/*
 void* spotf2_(void)
 {
     if (verbose) puts("STUB: spotf2_ called");
     return NULL;
 }
+*/
 
+/*
 void* spotrf(void)
 {
     if (verbose) puts("STUB: spotrf called");
     return NULL;
 }
+*/
 
+/*
 void* spotrf_(void)
 {
     if (verbose) puts("STUB: spotrf_ called");
     return NULL;
 }
+*/
 
 void* spotri(void)
 {
@@ -29933,17 +30309,21 @@ void* spotri_(void)
     return NULL;
 }
 
+/*
 void* spotrs(void)
 {
     if (verbose) puts("STUB: spotrs called");
     return NULL;
 }
+*/
 
+/*
 void* spotrs_(void)
 {
     if (verbose) puts("STUB: spotrs_ called");
     return NULL;
 }
+*/
 
 void* sppcon(void)
 {
@@ -30617,29 +30997,37 @@ void* ssyequb_(void)
     return NULL;
 }
 
+/*
 void* ssyev(void)
 {
     if (verbose) puts("STUB: ssyev called");
     return NULL;
 }
+*/
 
+/*
 void* ssyev_(void)
 {
     if (verbose) puts("STUB: ssyev_ called");
     return NULL;
 }
+*/
 
+/*
 void* ssyevd(void)
 {
     if (verbose) puts("STUB: ssyevd called");
     return NULL;
 }
+*/
 
+/*
 void* ssyevd_(void)
 {
     if (verbose) puts("STUB: ssyevd_ called");
     return NULL;
 }
+*/
 
 void* ssyevr(void)
 {
@@ -31181,17 +31569,21 @@ void* strti2_(void)
     return NULL;
 }
 
+/*
 void* strtri(void)
 {
     if (verbose) puts("STUB: strtri called");
     return NULL;
 }
+*/
 
+/*
 void* strtri_(void)
 {
     if (verbose) puts("STUB: strtri_ called");
     return NULL;
 }
+*/
 
 void* strtrs(void)
 {
@@ -0,0 +1,107 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "lapack_internal.h"
+#include <float.h>
+#include <string.h>
+
+void lapack_param_error(const char* routine, int pos)
+{
+	xerbla_(routine, &pos);
+}
+
+// Machine parameters, see xLAMCH. Single precision ones are returned as double too, following
+// the f2c convention for REAL functions.
+
+static double lamch(const char* cmach, double eps, double sfmin, int digits, int emin, int emax, double rmax)
+{
+	if (lsame_(cmach, "E"))
+		return eps;
+	if (lsame_(cmach, "S"))
+		return sfmin;
+	if (lsame_(cmach, "B"))
+		return FLT_RADIX;
+	if (lsame_(cmach, "P"))
+		return eps * FLT_RADIX;
+	if (lsame_(cmach, "N"))
+		return digits;
+	if (lsame_(cmach, "R"))
+		return 1;
+	if (lsame_(cmach, "M"))
+		return emin;
+	if (lsame_(cmach, "U"))
+		return sfmin;
+	if (lsame_(cmach, "L"))
+		return emax;
+	if (lsame_(cmach, "O"))
+		return rmax;
+	return 0;
+}
+
+__CLPK_doublereal slamch_(char *__cmach)
+{
+	return lamch(__cmach, FLT_EPSILON * 0.5, FLT_MIN, FLT_MANT_DIG, FLT_MIN_EXP, FLT_MAX_EXP, FLT_MAX);
+}
+LAPACK_ALIASES(__CLPK_doublereal, slamch_, slamch, SLAMCH, SLAMCH_, (char *__cmach), (__cmach))
+
+__CLPK_doublereal dlamch_(char *__cmach)
+{
+	return lamch(__cmach, DBL_EPSILON * 0.5, DBL_MIN, DBL_MANT_DIG, DBL_MIN_EXP, DBL_MAX_EXP, DBL_MAX);
+}
+LAPACK_ALIASES(__CLPK_doublereal, dlamch_, dlamch, DLAMCH, DLAMCH_, (char *__cmach), (__cmach))
+
+// Tuning parameters. The routines here pick their own block sizes, these are only for
+// callers that size their workspace or blocking after them.
+__CLPK_integer ilaenv_(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4)
+{
+	(void)__name;
+	(void)__opts;
+	(void)__n3;
+	(void)__n4;
+
+	switch (*__ispec)
+	{
+		case 1: // block size
+			return LAPACK_NB;
+		case 2: // minimum block size
+			return 2;
+		case 3: // crossover point to unblocked code
+			return 128;
+		case 4: // number of shifts, used in xHSEQR
+			return 6;
+		case 5: // minimum column dimension for blocking
+			return 2;
+		case 6: // crossover point for SVD
+			return (int) (MIN(*__n1, *__n2) * 1.6);
+		case 7: // number of processors
+			return APPLE_NTHREADS();
+		case 8: // crossover point for multishift QR
+			return 50;
+		case 9: // size of the subproblems in divide and conquer
+			return 25;
+		case 10: // IEEE NaN arithmetic can be trusted
+		case 11: // infinity arithmetic can be trusted
+			return 1;
+		default:
+			return -1;
+	}
+}
+LAPACK_ALIASES(__CLPK_integer, ilaenv_, ilaenv, ILAENV, ILAENV_,
+	(__CLPK_integer *__ispec, char *__name, char *__opts, __CLPK_integer *__n1, __CLPK_integer *__n2, __CLPK_integer *__n3, __CLPK_integer *__n4),
+	(__ispec, __name, __opts, __n1, __n2, __n3, __n4))
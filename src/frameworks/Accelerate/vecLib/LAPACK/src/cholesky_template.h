@@ -0,0 +1,195 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Cholesky factorization and solves, included by cholesky.c through lapack_instantiate.h.
+//
+// xPOTRF is recursive like xGETRF: with A = [A11 A12; A21 A22], factor A11, solve for the
+// off-diagonal block with TRSM, update A22 with SYRK and factor it.
+
+#define CHOLESKY_BASE 16
+
+// Unblocked, column by column. Returns INFO.
+static int PFX(potf2_impl)(bool upper, int n, REAL* a, int lda)
+{
+	for (int j = 0; j < n; j++)
+	{
+		REAL* ajj = a + j + (size_t) j * lda;
+
+		if (upper)
+		{
+			// U(j,j) and row j of U from the columns above it
+			REAL* colj = a + (size_t) j * lda;
+			const REAL d = *ajj - CBLAS(dot)(j, colj, 1, colj, 1);
+
+			if (!(d > 0))
+			{
+				*ajj = d;
+				return j + 1;
+			}
+
+			*ajj = SQRT(d);
+			if (j < n - 1)
+			{
+				CBLAS(gemv)(CblasColMajor, CblasTrans, j, n - j - 1, -1, a + (size_t) (j + 1) * lda, lda,
+					colj, 1, 1, ajj + lda, lda);
+				CBLAS(scal)(n - j - 1, 1 / *ajj, ajj + lda, lda);
+			}
+		}
+		else
+		{
+			REAL* rowj = a + j;
+			const REAL d = *ajj - CBLAS(dot)(j, rowj, lda, rowj, lda);
+
+			if (!(d > 0))
+			{
+				*ajj = d;
+				return j + 1;
+			}
+
+			*ajj = SQRT(d);
+			if (j < n - 1)
+			{
+				CBLAS(gemv)(CblasColMajor, CblasNoTrans, n - j - 1, j, -1, a + j + 1, lda,
+					rowj, lda, 1, ajj + 1, 1);
+				CBLAS(scal)(n - j - 1, 1 / *ajj, ajj + 1, 1);
+			}
+		}
+	}
+
+	return 0;
+}
+
+int PFX(potrf_impl)(bool upper, int n, REAL* a, int lda)
+{
+	if (n <= CHOLESKY_BASE)
+		return PFX(potf2_impl)(upper, n, a, lda);
+
+	const int n1 = n / 2, n2 = n - n1;
+	REAL* a22 = a + n1 + (size_t) n1 * lda;
+
+	int info = PFX(potrf_impl)(upper, n1, a, lda);
+	if (info != 0)
+		return info;
+
+	if (upper)
+	{
+		// U12 := U11^-T * A12, A22 := A22 - U12^T * U12
+		REAL* a12 = a + (size_t) n1 * lda;
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, n1, n2, 1, a, lda, a12, lda);
+		CBLAS(syrk)(CblasColMajor, CblasUpper, CblasTrans, n2, n1, -1, a12, lda, 1, a22, lda);
+	}
+	else
+	{
+		// L21 := A21 * L11^-T, A22 := A22 - L21 * L21^T
+		REAL* a21 = a + n1;
+		CBLAS(trsm)(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasNonUnit, n2, n1, 1, a, lda, a21, lda);
+		CBLAS(syrk)(CblasColMajor, CblasLower, CblasNoTrans, n2, n1, -1, a21, lda, 1, a22, lda);
+	}
+
+	info = PFX(potrf_impl)(upper, n2, a22, lda);
+	return info != 0 ? info + n1 : 0;
+}
+
+static void PFX(potrs_impl)(bool upper, int n, int nrhs, const REAL* a, int lda, REAL* b, int ldb)
+{
+	if (upper)
+	{
+		// A = U^T * U
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+	}
+	else
+	{
+		// A = L * L^T
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+	}
+}
+
+int F(potf2_)(char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(POTF2);
+	const bool upper = lsame_(__uplo, "U");
+
+	CHECK(upper || lsame_(__uplo, "L"), 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__n), 4);
+
+	*__info = PFX(potf2_impl)(upper, *__n, __a, *__lda);
+	return 0;
+}
+LAPACK_ALIASES(int, F(potf2_), F(potf2), FU(POTF2), FU(POTF2_),
+	(char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info),
+	(__uplo, __n, __a, __lda, __info))
+
+int F(potrf_)(char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(POTRF);
+	const bool upper = lsame_(__uplo, "U");
+
+	CHECK(upper || lsame_(__uplo, "L"), 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__n), 4);
+
+	*__info = PFX(potrf_impl)(upper, *__n, __a, *__lda);
+	return 0;
+}
+LAPACK_ALIASES(int, F(potrf_), F(potrf), FU(POTRF), FU(POTRF_),
+	(char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info),
+	(__uplo, __n, __a, __lda, __info))
+
+int F(potrs_)(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(POTRS);
+	const bool upper = lsame_(__uplo, "U");
+
+	CHECK(upper || lsame_(__uplo, "L"), 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__nrhs >= 0, 3);
+	CHECK(*__lda >= MAX1(*__n), 5);
+	CHECK(*__ldb >= MAX1(*__n), 7);
+
+	*__info = 0;
+	if (*__n > 0 && *__nrhs > 0)
+		PFX(potrs_impl)(upper, *__n, *__nrhs, __a, *__lda, __b, *__ldb);
+	return 0;
+}
+LAPACK_ALIASES(int, F(potrs_), F(potrs), FU(POTRS), FU(POTRS_),
+	(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info),
+	(__uplo, __n, __nrhs, __a, __lda, __b, __ldb, __info))
+
+int F(posv_)(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(POSV);
+	const bool upper = lsame_(__uplo, "U");
+
+	CHECK(upper || lsame_(__uplo, "L"), 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__nrhs >= 0, 3);
+	CHECK(*__lda >= MAX1(*__n), 5);
+	CHECK(*__ldb >= MAX1(*__n), 7);
+
+	*__info = PFX(potrf_impl)(upper, *__n, __a, *__lda);
+	if (*__info == 0 && *__n > 0 && *__nrhs > 0)
+		PFX(potrs_impl)(upper, *__n, *__nrhs, __a, *__lda, __b, *__ldb);
+	return 0;
+}
+LAPACK_ALIASES(int, F(posv_), F(posv), FU(POSV), FU(POSV_),
+	(char *__uplo, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info),
+	(__uplo, __n, __nrhs, __a, __lda, __b, __ldb, __info))
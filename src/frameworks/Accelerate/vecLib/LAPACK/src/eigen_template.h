@@ -0,0 +1,469 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Symmetric eigenvalue problems, included by eigen.c through lapack_instantiate.h.
+//
+// A is reduced to tridiagonal form T = Q^T * A * Q with Householder reflectors (xSYTRD, whose
+// trailing updates are SYR2Ks over panels of LAPACK_NB columns), Q is formed explicitly with
+// xORGQR and the eigenvalues of T are found with the implicit QL algorithm, rotating Q into the
+// eigenvectors as it goes. xSYEVD shares this path instead of using divide and conquer, its
+// results are the same up to rounding.
+
+// Reduces the lower triangle of A to tridiagonal form with the diagonal in d, the subdiagonal
+// in e and the reflectors below the subdiagonal like xSYTD2. `work` has n elements.
+static void PFX(sytd2_lower)(int n, REAL* a, int lda, REAL* d, REAL* e, REAL* tau, REAL* work)
+{
+	for (int i = 0; i < n - 1; i++)
+	{
+		REAL* sub = a + i + 1 + (size_t) i * lda;
+		REAL* a22 = sub + lda;
+		const int len = n - i - 1;
+		REAL taui;
+
+		// H(i) annihilates A(i+2:n,i)
+		PFX(larfg_impl)(len, sub, sub + MIN(1, len - 1), 1, &taui);
+		e[i] = *sub;
+
+		if (taui != 0)
+		{
+			// x := tau * A22 * v, w := x - (tau / 2) * (x^T * v) * v, A22 := A22 - v * w^T - w * v^T
+			*sub = 1;
+			CBLAS(symv)(CblasColMajor, CblasLower, len, taui, a22, lda, sub, 1, 0, work, 1);
+
+			const REAL alpha = -(REAL) 0.5 * taui * CBLAS(dot)(len, work, 1, sub, 1);
+			CBLAS(axpy)(len, alpha, sub, 1, work, 1);
+			CBLAS(syr2)(CblasColMajor, CblasLower, len, -1, sub, 1, work, 1, a22, lda);
+			*sub = e[i];
+		}
+
+		d[i] = a[i + (size_t) i * lda];
+		tau[i] = taui;
+	}
+
+	d[n - 1] = a[(n - 1) + (size_t) (n - 1) * lda];
+}
+
+// Reduces the first nb columns of the lower triangle of the n x n A like xLATRD, leaving the
+// trailing matrix alone: A(nb:n,nb:n) still has to be updated with -V * W^T - W * V^T, where V
+// are the reflectors (with their unit elements stored) and W the n x nb matrix returned in w.
+static void PFX(latrd_lower)(int n, int nb, REAL* a, int lda, REAL* e, REAL* tau, REAL* w, int ldw)
+{
+	for (int i = 0; i < nb; i++)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+		REAL* sub = aii + 1;
+		REAL* wsub = w + i + 1 + (size_t) i * ldw;
+		REAL* wtop = w + (size_t) i * ldw;
+		const int len = n - i - 1;
+
+		// bring A(i:n,i) up to date with the reflectors of this panel
+		if (i > 0)
+		{
+			CBLAS(gemv)(CblasColMajor, CblasNoTrans, len + 1, i, -1, a + i, lda, w + i, ldw, 1, aii, 1);
+			CBLAS(gemv)(CblasColMajor, CblasNoTrans, len + 1, i, -1, w + i, ldw, a + i, lda, 1, aii, 1);
+		}
+
+		// H(i) annihilates A(i+2:n,i)
+		PFX(larfg_impl)(len, sub, sub + MIN(1, len - 1), 1, &tau[i]);
+		e[i] = *sub;
+		*sub = 1;
+
+		// W(i+1:n,i) := tau * (A22 - V * W^T - W * V^T) * v, with W(0:i,i) as scratch
+		CBLAS(symv)(CblasColMajor, CblasLower, len, 1, sub + lda, lda, sub, 1, 0, wsub, 1);
+		if (i > 0)
+		{
+			CBLAS(gemv)(CblasColMajor, CblasTrans, len, i, 1, w + i + 1, ldw, sub, 1, 0, wtop, 1);
+			CBLAS(gemv)(CblasColMajor, CblasNoTrans, len, i, -1, a + i + 1, lda, wtop, 1, 1, wsub, 1);
+			CBLAS(gemv)(CblasColMajor, CblasTrans, len, i, 1, a + i + 1, lda, sub, 1, 0, wtop, 1);
+			CBLAS(gemv)(CblasColMajor, CblasNoTrans, len, i, -1, w + i + 1, ldw, wtop, 1, 1, wsub, 1);
+		}
+		CBLAS(scal)(len, tau[i], wsub, 1);
+
+		const REAL alpha = -(REAL) 0.5 * tau[i] * CBLAS(dot)(len, wsub, 1, sub, 1);
+		CBLAS(axpy)(len, alpha, sub, 1, wsub, 1);
+	}
+}
+
+// The blocked sytd2_lower. Panels of LAPACK_NB columns are reduced with latrd_lower and
+// the trailing matrix is updated with SYR2K; the last columns and the case where W can't be
+// allocated are left to sytd2_lower.
+static void PFX(sytrd_lower)(int n, REAL* a, int lda, REAL* d, REAL* e, REAL* tau, REAL* work)
+{
+	const int nb = LAPACK_NB;
+	REAL* w = NULL;
+	int i = 0;
+
+	if (n > 2 * nb)
+		w = (REAL*) malloc(sizeof(REAL) * (size_t) n * nb);
+
+	for (; w && n - i > 2 * nb; i += nb)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+		const int ldw = n - i;
+
+		PFX(latrd_lower)(n - i, nb, aii, lda, e + i, tau + i, w, ldw);
+		CBLAS(syr2k)(CblasColMajor, CblasLower, CblasNoTrans, n - i - nb, nb, -1, aii + nb, lda,
+			w + nb, ldw, 1, aii + nb + (size_t) nb * lda, lda);
+
+		for (int j = i; j < i + nb; j++)
+		{
+			a[j + 1 + (size_t) j * lda] = e[j];
+			d[j] = a[j + (size_t) j * lda];
+		}
+	}
+
+	free(w);
+	PFX(sytd2_lower)(n - i, a + i + (size_t) i * lda, lda, d + i, e + i, tau + i, work);
+}
+
+// Forms the Q of sytrd_lower in A. The reflectors are those of a QR factorization of
+// A(1:n,0:n-1), so they are shifted one column to the right and handed to xORGQR.
+static void PFX(orgtr_lower)(int n, REAL* a, int lda, const REAL* tau, REAL* work)
+{
+	for (int j = n - 1; j > 0; j--)
+	{
+		REAL* col = a + (size_t) j * lda;
+
+		col[0] = 0;
+		for (int i = j + 1; i < n; i++)
+			col[i] = col[i - lda];
+	}
+
+	a[0] = 1;
+	for (int i = 1; i < n; i++)
+		a[i] = 0;
+
+	if (n > 1)
+		PFX(orgqr_impl)(n - 1, n - 1, n - 1, a + 1 + lda, lda, tau, work);
+}
+
+// A batch holds several sweeps of the QR iterations, this many rotations per column of z. It
+// is applied to blocks of rows of about ROTATIONS_BLOCK elements, which stay in cache while all
+// of its rotations go through them, instead of z being swept once per rotation.
+#define ROTATIONS_PER_COLUMN 64
+#define ROTATIONS_BLOCK 32768
+
+void PFX(rotations_init)(struct PFX(rotations)* r, REAL* z, int m, int n, int ldz)
+{
+	r->z = z;
+	r->m = m;
+	r->n = n;
+	r->ldz = ldz;
+	r->count = 0;
+	r->capacity = 0;
+	r->cols = NULL;
+	r->cs = NULL;
+
+	if (!z || m == 0)
+	{
+		r->z = NULL;
+		return;
+	}
+
+	const size_t capacity = (size_t) ROTATIONS_PER_COLUMN * MAX1(n);
+
+	r->cols = (int*) malloc(sizeof(int) * 2 * capacity);
+	r->cs = (REAL*) malloc(sizeof(REAL) * 2 * capacity);
+	if (r->cols && r->cs)
+		r->capacity = capacity;
+}
+
+static void PFX(rotations_apply)(struct PFX(rotations)* r)
+{
+	const int mb = MAX(8, ROTATIONS_BLOCK / MAX1(r->n));
+
+	for (int i0 = 0; i0 < r->m; i0 += mb)
+	{
+		const int rows = MIN(mb, r->m - i0);
+
+		for (int k = 0; k < r->count; k++)
+		{
+			REAL* restrict x = r->z + i0 + (size_t) r->cols[2 * k] * r->ldz;
+			REAL* restrict y = r->z + i0 + (size_t) r->cols[2 * k + 1] * r->ldz;
+			const REAL c = r->cs[2 * k], s = r->cs[2 * k + 1];
+
+			#pragma clang loop vectorize(enable)
+			for (int i = 0; i < rows; i++)
+			{
+				const REAL t = c * x[i] + s * y[i];
+				y[i] = c * y[i] - s * x[i];
+				x[i] = t;
+			}
+		}
+	}
+
+	r->count = 0;
+}
+
+void PFX(rotations_add)(struct PFX(rotations)* r, int x, int y, REAL c, REAL s)
+{
+	if (!r->z || (c == 1 && s == 0))
+		return;
+
+	if (r->capacity == 0)
+	{
+		CBLAS(rot)(r->m, r->z + (size_t) x * r->ldz, 1, r->z + (size_t) y * r->ldz, 1, c, s);
+		return;
+	}
+
+	if (r->count == r->capacity)
+		PFX(rotations_apply)(r);
+
+	r->cols[2 * r->count] = x;
+	r->cols[2 * r->count + 1] = y;
+	r->cs[2 * r->count] = c;
+	r->cs[2 * r->count + 1] = s;
+	r->count++;
+}
+
+void PFX(rotations_finish)(struct PFX(rotations)* r)
+{
+	if (r->count)
+		PFX(rotations_apply)(r);
+
+	free(r->cols);
+	free(r->cs);
+	r->cols = NULL;
+	r->cs = NULL;
+	r->capacity = 0;
+}
+
+// The implicit QL algorithm with Wilkinson shifts on the tridiagonal matrix with diagonal d
+// and subdiagonal e (destroyed), after EISPACK's tql2. The rotations are applied to the
+// columns of z if it isn't NULL. Eigenvalues (and vectors) end up in ascending order.
+// Returns LAPACK's INFO: 0, or the number of subdiagonal elements that didn't converge.
+static int PFX(steql)(int n, REAL* d, REAL* e, REAL* z, int ldz)
+{
+	struct PFX(rotations) rot;
+	REAL f = 0, tst1 = 0;
+
+	if (n == 0)
+		return 0;
+	e[n - 1] = 0;
+	PFX(rotations_init)(&rot, z, n, n, ldz);
+
+	for (int l = 0; l < n; l++)
+	{
+		int m = l, iter = 0;
+
+		tst1 = MAX(tst1, ABS(d[l]) + ABS(e[l]));
+		while (ABS(e[m]) > EPS * tst1)
+			m++;
+
+		while (m > l)
+		{
+			if (++iter > 30)
+			{
+				int info = 0;
+				for (int i = 0; i < n - 1; i++)
+				{
+					if (e[i] != 0)
+						info++;
+				}
+				PFX(rotations_finish)(&rot);
+				return info;
+			}
+
+			// shift from the leading 2x2 block
+			REAL g = d[l];
+			REAL p = (d[l + 1] - g) / (2 * e[l]);
+			REAL r = copysign(HYPOT(p, 1), p);
+
+			d[l] = e[l] / (p + r);
+			d[l + 1] = e[l] * (p + r);
+
+			const REAL dl1 = d[l + 1];
+			REAL h = g - d[l];
+
+			for (int i = l + 2; i < n; i++)
+				d[i] -= h;
+			f += h;
+
+			// QL transformation
+			p = d[m];
+			REAL c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+			const REAL el1 = e[l + 1];
+
+			for (int i = m - 1; i >= l; i--)
+			{
+				c3 = c2;
+				c2 = c;
+				s2 = s;
+				g = c * e[i];
+				h = c * p;
+				r = HYPOT(p, e[i]);
+				e[i + 1] = s * r;
+				s = e[i] / r;
+				c = p / r;
+				p = c * d[i] - s * g;
+				d[i + 1] = h + s * (c * g + s * d[i]);
+
+				PFX(rotations_add)(&rot, i + 1, i, c, s);
+			}
+
+			p = -s * s2 * c3 * el1 * e[l] / dl1;
+			e[l] = s * p;
+			d[l] = c * p;
+
+			if (ABS(e[l]) <= EPS * tst1)
+				break;
+		}
+
+		d[l] += f;
+		e[l] = 0;
+	}
+
+	PFX(rotations_finish)(&rot);
+
+	// selection sort, which swaps each eigenvector at most once
+	for (int i = 0; i < n - 1; i++)
+	{
+		int k = i;
+
+		for (int j = i + 1; j < n; j++)
+		{
+			if (d[j] < d[k])
+				k = j;
+		}
+
+		if (k != i)
+		{
+			const REAL t = d[k];
+			d[k] = d[i];
+			d[i] = t;
+
+			if (z)
+				CBLAS(swap)(n, z + (size_t) i * ldz, 1, z + (size_t) k * ldz, 1);
+		}
+	}
+
+	return 0;
+}
+
+// `work` has 3n-1 elements. Returns LAPACK's INFO.
+static int PFX(syev_impl)(bool vectors, bool upper, int n, REAL* a, int lda, REAL* w, REAL* work)
+{
+	if (n == 1)
+	{
+		w[0] = a[0];
+		if (vectors)
+			a[0] = 1;
+		return 0;
+	}
+
+	// the reduction works on the lower triangle
+	if (upper)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			for (int i = j + 1; i < n; i++)
+				a[i + (size_t) j * lda] = a[j + (size_t) i * lda];
+		}
+	}
+
+	REAL* e = work;
+	REAL* tau = work + n;
+	REAL* scratch = work + 2 * n - 1;
+
+	PFX(sytrd_lower)(n, a, lda, w, e, tau, scratch);
+
+	if (!vectors)
+		return PFX(steql)(n, w, e, NULL, 0);
+
+	PFX(orgtr_lower)(n, a, lda, tau, scratch);
+	return PFX(steql)(n, w, e, a, lda);
+}
+
+int F(syev_)(char *__jobz, char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__w, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(SYEV);
+	const bool vectors = lsame_(__jobz, "V");
+	const bool upper = lsame_(__uplo, "U");
+	const int minwork = MAX1(3 * *__n - 1);
+
+	*__work = (REAL) minwork;
+
+	CHECK(vectors || lsame_(__jobz, "N"), 1);
+	CHECK(upper || lsame_(__uplo, "L"), 2);
+	CHECK(*__n >= 0, 3);
+	CHECK(*__lda >= MAX1(*__n), 5);
+	CHECK(*__lwork >= minwork || *__lwork == -1, 8);
+
+	*__info = 0;
+	if (*__lwork != -1 && *__n > 0)
+		*__info = PFX(syev_impl)(vectors, upper, *__n, __a, *__lda, __w, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(syev_), F(syev), FU(SYEV), FU(SYEV_),
+	(char *__jobz, char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__w, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__jobz, __uplo, __n, __a, __lda, __w, __work, __lwork, __info))
+
+int F(syevd_)(char *__jobz, char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__w, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(SYEVD);
+	const bool vectors = lsame_(__jobz, "V");
+	const bool upper = lsame_(__uplo, "U");
+	const int n = *__n;
+	int minwork = 1, miniwork = 1;
+
+	// the reference's minimum workspace, so that callers sizing it for that still work here
+	if (n > 1)
+	{
+		minwork = vectors ? 1 + 6 * n + 2 * n * n : 2 * n + 1;
+		miniwork = vectors ? 3 + 5 * n : 1;
+	}
+
+	*__work = (REAL) minwork;
+	*__iwork = miniwork;
+
+	CHECK(vectors || lsame_(__jobz, "N"), 1);
+	CHECK(upper || lsame_(__uplo, "L"), 2);
+	CHECK(n >= 0, 3);
+	CHECK(*__lda >= MAX1(n), 5);
+	CHECK(*__lwork >= minwork || *__lwork == -1, 8);
+	CHECK(*__liwork >= miniwork || *__liwork == -1, 10);
+
+	*__info = 0;
+	if (*__lwork == -1 || *__liwork == -1 || n == 0)
+		return 0;
+
+	if (!vectors && n > 1)
+	{
+		// only 2n+1 elements, less than syev_impl wants: the reflectors aren't needed, so
+		// reduce with their storage overlapping the scratch space
+		if (upper)
+		{
+			for (int j = 0; j < n; j++)
+			{
+				for (int i = j + 1; i < n; i++)
+					__a[i + (size_t) j * *__lda] = __a[j + (size_t) i * *__lda];
+			}
+		}
+
+		PFX(sytrd_lower)(n, __a, *__lda, __w, __work, __work + n, __work + n + 1);
+		*__info = PFX(steql)(n, __w, __work, NULL, 0);
+		return 0;
+	}
+
+	*__info = PFX(syev_impl)(vectors, upper, n, __a, *__lda, __w, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(syevd_), F(syevd), FU(SYEVD), FU(SYEVD_),
+	(char *__jobz, char *__uplo, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__w, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__liwork, __CLPK_integer *__info),
+	(__jobz, __uplo, __n, __a, __lda, __w, __work, __lwork, __iwork, __liwork, __info))
@@ -0,0 +1,59 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Implementations shared between the files of this library, included by lapack_internal.h
+// with REAL and PFX(name) defined for float and double. Matrices are column-major, indices
+// 0-based except for pivot arrays, which keep LAPACK's 1-based values.
+
+// Returns LAPACK's INFO: 0, or the 1-based index of the first zero pivot
+int PFX(getrf_impl)(int m, int n, REAL* a, int lda, int* ipiv);
+// Returns LAPACK's INFO: 0, or the order of the first minor that isn't positive definite
+int PFX(potrf_impl)(bool upper, int n, REAL* a, int lda);
+
+// Generates an elementary reflector H such that H * (alpha, x) = (beta, 0), see xLARFG
+void PFX(larfg_impl)(int n, REAL* alpha, REAL* x, int incx, REAL* tau);
+// Applies H = I - tau * v * v^T to the m x n matrix C from the left or the right.
+// `work` has n (left) or m (right) elements.
+void PFX(larf_impl)(bool left, int m, int n, const REAL* v, int incv, REAL tau, REAL* c, int ldc, REAL* work);
+
+// QR factorization and the application or generation of Q. `work` has at least n (geqrf,
+// orgqr) or the size of the side of C that Q is applied to (ormqr) elements; the blocked
+// algorithms allocate their own workspace and only fall back to `work` without memory.
+void PFX(geqrf_impl)(int m, int n, REAL* a, int lda, REAL* tau, REAL* work);
+void PFX(orgqr_impl)(int m, int n, int k, REAL* a, int lda, const REAL* tau, REAL* work);
+void PFX(ormqr_impl)(bool left, bool trans, int m, int n, int k, const REAL* a, int lda, const REAL* tau,
+	REAL* c, int ldc, REAL* work);
+
+// Plane rotations x := c * x + s * y, y := c * y - s * x (like ROT) of pairs of columns of the
+// m x n matrix z, recorded by the QR iterations on tridiagonal and bidiagonal matrices and
+// applied in batches by blocks of rows. Without memory for the batch they are applied right
+// away; with a NULL z they are dropped.
+struct PFX(rotations)
+{
+	REAL* z;
+	int m, n, ldz;
+	int count, capacity;
+	int* cols;
+	REAL* cs;
+};
+
+void PFX(rotations_init)(struct PFX(rotations)* r, REAL* z, int m, int n, int ldz);
+void PFX(rotations_add)(struct PFX(rotations)* r, int x, int y, REAL c, REAL s);
+// Applies the rotations still in the batch and frees it
+void PFX(rotations_finish)(struct PFX(rotations)* r);
@@ -0,0 +1,82 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Includes LAPACK_TEMPLATE once for float and once for double, with:
+//   REAL                  the element type
+//   F(name), FU(name)     the lower- and upper-case exported names
+//   ROUTINE(name)         the name reported on errors
+//   PFX(name)             internal names
+//   CBLAS(name)           the BLAS routine of the element type
+//   EPS, SAFMIN           relative machine precision and the smallest safely invertible number
+//   ABS(x), SQRT(x), HYPOT(x, y)
+
+#include <float.h>
+#include <math.h>
+
+#define REAL float
+#define F(name) s##name
+#define FU(name) S##name
+#define ROUTINE(name) "S" #name
+#define PFX(name) s##name
+#define CBLAS(name) cblas_s##name
+#define CBLAS_IAMAX cblas_isamax
+#define EPS (FLT_EPSILON * 0.5f)
+#define SAFMIN FLT_MIN
+#define ABS(x) fabsf(x)
+#define SQRT(x) sqrtf(x)
+#define HYPOT(x, y) hypotf(x, y)
+#include LAPACK_TEMPLATE
+#undef REAL
+#undef F
+#undef FU
+#undef ROUTINE
+#undef PFX
+#undef CBLAS
+#undef CBLAS_IAMAX
+#undef EPS
+#undef SAFMIN
+#undef ABS
+#undef SQRT
+#undef HYPOT
+
+#define REAL double
+#define F(name) d##name
+#define FU(name) D##name
+#define ROUTINE(name) "D" #name
+#define PFX(name) d##name
+#define CBLAS(name) cblas_d##name
+#define CBLAS_IAMAX cblas_idamax
+#define EPS (DBL_EPSILON * 0.5)
+#define SAFMIN DBL_MIN
+#define ABS(x) fabs(x)
+#define SQRT(x) sqrt(x)
+#define HYPOT(x, y) hypot(x, y)
+#include LAPACK_TEMPLATE
+#undef REAL
+#undef F
+#undef FU
+#undef ROUTINE
+#undef PFX
+#undef CBLAS
+#undef CBLAS_IAMAX
+#undef EPS
+#undef SAFMIN
+#undef ABS
+#undef SQRT
+#undef HYPOT
@@ -0,0 +1,73 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _LAPACK_INTERNAL_H_
+#define _LAPACK_INTERNAL_H_
+
+#include <LAPACK/LAPACK.h>
+#include <BLAS/BLAS.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// The routines are written against the column-major CBLAS interface, so that all the heavy
+// lifting happens in libBLAS' blocked and threaded level 3 routines. Each exported routine
+// validates its arguments like the reference LAPACK does and then calls a *_impl function
+// taking plain values, which is also what other routines in this library use.
+
+// Reports argument `pos` of `routine` as invalid through xerbla_, which aborts unless
+// a handler has been installed with SetBLASParamErrorProc()
+void lapack_param_error(const char* routine, int pos);
+
+// Every routine is exported as name_, name, NAME and NAME_
+#define LAPACK_ALIASES(type, impl, lower, upper, upper_, params, args) \
+	type lower params { return impl args; } \
+	type upper params { return impl args; } \
+	type upper_ params { return impl args; }
+
+// Sets *__info and reports the argument if `cond` doesn't hold. Expects `routine` to be defined.
+#define CHECK(cond, pos) \
+	do { \
+		if (!(cond)) \
+		{ \
+			*__info = -(pos); \
+			lapack_param_error(routine, pos); \
+			return 0; \
+		} \
+	} while (0)
+
+#define MAX1(x) ((x) > 1 ? (x) : 1)
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+// Block size of the blocked (non-recursive) algorithms
+#define LAPACK_NB 32
+
+#define REAL float
+#define PFX(name) s##name
+#include "lapack_impl.h"
+#undef REAL
+#undef PFX
+
+#define REAL double
+#define PFX(name) d##name
+#include "lapack_impl.h"
+#undef REAL
+#undef PFX
+
+#endif
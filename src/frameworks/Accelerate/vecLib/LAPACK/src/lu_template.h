@@ -0,0 +1,420 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// LU factorization with partial pivoting and the routines built on it, included by lu.c
+// through lapack_instantiate.h.
+//
+// xGETRF is Toledo's recursive algorithm: factor the left half of the columns, update the
+// right half with a triangular solve and a matrix product, then factor what remains of the
+// right half. Nearly all of the work ends up in large TRSM and GEMM calls instead of the
+// panel-sized ones of the classic blocked algorithm.
+
+// Below this many columns, panels are factored column by column
+#define LU_BASE 16
+
+// Row interchanges, with the 1-based k1, k2 and pivot indices of xLASWP. Columns are done
+// in blocks so that the rows being swapped stay in cache.
+static void PFX(laswp_impl)(int n, REAL* a, int lda, int k1, int k2, const int* ipiv, int incx)
+{
+	int first, last, step, ix0;
+
+	if (incx > 0)
+	{
+		ix0 = k1;
+		first = k1;
+		last = k2;
+		step = 1;
+	}
+	else if (incx < 0)
+	{
+		ix0 = k1 + (k1 - k2) * incx;
+		first = k2;
+		last = k1;
+		step = -1;
+	}
+	else
+	{
+		return;
+	}
+
+	for (int j0 = 0; j0 < n; j0 += 32)
+	{
+		const int cols = MIN(32, n - j0);
+		int ix = ix0;
+
+		for (int i = first; step > 0 ? i <= last : i >= last; i += step, ix += incx)
+		{
+			const int ip = ipiv[ix - 1];
+
+			if (ip == i)
+				continue;
+
+			REAL* r1 = a + (i - 1) + (size_t) j0 * lda;
+			REAL* r2 = a + (ip - 1) + (size_t) j0 * lda;
+
+			for (int j = 0; j < cols; j++)
+			{
+				const REAL t = r1[(size_t) j * lda];
+				r1[(size_t) j * lda] = r2[(size_t) j * lda];
+				r2[(size_t) j * lda] = t;
+			}
+		}
+	}
+}
+
+static int PFX(getf2_impl)(int m, int n, REAL* a, int lda, int* ipiv)
+{
+	const int k = MIN(m, n);
+	int info = 0;
+
+	for (int j = 0; j < k; j++)
+	{
+		REAL* col = a + j + (size_t) j * lda;
+		const int p = j + (int) CBLAS_IAMAX(m - j, col, 1);
+
+		ipiv[j] = p + 1;
+
+		if (a[p + (size_t) j * lda] != 0)
+		{
+			if (p != j)
+				CBLAS(swap)(n, a + j, lda, a + p, lda);
+
+			if (ABS(*col) >= SAFMIN)
+			{
+				CBLAS(scal)(m - j - 1, 1 / *col, col + 1, 1);
+			}
+			else
+			{
+				for (int i = 1; i < m - j; i++)
+					col[i] /= *col;
+			}
+		}
+		else if (info == 0)
+		{
+			info = j + 1;
+		}
+
+		if (j + 1 < k || j + 1 < n)
+		{
+			CBLAS(ger)(CblasColMajor, m - j - 1, n - j - 1, -1, col + 1, 1, col + lda, lda,
+				col + 1 + lda, lda);
+		}
+	}
+
+	return info;
+}
+
+// Factors an m x n panel with n <= m
+static int PFX(getrf_recursive)(int m, int n, REAL* a, int lda, int* ipiv)
+{
+	if (n <= LU_BASE)
+		return PFX(getf2_impl)(m, n, a, lda, ipiv);
+
+	const int n1 = n / 2, n2 = n - n1;
+	REAL* a12 = a + (size_t) n1 * lda;
+	REAL* a21 = a + n1;
+	REAL* a22 = a + n1 + (size_t) n1 * lda;
+
+	int info = PFX(getrf_recursive)(m, n1, a, lda, ipiv);
+
+	// A12 := L11^-1 * P * A12, A22 := A22 - A21 * A12
+	PFX(laswp_impl)(n2, a12, lda, 1, n1, ipiv, 1);
+	CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, n1, n2, 1, a, lda, a12, lda);
+	CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, m - n1, n2, n1, -1, a21, lda, a12, lda, 1, a22, lda);
+
+	const int info2 = PFX(getrf_recursive)(m - n1, n2, a22, lda, ipiv + n1);
+	if (info == 0 && info2 != 0)
+		info = info2 + n1;
+
+	// the pivots of the right half are relative to its first row, and apply to the left half too
+	for (int i = n1; i < n; i++)
+		ipiv[i] += n1;
+	PFX(laswp_impl)(n1, a, lda, n1 + 1, n, ipiv, 1);
+
+	return info;
+}
+
+int PFX(getrf_impl)(int m, int n, REAL* a, int lda, int* ipiv)
+{
+	const int k = MIN(m, n);
+
+	if (k == 0)
+		return 0;
+
+	const int info = PFX(getrf_recursive)(m, k, a, lda, ipiv);
+
+	// wide matrices: U12 := L11^-1 * P * A12
+	if (n > k)
+	{
+		REAL* a12 = a + (size_t) k * lda;
+
+		PFX(laswp_impl)(n - k, a12, lda, 1, k, ipiv, 1);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, k, n - k, 1, a, lda, a12, lda);
+	}
+
+	return info;
+}
+
+static void PFX(getrs_impl)(bool trans, int n, int nrhs, const REAL* a, int lda, const int* ipiv, REAL* b, int ldb)
+{
+	if (!trans)
+	{
+		// A = P * L * U
+		PFX(laswp_impl)(nrhs, b, ldb, 1, n, ipiv, 1);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, n, nrhs, 1, a, lda, b, ldb);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+	}
+	else
+	{
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+		CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasTrans, CblasUnit, n, nrhs, 1, a, lda, b, ldb);
+		PFX(laswp_impl)(nrhs, b, ldb, 1, n, ipiv, -1);
+	}
+}
+
+// Inverse of a triangular matrix whose diagonal is known to be nonzero, recursively:
+// inv([A11 A12; 0 A22]) = [inv(A11), -inv(A11) * A12 * inv(A22); 0, inv(A22)]
+static void PFX(trtri_recursive)(bool upper, bool unit, int n, REAL* a, int lda)
+{
+	const enum CBLAS_UPLO uplo = upper ? CblasUpper : CblasLower;
+	const enum CBLAS_DIAG diag = unit ? CblasUnit : CblasNonUnit;
+
+	if (n <= LU_BASE)
+	{
+		// xTRTI2: column j of the inverse from the already inverted columns next to it
+		for (int jj = 0; jj < n; jj++)
+		{
+			const int j = upper ? jj : n - 1 - jj;
+			REAL* ajj = a + j + (size_t) j * lda;
+			REAL scale = -1;
+
+			if (!unit)
+			{
+				*ajj = 1 / *ajj;
+				scale = -*ajj;
+			}
+
+			if (upper)
+			{
+				CBLAS(trmv)(CblasColMajor, uplo, CblasNoTrans, diag, j, a, lda, a + (size_t) j * lda, 1);
+				CBLAS(scal)(j, scale, a + (size_t) j * lda, 1);
+			}
+			else if (j < n - 1)
+			{
+				CBLAS(trmv)(CblasColMajor, uplo, CblasNoTrans, diag, n - 1 - j, ajj + 1 + lda, lda, ajj + 1, 1);
+				CBLAS(scal)(n - 1 - j, scale, ajj + 1, 1);
+			}
+		}
+		return;
+	}
+
+	const int n1 = n / 2, n2 = n - n1;
+	REAL* a11 = a;
+	REAL* a22 = a + n1 + (size_t) n1 * lda;
+
+	if (upper)
+	{
+		REAL* a12 = a + (size_t) n1 * lda;
+		CBLAS(trsm)(CblasColMajor, CblasLeft, uplo, CblasNoTrans, diag, n1, n2, -1, a11, lda, a12, lda);
+		CBLAS(trsm)(CblasColMajor, CblasRight, uplo, CblasNoTrans, diag, n1, n2, 1, a22, lda, a12, lda);
+	}
+	else
+	{
+		REAL* a21 = a + n1;
+		CBLAS(trsm)(CblasColMajor, CblasLeft, uplo, CblasNoTrans, diag, n2, n1, -1, a22, lda, a21, lda);
+		CBLAS(trsm)(CblasColMajor, CblasRight, uplo, CblasNoTrans, diag, n2, n1, 1, a11, lda, a21, lda);
+	}
+
+	PFX(trtri_recursive)(upper, unit, n1, a11, lda);
+	PFX(trtri_recursive)(upper, unit, n2, a22, lda);
+}
+
+static int PFX(trtri_impl)(bool upper, bool unit, int n, REAL* a, int lda)
+{
+	if (!unit)
+	{
+		for (int i = 0; i < n; i++)
+		{
+			if (a[i + (size_t) i * lda] == 0)
+				return i + 1;
+		}
+	}
+
+	PFX(trtri_recursive)(upper, unit, n, a, lda);
+	return 0;
+}
+
+int F(laswp_)(__CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx)
+{
+	PFX(laswp_impl)(*__n, __a, *__lda, *__k1, *__k2, __ipiv, *__incx);
+	return 0;
+}
+LAPACK_ALIASES(int, F(laswp_), F(laswp), FU(LASWP), FU(LASWP_),
+	(__CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__k1, __CLPK_integer *__k2, __CLPK_integer *__ipiv, __CLPK_integer *__incx),
+	(__n, __a, __lda, __k1, __k2, __ipiv, __incx))
+
+int F(getf2_)(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GETF2);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__m), 4);
+
+	*__info = PFX(getf2_impl)(*__m, *__n, __a, *__lda, __ipiv);
+	return 0;
+}
+LAPACK_ALIASES(int, F(getf2_), F(getf2), FU(GETF2), FU(GETF2_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info),
+	(__m, __n, __a, __lda, __ipiv, __info))
+
+int F(getrf_)(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GETRF);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__m), 4);
+
+	*__info = PFX(getrf_impl)(*__m, *__n, __a, *__lda, __ipiv);
+	return 0;
+}
+LAPACK_ALIASES(int, F(getrf_), F(getrf), FU(GETRF), FU(GETRF_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, __CLPK_integer *__info),
+	(__m, __n, __a, __lda, __ipiv, __info))
+
+int F(getrs_)(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GETRS);
+	const bool notrans = lsame_(__trans, "N");
+
+	CHECK(notrans || lsame_(__trans, "T") || lsame_(__trans, "C"), 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__nrhs >= 0, 3);
+	CHECK(*__lda >= MAX1(*__n), 5);
+	CHECK(*__ldb >= MAX1(*__n), 8);
+
+	*__info = 0;
+	if (*__n > 0 && *__nrhs > 0)
+		PFX(getrs_impl)(!notrans, *__n, *__nrhs, __a, *__lda, __ipiv, __b, *__ldb);
+	return 0;
+}
+LAPACK_ALIASES(int, F(getrs_), F(getrs), FU(GETRS), FU(GETRS_),
+	(char *__trans, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info),
+	(__trans, __n, __nrhs, __a, __lda, __ipiv, __b, __ldb, __info))
+
+int F(gesv_)(__CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GESV);
+
+	CHECK(*__n >= 0, 1);
+	CHECK(*__nrhs >= 0, 2);
+	CHECK(*__lda >= MAX1(*__n), 4);
+	CHECK(*__ldb >= MAX1(*__n), 7);
+
+	*__info = PFX(getrf_impl)(*__n, *__n, __a, *__lda, __ipiv);
+	if (*__info == 0 && *__n > 0 && *__nrhs > 0)
+		PFX(getrs_impl)(false, *__n, *__nrhs, __a, *__lda, __ipiv, __b, *__ldb);
+	return 0;
+}
+LAPACK_ALIASES(int, F(gesv_), F(gesv), FU(GESV), FU(GESV_),
+	(__CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__b, __CLPK_integer *__ldb, __CLPK_integer *__info),
+	(__n, __nrhs, __a, __lda, __ipiv, __b, __ldb, __info))
+
+int F(trtri_)(char *__uplo, char *__diag, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(TRTRI);
+	const bool upper = lsame_(__uplo, "U");
+	const bool unit = lsame_(__diag, "U");
+
+	CHECK(upper || lsame_(__uplo, "L"), 1);
+	CHECK(unit || lsame_(__diag, "N"), 2);
+	CHECK(*__n >= 0, 3);
+	CHECK(*__lda >= MAX1(*__n), 5);
+
+	*__info = PFX(trtri_impl)(upper, unit, *__n, __a, *__lda);
+	return 0;
+}
+LAPACK_ALIASES(int, F(trtri_), F(trtri), FU(TRTRI), FU(TRTRI_),
+	(char *__uplo, char *__diag, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__info),
+	(__uplo, __diag, __n, __a, __lda, __info))
+
+// inv(A) = inv(U) * inv(L) * P: invert U in place, then solve X * L = inv(U) for X a block of
+// columns at a time from the right, keeping the columns of L being used in `work`
+int F(getri_)(__CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GETRI);
+	const int n = *__n, lda = *__lda;
+
+	*__work = (REAL) MAX1(n * LAPACK_NB);
+
+	CHECK(n >= 0, 1);
+	CHECK(lda >= MAX1(n), 3);
+	CHECK(*__lwork >= MAX1(n) || *__lwork == -1, 6);
+
+	*__info = 0;
+	if (*__lwork == -1 || n == 0)
+		return 0;
+
+	*__info = PFX(trtri_impl)(true, false, n, __a, lda);
+	if (*__info != 0)
+		return 0;
+
+	const int nb = MIN(LAPACK_NB, *__lwork / n);
+	const int ldw = n;
+
+	for (int j = ((n - 1) / nb) * nb; j >= 0; j -= nb)
+	{
+		const int jb = MIN(nb, n - j);
+
+		// move the strictly lower part of this block of L to work
+		for (int jj = 0; jj < jb; jj++)
+		{
+			REAL* col = __a + (size_t) (j + jj) * lda;
+			REAL* w = __work + (size_t) jj * ldw;
+
+			for (int i = j + jj + 1; i < n; i++)
+			{
+				w[i] = col[i];
+				col[i] = 0;
+			}
+		}
+
+		if (j + jb < n)
+		{
+			CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, n, jb, n - j - jb, -1,
+				__a + (size_t) (j + jb) * lda, lda, __work + j + jb, ldw, 1, __a + (size_t) j * lda, lda);
+		}
+		CBLAS(trsm)(CblasColMajor, CblasRight, CblasLower, CblasNoTrans, CblasUnit, n, jb, 1,
+			__work + j, ldw, __a + (size_t) j * lda, lda);
+	}
+
+	// undo the row interchanges of A as column interchanges of its inverse
+	for (int j = n - 2; j >= 0; j--)
+	{
+		const int jp = __ipiv[j] - 1;
+		if (jp != j)
+			CBLAS(swap)(n, __a + (size_t) j * lda, 1, __a + (size_t) jp * lda, 1);
+	}
+
+	return 0;
+}
+LAPACK_ALIASES(int, F(getri_), F(getri), FU(GETRI), FU(GETRI_),
+	(__CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, __CLPK_integer *__ipiv, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__n, __a, __lda, __ipiv, __work, __lwork, __info))
@@ -0,0 +1,658 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// QR factorization with Householder reflectors, the generation and application of Q, and
+// least squares on top of them. Included by qr.c through lapack_instantiate.h.
+//
+// The blocked routines follow the reference LAPACK: the reflectors of a panel of nb columns
+// are accumulated into the compact WY form H1 * ... * Hnb = I - V * T * V^T (xLARFT), which
+// is then applied to the rest of the matrix with TRMM and GEMM (xLARFB).
+
+void PFX(larfg_impl)(int n, REAL* alpha, REAL* x, int incx, REAL* tau)
+{
+	if (n <= 1)
+	{
+		*tau = 0;
+		return;
+	}
+
+	REAL xnorm = CBLAS(nrm2)(n - 1, x, incx);
+	if (xnorm == 0)
+	{
+		// H is the identity
+		*tau = 0;
+		return;
+	}
+
+	REAL beta = -copysign(HYPOT(*alpha, xnorm), *alpha);
+	const REAL safmin = SAFMIN / EPS;
+	int knt = 0;
+
+	if (ABS(beta) < safmin)
+	{
+		// beta may be inaccurate, scale x up and recompute it
+		do
+		{
+			knt++;
+			CBLAS(scal)(n - 1, 1 / safmin, x, incx);
+			beta /= safmin;
+			*alpha /= safmin;
+		}
+		while (ABS(beta) < safmin && knt < 20);
+
+		xnorm = CBLAS(nrm2)(n - 1, x, incx);
+		beta = -copysign(HYPOT(*alpha, xnorm), *alpha);
+	}
+
+	*tau = (beta - *alpha) / beta;
+	CBLAS(scal)(n - 1, 1 / (*alpha - beta), x, incx);
+
+	for (int i = 0; i < knt; i++)
+		beta *= safmin;
+	*alpha = beta;
+}
+
+void PFX(larf_impl)(bool left, int m, int n, const REAL* v, int incv, REAL tau, REAL* c, int ldc, REAL* work)
+{
+	if (tau == 0 || m == 0 || n == 0)
+		return;
+
+	if (left)
+	{
+		// w := C^T * v, C := C - tau * v * w^T
+		CBLAS(gemv)(CblasColMajor, CblasTrans, m, n, 1, c, ldc, v, incv, 0, work, 1);
+		CBLAS(ger)(CblasColMajor, m, n, -tau, v, incv, work, 1, c, ldc);
+	}
+	else
+	{
+		// w := C * v, C := C - tau * w * v^T
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m, n, 1, c, ldc, v, incv, 0, work, 1);
+		CBLAS(ger)(CblasColMajor, m, n, -tau, work, 1, v, incv, c, ldc);
+	}
+}
+
+static void PFX(geqr2_impl)(int m, int n, REAL* a, int lda, REAL* tau, REAL* work)
+{
+	const int k = MIN(m, n);
+
+	for (int i = 0; i < k; i++)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+
+		PFX(larfg_impl)(m - i, aii, aii + MIN(1, m - i - 1), 1, &tau[i]);
+
+		if (i < n - 1)
+		{
+			const REAL saved = *aii;
+			*aii = 1;
+			PFX(larf_impl)(true, m - i, n - i - 1, aii, 1, tau[i], aii + lda, lda, work);
+			*aii = saved;
+		}
+	}
+}
+
+// Forms the upper triangular k x k T of H1 * ... * Hk = I - V * T * V^T, V being the unit
+// lower trapezoidal m x k matrix of the reflectors as stored by xGEQRF
+static void PFX(larft_impl)(int m, int k, const REAL* v, int ldv, const REAL* tau, REAL* t, int ldt)
+{
+	for (int i = 0; i < k; i++)
+	{
+		REAL* ti = t + (size_t) i * ldt;
+
+		if (tau[i] == 0)
+		{
+			for (int j = 0; j <= i; j++)
+				ti[j] = 0;
+			continue;
+		}
+
+		// T(0:i,i) := -tau(i) * V(i:m,0:i)^T * V(i:m,i), with the implicit V(i,i) = 1
+		for (int j = 0; j < i; j++)
+			ti[j] = -tau[i] * v[i + (size_t) j * ldv];
+		if (i < m - 1)
+		{
+			CBLAS(gemv)(CblasColMajor, CblasTrans, m - i - 1, i, -tau[i], v + i + 1, ldv,
+				v + i + 1 + (size_t) i * ldv, 1, 1, ti, 1);
+		}
+
+		// T(0:i,i) := T(0:i,0:i) * T(0:i,i)
+		CBLAS(trmv)(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit, i, t, ldt, ti, 1);
+		ti[i] = tau[i];
+	}
+}
+
+// Applies H = I - V * T * V^T or H^T to the m x n matrix C from the left or the right, where
+// V has k columns and m (left) or n (right) rows. `work` is k columns of n (left) or m (right)
+// elements.
+static void PFX(larfb_impl)(bool left, bool trans, int m, int n, int k, const REAL* v, int ldv,
+	const REAL* t, int ldt, REAL* c, int ldc, REAL* work)
+{
+	if (m == 0 || n == 0)
+		return;
+
+	// W * T^T for H, W * T for H^T (on the left), the other way around on the right
+	const enum CBLAS_TRANSPOSE tt = (trans == left) ? CblasNoTrans : CblasTrans;
+
+	if (left)
+	{
+		const int ldw = n;
+
+		// W := C^T * V = C1^T * V1 + C2^T * V2
+		for (int j = 0; j < k; j++)
+			CBLAS(copy)(n, c + j, ldc, work + (size_t) j * ldw, 1);
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasLower, CblasNoTrans, CblasUnit, n, k, 1, v, ldv, work, ldw);
+		if (m > k)
+		{
+			CBLAS(gemm)(CblasColMajor, CblasTrans, CblasNoTrans, n, k, m - k, 1, c + k, ldc, v + k, ldv,
+				1, work, ldw);
+		}
+
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasUpper, tt, CblasNonUnit, n, k, 1, t, ldt, work, ldw);
+
+		// C := C - V * W^T
+		if (m > k)
+		{
+			CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasTrans, m - k, n, k, -1, v + k, ldv, work, ldw,
+				1, c + k, ldc);
+		}
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasUnit, n, k, 1, v, ldv, work, ldw);
+
+		for (int j = 0; j < n; j++)
+		{
+			for (int i = 0; i < k; i++)
+				c[i + (size_t) j * ldc] -= work[j + (size_t) i * ldw];
+		}
+	}
+	else
+	{
+		const int ldw = m;
+
+		// W := C * V = C1 * V1 + C2 * V2
+		for (int j = 0; j < k; j++)
+			CBLAS(copy)(m, c + (size_t) j * ldc, 1, work + (size_t) j * ldw, 1);
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasLower, CblasNoTrans, CblasUnit, m, k, 1, v, ldv, work, ldw);
+		if (n > k)
+		{
+			CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, m, k, n - k, 1, c + (size_t) k * ldc, ldc,
+				v + k, ldv, 1, work, ldw);
+		}
+
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasUpper, tt, CblasNonUnit, m, k, 1, t, ldt, work, ldw);
+
+		// C := C - W * V^T
+		if (n > k)
+		{
+			CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasTrans, m, n - k, k, -1, work, ldw, v + k, ldv,
+				1, c + (size_t) k * ldc, ldc);
+		}
+		CBLAS(trmm)(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasUnit, m, k, 1, v, ldv, work, ldw);
+
+		for (int j = 0; j < k; j++)
+		{
+			#pragma clang loop vectorize(enable)
+			for (int i = 0; i < m; i++)
+				c[i + (size_t) j * ldc] -= work[i + (size_t) j * ldw];
+		}
+	}
+}
+
+// T followed by W for the blocked routines, NULL if there's no memory
+static REAL* PFX(qr_workspace)(int rows)
+{
+	return (REAL*) malloc(sizeof(REAL) * LAPACK_NB * ((size_t) LAPACK_NB + MAX1(rows)));
+}
+
+void PFX(geqrf_impl)(int m, int n, REAL* a, int lda, REAL* tau, REAL* work)
+{
+	const int k = MIN(m, n);
+	const int nb = LAPACK_NB;
+	REAL* ws = NULL;
+
+	if (k > nb && n > nb)
+		ws = PFX(qr_workspace)(n);
+	if (!ws)
+	{
+		PFX(geqr2_impl)(m, n, a, lda, tau, work);
+		return;
+	}
+
+	REAL* t = ws;
+	REAL* w = ws + nb * nb;
+
+	for (int i = 0; i < k; i += nb)
+	{
+		const int ib = MIN(nb, k - i);
+		REAL* aii = a + i + (size_t) i * lda;
+
+		PFX(geqr2_impl)(m - i, ib, aii, lda, tau + i, w);
+
+		if (i + ib < n)
+		{
+			PFX(larft_impl)(m - i, ib, aii, lda, tau + i, t, nb);
+			PFX(larfb_impl)(true, true, m - i, n - i - ib, ib, aii, lda, t, nb, aii + (size_t) ib * lda, lda, w);
+		}
+	}
+
+	free(ws);
+}
+
+static void PFX(org2r_impl)(int m, int n, int k, REAL* a, int lda, const REAL* tau, REAL* work)
+{
+	// columns k..n-1 start as those of the identity
+	for (int j = k; j < n; j++)
+	{
+		REAL* col = a + (size_t) j * lda;
+
+		for (int i = 0; i < m; i++)
+			col[i] = 0;
+		col[j] = 1;
+	}
+
+	for (int i = k - 1; i >= 0; i--)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+
+		if (i < n - 1)
+		{
+			*aii = 1;
+			PFX(larf_impl)(true, m - i, n - i - 1, aii, 1, tau[i], aii + lda, lda, work);
+		}
+		if (i < m - 1)
+			CBLAS(scal)(m - i - 1, -tau[i], aii + 1, 1);
+		*aii = 1 - tau[i];
+
+		for (int l = 0; l < i; l++)
+			a[l + (size_t) i * lda] = 0;
+	}
+}
+
+void PFX(orgqr_impl)(int m, int n, int k, REAL* a, int lda, const REAL* tau, REAL* work)
+{
+	const int nb = LAPACK_NB;
+	REAL* ws = NULL;
+
+	if (k > nb && n > nb)
+		ws = PFX(qr_workspace)(n);
+	if (!ws)
+	{
+		PFX(org2r_impl)(m, n, k, a, lda, tau, work);
+		return;
+	}
+
+	REAL* t = ws;
+	REAL* w = ws + nb * nb;
+
+	// the last block and the columns after it unblocked, then the others backwards
+	const int kl = ((k - 1) / nb) * nb;
+
+	PFX(org2r_impl)(m - kl, n - kl, k - kl, a + kl + (size_t) kl * lda, lda, tau + kl, w);
+	for (int j = kl; j < n; j++)
+	{
+		for (int i = 0; i < kl; i++)
+			a[i + (size_t) j * lda] = 0;
+	}
+
+	for (int i = kl - nb; i >= 0; i -= nb)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+
+		PFX(larft_impl)(m - i, nb, aii, lda, tau + i, t, nb);
+		PFX(larfb_impl)(true, false, m - i, n - i - nb, nb, aii, lda, t, nb, aii + (size_t) nb * lda, lda, w);
+
+		PFX(org2r_impl)(m - i, nb, nb, aii, lda, tau + i, w);
+		for (int j = i; j < i + nb; j++)
+		{
+			for (int l = 0; l < i; l++)
+				a[l + (size_t) j * lda] = 0;
+		}
+	}
+
+	free(ws);
+}
+
+// Q = H1 * ... * Hk: Q * C applies Hk first, Q^T * C H1 first, and the other way around on the right
+static void PFX(orm2r_impl)(bool left, bool trans, int m, int n, int k, const REAL* a, int lda, const REAL* tau,
+	REAL* c, int ldc, REAL* work)
+{
+	const bool forward = (left == trans);
+
+	for (int l = 0; l < k; l++)
+	{
+		const int i = forward ? l : k - 1 - l;
+		REAL* aii = (REAL*) a + i + (size_t) i * lda;
+		const REAL saved = *aii;
+
+		*aii = 1;
+		if (left)
+			PFX(larf_impl)(true, m - i, n, aii, 1, tau[i], c + i, ldc, work);
+		else
+			PFX(larf_impl)(false, m, n - i, aii, 1, tau[i], c + (size_t) i * ldc, ldc, work);
+		*aii = saved;
+	}
+}
+
+void PFX(ormqr_impl)(bool left, bool trans, int m, int n, int k, const REAL* a, int lda, const REAL* tau,
+	REAL* c, int ldc, REAL* work)
+{
+	const int nb = LAPACK_NB;
+	REAL* ws = NULL;
+
+	if (k > nb)
+		ws = PFX(qr_workspace)(left ? n : m);
+	if (!ws)
+	{
+		PFX(orm2r_impl)(left, trans, m, n, k, a, lda, tau, c, ldc, work);
+		return;
+	}
+
+	REAL* t = ws;
+	REAL* w = ws + nb * nb;
+	const int nq = left ? m : n;
+	const bool forward = (left == trans);
+	const int nblocks = (k + nb - 1) / nb;
+
+	for (int l = 0; l < nblocks; l++)
+	{
+		const int i = (forward ? l : nblocks - 1 - l) * nb;
+		const int ib = MIN(nb, k - i);
+		const REAL* aii = a + i + (size_t) i * lda;
+
+		PFX(larft_impl)(nq - i, ib, aii, lda, tau + i, t, nb);
+		if (left)
+			PFX(larfb_impl)(true, trans, m - i, n, ib, aii, lda, t, nb, c + i, ldc, w);
+		else
+			PFX(larfb_impl)(false, trans, m, n - i, ib, aii, lda, t, nb, c + (size_t) i * ldc, ldc, w);
+	}
+
+	free(ws);
+}
+
+// A = L * Q for m < n, with the reflectors stored in the rows of A like xGELQF does. Only
+// used by xGELS for underdetermined systems, so it isn't blocked.
+static void PFX(gelq2_impl)(int m, int n, REAL* a, int lda, REAL* tau, REAL* work)
+{
+	for (int i = 0; i < m; i++)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+
+		PFX(larfg_impl)(n - i, aii, aii + (size_t) MIN(1, n - i - 1) * lda, lda, &tau[i]);
+
+		if (i < m - 1)
+		{
+			const REAL saved = *aii;
+			*aii = 1;
+			PFX(larf_impl)(false, m - i - 1, n - i, aii, lda, tau[i], aii + 1, lda, work);
+			*aii = saved;
+		}
+	}
+}
+
+// Q = Hk * ... * H1 from xGELQ2 applied to C from the left: Q * C applies H1 first
+static void PFX(orml2_left)(bool trans, int m, int n, int k, REAL* a, int lda, const REAL* tau,
+	REAL* c, int ldc, REAL* work)
+{
+	for (int l = 0; l < k; l++)
+	{
+		const int i = trans ? k - 1 - l : l;
+		REAL* aii = a + i + (size_t) i * lda;
+		const REAL saved = *aii;
+
+		*aii = 1;
+		PFX(larf_impl)(true, m - i, n, aii, lda, tau[i], c + i, ldc, work);
+		*aii = saved;
+	}
+}
+
+// Returns LAPACK's INFO: 0, or the index of the first zero on the diagonal of the triangular factor
+static int PFX(gels_impl)(bool trans, int m, int n, int nrhs, REAL* a, int lda, REAL* b, int ldb,
+	REAL* tau, REAL* work)
+{
+	const int mn = MIN(m, n);
+
+	if (m >= n)
+	{
+		PFX(geqrf_impl)(m, n, a, lda, tau, work);
+
+		for (int i = 0; i < n; i++)
+		{
+			if (a[i + (size_t) i * lda] == 0)
+				return i + 1;
+		}
+
+		if (!trans)
+		{
+			// least squares: min |A * X - B| with X = R^-1 * (Q^T * B)(0:n)
+			PFX(ormqr_impl)(true, true, m, nrhs, n, a, lda, tau, b, ldb, work);
+			CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+		}
+		else
+		{
+			// minimum norm solution of A^T * X = B: X = Q * (R^-T * B, 0)
+			CBLAS(trsm)(CblasColMajor, CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, n, nrhs, 1, a, lda, b, ldb);
+			for (int j = 0; j < nrhs; j++)
+			{
+				for (int i = n; i < m; i++)
+					b[i + (size_t) j * ldb] = 0;
+			}
+			PFX(ormqr_impl)(true, false, m, nrhs, n, a, lda, tau, b, ldb, work);
+		}
+	}
+	else
+	{
+		PFX(gelq2_impl)(m, n, a, lda, tau, work);
+
+		for (int i = 0; i < m; i++)
+		{
+			if (a[i + (size_t) i * lda] == 0)
+				return i + 1;
+		}
+
+		if (!trans)
+		{
+			// minimum norm solution of A * X = B: X = Q^T * (L^-1 * B, 0)
+			CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, m, nrhs, 1, a, lda, b, ldb);
+			for (int j = 0; j < nrhs; j++)
+			{
+				for (int i = m; i < n; i++)
+					b[i + (size_t) j * ldb] = 0;
+			}
+			PFX(orml2_left)(true, n, nrhs, mn, a, lda, tau, b, ldb, work);
+		}
+		else
+		{
+			// least squares: min |A^T * X - B| with X = L^-T * (Q * B)(0:m)
+			PFX(orml2_left)(false, n, nrhs, mn, a, lda, tau, b, ldb, work);
+			CBLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasTrans, CblasNonUnit, m, nrhs, 1, a, lda, b, ldb);
+		}
+	}
+
+	return 0;
+}
+
+int F(larfg_)(__CLPK_integer *__n, REAL *__alpha, REAL *__x, __CLPK_integer *__incx, REAL *__tau)
+{
+	PFX(larfg_impl)(*__n, __alpha, __x, *__incx, __tau);
+	return 0;
+}
+LAPACK_ALIASES(int, F(larfg_), F(larfg), FU(LARFG), FU(LARFG_),
+	(__CLPK_integer *__n, REAL *__alpha, REAL *__x, __CLPK_integer *__incx, REAL *__tau),
+	(__n, __alpha, __x, __incx, __tau))
+
+int F(geqr2_)(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GEQR2);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__m), 4);
+
+	*__info = 0;
+	PFX(geqr2_impl)(*__m, *__n, __a, *__lda, __tau, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(geqr2_), F(geqr2), FU(GEQR2), FU(GEQR2_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__info),
+	(__m, __n, __a, __lda, __tau, __work, __info))
+
+int F(geqrf_)(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GEQRF);
+
+	*__work = (REAL) MAX1(*__n * LAPACK_NB);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0, 2);
+	CHECK(*__lda >= MAX1(*__m), 4);
+	CHECK(*__lwork >= MAX1(*__n) || *__lwork == -1, 7);
+
+	*__info = 0;
+	if (*__lwork != -1)
+		PFX(geqrf_impl)(*__m, *__n, __a, *__lda, __tau, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(geqrf_), F(geqrf), FU(GEQRF), FU(GEQRF_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__m, __n, __a, __lda, __tau, __work, __lwork, __info))
+
+int F(org2r_)(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(ORG2R);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0 && *__n <= *__m, 2);
+	CHECK(*__k >= 0 && *__k <= *__n, 3);
+	CHECK(*__lda >= MAX1(*__m), 5);
+
+	*__info = 0;
+	PFX(org2r_impl)(*__m, *__n, *__k, __a, *__lda, __tau, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(org2r_), F(org2r), FU(ORG2R), FU(ORG2R_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__info),
+	(__m, __n, __k, __a, __lda, __tau, __work, __info))
+
+int F(orgqr_)(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(ORGQR);
+
+	*__work = (REAL) MAX1(*__n * LAPACK_NB);
+
+	CHECK(*__m >= 0, 1);
+	CHECK(*__n >= 0 && *__n <= *__m, 2);
+	CHECK(*__k >= 0 && *__k <= *__n, 3);
+	CHECK(*__lda >= MAX1(*__m), 5);
+	CHECK(*__lwork >= MAX1(*__n) || *__lwork == -1, 8);
+
+	*__info = 0;
+	if (*__lwork != -1 && *__n > 0)
+		PFX(orgqr_impl)(*__m, *__n, *__k, __a, *__lda, __tau, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(orgqr_), F(orgqr), FU(ORGQR), FU(ORGQR_),
+	(__CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__m, __n, __k, __a, __lda, __tau, __work, __lwork, __info))
+
+int F(orm2r_)(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__c, __CLPK_integer *__ldc, REAL *__work, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(ORM2R);
+	const bool left = lsame_(__side, "L");
+	const bool notrans = lsame_(__trans, "N");
+	const int nq = left ? *__m : *__n;
+
+	CHECK(left || lsame_(__side, "R"), 1);
+	CHECK(notrans || lsame_(__trans, "T"), 2);
+	CHECK(*__m >= 0, 3);
+	CHECK(*__n >= 0, 4);
+	CHECK(*__k >= 0 && *__k <= nq, 5);
+	CHECK(*__lda >= MAX1(nq), 7);
+	CHECK(*__ldc >= MAX1(*__m), 10);
+
+	*__info = 0;
+	PFX(orm2r_impl)(left, !notrans, *__m, *__n, *__k, __a, *__lda, __tau, __c, *__ldc, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(orm2r_), F(orm2r), FU(ORM2R), FU(ORM2R_),
+	(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__c, __CLPK_integer *__ldc, REAL *__work, __CLPK_integer *__info),
+	(__side, __trans, __m, __n, __k, __a, __lda, __tau, __c, __ldc, __work, __info))
+
+int F(ormqr_)(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__c, __CLPK_integer *__ldc, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(ORMQR);
+	const bool left = lsame_(__side, "L");
+	const bool notrans = lsame_(__trans, "N");
+	const int nq = left ? *__m : *__n;
+	const int nw = left ? *__n : *__m;
+
+	*__work = (REAL) MAX1(nw * LAPACK_NB);
+
+	CHECK(left || lsame_(__side, "R"), 1);
+	CHECK(notrans || lsame_(__trans, "T"), 2);
+	CHECK(*__m >= 0, 3);
+	CHECK(*__n >= 0, 4);
+	CHECK(*__k >= 0 && *__k <= nq, 5);
+	CHECK(*__lda >= MAX1(nq), 7);
+	CHECK(*__ldc >= MAX1(*__m), 10);
+	CHECK(*__lwork >= MAX1(nw) || *__lwork == -1, 12);
+
+	*__info = 0;
+	if (*__lwork != -1 && *__m > 0 && *__n > 0)
+		PFX(ormqr_impl)(left, !notrans, *__m, *__n, *__k, __a, *__lda, __tau, __c, *__ldc, __work);
+	return 0;
+}
+LAPACK_ALIASES(int, F(ormqr_), F(ormqr), FU(ORMQR), FU(ORMQR_),
+	(char *__side, char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__k, REAL *__a, __CLPK_integer *__lda, REAL *__tau, REAL *__c, __CLPK_integer *__ldc, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__side, __trans, __m, __n, __k, __a, __lda, __tau, __c, __ldc, __work, __lwork, __info))
+
+int F(gels_)(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GELS);
+	const bool notrans = lsame_(__trans, "N");
+	const int mn = MIN(*__m, *__n);
+	const int minwork = MAX1(mn + MAX(mn, *__nrhs));
+
+	*__work = (REAL) minwork;
+
+	CHECK(notrans || lsame_(__trans, "T"), 1);
+	CHECK(*__m >= 0, 2);
+	CHECK(*__n >= 0, 3);
+	CHECK(*__nrhs >= 0, 4);
+	CHECK(*__lda >= MAX1(*__m), 6);
+	CHECK(*__ldb >= MAX1(MAX(*__m, *__n)), 8);
+	CHECK(*__lwork >= minwork || *__lwork == -1, 10);
+
+	*__info = 0;
+	if (*__lwork == -1)
+		return 0;
+
+	if (mn == 0 || *__nrhs == 0)
+	{
+		for (int j = 0; j < *__nrhs; j++)
+		{
+			for (int i = 0; i < MAX(*__m, *__n); i++)
+				__b[i + (size_t) j * *__ldb] = 0;
+		}
+		return 0;
+	}
+
+	*__info = PFX(gels_impl)(!notrans, *__m, *__n, *__nrhs, __a, *__lda, __b, *__ldb, __work, __work + mn);
+	return 0;
+}
+LAPACK_ALIASES(int, F(gels_), F(gels), FU(GELS), FU(GELS_),
+	(char *__trans, __CLPK_integer *__m, __CLPK_integer *__n, __CLPK_integer *__nrhs, REAL *__a, __CLPK_integer *__lda, REAL *__b, __CLPK_integer *__ldb, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__trans, __m, __n, __nrhs, __a, __lda, __b, __ldb, __work, __lwork, __info))
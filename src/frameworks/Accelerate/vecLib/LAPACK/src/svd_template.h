@@ -0,0 +1,596 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Singular value decomposition, included by svd.c through lapack_instantiate.h.
+//
+// Both xGESVD and xGESDD reduce A to upper bidiagonal form B = Q^T * A * P (xGEBRD, whose
+// trailing updates are GEMMs over panels of LAPACK_NB rows and columns), after a QR
+// factorization if A is much taller than wide. The singular values of B are found with the
+// implicit QR iteration of xBDSQR, rotating Q and P into the singular vectors as it goes.
+// xGESDD shares this path instead of using divide and conquer, its results are the same up to
+// rounding.
+
+// Reduces the first nb rows and columns of the m x n A (m > nb, n > nb) to upper bidiagonal
+// form like xLABRD, leaving the trailing matrix alone: A(nb:m,nb:n) still has to be updated
+// with -V * Y^T - X * W^T, where V and W are the reflectors of Q and P (with their unit
+// elements stored) and X, Y the m x nb and n x nb matrices returned in x and y.
+static void PFX(labrd_impl)(int m, int n, int nb, REAL* a, int lda, REAL* d, REAL* e, REAL* tauq, REAL* taup,
+	REAL* x, int ldx, REAL* y, int ldy)
+{
+	for (int i = 0; i < nb; i++)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+		REAL* arow = aii + lda;
+		REAL* right = a + (size_t) (i + 1) * lda;
+		REAL* xi = x + (size_t) i * ldx;
+		REAL* yi = y + (size_t) i * ldy;
+
+		// bring A(i:m,i) up to date with the reflectors of this panel
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m - i, i, -1, a + i, lda, y + i, ldy, 1, aii, 1);
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m - i, i, -1, x + i, ldx, a + (size_t) i * lda, 1, 1, aii, 1);
+
+		// H(i) annihilates A(i+1:m,i)
+		PFX(larfg_impl)(m - i, aii, aii + MIN(1, m - i - 1), 1, &tauq[i]);
+		d[i] = *aii;
+		*aii = 1;
+
+		// Y(i+1:n,i), with Y(0:i,i) as scratch
+		CBLAS(gemv)(CblasColMajor, CblasTrans, m - i, n - i - 1, 1, arow, lda, aii, 1, 0, yi + i + 1, 1);
+		CBLAS(gemv)(CblasColMajor, CblasTrans, m - i, i, 1, a + i, lda, aii, 1, 0, yi, 1);
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, n - i - 1, i, -1, y + i + 1, ldy, yi, 1, 1, yi + i + 1, 1);
+		CBLAS(gemv)(CblasColMajor, CblasTrans, m - i, i, 1, x + i, ldx, aii, 1, 0, yi, 1);
+		CBLAS(gemv)(CblasColMajor, CblasTrans, i, n - i - 1, -1, right, lda, yi, 1, 1, yi + i + 1, 1);
+		CBLAS(scal)(n - i - 1, tauq[i], yi + i + 1, 1);
+
+		// bring A(i,i+1:n) up to date
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, n - i - 1, i + 1, -1, y + i + 1, ldy, a + i, lda, 1, arow, lda);
+		CBLAS(gemv)(CblasColMajor, CblasTrans, i, n - i - 1, -1, right, lda, x + i, ldx, 1, arow, lda);
+
+		// G(i) annihilates A(i,i+2:n)
+		PFX(larfg_impl)(n - i - 1, arow, arow + (size_t) MIN(1, n - i - 2) * lda, lda, &taup[i]);
+		e[i] = *arow;
+		*arow = 1;
+
+		// X(i+1:m,i), with X(0:i+1,i) as scratch
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m - i - 1, n - i - 1, 1, arow + 1, lda, arow, lda, 0, xi + i + 1, 1);
+		CBLAS(gemv)(CblasColMajor, CblasTrans, n - i - 1, i + 1, 1, y + i + 1, ldy, arow, lda, 0, xi, 1);
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m - i - 1, i + 1, -1, a + i + 1, lda, xi, 1, 1, xi + i + 1, 1);
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, i, n - i - 1, 1, right, lda, arow, lda, 0, xi, 1);
+		CBLAS(gemv)(CblasColMajor, CblasNoTrans, m - i - 1, i, -1, x + i + 1, ldx, xi, 1, 1, xi + i + 1, 1);
+		CBLAS(scal)(m - i - 1, taup[i], xi + i + 1, 1);
+	}
+}
+
+// The unblocked gebrd_impl, see xGEBD2. `work` has m elements.
+static void PFX(gebd2_impl)(int m, int n, REAL* a, int lda, REAL* d, REAL* e, REAL* tauq, REAL* taup, REAL* work)
+{
+	for (int i = 0; i < n; i++)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+		REAL* arow = aii + lda;
+
+		// H(i) annihilates A(i+1:m,i)
+		PFX(larfg_impl)(m - i, aii, aii + MIN(1, m - i - 1), 1, &tauq[i]);
+		d[i] = *aii;
+
+		if (i == n - 1)
+		{
+			taup[i] = 0;
+			break;
+		}
+
+		*aii = 1;
+		PFX(larf_impl)(true, m - i, n - i - 1, aii, 1, tauq[i], arow, lda, work);
+		*aii = d[i];
+
+		// G(i) annihilates A(i,i+2:n)
+		PFX(larfg_impl)(n - i - 1, arow, arow + (size_t) MIN(1, n - i - 2) * lda, lda, &taup[i]);
+		e[i] = *arow;
+		*arow = 1;
+		PFX(larf_impl)(false, m - i - 1, n - i - 1, arow, lda, taup[i], arow + 1, lda, work);
+		*arow = e[i];
+	}
+}
+
+// Reduces the m x n A (m >= n) to upper bidiagonal form with the diagonal in d and the
+// superdiagonal in e like xGEBRD: the reflectors of Q go below the diagonal and those of P
+// right of the superdiagonal. Panels of LAPACK_NB rows and columns are reduced with labrd_impl
+// and the trailing matrix is updated with GEMM; the last columns and the case where X and Y
+// can't be allocated are left to gebd2_impl. `work` has m elements.
+static void PFX(gebrd_impl)(int m, int n, REAL* a, int lda, REAL* d, REAL* e, REAL* tauq, REAL* taup, REAL* work)
+{
+	const int nb = LAPACK_NB;
+	REAL* xy = NULL;
+	int i = 0;
+
+	if (n > 2 * nb)
+		xy = (REAL*) malloc(sizeof(REAL) * nb * ((size_t) m + n));
+
+	for (; xy && n - i > 2 * nb; i += nb)
+	{
+		REAL* aii = a + i + (size_t) i * lda;
+		REAL* a22 = aii + nb + (size_t) nb * lda;
+		const int ldx = m - i, ldy = n - i;
+		REAL* x = xy;
+		REAL* y = xy + (size_t) nb * ldx;
+
+		PFX(labrd_impl)(m - i, n - i, nb, aii, lda, d + i, e + i, tauq + i, taup + i, x, ldx, y, ldy);
+
+		CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasTrans, m - i - nb, n - i - nb, nb, -1, aii + nb, lda,
+			y + nb, ldy, 1, a22, lda);
+		CBLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, m - i - nb, n - i - nb, nb, -1, x + nb, ldx,
+			aii + (size_t) nb * lda, lda, 1, a22, lda);
+
+		for (int j = i; j < i + nb; j++)
+		{
+			a[j + (size_t) j * lda] = d[j];
+			a[j + (size_t) (j + 1) * lda] = e[j];
+		}
+	}
+
+	free(xy);
+	PFX(gebd2_impl)(m - i, n - i, a + i + (size_t) i * lda, lda, d + i, e + i, tauq + i, taup + i, work);
+}
+
+// The rotation with c * f + s * g = r and c * g - s * f = 0, see xLARTG
+static void PFX(lartg_impl)(REAL f, REAL g, REAL* c, REAL* s, REAL* r)
+{
+	if (g == 0)
+	{
+		*c = 1;
+		*s = 0;
+		*r = f;
+	}
+	else if (f == 0)
+	{
+		*c = 0;
+		*s = 1;
+		*r = g;
+	}
+	else
+	{
+		const REAL t = HYPOT(f, g);
+
+		*c = f / t;
+		*s = g / t;
+		*r = t;
+	}
+}
+
+// The smaller singular value of [f g; 0 h], see xLAS2
+static REAL PFX(las2_min)(REAL f, REAL g, REAL h)
+{
+	const REAL fa = ABS(f), ga = ABS(g), ha = ABS(h);
+	const REAL fhmn = MIN(fa, ha), fhmx = MAX(fa, ha);
+
+	if (fhmn == 0)
+		return 0;
+
+	const REAL as = 1 + fhmn / fhmx, at = (fhmx - fhmn) / fhmx;
+
+	if (ga < fhmx)
+	{
+		const REAL au = (ga / fhmx) * (ga / fhmx);
+		return fhmn * (2 / (SQRT(as * as + au) + SQRT(at * at + au)));
+	}
+
+	const REAL au = fhmx / ga;
+	if (au == 0)
+		return (fhmn * fhmx) / ga;
+
+	return 2 * fhmn * au / (SQRT(1 + (as * au) * (as * au)) + SQRT(1 + (at * au) * (at * au)));
+}
+
+// The singular values of the n x n upper bidiagonal matrix with diagonal d and superdiagonal
+// e (destroyed) with the implicit QR iteration of xBDSQR: shifted sweeps chase a bulge from the
+// top of the last unreduced block to its bottom, zeros on the diagonal are chased out of the
+// block first. The left rotations are applied to the columns of the um x n U, the right ones
+// to those of the n x n V, either may be NULL. Singular values (and vectors) end up positive
+// and in descending order. Returns LAPACK's INFO: 0, or the number of superdiagonal elements
+// that didn't converge.
+static int PFX(bdsqr_impl)(int n, REAL* d, REAL* e, REAL* u, int um, int ldu, REAL* v, int ldv)
+{
+	struct PFX(rotations) urot, vrot;
+	// xBDSQR's tolerance, eps^(-1/8) relative accuracy clamped to 10..100 eps
+	const REAL tol = MAX(10, MIN(100, SQRT(SQRT(SQRT(1 / EPS))))) * EPS;
+	REAL anorm = 0;
+
+	for (int i = 0; i < n; i++)
+		anorm = MAX(anorm, ABS(d[i]) + (i < n - 1 ? ABS(e[i]) : 0));
+
+	const REAL thresh = tol * anorm;
+	const long maxit = 6 * (long) n * n;
+	long iter = 0;
+	int info = 0;
+
+	PFX(rotations_init)(&urot, u, um, n, ldu);
+	PFX(rotations_init)(&vrot, v, n, n, ldv);
+
+	#define NEGLIGIBLE(i) (ABS(e[i]) <= thresh || ABS(e[i]) <= tol * (ABS(d[i]) + ABS(d[(i) + 1])))
+
+	for (int hi = n - 1; hi > 0; )
+	{
+		if (NEGLIGIBLE(hi - 1))
+		{
+			e[--hi] = 0;
+			continue;
+		}
+
+		int lo = hi - 1;
+		while (lo > 0 && !NEGLIGIBLE(lo - 1))
+			lo--;
+		if (lo > 0)
+			e[lo - 1] = 0;
+
+		if (iter > maxit)
+		{
+			for (int i = 0; i < n - 1; i++)
+			{
+				if (e[i] != 0)
+					info++;
+			}
+			break;
+		}
+
+		int k = lo;
+		while (k <= hi && ABS(d[k]) > thresh)
+			k++;
+
+		if (k < hi)
+		{
+			// rotate the row of the zero d[k] into the ones below it until its element is gone
+			REAL f = e[k];
+
+			d[k] = e[k] = 0;
+			for (int j = k + 1; j <= hi && f != 0; j++)
+			{
+				REAL c, s;
+
+				PFX(lartg_impl)(d[j], f, &c, &s, &d[j]);
+				PFX(rotations_add)(&urot, j, k, c, s);
+				if (j < hi)
+				{
+					f = -s * e[j];
+					e[j] *= c;
+				}
+			}
+			continue;
+		}
+		else if (k == hi)
+		{
+			// the same with the column of the zero d[hi] and the columns left of it
+			REAL f = e[hi - 1];
+
+			d[hi] = e[hi - 1] = 0;
+			for (int j = hi - 1; j >= lo && f != 0; j--)
+			{
+				REAL c, s;
+
+				PFX(lartg_impl)(d[j], f, &c, &s, &d[j]);
+				PFX(rotations_add)(&vrot, j, hi, c, s);
+				if (j > lo)
+				{
+					f = -s * e[j - 1];
+					e[j - 1] *= c;
+				}
+			}
+			continue;
+		}
+
+		// shift by the smaller singular value of the bottom 2x2 block, unless it's negligible
+		REAL shift = PFX(las2_min)(d[hi - 1], e[hi - 1], d[hi]);
+		if ((shift / d[lo]) * (shift / d[lo]) < EPS)
+			shift = 0;
+
+		REAL f = (ABS(d[lo]) - shift) * (copysign(1, d[lo]) + shift / d[lo]);
+		REAL g = e[lo];
+
+		for (int i = lo; i < hi; i++)
+		{
+			REAL cr, sr, cl, sl, r;
+
+			PFX(lartg_impl)(f, g, &cr, &sr, &r);
+			if (i > lo)
+				e[i - 1] = r;
+			f = cr * d[i] + sr * e[i];
+			e[i] = cr * e[i] - sr * d[i];
+			g = sr * d[i + 1];
+			d[i + 1] *= cr;
+
+			PFX(lartg_impl)(f, g, &cl, &sl, &d[i]);
+			f = cl * e[i] + sl * d[i + 1];
+			d[i + 1] = cl * d[i + 1] - sl * e[i];
+			if (i < hi - 1)
+			{
+				g = sl * e[i + 1];
+				e[i + 1] *= cl;
+			}
+
+			PFX(rotations_add)(&vrot, i, i + 1, cr, sr);
+			PFX(rotations_add)(&urot, i, i + 1, cl, sl);
+		}
+
+		e[hi - 1] = f;
+		iter += hi - lo;
+	}
+
+	#undef NEGLIGIBLE
+
+	PFX(rotations_finish)(&urot);
+	PFX(rotations_finish)(&vrot);
+
+	for (int i = 0; i < n; i++)
+	{
+		if (d[i] < 0)
+		{
+			d[i] = -d[i];
+			if (v)
+				CBLAS(scal)(n, -1, v + (size_t) i * ldv, 1);
+		}
+	}
+
+	// selection sort, which swaps each singular vector at most once
+	for (int i = 0; i < n - 1; i++)
+	{
+		int k = i;
+
+		for (int j = i + 1; j < n; j++)
+		{
+			if (d[j] > d[k])
+				k = j;
+		}
+
+		if (k != i)
+		{
+			const REAL t = d[k];
+			d[k] = d[i];
+			d[i] = t;
+
+			if (u)
+				CBLAS(swap)(um, u + (size_t) i * ldu, 1, u + (size_t) k * ldu, 1);
+			if (v)
+				CBLAS(swap)(n, v + (size_t) i * ldv, 1, v + (size_t) k * ldv, 1);
+		}
+	}
+
+	return info;
+}
+
+// SVD of the m x n matrix A with m >= n, or of A^T if `transposed` (A being n x m then).
+// The singular values go to s in descending order, the first lcols columns of U to l
+// (lcols is 0, n or m) and V to v if it isn't NULL. Returns LAPACK's INFO.
+static int PFX(svd_tall)(int m, int n, const REAL* a, int lda, bool transposed, REAL* s,
+	REAL* l, int ldl, int lcols, REAL* v, int ldv)
+{
+	// the crossover of xGESVD, see ilaenv_(6): B is made from the R of A = Q * R beyond it
+	const bool tall = m > n && m >= (int) (n * 1.6);
+	const int bm = tall ? n : m;
+	const size_t lwork = MAX(m, lcols);
+	REAL* c = (REAL*) malloc(sizeof(REAL) * ((size_t) m * n + (tall ? (size_t) n * n : 0) + 4 * (size_t) n + lwork));
+
+	if (!c)
+		return n;
+
+	REAL* b = tall ? c + (size_t) m * n : c;
+	REAL* e = b + (size_t) bm * n;
+	REAL* tauq = e + n;
+	REAL* taup = tauq + n;
+	REAL* tau = taup + n;
+	REAL* work = tau + n;
+
+	for (int j = 0; j < n; j++)
+	{
+		if (transposed)
+			CBLAS(copy)(m, a + j, lda, c + (size_t) j * m, 1);
+		else
+			CBLAS(copy)(m, a + (size_t) j * lda, 1, c + (size_t) j * m, 1);
+	}
+
+	if (tall)
+	{
+		PFX(geqrf_impl)(m, n, c, m, tau, work);
+
+		for (int j = 0; j < n; j++)
+		{
+			for (int i = 0; i < n; i++)
+				b[i + (size_t) j * n] = (i <= j) ? c[i + (size_t) j * m] : 0;
+		}
+	}
+
+	PFX(gebrd_impl)(bm, n, b, bm, s, e, tauq, taup, work);
+
+	// Q of the bidiagonal reduction, to be rotated into U (or into the top of U, see below)
+	if (lcols)
+	{
+		for (int j = 0; j < n; j++)
+			CBLAS(copy)(bm, b + (size_t) j * bm, 1, l + (size_t) j * ldl, 1);
+		PFX(orgqr_impl)(bm, tall ? n : lcols, n, l, ldl, tauq, work);
+	}
+
+	// P, whose reflectors are those of a QR factorization of B(0:n-1,1:n)^T, so they are
+	// shifted one row down and handed to xORGQR like xORGBR does
+	if (v)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			for (int i = 0; i < n; i++)
+				v[i + (size_t) j * ldv] = (j > 0 && i > j) ? b[(j - 1) + (size_t) i * bm] : (i == j);
+		}
+
+		if (n > 1)
+			PFX(orgqr_impl)(n - 1, n - 1, n - 1, v + 1 + ldv, ldv, taup, work);
+	}
+
+	const int info = PFX(bdsqr_impl)(n, s, e, lcols ? l : NULL, bm, ldl, v, ldv);
+
+	if (lcols && tall)
+	{
+		// U = Q * [U_B 0; 0 I]
+		for (int j = 0; j < lcols; j++)
+		{
+			REAL* col = l + (size_t) j * ldl;
+
+			for (int i = (j < n) ? n : 0; i < m; i++)
+				col[i] = (i == j);
+		}
+
+		PFX(ormqr_impl)(true, false, m, lcols, n, c, m, tau, l, ldl, work);
+	}
+
+	free(c);
+	return info;
+}
+
+// The m x ucols U and vrows x n V^T, where ucols is 0, min(m,n) or m and vrows 0, min(m,n)
+// or n. U or V^T may be A itself. Returns LAPACK's INFO.
+static int PFX(gesvd_impl)(int m, int n, REAL* a, int lda, REAL* s, REAL* u, int ldu, int ucols,
+	REAL* vt, int ldvt, int vrows)
+{
+	int info;
+
+	if (m >= n)
+	{
+		REAL* v = NULL;
+
+		if (vrows && !(v = (REAL*) malloc(sizeof(REAL) * n * n)))
+			return n;
+
+		info = PFX(svd_tall)(m, n, a, lda, false, s, u, ldu, ucols, v, n);
+
+		for (int j = 0; j < n && v; j++)
+			CBLAS(copy)(n, v + (size_t) j * n, 1, vt + j, ldvt);
+		free(v);
+	}
+	else
+	{
+		// A^T = U' * S * V'^T, so U = V' and V^T = U'^T
+		REAL* l = NULL;
+
+		if (vrows && !(l = (REAL*) malloc(sizeof(REAL) * n * vrows)))
+			return m;
+
+		info = PFX(svd_tall)(n, m, a, lda, true, s, l, n, vrows, ucols ? u : NULL, ldu);
+
+		for (int j = 0; j < vrows; j++)
+			CBLAS(copy)(n, l + (size_t) j * n, 1, vt + j, ldvt);
+		free(l);
+	}
+
+	return info;
+}
+
+int F(gesvd_)(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__s, REAL *__u, __CLPK_integer *__ldu, REAL *__vt, __CLPK_integer *__ldvt, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GESVD);
+	const int m = *__m, n = *__n;
+	const int mn = MIN(m, n), mx = MAX(m, n);
+	const bool ua = lsame_(__jobu, "A"), us = lsame_(__jobu, "S"), uo = lsame_(__jobu, "O");
+	const bool va = lsame_(__jobvt, "A"), vs = lsame_(__jobvt, "S"), vo = lsame_(__jobvt, "O");
+	const int minwork = MAX1(MAX(3 * mn + mx, 5 * mn));
+
+	*__work = (REAL) minwork;
+
+	CHECK(ua || us || uo || lsame_(__jobu, "N"), 1);
+	CHECK((va || vs || vo || lsame_(__jobvt, "N")) && !(uo && vo), 2);
+	CHECK(m >= 0, 3);
+	CHECK(n >= 0, 4);
+	CHECK(*__lda >= MAX1(m), 6);
+	CHECK(*__ldu >= 1 && !((ua || us) && *__ldu < m), 9);
+	CHECK(*__ldvt >= 1 && !(va && *__ldvt < n) && !(vs && *__ldvt < mn), 11);
+	CHECK(*__lwork >= minwork || *__lwork == -1, 13);
+
+	*__info = 0;
+	if (*__lwork == -1 || mn == 0)
+		return 0;
+
+	REAL* u = uo ? __a : __u;
+	const int ldu = uo ? *__lda : *__ldu;
+	REAL* vt = vo ? __a : __vt;
+	const int ldvt = vo ? *__lda : *__ldvt;
+
+	*__info = PFX(gesvd_impl)(m, n, __a, *__lda, __s, u, ldu, ua ? m : (us || uo) ? mn : 0,
+		vt, ldvt, va ? n : (vs || vo) ? mn : 0);
+	return 0;
+}
+LAPACK_ALIASES(int, F(gesvd_), F(gesvd), FU(GESVD), FU(GESVD_),
+	(char *__jobu, char *__jobvt, __CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__s, REAL *__u, __CLPK_integer *__ldu, REAL *__vt, __CLPK_integer *__ldvt, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__info),
+	(__jobu, __jobvt, __m, __n, __a, __lda, __s, __u, __ldu, __vt, __ldvt, __work, __lwork, __info))
+
+int F(gesdd_)(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__s, REAL *__u, __CLPK_integer *__ldu, REAL *__vt, __CLPK_integer *__ldvt, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info)
+{
+	static const char routine[] = ROUTINE(GESDD);
+	const int m = *__m, n = *__n;
+	const int mn = MIN(m, n), mx = MAX(m, n);
+	const bool za = lsame_(__jobz, "A"), zs = lsame_(__jobz, "S"), zo = lsame_(__jobz, "O");
+	const bool zn = lsame_(__jobz, "N");
+	int minwork;
+
+	(void)__iwork;
+
+	// the workspace documented by the reference
+	if (zn)
+		minwork = 3 * mn + MAX(mx, 7 * mn);
+	else if (zo)
+		minwork = 3 * mn + MAX(mx, 5 * mn * mn + 4 * mn);
+	else
+		minwork = 4 * mn * mn + 7 * mn;
+	minwork = MAX1(minwork);
+
+	*__work = (REAL) minwork;
+
+	CHECK(za || zs || zo || zn, 1);
+	CHECK(m >= 0, 2);
+	CHECK(n >= 0, 3);
+	CHECK(*__lda >= MAX1(m), 5);
+	CHECK(*__ldu >= 1 && !((za || zs || (zo && m < n)) && *__ldu < m), 8);
+	CHECK(*__ldvt >= 1 && !((za || (zo && m >= n)) && *__ldvt < n) && !(zs && *__ldvt < mn), 10);
+	CHECK(*__lwork >= minwork || *__lwork == -1, 12);
+
+	*__info = 0;
+	if (*__lwork == -1 || mn == 0)
+		return 0;
+
+	// with 'O', A is overwritten by U if m >= n and by V^T otherwise
+	REAL* u = (zo && m >= n) ? __a : __u;
+	const int ldu = (zo && m >= n) ? *__lda : *__ldu;
+	REAL* vt = (zo && m < n) ? __a : __vt;
+	const int ldvt = (zo && m < n) ? *__lda : *__ldvt;
+	int ucols = 0, vrows = 0;
+
+	if (za)
+	{
+		ucols = m;
+		vrows = n;
+	}
+	else if (zs)
+	{
+		ucols = vrows = mn;
+	}
+	else if (zo)
+	{
+		ucols = (m >= n) ? mn : m;
+		vrows = (m >= n) ? n : mn;
+	}
+
+	*__info = PFX(gesvd_impl)(m, n, __a, *__lda, __s, u, ldu, ucols, vt, ldvt, vrows);
+	return 0;
+}
+LAPACK_ALIASES(int, F(gesdd_), F(gesdd), FU(GESDD), FU(GESDD_),
+	(char *__jobz, __CLPK_integer *__m, __CLPK_integer *__n, REAL *__a, __CLPK_integer *__lda, REAL *__s, REAL *__u, __CLPK_integer *__ldu, REAL *__vt, __CLPK_integer *__ldvt, REAL *__work, __CLPK_integer *__lwork, __CLPK_integer *__iwork, __CLPK_integer *__info),
+	(__jobz, __m, __n, __a, __lda, __s, __u, __ldu, __vt, __ldvt, __work, __lwork, __iwork, __info))
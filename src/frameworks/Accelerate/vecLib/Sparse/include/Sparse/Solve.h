@@ -0,0 +1,214 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _Sparse_Solve_H_
+#define _Sparse_Solve_H_
+
+// Included by Sparse.h. The sparse solver interface, overloaded on the element type.
+
+typedef void (^SparseOperator_Double)(bool accumulate, enum CBLAS_TRANSPOSE trans, DenseMatrix_Double X, DenseMatrix_Double Y);
+typedef void (^SparseOperator_Float)(bool accumulate, enum CBLAS_TRANSPOSE trans, DenseMatrix_Float X, DenseMatrix_Float Y);
+typedef void (^SparseVectorOperator_Double)(bool accumulate, enum CBLAS_TRANSPOSE trans, DenseVector_Double x, DenseVector_Double y);
+typedef void (^SparseVectorOperator_Float)(bool accumulate, enum CBLAS_TRANSPOSE trans, DenseVector_Float x, DenseVector_Float y);
+
+// Matrices
+
+SparseMatrix_Double SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const double *val);
+SparseMatrix_Float SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const float *val);
+SparseMatrix_Double SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const double *val, void *storage, void *workspace);
+SparseMatrix_Float SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const float *val, void *storage, void *workspace);
+SparseMatrix_Double SPARSE_PUBLIC_INTERFACE SparseConvertFromOpaque(sparse_matrix_double matrix);
+SparseMatrix_Float SPARSE_PUBLIC_INTERFACE SparseConvertFromOpaque(sparse_matrix_float matrix);
+
+SparseMatrix_Double SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseMatrix_Double Matrix);
+SparseMatrix_Float SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseMatrix_Float Matrix);
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseOpaqueFactorization_Double Factor);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseOpaqueFactorization_Float Factor);
+SparseOpaqueSubfactor_Double SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseOpaqueSubfactor_Double Subfactor);
+SparseOpaqueSubfactor_Float SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SparseOpaqueSubfactor_Float Subfactor);
+
+// Y = AX, Y = alpha AX, Y += AX and Y += alpha AX
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseMatrix_Double A, DenseMatrix_Double X, DenseMatrix_Double Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseMatrix_Float A, DenseMatrix_Float X, DenseMatrix_Float Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseMatrix_Double A, DenseVector_Double x, DenseVector_Double y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseMatrix_Float A, DenseVector_Float x, DenseVector_Float y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(double alpha, SparseMatrix_Double A, DenseMatrix_Double X, DenseMatrix_Double Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(float alpha, SparseMatrix_Float A, DenseMatrix_Float X, DenseMatrix_Float Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(double alpha, SparseMatrix_Double A, DenseVector_Double x, DenseVector_Double y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(float alpha, SparseMatrix_Float A, DenseVector_Float x, DenseVector_Float y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SparseMatrix_Double A, DenseMatrix_Double X, DenseMatrix_Double Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SparseMatrix_Float A, DenseMatrix_Float X, DenseMatrix_Float Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SparseMatrix_Double A, DenseVector_Double x, DenseVector_Double y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SparseMatrix_Float A, DenseVector_Float x, DenseVector_Float y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(double alpha, SparseMatrix_Double A, DenseMatrix_Double X, DenseMatrix_Double Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(float alpha, SparseMatrix_Float A, DenseMatrix_Float X, DenseMatrix_Float Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(double alpha, SparseMatrix_Double A, DenseVector_Double x, DenseVector_Double y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(float alpha, SparseMatrix_Float A, DenseVector_Float x, DenseVector_Float y);
+
+// Direct methods
+
+// Symbolic factorization of the structure alone
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrixStructure Matrix);
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrixStructure Matrix, SparseSymbolicFactorOptions sfoptions);
+
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrix_Double Matrix);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrix_Float Matrix);
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrix_Double Matrix, SparseSymbolicFactorOptions sfoptions, SparseNumericFactorOptions nfoptions);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrix_Float Matrix, SparseSymbolicFactorOptions sfoptions, SparseNumericFactorOptions nfoptions);
+
+// Numeric factorization with the pattern of a symbolic one
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Double Matrix);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Float Matrix);
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Double Matrix, SparseNumericFactorOptions nfoptions);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Float Matrix, SparseNumericFactorOptions nfoptions);
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Double Matrix, SparseNumericFactorOptions nfoptions, void *factorStorage, void *workspace);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SparseMatrix_Float Matrix, SparseNumericFactorOptions nfoptions, void *factorStorage, void *workspace);
+
+// Factors a matrix with the same pattern into an existing factorization
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Double Matrix, SparseOpaqueFactorization_Double *Factorization);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Float Matrix, SparseOpaqueFactorization_Float *Factorization);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Double Matrix, SparseOpaqueFactorization_Double *Factorization, SparseNumericFactorOptions nfoptions);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Float Matrix, SparseOpaqueFactorization_Float *Factorization, SparseNumericFactorOptions nfoptions);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Double Matrix, SparseOpaqueFactorization_Double *Factorization, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Float Matrix, SparseOpaqueFactorization_Float *Factorization, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Double Matrix, SparseOpaqueFactorization_Double *Factorization, SparseNumericFactorOptions nfoptions, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SparseMatrix_Float Matrix, SparseOpaqueFactorization_Float *Factorization, SparseNumericFactorOptions nfoptions, void *workspace);
+
+// XB = A^-1 XB in place, or X = A^-1 B; the least squares or minimum norm solution for QR
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseMatrix_Double XB);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseMatrix_Float XB);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseMatrix_Double XB, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseMatrix_Float XB, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseMatrix_Double B, DenseMatrix_Double X);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseMatrix_Float B, DenseMatrix_Float X);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseMatrix_Double B, DenseMatrix_Double X, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseMatrix_Float B, DenseMatrix_Float X, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseVector_Double xb);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseVector_Float xb);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseVector_Double xb, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseVector_Float xb, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseVector_Double b, DenseVector_Double x);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseVector_Float b, DenseVector_Float x);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Double Factored, DenseVector_Double b, DenseVector_Double x, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueFactorization_Float Factored, DenseVector_Float b, DenseVector_Float x, void *workspace);
+
+// A part of a factorization, which keeps a reference to it until SparseCleanup()
+SparseOpaqueSubfactor_Double SPARSE_PUBLIC_INTERFACE SparseCreateSubfactor(SparseSubfactor_t subfactor, SparseOpaqueFactorization_Double Factor);
+SparseOpaqueSubfactor_Float SPARSE_PUBLIC_INTERFACE SparseCreateSubfactor(SparseSubfactor_t subfactor, SparseOpaqueFactorization_Float Factor);
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double XY);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float XY);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double XY, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float XY, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double X, DenseMatrix_Double Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float X, DenseMatrix_Float Y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double X, DenseMatrix_Double Y, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float X, DenseMatrix_Float Y, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double xy);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float xy);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double xy, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float xy, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double x, DenseVector_Double y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float x, DenseVector_Float y);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double x, DenseVector_Double y, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float x, DenseVector_Float y, void *workspace);
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double XB);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float XB);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double XB, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float XB, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double B, DenseMatrix_Double X);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float B, DenseMatrix_Float X);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseMatrix_Double B, DenseMatrix_Double X, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseMatrix_Float B, DenseMatrix_Float X, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double xb);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float xb);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double xb, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float xb, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double b, DenseVector_Double x);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float b, DenseVector_Float x);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Double Subfactor, DenseVector_Double b, DenseVector_Double x, void *workspace);
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SparseOpaqueSubfactor_Float Subfactor, DenseVector_Float b, DenseVector_Float x, void *workspace);
+
+// Iterative methods
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseConjugateGradient(void);
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseConjugateGradient(SparseCGOptions options);
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseGMRES(void);
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseGMRES(SparseGMRESOptions options);
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseLSMR(void);
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseLSMR(SparseLSMROptions options);
+
+SparseOpaquePreconditioner_Double SPARSE_PUBLIC_INTERFACE SparseCreatePreconditioner(SparsePreconditioner_t type, SparseMatrix_Double A);
+SparseOpaquePreconditioner_Float SPARSE_PUBLIC_INTERFACE SparseCreatePreconditioner(SparsePreconditioner_t type, SparseMatrix_Float A);
+
+// Solves AX = B, or min |AX - B| for LSMR, from the initial guess in X
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseMatrix_Double B, DenseMatrix_Double X);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseMatrix_Float B, DenseMatrix_Float X);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseMatrix_Double B, DenseMatrix_Double X, SparsePreconditioner_t Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseMatrix_Float B, DenseMatrix_Float X, SparsePreconditioner_t Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseMatrix_Double B, DenseMatrix_Double X, SparseOpaquePreconditioner_Double Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseMatrix_Float B, DenseMatrix_Float X, SparseOpaquePreconditioner_Float Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseVector_Double b, DenseVector_Double x);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseVector_Float b, DenseVector_Float x);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseVector_Double b, DenseVector_Double x, SparsePreconditioner_t Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseVector_Float b, DenseVector_Float x, SparsePreconditioner_t Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Double A, DenseVector_Double b, DenseVector_Double x, SparseOpaquePreconditioner_Double Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseMatrix_Float A, DenseVector_Float b, DenseVector_Float x, SparseOpaquePreconditioner_Float Preconditioner);
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseOperator_Double ApplyOperator, DenseMatrix_Double B, DenseMatrix_Double X);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseOperator_Float ApplyOperator, DenseMatrix_Float B, DenseMatrix_Float X);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseOperator_Double ApplyOperator, DenseMatrix_Double B, DenseMatrix_Double X, SparseOpaquePreconditioner_Double Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseOperator_Float ApplyOperator, DenseMatrix_Float B, DenseMatrix_Float X, SparseOpaquePreconditioner_Float Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseVectorOperator_Double ApplyOperator, DenseVector_Double b, DenseVector_Double x);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseVectorOperator_Float ApplyOperator, DenseVector_Float b, DenseVector_Float x);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseVectorOperator_Double ApplyOperator, DenseVector_Double b, DenseVector_Double x, SparseOpaquePreconditioner_Double Preconditioner);
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SparseVectorOperator_Float ApplyOperator, DenseVector_Float b, DenseVector_Float x, SparseOpaquePreconditioner_Float Preconditioner);
+
+// One iteration on the columns that haven't converged, see _SparseCGIterate_Double()
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, SparseOperator_Double ApplyOperator, DenseMatrix_Double B, DenseMatrix_Double R, DenseMatrix_Double X);
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, SparseOperator_Float ApplyOperator, DenseMatrix_Float B, DenseMatrix_Float R, DenseMatrix_Float X);
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, SparseOperator_Double ApplyOperator, DenseMatrix_Double B, DenseMatrix_Double R, DenseMatrix_Double X, SparseOpaquePreconditioner_Double Preconditioner);
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, SparseOperator_Float ApplyOperator, DenseMatrix_Float B, DenseMatrix_Float R, DenseMatrix_Float X, SparseOpaquePreconditioner_Float Preconditioner);
+
+// Bytes of state SparseIterate() needs
+size_t SPARSE_PUBLIC_INTERFACE SparseGetStateSize_Double(SparseIterativeMethod method, bool preconditioner, int m, int n, int nrhs);
+size_t SPARSE_PUBLIC_INTERFACE SparseGetStateSize_Float(SparseIterativeMethod method, bool preconditioner, int m, int n, int nrhs);
+
+// Reference counting
+
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueSymbolicFactorization SymbolicFactor);
+SparseOpaqueFactorization_Double SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueFactorization_Double NumericFactor);
+SparseOpaqueFactorization_Float SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueFactorization_Float NumericFactor);
+SparseOpaqueSubfactor_Double SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueSubfactor_Double Subfactor);
+SparseOpaqueSubfactor_Float SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueSubfactor_Float Subfactor);
+
+// Releases what Sparse allocated
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueSymbolicFactorization Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueFactorization_Double Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueFactorization_Float Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueSubfactor_Double Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueSubfactor_Float Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseMatrix_Double Matrix);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseMatrix_Float Matrix);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaquePreconditioner_Double Opaque);
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaquePreconditioner_Float Opaque);
+
+#endif
@@ -21,207 +21,429 @@
 #ifndef _Sparse_H_
 #define _Sparse_H_
 
-void* _SparseCGIterate_Double(void);
-void* _SparseCGIterate_Float(void);
-void* _SparseCGSolve_Double(void);
-void* _SparseCGSolve_Float(void);
-void* _SparseConvertFromCoordinate_Double(void);
-void* _SparseConvertFromCoordinate_Float(void);
-void* _SparseConvertFromOpaque_Double(void);
-void* _SparseConvertFromOpaque_Float(void);
-void* _SparseCreatePreconditioner_Double(void);
-void* _SparseCreatePreconditioner_Float(void);
-void* _SparseDestroyOpaqueNumeric_Double(void);
-void* _SparseDestroyOpaqueNumeric_Float(void);
-void* _SparseDestroyOpaqueSymbolic(void);
-void* _SparseFactorQR_Double(void);
-void* _SparseFactorQR_Float(void);
-void* _SparseFactorSymmetric_Double(void);
-void* _SparseFactorSymmetric_Float(void);
-void* _SparseGMRESIterate_Double(void);
-void* _SparseGMRESIterate_Float(void);
-void* _SparseGMRESSolve_Double(void);
-void* _SparseGMRESSolve_Float(void);
-void* _SparseGetIterativeStateSize_Double(void);
-void* _SparseGetIterativeStateSize_Float(void);
-void* _SparseGetOptionsFromNumericFactor_Double(void);
-void* _SparseGetOptionsFromNumericFactor_Float(void);
-void* _SparseGetOptionsFromSymbolicFactor(void);
-void* _SparseGetWorkspaceRequired_Double(void);
-void* _SparseGetWorkspaceRequired_Float(void);
-void* _SparseLSMRIterate_Double(void);
-void* _SparseLSMRIterate_Float(void);
-void* _SparseLSMRSolve_Double(void);
-void* _SparseLSMRSolve_Float(void);
-void* _SparseMultiplySubfactor_Double(void);
-void* _SparseMultiplySubfactor_Float(void);
-void* _SparseNumericFactorQR_Double(void);
-void* _SparseNumericFactorQR_Float(void);
-void* _SparseNumericFactorSymmetric_Double(void);
-void* _SparseNumericFactorSymmetric_Float(void);
-void* _SparseRefactorQR_Double(void);
-void* _SparseRefactorQR_Float(void);
-void* _SparseRefactorSymmetric_Double(void);
-void* _SparseRefactorSymmetric_Float(void);
-void* _SparseReleaseOpaquePreconditioner_Double(void);
-void* _SparseReleaseOpaquePreconditioner_Float(void);
-void* _SparseRetainNumeric_Double(void);
-void* _SparseRetainNumeric_Float(void);
-void* _SparseRetainSymbolic(void);
-void* _SparseSolveOpaque_Double(void);
-void* _SparseSolveOpaque_Float(void);
-void* _SparseSolveSubfactor_Double(void);
-void* _SparseSolveSubfactor_Float(void);
-void* _SparseSpMV_Double(void);
-void* _SparseSpMV_Float(void);
-void* _SparseSymbolicFactorQR(void);
-void* _SparseSymbolicFactorSymmetric(void);
-void* _SparseTrap(void);
-void* _Z10SparseLSMR17SparseLSMROptions(void);
-void* _Z10SparseLSMRv(void);
-void* _Z11SparseGMRES18SparseGMRESOptions(void);
-void* _Z11SparseGMRESv(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseMatrix_FloatS1_(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseMatrix_FloatS1_32SparseOpaquePreconditioner_Float(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseMatrix_FloatS1_i(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseVector_FloatS1_(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseVector_FloatS1_32SparseOpaquePreconditioner_Float(void);
-void* _Z11SparseSolve21SparseIterativeMethod18SparseMatrix_Float17DenseVector_FloatS1_i(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseMatrix_DoubleS1_(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseMatrix_DoubleS1_33SparseOpaquePreconditioner_Double(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseMatrix_DoubleS1_i(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseVector_DoubleS1_(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseVector_DoubleS1_33SparseOpaquePreconditioner_Double(void);
-void* _Z11SparseSolve21SparseIterativeMethod19SparseMatrix_Double18DenseVector_DoubleS1_i(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE17DenseMatrix_FloatS1_ES1_S1_(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE17DenseMatrix_FloatS1_ES1_S1_32SparseOpaquePreconditioner_Float(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE17DenseVector_FloatS1_ES1_S1_(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE17DenseVector_FloatS1_ES1_S1_32SparseOpaquePreconditioner_Float(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE18DenseMatrix_DoubleS1_ES1_S1_(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE18DenseMatrix_DoubleS1_ES1_S1_33SparseOpaquePreconditioner_Double(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE18DenseVector_DoubleS1_ES1_S1_(void);
-void* _Z11SparseSolve21SparseIterativeMethodU13block_pointerFvb15CBLAS_TRANSPOSE18DenseVector_DoubleS1_ES1_S1_33SparseOpaquePreconditioner_Double(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseMatrix_Float(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseMatrix_FloatPv(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseMatrix_FloatS0_(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseMatrix_FloatS0_Pv(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseVector_Float(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseVector_FloatPv(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseVector_FloatS0_(void);
-void* _Z11SparseSolve27SparseOpaqueSubfactor_Float17DenseVector_FloatS0_Pv(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseMatrix_Double(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseMatrix_DoublePv(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseMatrix_DoubleS0_(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseMatrix_DoubleS0_Pv(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseVector_Double(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseVector_DoublePv(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseVector_DoubleS0_(void);
-void* _Z11SparseSolve28SparseOpaqueSubfactor_Double18DenseVector_DoubleS0_Pv(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseMatrix_Float(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseMatrix_FloatPv(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseMatrix_FloatS0_(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseMatrix_FloatS0_Pv(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseVector_Float(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseVector_FloatPv(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseVector_FloatS0_(void);
-void* _Z11SparseSolve31SparseOpaqueFactorization_Float17DenseVector_FloatS0_Pv(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseMatrix_Double(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseMatrix_DoublePv(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseMatrix_DoubleS0_(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseMatrix_DoubleS0_Pv(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseVector_Double(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseVector_DoublePv(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseVector_DoubleS0_(void);
-void* _Z11SparseSolve32SparseOpaqueFactorization_Double18DenseVector_DoubleS0_Pv(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization18SparseMatrix_Float(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization18SparseMatrix_Float26SparseNumericFactorOptions(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization18SparseMatrix_Float26SparseNumericFactorOptionsPvS2_(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization19SparseMatrix_Double(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization19SparseMatrix_Double26SparseNumericFactorOptions(void);
-void* _Z12SparseFactor33SparseOpaqueSymbolicFactorization19SparseMatrix_Double26SparseNumericFactorOptionsPvS2_(void);
-void* _Z12SparseFactorh18SparseMatrix_Float(void);
-void* _Z12SparseFactorh18SparseMatrix_Float27SparseSymbolicFactorOptions26SparseNumericFactorOptions(void);
-void* _Z12SparseFactorh19SparseMatrix_Double(void);
-void* _Z12SparseFactorh19SparseMatrix_Double27SparseSymbolicFactorOptions26SparseNumericFactorOptions(void);
-void* _Z12SparseFactorh21SparseMatrixStructure(void);
-void* _Z12SparseFactorh21SparseMatrixStructure27SparseSymbolicFactorOptions(void);
-void* _Z12SparseRetain27SparseOpaqueSubfactor_Float(void);
-void* _Z12SparseRetain28SparseOpaqueSubfactor_Double(void);
-void* _Z12SparseRetain31SparseOpaqueFactorization_Float(void);
-void* _Z12SparseRetain32SparseOpaqueFactorization_Double(void);
-void* _Z12SparseRetain33SparseOpaqueSymbolicFactorization(void);
-void* _Z13SparseCleanup18SparseMatrix_Float(void);
-void* _Z13SparseCleanup19SparseMatrix_Double(void);
-void* _Z13SparseCleanup27SparseOpaqueSubfactor_Float(void);
-void* _Z13SparseCleanup28SparseOpaqueSubfactor_Double(void);
-void* _Z13SparseCleanup31SparseOpaqueFactorization_Float(void);
-void* _Z13SparseCleanup32SparseOpaqueFactorization_Double(void);
-void* _Z13SparseCleanup32SparseOpaquePreconditioner_Float(void);
-void* _Z13SparseCleanup33SparseOpaquePreconditioner_Double(void);
-void* _Z13SparseCleanup33SparseOpaqueSymbolicFactorization(void);
-void* _Z13SparseIterate21SparseIterativeMethodiPKbPvU13block_pointerFvb15CBLAS_TRANSPOSE17DenseMatrix_FloatS4_ES4_S4_S4_(void);
-void* _Z13SparseIterate21SparseIterativeMethodiPKbPvU13block_pointerFvb15CBLAS_TRANSPOSE17DenseMatrix_FloatS4_ES4_S4_S4_32SparseOpaquePreconditioner_Float(void);
-void* _Z13SparseIterate21SparseIterativeMethodiPKbPvU13block_pointerFvb15CBLAS_TRANSPOSE18DenseMatrix_DoubleS4_ES4_S4_S4_(void);
-void* _Z13SparseIterate21SparseIterativeMethodiPKbPvU13block_pointerFvb15CBLAS_TRANSPOSE18DenseMatrix_DoubleS4_ES4_S4_S4_33SparseOpaquePreconditioner_Double(void);
-void* _Z14SparseMultiply18SparseMatrix_Float17DenseMatrix_FloatS0_(void);
-void* _Z14SparseMultiply18SparseMatrix_Float17DenseVector_FloatS0_(void);
-void* _Z14SparseMultiply19SparseMatrix_Double18DenseMatrix_DoubleS0_(void);
-void* _Z14SparseMultiply19SparseMatrix_Double18DenseVector_DoubleS0_(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseMatrix_Float(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseMatrix_FloatPv(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseMatrix_FloatS0_(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseMatrix_FloatS0_Pv(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseVector_Float(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseVector_FloatPv(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseVector_FloatS0_(void);
-void* _Z14SparseMultiply27SparseOpaqueSubfactor_Float17DenseVector_FloatS0_Pv(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseMatrix_Double(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseMatrix_DoublePv(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseMatrix_DoubleS0_(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseMatrix_DoubleS0_Pv(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseVector_Double(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseVector_DoublePv(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseVector_DoubleS0_(void);
-void* _Z14SparseMultiply28SparseOpaqueSubfactor_Double18DenseVector_DoubleS0_Pv(void);
-void* _Z14SparseMultiplyd19SparseMatrix_Double18DenseMatrix_DoubleS0_(void);
-void* _Z14SparseMultiplyd19SparseMatrix_Double18DenseVector_DoubleS0_(void);
-void* _Z14SparseMultiplyf18SparseMatrix_Float17DenseMatrix_FloatS0_(void);
-void* _Z14SparseMultiplyf18SparseMatrix_Float17DenseVector_FloatS0_(void);
-void* _Z14SparseRefactor18SparseMatrix_FloatP31SparseOpaqueFactorization_Float(void);
-void* _Z14SparseRefactor18SparseMatrix_FloatP31SparseOpaqueFactorization_Float26SparseNumericFactorOptions(void);
-void* _Z14SparseRefactor18SparseMatrix_FloatP31SparseOpaqueFactorization_Float26SparseNumericFactorOptionsPv(void);
-void* _Z14SparseRefactor18SparseMatrix_FloatP31SparseOpaqueFactorization_FloatPv(void);
-void* _Z14SparseRefactor19SparseMatrix_DoubleP32SparseOpaqueFactorization_Double(void);
-void* _Z14SparseRefactor19SparseMatrix_DoubleP32SparseOpaqueFactorization_Double26SparseNumericFactorOptions(void);
-void* _Z14SparseRefactor19SparseMatrix_DoubleP32SparseOpaqueFactorization_Double26SparseNumericFactorOptionsPv(void);
-void* _Z14SparseRefactor19SparseMatrix_DoubleP32SparseOpaqueFactorization_DoublePv(void);
-void* _Z17SparseMultiplyAdd18SparseMatrix_Float17DenseMatrix_FloatS0_(void);
-void* _Z17SparseMultiplyAdd18SparseMatrix_Float17DenseVector_FloatS0_(void);
-void* _Z17SparseMultiplyAdd19SparseMatrix_Double18DenseMatrix_DoubleS0_(void);
-void* _Z17SparseMultiplyAdd19SparseMatrix_Double18DenseVector_DoubleS0_(void);
-void* _Z17SparseMultiplyAddd19SparseMatrix_Double18DenseMatrix_DoubleS0_(void);
-void* _Z17SparseMultiplyAddd19SparseMatrix_Double18DenseVector_DoubleS0_(void);
-void* _Z17SparseMultiplyAddf18SparseMatrix_Float17DenseMatrix_FloatS0_(void);
-void* _Z17SparseMultiplyAddf18SparseMatrix_Float17DenseVector_FloatS0_(void);
-void* _Z18SparseGetTranspose18SparseMatrix_Float(void);
-void* _Z18SparseGetTranspose19SparseMatrix_Double(void);
-void* _Z18SparseGetTranspose27SparseOpaqueSubfactor_Float(void);
-void* _Z18SparseGetTranspose28SparseOpaqueSubfactor_Double(void);
-void* _Z18SparseGetTranspose31SparseOpaqueFactorization_Float(void);
-void* _Z18SparseGetTranspose32SparseOpaqueFactorization_Double(void);
-void* _Z21SparseCreateSubfactorh31SparseOpaqueFactorization_Float(void);
-void* _Z21SparseCreateSubfactorh32SparseOpaqueFactorization_Double(void);
-void* _Z23SparseConjugateGradient15SparseCGOptions(void);
-void* _Z23SparseConjugateGradientv(void);
-void* _Z23SparseConvertFromOpaqueP14sparse_m_float(void);
-void* _Z23SparseConvertFromOpaqueP15sparse_m_double(void);
-void* _Z24SparseGetStateSize_Float21SparseIterativeMethodbiii(void);
-void* _Z25SparseGetStateSize_Double21SparseIterativeMethodbiii(void);
-void* _Z26SparseCreatePreconditioneri18SparseMatrix_Float(void);
-void* _Z26SparseCreatePreconditioneri19SparseMatrix_Double(void);
-void* _Z27SparseConvertFromCoordinateiilh18SparseAttributes_tPKiS1_PKd(void);
-void* _Z27SparseConvertFromCoordinateiilh18SparseAttributes_tPKiS1_PKdPvS4_(void);
-void* _Z27SparseConvertFromCoordinateiilh18SparseAttributes_tPKiS1_PKf(void);
-void* _Z27SparseConvertFromCoordinateiilh18SparseAttributes_tPKiS1_PKfPvS4_(void);
+#include <BLAS/BLAS.h>
+#include <SparseBLAS/SparseBLAS.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The solver interface of Sparse/Solve.h. The public functions are overloaded, clang's
+// overloadable attribute gives them the same (C++) symbol names as Apple's library. They're
+// thin wrappers around the _Sparse* functions below.
+#define SPARSE_PUBLIC_INTERFACE __attribute__((overloadable))
+
+typedef uint8_t SparseTriangle_t;
+enum
+{
+	SparseUpperTriangle = 0,
+	SparseLowerTriangle = 1,
+};
+
+typedef unsigned int SparseKind_t;
+enum
+{
+	SparseOrdinary = 0,
+	SparseTriangular = 1,
+	SparseUnitTriangular = 2,
+	SparseSymmetric = 3,
+};
+
+typedef struct
+{
+	bool transpose: 1;
+	SparseTriangle_t triangle: 1;
+	SparseKind_t kind: 2;
+	unsigned int _reserved: 11;
+	bool _allocatedBySparse: 1;
+} SparseAttributes_t;
+
+// Compressed sparse columns of blockSize x blockSize blocks, each stored column-major in data
+typedef struct
+{
+	int rowCount;
+	int columnCount;
+	long *columnStarts;
+	int *rowIndices;
+	SparseAttributes_t attributes;
+	uint8_t blockSize;
+} SparseMatrixStructure;
+
+typedef struct
+{
+	SparseMatrixStructure structure;
+	double *data;
+} SparseMatrix_Double;
+
+typedef struct
+{
+	SparseMatrixStructure structure;
+	float *data;
+} SparseMatrix_Float;
+
+typedef struct
+{
+	int count;
+	double *data;
+} DenseVector_Double;
+
+typedef struct
+{
+	int count;
+	float *data;
+} DenseVector_Float;
+
+// Column-major
+typedef struct
+{
+	int rowCount;
+	int columnCount;
+	int columnStride;
+	SparseAttributes_t attributes;
+	double *data;
+} DenseMatrix_Double;
+
+typedef struct
+{
+	int rowCount;
+	int columnCount;
+	int columnStride;
+	SparseAttributes_t attributes;
+	float *data;
+} DenseMatrix_Float;
+
+typedef int SparseStatus_t;
+enum
+{
+	SparseStatusOK = 0,
+	SparseFactorizationFailed = -1,
+	SparseMatrixIsSingular = -2,
+	SparseInternalError = -3,
+	SparseParameterError = -4,
+	SparseStatusReleased = -INT_MAX,
+};
+
+typedef uint8_t SparseFactorization_t;
+enum
+{
+	SparseFactorizationCholesky = 0,
+	SparseFactorizationLDLT = 1,
+	SparseFactorizationLDLTUnpivoted = 2,
+	SparseFactorizationLDLTSBK = 3,
+	SparseFactorizationLDLTTPP = 4,
+	SparseFactorizationQR = 40,
+	SparseFactorizationCholeskyAtA = 41,
+};
+
+typedef uint32_t SparseControl_t;
+enum
+{
+	SparseDefaultControl = 0,
+};
+
+typedef uint8_t SparseOrder_t;
+enum
+{
+	SparseOrderDefault = 0,
+	SparseOrderUser = 1,
+	SparseOrderAMD = 2,
+	SparseOrderMetis = 3,
+	SparseOrderCOLAMD = 4,
+};
+
+typedef uint8_t SparseScaling_t;
+enum
+{
+	SparseScalingDefault = 0,
+	SparseScalingUser = 1,
+	SparseScalingEquilibriationInf = 2,
+};
+
+typedef struct
+{
+	SparseControl_t control;
+	SparseOrder_t orderMethod;
+	// the ordering for SparseOrderUser, order[i] is the column eliminated i-th
+	int *order;
+	int *ignoreRowsAndColumns;
+	void *(*malloc)(size_t size);
+	void (*free)(void *pointer);
+	void (*reportError)(const char *message);
+} SparseSymbolicFactorOptions;
+
+typedef struct
+{
+	SparseControl_t control;
+	SparseScaling_t scalingMethod;
+	void *scaling;
+	// pivots smaller than pivotTolerance times the largest candidate aren't taken, pivots
+	// smaller than zeroTolerance are treated as zero
+	double pivotTolerance;
+	double zeroTolerance;
+} SparseNumericFactorOptions;
+
+typedef struct
+{
+	SparseStatus_t status;
+	int rowCount;
+	int columnCount;
+	SparseAttributes_t attributes;
+	uint8_t blockSize;
+	SparseFactorization_t type;
+	void *factorization;
+	size_t workspaceSize_Float;
+	size_t workspaceSize_Double;
+	size_t factorSize_Float;
+	size_t factorSize_Double;
+} SparseOpaqueSymbolicFactorization;
+
+typedef struct
+{
+	SparseStatus_t status;
+	SparseAttributes_t attributes;
+	SparseOpaqueSymbolicFactorization symbolicFactorization;
+	bool userFactorStorage;
+	void *numericFactorization;
+	size_t solveWorkspaceRequiredStatic;
+	size_t solveWorkspaceRequiredPerRHS;
+} SparseOpaqueFactorization_Double;
+
+typedef struct
+{
+	SparseStatus_t status;
+	SparseAttributes_t attributes;
+	SparseOpaqueSymbolicFactorization symbolicFactorization;
+	bool userFactorStorage;
+	void *numericFactorization;
+	size_t solveWorkspaceRequiredStatic;
+	size_t solveWorkspaceRequiredPerRHS;
+} SparseOpaqueFactorization_Float;
+
+// A symmetric factorization is A = P L D L^T P^T with D = I for Cholesky, a QR factorization
+// A P = Q R. S is the scaling, which is the identity.
+typedef uint8_t SparseSubfactor_t;
+enum
+{
+	SparseSubfactorInvalid = 0,
+	SparseSubfactorP = 1,
+	SparseSubfactorS = 2,
+	SparseSubfactorL = 3,
+	SparseSubfactorD = 4,
+	SparseSubfactorPLPS = 5,
+	SparseSubfactorQ = 6,
+	SparseSubfactorR = 7,
+	SparseSubfactorRP = 8,
+};
+
+typedef struct
+{
+	SparseAttributes_t attributes;
+	SparseSubfactor_t contents;
+	SparseOpaqueFactorization_Double factor;
+	size_t workspaceRequiredStatic;
+	size_t workspaceRequiredPerRHS;
+} SparseOpaqueSubfactor_Double;
+
+typedef struct
+{
+	SparseAttributes_t attributes;
+	SparseSubfactor_t contents;
+	SparseOpaqueFactorization_Float factor;
+	size_t workspaceRequiredStatic;
+	size_t workspaceRequiredPerRHS;
+} SparseOpaqueSubfactor_Float;
+
+// Iterative methods. Zero tolerances and counts in the options select the defaults:
+// 100 iterations, rtol = sqrt(epsilon), atol = 0, and 16 vectors for GMRES.
+typedef struct
+{
+	void (*reportError)(const char *message);
+	int maxIterations;
+	double atol;
+	double rtol;
+	void (*reportStatus)(const char *message);
+} SparseCGOptions;
+
+typedef uint8_t SparseGMRESVariant_t;
+enum
+{
+	SparseVariantDQGMRES = 0,
+	SparseVariantGMRES = 1,
+	SparseVariantFGMRES = 2,
+};
+
+typedef struct
+{
+	void (*reportError)(const char *message);
+	SparseGMRESVariant_t variant;
+	int nvec;
+	int maxIterations;
+	double atol;
+	double rtol;
+	void (*reportStatus)(const char *message);
+} SparseGMRESOptions;
+
+typedef int SparseLSMRConvergenceTest_t;
+enum
+{
+	SparseLSMRCTDefault = 0,
+	SparseLSMRCTFongSaunders = 1,
+};
+
+// LSMR solves min |AX - B|^2 + lambda^2 |X|^2. Its iteration limit defaults to 4 times the
+// number of columns, btol to sqrt(epsilon) and conditionLimit to 1 / sqrt(epsilon).
+typedef struct
+{
+	void (*reportError)(const char *message);
+	double lambda;
+	int nvec;
+	SparseLSMRConvergenceTest_t convergenceTest;
+	double atol;
+	double rtol;
+	double btol;
+	double conditionLimit;
+	int maxIterations;
+	void (*reportStatus)(const char *message);
+} SparseLSMROptions;
+
+enum
+{
+	_SparseMethodCG = 0,
+	_SparseMethodGMRES = 1,
+	_SparseMethodLSMR = 2,
+};
+
+typedef struct
+{
+	int method;
+	union
+	{
+		SparseCGOptions cg;
+		SparseGMRESOptions gmres;
+		SparseLSMROptions lsmr;
+		char padding[2048];
+	} options;
+} SparseIterativeMethod;
+
+typedef int SparseIterativeStatus_t;
+enum
+{
+	SparseIterativeConverged = 0,
+	SparseIterativeMaxIterations = 1,
+	SparseIterativeParameterError = -1,
+	SparseIterativeIllConditioned = -2,
+	SparseIterativeInternalError = -99,
+};
+
+typedef int SparsePreconditioner_t;
+enum
+{
+	SparsePreconditionerNone = 0,
+	SparsePreconditionerUser = 1,
+	// Jacobi, the inverse of the diagonal
+	SparsePreconditionerDiagonal = 2,
+	// scales the columns to unit 2-norm, for LSMR
+	SparsePreconditionerDiagScaling = 3,
+};
+
+// apply computes Y = P X, or Y = P^T X, for a preconditioner P that approximates A^-1
+typedef struct
+{
+	SparsePreconditioner_t type;
+	void *mem;
+	void (*apply)(void *mem, enum CBLAS_TRANSPOSE trans, DenseMatrix_Double X, DenseMatrix_Double Y);
+} SparseOpaquePreconditioner_Double;
+
+typedef struct
+{
+	SparsePreconditioner_t type;
+	void *mem;
+	void (*apply)(void *mem, enum CBLAS_TRANSPOSE trans, DenseMatrix_Float X, DenseMatrix_Float Y);
+} SparseOpaquePreconditioner_Float;
+
+// Called on every parameter error, a place to put a breakpoint
+void _SparseTrap(void);
+
+// Conversions. Without storage, the matrix is allocated and must be released with
+// SparseCleanup(). User storage needs (n + 1) longs, nBlock ints and nBlock * blockSize^2
+// values, 8-byte aligned, the workspace n ints. Duplicate entries are summed up.
+SparseMatrix_Double _SparseConvertFromCoordinate_Double(int __m, int __n, long __nBlock, uint8_t __blockSize, SparseAttributes_t __attributes, const int *__row, const int *__col, const double *__val, void *__storage, void *__workspace);
+SparseMatrix_Float _SparseConvertFromCoordinate_Float(int __m, int __n, long __nBlock, uint8_t __blockSize, SparseAttributes_t __attributes, const int *__row, const int *__col, const float *__val, void *__storage, void *__workspace);
+SparseMatrix_Double _SparseConvertFromOpaque_Double(sparse_matrix_double __matrix);
+SparseMatrix_Float _SparseConvertFromOpaque_Float(sparse_matrix_float __matrix);
+
+// Y = alpha op(A) X, added to Y if accumulate is set
+void _SparseSpMV_Double(double __alpha, SparseMatrix_Double __A, DenseMatrix_Double __X, bool __accumulate, DenseMatrix_Double __Y);
+void _SparseSpMV_Float(float __alpha, SparseMatrix_Float __A, DenseMatrix_Float __X, bool __accumulate, DenseMatrix_Float __Y);
+
+// Direct methods
+SparseOpaqueSymbolicFactorization _SparseSymbolicFactorSymmetric(SparseFactorization_t __type, const SparseMatrixStructure *__Matrix, const SparseSymbolicFactorOptions *__options);
+SparseOpaqueSymbolicFactorization _SparseSymbolicFactorQR(SparseFactorization_t __type, const SparseMatrixStructure *__Matrix, const SparseSymbolicFactorOptions *__options);
+void _SparseRetainSymbolic(SparseOpaqueSymbolicFactorization *__symbolic);
+void _SparseDestroyOpaqueSymbolic(SparseOpaqueSymbolicFactorization *__symbolic);
+SparseSymbolicFactorOptions _SparseGetOptionsFromSymbolicFactor(SparseOpaqueSymbolicFactorization *__factor);
+
+SparseOpaqueFactorization_Double _SparseFactorSymmetric_Double(SparseFactorization_t __type, const SparseMatrix_Double *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions);
+SparseOpaqueFactorization_Float _SparseFactorSymmetric_Float(SparseFactorization_t __type, const SparseMatrix_Float *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions);
+SparseOpaqueFactorization_Double _SparseFactorQR_Double(SparseFactorization_t __type, const SparseMatrix_Double *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions);
+SparseOpaqueFactorization_Float _SparseFactorQR_Float(SparseFactorization_t __type, const SparseMatrix_Float *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions);
+// factorStorage needs factorSize_* bytes of the symbolic factorization and workspace its
+// workspaceSize_*, either can be NULL to have them allocated
+SparseOpaqueFactorization_Double _SparseNumericFactorSymmetric_Double(SparseOpaqueSymbolicFactorization *__symbolic, const SparseMatrix_Double *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace);
+SparseOpaqueFactorization_Float _SparseNumericFactorSymmetric_Float(SparseOpaqueSymbolicFactorization *__symbolic, const SparseMatrix_Float *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace);
+SparseOpaqueFactorization_Double _SparseNumericFactorQR_Double(SparseOpaqueSymbolicFactorization *__symbolic, const SparseMatrix_Double *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace);
+SparseOpaqueFactorization_Float _SparseNumericFactorQR_Float(SparseOpaqueSymbolicFactorization *__symbolic, const SparseMatrix_Float *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace);
+void _SparseRefactorSymmetric_Double(const SparseMatrix_Double *__Matrix, SparseOpaqueFactorization_Double *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace);
+void _SparseRefactorSymmetric_Float(const SparseMatrix_Float *__Matrix, SparseOpaqueFactorization_Float *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace);
+void _SparseRefactorQR_Double(const SparseMatrix_Double *__Matrix, SparseOpaqueFactorization_Double *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace);
+void _SparseRefactorQR_Float(const SparseMatrix_Float *__Matrix, SparseOpaqueFactorization_Float *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace);
+void _SparseRetainNumeric_Double(SparseOpaqueFactorization_Double *__numeric);
+void _SparseRetainNumeric_Float(SparseOpaqueFactorization_Float *__numeric);
+void _SparseDestroyOpaqueNumeric_Double(SparseOpaqueFactorization_Double *__numeric);
+void _SparseDestroyOpaqueNumeric_Float(SparseOpaqueFactorization_Float *__numeric);
+SparseNumericFactorOptions _SparseGetOptionsFromNumericFactor_Double(SparseOpaqueFactorization_Double *__factor);
+SparseNumericFactorOptions _SparseGetOptionsFromNumericFactor_Float(SparseOpaqueFactorization_Float *__factor);
+// Workspace bytes a solve with the factorization, or with one of its subfactors, needs
+void _SparseGetWorkspaceRequired_Double(SparseSubfactor_t __Sub, SparseOpaqueFactorization_Double __Factor, size_t *__workStatic, size_t *__workPerRHS);
+void _SparseGetWorkspaceRequired_Float(SparseSubfactor_t __Sub, SparseOpaqueFactorization_Float __Factor, size_t *__workStatic, size_t *__workPerRHS);
+// Soln = A^-1 RHS, or the least squares solution for QR. RHS and Soln may be the same matrix
+// if it has room for the larger of the two.
+void _SparseSolveOpaque_Double(const SparseOpaqueFactorization_Double *__Factored, const DenseMatrix_Double *__RHS, const DenseMatrix_Double *__Soln, void *__workspace);
+void _SparseSolveOpaque_Float(const SparseOpaqueFactorization_Float *__Factored, const DenseMatrix_Float *__RHS, const DenseMatrix_Float *__Soln, void *__workspace);
+void _SparseMultiplySubfactor_Double(const SparseOpaqueSubfactor_Double *__Subfactor, const DenseMatrix_Double *__x, const DenseMatrix_Double *__y, char *__workspace);
+void _SparseMultiplySubfactor_Float(const SparseOpaqueSubfactor_Float *__Subfactor, const DenseMatrix_Float *__x, const DenseMatrix_Float *__y, char *__workspace);
+void _SparseSolveSubfactor_Double(const SparseOpaqueSubfactor_Double *__Subfactor, const DenseMatrix_Double *__b, const DenseMatrix_Double *__x, char *__workspace);
+void _SparseSolveSubfactor_Float(const SparseOpaqueSubfactor_Float *__Subfactor, const DenseMatrix_Float *__b, const DenseMatrix_Float *__x, char *__workspace);
+
+// Iterative methods. The Iterate functions do one iteration on the columns that haven't
+// converged, with `state` of _SparseGetIterativeStateSize_*() bytes: iteration 0 sets up the
+// state from X and B, a negative iteration stores the final solution in X. R receives the
+// residual B - AX, or A^T (B - AX) for LSMR. The operator computes Y = op(A) X, or
+// Y += op(A) X if accumulate is set, and is a block, so these need -fblocks.
+size_t _SparseGetIterativeStateSize_Double(const SparseIterativeMethod *__method, bool __preconditioner, int __m, int __n, int __nrhs);
+size_t _SparseGetIterativeStateSize_Float(const SparseIterativeMethod *__method, bool __preconditioner, int __m, int __n, int __nrhs);
+#if defined(__BLOCKS__)
+SparseIterativeStatus_t _SparseCGSolve_Double(const SparseCGOptions *__options, DenseMatrix_Double __X, DenseMatrix_Double __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double), const SparseOpaquePreconditioner_Double *__Preconditioner);
+SparseIterativeStatus_t _SparseCGSolve_Float(const SparseCGOptions *__options, DenseMatrix_Float __X, DenseMatrix_Float __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float), const SparseOpaquePreconditioner_Float *__Preconditioner);
+SparseIterativeStatus_t _SparseGMRESSolve_Double(const SparseGMRESOptions *__options, DenseMatrix_Double __X, DenseMatrix_Double __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double), const SparseOpaquePreconditioner_Double *__Preconditioner);
+SparseIterativeStatus_t _SparseGMRESSolve_Float(const SparseGMRESOptions *__options, DenseMatrix_Float __X, DenseMatrix_Float __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float), const SparseOpaquePreconditioner_Float *__Preconditioner);
+SparseIterativeStatus_t _SparseLSMRSolve_Double(const SparseLSMROptions *__options, DenseMatrix_Double __X, DenseMatrix_Double __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double), const SparseOpaquePreconditioner_Double *__Preconditioner);
+SparseIterativeStatus_t _SparseLSMRSolve_Float(const SparseLSMROptions *__options, DenseMatrix_Float __X, DenseMatrix_Float __B, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float), const SparseOpaquePreconditioner_Float *__Preconditioner);
+void _SparseCGIterate_Double(const SparseCGOptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Double __X, DenseMatrix_Double __B, DenseMatrix_Double __R, const SparseOpaquePreconditioner_Double *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double));
+void _SparseCGIterate_Float(const SparseCGOptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Float __X, DenseMatrix_Float __B, DenseMatrix_Float __R, const SparseOpaquePreconditioner_Float *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float));
+void _SparseGMRESIterate_Double(const SparseGMRESOptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Double __X, DenseMatrix_Double __B, DenseMatrix_Double __R, const SparseOpaquePreconditioner_Double *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double));
+void _SparseGMRESIterate_Float(const SparseGMRESOptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Float __X, DenseMatrix_Float __B, DenseMatrix_Float __R, const SparseOpaquePreconditioner_Float *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float));
+void _SparseLSMRIterate_Double(const SparseLSMROptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Double __X, DenseMatrix_Double __B, DenseMatrix_Double __R, const SparseOpaquePreconditioner_Double *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Double, DenseMatrix_Double));
+void _SparseLSMRIterate_Float(const SparseLSMROptions *__options, int __iteration, char *__state, const bool *__converged, DenseMatrix_Float __X, DenseMatrix_Float __B, DenseMatrix_Float __R, const SparseOpaquePreconditioner_Float *__Preconditioner, void (^__ApplyOperator)(bool, enum CBLAS_TRANSPOSE, DenseMatrix_Float, DenseMatrix_Float));
+#endif
+SparseOpaquePreconditioner_Double _SparseCreatePreconditioner_Double(SparsePreconditioner_t __type, const SparseMatrix_Double *__A);
+SparseOpaquePreconditioner_Float _SparseCreatePreconditioner_Float(SparsePreconditioner_t __type, const SparseMatrix_Float *__A);
+void _SparseReleaseOpaquePreconditioner_Double(SparseOpaquePreconditioner_Double *__Opaque);
+void _SparseReleaseOpaquePreconditioner_Float(SparseOpaquePreconditioner_Float *__Opaque);
+
+// The overloaded interface needs clang, with blocks
+#if defined(__clang__) && defined(__BLOCKS__)
+#include <Sparse/Solve.h>
+#endif
 
 #endif
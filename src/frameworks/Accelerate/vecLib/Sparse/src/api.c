@@ -0,0 +1,99 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// The overloaded interface of Solve.h, over the _Sparse functions of the other files. Sparse
+// matrices become iterative operators through _SparseSpMV, so that the solvers get the
+// threaded products, and blocks are called through a pointer to them.
+
+static SparseIterativeMethod iterative_method(int method)
+{
+	SparseIterativeMethod result;
+
+	memset(&result, 0, sizeof(result));
+	result.method = method;
+	return result;
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseConjugateGradient(void)
+{
+	return iterative_method(_SparseMethodCG);
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseConjugateGradient(SparseCGOptions options)
+{
+	SparseIterativeMethod result = iterative_method(_SparseMethodCG);
+	result.options.cg = options;
+	return result;
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseGMRES(void)
+{
+	return iterative_method(_SparseMethodGMRES);
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseGMRES(SparseGMRESOptions options)
+{
+	SparseIterativeMethod result = iterative_method(_SparseMethodGMRES);
+	result.options.gmres = options;
+	return result;
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseLSMR(void)
+{
+	return iterative_method(_SparseMethodLSMR);
+}
+
+SparseIterativeMethod SPARSE_PUBLIC_INTERFACE SparseLSMR(SparseLSMROptions options)
+{
+	SparseIterativeMethod result = iterative_method(_SparseMethodLSMR);
+	result.options.lsmr = options;
+	return result;
+}
+
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrixStructure Matrix)
+{
+	if (sparse_is_symmetric_type(type))
+		return _SparseSymbolicFactorSymmetric(type, &Matrix, NULL);
+	return _SparseSymbolicFactorQR(type, &Matrix, NULL);
+}
+
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SparseMatrixStructure Matrix, SparseSymbolicFactorOptions sfoptions)
+{
+	if (sparse_is_symmetric_type(type))
+		return _SparseSymbolicFactorSymmetric(type, &Matrix, &sfoptions);
+	return _SparseSymbolicFactorQR(type, &Matrix, &sfoptions);
+}
+
+SparseOpaqueSymbolicFactorization SPARSE_PUBLIC_INTERFACE SparseRetain(SparseOpaqueSymbolicFactorization SymbolicFactor)
+{
+	_SparseRetainSymbolic(&SymbolicFactor);
+	return SymbolicFactor;
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SparseOpaqueSymbolicFactorization Opaque)
+{
+	_SparseDestroyOpaqueSymbolic(&Opaque);
+}
+
+#define SPARSE_TEMPLATE "api_template.h"
+#include "sparse_instantiate.h"
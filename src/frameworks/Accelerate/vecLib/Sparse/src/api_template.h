@@ -0,0 +1,498 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Included by api.c through sparse_instantiate.h
+
+static DENSE_MATRIX PFX(vector_matrix)(DENSE_VECTOR v)
+{
+	DENSE_MATRIX result;
+
+	memset(&result, 0, sizeof(result));
+	result.rowCount = v.count;
+	result.columnCount = 1;
+	result.columnStride = v.count;
+	result.data = v.data;
+	return result;
+}
+
+// Matrices
+
+SPARSE_MATRIX SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const REAL *val)
+{
+	return F(_SparseConvertFromCoordinate)(m, n, nBlock, blockSize, attributes, row, col, val, NULL, NULL);
+}
+
+SPARSE_MATRIX SPARSE_PUBLIC_INTERFACE SparseConvertFromCoordinate(int m, int n, long nBlock, uint8_t blockSize, SparseAttributes_t attributes, const int *row, const int *col, const REAL *val, void *storage, void *workspace)
+{
+	return F(_SparseConvertFromCoordinate)(m, n, nBlock, blockSize, attributes, row, col, val, storage, workspace);
+}
+
+SPARSE_MATRIX SPARSE_PUBLIC_INTERFACE SparseConvertFromOpaque(SB(sparse_matrix) matrix)
+{
+	return F(_SparseConvertFromOpaque)(matrix);
+}
+
+SPARSE_MATRIX SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SPARSE_MATRIX Matrix)
+{
+	Matrix.structure.attributes.transpose = !Matrix.structure.attributes.transpose;
+	return Matrix;
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseGetTranspose(FACTORIZATION Factor)
+{
+	Factor.attributes.transpose = !Factor.attributes.transpose;
+	return Factor;
+}
+
+SUBFACTOR SPARSE_PUBLIC_INTERFACE SparseGetTranspose(SUBFACTOR Subfactor)
+{
+	Subfactor.attributes.transpose = !Subfactor.attributes.transpose;
+	return Subfactor;
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SPARSE_MATRIX A, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	F(_SparseSpMV)(1, A, X, false, Y);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SPARSE_MATRIX A, DENSE_VECTOR x, DENSE_VECTOR y)
+{
+	F(_SparseSpMV)(1, A, PFX(vector_matrix)(x), false, PFX(vector_matrix)(y));
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(REAL alpha, SPARSE_MATRIX A, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	F(_SparseSpMV)(alpha, A, X, false, Y);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(REAL alpha, SPARSE_MATRIX A, DENSE_VECTOR x, DENSE_VECTOR y)
+{
+	F(_SparseSpMV)(alpha, A, PFX(vector_matrix)(x), false, PFX(vector_matrix)(y));
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SPARSE_MATRIX A, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	F(_SparseSpMV)(1, A, X, true, Y);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(SPARSE_MATRIX A, DENSE_VECTOR x, DENSE_VECTOR y)
+{
+	F(_SparseSpMV)(1, A, PFX(vector_matrix)(x), true, PFX(vector_matrix)(y));
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(REAL alpha, SPARSE_MATRIX A, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	F(_SparseSpMV)(alpha, A, X, true, Y);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiplyAdd(REAL alpha, SPARSE_MATRIX A, DENSE_VECTOR x, DENSE_VECTOR y)
+{
+	F(_SparseSpMV)(alpha, A, PFX(vector_matrix)(x), true, PFX(vector_matrix)(y));
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SPARSE_MATRIX Matrix)
+{
+	// the column starts begin the single block _SparseConvertFromCoordinate() allocates
+	if (Matrix.structure.attributes._allocatedBySparse)
+		free(Matrix.structure.columnStarts);
+}
+
+// Direct methods
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SPARSE_MATRIX Matrix)
+{
+	if (sparse_is_symmetric_type(type))
+		return F(_SparseFactorSymmetric)(type, &Matrix, NULL, NULL);
+	return F(_SparseFactorQR)(type, &Matrix, NULL, NULL);
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseFactor(SparseFactorization_t type, SPARSE_MATRIX Matrix, SparseSymbolicFactorOptions sfoptions, SparseNumericFactorOptions nfoptions)
+{
+	if (sparse_is_symmetric_type(type))
+		return F(_SparseFactorSymmetric)(type, &Matrix, &sfoptions, &nfoptions);
+	return F(_SparseFactorQR)(type, &Matrix, &sfoptions, &nfoptions);
+}
+
+static FACTORIZATION PFX(numeric_factor)(SparseOpaqueSymbolicFactorization* symbolic, const SPARSE_MATRIX* Matrix, const SparseNumericFactorOptions* options, void* factorStorage, void* workspace)
+{
+	if (sparse_is_symmetric_type(symbolic->type))
+		return F(_SparseNumericFactorSymmetric)(symbolic, Matrix, options, factorStorage, workspace);
+	return F(_SparseNumericFactorQR)(symbolic, Matrix, options, factorStorage, workspace);
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SPARSE_MATRIX Matrix)
+{
+	return PFX(numeric_factor)(&SymbolicFactor, &Matrix, NULL, NULL, NULL);
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SPARSE_MATRIX Matrix, SparseNumericFactorOptions nfoptions)
+{
+	return PFX(numeric_factor)(&SymbolicFactor, &Matrix, &nfoptions, NULL, NULL);
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseFactor(SparseOpaqueSymbolicFactorization SymbolicFactor, SPARSE_MATRIX Matrix, SparseNumericFactorOptions nfoptions, void *factorStorage, void *workspace)
+{
+	return PFX(numeric_factor)(&SymbolicFactor, &Matrix, &nfoptions, factorStorage, workspace);
+}
+
+static void PFX(refactor)(const SPARSE_MATRIX* Matrix, FACTORIZATION* Factorization, const SparseNumericFactorOptions* options, void* workspace)
+{
+	if (sparse_is_symmetric_type(Factorization->symbolicFactorization.type))
+		F(_SparseRefactorSymmetric)(Matrix, Factorization, options, workspace);
+	else
+		F(_SparseRefactorQR)(Matrix, Factorization, options, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SPARSE_MATRIX Matrix, FACTORIZATION *Factorization)
+{
+	PFX(refactor)(&Matrix, Factorization, NULL, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SPARSE_MATRIX Matrix, FACTORIZATION *Factorization, SparseNumericFactorOptions nfoptions)
+{
+	PFX(refactor)(&Matrix, Factorization, &nfoptions, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SPARSE_MATRIX Matrix, FACTORIZATION *Factorization, void *workspace)
+{
+	PFX(refactor)(&Matrix, Factorization, NULL, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseRefactor(SPARSE_MATRIX Matrix, FACTORIZATION *Factorization, SparseNumericFactorOptions nfoptions, void *workspace)
+{
+	PFX(refactor)(&Matrix, Factorization, &nfoptions, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_MATRIX XB)
+{
+	F(_SparseSolveOpaque)(&Factored, &XB, &XB, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_MATRIX XB, void *workspace)
+{
+	F(_SparseSolveOpaque)(&Factored, &XB, &XB, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_MATRIX B, DENSE_MATRIX X)
+{
+	F(_SparseSolveOpaque)(&Factored, &B, &X, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_MATRIX B, DENSE_MATRIX X, void *workspace)
+{
+	F(_SparseSolveOpaque)(&Factored, &B, &X, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_VECTOR xb)
+{
+	DENSE_MATRIX XB = PFX(vector_matrix)(xb);
+	F(_SparseSolveOpaque)(&Factored, &XB, &XB, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_VECTOR xb, void *workspace)
+{
+	DENSE_MATRIX XB = PFX(vector_matrix)(xb);
+	F(_SparseSolveOpaque)(&Factored, &XB, &XB, workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_VECTOR b, DENSE_VECTOR x)
+{
+	DENSE_MATRIX B = PFX(vector_matrix)(b), X = PFX(vector_matrix)(x);
+	F(_SparseSolveOpaque)(&Factored, &B, &X, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(FACTORIZATION Factored, DENSE_VECTOR b, DENSE_VECTOR x, void *workspace)
+{
+	DENSE_MATRIX B = PFX(vector_matrix)(b), X = PFX(vector_matrix)(x);
+	F(_SparseSolveOpaque)(&Factored, &B, &X, workspace);
+}
+
+FACTORIZATION SPARSE_PUBLIC_INTERFACE SparseRetain(FACTORIZATION NumericFactor)
+{
+	F(_SparseRetainNumeric)(&NumericFactor);
+	return NumericFactor;
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(FACTORIZATION Opaque)
+{
+	F(_SparseDestroyOpaqueNumeric)(&Opaque);
+}
+
+// Subfactors
+
+SUBFACTOR SPARSE_PUBLIC_INTERFACE SparseCreateSubfactor(SparseSubfactor_t subfactor, FACTORIZATION Factor)
+{
+	SUBFACTOR result;
+
+	memset(&result, 0, sizeof(result));
+	result.contents = subfactor;
+	result.factor = Factor;
+	F(_SparseGetWorkspaceRequired)(subfactor, Factor, &result.workspaceRequiredStatic, &result.workspaceRequiredPerRHS);
+	F(_SparseRetainNumeric)(&result.factor);
+	return result;
+}
+
+SUBFACTOR SPARSE_PUBLIC_INTERFACE SparseRetain(SUBFACTOR Subfactor)
+{
+	F(_SparseRetainNumeric)(&Subfactor.factor);
+	return Subfactor;
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(SUBFACTOR Opaque)
+{
+	F(_SparseDestroyOpaqueNumeric)(&Opaque.factor);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_MATRIX XY)
+{
+	F(_SparseMultiplySubfactor)(&Subfactor, &XY, &XY, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_MATRIX XY, void *workspace)
+{
+	F(_SparseMultiplySubfactor)(&Subfactor, &XY, &XY, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	F(_SparseMultiplySubfactor)(&Subfactor, &X, &Y, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_MATRIX X, DENSE_MATRIX Y, void *workspace)
+{
+	F(_SparseMultiplySubfactor)(&Subfactor, &X, &Y, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_VECTOR xy)
+{
+	DENSE_MATRIX XY = PFX(vector_matrix)(xy);
+	F(_SparseMultiplySubfactor)(&Subfactor, &XY, &XY, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_VECTOR xy, void *workspace)
+{
+	DENSE_MATRIX XY = PFX(vector_matrix)(xy);
+	F(_SparseMultiplySubfactor)(&Subfactor, &XY, &XY, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_VECTOR x, DENSE_VECTOR y)
+{
+	DENSE_MATRIX X = PFX(vector_matrix)(x), Y = PFX(vector_matrix)(y);
+	F(_SparseMultiplySubfactor)(&Subfactor, &X, &Y, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseMultiply(SUBFACTOR Subfactor, DENSE_VECTOR x, DENSE_VECTOR y, void *workspace)
+{
+	DENSE_MATRIX X = PFX(vector_matrix)(x), Y = PFX(vector_matrix)(y);
+	F(_SparseMultiplySubfactor)(&Subfactor, &X, &Y, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_MATRIX XB)
+{
+	F(_SparseSolveSubfactor)(&Subfactor, &XB, &XB, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_MATRIX XB, void *workspace)
+{
+	F(_SparseSolveSubfactor)(&Subfactor, &XB, &XB, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_MATRIX B, DENSE_MATRIX X)
+{
+	F(_SparseSolveSubfactor)(&Subfactor, &B, &X, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_MATRIX B, DENSE_MATRIX X, void *workspace)
+{
+	F(_SparseSolveSubfactor)(&Subfactor, &B, &X, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_VECTOR xb)
+{
+	DENSE_MATRIX XB = PFX(vector_matrix)(xb);
+	F(_SparseSolveSubfactor)(&Subfactor, &XB, &XB, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_VECTOR xb, void *workspace)
+{
+	DENSE_MATRIX XB = PFX(vector_matrix)(xb);
+	F(_SparseSolveSubfactor)(&Subfactor, &XB, &XB, (char*) workspace);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_VECTOR b, DENSE_VECTOR x)
+{
+	DENSE_MATRIX B = PFX(vector_matrix)(b), X = PFX(vector_matrix)(x);
+	F(_SparseSolveSubfactor)(&Subfactor, &B, &X, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseSolve(SUBFACTOR Subfactor, DENSE_VECTOR b, DENSE_VECTOR x, void *workspace)
+{
+	DENSE_MATRIX B = PFX(vector_matrix)(b), X = PFX(vector_matrix)(x);
+	F(_SparseSolveSubfactor)(&Subfactor, &B, &X, (char*) workspace);
+}
+
+// Iterative methods
+
+static SparseIterativeStatus_t PFX(iterative_solve)(const SparseIterativeMethod* method, DENSE_MATRIX X, DENSE_MATRIX B, OPERATOR ApplyOperator, const PRECONDITIONER* P)
+{
+	switch (method->method)
+	{
+		case _SparseMethodCG:
+			return F(_SparseCGSolve)(&method->options.cg, X, B, ApplyOperator, P);
+		case _SparseMethodGMRES:
+			return F(_SparseGMRESSolve)(&method->options.gmres, X, B, ApplyOperator, P);
+		case _SparseMethodLSMR:
+			return F(_SparseLSMRSolve)(&method->options.lsmr, X, B, ApplyOperator, P);
+		default:
+			sparse_error(NULL, "unknown iterative method %d", method->method);
+			return SparseIterativeParameterError;
+	}
+}
+
+// A sparse matrix as the operator, its transpose flips the attributes
+static SparseIterativeStatus_t PFX(operator_solve)(const SparseIterativeMethod* method, SPARSE_MATRIX A, DENSE_MATRIX X, DENSE_MATRIX B, const PRECONDITIONER* P)
+{
+	OPERATOR op = ^(bool accumulate, enum CBLAS_TRANSPOSE trans, DENSE_MATRIX x, DENSE_MATRIX y) {
+		SPARSE_MATRIX M = A;
+
+		if (trans != CblasNoTrans)
+			M.structure.attributes.transpose = !M.structure.attributes.transpose;
+		F(_SparseSpMV)(1, M, x, accumulate, y);
+	};
+	return PFX(iterative_solve)(method, X, B, op, P);
+}
+
+// Solves with a preconditioner of the given type for A, built for this solve only
+static SparseIterativeStatus_t PFX(matrix_solve)(const SparseIterativeMethod* method, const SPARSE_MATRIX* A, DENSE_MATRIX B, DENSE_MATRIX X, SparsePreconditioner_t type)
+{
+	if (type == SparsePreconditionerNone)
+		return PFX(operator_solve)(method, *A, X, B, NULL);
+
+	PRECONDITIONER P = F(_SparseCreatePreconditioner)(type, A);
+	if (P.type == SparsePreconditionerNone)
+		return SparseIterativeParameterError;
+
+	const SparseIterativeStatus_t status = PFX(operator_solve)(method, *A, X, B, &P);
+	F(_SparseReleaseOpaquePreconditioner)(&P);
+	return status;
+}
+
+// The vectors as single column matrices
+static SparseIterativeStatus_t PFX(vector_solve)(const SparseIterativeMethod* method, VECTOR_OPERATOR ApplyOperator, DENSE_VECTOR b, DENSE_VECTOR x, const PRECONDITIONER* P)
+{
+	OPERATOR op = ^(bool accumulate, enum CBLAS_TRANSPOSE trans, DENSE_MATRIX X, DENSE_MATRIX Y) {
+		DENSE_VECTOR xv = { X.rowCount, X.data }, yv = { Y.rowCount, Y.data };
+		ApplyOperator(accumulate, trans, xv, yv);
+	};
+	return PFX(iterative_solve)(method, PFX(vector_matrix)(x), PFX(vector_matrix)(b), op, P);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_MATRIX B, DENSE_MATRIX X)
+{
+	return PFX(matrix_solve)(&method, &A, B, X, SparsePreconditionerNone);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_MATRIX B, DENSE_MATRIX X, SparsePreconditioner_t Preconditioner)
+{
+	return PFX(matrix_solve)(&method, &A, B, X, Preconditioner);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_MATRIX B, DENSE_MATRIX X, PRECONDITIONER Preconditioner)
+{
+	return PFX(operator_solve)(&method, A, X, B, &Preconditioner);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_VECTOR b, DENSE_VECTOR x)
+{
+	return PFX(matrix_solve)(&method, &A, PFX(vector_matrix)(b), PFX(vector_matrix)(x), SparsePreconditionerNone);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_VECTOR b, DENSE_VECTOR x, SparsePreconditioner_t Preconditioner)
+{
+	return PFX(matrix_solve)(&method, &A, PFX(vector_matrix)(b), PFX(vector_matrix)(x), Preconditioner);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, SPARSE_MATRIX A, DENSE_VECTOR b, DENSE_VECTOR x, PRECONDITIONER Preconditioner)
+{
+	return PFX(operator_solve)(&method, A, PFX(vector_matrix)(x), PFX(vector_matrix)(b), &Preconditioner);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, OPERATOR ApplyOperator, DENSE_MATRIX B, DENSE_MATRIX X)
+{
+	return PFX(iterative_solve)(&method, X, B, ApplyOperator, NULL);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, OPERATOR ApplyOperator, DENSE_MATRIX B, DENSE_MATRIX X, PRECONDITIONER Preconditioner)
+{
+	return PFX(iterative_solve)(&method, X, B, ApplyOperator, &Preconditioner);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, VECTOR_OPERATOR ApplyOperator, DENSE_VECTOR b, DENSE_VECTOR x)
+{
+	return PFX(vector_solve)(&method, ApplyOperator, b, x, NULL);
+}
+
+SparseIterativeStatus_t SPARSE_PUBLIC_INTERFACE SparseSolve(SparseIterativeMethod method, VECTOR_OPERATOR ApplyOperator, DENSE_VECTOR b, DENSE_VECTOR x, PRECONDITIONER Preconditioner)
+{
+	return PFX(vector_solve)(&method, ApplyOperator, b, x, &Preconditioner);
+}
+
+static void PFX(iterate)(const SparseIterativeMethod* method, int iteration, const bool* converged, void* state, OPERATOR ApplyOperator, DENSE_MATRIX B, DENSE_MATRIX R, DENSE_MATRIX X, const PRECONDITIONER* P)
+{
+	switch (method->method)
+	{
+		case _SparseMethodCG:
+			F(_SparseCGIterate)(&method->options.cg, iteration, (char*) state, converged, X, B, R, P, ApplyOperator);
+			break;
+		case _SparseMethodGMRES:
+			F(_SparseGMRESIterate)(&method->options.gmres, iteration, (char*) state, converged, X, B, R, P, ApplyOperator);
+			break;
+		case _SparseMethodLSMR:
+			F(_SparseLSMRIterate)(&method->options.lsmr, iteration, (char*) state, converged, X, B, R, P, ApplyOperator);
+			break;
+		default:
+			sparse_error(NULL, "unknown iterative method %d", method->method);
+			break;
+	}
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, OPERATOR ApplyOperator, DENSE_MATRIX B, DENSE_MATRIX R, DENSE_MATRIX X)
+{
+	PFX(iterate)(&method, iteration, converged, state, ApplyOperator, B, R, X, NULL);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseIterate(SparseIterativeMethod method, int iteration, const bool *converged, void *state, OPERATOR ApplyOperator, DENSE_MATRIX B, DENSE_MATRIX R, DENSE_MATRIX X, PRECONDITIONER Preconditioner)
+{
+	PFX(iterate)(&method, iteration, converged, state, ApplyOperator, B, R, X, &Preconditioner);
+}
+
+size_t SPARSE_PUBLIC_INTERFACE F(SparseGetStateSize)(SparseIterativeMethod method, bool preconditioner, int m, int n, int nrhs)
+{
+	return F(_SparseGetIterativeStateSize)(&method, preconditioner, m, n, nrhs);
+}
+
+PRECONDITIONER SPARSE_PUBLIC_INTERFACE SparseCreatePreconditioner(SparsePreconditioner_t type, SPARSE_MATRIX A)
+{
+	return F(_SparseCreatePreconditioner)(type, &A);
+}
+
+void SPARSE_PUBLIC_INTERFACE SparseCleanup(PRECONDITIONER Opaque)
+{
+	F(_SparseReleaseOpaquePreconditioner)(&Opaque);
+}
@@ -0,0 +1,612 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Left-looking supernodal factorization: each supernode's panel is assembled from the
+// matrix, updated by the supernodes below it with one GEMM each, scattered through a map
+// from row index to panel row, and then factored, by xPOTRF and xTRSM for Cholesky.
+
+struct PFX(factor_job)
+{
+	const struct sparse_symbolic* S;
+	struct sparse_numeric* N;
+	const REAL* data;
+	char* workspace;
+	size_t task_size;
+	bool ldlt;
+	// LDL^T pivots at most zero_tolerance in magnitude are replaced by +-perturbation
+	REAL zero_tolerance;
+	REAL perturbation;
+	REAL pivot_threshold;
+	atomic_int status;
+	atomic_int perturbed;
+};
+
+struct PFX(task_space)
+{
+	int* map;
+	int* order;
+	REAL* update;
+	REAL* scaled;
+	REAL* accumulator;
+};
+
+static struct PFX(task_space) PFX(task_space)(const struct PFX(factor_job)* job, size_t task)
+{
+	const struct sparse_symbolic* S = job->S;
+	struct sparse_layout layout = { job->workspace + task * job->task_size, 0 };
+	struct PFX(task_space) space;
+
+	space.map = (int*) sparse_layout_take(&layout, (size_t) S->n * sizeof(int));
+	space.order = (int*) sparse_layout_take(&layout, (size_t) S->max_columns * sizeof(int));
+	space.update = (REAL*) sparse_layout_take(&layout, S->max_update * sizeof(REAL));
+	space.scaled = (REAL*) sparse_layout_take(&layout, S->max_update * sizeof(REAL));
+	space.accumulator = (S->type == SparseFactorizationCholeskyAtA) ? (REAL*) sparse_layout_take(&layout, (size_t) S->n * sizeof(REAL)) : NULL;
+	return space;
+}
+
+static void PFX(swap_columns)(REAL* P, int r, int from, int a, int b)
+{
+	for (int i = from; i < r; i++)
+	{
+		const REAL t = P[i + a * r];
+		P[i + a * r] = P[i + b * r];
+		P[i + b * r] = t;
+	}
+}
+
+// Bunch-Kaufman LDL^T of the c x c diagonal block of an r x c panel, whose columns are
+// symmetrically swapped only among themselves. The rows below become L21 = A21 L11^-T D^-1.
+static SparseStatus_t PFX(ldlt_block)(struct PFX(factor_job)* job, int f, REAL* P, int r, int c, int* order)
+{
+	struct sparse_numeric* N = job->N;
+	REAL* diagonal = (REAL*) N->diagonal;
+	REAL* subdiagonal = (REAL*) N->subdiagonal;
+	const bool pivoting = job->S->type != SparseFactorizationLDLTUnpivoted;
+	const REAL alpha = (job->S->type == SparseFactorizationLDLTTPP) ? job->pivot_threshold : (REAL) ((1 + SQRT(17)) / 8);
+	SparseStatus_t status = SparseStatusOK;
+
+	// the diagonal block in full, for the swaps
+	for (int j = 0; j < c; j++)
+	{
+		order[j] = j;
+		for (int i = 0; i < j; i++)
+			P[i + j * r] = P[j + i * r];
+	}
+
+	for (int k = 0; k < c;)
+	{
+		const REAL absakk = ABS(P[k + k * r]);
+		REAL colmax = 0;
+		int imax = k, size = 1, kp = k;
+
+		for (int i = k + 1; i < c; i++)
+		{
+			if (ABS(P[i + k * r]) > colmax)
+			{
+				colmax = ABS(P[i + k * r]);
+				imax = i;
+			}
+		}
+
+		if (pivoting && colmax > 0 && absakk < alpha * colmax)
+		{
+			REAL rowmax = 0;
+			for (int j = k; j < c; j++)
+			{
+				if (j != imax && ABS(P[imax + j * r]) > rowmax)
+					rowmax = ABS(P[imax + j * r]);
+			}
+
+			if (absakk * rowmax >= alpha * colmax * colmax)
+				kp = k;
+			else if (ABS(P[imax + imax * r]) >= alpha * rowmax)
+				kp = imax;
+			else
+			{
+				kp = imax;
+				size = 2;
+			}
+		}
+
+		const int kk = k + size - 1;
+		if (kp != kk)
+		{
+			// rows of the diagonal block, then whole columns
+			for (int j = 0; j < c; j++)
+			{
+				const REAL t = P[kp + j * r];
+				P[kp + j * r] = P[kk + j * r];
+				P[kk + j * r] = t;
+			}
+			PFX(swap_columns)(P, r, 0, kp, kk);
+
+			const int t = order[kp];
+			order[kp] = order[kk];
+			order[kk] = t;
+		}
+
+		if (size == 1)
+		{
+			REAL d = P[k + k * r];
+
+			if (ABS(d) <= job->zero_tolerance)
+			{
+				bool empty = true;
+				for (int i = k + 1; empty && i < r; i++)
+					empty = P[i + k * r] == 0;
+
+				if (empty && d == 0)
+					status = SparseMatrixIsSingular;
+				d = (d < 0) ? -job->perturbation : job->perturbation;
+				atomic_fetch_add_explicit(&job->perturbed, 1, memory_order_relaxed);
+			}
+
+			P[k + k * r] = d;
+			diagonal[f + k] = d;
+			subdiagonal[f + k] = 0;
+
+			for (int j = k + 1; j < c; j++)
+			{
+				const REAL l = P[j + k * r] / d;
+				REAL* col = P + j * r;
+				const REAL* pk = P + k * r;
+
+				for (int i = k + 1; i < r; i++)
+					col[i] -= pk[i] * l;
+			}
+			for (int i = k + 1; i < r; i++)
+				P[i + k * r] /= d;
+		}
+		else
+		{
+			const REAL a = P[k + k * r], b = P[k + 1 + k * r], e = P[k + 1 + (k + 1) * r];
+			const REAL det = a * e - b * b;
+			REAL* p0 = P + k * r;
+			REAL* p1 = P + (k + 1) * r;
+
+			for (int j = k + 2; j < c; j++)
+			{
+				const REAL l0 = (p0[j] * e - p1[j] * b) / det;
+				const REAL l1 = (p1[j] * a - p0[j] * b) / det;
+				REAL* col = P + j * r;
+
+				for (int i = k + 2; i < r; i++)
+					col[i] -= p0[i] * l0 + p1[i] * l1;
+			}
+			for (int i = k + 2; i < r; i++)
+			{
+				const REAL x = p0[i], y = p1[i];
+				p0[i] = (x * e - y * b) / det;
+				p1[i] = (y * a - x * b) / det;
+			}
+
+			p0[k + 1] = 0;
+			diagonal[f + k] = a;
+			diagonal[f + k + 1] = e;
+			subdiagonal[f + k] = b;
+			subdiagonal[f + k + 1] = 0;
+		}
+
+		k += size;
+	}
+
+	for (int k = 0; k < c; k++)
+		N->pivots[f + k] = f + order[k];
+	return status;
+}
+
+static void PFX(factor_supernode)(struct PFX(factor_job)* job, const struct PFX(task_space)* space, int J)
+{
+	const struct sparse_symbolic* S = job->S;
+	struct sparse_numeric* N = job->N;
+	REAL* values = (REAL*) N->values;
+	const REAL* lower = (const REAL*) N->lower_values;
+	const REAL* diagonal = (const REAL*) N->diagonal;
+	const REAL* subdiagonal = (const REAL*) N->subdiagonal;
+	const int f = S->super_first[J], c = S->super_first[J + 1] - f, l = f + c - 1;
+	const int* rows = S->super_rows + S->super_row_starts[J];
+	const int r = (int) (S->super_row_starts[J + 1] - S->super_row_starts[J]);
+	REAL* P = values + S->super_value_starts[J];
+	int* map = space->map;
+
+	for (int k = 0; k < r; k++)
+		map[rows[k]] = k;
+
+	memset(P, 0, (size_t) r * (size_t) c * sizeof(REAL));
+	for (int j = f; j <= l; j++)
+	{
+		REAL* col = P + (size_t) (j - f) * r;
+		for (long e = S->lower_starts[j]; e < S->lower_starts[j + 1]; e++)
+			col[map[S->lower_rows[e]]] += lower[e];
+	}
+
+	for (long u = S->update_starts[J]; u < S->update_starts[J + 1]; u++)
+	{
+		const int K = S->updates[u];
+		const int fK = S->super_first[K], cK = S->super_first[K + 1] - fK;
+		const int* rowsK = S->super_rows + S->super_row_starts[K];
+		const int rK = (int) (S->super_row_starts[K + 1] - S->super_row_starts[K]);
+		const REAL* PK = values + S->super_value_starts[K];
+		int p1, p2, lo = cK, hi = rK;
+
+		// K's rows in J's columns are [p1, p2)
+		while (lo < hi)
+		{
+			const int mid = lo + (hi - lo) / 2;
+			if (rowsK[mid] < f)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		p1 = lo;
+		for (p2 = p1; p2 < rK && rowsK[p2] <= l; p2++)
+			;
+
+		const int nr = rK - p1, nc = p2 - p1;
+		REAL* W = space->update;
+
+		if (job->ldlt)
+		{
+			// the rows of K in J's columns times K's D
+			REAL* T = space->scaled;
+			for (int q = 0; q < cK; q++)
+			{
+				const REAL* lq = PK + p1 + (size_t) q * rK;
+
+				if (subdiagonal[fK + q] != 0)
+				{
+					const REAL* lq1 = lq + rK;
+					const REAL d1 = diagonal[fK + q], e = subdiagonal[fK + q], d2 = diagonal[fK + q + 1];
+
+					for (int i = 0; i < nc; i++)
+					{
+						T[i + q * nc] = lq[i] * d1 + lq1[i] * e;
+						T[i + (q + 1) * nc] = lq[i] * e + lq1[i] * d2;
+					}
+					q++;
+				}
+				else
+				{
+					for (int i = 0; i < nc; i++)
+						T[i + q * nc] = lq[i] * diagonal[fK + q];
+				}
+			}
+			BLAS(gemm)(CblasColMajor, CblasNoTrans, CblasTrans, nr, nc, cK, 1, PK + p1, rK, T, nc, 0, W, nr);
+		}
+		else
+			BLAS(gemm)(CblasColMajor, CblasNoTrans, CblasTrans, nr, nc, cK, 1, PK + p1, rK, PK + p1, rK, 0, W, nr);
+
+		for (int jj = 0; jj < nc; jj++)
+		{
+			REAL* col = P + (size_t) (rowsK[p1 + jj] - f) * r;
+			const REAL* w = W + (size_t) jj * nr;
+
+			for (int ii = jj; ii < nr; ii++)
+				col[map[rowsK[p1 + ii]]] -= w[ii];
+		}
+	}
+
+	if (job->ldlt)
+	{
+		const SparseStatus_t status = PFX(ldlt_block)(job, f, P, r, c, space->order);
+		if (status != SparseStatusOK)
+			atomic_store(&job->status, status);
+	}
+	else
+	{
+		int n = c, lda = r, info = 0;
+		char uplo = 'L';
+
+		LAPACK(potrf)(&uplo, &n, P, &lda, &info);
+		if (info != 0)
+		{
+			atomic_store(&job->status, SparseFactorizationFailed);
+			return;
+		}
+		if (r > c)
+			BLAS(trsm)(CblasColMajor, CblasRight, CblasLower, CblasTrans, CblasNonUnit, r - c, c, 1, P, r, P + c, r);
+	}
+}
+
+static void PFX(factor_task)(void* ctx, size_t task)
+{
+	struct PFX(factor_job)* job = (struct PFX(factor_job)*) ctx;
+	const struct sparse_symbolic* S = job->S;
+	const struct PFX(task_space) space = PFX(task_space)(job, task);
+
+	for (int i = S->task_starts[task]; i < S->task_starts[task + 1]; i++)
+	{
+		for (int J = S->task_first[i]; J <= S->task_last[i]; J++)
+		{
+			if (atomic_load_explicit(&job->status, memory_order_relaxed) == SparseFactorizationFailed)
+				return;
+			PFX(factor_supernode)(job, &space, J);
+		}
+	}
+}
+
+// The lower triangle of P^T A^T A P, columns split across tasks
+static void PFX(ata_task)(void* ctx, size_t task)
+{
+	struct PFX(factor_job)* job = (struct PFX(factor_job)*) ctx;
+	const struct sparse_symbolic* S = job->S;
+	const struct sparse_points* A = &S->matrix;
+	const REAL* values = (const REAL*) job->N->matrix_values;
+	REAL* lower = (REAL*) job->N->lower_values;
+	REAL* acc = PFX(task_space)(job, task).accumulator;
+	const size_t tasks = S->tasks ? (size_t) S->tasks : 1;
+	const int first = (int) ((size_t) S->n * task / tasks), last = (int) ((size_t) S->n * (task + 1) / tasks);
+
+	for (int k = first; k < last; k++)
+	{
+		const int j = S->perm[k];
+
+		for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+		{
+			const int row = A->indices[p];
+			const REAL v = values[p];
+
+			for (long q = S->row_starts[row]; q < S->row_starts[row + 1]; q++)
+				acc[S->row_columns[q]] += values[S->row_entries[q]] * v;
+		}
+
+		for (long e = S->lower_starts[k]; e < S->lower_starts[k + 1]; e++)
+			lower[e] = acc[S->perm[S->lower_rows[e]]];
+
+		for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+		{
+			const int row = A->indices[p];
+			for (long q = S->row_starts[row]; q < S->row_starts[row + 1]; q++)
+				acc[S->row_columns[q]] = 0;
+		}
+	}
+}
+
+SparseStatus_t PFX(factor_supernodal)(const struct sparse_symbolic* S, struct sparse_numeric* N, const REAL* data, char* workspace)
+{
+	const size_t nnz = (size_t) S->lower_starts[S->n];
+	const size_t tasks = S->tasks ? (size_t) S->tasks : 1;
+	REAL* lower = (REAL*) N->lower_values;
+	struct PFX(factor_job) job = {
+		.S = S,
+		.N = N,
+		.data = data,
+		.workspace = workspace,
+		.task_size = S->workspace_size[IS_DOUBLE] / tasks,
+		.ldlt = sparse_is_ldlt(S->type),
+	};
+
+	atomic_init(&job.status, SparseStatusOK);
+	atomic_init(&job.perturbed, 0);
+
+	if (S->type == SparseFactorizationCholeskyAtA)
+	{
+		REAL* values = (REAL*) N->matrix_values;
+		for (long p = 0; p < S->matrix.starts[S->matrix.columns]; p++)
+			values[p] = (S->matrix.source[p] < 0) ? 1 : data[S->matrix.source[p]];
+
+		for (size_t t = 0; t < tasks; t++)
+			memset(PFX(task_space)(&job, t).accumulator, 0, (size_t) S->n * sizeof(REAL));
+		sparse_parallel_for(tasks, &job, PFX(ata_task));
+	}
+	else
+	{
+		for (size_t e = 0; e < nnz; e++)
+			lower[e] = data[S->lower_source[e]];
+	}
+
+	if (job.ldlt)
+	{
+		REAL largest = 0;
+		for (size_t e = 0; e < nnz; e++)
+		{
+			if (ABS(lower[e]) > largest)
+				largest = ABS(lower[e]);
+		}
+		if (largest == 0)
+			largest = 1;
+
+		job.zero_tolerance = (N->options.zeroTolerance > 0) ? (REAL) N->options.zeroTolerance : EPSILON * largest;
+		job.perturbation = SQRT(EPSILON) * largest;
+		job.pivot_threshold = (N->options.pivotTolerance > 0) ? (REAL) N->options.pivotTolerance : (REAL) 0.01;
+	}
+
+	sparse_parallel_for((size_t) S->tasks, &job, PFX(factor_task));
+
+	const struct PFX(task_space) space = PFX(task_space)(&job, 0);
+	for (int i = 0; i < S->top_count; i++)
+	{
+		if (atomic_load(&job.status) == SparseFactorizationFailed)
+			break;
+		PFX(factor_supernode)(&job, &space, S->top[i]);
+	}
+
+	N->perturbed = atomic_load(&job.perturbed);
+	return (SparseStatus_t) atomic_load(&job.status);
+}
+
+// Row k of the panel's first c rows for the permuted order
+static void PFX(pivot_rows)(const int* pivots, int f, int c, bool inverse, REAL* X, int nrhs, int ld, REAL* work)
+{
+	for (int k = 0; k < nrhs; k++)
+	{
+		REAL* x = X + (size_t) k * ld;
+
+		for (int i = 0; i < c; i++)
+			work[i] = inverse ? x[f + i] : x[pivots[f + i]];
+		for (int i = 0; i < c; i++)
+		{
+			if (inverse)
+				x[pivots[f + i]] = work[i];
+			else
+				x[f + i] = work[i];
+		}
+	}
+}
+
+static void PFX(gather)(const int* rows, int count, const REAL* X, int nrhs, int ld, REAL* work)
+{
+	for (int k = 0; k < nrhs; k++)
+	{
+		const REAL* x = X + (size_t) k * ld;
+		for (int i = 0; i < count; i++)
+			work[i + (size_t) k * count] = x[rows[i]];
+	}
+}
+
+static void PFX(scatter_add)(const int* rows, int count, REAL alpha, const REAL* work, REAL* X, int nrhs, int ld)
+{
+	for (int k = 0; k < nrhs; k++)
+	{
+		REAL* x = X + (size_t) k * ld;
+		for (int i = 0; i < count; i++)
+			x[rows[i]] += alpha * work[i + (size_t) k * count];
+	}
+}
+
+void PFX(supernodal_sweep)(const struct sparse_symbolic* S, const struct sparse_numeric* N, enum sparse_sweep sweep, REAL* X, int nrhs, int ld, REAL* work)
+{
+	const REAL* values = (const REAL*) N->values;
+	const enum CBLAS_DIAG diag = sparse_is_ldlt(S->type) ? CblasUnit : CblasNonUnit;
+	const bool forward = sweep == sparse_solve_lower || sweep == sparse_multiply_upper;
+	const int ns = S->supernodes;
+
+	for (int s = 0; s < ns; s++)
+	{
+		const int J = forward ? s : ns - 1 - s;
+		const int f = S->super_first[J], c = S->super_first[J + 1] - f;
+		const int* rows = S->super_rows + S->super_row_starts[J];
+		const int r = (int) (S->super_row_starts[J + 1] - S->super_row_starts[J]);
+		const REAL* P = values + S->super_value_starts[J];
+		REAL* XJ = X + f;
+
+		switch (sweep)
+		{
+			case sparse_solve_lower:
+				if (N->pivots)
+					PFX(pivot_rows)(N->pivots, f, c, false, X, nrhs, ld, work);
+				BLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, diag, c, nrhs, 1, P, r, XJ, ld);
+				if (r > c)
+				{
+					BLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, r - c, nrhs, c, 1, P + c, r, XJ, ld, 0, work, r - c);
+					PFX(scatter_add)(rows + c, r - c, -1, work, X, nrhs, ld);
+				}
+				break;
+
+			case sparse_solve_upper:
+				if (r > c)
+				{
+					PFX(gather)(rows + c, r - c, X, nrhs, ld, work);
+					BLAS(gemm)(CblasColMajor, CblasTrans, CblasNoTrans, c, nrhs, r - c, -1, P + c, r, work, r - c, 1, XJ, ld);
+				}
+				BLAS(trsm)(CblasColMajor, CblasLeft, CblasLower, CblasTrans, diag, c, nrhs, 1, P, r, XJ, ld);
+				if (N->pivots)
+					PFX(pivot_rows)(N->pivots, f, c, true, X, nrhs, ld, work);
+				break;
+
+			case sparse_multiply_lower:
+				if (r > c)
+				{
+					BLAS(gemm)(CblasColMajor, CblasNoTrans, CblasNoTrans, r - c, nrhs, c, 1, P + c, r, XJ, ld, 0, work, r - c);
+					PFX(scatter_add)(rows + c, r - c, 1, work, X, nrhs, ld);
+				}
+				BLAS(trmm)(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, diag, c, nrhs, 1, P, r, XJ, ld);
+				if (N->pivots)
+					PFX(pivot_rows)(N->pivots, f, c, true, X, nrhs, ld, work);
+				break;
+
+			case sparse_multiply_upper:
+				if (N->pivots)
+					PFX(pivot_rows)(N->pivots, f, c, false, X, nrhs, ld, work);
+				BLAS(trmm)(CblasColMajor, CblasLeft, CblasLower, CblasTrans, diag, c, nrhs, 1, P, r, XJ, ld);
+				if (r > c)
+				{
+					PFX(gather)(rows + c, r - c, X, nrhs, ld, work);
+					BLAS(gemm)(CblasColMajor, CblasTrans, CblasNoTrans, c, nrhs, r - c, 1, P + c, r, work, r - c, 1, XJ, ld);
+				}
+				break;
+		}
+	}
+}
+
+void PFX(supernodal_diagonal)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool solve, REAL* X, int nrhs, int ld)
+{
+	const REAL* diagonal = (const REAL*) N->diagonal;
+	const REAL* subdiagonal = (const REAL*) N->subdiagonal;
+
+	if (!diagonal)
+		return;
+
+	for (int k = 0; k < nrhs; k++)
+	{
+		REAL* x = X + (size_t) k * ld;
+
+		for (int i = 0; i < S->n; i++)
+		{
+			if (subdiagonal[i] != 0)
+			{
+				const REAL a = diagonal[i], b = subdiagonal[i], e = diagonal[i + 1];
+				const REAL x0 = x[i], x1 = x[i + 1];
+
+				if (solve)
+				{
+					const REAL det = a * e - b * b;
+					x[i] = (x0 * e - x1 * b) / det;
+					x[i + 1] = (x1 * a - x0 * b) / det;
+				}
+				else
+				{
+					x[i] = a * x0 + b * x1;
+					x[i + 1] = b * x0 + e * x1;
+				}
+				i++;
+			}
+			else if (solve)
+				x[i] /= diagonal[i];
+			else
+				x[i] *= diagonal[i];
+		}
+	}
+}
+
+void PFX(supernodal_residual)(const struct sparse_symbolic* S, const struct sparse_numeric* N, const REAL* B, const REAL* X, REAL* Y, int nrhs, int ld)
+{
+	const REAL* lower = (const REAL*) N->lower_values;
+
+	for (int k = 0; k < nrhs; k++)
+	{
+		const REAL* b = B + (size_t) k * ld;
+		const REAL* x = X + (size_t) k * ld;
+		REAL* y = Y + (size_t) k * ld;
+
+		memcpy(y, b, (size_t) S->n * sizeof(REAL));
+		for (int j = 0; j < S->n; j++)
+		{
+			REAL sum = 0;
+			for (long e = S->lower_starts[j]; e < S->lower_starts[j + 1]; e++)
+			{
+				const int i = S->lower_rows[e];
+				y[i] -= lower[e] * x[j];
+				if (i != j)
+					sum += lower[e] * x[i];
+			}
+			y[j] -= sum;
+		}
+	}
+}
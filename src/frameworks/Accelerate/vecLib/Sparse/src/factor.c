@@ -0,0 +1,80 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <string.h>
+
+// The matrix a factorization applies to, when RHS and solution of a solve have different sizes
+static void factored_shape(const struct sparse_symbolic* S, bool transpose, int* rows, int* columns)
+{
+	// QR of a wide matrix factors its transpose
+	const bool flip = S->transposed != transpose;
+
+	*rows = flip ? S->n : S->m;
+	*columns = flip ? S->m : S->n;
+}
+
+// The shape of op(subfactor)
+static void subfactor_shape(const struct sparse_symbolic* S, SparseSubfactor_t sub, bool transpose, int* rows, int* columns)
+{
+	*rows = *columns = S->n;
+	if (sub == SparseSubfactorQ)
+	{
+		*rows = transpose ? S->n : S->m;
+		*columns = transpose ? S->m : S->n;
+	}
+}
+
+static bool subfactor_valid(const struct sparse_symbolic* S, SparseSubfactor_t sub)
+{
+	switch (sub)
+	{
+		case SparseSubfactorP:
+		case SparseSubfactorS:
+			return true;
+		case SparseSubfactorL:
+		case SparseSubfactorPLPS:
+			return sparse_is_symmetric_type(S->type);
+		case SparseSubfactorD:
+			return sparse_is_ldlt(S->type);
+		case SparseSubfactorQ:
+			return S->type == SparseFactorizationQR;
+		case SparseSubfactorR:
+		case SparseSubfactorRP:
+			return S->type == SparseFactorizationQR || S->type == SparseFactorizationCholeskyAtA;
+		default:
+			return false;
+	}
+}
+
+// Values of workspace per right-hand side a solve (SparseSubfactorInvalid) or a subfactor needs
+static size_t workspace_values(const struct sparse_symbolic* S, SparseSubfactor_t sub)
+{
+	const size_t n = (size_t) S->n, rows = (size_t) S->max_rows;
+
+	// the factored matrix is m x n with m >= n
+	if (S->type == SparseFactorizationQR)
+		return (size_t) S->m2 + (size_t) S->m;
+	if (sub != SparseSubfactorInvalid || S->type == SparseFactorizationCholeskyAtA)
+		return 2 * n + rows;
+	return 3 * n + rows;
+}
+
+#define SPARSE_TEMPLATE "factor_template.h"
+#include "sparse_instantiate.h"
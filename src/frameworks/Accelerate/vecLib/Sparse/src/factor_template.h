@@ -0,0 +1,649 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+static FACTORIZATION PFX(numeric_result)(const SparseOpaqueSymbolicFactorization* symbolic, const SPARSE_MATRIX* A, struct sparse_numeric* N, bool user_storage, SparseStatus_t status)
+{
+	FACTORIZATION result = { 0 };
+
+	result.status = status;
+	if (A)
+		result.attributes = A->structure.attributes;
+	result.attributes.transpose = false;
+	result.attributes._allocatedBySparse = false;
+	if (symbolic)
+		result.symbolicFactorization = *symbolic;
+	result.userFactorStorage = user_storage;
+	result.numericFactorization = N;
+
+	if (N)
+	{
+		result.solveWorkspaceRequiredStatic = 0;
+		result.solveWorkspaceRequiredPerRHS = workspace_values(N->symbolic, SparseSubfactorInvalid) * sizeof(REAL);
+	}
+	return result;
+}
+
+static bool PFX(matrix_matches)(const struct sparse_symbolic* S, const SparseOpaqueSymbolicFactorization* symbolic, const SPARSE_MATRIX* A)
+{
+	const SparseMatrixStructure* structure = &A->structure;
+
+	if (structure->rowCount != symbolic->rowCount || structure->columnCount != symbolic->columnCount
+		|| structure->blockSize != symbolic->blockSize
+		|| structure->columnStarts[structure->columnCount] * structure->blockSize * structure->blockSize != S->values)
+	{
+		sparse_error(S->options.reportError, "the matrix doesn't have the structure of the symbolic factorization");
+		return false;
+	}
+	return true;
+}
+
+static SparseStatus_t PFX(factor_values)(const struct sparse_symbolic* S, struct sparse_numeric* N, const REAL* data, void* workspace)
+{
+	char* memory = (char*) workspace;
+	SparseStatus_t status;
+
+	if (!memory)
+	{
+		memory = (char*) S->options.malloc(S->workspace_size[IS_DOUBLE] ? S->workspace_size[IS_DOUBLE] : 1);
+		if (!memory)
+			return SparseInternalError;
+	}
+
+	N->perturbed = 0;
+	if (S->type == SparseFactorizationQR)
+		status = PFX(factor_qr)(S, N, data, memory);
+	else
+		status = PFX(factor_supernodal)(S, N, data, memory);
+
+	if (memory != workspace)
+		S->options.free(memory);
+	return status;
+}
+
+static FACTORIZATION PFX(numeric_factor)(SparseOpaqueSymbolicFactorization* symbolic, const SPARSE_MATRIX* A, const SparseNumericFactorOptions* options, void* storage, void* workspace, bool qr)
+{
+	struct sparse_symbolic* S = (struct sparse_symbolic*) symbolic->factorization;
+
+	if (symbolic->status != SparseStatusOK || !S)
+	{
+		sparse_error(S ? S->options.reportError : NULL, "the symbolic factorization isn't valid");
+		return PFX(numeric_result)(symbolic, A, NULL, false, SparseParameterError);
+	}
+	if (qr == sparse_is_symmetric_type(S->type))
+	{
+		sparse_error(S->options.reportError, "factorization type %d doesn't match the function", S->type);
+		return PFX(numeric_result)(symbolic, A, NULL, false, SparseParameterError);
+	}
+	if (!PFX(matrix_matches)(S, symbolic, A))
+		return PFX(numeric_result)(symbolic, A, NULL, false, SparseParameterError);
+
+	char* base = (char*) storage;
+	if (!base)
+	{
+		base = (char*) S->options.malloc(S->factor_size[IS_DOUBLE]);
+		if (!base)
+			return PFX(numeric_result)(symbolic, A, NULL, false, SparseInternalError);
+	}
+
+	sparse_numeric_layout(S, IS_DOUBLE, base);
+	struct sparse_numeric* N = (struct sparse_numeric*) base;
+
+	atomic_init(&N->refs, 1);
+	atomic_fetch_add(&S->refs, 1);
+	N->symbolic = S;
+	N->is_double = IS_DOUBLE;
+	N->user_storage = storage != NULL;
+	if (options)
+		N->options = *options;
+
+	const SparseStatus_t status = PFX(factor_values)(S, N, A->data, workspace);
+	return PFX(numeric_result)(symbolic, A, N, storage != NULL, status);
+}
+
+static FACTORIZATION PFX(factor)(SparseOpaqueSymbolicFactorization symbolic, const SPARSE_MATRIX* A, const SparseNumericFactorOptions* nfoptions, bool qr)
+{
+	if (symbolic.status != SparseStatusOK)
+		return PFX(numeric_result)(&symbolic, A, NULL, false, symbolic.status);
+
+	// the numeric factorization keeps its own reference to the symbolic one
+	FACTORIZATION result = PFX(numeric_factor)(&symbolic, A, nfoptions, NULL, NULL, qr);
+	_SparseDestroyOpaqueSymbolic(&symbolic);
+	return result;
+}
+
+FACTORIZATION F(_SparseFactorSymmetric)(SparseFactorization_t __type, const SPARSE_MATRIX *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions)
+{
+	return PFX(factor)(_SparseSymbolicFactorSymmetric(__type, &__Matrix->structure, __sfoptions), __Matrix, __nfoptions, false);
+}
+
+FACTORIZATION F(_SparseFactorQR)(SparseFactorization_t __type, const SPARSE_MATRIX *__Matrix, const SparseSymbolicFactorOptions *__sfoptions, const SparseNumericFactorOptions *__nfoptions)
+{
+	return PFX(factor)(_SparseSymbolicFactorQR(__type, &__Matrix->structure, __sfoptions), __Matrix, __nfoptions, true);
+}
+
+FACTORIZATION F(_SparseNumericFactorSymmetric)(SparseOpaqueSymbolicFactorization *__symbolic, const SPARSE_MATRIX *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace)
+{
+	return PFX(numeric_factor)(__symbolic, __Matrix, __options, __factorStorage, __workspace, false);
+}
+
+FACTORIZATION F(_SparseNumericFactorQR)(SparseOpaqueSymbolicFactorization *__symbolic, const SPARSE_MATRIX *__Matrix, const SparseNumericFactorOptions *__options, void *__factorStorage, void *__workspace)
+{
+	return PFX(numeric_factor)(__symbolic, __Matrix, __options, __factorStorage, __workspace, true);
+}
+
+static void PFX(refactor)(const SPARSE_MATRIX* A, FACTORIZATION* factored, const SparseNumericFactorOptions* options, void* workspace, bool qr)
+{
+	struct sparse_numeric* N = (struct sparse_numeric*) factored->numericFactorization;
+
+	if (!N)
+	{
+		sparse_error(NULL, "the factorization has been released");
+		factored->status = SparseParameterError;
+		return;
+	}
+
+	const struct sparse_symbolic* S = N->symbolic;
+	if (qr == sparse_is_symmetric_type(S->type))
+	{
+		sparse_error(S->options.reportError, "factorization type %d doesn't match the function", S->type);
+		factored->status = SparseParameterError;
+		return;
+	}
+	if (!PFX(matrix_matches)(S, &factored->symbolicFactorization, A))
+	{
+		factored->status = SparseParameterError;
+		return;
+	}
+
+	if (options)
+		N->options = *options;
+	factored->status = PFX(factor_values)(S, N, A->data, workspace);
+}
+
+void F(_SparseRefactorSymmetric)(const SPARSE_MATRIX *__Matrix, FACTORIZATION *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace)
+{
+	PFX(refactor)(__Matrix, __Factored, __nfoptions, __workspace, false);
+}
+
+void F(_SparseRefactorQR)(const SPARSE_MATRIX *__Matrix, FACTORIZATION *__Factored, const SparseNumericFactorOptions *__nfoptions, void *__workspace)
+{
+	PFX(refactor)(__Matrix, __Factored, __nfoptions, __workspace, true);
+}
+
+void F(_SparseRetainNumeric)(FACTORIZATION *__numeric)
+{
+	struct sparse_numeric* N = (struct sparse_numeric*) __numeric->numericFactorization;
+
+	if (N)
+		atomic_fetch_add(&N->refs, 1);
+}
+
+void F(_SparseDestroyOpaqueNumeric)(FACTORIZATION *__numeric)
+{
+	struct sparse_numeric* N = (struct sparse_numeric*) __numeric->numericFactorization;
+
+	__numeric->numericFactorization = NULL;
+	__numeric->status = SparseStatusReleased;
+	if (!N || atomic_fetch_sub(&N->refs, 1) != 1)
+		return;
+
+	struct sparse_symbolic* S = N->symbolic;
+	if (!N->user_storage)
+		S->options.free(N);
+	sparse_symbolic_release(S);
+}
+
+SparseNumericFactorOptions F(_SparseGetOptionsFromNumericFactor)(FACTORIZATION *__factor)
+{
+	const struct sparse_numeric* N = (const struct sparse_numeric*) __factor->numericFactorization;
+	SparseNumericFactorOptions options = { 0 };
+
+	if (N)
+		options = N->options;
+	return options;
+}
+
+void F(_SparseGetWorkspaceRequired)(SparseSubfactor_t __Sub, FACTORIZATION __Factor, size_t *__workStatic, size_t *__workPerRHS)
+{
+	const struct sparse_numeric* N = (const struct sparse_numeric*) __Factor.numericFactorization;
+
+	*__workStatic = 0;
+	*__workPerRHS = N ? workspace_values(N->symbolic, __Sub) * sizeof(REAL) : 0;
+}
+
+// P^T X and P X of the fill-reducing ordering
+static void PFX(permute)(const struct sparse_symbolic* S, bool transpose, const REAL* X, int ldx, REAL* Y, int ldy, int nrhs)
+{
+	for (int c = 0; c < nrhs; c++)
+	{
+		const REAL* x = X + (size_t) c * ldx;
+		REAL* y = Y + (size_t) c * ldy;
+
+		for (int k = 0; k < S->n; k++)
+		{
+			if (transpose)
+				y[k] = x[S->perm[k]];
+			else
+				y[S->perm[k]] = x[k];
+		}
+	}
+}
+
+// X = (L D L^T)^-1 X in the permuted order, refined against the assembled matrix if pivots
+// were perturbed
+static void PFX(solve_symmetric)(const struct sparse_symbolic* S, const struct sparse_numeric* N, REAL* X, int nrhs, REAL* work)
+{
+	const int n = S->n;
+	REAL* rhs = work;
+	REAL* correction = rhs + (size_t) n * nrhs;
+	REAL* sweep = correction + (size_t) n * nrhs;
+	const int steps = (N->perturbed > 0) ? 2 : 0;
+
+	if (steps)
+		memcpy(rhs, X, (size_t) n * nrhs * sizeof(REAL));
+
+	PFX(supernodal_sweep)(S, N, sparse_solve_lower, X, nrhs, n, sweep);
+	PFX(supernodal_diagonal)(S, N, true, X, nrhs, n);
+	PFX(supernodal_sweep)(S, N, sparse_solve_upper, X, nrhs, n, sweep);
+
+	for (int step = 0; step < steps; step++)
+	{
+		PFX(supernodal_residual)(S, N, rhs, X, correction, nrhs, n);
+		PFX(supernodal_sweep)(S, N, sparse_solve_lower, correction, nrhs, n, sweep);
+		PFX(supernodal_diagonal)(S, N, true, correction, nrhs, n);
+		PFX(supernodal_sweep)(S, N, sparse_solve_upper, correction, nrhs, n, sweep);
+		BLAS(axpy)(n * nrhs, 1, correction, 1, X, 1);
+	}
+}
+
+// Least squares solution of op(M) x = b for the factored matrix M P = Q R, or the minimum
+// norm one if op(M) is M^T. x has m2 entries.
+static void PFX(solve_qr)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, const REAL* b, REAL* y, REAL* x)
+{
+	memset(x, 0, (size_t) S->m2 * sizeof(REAL));
+
+	if (!transpose)
+	{
+		for (int i = 0; i < S->m; i++)
+			x[S->pinv[i]] = b[i];
+		PFX(qr_apply_q)(S, N, true, x);
+		PFX(qr_solve_r)(S, N, false, x);
+		for (int k = 0; k < S->n; k++)
+			y[S->perm[k]] = x[k];
+	}
+	else
+	{
+		for (int k = 0; k < S->n; k++)
+			x[k] = b[S->perm[k]];
+		PFX(qr_solve_r)(S, N, true, x);
+		PFX(qr_apply_q)(S, N, false, x);
+		for (int i = 0; i < S->m; i++)
+			y[i] = x[S->pinv[i]];
+	}
+}
+
+// Y = op(A) X for CholeskyAtA's copy of A, where A^T is symbolic->matrix's transpose
+static void PFX(ata_multiply)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, const REAL* X, int ldx, REAL* Y, int ldy, int nrhs)
+{
+	const struct sparse_points* A = &S->matrix;
+	const REAL* values = (const REAL*) N->matrix_values;
+
+	for (int c = 0; c < nrhs; c++)
+	{
+		const REAL* x = X + (size_t) c * ldx;
+		REAL* y = Y + (size_t) c * ldy;
+
+		if (transpose)
+		{
+			for (int j = 0; j < A->columns; j++)
+			{
+				REAL sum = 0;
+				for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+					sum += values[p] * x[A->indices[p]];
+				y[j] = sum;
+			}
+		}
+		else
+		{
+			memset(y, 0, (size_t) A->rows * sizeof(REAL));
+			for (int j = 0; j < A->columns; j++)
+			{
+				for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+					y[A->indices[p]] += values[p] * x[j];
+			}
+		}
+	}
+}
+
+static bool PFX(dense_valid)(const struct sparse_symbolic* S, const DENSE_MATRIX* X, int rows, int columns, const char* name)
+{
+	if (X->rowCount < rows || X->columnCount != columns || X->columnStride < X->rowCount || (!X->data && rows > 0 && columns > 0))
+	{
+		sparse_error(S->options.reportError, "%s should be a %d x %d matrix, it's %d x %d with stride %d", name, rows, columns, X->rowCount, X->columnCount, X->columnStride);
+		return false;
+	}
+	return true;
+}
+
+// The numeric factorization of an opaque one the client passed, NULL and an error if invalid
+static const struct sparse_numeric* PFX(numeric_of)(const FACTORIZATION* factored)
+{
+	const struct sparse_numeric* N = (const struct sparse_numeric*) factored->numericFactorization;
+
+	if (!N || factored->status != SparseStatusOK)
+	{
+		sparse_error(N ? N->symbolic->options.reportError : NULL, "the factorization isn't valid, its status is %d", factored->status);
+		return NULL;
+	}
+	return N;
+}
+
+void F(_SparseSolveOpaque)(const FACTORIZATION *__Factored, const DENSE_MATRIX *__RHS, const DENSE_MATRIX *__Soln, void *__workspace)
+{
+	const struct sparse_numeric* N = PFX(numeric_of)(__Factored);
+	if (!N)
+		return;
+
+	const struct sparse_symbolic* S = N->symbolic;
+	const bool transpose = __Factored->attributes.transpose;
+	const int nrhs = __RHS->columnCount;
+	int rows, columns;
+
+	factored_shape(S, transpose, &rows, &columns);
+	if (!PFX(dense_valid)(S, __RHS, rows, nrhs, "the right-hand side") || !PFX(dense_valid)(S, __Soln, columns, nrhs, "the solution"))
+		return;
+	if (nrhs == 0)
+		return;
+
+	REAL* work = (REAL*) __workspace;
+	if (!work)
+	{
+		work = (REAL*) S->options.malloc(workspace_values(S, SparseSubfactorInvalid) * nrhs * sizeof(REAL));
+		if (!work)
+		{
+			sparse_error(S->options.reportError, "out of memory");
+			return;
+		}
+	}
+
+	const REAL* B = __RHS->data;
+	REAL* X = __Soln->data;
+	const int ldb = __RHS->columnStride, ldx = __Soln->columnStride;
+
+	if (S->type == SparseFactorizationQR)
+	{
+		// column by column, so that RHS and solution can share memory
+		REAL* x = work;
+		REAL* y = work + S->m2;
+
+		for (int c = 0; c < nrhs; c++)
+		{
+			PFX(solve_qr)(S, N, S->transposed != transpose, B + (size_t) c * ldb, y, x);
+			memcpy(X + (size_t) c * ldx, y, (size_t) columns * sizeof(REAL));
+		}
+	}
+	else if (S->type == SparseFactorizationCholeskyAtA)
+	{
+		// (A^T A)^-1 A^T B, or A (A^T A)^-1 B for A^T
+		REAL* Xp = work;
+		REAL* T = Xp + (size_t) S->n * nrhs;
+		REAL* sweep = T + (size_t) S->n * nrhs;
+
+		if (!transpose)
+		{
+			PFX(ata_multiply)(S, N, true, B, ldb, T, S->n, nrhs);
+			PFX(permute)(S, true, T, S->n, Xp, S->n, nrhs);
+		}
+		else
+			PFX(permute)(S, true, B, ldb, Xp, S->n, nrhs);
+
+		PFX(supernodal_sweep)(S, N, sparse_solve_lower, Xp, nrhs, S->n, sweep);
+		PFX(supernodal_sweep)(S, N, sparse_solve_upper, Xp, nrhs, S->n, sweep);
+
+		if (!transpose)
+			PFX(permute)(S, false, Xp, S->n, X, ldx, nrhs);
+		else
+		{
+			PFX(permute)(S, false, Xp, S->n, T, S->n, nrhs);
+			PFX(ata_multiply)(S, N, false, T, S->n, X, ldx, nrhs);
+		}
+	}
+	else
+	{
+		REAL* Xp = work;
+
+		PFX(permute)(S, true, B, ldb, Xp, S->n, nrhs);
+		PFX(solve_symmetric)(S, N, Xp, nrhs, Xp + (size_t) S->n * nrhs);
+		PFX(permute)(S, false, Xp, S->n, X, ldx, nrhs);
+	}
+
+	if (work != __workspace)
+		S->options.free(work);
+}
+
+// X = op(subfactor) X, or op(subfactor)^-1 X, in place for the subfactors of a symmetric
+// factorization: T takes n * nrhs values and sweep max_rows * nrhs
+static void PFX(apply_symmetric)(const struct sparse_symbolic* S, const struct sparse_numeric* N, SparseSubfactor_t sub, bool transpose, bool solve, REAL* X, int nrhs, REAL* T, REAL* sweep)
+{
+	const int n = S->n;
+	const size_t size = (size_t) n * nrhs * sizeof(REAL);
+	enum sparse_sweep lower = solve ? sparse_solve_lower : sparse_multiply_lower;
+	enum sparse_sweep upper = solve ? sparse_solve_upper : sparse_multiply_upper;
+
+	switch (sub)
+	{
+		case SparseSubfactorP:
+			// P^-1 = P^T
+			PFX(permute)(S, transpose != solve, X, n, T, n, nrhs);
+			memcpy(X, T, size);
+			break;
+
+		case SparseSubfactorL:
+			PFX(supernodal_sweep)(S, N, transpose ? upper : lower, X, nrhs, n, sweep);
+			break;
+
+		case SparseSubfactorD:
+			PFX(supernodal_diagonal)(S, N, solve, X, nrhs, n);
+			break;
+
+		case SparseSubfactorPLPS:
+			// P L, P L^T is L^T P^T
+			if (transpose == solve)
+			{
+				PFX(supernodal_sweep)(S, N, transpose ? upper : lower, X, nrhs, n, sweep);
+				PFX(permute)(S, false, X, n, T, n, nrhs);
+				memcpy(X, T, size);
+			}
+			else
+			{
+				PFX(permute)(S, true, X, n, T, n, nrhs);
+				memcpy(X, T, size);
+				PFX(supernodal_sweep)(S, N, transpose ? upper : lower, X, nrhs, n, sweep);
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+// y = op(subfactor) x or op(subfactor)^-1 x for a QR factorization, x and y may be the same.
+// T takes m2 + n values.
+static void PFX(apply_qr)(const struct sparse_symbolic* S, const struct sparse_numeric* N, SparseSubfactor_t sub, bool transpose, bool solve, const REAL* x, REAL* y, REAL* T)
+{
+	REAL* z = T;
+	REAL* t = T + S->m2;
+	const int n = S->n;
+
+	switch (sub)
+	{
+		case SparseSubfactorP:
+			for (int k = 0; k < n; k++)
+			{
+				if (transpose != solve)
+					t[k] = x[S->perm[k]];
+				else
+					t[S->perm[k]] = x[k];
+			}
+			memcpy(y, t, (size_t) n * sizeof(REAL));
+			break;
+
+		case SparseSubfactorQ:
+			// Q^-1 is Q^T, in the least squares sense
+			memset(z, 0, (size_t) S->m2 * sizeof(REAL));
+			if (transpose != solve)
+			{
+				for (int i = 0; i < S->m; i++)
+					z[S->pinv[i]] = x[i];
+				PFX(qr_apply_q)(S, N, true, z);
+				memcpy(y, z, (size_t) n * sizeof(REAL));
+			}
+			else
+			{
+				memcpy(z, x, (size_t) n * sizeof(REAL));
+				PFX(qr_apply_q)(S, N, false, z);
+				for (int i = 0; i < S->m; i++)
+					y[i] = z[S->pinv[i]];
+			}
+			break;
+
+		case SparseSubfactorR:
+			memcpy(t, x, (size_t) n * sizeof(REAL));
+			if (solve)
+			{
+				PFX(qr_solve_r)(S, N, transpose, t);
+				memcpy(y, t, (size_t) n * sizeof(REAL));
+			}
+			else
+				PFX(qr_multiply_r)(S, N, transpose, t, y);
+			break;
+
+		case SparseSubfactorRP:
+			// R P^T, its transpose is P R^T
+			if (transpose == solve)
+			{
+				for (int k = 0; k < n; k++)
+					t[k] = x[S->perm[k]];
+				if (solve)
+					PFX(qr_solve_r)(S, N, true, t);
+				else
+				{
+					PFX(qr_multiply_r)(S, N, false, t, z);
+					memcpy(t, z, (size_t) n * sizeof(REAL));
+				}
+				memcpy(y, t, (size_t) n * sizeof(REAL));
+			}
+			else
+			{
+				memcpy(t, x, (size_t) n * sizeof(REAL));
+				if (solve)
+					PFX(qr_solve_r)(S, N, false, t);
+				else
+				{
+					PFX(qr_multiply_r)(S, N, true, t, z);
+					memcpy(t, z, (size_t) n * sizeof(REAL));
+				}
+				for (int k = 0; k < n; k++)
+					y[S->perm[k]] = t[k];
+			}
+			break;
+
+		default:
+			if (x != y)
+				memcpy(y, x, (size_t) n * sizeof(REAL));
+			break;
+	}
+}
+
+static void PFX(apply_subfactor)(const SUBFACTOR* sub, const DENSE_MATRIX* in, const DENSE_MATRIX* out, char* workspace, bool solve)
+{
+	const struct sparse_numeric* N = PFX(numeric_of)(&sub->factor);
+	if (!N)
+		return;
+
+	const struct sparse_symbolic* S = N->symbolic;
+	const bool transpose = sub->attributes.transpose;
+	SparseSubfactor_t contents = sub->contents;
+	int rows, columns;
+
+	if (!subfactor_valid(S, contents))
+	{
+		sparse_error(S->options.reportError, "subfactor %d isn't valid for factorization type %d", contents, S->type);
+		return;
+	}
+
+	subfactor_shape(S, contents, transpose, &rows, &columns);
+	if (!PFX(dense_valid)(S, in, solve ? rows : columns, in->columnCount, "the input") || !PFX(dense_valid)(S, out, solve ? columns : rows, in->columnCount, "the output"))
+		return;
+
+	const int nrhs = in->columnCount;
+	if (nrhs == 0)
+		return;
+
+	REAL* work = (REAL*) workspace;
+	if (!work)
+	{
+		work = (REAL*) S->options.malloc(workspace_values(S, contents) * nrhs * sizeof(REAL));
+		if (!work)
+		{
+			sparse_error(S->options.reportError, "out of memory");
+			return;
+		}
+	}
+
+	if (S->type == SparseFactorizationQR)
+	{
+		for (int c = 0; c < nrhs; c++)
+			PFX(apply_qr)(S, N, contents, transpose, solve, in->data + (size_t) c * in->columnStride, out->data + (size_t) c * out->columnStride, work);
+	}
+	else
+	{
+		const int n = S->n;
+		REAL* X = work;
+		REAL* T = X + (size_t) n * nrhs;
+		REAL* sweep = T + (size_t) n * nrhs;
+		bool flip = false;
+
+		// CholeskyAtA's R is L^T, and R P^T is (P L)^T
+		if (S->type == SparseFactorizationCholeskyAtA && contents != SparseSubfactorP && contents != SparseSubfactorS)
+		{
+			contents = (contents == SparseSubfactorR) ? SparseSubfactorL : SparseSubfactorPLPS;
+			flip = true;
+		}
+
+		for (int c = 0; c < nrhs; c++)
+			memcpy(X + (size_t) c * n, in->data + (size_t) c * in->columnStride, (size_t) n * sizeof(REAL));
+		PFX(apply_symmetric)(S, N, contents, transpose != flip, solve, X, nrhs, T, sweep);
+		for (int c = 0; c < nrhs; c++)
+			memcpy(out->data + (size_t) c * out->columnStride, X + (size_t) c * n, (size_t) n * sizeof(REAL));
+	}
+
+	if (work != (REAL*) workspace)
+		S->options.free(work);
+}
+
+void F(_SparseMultiplySubfactor)(const SUBFACTOR *__Subfactor, const DENSE_MATRIX *__x, const DENSE_MATRIX *__y, char *__workspace)
+{
+	PFX(apply_subfactor)(__Subfactor, __x, __y, __workspace, false);
+}
+
+void F(_SparseSolveSubfactor)(const SUBFACTOR *__Subfactor, const DENSE_MATRIX *__b, const DENSE_MATRIX *__x, char *__workspace)
+{
+	PFX(apply_subfactor)(__Subfactor, __b, __x, __workspace, true);
+}
@@ -0,0 +1,157 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "sparse_internal.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The Krylov methods work on all right-hand sides at once: their vectors are kept as
+// n x nrhs blocks, so that each iteration applies the operator (a threaded SpMM for the
+// public interface) and the preconditioner once for all the columns, and the columns
+// that have converged just aren't updated. GMRES is right-preconditioned, so that its
+// residual estimates are those of the original system, and LSMR applies a preconditioner
+// as a right scaling of A.
+//
+// The solvers stop on estimates of the residual that the recurrences give, then check
+// them against B - AX and carry on, restarting, if rounding made them too optimistic.
+
+// The column of a dense matrix
+#define ITERATIVE_COLUMN(M, c) ((M).data + (size_t) (c) * (M).columnStride)
+
+// The first part of every state
+struct iterative_header
+{
+	// the Arnoldi step of GMRES' current cycle, or the number of DQGMRES steps
+	int position;
+};
+
+// Why LSMR stopped on a column
+enum
+{
+	lsmr_running = 0,
+	lsmr_converged = 1,
+	lsmr_ill_conditioned = 2,
+};
+
+static SparseCGOptions cg_defaults(const SparseCGOptions* options, double epsilon)
+{
+	SparseCGOptions o = { 0 };
+
+	if (options)
+		o = *options;
+	if (o.maxIterations <= 0)
+		o.maxIterations = 100;
+	if (o.rtol <= 0)
+		o.rtol = sqrt(epsilon);
+	if (o.atol < 0)
+		o.atol = 0;
+	return o;
+}
+
+static SparseGMRESOptions gmres_defaults(const SparseGMRESOptions* options, double epsilon)
+{
+	SparseGMRESOptions o = { 0 };
+
+	if (options)
+		o = *options;
+	if (o.nvec <= 0)
+		o.nvec = 16;
+	if (o.maxIterations <= 0)
+		o.maxIterations = 100;
+	if (o.rtol <= 0)
+		o.rtol = sqrt(epsilon);
+	if (o.atol < 0)
+		o.atol = 0;
+	return o;
+}
+
+static SparseLSMROptions lsmr_defaults(const SparseLSMROptions* options, double epsilon, int n)
+{
+	SparseLSMROptions o = { 0 };
+
+	if (options)
+		o = *options;
+	if (o.nvec < 0)
+		o.nvec = 0;
+	if (o.maxIterations <= 0)
+		o.maxIterations = (n > INT_MAX / 4) ? INT_MAX : 4 * n;
+	if (o.rtol <= 0)
+		o.rtol = sqrt(epsilon);
+	if (o.btol <= 0)
+		o.btol = sqrt(epsilon);
+	if (o.conditionLimit <= 0)
+		o.conditionLimit = 1 / sqrt(epsilon);
+	if (o.atol < 0)
+		o.atol = 0;
+	return o;
+}
+
+static bool gmres_variant_valid(SparseGMRESVariant_t variant)
+{
+	return variant == SparseVariantDQGMRES || variant == SparseVariantGMRES || variant == SparseVariantFGMRES;
+}
+
+// Whether a residual norm meets max(atol, rtol |b|)
+static bool residual_converged(double norm, double norm_b, double atol, double rtol)
+{
+	return norm <= fmax(atol, rtol * norm_b);
+}
+
+// c, s and r with [c s; -s c] [a; b] = [r; 0] and r >= 0
+static void sym_ortho(double a, double b, double* c, double* s, double* r)
+{
+	if (b == 0)
+	{
+		*c = (a < 0) ? -1 : 1;
+		*s = 0;
+		*r = fabs(a);
+	}
+	else if (a == 0)
+	{
+		*c = 0;
+		*s = (b < 0) ? -1 : 1;
+		*r = fabs(b);
+	}
+	else
+	{
+		*r = hypot(a, b);
+		*c = a / *r;
+		*s = b / *r;
+	}
+}
+
+static void report_status(void (*report)(const char* message), const char* format, ...) __attribute__((format(printf, 2, 3)));
+static void report_status(void (*report)(const char* message), const char* format, ...)
+{
+	char message[256];
+	va_list ap;
+
+	if (!report)
+		return;
+
+	va_start(ap, format);
+	vsnprintf(message, sizeof(message), format, ap);
+	va_end(ap);
+	report(message);
+}
+
+#define SPARSE_TEMPLATE "iterative_template.h"
+#include "sparse_instantiate.h"
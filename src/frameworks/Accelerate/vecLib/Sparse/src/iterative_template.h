@@ -0,0 +1,1378 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// Included by iterative.c once for float and once for double, see sparse_instantiate.h
+
+struct PFX(iteration)
+{
+	OPERATOR apply;
+	// NULL without a preconditioner
+	const PRECONDITIONER* P;
+	// the operator is m x n, m = n except for LSMR
+	int m;
+	int n;
+	int nrhs;
+	DENSE_MATRIX X;
+	DENSE_MATRIX B;
+};
+
+static bool PFX(iteration_setup)(struct PFX(iteration)* it, void (*report)(const char* message), bool square, DENSE_MATRIX X, DENSE_MATRIX B, OPERATOR apply, const PRECONDITIONER* P)
+{
+	if (!apply)
+	{
+		sparse_error(report, "no operator to iterate with");
+		return false;
+	}
+	if (X.columnCount != B.columnCount || X.columnCount < 0 || X.rowCount < 0 || B.rowCount < 0
+		|| (square && X.rowCount != B.rowCount) || X.columnStride < X.rowCount || B.columnStride < B.rowCount)
+	{
+		sparse_error(report, "can't solve for X of %d x %d with B of %d x %d", X.rowCount, X.columnCount, B.rowCount, B.columnCount);
+		return false;
+	}
+	if (P && P->type != SparsePreconditionerNone && !P->apply)
+	{
+		sparse_error(report, "preconditioner of type %d without an apply function", P->type);
+		return false;
+	}
+
+	it->apply = apply;
+	it->P = (P && P->type != SparsePreconditionerNone) ? P : NULL;
+	it->m = B.rowCount;
+	it->n = X.rowCount;
+	it->nrhs = X.columnCount;
+	it->X = X;
+	it->B = B;
+	return true;
+}
+
+// A block of `rows` x nrhs values of the state
+static DENSE_MATRIX PFX(block)(const struct PFX(iteration)* it, REAL* data, int rows)
+{
+	DENSE_MATRIX M = { rows, it->nrhs, rows, { 0 }, data };
+	return M;
+}
+
+static void PFX(operate)(const struct PFX(iteration)* it, bool accumulate, enum CBLAS_TRANSPOSE trans, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	it->apply(accumulate, trans, X, Y);
+}
+
+// Y = P X, or a copy without a preconditioner
+static void PFX(precondition)(const struct PFX(iteration)* it, enum CBLAS_TRANSPOSE trans, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	if (it->P)
+	{
+		it->P->apply(it->P->mem, trans, X, Y);
+		return;
+	}
+
+	for (int c = 0; c < X.columnCount; c++)
+		memcpy(ITERATIVE_COLUMN(Y, c), ITERATIVE_COLUMN(X, c), (size_t) X.rowCount * sizeof(REAL));
+}
+
+// R = B - A X for the columns that aren't skipped, R holding A X for the others
+static void PFX(residual)(const struct PFX(iteration)* it, DENSE_MATRIX R)
+{
+	PFX(operate)(it, false, CblasNoTrans, it->X, R);
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		const REAL* b = ITERATIVE_COLUMN(it->B, c);
+		REAL* r = ITERATIVE_COLUMN(R, c);
+
+		for (int i = 0; i < it->m; i++)
+			r[i] = b[i] - r[i];
+	}
+}
+
+static bool PFX(skipped)(const bool* skip, int c)
+{
+	return skip && skip[c];
+}
+
+//
+// Conjugate gradients
+//
+
+struct PFX(cg_column)
+{
+	// r^T P r, and |r| from the recurrence
+	REAL rz;
+	REAL norm_r;
+	// p^T A p vanished
+	bool broken;
+};
+
+struct PFX(cg_state)
+{
+	struct PFX(cg_column)* columns;
+	REAL* r;
+	REAL* p;
+	REAL* q;
+	// the preconditioned residual, r itself without a preconditioner
+	REAL* z;
+};
+
+static size_t PFX(cg_layout)(char* base, bool preconditioned, int n, int nrhs, struct PFX(cg_state)* st)
+{
+	struct sparse_layout layout = { base, 0 };
+	const size_t block = (size_t) n * nrhs * sizeof(REAL);
+
+	sparse_layout_take(&layout, sizeof(struct iterative_header));
+	st->columns = (struct PFX(cg_column)*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(*st->columns));
+	st->r = (REAL*) sparse_layout_take(&layout, block);
+	st->p = (REAL*) sparse_layout_take(&layout, block);
+	st->q = (REAL*) sparse_layout_take(&layout, block);
+	st->z = preconditioned ? (REAL*) sparse_layout_take(&layout, block) : st->r;
+	return layout.size;
+}
+
+static void PFX(cg_init)(const struct PFX(iteration)* it, struct PFX(cg_state)* st)
+{
+	const int n = it->n;
+
+	PFX(residual)(it, PFX(block)(it, st->r, n));
+	if (it->P)
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, st->r, n), PFX(block)(it, st->z, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(cg_column)* col = &st->columns[c];
+		const REAL* r = st->r + (size_t) c * n;
+		const REAL* z = st->z + (size_t) c * n;
+
+		memcpy(st->p + (size_t) c * n, z, (size_t) n * sizeof(REAL));
+		col->rz = BLAS(dot)(n, r, 1, z, 1);
+		col->norm_r = BLAS(nrm2)(n, r, 1);
+		col->broken = false;
+	}
+}
+
+static void PFX(cg_step)(const struct PFX(iteration)* it, struct PFX(cg_state)* st, const bool* skip)
+{
+	const int n = it->n;
+
+	PFX(operate)(it, false, CblasNoTrans, PFX(block)(it, st->p, n), PFX(block)(it, st->q, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(cg_column)* col = &st->columns[c];
+		const REAL* p = st->p + (size_t) c * n;
+		const REAL* q = st->q + (size_t) c * n;
+
+		if (PFX(skipped)(skip, c) || col->broken)
+			continue;
+
+		const REAL pq = BLAS(dot)(n, p, 1, q, 1);
+		if (pq == 0 || !isfinite(pq))
+		{
+			col->broken = true;
+			continue;
+		}
+
+		const REAL alpha = col->rz / pq;
+		BLAS(axpy)(n, alpha, p, 1, ITERATIVE_COLUMN(it->X, c), 1);
+		BLAS(axpy)(n, -alpha, q, 1, st->r + (size_t) c * n, 1);
+	}
+
+	if (it->P)
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, st->r, n), PFX(block)(it, st->z, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(cg_column)* col = &st->columns[c];
+		const REAL* r = st->r + (size_t) c * n;
+		const REAL* z = st->z + (size_t) c * n;
+		REAL* p = st->p + (size_t) c * n;
+
+		if (PFX(skipped)(skip, c) || col->broken)
+			continue;
+
+		const REAL rz = BLAS(dot)(n, r, 1, z, 1);
+		const REAL beta = (col->rz != 0) ? rz / col->rz : 0;
+
+		BLAS(scal)(n, beta, p, 1);
+		BLAS(axpy)(n, 1, z, 1, p, 1);
+		col->rz = rz;
+		col->norm_r = BLAS(nrm2)(n, r, 1);
+	}
+}
+
+//
+// Restarted GMRES and FGMRES
+//
+
+struct PFX(gmres_column)
+{
+	// |r| at the restart, then the estimate of the Givens rotations
+	REAL norm_r;
+	// Arnoldi steps since the restart
+	int steps;
+};
+
+// Basis vector i of column c is at V + i * nrhs * n + c * n, so that vector i of all the
+// columns is an n x nrhs block that the operator is applied to at once
+struct PFX(gmres_state)
+{
+	struct iterative_header* header;
+	struct PFX(gmres_column)* columns;
+	REAL* V;
+	// FGMRES: the preconditioned basis vectors
+	REAL* Z;
+	// GMRES with a preconditioner: the preconditioned vector and the update of X
+	REAL* T;
+	REAL* U;
+	// per column, the (k + 1) x k Hessenberg matrix, reduced to triangular by the rotations
+	// c and s, and the right-hand side g of the reduced least squares problem
+	REAL* H;
+	REAL* cs;
+	REAL* sn;
+	REAL* g;
+	// k + 1 values of scratch
+	REAL* h;
+};
+
+static size_t PFX(gmres_layout)(char* base, const SparseGMRESOptions* o, bool preconditioned, int n, int nrhs, struct PFX(gmres_state)* st)
+{
+	struct sparse_layout layout = { base, 0 };
+	const size_t block = (size_t) n * nrhs * sizeof(REAL);
+	const size_t k = (size_t) o->nvec;
+
+	st->header = (struct iterative_header*) sparse_layout_take(&layout, sizeof(struct iterative_header));
+	st->columns = (struct PFX(gmres_column)*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(*st->columns));
+	st->V = (REAL*) sparse_layout_take(&layout, (k + 1) * block);
+	st->Z = st->T = st->U = NULL;
+	if (preconditioned && o->variant == SparseVariantFGMRES)
+		st->Z = (REAL*) sparse_layout_take(&layout, k * block);
+	else if (preconditioned)
+	{
+		st->T = (REAL*) sparse_layout_take(&layout, block);
+		st->U = (REAL*) sparse_layout_take(&layout, block);
+	}
+	st->H = (REAL*) sparse_layout_take(&layout, (k + 1) * k * nrhs * sizeof(REAL));
+	st->cs = (REAL*) sparse_layout_take(&layout, k * nrhs * sizeof(REAL));
+	st->sn = (REAL*) sparse_layout_take(&layout, k * nrhs * sizeof(REAL));
+	st->g = (REAL*) sparse_layout_take(&layout, (k + 1) * nrhs * sizeof(REAL));
+	st->h = (REAL*) sparse_layout_take(&layout, (k + 1) * sizeof(REAL));
+	return layout.size;
+}
+
+// Restarts all the columns from the residual of X
+static void PFX(gmres_init)(const struct PFX(iteration)* it, const SparseGMRESOptions* o, struct PFX(gmres_state)* st)
+{
+	const int n = it->n, k = o->nvec;
+
+	PFX(residual)(it, PFX(block)(it, st->V, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		REAL* v = st->V + (size_t) c * n;
+		const REAL beta = BLAS(nrm2)(n, v, 1);
+
+		if (beta > 0)
+			BLAS(scal)(n, 1 / beta, v, 1);
+		st->g[(size_t) c * (k + 1)] = beta;
+		st->columns[c].norm_r = beta;
+		st->columns[c].steps = 0;
+	}
+	st->header->position = 0;
+}
+
+// Adds the corrections of the current cycle to X
+static void PFX(gmres_update)(const struct PFX(iteration)* it, const SparseGMRESOptions* o, struct PFX(gmres_state)* st)
+{
+	const int n = it->n, k = o->nvec;
+	const int ldv = n * it->nrhs;
+	const bool flexible = st->Z != NULL;
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		const int steps = st->columns[c].steps;
+		const REAL* H = st->H + (size_t) c * (k + 1) * k;
+		REAL* y = st->g + (size_t) c * (k + 1);
+
+		if (steps == 0)
+		{
+			if (st->U)
+				memset(st->T + (size_t) c * n, 0, (size_t) n * sizeof(REAL));
+			continue;
+		}
+
+		// y = R^-1 g, with the components of a singular R left out
+		for (int i = steps - 1; i >= 0; i--)
+		{
+			REAL sum = y[i];
+			for (int l = i + 1; l < steps; l++)
+				sum -= H[i + (size_t) l * (k + 1)] * y[l];
+			y[i] = (H[i + (size_t) i * (k + 1)] != 0) ? sum / H[i + (size_t) i * (k + 1)] : 0;
+		}
+
+		if (flexible)
+			BLAS(gemv)(CblasColMajor, CblasNoTrans, n, steps, 1, st->Z + (size_t) c * n, ldv, y, 1, 1, ITERATIVE_COLUMN(it->X, c), 1);
+		else if (st->U)
+			BLAS(gemv)(CblasColMajor, CblasNoTrans, n, steps, 1, st->V + (size_t) c * n, ldv, y, 1, 0, st->T + (size_t) c * n, 1);
+		else
+			BLAS(gemv)(CblasColMajor, CblasNoTrans, n, steps, 1, st->V + (size_t) c * n, ldv, y, 1, 1, ITERATIVE_COLUMN(it->X, c), 1);
+	}
+
+	// X += P V y
+	if (st->U)
+	{
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, st->T, n), PFX(block)(it, st->U, n));
+		for (int c = 0; c < it->nrhs; c++)
+		{
+			if (st->columns[c].steps > 0)
+				BLAS(axpy)(n, 1, st->U + (size_t) c * n, 1, ITERATIVE_COLUMN(it->X, c), 1);
+		}
+	}
+
+	for (int c = 0; c < it->nrhs; c++)
+		st->columns[c].steps = 0;
+}
+
+static void PFX(gmres_step)(const struct PFX(iteration)* it, const SparseGMRESOptions* o, struct PFX(gmres_state)* st, const bool* skip)
+{
+	const int n = it->n, k = o->nvec;
+	const int ldv = n * it->nrhs;
+	const int j = st->header->position;
+	REAL* Vj = st->V + (size_t) j * ldv;
+	REAL* w = st->V + (size_t) (j + 1) * ldv;
+	REAL* z = Vj;
+
+	// w = A P v_j
+	if (it->P)
+	{
+		z = st->Z ? st->Z + (size_t) j * ldv : st->T;
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, Vj, n), PFX(block)(it, z, n));
+	}
+	PFX(operate)(it, false, CblasNoTrans, PFX(block)(it, z, n), PFX(block)(it, w, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(gmres_column)* col = &st->columns[c];
+		const REAL* V = st->V + (size_t) c * n;
+		REAL* wc = w + (size_t) c * n;
+		REAL* h = st->H + (size_t) c * (k + 1) * k + (size_t) j * (k + 1);
+		REAL* cs = st->cs + (size_t) c * k;
+		REAL* sn = st->sn + (size_t) c * k;
+		REAL* g = st->g + (size_t) c * (k + 1);
+
+		if (PFX(skipped)(skip, c))
+			continue;
+
+		// classical Gram-Schmidt, twice, to keep BLAS 2
+		BLAS(gemv)(CblasColMajor, CblasTrans, n, j + 1, 1, V, ldv, wc, 1, 0, h, 1);
+		BLAS(gemv)(CblasColMajor, CblasNoTrans, n, j + 1, -1, V, ldv, h, 1, 1, wc, 1);
+		BLAS(gemv)(CblasColMajor, CblasTrans, n, j + 1, 1, V, ldv, wc, 1, 0, st->h, 1);
+		BLAS(gemv)(CblasColMajor, CblasNoTrans, n, j + 1, -1, V, ldv, st->h, 1, 1, wc, 1);
+		BLAS(axpy)(j + 1, 1, st->h, 1, h, 1);
+
+		h[j + 1] = BLAS(nrm2)(n, wc, 1);
+		if (h[j + 1] > 0)
+			BLAS(scal)(n, 1 / h[j + 1], wc, 1);
+
+		for (int i = 0; i < j; i++)
+		{
+			const REAL a = h[i], b = h[i + 1];
+			h[i] = cs[i] * a + sn[i] * b;
+			h[i + 1] = -sn[i] * a + cs[i] * b;
+		}
+
+		double c_, s_, r_;
+		sym_ortho(h[j], h[j + 1], &c_, &s_, &r_);
+		cs[j] = (REAL) c_;
+		sn[j] = (REAL) s_;
+		h[j] = (REAL) r_;
+		h[j + 1] = 0;
+
+		g[j + 1] = -sn[j] * g[j];
+		g[j] = cs[j] * g[j];
+		col->norm_r = ABS(g[j + 1]);
+		col->steps = j + 1;
+	}
+
+	st->header->position = j + 1;
+	if (j + 1 == k)
+	{
+		PFX(gmres_update)(it, o, st);
+		PFX(gmres_init)(it, o, st);
+	}
+}
+
+// R = V (beta e_1 - H y), the residual of the current cycle's solution
+static void PFX(gmres_residual)(const struct PFX(iteration)* it, const SparseGMRESOptions* o, struct PFX(gmres_state)* st, const bool* skip, DENSE_MATRIX R)
+{
+	const int n = it->n, k = o->nvec;
+	const int ldv = n * it->nrhs;
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		const int steps = st->columns[c].steps;
+		const REAL* cs = st->cs + (size_t) c * k;
+		const REAL* sn = st->sn + (size_t) c * k;
+		REAL* t = st->h;
+
+		if (PFX(skipped)(skip, c))
+			continue;
+
+		// the rotations take beta e_1 - H y to (0, ..., 0, g[steps])
+		memset(t, 0, (size_t) steps * sizeof(REAL));
+		t[steps] = st->g[(size_t) c * (k + 1) + steps];
+		for (int i = steps - 1; i >= 0; i--)
+		{
+			const REAL a = t[i], b = t[i + 1];
+			t[i] = cs[i] * a - sn[i] * b;
+			t[i + 1] = sn[i] * a + cs[i] * b;
+		}
+
+		BLAS(gemv)(CblasColMajor, CblasNoTrans, n, steps + 1, 1, st->V + (size_t) c * n, ldv, t, 1, 0, ITERATIVE_COLUMN(R, c), 1);
+	}
+}
+
+//
+// DQGMRES, the direct quasi-GMRES of Saad and Wu: each vector is orthogonalized against
+// the last k only, and X is updated in every step through k + 1 direction vectors
+//
+
+struct PFX(dqgmres_column)
+{
+	REAL gamma;
+	// |gamma|, which estimates |r|
+	REAL norm_r;
+};
+
+// V and P hold the last k + 1 basis and direction vectors, vector i in slot i mod (k + 1)
+struct PFX(dqgmres_state)
+{
+	struct iterative_header* header;
+	struct PFX(dqgmres_column)* columns;
+	REAL* V;
+	REAL* P;
+	// per column, the last k + 1 rotations
+	REAL* cs;
+	REAL* sn;
+	// k + 2 values of scratch, column m of the Hessenberg matrix from row m - k
+	REAL* h;
+};
+
+static size_t PFX(dqgmres_layout)(char* base, const SparseGMRESOptions* o, int n, int nrhs, struct PFX(dqgmres_state)* st)
+{
+	struct sparse_layout layout = { base, 0 };
+	const size_t block = (size_t) n * nrhs * sizeof(REAL);
+	const size_t k = (size_t) o->nvec;
+
+	st->header = (struct iterative_header*) sparse_layout_take(&layout, sizeof(struct iterative_header));
+	st->columns = (struct PFX(dqgmres_column)*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(*st->columns));
+	st->V = (REAL*) sparse_layout_take(&layout, (k + 1) * block);
+	st->P = (REAL*) sparse_layout_take(&layout, (k + 1) * block);
+	st->cs = (REAL*) sparse_layout_take(&layout, (k + 1) * nrhs * sizeof(REAL));
+	st->sn = (REAL*) sparse_layout_take(&layout, (k + 1) * nrhs * sizeof(REAL));
+	st->h = (REAL*) sparse_layout_take(&layout, (k + 2) * sizeof(REAL));
+	return layout.size;
+}
+
+static void PFX(dqgmres_init)(const struct PFX(iteration)* it, struct PFX(dqgmres_state)* st)
+{
+	const int n = it->n;
+
+	PFX(residual)(it, PFX(block)(it, st->V, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		REAL* v = st->V + (size_t) c * n;
+		const REAL beta = BLAS(nrm2)(n, v, 1);
+
+		if (beta > 0)
+			BLAS(scal)(n, 1 / beta, v, 1);
+		st->columns[c].gamma = beta;
+		st->columns[c].norm_r = beta;
+	}
+	st->header->position = 0;
+}
+
+static void PFX(dqgmres_step)(const struct PFX(iteration)* it, const SparseGMRESOptions* o, struct PFX(dqgmres_state)* st, const bool* skip)
+{
+	const int n = it->n, k = o->nvec;
+	const size_t ldv = (size_t) n * it->nrhs;
+	const int m = st->header->position;
+	// column m of the Hessenberg matrix has rows m - k + 1 to m + 1, the rotations add row
+	// m - k; h[i - base] is row i
+	const int base = m - k;
+	const int first = (base > 0) ? base : 0;
+	REAL* Vm = st->V + (size_t) (m % (k + 1)) * ldv;
+	REAL* Pm = st->P + (size_t) (m % (k + 1)) * ldv;
+	REAL* w = st->V + (size_t) ((m + 1) % (k + 1)) * ldv;
+
+	// w = A z with z = P v_m, which becomes p_m
+	PFX(precondition)(it, CblasNoTrans, PFX(block)(it, Vm, n), PFX(block)(it, Pm, n));
+	PFX(operate)(it, false, CblasNoTrans, PFX(block)(it, Pm, n), PFX(block)(it, w, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(dqgmres_column)* col = &st->columns[c];
+		REAL* wc = w + (size_t) c * n;
+		REAL* pm = Pm + (size_t) c * n;
+		REAL* cs = st->cs + (size_t) c * (k + 1);
+		REAL* sn = st->sn + (size_t) c * (k + 1);
+		REAL* h = st->h;
+
+		if (PFX(skipped)(skip, c))
+			continue;
+
+		memset(h, 0, (size_t) (k + 2) * sizeof(REAL));
+		for (int i = (m - k + 1 > 0) ? m - k + 1 : 0; i <= m; i++)
+		{
+			const REAL* v = st->V + (size_t) (i % (k + 1)) * ldv + (size_t) c * n;
+			h[i - base] = BLAS(dot)(n, v, 1, wc, 1);
+			BLAS(axpy)(n, -h[i - base], v, 1, wc, 1);
+		}
+		h[k + 1] = BLAS(nrm2)(n, wc, 1);
+		if (h[k + 1] > 0)
+			BLAS(scal)(n, 1 / h[k + 1], wc, 1);
+
+		for (int i = first; i < m; i++)
+		{
+			const int r = i % (k + 1);
+			const REAL a = h[i - base], b = h[i + 1 - base];
+			h[i - base] = cs[r] * a + sn[r] * b;
+			h[i + 1 - base] = -sn[r] * a + cs[r] * b;
+		}
+
+		double c_, s_, r_;
+		sym_ortho(h[k], h[k + 1], &c_, &s_, &r_);
+		cs[m % (k + 1)] = (REAL) c_;
+		sn[m % (k + 1)] = (REAL) s_;
+
+		// p_m = (z - sum h_im p_i) / h_mm, X += gamma_m p_m
+		for (int i = first; i < m; i++)
+			BLAS(axpy)(n, -h[i - base], st->P + (size_t) (i % (k + 1)) * ldv + (size_t) c * n, 1, pm, 1);
+		if (r_ != 0)
+		{
+			BLAS(scal)(n, (REAL) (1 / r_), pm, 1);
+			BLAS(axpy)(n, (REAL) c_ * col->gamma, pm, 1, ITERATIVE_COLUMN(it->X, c), 1);
+		}
+		else
+			memset(pm, 0, (size_t) n * sizeof(REAL));
+
+		col->gamma = (REAL) -s_ * col->gamma;
+		col->norm_r = ABS(col->gamma);
+	}
+
+	st->header->position = m + 1;
+}
+
+//
+// What CG and the GMRES variants share
+//
+
+struct PFX(krylov)
+{
+	int method;
+	SparseGMRESOptions gmres;
+	struct PFX(cg_state) cg;
+	struct PFX(gmres_state) restarted;
+	struct PFX(dqgmres_state) dq;
+};
+
+static size_t PFX(krylov_layout)(struct PFX(krylov)* kr, char* base, bool preconditioned, int n, int nrhs)
+{
+	if (kr->method == _SparseMethodCG)
+		return PFX(cg_layout)(base, preconditioned, n, nrhs, &kr->cg);
+	if (kr->gmres.variant == SparseVariantDQGMRES)
+		return PFX(dqgmres_layout)(base, &kr->gmres, n, nrhs, &kr->dq);
+	return PFX(gmres_layout)(base, &kr->gmres, preconditioned, n, nrhs, &kr->restarted);
+}
+
+static void PFX(krylov_init)(struct PFX(krylov)* kr, const struct PFX(iteration)* it)
+{
+	if (kr->method == _SparseMethodCG)
+		PFX(cg_init)(it, &kr->cg);
+	else if (kr->gmres.variant == SparseVariantDQGMRES)
+		PFX(dqgmres_init)(it, &kr->dq);
+	else
+		PFX(gmres_init)(it, &kr->gmres, &kr->restarted);
+}
+
+static void PFX(krylov_step)(struct PFX(krylov)* kr, const struct PFX(iteration)* it, const bool* skip)
+{
+	if (kr->method == _SparseMethodCG)
+		PFX(cg_step)(it, &kr->cg, skip);
+	else if (kr->gmres.variant == SparseVariantDQGMRES)
+		PFX(dqgmres_step)(it, &kr->gmres, &kr->dq, skip);
+	else
+		PFX(gmres_step)(it, &kr->gmres, &kr->restarted, skip);
+}
+
+// Makes X the current solution
+static void PFX(krylov_finish)(struct PFX(krylov)* kr, const struct PFX(iteration)* it)
+{
+	if (kr->method == _SparseMethodGMRES && kr->gmres.variant != SparseVariantDQGMRES)
+		PFX(gmres_update)(it, &kr->gmres, &kr->restarted);
+}
+
+// The residual estimate of column c, negative after a breakdown
+static REAL PFX(krylov_norm)(const struct PFX(krylov)* kr, int c)
+{
+	if (kr->method == _SparseMethodCG)
+		return kr->cg.columns[c].broken ? -1 : kr->cg.columns[c].norm_r;
+	if (kr->gmres.variant == SparseVariantDQGMRES)
+		return kr->dq.columns[c].norm_r;
+	return kr->restarted.columns[c].norm_r;
+}
+
+// R = B - AX for the columns that aren't skipped
+static void PFX(krylov_residual)(struct PFX(krylov)* kr, const struct PFX(iteration)* it, const bool* skip, DENSE_MATRIX R)
+{
+	if (kr->method == _SparseMethodCG)
+	{
+		for (int c = 0; c < it->nrhs; c++)
+		{
+			if (!PFX(skipped)(skip, c))
+				memcpy(ITERATIVE_COLUMN(R, c), kr->cg.r + (size_t) c * it->n, (size_t) it->n * sizeof(REAL));
+		}
+	}
+	else if (kr->gmres.variant == SparseVariantDQGMRES)
+		PFX(residual)(it, R);
+	else
+		PFX(gmres_residual)(it, &kr->gmres, &kr->restarted, skip, R);
+}
+
+static SparseIterativeStatus_t PFX(krylov_solve)(struct PFX(krylov)* kr, const struct PFX(iteration)* it, const char* name, int max_iterations, double atol, double rtol, void (*report_error)(const char* message), void (*report)(const char* message))
+{
+	const int nrhs = it->nrhs;
+	struct sparse_layout layout = { NULL, PFX(krylov_layout)(kr, NULL, it->P != NULL, it->n, nrhs) };
+	REAL* norm_b = (REAL*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(REAL));
+	bool* done = (bool*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(bool));
+	bool* failed = (bool*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(bool));
+
+	char* state = (char*) malloc(layout.size);
+	if (!state)
+	{
+		sparse_error(report_error, "out of memory");
+		return SparseIterativeInternalError;
+	}
+
+	layout.base = state;
+	layout.size = PFX(krylov_layout)(kr, state, it->P != NULL, it->n, nrhs);
+	norm_b = (REAL*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(REAL));
+	done = (bool*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(bool));
+	failed = (bool*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(bool));
+
+	for (int c = 0; c < nrhs; c++)
+	{
+		norm_b[c] = BLAS(nrm2)(it->m, ITERATIVE_COLUMN(it->B, c), 1);
+		failed[c] = false;
+	}
+
+	int iterations = 0;
+	bool converged;
+
+	PFX(krylov_init)(kr, it);
+	for (;;)
+	{
+		// the norms are of B - AX here
+		converged = true;
+		for (int c = 0; c < nrhs; c++)
+		{
+			done[c] = failed[c] || residual_converged(PFX(krylov_norm)(kr, c), norm_b[c], atol, rtol);
+			converged = converged && done[c];
+		}
+		if (converged || iterations >= max_iterations)
+			break;
+
+		while (iterations < max_iterations)
+		{
+			double worst = 0;
+			bool all = true;
+
+			PFX(krylov_step)(kr, it, done);
+			iterations++;
+
+			for (int c = 0; c < nrhs; c++)
+			{
+				const REAL norm = PFX(krylov_norm)(kr, c);
+
+				if (done[c])
+					continue;
+				if (norm < 0)
+					done[c] = failed[c] = true;
+				else if (residual_converged(norm, norm_b[c], atol, rtol))
+					done[c] = true;
+				else
+				{
+					all = false;
+					worst = fmax(worst, (norm_b[c] > 0) ? norm / norm_b[c] : norm);
+				}
+			}
+
+			report_status(report, "%s iteration %d: largest relative residual %.3e", name, iterations, worst);
+			if (all)
+				break;
+		}
+
+		// check the estimates against the true residual, restarting from X
+		PFX(krylov_finish)(kr, it);
+		PFX(krylov_init)(kr, it);
+	}
+
+	bool any_failed = false;
+	for (int c = 0; c < nrhs; c++)
+		any_failed = any_failed || failed[c];
+
+	free(state);
+	if (any_failed)
+		return SparseIterativeIllConditioned;
+	return converged ? SparseIterativeConverged : SparseIterativeMaxIterations;
+}
+
+//
+// LSMR of Fong and Saunders, for min |A P Y - R0|^2 + lambda^2 |Y|^2 with X = X0 + P Y
+// and R0 = B - A X0, the directions of X being kept preconditioned
+//
+
+struct PFX(lsmr_column)
+{
+	REAL alpha, beta;
+	REAL zetabar, alphabar, rho, rhobar, cbar, sbar;
+	// for the estimate of |r|
+	REAL betadd, betad, rhodold, tautildeold, thetatilde, zeta, d;
+	// for the estimates of |A| and cond(A)
+	REAL normA2, maxrbar, minrbar;
+	REAL normb, normr, normar, normar0;
+	int iterations;
+	int status;
+};
+
+struct PFX(lsmr_state)
+{
+	struct PFX(lsmr_column)* columns;
+	// m x nrhs
+	REAL* u;
+	REAL* r;
+	// n x nrhs: v, P v (v itself without a preconditioner), A^T u before preconditioning,
+	// and the directions h and hbar multiplied by P
+	REAL* v;
+	REAL* pv;
+	REAL* t;
+	REAL* h;
+	REAL* hbar;
+	// the last nvec v for local reorthogonalization, v_i in slot i mod nvec
+	REAL* local;
+};
+
+static size_t PFX(lsmr_layout)(char* base, const SparseLSMROptions* o, bool preconditioned, int m, int n, int nrhs, struct PFX(lsmr_state)* st)
+{
+	struct sparse_layout layout = { base, 0 };
+	const size_t mblock = (size_t) m * nrhs * sizeof(REAL);
+	const size_t nblock = (size_t) n * nrhs * sizeof(REAL);
+
+	sparse_layout_take(&layout, sizeof(struct iterative_header));
+	st->columns = (struct PFX(lsmr_column)*) sparse_layout_take(&layout, (size_t) nrhs * sizeof(*st->columns));
+	st->u = (REAL*) sparse_layout_take(&layout, mblock);
+	st->r = (REAL*) sparse_layout_take(&layout, mblock);
+	st->v = (REAL*) sparse_layout_take(&layout, nblock);
+	st->pv = st->v;
+	st->t = NULL;
+	if (preconditioned)
+	{
+		st->pv = (REAL*) sparse_layout_take(&layout, nblock);
+		st->t = (REAL*) sparse_layout_take(&layout, nblock);
+	}
+	st->h = (REAL*) sparse_layout_take(&layout, nblock);
+	st->hbar = (REAL*) sparse_layout_take(&layout, nblock);
+	st->local = (REAL*) sparse_layout_take(&layout, (size_t) o->nvec * nblock);
+	return layout.size;
+}
+
+// v = P^T A^T u, added to v if accumulate is set
+static void PFX(lsmr_transpose)(const struct PFX(iteration)* it, struct PFX(lsmr_state)* st, bool accumulate, const bool* skip)
+{
+	const int n = it->n;
+
+	if (!it->P)
+	{
+		PFX(operate)(it, accumulate, CblasTrans, PFX(block)(it, st->u, it->m), PFX(block)(it, st->v, n));
+		return;
+	}
+
+	PFX(operate)(it, false, CblasTrans, PFX(block)(it, st->u, it->m), PFX(block)(it, st->t, n));
+	PFX(precondition)(it, CblasTrans, PFX(block)(it, st->t, n), PFX(block)(it, st->pv, n));
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		if (PFX(skipped)(skip, c))
+			continue;
+		if (accumulate)
+			BLAS(axpy)(n, 1, st->pv + (size_t) c * n, 1, st->v + (size_t) c * n, 1);
+		else
+			memcpy(st->v + (size_t) c * n, st->pv + (size_t) c * n, (size_t) n * sizeof(REAL));
+	}
+}
+
+// Normalizes v after orthogonalizing it against the last vectors, returns |v|
+static REAL PFX(lsmr_normalize)(const struct PFX(iteration)* it, const SparseLSMROptions* o, struct PFX(lsmr_state)* st, int c)
+{
+	const int n = it->n;
+	const size_t nblock = (size_t) n * it->nrhs;
+	const int iterations = st->columns[c].iterations;
+	REAL* v = st->v + (size_t) c * n;
+
+	if (o->nvec > 0)
+	{
+		const int count = (iterations < o->nvec) ? iterations : o->nvec;
+
+		for (int i = iterations - count; i < iterations; i++)
+		{
+			const REAL* w = st->local + (size_t) (i % o->nvec) * nblock + (size_t) c * n;
+			BLAS(axpy)(n, -BLAS(dot)(n, w, 1, v, 1), w, 1, v, 1);
+		}
+	}
+
+	const REAL alpha = BLAS(nrm2)(n, v, 1);
+	if (alpha > 0)
+		BLAS(scal)(n, 1 / alpha, v, 1);
+	if (o->nvec > 0)
+		memcpy(st->local + (size_t) (iterations % o->nvec) * nblock + (size_t) c * n, v, (size_t) n * sizeof(REAL));
+	return alpha;
+}
+
+static void PFX(lsmr_init)(const struct PFX(iteration)* it, const SparseLSMROptions* o, struct PFX(lsmr_state)* st)
+{
+	const int m = it->m, n = it->n;
+
+	PFX(residual)(it, PFX(block)(it, st->u, m));
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		REAL* u = st->u + (size_t) c * m;
+
+		st->columns[c].beta = BLAS(nrm2)(m, u, 1);
+		st->columns[c].iterations = 0;
+		if (st->columns[c].beta > 0)
+			BLAS(scal)(m, 1 / st->columns[c].beta, u, 1);
+	}
+
+	PFX(lsmr_transpose)(it, st, false, NULL);
+	for (int c = 0; c < it->nrhs; c++)
+		st->columns[c].alpha = PFX(lsmr_normalize)(it, o, st, c);
+	if (it->P)
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, st->v, n), PFX(block)(it, st->pv, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(lsmr_column)* col = &st->columns[c];
+
+		memcpy(st->h + (size_t) c * n, st->pv + (size_t) c * n, (size_t) n * sizeof(REAL));
+		memset(st->hbar + (size_t) c * n, 0, (size_t) n * sizeof(REAL));
+
+		col->zetabar = col->alpha * col->beta;
+		col->alphabar = col->alpha;
+		col->rho = col->rhobar = col->cbar = 1;
+		col->sbar = 0;
+		col->betadd = col->beta;
+		col->betad = 0;
+		col->rhodold = 1;
+		col->tautildeold = col->thetatilde = col->zeta = col->d = 0;
+		col->normA2 = col->alpha * col->alpha;
+		col->maxrbar = 0;
+		col->minrbar = IS_DOUBLE ? DBL_MAX : FLT_MAX;
+		col->normb = col->normr = col->beta;
+		col->normar = col->normar0 = col->alpha * col->beta;
+		col->status = (col->normar == 0) ? lsmr_converged : lsmr_running;
+	}
+}
+
+// The recurrences of one step for column c, once u, v and P v have been advanced
+static void PFX(lsmr_update)(const struct PFX(iteration)* it, const SparseLSMROptions* o, struct PFX(lsmr_state)* st, int c)
+{
+	struct PFX(lsmr_column)* col = &st->columns[c];
+	const int n = it->n;
+	REAL* X = ITERATIVE_COLUMN(it->X, c);
+	REAL* h = st->h + (size_t) c * n;
+	REAL* hbar = st->hbar + (size_t) c * n;
+	double chat, shat, alphahat, cs, sn, rho, cbar, sbar, rhobar;
+
+	// the rotations eliminating the damping and the subdiagonal of the bidiagonal matrix
+	sym_ortho(col->alphabar, o->lambda, &chat, &shat, &alphahat);
+	const double rhoold = col->rho;
+	sym_ortho(alphahat, col->beta, &cs, &sn, &rho);
+	const double thetanew = sn * col->alpha;
+	col->alphabar = (REAL) (cs * col->alpha);
+
+	const double rhobarold = col->rhobar;
+	const double zetaold = col->zeta;
+	const double thetabar = col->sbar * rho;
+	const double rhotemp = col->cbar * rho;
+	sym_ortho(col->cbar * rho, thetanew, &cbar, &sbar, &rhobar);
+	const double zeta = cbar * col->zetabar;
+	col->zetabar = (REAL) (-sbar * col->zetabar);
+
+	if (rho == 0 || rhobar == 0)
+	{
+		col->status = lsmr_ill_conditioned;
+		return;
+	}
+
+	// hbar = h - thetabar rho / (rhoold rhobarold) hbar, X += zeta / (rho rhobar) hbar,
+	// h = P v - thetanew / rho h
+	BLAS(scal)(n, (REAL) (-thetabar * rho / (rhoold * rhobarold)), hbar, 1);
+	BLAS(axpy)(n, 1, h, 1, hbar, 1);
+	BLAS(axpy)(n, (REAL) (zeta / (rho * rhobar)), hbar, 1, X, 1);
+	BLAS(scal)(n, (REAL) (-thetanew / rho), h, 1);
+	BLAS(axpy)(n, 1, st->pv + (size_t) c * n, 1, h, 1);
+
+	// |r|
+	const double betaacute = chat * col->betadd;
+	const double betacheck = -shat * col->betadd;
+	const double betahat = cs * betaacute;
+	col->betadd = (REAL) (-sn * betaacute);
+
+	double ctildeold, stildeold, rhotildeold;
+	const double thetatildeold = col->thetatilde;
+	sym_ortho(col->rhodold, thetabar, &ctildeold, &stildeold, &rhotildeold);
+	col->thetatilde = (REAL) (stildeold * rhobar);
+	col->rhodold = (REAL) (ctildeold * rhobar);
+	col->betad = (REAL) (-stildeold * col->betad + ctildeold * betahat);
+	col->tautildeold = (REAL) ((zetaold - thetatildeold * col->tautildeold) / rhotildeold);
+	const double taud = (zeta - col->thetatilde * col->tautildeold) / col->rhodold;
+	col->d += (REAL) (betacheck * betacheck);
+	col->normr = (REAL) sqrt(col->d + (col->betad - taud) * (col->betad - taud) + (double) col->betadd * col->betadd);
+
+	// |A| and cond(A)
+	col->normA2 += col->beta * col->beta;
+	const double normA = sqrt(col->normA2);
+	col->normA2 += col->alpha * col->alpha;
+	if (rhobarold > col->maxrbar)
+		col->maxrbar = (REAL) rhobarold;
+	if (col->iterations > 1 && rhobarold < col->minrbar)
+		col->minrbar = (REAL) rhobarold;
+	const double condA = fmax(col->maxrbar, rhotemp) / fmin(col->minrbar, rhotemp);
+
+	col->rho = (REAL) rho;
+	col->rhobar = (REAL) rhobar;
+	col->cbar = (REAL) cbar;
+	col->sbar = (REAL) sbar;
+	col->zeta = (REAL) zeta;
+	col->normar = ABS(col->zetabar);
+
+	// the stopping rules
+	const double normx = BLAS(nrm2)(n, X, 1);
+	const double test1 = (col->normb > 0) ? col->normr / col->normb : 0;
+	const double test2 = (normA * col->normr > 0) ? col->normar / (normA * col->normr) : 0;
+	const double test3 = 1 / condA;
+
+	if (test3 <= 1 / o->conditionLimit)
+		col->status = lsmr_ill_conditioned;
+	else if (o->convergenceTest == SparseLSMRCTFongSaunders)
+	{
+		const double t1 = test1 / (1 + normA * normx / col->normb);
+		const double tol = o->btol + o->atol * normA * normx / col->normb;
+
+		if (test2 <= o->atol || test1 <= tol || 1 + test2 <= 1 || 1 + t1 <= 1)
+			col->status = lsmr_converged;
+	}
+	else if (residual_converged(col->normar, col->normar0, o->atol, o->rtol) || residual_converged(col->normr, col->normb, o->atol, o->rtol))
+		col->status = lsmr_converged;
+}
+
+static void PFX(lsmr_step)(const struct PFX(iteration)* it, const SparseLSMROptions* o, struct PFX(lsmr_state)* st, const bool* skip)
+{
+	const int m = it->m, n = it->n;
+
+	// beta u = A P v - alpha u
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		if (!PFX(skipped)(skip, c))
+			BLAS(scal)(m, -st->columns[c].alpha, st->u + (size_t) c * m, 1);
+	}
+	PFX(operate)(it, true, CblasNoTrans, PFX(block)(it, st->pv, n), PFX(block)(it, st->u, m));
+
+	// alpha v = P^T A^T u - beta v
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		struct PFX(lsmr_column)* col = &st->columns[c];
+		REAL* u = st->u + (size_t) c * m;
+
+		if (PFX(skipped)(skip, c))
+			continue;
+
+		col->beta = BLAS(nrm2)(m, u, 1);
+		if (col->beta > 0)
+			BLAS(scal)(m, 1 / col->beta, u, 1);
+		BLAS(scal)(n, -col->beta, st->v + (size_t) c * n, 1);
+	}
+	PFX(lsmr_transpose)(it, st, true, skip);
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		if (PFX(skipped)(skip, c))
+			continue;
+		st->columns[c].iterations++;
+		st->columns[c].alpha = PFX(lsmr_normalize)(it, o, st, c);
+	}
+	if (it->P)
+		PFX(precondition)(it, CblasNoTrans, PFX(block)(it, st->v, n), PFX(block)(it, st->pv, n));
+
+	for (int c = 0; c < it->nrhs; c++)
+	{
+		if (!PFX(skipped)(skip, c) && st->columns[c].status == lsmr_running)
+			PFX(lsmr_update)(it, o, st, c);
+	}
+}
+
+// R = A^T (B - A X)
+static void PFX(lsmr_residual)(const struct PFX(iteration)* it, struct PFX(lsmr_state)* st, DENSE_MATRIX R)
+{
+	const DENSE_MATRIX r = PFX(block)(it, st->r, it->m);
+
+	PFX(residual)(it, r);
+	PFX(operate)(it, false, CblasTrans, r, R);
+}
+
+//
+// The entry points
+//
+
+size_t F(_SparseGetIterativeStateSize)(const SparseIterativeMethod *__method, bool __preconditioner, int __m, int __n, int __nrhs)
+{
+	struct PFX(krylov) kr = { 0 };
+
+	if (!__method || __m < 0 || __n < 0 || __nrhs < 0)
+	{
+		sparse_error(NULL, "invalid iterative method or dimensions");
+		return 0;
+	}
+
+	switch (__method->method)
+	{
+		case _SparseMethodCG:
+			kr.method = _SparseMethodCG;
+			return PFX(krylov_layout)(&kr, NULL, __preconditioner, __n, __nrhs);
+		case _SparseMethodGMRES:
+			kr.method = _SparseMethodGMRES;
+			kr.gmres = gmres_defaults(&__method->options.gmres, EPSILON);
+			return PFX(krylov_layout)(&kr, NULL, __preconditioner, __n, __nrhs);
+		case _SparseMethodLSMR:
+		{
+			struct PFX(lsmr_state) st;
+			const SparseLSMROptions o = lsmr_defaults(&__method->options.lsmr, EPSILON, __n);
+			return PFX(lsmr_layout)(NULL, &o, __preconditioner, __m, __n, __nrhs, &st);
+		}
+		default:
+			sparse_error(NULL, "unknown iterative method %d", __method->method);
+			return 0;
+	}
+}
+
+SparseIterativeStatus_t F(_SparseCGSolve)(const SparseCGOptions *__options, DENSE_MATRIX __X, DENSE_MATRIX __B, OPERATOR __ApplyOperator, const PRECONDITIONER *__Preconditioner)
+{
+	const SparseCGOptions o = cg_defaults(__options, EPSILON);
+	struct PFX(krylov) kr = { .method = _SparseMethodCG };
+	struct PFX(iteration) it;
+
+	if (!PFX(iteration_setup)(&it, o.reportError, true, __X, __B, __ApplyOperator, __Preconditioner))
+		return SparseIterativeParameterError;
+
+	return PFX(krylov_solve)(&kr, &it, "CG", o.maxIterations, o.atol, o.rtol, o.reportError, o.reportStatus);
+}
+
+SparseIterativeStatus_t F(_SparseGMRESSolve)(const SparseGMRESOptions *__options, DENSE_MATRIX __X, DENSE_MATRIX __B, OPERATOR __ApplyOperator, const PRECONDITIONER *__Preconditioner)
+{
+	struct PFX(krylov) kr = { .method = _SparseMethodGMRES, .gmres = gmres_defaults(__options, EPSILON) };
+	struct PFX(iteration) it;
+
+	if (!gmres_variant_valid(kr.gmres.variant))
+	{
+		sparse_error(kr.gmres.reportError, "unknown GMRES variant %d", kr.gmres.variant);
+		return SparseIterativeParameterError;
+	}
+	if (!PFX(iteration_setup)(&it, kr.gmres.reportError, true, __X, __B, __ApplyOperator, __Preconditioner))
+		return SparseIterativeParameterError;
+
+	return PFX(krylov_solve)(&kr, &it, "GMRES", kr.gmres.maxIterations, kr.gmres.atol, kr.gmres.rtol, kr.gmres.reportError, kr.gmres.reportStatus);
+}
+
+SparseIterativeStatus_t F(_SparseLSMRSolve)(const SparseLSMROptions *__options, DENSE_MATRIX __X, DENSE_MATRIX __B, OPERATOR __ApplyOperator, const PRECONDITIONER *__Preconditioner)
+{
+	const SparseLSMROptions o = lsmr_defaults(__options, EPSILON, __X.rowCount);
+	struct PFX(lsmr_state) st;
+	struct PFX(iteration) it;
+
+	if (!PFX(iteration_setup)(&it, o.reportError, false, __X, __B, __ApplyOperator, __Preconditioner))
+		return SparseIterativeParameterError;
+
+	const size_t size = PFX(lsmr_layout)(NULL, &o, it.P != NULL, it.m, it.n, it.nrhs, &st);
+	char* state = (char*) malloc(size + (size_t) it.nrhs * sizeof(bool));
+	if (!state)
+	{
+		sparse_error(o.reportError, "out of memory");
+		return SparseIterativeInternalError;
+	}
+	PFX(lsmr_layout)(state, &o, it.P != NULL, it.m, it.n, it.nrhs, &st);
+	bool* done = (bool*) (state + size);
+
+	PFX(lsmr_init)(&it, &o, &st);
+
+	int iterations = 0;
+	bool all = true;
+	for (;;)
+	{
+		double worst = 0;
+
+		all = true;
+		for (int c = 0; c < it.nrhs; c++)
+		{
+			const struct PFX(lsmr_column)* col = &st.columns[c];
+
+			done[c] = col->status != lsmr_running;
+			if (!done[c])
+			{
+				all = false;
+				worst = fmax(worst, (col->normar0 > 0) ? col->normar / col->normar0 : col->normar);
+			}
+		}
+		if (iterations > 0)
+			report_status(o.reportStatus, "LSMR iteration %d: largest relative |A^T r| %.3e", iterations, worst);
+		if (all || iterations >= o.maxIterations)
+			break;
+
+		PFX(lsmr_step)(&it, &o, &st, done);
+		iterations++;
+	}
+
+	SparseIterativeStatus_t status = all ? SparseIterativeConverged : SparseIterativeMaxIterations;
+	for (int c = 0; c < it.nrhs; c++)
+	{
+		if (st.columns[c].status == lsmr_ill_conditioned)
+			status = SparseIterativeIllConditioned;
+	}
+
+	free(state);
+	return status;
+}
+
+// Checks an Iterate call, R being n x nrhs
+static bool PFX(iterate_setup)(struct PFX(iteration)* it, void (*report)(const char* message), bool square, char* state, DENSE_MATRIX X, DENSE_MATRIX B, DENSE_MATRIX R, OPERATOR apply, const PRECONDITIONER* P)
+{
+	if (!state)
+	{
+		sparse_error(report, "no state to iterate with");
+		return false;
+	}
+	if (!PFX(iteration_setup)(it, report, square, X, B, apply, P))
+		return false;
+	if (R.rowCount != X.rowCount || R.columnCount != X.columnCount || R.columnStride < R.rowCount)
+	{
+		sparse_error(report, "residual of %d x %d for X of %d x %d", R.rowCount, R.columnCount, X.rowCount, X.columnCount);
+		return false;
+	}
+	return true;
+}
+
+static void PFX(krylov_iterate)(struct PFX(krylov)* kr, const struct PFX(iteration)* it, int iteration, char* state, const bool* converged, DENSE_MATRIX R)
+{
+	PFX(krylov_layout)(kr, state, it->P != NULL, it->n, it->nrhs);
+
+	if (iteration < 0)
+	{
+		PFX(krylov_finish)(kr, it);
+		return;
+	}
+
+	if (iteration == 0)
+		PFX(krylov_init)(kr, it);
+	else
+		PFX(krylov_step)(kr, it, converged);
+	PFX(krylov_residual)(kr, it, converged, R);
+}
+
+void F(_SparseCGIterate)(const SparseCGOptions *__options, int __iteration, char *__state, const bool *__converged, DENSE_MATRIX __X, DENSE_MATRIX __B, DENSE_MATRIX __R, const PRECONDITIONER *__Preconditioner, OPERATOR __ApplyOperator)
+{
+	const SparseCGOptions o = cg_defaults(__options, EPSILON);
+	struct PFX(krylov) kr = { .method = _SparseMethodCG };
+	struct PFX(iteration) it;
+
+	if (PFX(iterate_setup)(&it, o.reportError, true, __state, __X, __B, __R, __ApplyOperator, __Preconditioner))
+		PFX(krylov_iterate)(&kr, &it, __iteration, __state, __converged, __R);
+}
+
+void F(_SparseGMRESIterate)(const SparseGMRESOptions *__options, int __iteration, char *__state, const bool *__converged, DENSE_MATRIX __X, DENSE_MATRIX __B, DENSE_MATRIX __R, const PRECONDITIONER *__Preconditioner, OPERATOR __ApplyOperator)
+{
+	struct PFX(krylov) kr = { .method = _SparseMethodGMRES, .gmres = gmres_defaults(__options, EPSILON) };
+	struct PFX(iteration) it;
+
+	if (!gmres_variant_valid(kr.gmres.variant))
+	{
+		sparse_error(kr.gmres.reportError, "unknown GMRES variant %d", kr.gmres.variant);
+		return;
+	}
+	if (PFX(iterate_setup)(&it, kr.gmres.reportError, true, __state, __X, __B, __R, __ApplyOperator, __Preconditioner))
+		PFX(krylov_iterate)(&kr, &it, __iteration, __state, __converged, __R);
+}
+
+void F(_SparseLSMRIterate)(const SparseLSMROptions *__options, int __iteration, char *__state, const bool *__converged, DENSE_MATRIX __X, DENSE_MATRIX __B, DENSE_MATRIX __R, const PRECONDITIONER *__Preconditioner, OPERATOR __ApplyOperator)
+{
+	const SparseLSMROptions o = lsmr_defaults(__options, EPSILON, __X.rowCount);
+	struct PFX(lsmr_state) st;
+	struct PFX(iteration) it;
+
+	if (!PFX(iterate_setup)(&it, o.reportError, false, __state, __X, __B, __R, __ApplyOperator, __Preconditioner))
+		return;
+
+	// X is updated in every step
+	if (__iteration < 0)
+		return;
+
+	PFX(lsmr_layout)(__state, &o, it.P != NULL, it.m, it.n, it.nrhs, &st);
+	if (__iteration == 0)
+		PFX(lsmr_init)(&it, &o, &st);
+	else
+		PFX(lsmr_step)(&it, &o, &st, __converged);
+	PFX(lsmr_residual)(&it, &st, __R);
+}
+
+//
+// Preconditioners
+//
+
+// Y = D X with the diagonal D in mem
+static void PFX(apply_diagonal)(void* mem, enum CBLAS_TRANSPOSE trans, DENSE_MATRIX X, DENSE_MATRIX Y)
+{
+	const REAL* d = (const REAL*) mem;
+
+	(void) trans;
+	for (int c = 0; c < X.columnCount; c++)
+	{
+		const REAL* x = ITERATIVE_COLUMN(X, c);
+		REAL* y = ITERATIVE_COLUMN(Y, c);
+
+		for (int i = 0; i < X.rowCount; i++)
+			y[i] = d[i] * x[i];
+	}
+}
+
+// d[j] = sum of a_ij^2 over column j of op(A) for DiagScaling, the diagonal for Diagonal
+static void PFX(diagonal_sums)(const SPARSE_MATRIX* A, bool squares, REAL* d)
+{
+	const SparseMatrixStructure* s = &A->structure;
+	const SparseKind_t kind = s->attributes.kind;
+	const bool lower = s->attributes.triangle == SparseLowerTriangle;
+	const bool transpose = s->attributes.transpose && kind != SparseSymmetric;
+	const int b = s->blockSize;
+	const size_t size = (size_t) b * b;
+
+	for (int J = 0; J < s->columnCount; J++)
+	{
+		for (long p = s->columnStarts[J]; p < s->columnStarts[J + 1]; p++)
+		{
+			const int I = s->rowIndices[p];
+			const REAL* block = A->data + p * size;
+
+			if (!squares && I != J)
+				continue;
+
+			for (int bj = 0; bj < b; bj++)
+			{
+				for (int bi = 0; bi < b; bi++)
+				{
+					const int i = I * b + bi, j = J * b + bj;
+					const REAL value = block[bi + bj * b];
+
+					if (kind != SparseOrdinary && (lower ? i < j : i > j))
+						continue;
+					if (kind == SparseUnitTriangular && i == j)
+						continue;
+
+					if (!squares)
+					{
+						if (i == j)
+							d[i] += value;
+					}
+					else
+					{
+						d[transpose ? i : j] += value * value;
+						if (kind == SparseSymmetric && i != j)
+							d[i] += value * value;
+					}
+				}
+			}
+		}
+	}
+
+	if (kind == SparseUnitTriangular)
+	{
+		for (int i = 0; i < s->columnCount * b; i++)
+			d[i] += 1;
+	}
+}
+
+PRECONDITIONER F(_SparseCreatePreconditioner)(SparsePreconditioner_t __type, const SPARSE_MATRIX *__A)
+{
+	PRECONDITIONER P = { SparsePreconditionerNone, NULL, NULL };
+
+	if (!__A)
+	{
+		sparse_error(NULL, "no matrix to precondition");
+		return P;
+	}
+
+	const SparseMatrixStructure* s = &__A->structure;
+	const bool transpose = s->attributes.transpose && s->attributes.kind != SparseSymmetric;
+	const int n = (transpose ? s->rowCount : s->columnCount) * s->blockSize;
+
+	if (__type == SparsePreconditionerDiagonal && s->rowCount != s->columnCount)
+	{
+		sparse_error(NULL, "a diagonal preconditioner needs a square matrix, not %d x %d", s->rowCount * s->blockSize, s->columnCount * s->blockSize);
+		return P;
+	}
+	if (__type != SparsePreconditionerDiagonal && __type != SparsePreconditionerDiagScaling)
+	{
+		sparse_error(NULL, "can't create a preconditioner of type %d", __type);
+		return P;
+	}
+
+	REAL* d = (REAL*) calloc(n ? (size_t) n : 1, sizeof(REAL));
+	if (!d)
+	{
+		sparse_error(NULL, "out of memory");
+		return P;
+	}
+
+	// rows or columns without entries are left alone
+	PFX(diagonal_sums)(__A, __type == SparsePreconditionerDiagScaling, d);
+	for (int i = 0; i < n; i++)
+	{
+		if (__type == SparsePreconditionerDiagScaling)
+			d[i] = (d[i] > 0) ? 1 / SQRT(d[i]) : 1;
+		else
+			d[i] = (d[i] != 0) ? 1 / d[i] : 1;
+	}
+
+	P.type = __type;
+	P.mem = d;
+	P.apply = PFX(apply_diagonal);
+	return P;
+}
+
+void F(_SparseReleaseOpaquePreconditioner)(PRECONDITIONER *__Opaque)
+{
+	if (__Opaque->type == SparsePreconditionerDiagonal || __Opaque->type == SparsePreconditionerDiagScaling)
+		free(__Opaque->mem);
+
+	__Opaque->type = SparsePreconditionerNone;
+	__Opaque->mem = NULL;
+	__Opaque->apply = NULL;
+}
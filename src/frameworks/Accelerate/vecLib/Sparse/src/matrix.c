@@ -0,0 +1,62 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Whether block (I, J) is in the part of the matrix its kind stores
+static bool block_stored(SparseAttributes_t attributes, long I, long J)
+{
+	if (attributes.kind == SparseOrdinary)
+		return true;
+	return (attributes.triangle == SparseLowerTriangle) ? I >= J : I <= J;
+}
+
+// The first entry in [begin, end) of a column with row index >= row, the row indices of a
+// column being increasing
+static long lower_bound(const int* rows, long begin, long end, int row)
+{
+	while (begin < end)
+	{
+		const long mid = begin + (end - begin) / 2;
+		if (rows[mid] < row)
+			begin = mid + 1;
+		else
+			end = mid;
+	}
+	return begin;
+}
+
+static SparseAttributes_t attributes_from_properties(void* A)
+{
+	SparseAttributes_t attributes = { 0 };
+
+	if (sparse_get_matrix_property(A, SPARSE_UPPER_SYMMETRIC) == 1 || sparse_get_matrix_property(A, SPARSE_LOWER_SYMMETRIC) == 1)
+		attributes.kind = SparseSymmetric;
+	else if (sparse_get_matrix_property(A, SPARSE_UPPER_TRIANGULAR) == 1 || sparse_get_matrix_property(A, SPARSE_LOWER_TRIANGULAR) == 1)
+		attributes.kind = SparseTriangular;
+
+	if (sparse_get_matrix_property(A, SPARSE_LOWER_SYMMETRIC) == 1 || sparse_get_matrix_property(A, SPARSE_LOWER_TRIANGULAR) == 1)
+		attributes.triangle = SparseLowerTriangle;
+	return attributes;
+}
+
+#define SPARSE_TEMPLATE "matrix_template.h"
+#include "sparse_instantiate.h"
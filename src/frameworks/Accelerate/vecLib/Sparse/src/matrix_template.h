@@ -0,0 +1,460 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Swaps entries p and q of a column, their row indices and their blocks of `size` values
+static void PFX(swap_entries)(int* rows, REAL* data, size_t size, long p, long q)
+{
+	const int r = rows[p];
+	rows[p] = rows[q];
+	rows[q] = r;
+
+	for (size_t k = 0; k < size; k++)
+	{
+		const REAL t = data[p * size + k];
+		data[p * size + k] = data[q * size + k];
+		data[q * size + k] = t;
+	}
+}
+
+// Heapsort of the entries [begin, end) by row, in place as the storage may be the client's
+static void PFX(sort_column)(int* rows, REAL* data, size_t size, long begin, long end)
+{
+	const long count = end - begin;
+
+	for (long start = count / 2 - 1, last = count; last > 1;)
+	{
+		long root;
+
+		if (start >= 0)
+			root = start--;
+		else
+		{
+			PFX(swap_entries)(rows, data, size, begin, begin + --last);
+			root = 0;
+		}
+
+		for (long child; (child = 2 * root + 1) < last; root = child)
+		{
+			if (child + 1 < last && rows[begin + child + 1] > rows[begin + child])
+				child++;
+			if (rows[begin + root] >= rows[begin + child])
+				break;
+			PFX(swap_entries)(rows, data, size, begin + root, begin + child);
+		}
+	}
+}
+
+SPARSE_MATRIX F(_SparseConvertFromCoordinate)(int __m, int __n, long __nBlock, uint8_t __blockSize, SparseAttributes_t __attributes, const int *__row, const int *__col, const REAL *__val, void *__storage, void *__workspace)
+{
+	SPARSE_MATRIX A = { 0 };
+	const size_t size = (size_t) __blockSize * __blockSize;
+
+	if (__m < 0 || __n < 0 || __nBlock < 0 || __blockSize < 1 || (__nBlock > 0 && (!__row || !__col || !__val)))
+	{
+		sparse_error(NULL, "invalid coordinate matrix");
+		return A;
+	}
+	if (__attributes.kind != SparseOrdinary && __m != __n)
+	{
+		sparse_error(NULL, "a triangular or symmetric matrix must be square, it's %d x %d", __m, __n);
+		return A;
+	}
+
+	int* counts = (int*) (__workspace ? __workspace : malloc(((size_t) __n + 1) * sizeof(int)));
+	if (!counts)
+	{
+		sparse_error(NULL, "out of memory");
+		return A;
+	}
+	memset(counts, 0, (size_t) __n * sizeof(int));
+
+	long kept = 0;
+	for (long k = 0; k < __nBlock; k++)
+	{
+		if (__row[k] < 0 || __row[k] >= __m || __col[k] < 0 || __col[k] >= __n)
+		{
+			sparse_error(NULL, "entry %ld at (%d, %d) is outside the %d x %d matrix", k, __row[k], __col[k], __m, __n);
+			if (counts != __workspace)
+				free(counts);
+			return A;
+		}
+		if (block_stored(__attributes, __row[k], __col[k]))
+		{
+			counts[__col[k]]++;
+			kept++;
+		}
+	}
+
+	// column starts, then the values, which stay 8-byte aligned, then the row indices
+	char* memory = (char*) __storage;
+	if (!memory)
+	{
+		memory = (char*) malloc(((size_t) __n + 1) * sizeof(long) + (size_t) kept * (size * sizeof(REAL) + sizeof(int)));
+		if (!memory)
+		{
+			sparse_error(NULL, "out of memory");
+			if (counts != __workspace)
+				free(counts);
+			return A;
+		}
+		__attributes._allocatedBySparse = true;
+	}
+	else
+		__attributes._allocatedBySparse = false;
+
+	long* starts = (long*) memory;
+	REAL* data = (REAL*) (starts + __n + 1);
+	int* rows = (int*) (data + (size_t) kept * size);
+
+	starts[0] = 0;
+	for (int j = 0; j < __n; j++)
+	{
+		starts[j + 1] = starts[j] + counts[j];
+		counts[j] = 0;
+	}
+	for (long k = 0; k < __nBlock; k++)
+	{
+		if (!block_stored(__attributes, __row[k], __col[k]))
+			continue;
+
+		const long p = starts[__col[k]] + counts[__col[k]]++;
+		rows[p] = __row[k];
+		memcpy(data + (size_t) p * size, __val + (size_t) k * size, size * sizeof(REAL));
+	}
+
+	// sorts the columns and sums up duplicates
+	long q = 0, begin = 0;
+	for (int j = 0; j < __n; j++)
+	{
+		const long end = starts[j + 1];
+
+		PFX(sort_column)(rows, data, size, begin, end);
+		starts[j] = q;
+		for (long p = begin; p < end; p++)
+		{
+			if (q > starts[j] && rows[q - 1] == rows[p])
+			{
+				for (size_t k = 0; k < size; k++)
+					data[(size_t) (q - 1) * size + k] += data[(size_t) p * size + k];
+			}
+			else
+			{
+				if (q != p)
+				{
+					rows[q] = rows[p];
+					memmove(data + (size_t) q * size, data + (size_t) p * size, size * sizeof(REAL));
+				}
+				q++;
+			}
+		}
+		begin = end;
+	}
+	starts[__n] = q;
+
+	// the row indices move up to the values if duplicates shrank them
+	if (q < kept)
+		memmove(data + (size_t) q * size, rows, (size_t) q * sizeof(int));
+
+	A.structure.rowCount = __m;
+	A.structure.columnCount = __n;
+	A.structure.columnStarts = starts;
+	A.structure.rowIndices = (q < kept) ? (int*) (data + (size_t) q * size) : rows;
+	A.structure.attributes = __attributes;
+	A.structure.blockSize = __blockSize;
+	A.data = data;
+
+	if (counts != __workspace)
+		free(counts);
+	return A;
+}
+
+SPARSE_MATRIX F(_SparseConvertFromOpaque)(SB(sparse_matrix) __matrix)
+{
+	SPARSE_MATRIX A = { 0 };
+	const int m = (int) sparse_get_matrix_number_of_rows(__matrix);
+	const int n = (int) sparse_get_matrix_number_of_columns(__matrix);
+	long total = 0;
+
+	if (!__matrix)
+	{
+		sparse_error(NULL, "the matrix is NULL");
+		return A;
+	}
+
+	// committed rows hold both triangles of a symmetric matrix
+	for (int i = 0; i < m; i++)
+	{
+		const long count = sparse_get_matrix_nonzero_count_for_row(__matrix, i);
+		if (count < 0)
+		{
+			sparse_error(NULL, "can't read row %d of the matrix", i);
+			return A;
+		}
+		total += count;
+	}
+
+	int* rows = (int*) malloc(((size_t) total + 1) * sizeof(int));
+	int* columns = (int*) malloc(((size_t) total + 1) * sizeof(int));
+	sparse_index* indices = (sparse_index*) malloc(((size_t) total + 1) * sizeof(sparse_index));
+	REAL* values = (REAL*) malloc(((size_t) total + 1) * sizeof(REAL));
+
+	if (rows && columns && indices && values)
+	{
+		long p = 0;
+		for (int i = 0; i < m; i++)
+		{
+			sparse_index end;
+			const sparse_index count = SB(sparse_extract_sparse_row)(__matrix, i, 0, &end, (sparse_dimension) (total - p), values + p, indices + p);
+
+			for (sparse_index k = 0; k < count; k++)
+			{
+				rows[p + k] = i;
+				columns[p + k] = (int) indices[p + k];
+			}
+			p += (count > 0) ? count : 0;
+		}
+
+		A = F(_SparseConvertFromCoordinate)(m, n, p, 1, attributes_from_properties(__matrix), rows, columns, values, NULL, NULL);
+	}
+	else
+		sparse_error(NULL, "out of memory");
+
+	free(rows);
+	free(columns);
+	free(indices);
+	free(values);
+	return A;
+}
+
+struct PFX(spmv_job)
+{
+	REAL alpha;
+	const SPARSE_MATRIX* A;
+	bool transpose;
+	bool accumulate;
+	// op(A) is rows x columns, the blocks of the task's rows are split evenly
+	int rows;
+	int block_rows;
+	size_t tasks;
+	const REAL* X;
+	int ldx;
+	REAL* Y;
+	int ldy;
+	int nrhs;
+};
+
+// y[i] += v x[j] for the right-hand sides
+static inline void PFX(spmv_add)(const struct PFX(spmv_job)* job, int i, int j, REAL v)
+{
+	const REAL* x = job->X + j;
+	REAL* y = job->Y + i;
+
+	for (int c = 0; c < job->nrhs; c++)
+		y[(size_t) c * job->ldy] += v * x[(size_t) c * job->ldx];
+}
+
+// spmv_task() for matrices of single values, one right-hand side at a time so that the
+// loops keep x and y in registers and the mirrored entries of a column add up to one sum
+static void PFX(spmv_values)(const struct PFX(spmv_job)* job, int I0, int I1)
+{
+	const SparseMatrixStructure* s = &job->A->structure;
+	const REAL* data = job->A->data;
+	const SparseKind_t kind = s->attributes.kind;
+	const bool lower = s->attributes.triangle == SparseLowerTriangle;
+	const bool skip_diagonal = kind == SparseSymmetric || kind == SparseUnitTriangular;
+	const REAL alpha = job->alpha;
+
+	for (int c = 0; c < job->nrhs; c++)
+	{
+		const REAL* x = job->X + (size_t) c * job->ldx;
+		REAL* y = job->Y + (size_t) c * job->ldy;
+
+		if (!job->transpose || kind == SparseSymmetric)
+		{
+			for (int j = 0; j < s->columnCount; j++)
+			{
+				const long end = s->columnStarts[j + 1];
+				const long begin = (I0 > 0) ? lower_bound(s->rowIndices, s->columnStarts[j], end, I0) : s->columnStarts[j];
+				const REAL xj = alpha * x[j];
+
+				for (long p = begin; p < end && s->rowIndices[p] < I1; p++)
+				{
+					const int i = s->rowIndices[p];
+
+					if (kind != SparseOrdinary && ((lower ? i < j : i > j) || (kind == SparseUnitTriangular && i == j)))
+						continue;
+					y[i] += data[p] * xj;
+				}
+			}
+		}
+
+		if (job->transpose || kind == SparseSymmetric)
+		{
+			for (int j = I0; j < I1; j++)
+			{
+				REAL sum = 0;
+
+				for (long p = s->columnStarts[j]; p < s->columnStarts[j + 1]; p++)
+				{
+					const int i = s->rowIndices[p];
+
+					if (kind != SparseOrdinary && ((lower ? i < j : i > j) || (skip_diagonal && i == j)))
+						continue;
+					sum += data[p] * x[i];
+				}
+				y[j] += alpha * sum;
+			}
+		}
+
+		if (kind == SparseUnitTriangular)
+		{
+			for (int i = I0; i < I1; i++)
+				y[i] += alpha * x[i];
+		}
+	}
+}
+
+// Output rows [first, last) of op(A) X. The entries whose row is in the range are found in
+// each column by binary search, the ones of the transpose are the columns of the range.
+static void PFX(spmv_task)(void* ctx, size_t task)
+{
+	const struct PFX(spmv_job)* job = (const struct PFX(spmv_job)*) ctx;
+	const SparseMatrixStructure* s = &job->A->structure;
+	const REAL* data = job->A->data;
+	const int b = s->blockSize;
+	const long size = (long) b * b;
+	const SparseKind_t kind = s->attributes.kind;
+	const bool lower = s->attributes.triangle == SparseLowerTriangle;
+	const int I0 = (int) ((size_t) job->block_rows * task / job->tasks);
+	const int I1 = (int) ((size_t) job->block_rows * (task + 1) / job->tasks);
+	const REAL alpha = job->alpha;
+
+	if (!job->accumulate)
+	{
+		for (int c = 0; c < job->nrhs; c++)
+			memset(job->Y + (size_t) c * job->ldy + (size_t) I0 * b, 0, (size_t) (I1 - I0) * b * sizeof(REAL));
+	}
+
+	if (b == 1)
+	{
+		PFX(spmv_values)(job, I0, I1);
+		return;
+	}
+
+	// entries whose row gives the output row: A's own for A X, and the stored triangle of a
+	// symmetric matrix either way
+	if (!job->transpose || kind == SparseSymmetric)
+	{
+		for (int J = 0; J < s->columnCount; J++)
+		{
+			const long end = s->columnStarts[J + 1];
+			for (long p = lower_bound(s->rowIndices, s->columnStarts[J], end, I0); p < end && s->rowIndices[p] < I1; p++)
+			{
+				const int I = s->rowIndices[p];
+				const REAL* block = data + p * size;
+
+				for (int bj = 0; bj < b; bj++)
+				{
+					for (int bi = 0; bi < b; bi++)
+					{
+						const int i = I * b + bi, j = J * b + bj;
+
+						if (kind != SparseOrdinary && (lower ? i < j : i > j))
+							continue;
+						if (kind == SparseUnitTriangular && i == j)
+							continue;
+						PFX(spmv_add)(job, i, j, alpha * block[bi + bj * b]);
+					}
+				}
+			}
+		}
+	}
+
+	// entries whose column gives the output row: A^T's, and the mirrored triangle
+	if (job->transpose || kind == SparseSymmetric)
+	{
+		for (int J = I0; J < I1; J++)
+		{
+			for (long p = s->columnStarts[J]; p < s->columnStarts[J + 1]; p++)
+			{
+				const int I = s->rowIndices[p];
+				const REAL* block = data + p * size;
+
+				for (int bj = 0; bj < b; bj++)
+				{
+					for (int bi = 0; bi < b; bi++)
+					{
+						const int i = I * b + bi, j = J * b + bj;
+
+						if (kind != SparseOrdinary && (lower ? i < j : i > j))
+							continue;
+						if (i == j && (kind == SparseSymmetric || kind == SparseUnitTriangular))
+							continue;
+						PFX(spmv_add)(job, j, i, alpha * block[bi + bj * b]);
+					}
+				}
+			}
+		}
+	}
+
+	if (kind == SparseUnitTriangular)
+	{
+		for (int i = I0 * b; i < I1 * b; i++)
+			PFX(spmv_add)(job, i, i, alpha);
+	}
+}
+
+void F(_SparseSpMV)(REAL __alpha, SPARSE_MATRIX __A, DENSE_MATRIX __X, bool __accumulate, DENSE_MATRIX __Y)
+{
+	const SparseMatrixStructure* s = &__A.structure;
+	const bool transpose = s->attributes.transpose && s->attributes.kind != SparseSymmetric;
+	const int b = s->blockSize;
+	const int rows = (transpose ? s->columnCount : s->rowCount) * b;
+	const int columns = (transpose ? s->rowCount : s->columnCount) * b;
+
+	if (__X.rowCount != columns || __Y.rowCount != rows || __X.columnCount != __Y.columnCount
+		|| __X.columnStride < __X.rowCount || __Y.columnStride < __Y.rowCount)
+	{
+		sparse_error(NULL, "can't multiply a %d x %d matrix by %d x %d into %d x %d", rows, columns, __X.rowCount, __X.columnCount, __Y.rowCount, __Y.columnCount);
+		return;
+	}
+	if (__Y.columnCount == 0 || rows == 0)
+		return;
+
+	struct PFX(spmv_job) job = {
+		.alpha = __alpha,
+		.A = &__A,
+		.transpose = transpose,
+		.accumulate = __accumulate,
+		.rows = rows,
+		.block_rows = rows / b,
+		.X = __X.data,
+		.ldx = __X.columnStride,
+		.Y = __Y.data,
+		.ldy = __Y.columnStride,
+		.nrhs = __Y.columnCount,
+	};
+
+	const size_t work = (size_t) s->columnStarts[s->columnCount] * (size_t) b * b * (size_t) job.nrhs;
+	job.tasks = sparse_task_count(work);
+	if (job.tasks > (size_t) job.block_rows)
+		job.tasks = (size_t) job.block_rows;
+
+	sparse_parallel_for(job.tasks, &job, PFX(spmv_task));
+}
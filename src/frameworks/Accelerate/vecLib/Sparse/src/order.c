@@ -0,0 +1,499 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Approximate minimum degree (Amestoy, Davis and Duff) on the quotient graph. An eliminated
+// variable becomes an element, the clique of the variables it was connected to; variables
+// keep the elements they belong to and the variables they are still directly connected to.
+// Degrees are AMD's approximate external degrees, indistinguishable variables are merged
+// into supervariables, and elements contained in a new element are absorbed by it. Rows
+// that are much denser than the rest are left out and ordered last.
+
+struct index_list
+{
+	int* data;
+	int size;
+	int capacity;
+};
+
+enum
+{
+	amd_variable,
+	amd_element,
+	amd_dead,
+	amd_dense,
+};
+
+struct amd
+{
+	int n;
+	// variables adjacent to a variable, or the variables of an element
+	struct index_list* vars;
+	// elements adjacent to a variable
+	struct index_list* elems;
+	unsigned char* status;
+	// supervariable sizes, 0 once merged into another, and element sizes in variables
+	int* nv;
+	int* esize;
+	int* degree;
+
+	// doubly linked lists of the variables of each degree
+	int* head;
+	int* next;
+	int* prev;
+	int min_degree;
+
+	int* mark;
+	int stamp;
+	// |L_e \ L_p| of the elements next to the new element, valid when wmark[e] == step
+	int* w;
+	int* wmark;
+
+	// the variables merged into a supervariable, in a list starting at the supervariable
+	int* member_next;
+	int* member_last;
+
+	unsigned int* hash;
+	int* hash_head;
+	int* hash_next;
+};
+
+static bool list_push(struct index_list* list, int value)
+{
+	if (list->size == list->capacity)
+	{
+		const int capacity = list->capacity ? 2 * list->capacity : 4;
+		int* data = (int*) realloc(list->data, (size_t) capacity * sizeof(int));
+		if (!data)
+			return false;
+		list->data = data;
+		list->capacity = capacity;
+	}
+
+	list->data[list->size++] = value;
+	return true;
+}
+
+static void list_free(struct index_list* list)
+{
+	free(list->data);
+	list->data = NULL;
+	list->size = list->capacity = 0;
+}
+
+static int next_stamp(struct amd* a)
+{
+	if (a->stamp == 0x7fffffff)
+	{
+		memset(a->mark, 0, (size_t) a->n * sizeof(int));
+		a->stamp = 0;
+	}
+	return ++a->stamp;
+}
+
+static void degree_insert(struct amd* a, int i)
+{
+	const int d = a->degree[i];
+
+	a->prev[i] = -1;
+	a->next[i] = a->head[d];
+	if (a->head[d] >= 0)
+		a->prev[a->head[d]] = i;
+	a->head[d] = i;
+	if (d < a->min_degree)
+		a->min_degree = d;
+}
+
+static void degree_remove(struct amd* a, int i)
+{
+	if (a->prev[i] >= 0)
+		a->next[a->prev[i]] = a->next[i];
+	else
+		a->head[a->degree[i]] = a->next[i];
+	if (a->next[i] >= 0)
+		a->prev[a->next[i]] = a->prev[i];
+}
+
+static inline bool live_variable(const struct amd* a, int i)
+{
+	return a->status[i] == amd_variable && a->nv[i] > 0;
+}
+
+static void amd_free(struct amd* a)
+{
+	if (a->vars)
+	{
+		for (int i = 0; i < a->n; i++)
+			list_free(&a->vars[i]);
+	}
+	if (a->elems)
+	{
+		for (int i = 0; i < a->n; i++)
+			list_free(&a->elems[i]);
+	}
+
+	free(a->vars);
+	free(a->elems);
+	free(a->status);
+	free(a->nv);
+	free(a->esize);
+	free(a->degree);
+	free(a->head);
+	free(a->next);
+	free(a->prev);
+	free(a->mark);
+	free(a->w);
+	free(a->wmark);
+	free(a->member_next);
+	free(a->member_last);
+	free(a->hash);
+	free(a->hash_head);
+	free(a->hash_next);
+}
+
+static bool amd_init(struct amd* a, int n, const long* starts, const int* indices)
+{
+	const size_t count = n ? (size_t) n : 1;
+
+	memset(a, 0, sizeof(*a));
+	a->n = n;
+	a->vars = (struct index_list*) calloc(count, sizeof(struct index_list));
+	a->elems = (struct index_list*) calloc(count, sizeof(struct index_list));
+	a->status = (unsigned char*) calloc(count, 1);
+	a->nv = (int*) malloc(count * sizeof(int));
+	a->esize = (int*) calloc(count, sizeof(int));
+	a->degree = (int*) malloc(count * sizeof(int));
+	a->head = (int*) malloc(count * sizeof(int));
+	a->next = (int*) malloc(count * sizeof(int));
+	a->prev = (int*) malloc(count * sizeof(int));
+	a->mark = (int*) calloc(count, sizeof(int));
+	a->w = (int*) malloc(count * sizeof(int));
+	a->wmark = (int*) malloc(count * sizeof(int));
+	a->member_next = (int*) malloc(count * sizeof(int));
+	a->member_last = (int*) malloc(count * sizeof(int));
+	a->hash = (unsigned int*) malloc(count * sizeof(unsigned int));
+	a->hash_head = (int*) malloc(count * sizeof(int));
+	a->hash_next = (int*) malloc(count * sizeof(int));
+
+	if (!a->vars || !a->elems || !a->status || !a->nv || !a->esize || !a->degree || !a->head || !a->next || !a->prev
+		|| !a->mark || !a->w || !a->wmark || !a->member_next || !a->member_last || !a->hash || !a->hash_head || !a->hash_next)
+		return false;
+
+	for (int i = 0; i < n; i++)
+	{
+		a->nv[i] = 1;
+		a->head[i] = -1;
+		a->wmark[i] = -1;
+		a->hash_head[i] = -1;
+		a->member_next[i] = -1;
+		a->member_last[i] = i;
+	}
+
+	// the adjacency without duplicates and the diagonal, the pattern may have only one of
+	// (i, j) and (j, i)
+	for (int j = 0; j < n; j++)
+	{
+		for (long p = starts[j]; p < starts[j + 1]; p++)
+		{
+			const int i = indices[p];
+			if (i == j)
+				continue;
+			if (!list_push(&a->vars[j], i) || !list_push(&a->vars[i], j))
+				return false;
+		}
+	}
+
+	for (int j = 0; j < n; j++)
+	{
+		struct index_list* list = &a->vars[j];
+		const int stamp = next_stamp(a);
+		int kept = 0;
+
+		a->mark[j] = stamp;
+		for (int k = 0; k < list->size; k++)
+		{
+			if (a->mark[list->data[k]] != stamp)
+			{
+				a->mark[list->data[k]] = stamp;
+				list->data[kept++] = list->data[k];
+			}
+		}
+		list->size = kept;
+	}
+
+	const int dense = (int) fmax(16, 10 * sqrt((double) n));
+	for (int i = 0; i < n; i++)
+	{
+		if (a->vars[i].size > dense && a->vars[i].size > n / 2)
+			a->status[i] = amd_dense;
+	}
+
+	a->min_degree = n;
+	for (int i = 0; i < n; i++)
+	{
+		if (a->status[i] == amd_dense)
+		{
+			list_free(&a->vars[i]);
+			continue;
+		}
+
+		struct index_list* list = &a->vars[i];
+		int kept = 0;
+		for (int k = 0; k < list->size; k++)
+		{
+			if (a->status[list->data[k]] != amd_dense)
+				list->data[kept++] = list->data[k];
+		}
+		list->size = kept;
+		a->degree[i] = kept;
+		degree_insert(a, i);
+	}
+
+	return true;
+}
+
+// Eliminates variable p, which becomes an element
+static bool amd_eliminate(struct amd* a, int p, int* eliminated, int step)
+{
+	const int lp_stamp = next_stamp(a);
+	struct index_list lp = { NULL, 0, 0 };
+	int degme = 0;
+
+	a->status[p] = amd_element;
+	*eliminated += a->nv[p];
+	a->mark[p] = lp_stamp;
+
+	// L_p is the union of the elements next to p, which it absorbs, and p's variables
+	for (int k = 0; k < a->elems[p].size; k++)
+	{
+		const int e = a->elems[p].data[k];
+		if (a->status[e] != amd_element)
+			continue;
+
+		for (int q = 0; q < a->vars[e].size; q++)
+		{
+			const int i = a->vars[e].data[q];
+			if (live_variable(a, i) && a->mark[i] != lp_stamp)
+			{
+				a->mark[i] = lp_stamp;
+				if (!list_push(&lp, i))
+					return false;
+			}
+		}
+
+		a->status[e] = amd_dead;
+		list_free(&a->vars[e]);
+	}
+	for (int q = 0; q < a->vars[p].size; q++)
+	{
+		const int i = a->vars[p].data[q];
+		if (live_variable(a, i) && a->mark[i] != lp_stamp)
+		{
+			a->mark[i] = lp_stamp;
+			if (!list_push(&lp, i))
+				return false;
+		}
+	}
+
+	list_free(&a->elems[p]);
+	list_free(&a->vars[p]);
+	a->vars[p] = lp;
+
+	for (int q = 0; q < lp.size; q++)
+	{
+		degme += a->nv[lp.data[q]];
+		degree_remove(a, lp.data[q]);
+	}
+	a->esize[p] = degme;
+
+	// |L_e \ L_p| for the other elements of the variables in L_p
+	for (int q = 0; q < lp.size; q++)
+	{
+		const int i = lp.data[q];
+		for (int k = 0; k < a->elems[i].size; k++)
+		{
+			const int e = a->elems[i].data[k];
+			if (a->status[e] != amd_element)
+				continue;
+			if (a->wmark[e] != step)
+			{
+				a->wmark[e] = step;
+				a->w[e] = a->esize[e];
+			}
+			a->w[e] -= a->nv[i];
+		}
+	}
+
+	// approximate degrees, pruning what p now covers
+	for (int q = 0; q < lp.size; q++)
+	{
+		const int i = lp.data[q];
+		struct index_list* elems = &a->elems[i];
+		struct index_list* vars = &a->vars[i];
+		unsigned int hash = (unsigned int) p;
+		int degree = 0, kept = 0;
+
+		for (int k = 0; k < elems->size; k++)
+		{
+			const int e = elems->data[k];
+			if (a->status[e] != amd_element)
+				continue;
+			if (a->w[e] == 0)
+			{
+				// contained in L_p
+				a->status[e] = amd_dead;
+				list_free(&a->vars[e]);
+				continue;
+			}
+			degree += a->w[e];
+			hash += (unsigned int) e;
+			elems->data[kept++] = e;
+		}
+		elems->size = kept;
+		if (!list_push(elems, p))
+			return false;
+
+		kept = 0;
+		for (int k = 0; k < vars->size; k++)
+		{
+			const int j = vars->data[k];
+			if (!live_variable(a, j) || a->mark[j] == lp_stamp)
+				continue;
+			degree += a->nv[j];
+			hash += (unsigned int) j;
+			vars->data[kept++] = j;
+		}
+		vars->size = kept;
+
+		degree += degme - a->nv[i];
+		if (degree > a->degree[i] + degme - a->nv[i])
+			degree = a->degree[i] + degme - a->nv[i];
+		if (degree > a->n - *eliminated - a->nv[i])
+			degree = a->n - *eliminated - a->nv[i];
+		a->degree[i] = (degree > 0) ? degree : 0;
+		a->hash[i] = hash;
+	}
+
+	// supervariables: variables of L_p with the same elements and variables
+	for (int q = 0; q < lp.size; q++)
+	{
+		const int i = lp.data[q];
+		const int bucket = (int) (a->hash[i] % (unsigned int) a->n);
+		a->hash_next[i] = a->hash_head[bucket];
+		a->hash_head[bucket] = i;
+	}
+	for (int q = 0; q < lp.size; q++)
+	{
+		const int bucket = (int) (a->hash[lp.data[q]] % (unsigned int) a->n);
+
+		for (int i = a->hash_head[bucket]; i >= 0; i = a->hash_next[i])
+		{
+			if (a->nv[i] == 0 || a->hash_next[i] < 0)
+				continue;
+
+			const int stamp = next_stamp(a);
+			for (int k = 0; k < a->elems[i].size; k++)
+				a->mark[a->elems[i].data[k]] = stamp;
+			for (int k = 0; k < a->vars[i].size; k++)
+				a->mark[a->vars[i].data[k]] = stamp;
+
+			for (int j = a->hash_next[i]; j >= 0; j = a->hash_next[j])
+			{
+				if (a->nv[j] == 0 || a->hash[j] != a->hash[i] || a->elems[j].size != a->elems[i].size || a->vars[j].size != a->vars[i].size)
+					continue;
+
+				bool same = true;
+				for (int k = 0; same && k < a->elems[j].size; k++)
+					same = a->mark[a->elems[j].data[k]] == stamp;
+				for (int k = 0; same && k < a->vars[j].size; k++)
+					same = a->mark[a->vars[j].data[k]] == stamp;
+				if (!same)
+					continue;
+
+				a->nv[i] += a->nv[j];
+				a->degree[i] -= a->nv[j];
+				a->nv[j] = 0;
+				a->status[j] = amd_dead;
+				list_free(&a->elems[j]);
+				list_free(&a->vars[j]);
+				a->member_next[a->member_last[i]] = j;
+				a->member_last[i] = a->member_last[j];
+			}
+		}
+		a->hash_head[bucket] = -1;
+	}
+
+	for (int q = 0; q < lp.size; q++)
+	{
+		const int i = lp.data[q];
+		if (a->nv[i] > 0)
+		{
+			if (a->degree[i] < 0)
+				a->degree[i] = 0;
+			degree_insert(a, i);
+		}
+	}
+
+	return true;
+}
+
+bool sparse_order_amd(int n, const long* starts, const int* indices, int* perm)
+{
+	struct amd a;
+	int eliminated = 0, dense = 0, k = 0;
+	bool ok = amd_init(&a, n, starts, indices);
+
+	for (int i = 0; ok && i < n; i++)
+	{
+		if (a.status[i] == amd_dense)
+			dense++;
+	}
+
+	for (int step = 0; ok && eliminated < n - dense; step++)
+	{
+		while (a.min_degree < n && a.head[a.min_degree] < 0)
+			a.min_degree++;
+		if (a.min_degree >= n)
+		{
+			ok = false;
+			break;
+		}
+
+		const int p = a.head[a.min_degree];
+		degree_remove(&a, p);
+
+		for (int i = p; i >= 0; i = a.member_next[i])
+			perm[k++] = i;
+
+		ok = amd_eliminate(&a, p, &eliminated, step);
+	}
+
+	for (int i = 0; ok && i < n; i++)
+	{
+		if (a.status[i] == amd_dense)
+			perm[k++] = i;
+	}
+
+	amd_free(&a);
+	return ok && k == n;
+}
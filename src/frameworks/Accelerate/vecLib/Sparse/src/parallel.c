@@ -0,0 +1,63 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <dispatch/dispatch.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Below this many multiply-adds per task, splitting work costs more than it saves
+#define SPARSE_TASK_WORK 32768
+
+size_t sparse_thread_count(void)
+{
+	static atomic_size_t count = 0;
+	size_t n = atomic_load_explicit(&count, memory_order_relaxed);
+
+	if (n == 0)
+	{
+		const char* env = getenv("VECLIB_MAXIMUM_THREADS");
+		long value = env ? strtol(env, NULL, 10) : 0;
+
+		if (value <= 0)
+			value = sysconf(_SC_NPROCESSORS_ONLN);
+		n = (value > 0) ? (size_t) value : 1;
+		atomic_store_explicit(&count, n, memory_order_relaxed);
+	}
+
+	return n;
+}
+
+void sparse_parallel_for(size_t tasks, void* ctx, void (*fn)(void* ctx, size_t task))
+{
+	if (tasks > 1)
+		dispatch_apply_f(tasks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ctx, fn);
+	else if (tasks == 1)
+		fn(ctx, 0);
+}
+
+size_t sparse_task_count(size_t work)
+{
+	const size_t threads = sparse_thread_count();
+	const size_t tasks = work / SPARSE_TASK_WORK;
+
+	if (tasks <= 1)
+		return 1;
+	return (tasks < threads) ? tasks : threads;
+}
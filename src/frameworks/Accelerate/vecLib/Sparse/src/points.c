@@ -0,0 +1,232 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+void sparse_points_free(struct sparse_points* points)
+{
+	free(points->starts);
+	free(points->indices);
+	free(points->source);
+	memset(points, 0, sizeof(*points));
+}
+
+bool sparse_points_build(const SparseMatrixStructure* structure, bool transpose, struct sparse_points* points)
+{
+	const long b = structure->blockSize ? structure->blockSize : 1;
+	const SparseKind_t kind = structure->attributes.kind;
+	const bool lower = structure->attributes.triangle == SparseLowerTriangle;
+	const int rows = (int) (structure->rowCount * b);
+	const int columns = (int) (structure->columnCount * b);
+
+	transpose = transpose != structure->attributes.transpose;
+
+	memset(points, 0, sizeof(*points));
+	points->rows = transpose ? columns : rows;
+	points->columns = transpose ? rows : columns;
+	points->starts = (long*) calloc((size_t) points->columns + 1, sizeof(long));
+	if (!points->starts)
+		return false;
+
+	// counts the entries of each column on the first pass and places them on the second
+	long* next = NULL;
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int J = 0; J < structure->columnCount; J++)
+		{
+			for (long p = structure->columnStarts[J]; p < structure->columnStarts[J + 1]; p++)
+			{
+				const long I = structure->rowIndices[p];
+
+				for (long bj = 0; bj < b; bj++)
+				{
+					for (long bi = 0; bi < b; bi++)
+					{
+						const int i = (int) (I * b + bi), j = (int) (J * b + bj);
+						const long src = p * b * b + bi + bj * b;
+
+						if (kind != SparseOrdinary && (lower ? i < j : i > j))
+							continue;
+						if (kind == SparseUnitTriangular && i == j)
+							continue;
+
+						for (int mirror = 0; mirror < ((kind == SparseSymmetric && i != j) ? 2 : 1); mirror++)
+						{
+							const int r = (mirror != transpose) ? j : i;
+							const int c = (mirror != transpose) ? i : j;
+
+							if (pass == 0)
+								points->starts[c + 1]++;
+							else
+							{
+								points->indices[next[c]] = r;
+								points->source[next[c]++] = src;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (kind == SparseUnitTriangular)
+		{
+			const int diagonal = (rows < columns) ? rows : columns;
+			for (int i = 0; i < diagonal; i++)
+			{
+				if (pass == 0)
+					points->starts[i + 1]++;
+				else
+				{
+					points->indices[next[i]] = i;
+					points->source[next[i]++] = -1;
+				}
+			}
+		}
+
+		if (pass == 0)
+		{
+			for (int j = 0; j < points->columns; j++)
+				points->starts[j + 1] += points->starts[j];
+
+			const size_t nnz = (size_t) points->starts[points->columns];
+			points->indices = (int*) malloc((nnz ? nnz : 1) * sizeof(int));
+			points->source = (long*) malloc((nnz ? nnz : 1) * sizeof(long));
+			next = (long*) malloc(((size_t) points->columns + 1) * sizeof(long));
+			if (!points->indices || !points->source || !next)
+			{
+				free(next);
+				sparse_points_free(points);
+				return false;
+			}
+			memcpy(next, points->starts, (size_t) points->columns * sizeof(long));
+		}
+	}
+
+	free(next);
+	return true;
+}
+
+bool sparse_points_rows(const struct sparse_points* A, long** row_starts, int** row_columns, long** row_entries)
+{
+	const size_t nnz = (size_t) A->starts[A->columns];
+	long* starts = (long*) calloc((size_t) A->rows + 1, sizeof(long));
+	int* columns = (int*) malloc((nnz ? nnz : 1) * sizeof(int));
+	long* entries = (long*) malloc((nnz ? nnz : 1) * sizeof(long));
+	long* next = (long*) malloc(((size_t) A->rows + 1) * sizeof(long));
+
+	if (!starts || !columns || !entries || !next)
+	{
+		free(starts);
+		free(columns);
+		free(entries);
+		free(next);
+		return false;
+	}
+
+	for (size_t p = 0; p < nnz; p++)
+		starts[A->indices[p] + 1]++;
+	for (int i = 0; i < A->rows; i++)
+		starts[i + 1] += starts[i];
+	memcpy(next, starts, (size_t) A->rows * sizeof(long));
+
+	for (int j = 0; j < A->columns; j++)
+	{
+		for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+		{
+			const long q = next[A->indices[p]]++;
+			columns[q] = j;
+			entries[q] = p;
+		}
+	}
+
+	free(next);
+	*row_starts = starts;
+	*row_columns = columns;
+	*row_entries = entries;
+	return true;
+}
+
+// Appends to an array that doubles its capacity as it fills
+static bool push_index(int** array, size_t* count, size_t* capacity, int value)
+{
+	if (*count == *capacity)
+	{
+		int* bigger = (int*) realloc(*array, 2 * *capacity * sizeof(int));
+		if (!bigger)
+			return false;
+		*array = bigger;
+		*capacity *= 2;
+	}
+
+	(*array)[(*count)++] = value;
+	return true;
+}
+
+bool sparse_points_ata(const struct sparse_points* A, const long* row_starts, const int* row_columns, long** starts, int** indices)
+{
+	const int n = A->columns;
+	long* s = (long*) malloc(((size_t) n + 1) * sizeof(long));
+	int* mark = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	size_t capacity = (size_t) A->starts[n] + (size_t) n + 1;
+	int* idx = (int*) malloc(capacity * sizeof(int));
+	size_t count = 0;
+
+	if (!s || !mark || !idx)
+		goto fail;
+
+	for (int j = 0; j < n; j++)
+		mark[j] = -1;
+
+	// column j of A^T A holds the columns of all the rows that column j of A touches
+	for (int j = 0; j < n; j++)
+	{
+		s[j] = (long) count;
+		mark[j] = j;
+		if (!push_index(&idx, &count, &capacity, j))
+			goto fail;
+
+		for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+		{
+			const int r = A->indices[p];
+			for (long q = row_starts[r]; q < row_starts[r + 1]; q++)
+			{
+				const int i = row_columns[q];
+				if (mark[i] == j)
+					continue;
+				mark[i] = j;
+				if (!push_index(&idx, &count, &capacity, i))
+					goto fail;
+			}
+		}
+	}
+	s[n] = (long) count;
+
+	free(mark);
+	*starts = s;
+	*indices = idx;
+	return true;
+
+fail:
+	free(s);
+	free(mark);
+	free(idx);
+	return false;
+}
@@ -0,0 +1,221 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Left-looking Householder QR, cs_qr() of CSparse: column k is reduced by the Householder
+// reflections of the columns of R's row pattern, which are found by walking the column
+// elimination tree up from the leftmost column of each row. The rows are in the order pinv of
+// the symbolic analysis, which makes the k-th one the pivotal row of the k-th reflection.
+
+// x = (I - beta v v^T) x for reflection k
+static void PFX(apply_householder)(const struct sparse_numeric* N, int k, REAL* x)
+{
+	const REAL* v = (const REAL*) N->v_values;
+	REAL tau = 0;
+
+	for (long p = N->v_starts[k]; p < N->v_starts[k + 1]; p++)
+		tau += v[p] * x[N->v_rows[p]];
+	tau *= ((const REAL*) N->beta)[k];
+	for (long p = N->v_starts[k]; p < N->v_starts[k + 1]; p++)
+		x[N->v_rows[p]] -= v[p] * tau;
+}
+
+// Turns x into v with v[0] = 1 such that (I - beta v v^T) x = s e1, returns s
+static REAL PFX(householder)(REAL* x, long count, REAL* beta)
+{
+	REAL sigma = 0, s;
+
+	for (long i = 1; i < count; i++)
+		sigma += x[i] * x[i];
+
+	if (sigma == 0)
+	{
+		s = ABS(x[0]);
+		*beta = (x[0] <= 0) ? 2 : 0;
+		x[0] = 1;
+	}
+	else
+	{
+		s = SQRT(x[0] * x[0] + sigma);
+		x[0] = (x[0] <= 0) ? (x[0] - s) : (-sigma / (x[0] + s));
+		*beta = -1 / (s * x[0]);
+	}
+	return s;
+}
+
+SparseStatus_t PFX(factor_qr)(const struct sparse_symbolic* S, struct sparse_numeric* N, const REAL* data, char* workspace)
+{
+	const struct sparse_points* A = &S->matrix;
+	const int n = S->n, m2 = S->m2;
+	struct sparse_layout layout = { workspace, 0 };
+	int* w = (int*) sparse_layout_take(&layout, ((size_t) m2 + (size_t) n) * sizeof(int));
+	int* stack = w + m2;
+	REAL* x = (REAL*) sparse_layout_take(&layout, (size_t) m2 * sizeof(REAL));
+	REAL* v = (REAL*) N->v_values;
+	REAL* r = (REAL*) N->r_values;
+	REAL* beta = (REAL*) N->beta;
+	long vnz = 0, rnz = 0;
+
+	for (int i = 0; i < m2; i++)
+	{
+		w[i] = -1;
+		x[i] = 0;
+	}
+
+	for (int k = 0; k < n; k++)
+	{
+		const int col = S->perm[k];
+		const long p1 = vnz;
+		int top = n;
+
+		N->r_starts[k] = rnz;
+		N->v_starts[k] = vnz;
+		w[k] = k;
+		N->v_rows[vnz++] = k;
+
+		for (long p = A->starts[col]; p < A->starts[col + 1]; p++)
+		{
+			int len = 0;
+
+			// the path from the row's leftmost column up to the columns already seen
+			for (int i = S->leftmost[A->indices[p]]; w[i] != k; i = S->parent[i])
+			{
+				stack[len++] = i;
+				w[i] = k;
+			}
+			while (len > 0)
+				stack[--top] = stack[--len];
+
+			const int i = S->pinv[A->indices[p]];
+			x[i] += (A->source[p] < 0) ? 1 : data[A->source[p]];
+			if (i > k && w[i] < k)
+			{
+				N->v_rows[vnz++] = i;
+				w[i] = k;
+			}
+		}
+
+		for (int p = top; p < n; p++)
+		{
+			const int i = stack[p];
+
+			PFX(apply_householder)(N, i, x);
+			N->r_rows[rnz] = i;
+			r[rnz++] = x[i];
+			x[i] = 0;
+
+			if (S->parent[i] == k)
+			{
+				for (long q = N->v_starts[i]; q < N->v_starts[i + 1]; q++)
+				{
+					const int j = N->v_rows[q];
+					if (w[j] < k)
+					{
+						w[j] = k;
+						N->v_rows[vnz++] = j;
+					}
+				}
+			}
+		}
+
+		for (long p = p1; p < vnz; p++)
+		{
+			v[p] = x[N->v_rows[p]];
+			x[N->v_rows[p]] = 0;
+		}
+		N->v_starts[k + 1] = vnz;
+
+		N->r_rows[rnz] = k;
+		r[rnz++] = PFX(householder)(v + p1, vnz - p1, beta + k);
+	}
+
+	N->r_starts[n] = rnz;
+	return SparseStatusOK;
+}
+
+void PFX(qr_apply_q)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, REAL* x)
+{
+	if (transpose)
+	{
+		for (int k = 0; k < S->n; k++)
+			PFX(apply_householder)(N, k, x);
+	}
+	else
+	{
+		for (int k = S->n - 1; k >= 0; k--)
+			PFX(apply_householder)(N, k, x);
+	}
+}
+
+// Unknowns with a zero on R's diagonal, of a rank deficient matrix, are set to 0
+void PFX(qr_solve_r)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, REAL* x)
+{
+	const REAL* r = (const REAL*) N->r_values;
+
+	if (transpose)
+	{
+		for (int j = 0; j < S->n; j++)
+		{
+			const long last = N->r_starts[j + 1] - 1;
+			REAL sum = x[j];
+
+			for (long p = N->r_starts[j]; p < last; p++)
+				sum -= r[p] * x[N->r_rows[p]];
+			x[j] = (r[last] != 0) ? sum / r[last] : 0;
+		}
+	}
+	else
+	{
+		for (int j = S->n - 1; j >= 0; j--)
+		{
+			const long last = N->r_starts[j + 1] - 1;
+			const REAL xj = (r[last] != 0) ? x[j] / r[last] : 0;
+
+			x[j] = xj;
+			for (long p = N->r_starts[j]; p < last; p++)
+				x[N->r_rows[p]] -= r[p] * xj;
+		}
+	}
+}
+
+void PFX(qr_multiply_r)(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, const REAL* x, REAL* y)
+{
+	const REAL* r = (const REAL*) N->r_values;
+
+	for (int j = 0; j < S->n; j++)
+	{
+		if (transpose)
+		{
+			REAL sum = 0;
+			for (long p = N->r_starts[j]; p < N->r_starts[j + 1]; p++)
+				sum += r[p] * x[N->r_rows[p]];
+			y[j] = sum;
+		}
+		else
+			y[j] = 0;
+	}
+
+	if (!transpose)
+	{
+		for (int j = 0; j < S->n; j++)
+		{
+			for (long p = N->r_starts[j]; p < N->r_starts[j + 1]; p++)
+				y[N->r_rows[p]] += r[p] * x[j];
+		}
+	}
+}
@@ -0,0 +1,111 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Includes SPARSE_TEMPLATE once for float and once for double, with:
+//   REAL                  the element type
+//   F(name)               the exported name, name_Float or name_Double
+//   PFX(name)             internal names
+//   SPARSE_MATRIX, DENSE_MATRIX, DENSE_VECTOR, FACTORIZATION, SUBFACTOR, PRECONDITIONER
+//                         the types of Sparse.h
+//   OPERATOR, VECTOR_OPERATOR
+//                         the operator blocks of Solve.h
+//   SB(name)              SparseBLAS' name_float or name_double
+//   BLAS(name)            cblas_sname or cblas_dname
+//   LAPACK(name)          sname_ or dname_
+//   IS_DOUBLE             whether REAL is double
+//   EPSILON, ABS(x), SQRT(x)
+
+#include <float.h>
+#include <math.h>
+
+#define REAL float
+#define F(name) name##_Float
+#define PFX(name) s##name
+#define SPARSE_MATRIX SparseMatrix_Float
+#define DENSE_MATRIX DenseMatrix_Float
+#define DENSE_VECTOR DenseVector_Float
+#define FACTORIZATION SparseOpaqueFactorization_Float
+#define SUBFACTOR SparseOpaqueSubfactor_Float
+#define PRECONDITIONER SparseOpaquePreconditioner_Float
+#define OPERATOR SparseOperator_Float
+#define VECTOR_OPERATOR SparseVectorOperator_Float
+#define SB(name) name##_float
+#define BLAS(name) cblas_s##name
+#define LAPACK(name) s##name##_
+#define IS_DOUBLE false
+#define EPSILON FLT_EPSILON
+#define ABS(x) fabsf(x)
+#define SQRT(x) sqrtf(x)
+#include SPARSE_TEMPLATE
+#undef REAL
+#undef F
+#undef PFX
+#undef SPARSE_MATRIX
+#undef DENSE_MATRIX
+#undef DENSE_VECTOR
+#undef FACTORIZATION
+#undef SUBFACTOR
+#undef PRECONDITIONER
+#undef OPERATOR
+#undef VECTOR_OPERATOR
+#undef SB
+#undef BLAS
+#undef LAPACK
+#undef IS_DOUBLE
+#undef EPSILON
+#undef ABS
+#undef SQRT
+
+#define REAL double
+#define F(name) name##_Double
+#define PFX(name) d##name
+#define SPARSE_MATRIX SparseMatrix_Double
+#define DENSE_MATRIX DenseMatrix_Double
+#define DENSE_VECTOR DenseVector_Double
+#define FACTORIZATION SparseOpaqueFactorization_Double
+#define SUBFACTOR SparseOpaqueSubfactor_Double
+#define PRECONDITIONER SparseOpaquePreconditioner_Double
+#define OPERATOR SparseOperator_Double
+#define VECTOR_OPERATOR SparseVectorOperator_Double
+#define SB(name) name##_double
+#define BLAS(name) cblas_d##name
+#define LAPACK(name) d##name##_
+#define IS_DOUBLE true
+#define EPSILON DBL_EPSILON
+#define ABS(x) fabs(x)
+#define SQRT(x) sqrt(x)
+#include SPARSE_TEMPLATE
+#undef REAL
+#undef F
+#undef PFX
+#undef SPARSE_MATRIX
+#undef DENSE_MATRIX
+#undef DENSE_VECTOR
+#undef FACTORIZATION
+#undef SUBFACTOR
+#undef PRECONDITIONER
+#undef OPERATOR
+#undef VECTOR_OPERATOR
+#undef SB
+#undef BLAS
+#undef LAPACK
+#undef IS_DOUBLE
+#undef EPSILON
+#undef ABS
+#undef SQRT
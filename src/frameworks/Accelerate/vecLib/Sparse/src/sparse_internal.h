@@ -0,0 +1,247 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARSE_INTERNAL_H_
+#define _SPARSE_INTERNAL_H_
+
+#include <Sparse/Sparse.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Symmetric matrices are factored as P^T A P = L D L^T by a left-looking supernodal method:
+// the columns of L are grouped into supernodes of columns with the same structure below the
+// diagonal, each stored as a dense column-major panel, so that the updates between them and
+// the solves are BLAS 3 calls. Supernodes in independent subtrees of the elimination tree are
+// factored concurrently, the ones near the root one after another with libBLAS' threads.
+// LDL^T pivots within a supernode's diagonal block only, so the structure found by the
+// symbolic analysis stays valid; pivots that are too small are perturbed and the solves
+// refine the solution against the original matrix.
+// QR is left-looking Householder on the columns, CholeskyAtA factors A^T A.
+
+// A matrix in compressed sparse columns of single entries, the value of entry e is
+// data[source[e]] of the client's matrix, or 1 if source[e] is negative (the implicit
+// diagonal of a unit triangular matrix)
+struct sparse_points
+{
+	int rows;
+	int columns;
+	long* starts;
+	int* indices;
+	long* source;
+};
+
+struct sparse_symbolic
+{
+	atomic_int refs;
+	SparseFactorization_t type;
+	SparseSymbolicFactorOptions options;
+
+	// the factored matrix is n x n, or m x n for QR and CholeskyAtA
+	int m;
+	int n;
+	// QR of A^T, for matrices with fewer rows than columns
+	bool transposed;
+	// values in the client's matrix
+	long values;
+
+	// fill-reducing ordering, column perm[k] of the matrix is the k-th to be eliminated
+	int* perm;
+	int* iperm;
+
+	// symmetric factorizations: the lower triangle of P^T A P (or P^T A^T A P) that the
+	// supernodes are assembled from
+	long* lower_starts;
+	int* lower_rows;
+	long* lower_source;
+
+	// supernode s holds columns super_first[s] to super_first[s + 1] - 1, its panel's rows are
+	// super_rows[super_row_starts[s]...], the first ones being its own columns, and its values
+	// start at super_value_starts[s] of the factor
+	int supernodes;
+	int* super_first;
+	long* super_row_starts;
+	int* super_rows;
+	long* super_value_starts;
+	int* column_super;
+	// the supernodes that update supernode s, in increasing order
+	long* update_starts;
+	int* updates;
+	int max_rows;
+	int max_columns;
+	size_t max_update;
+
+	// task t factors the subtrees [task_first[i], task_last[i]] for i in
+	// [task_starts[t], task_starts[t + 1]), the supernodes in `top` are factored afterwards
+	int tasks;
+	int* task_starts;
+	int* task_first;
+	int* task_last;
+	int top_count;
+	int* top;
+
+	// QR and CholeskyAtA: the (possibly transposed) matrix, with its rows for A^T A
+	struct sparse_points matrix;
+	long* row_starts;
+	int* row_columns;
+	long* row_entries;
+
+	// QR: the elimination tree of A^T A, the leftmost column of each row, the row
+	// permutation, and the sizes of the Householder vectors and R. m2 >= m counts the empty
+	// rows added for structurally rank-deficient matrices.
+	int* parent;
+	int* leftmost;
+	int* pinv;
+	int m2;
+	long v_count;
+	long r_count;
+
+	// numeric workspace per task, and what the numeric factor takes, for float and double
+	size_t workspace_size[2];
+	size_t factor_size[2];
+};
+
+struct sparse_numeric
+{
+	atomic_int refs;
+	struct sparse_symbolic* symbolic;
+	SparseNumericFactorOptions options;
+	bool is_double;
+	bool user_storage;
+
+	// symmetric: the supernode panels, and the lower triangle of the matrix
+	void* values;
+	void* lower_values;
+	// LDL^T: the diagonal and the subdiagonal of D, nonzero for the first column of a 2 x 2
+	// pivot, and the pivoting within supernodes, column k of L is column pivots[k] of P^T A P
+	void* diagonal;
+	void* subdiagonal;
+	int* pivots;
+	int perturbed;
+	// CholeskyAtA: the values of the matrix, in the order of symbolic->matrix
+	void* matrix_values;
+
+	// QR: Householder vectors and R in compressed columns, the last entry of each column of R
+	// is its diagonal
+	long* v_starts;
+	int* v_rows;
+	void* v_values;
+	void* beta;
+	long* r_starts;
+	int* r_rows;
+	void* r_values;
+};
+
+// Rounds a byte count up so that parts laid out after it stay aligned
+#define SPARSE_ALIGN(size) (((size) + 63) & ~(size_t) 63)
+
+static inline bool sparse_is_symmetric_type(SparseFactorization_t type)
+{
+	return type <= SparseFactorizationLDLTTPP;
+}
+
+static inline bool sparse_is_ldlt(SparseFactorization_t type)
+{
+	return type >= SparseFactorizationLDLT && type <= SparseFactorizationLDLTTPP;
+}
+
+// Lays out consecutive parts of a block of memory, each 64-byte aligned. With a NULL base,
+// it only adds up the size.
+struct sparse_layout
+{
+	char* base;
+	size_t size;
+};
+
+static inline void* sparse_layout_take(struct sparse_layout* layout, size_t bytes)
+{
+	void* part = layout->base ? layout->base + layout->size : NULL;
+	layout->size += SPARSE_ALIGN(bytes);
+	return part;
+}
+
+// parallel.c
+// The number of threads to split work across, from VECLIB_MAXIMUM_THREADS or the CPU count
+size_t sparse_thread_count(void);
+// Runs fn(ctx, task) for task in [0, tasks), concurrently if there's more than one
+void sparse_parallel_for(size_t tasks, void* ctx, void (*fn)(void* ctx, size_t task));
+// How many tasks to split `work` multiply-adds into
+size_t sparse_task_count(size_t work);
+
+// error.c
+// Passes the message to `report`, or prints it, and calls _SparseTrap()
+void sparse_error(void (*report)(const char* message), const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+// points.c
+// Expands a structure to single entries, of its transpose if `transpose` is set. Symmetric
+// matrices get both triangles, triangular ones only theirs. NULL without memory.
+bool sparse_points_build(const SparseMatrixStructure* structure, bool transpose, struct sparse_points* points);
+void sparse_points_free(struct sparse_points* points);
+// The pattern of A^T A, with its diagonal
+bool sparse_points_ata(const struct sparse_points* A, const long* row_starts, const int* row_columns, long** starts, int** indices);
+// The rows of A: row_columns[row_starts[i]...] are the columns of row i's entries and
+// row_entries the entries' index in A
+bool sparse_points_rows(const struct sparse_points* A, long** row_starts, int** row_columns, long** row_entries);
+
+// order.c
+// Approximate minimum degree ordering of a symmetric pattern given by both triangles,
+// duplicates and the diagonal are ignored
+bool sparse_order_amd(int n, const long* starts, const int* indices, int* perm);
+
+// symbolic.c
+void sparse_symbolic_release(struct sparse_symbolic* S);
+// Lays out a numeric factorization for the symbolic one at `base`, returns its size
+size_t sparse_numeric_layout(const struct sparse_symbolic* S, bool is_double, char* base);
+
+enum sparse_sweep
+{
+	// X = L^-1 X, X = L^-T X, X = L X, X = L^T X
+	sparse_solve_lower,
+	sparse_solve_upper,
+	sparse_multiply_lower,
+	sparse_multiply_upper,
+};
+
+// cholesky.c, on the n x nrhs matrix X in the permuted order, `work` takes max_rows * nrhs
+// values. L includes the pivoting within supernodes, like LAPACK's L of xSYTRF.
+SparseStatus_t sfactor_supernodal(const struct sparse_symbolic* S, struct sparse_numeric* N, const float* data, char* workspace);
+SparseStatus_t dfactor_supernodal(const struct sparse_symbolic* S, struct sparse_numeric* N, const double* data, char* workspace);
+void ssupernodal_sweep(const struct sparse_symbolic* S, const struct sparse_numeric* N, enum sparse_sweep sweep, float* X, int nrhs, int ld, float* work);
+void dsupernodal_sweep(const struct sparse_symbolic* S, const struct sparse_numeric* N, enum sparse_sweep sweep, double* X, int nrhs, int ld, double* work);
+// X = D^-1 X or X = D X
+void ssupernodal_diagonal(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool solve, float* X, int nrhs, int ld);
+void dsupernodal_diagonal(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool solve, double* X, int nrhs, int ld);
+// Y = B - P^T A P X with the lower triangle the factorization was assembled from
+void ssupernodal_residual(const struct sparse_symbolic* S, const struct sparse_numeric* N, const float* B, const float* X, float* Y, int nrhs, int ld);
+void dsupernodal_residual(const struct sparse_symbolic* S, const struct sparse_numeric* N, const double* B, const double* X, double* Y, int nrhs, int ld);
+
+// qr.c, x has m2 entries, R is n x n
+SparseStatus_t sfactor_qr(const struct sparse_symbolic* S, struct sparse_numeric* N, const float* data, char* workspace);
+SparseStatus_t dfactor_qr(const struct sparse_symbolic* S, struct sparse_numeric* N, const double* data, char* workspace);
+// x = Q^T x if transpose, otherwise x = Q x, in the row order of the factorization
+void sqr_apply_q(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, float* x);
+void dqr_apply_q(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, double* x);
+// x = R^-1 x or x = R^-T x
+void sqr_solve_r(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, float* x);
+void dqr_solve_r(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, double* x);
+// y = R x or y = R^T x
+void sqr_multiply_r(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, const float* x, float* y);
+void dqr_multiply_r(const struct sparse_symbolic* S, const struct sparse_numeric* N, bool transpose, const double* x, double* y);
+
+#endif
@@ -0,0 +1,1182 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparse_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void* default_malloc(size_t size)
+{
+	return malloc(size);
+}
+
+static void default_free(void* pointer)
+{
+	free(pointer);
+}
+
+void sparse_symbolic_release(struct sparse_symbolic* S)
+{
+	if (!S || atomic_fetch_sub(&S->refs, 1) != 1)
+		return;
+
+	free(S->perm);
+	free(S->iperm);
+	free(S->lower_starts);
+	free(S->lower_rows);
+	free(S->lower_source);
+	free(S->super_first);
+	free(S->super_row_starts);
+	free(S->super_rows);
+	free(S->super_value_starts);
+	free(S->column_super);
+	free(S->update_starts);
+	free(S->updates);
+	free(S->task_starts);
+	free(S->task_first);
+	free(S->task_last);
+	free(S->top);
+	sparse_points_free(&S->matrix);
+	free(S->row_starts);
+	free(S->row_columns);
+	free(S->row_entries);
+	free(S->parent);
+	free(S->leftmost);
+	free(S->pinv);
+	free(S);
+}
+
+static int compare_ints(const void* a, const void* b)
+{
+	const int x = *(const int*) a, y = *(const int*) b;
+	return (x > y) - (x < y);
+}
+
+// The ordering the client asked for, or AMD's
+static bool find_ordering(struct sparse_symbolic* S, int n, const long* starts, const int* indices)
+{
+	S->perm = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	S->iperm = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	if (!S->perm || !S->iperm)
+		return false;
+
+	if (S->options.orderMethod == SparseOrderUser && S->options.order)
+	{
+		for (int i = 0; i < n; i++)
+			S->iperm[i] = -1;
+		for (int k = 0; k < n; k++)
+		{
+			const int j = S->options.order[k];
+			if (j < 0 || j >= n || S->iperm[j] >= 0)
+			{
+				sparse_error(S->options.reportError, "options.order isn't a permutation of the %d columns", n);
+				return false;
+			}
+			S->perm[k] = j;
+			S->iperm[j] = k;
+		}
+		return true;
+	}
+
+	// Metis and COLAMD aren't available, A^T A is ordered like a symmetric matrix
+	if (!sparse_order_amd(n, starts, indices, S->perm))
+		return false;
+	for (int k = 0; k < n; k++)
+		S->iperm[S->perm[k]] = k;
+	return true;
+}
+
+// The strictly upper triangle of P^T A P by columns, with A given by both triangles
+static bool permuted_upper(const int* iperm, int n, const long* starts, const int* indices, long** ustarts, int** urows)
+{
+	long* us = (long*) calloc((size_t) n + 1, sizeof(long));
+	int* ur = NULL;
+
+	if (!us)
+		return false;
+
+	for (int j = 0; j < n; j++)
+	{
+		for (long p = starts[j]; p < starts[j + 1]; p++)
+		{
+			if (iperm[indices[p]] < iperm[j])
+				us[iperm[j] + 1]++;
+		}
+	}
+	for (int j = 0; j < n; j++)
+		us[j + 1] += us[j];
+
+	ur = (int*) malloc(((size_t) us[n] + 1) * sizeof(int));
+	long* next = (long*) malloc(((size_t) n + 1) * sizeof(long));
+	if (!ur || !next)
+	{
+		free(us);
+		free(ur);
+		free(next);
+		return false;
+	}
+	memcpy(next, us, (size_t) n * sizeof(long));
+
+	for (int j = 0; j < n; j++)
+	{
+		for (long p = starts[j]; p < starts[j + 1]; p++)
+		{
+			const int i = iperm[indices[p]];
+			if (i < iperm[j])
+				ur[next[iperm[j]]++] = i;
+		}
+	}
+
+	free(next);
+	*ustarts = us;
+	*urows = ur;
+	return true;
+}
+
+// Liu's algorithm with path compression
+static void elimination_tree(int n, const long* ustarts, const int* urows, int* parent, int* ancestor)
+{
+	for (int k = 0; k < n; k++)
+	{
+		parent[k] = -1;
+		ancestor[k] = -1;
+
+		for (long p = ustarts[k]; p < ustarts[k + 1]; p++)
+		{
+			int next;
+			for (int i = urows[p]; i != -1 && i < k; i = next)
+			{
+				next = ancestor[i];
+				ancestor[i] = k;
+				if (next == -1)
+					parent[i] = k;
+			}
+		}
+	}
+}
+
+// post[k] is the k-th node of a depth-first postorder of the forest
+static bool postorder(int n, const int* parent, int* post)
+{
+	int* head = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* next = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* stack = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int k = 0;
+
+	if (!head || !next || !stack)
+	{
+		free(head);
+		free(next);
+		free(stack);
+		return false;
+	}
+
+	for (int j = 0; j < n; j++)
+		head[j] = -1;
+	for (int j = n - 1; j >= 0; j--)
+	{
+		if (parent[j] >= 0)
+		{
+			next[j] = head[parent[j]];
+			head[parent[j]] = j;
+		}
+	}
+
+	for (int root = 0; root < n; root++)
+	{
+		if (parent[root] != -1)
+			continue;
+
+		int top = 0;
+		stack[0] = root;
+		while (top >= 0)
+		{
+			const int j = stack[top];
+			const int child = head[j];
+
+			if (child == -1)
+			{
+				top--;
+				post[k++] = j;
+			}
+			else
+			{
+				head[j] = next[child];
+				stack[++top] = child;
+			}
+		}
+	}
+
+	free(head);
+	free(next);
+	free(stack);
+	return true;
+}
+
+// Orders the tree postorder, so that subtrees are contiguous, and returns the elimination
+// tree and the upper triangle in the new order
+static bool ordered_tree(struct sparse_symbolic* S, int n, const long* starts, const int* indices, int* parent, long** ustarts, int** urows)
+{
+	int* work = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* post = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	bool ok = work && post && permuted_upper(S->iperm, n, starts, indices, ustarts, urows);
+
+	if (ok)
+	{
+		elimination_tree(n, *ustarts, *urows, parent, work);
+		ok = postorder(n, parent, post);
+	}
+
+	if (ok)
+	{
+		for (int k = 0; k < n; k++)
+			work[k] = S->perm[post[k]];
+		memcpy(S->perm, work, (size_t) n * sizeof(int));
+		for (int k = 0; k < n; k++)
+			S->iperm[S->perm[k]] = k;
+
+		free(*ustarts);
+		free(*urows);
+		*ustarts = NULL;
+		*urows = NULL;
+		ok = permuted_upper(S->iperm, n, starts, indices, ustarts, urows);
+		if (ok)
+			elimination_tree(n, *ustarts, *urows, parent, work);
+	}
+
+	free(work);
+	free(post);
+	return ok;
+}
+
+// The number of entries in each column of L, from the subtrees of the rows of L
+static bool column_counts(int n, const long* ustarts, const int* urows, const int* parent, int* counts)
+{
+	int* mark = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	if (!mark)
+		return false;
+
+	for (int j = 0; j < n; j++)
+	{
+		counts[j] = 1;
+		mark[j] = -1;
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		mark[i] = i;
+		for (long p = ustarts[i]; p < ustarts[i + 1]; p++)
+		{
+			for (int k = urows[p]; mark[k] != i; k = parent[k])
+			{
+				counts[k]++;
+				mark[k] = i;
+			}
+		}
+	}
+
+	free(mark);
+	return true;
+}
+
+static double trapezoid(double rows, double columns)
+{
+	return rows * columns - columns * (columns - 1) / 2;
+}
+
+// Fundamental supernodes, then each merged into its parent when that adds few zeros
+static bool find_supernodes(struct sparse_symbolic* S, int n, const int* parent, const int* counts)
+{
+	int* first = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* columns = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* rows = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	double* entries = (double*) malloc(((size_t) n + 1) * sizeof(double));
+	int* children = (int*) calloc((size_t) n + 1, sizeof(int));
+	int* owner = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	bool* merged = (bool*) calloc((size_t) n + 1, sizeof(bool));
+	int ns = 0;
+	bool ok = first && columns && rows && entries && children && owner && merged;
+
+	if (!ok)
+		goto out;
+
+	for (int j = 0; j < n; j++)
+	{
+		if (parent[j] >= 0)
+			children[parent[j]]++;
+	}
+
+	for (int j = 0; j < n; j++)
+	{
+		if (j > 0 && parent[j - 1] == j && counts[j - 1] == counts[j] + 1 && children[j] == 1)
+		{
+			columns[ns - 1]++;
+		}
+		else
+		{
+			first[ns] = j;
+			columns[ns] = 1;
+			rows[ns] = counts[j];
+			ns++;
+		}
+		owner[j] = ns - 1;
+	}
+	for (int s = 0; s < ns; s++)
+		entries[s] = trapezoid(rows[s], columns[s]);
+
+	// relaxed amalgamation of a supernode with its parent when it's the last child, which
+	// in postorder is the supernode just before it
+	for (int s = 0; s + 1 < ns; s++)
+	{
+		const int last = first[s] + columns[s] - 1;
+		if (parent[last] < 0 || owner[parent[last]] != s + 1)
+			continue;
+
+		const double c = columns[s] + columns[s + 1];
+		const double r = columns[s] + rows[s + 1];
+		const double zeros = trapezoid(r, c) - entries[s] - entries[s + 1];
+		const double fraction = zeros / trapezoid(r, c);
+
+		if (c <= 4 || (c <= 16 && fraction < 0.5) || (c <= 48 && fraction < 0.1) || fraction < 0.05)
+		{
+			first[s + 1] = first[s];
+			columns[s + 1] += columns[s];
+			rows[s + 1] += columns[s];
+			entries[s + 1] += entries[s];
+			merged[s] = true;
+		}
+	}
+
+	S->super_first = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	S->column_super = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	if (!S->super_first || !S->column_super)
+	{
+		ok = false;
+		goto out;
+	}
+
+	S->supernodes = 0;
+	for (int s = 0; s < ns; s++)
+	{
+		if (merged[s])
+			continue;
+		S->super_first[S->supernodes] = first[s];
+		for (int j = first[s]; j < first[s] + columns[s]; j++)
+			S->column_super[j] = S->supernodes;
+		S->supernodes++;
+	}
+	S->super_first[S->supernodes] = n;
+
+out:
+	free(first);
+	free(columns);
+	free(rows);
+	free(entries);
+	free(children);
+	free(owner);
+	free(merged);
+	return ok;
+}
+
+// The lower triangle of P^T A P, with the source of each value if there is one
+static bool permuted_lower(struct sparse_symbolic* S, int n, const long* starts, const int* indices, const long* source)
+{
+	const int* iperm = S->iperm;
+
+	S->lower_starts = (long*) calloc((size_t) n + 1, sizeof(long));
+	if (!S->lower_starts)
+		return false;
+
+	for (int j = 0; j < n; j++)
+	{
+		for (long p = starts[j]; p < starts[j + 1]; p++)
+		{
+			if (iperm[indices[p]] >= iperm[j])
+				S->lower_starts[iperm[j] + 1]++;
+		}
+	}
+	for (int j = 0; j < n; j++)
+		S->lower_starts[j + 1] += S->lower_starts[j];
+
+	const size_t nnz = (size_t) S->lower_starts[n];
+	long* next = (long*) malloc(((size_t) n + 1) * sizeof(long));
+	S->lower_rows = (int*) malloc((nnz + 1) * sizeof(int));
+	if (source)
+		S->lower_source = (long*) malloc((nnz + 1) * sizeof(long));
+	if (!next || !S->lower_rows || (source && !S->lower_source))
+	{
+		free(next);
+		return false;
+	}
+	memcpy(next, S->lower_starts, (size_t) n * sizeof(long));
+
+	for (int j = 0; j < n; j++)
+	{
+		for (long p = starts[j]; p < starts[j + 1]; p++)
+		{
+			const int i = iperm[indices[p]];
+			if (i < iperm[j])
+				continue;
+
+			const long q = next[iperm[j]]++;
+			S->lower_rows[q] = i;
+			if (source)
+				S->lower_source[q] = source[p];
+		}
+	}
+
+	free(next);
+	return true;
+}
+
+// The rows of each supernode: its columns, the rows of A below them and the rows of its
+// children below them
+static bool supernode_rows(struct sparse_symbolic* S, int n, const int* parent)
+{
+	const int ns = S->supernodes;
+	int* mark = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* head = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* next = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	size_t capacity = (size_t) S->lower_starts[n] + (size_t) n + 1, count = 0;
+	bool ok = false;
+
+	S->super_row_starts = (long*) malloc(((size_t) ns + 1) * sizeof(long));
+	S->super_value_starts = (long*) malloc(((size_t) ns + 1) * sizeof(long));
+	S->super_rows = (int*) malloc(capacity * sizeof(int));
+	if (!mark || !head || !next || !S->super_row_starts || !S->super_value_starts || !S->super_rows)
+		goto out;
+
+	for (int j = 0; j < n; j++)
+		mark[j] = -1;
+	for (int s = 0; s < ns; s++)
+		head[s] = -1;
+	for (int s = ns - 1; s >= 0; s--)
+	{
+		const int last = S->super_first[s + 1] - 1;
+		if (parent[last] >= 0)
+		{
+			const int p = S->column_super[parent[last]];
+			next[s] = head[p];
+			head[p] = s;
+		}
+	}
+
+	S->super_value_starts[0] = 0;
+	S->max_rows = 0;
+	S->max_columns = 0;
+
+	for (int s = 0; s < ns; s++)
+	{
+		const int f = S->super_first[s], l = S->super_first[s + 1] - 1;
+		size_t bound = (size_t) (l - f + 1) + (size_t) (S->lower_starts[l + 1] - S->lower_starts[f]);
+
+		S->super_row_starts[s] = (long) count;
+		for (int c = head[s]; c >= 0; c = next[c])
+			bound += (size_t) (S->super_row_starts[c + 1] - S->super_row_starts[c]);
+		if (count + bound > capacity)
+		{
+			capacity = 2 * (count + bound);
+			int* bigger = (int*) realloc(S->super_rows, capacity * sizeof(int));
+			if (!bigger)
+				goto out;
+			S->super_rows = bigger;
+		}
+
+		for (int j = f; j <= l; j++)
+		{
+			mark[j] = s;
+			S->super_rows[count++] = j;
+		}
+
+		for (int j = f; j <= l; j++)
+		{
+			for (long p = S->lower_starts[j]; p < S->lower_starts[j + 1]; p++)
+			{
+				const int i = S->lower_rows[p];
+				if (mark[i] != s)
+				{
+					mark[i] = s;
+					S->super_rows[count++] = i;
+				}
+			}
+		}
+		for (int c = head[s]; c >= 0; c = next[c])
+		{
+			for (long p = S->super_row_starts[c]; p < S->super_row_starts[c + 1]; p++)
+			{
+				const int i = S->super_rows[p];
+				if (i > l && mark[i] != s)
+				{
+					mark[i] = s;
+					S->super_rows[count++] = i;
+				}
+			}
+		}
+
+		const long start = S->super_row_starts[s];
+		const int columns = l - f + 1;
+		const int rows = (int) ((long) count - start);
+
+		qsort(S->super_rows + start + columns, (size_t) (rows - columns), sizeof(int), compare_ints);
+		S->super_value_starts[s + 1] = S->super_value_starts[s] + (long) rows * columns;
+		if (rows > S->max_rows)
+			S->max_rows = rows;
+		if (columns > S->max_columns)
+			S->max_columns = columns;
+	}
+	S->super_row_starts[ns] = (long) count;
+	ok = true;
+
+out:
+	free(mark);
+	free(head);
+	free(next);
+	return ok;
+}
+
+// Which supernodes update which, and the largest update buffers that takes
+static bool update_lists(struct sparse_symbolic* S)
+{
+	const int ns = S->supernodes;
+	long* next = NULL;
+
+	S->max_update = 1;
+	S->update_starts = (long*) calloc((size_t) ns + 1, sizeof(long));
+	if (!S->update_starts)
+		return false;
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int K = 0; K < ns; K++)
+		{
+			const int* rows = S->super_rows + S->super_row_starts[K];
+			const int rK = (int) (S->super_row_starts[K + 1] - S->super_row_starts[K]);
+			const int cK = S->super_first[K + 1] - S->super_first[K];
+
+			for (int p = cK; p < rK;)
+			{
+				const int J = S->column_super[rows[p]];
+				int p2 = p + 1;
+
+				while (p2 < rK && S->column_super[rows[p2]] == J)
+					p2++;
+
+				if (pass == 0)
+				{
+					const size_t w = (size_t) (rK - p) * (size_t) (p2 - p);
+					const size_t t = (size_t) (p2 - p) * (size_t) cK;
+
+					S->update_starts[J + 1]++;
+					if (w > S->max_update)
+						S->max_update = w;
+					if (t > S->max_update)
+						S->max_update = t;
+				}
+				else
+					S->updates[next[J]++] = K;
+
+				p = p2;
+			}
+		}
+
+		if (pass == 0)
+		{
+			for (int J = 0; J < ns; J++)
+				S->update_starts[J + 1] += S->update_starts[J];
+
+			S->updates = (int*) malloc(((size_t) S->update_starts[ns] + 1) * sizeof(int));
+			next = (long*) malloc(((size_t) ns + 1) * sizeof(long));
+			if (!S->updates || !next)
+			{
+				free(next);
+				return false;
+			}
+			memcpy(next, S->update_starts, (size_t) ns * sizeof(long));
+		}
+	}
+
+	free(next);
+	return true;
+}
+
+// Splits the supernodal tree into subtrees for the tasks, largest first, until there are
+// enough of them and none is too large; the supernodes above them make up the top
+static bool schedule(struct sparse_symbolic* S, const int* parent)
+{
+	const int ns = S->supernodes;
+	int* sparent = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* first_desc = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* head = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* next = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* candidates = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	int* owner = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	double* subtree = (double*) calloc((size_t) ns + 1, sizeof(double));
+	double* load = NULL;
+	double total = 0;
+	int count = 0;
+	bool ok = false;
+
+	if (!sparent || !first_desc || !head || !next || !candidates || !owner || !subtree)
+		goto out;
+
+	for (int s = 0; s < ns; s++)
+	{
+		const int last = S->super_first[s + 1] - 1;
+		const double columns = last + 1 - S->super_first[s];
+		const double rows = (double) (S->super_row_starts[s + 1] - S->super_row_starts[s]);
+
+		sparent[s] = (parent[last] >= 0) ? S->column_super[parent[last]] : -1;
+		first_desc[s] = s;
+		head[s] = -1;
+		subtree[s] += columns * rows * rows;
+		total += columns * rows * rows;
+	}
+	for (int s = ns - 1; s >= 0; s--)
+	{
+		if (sparent[s] >= 0)
+		{
+			next[s] = head[sparent[s]];
+			head[sparent[s]] = s;
+		}
+	}
+	for (int s = 0; s < ns; s++)
+	{
+		if (sparent[s] >= 0)
+		{
+			subtree[sparent[s]] += subtree[s];
+			if (first_desc[s] < first_desc[sparent[s]])
+				first_desc[sparent[s]] = first_desc[s];
+		}
+	}
+
+	int tasks = (int) sparse_task_count((size_t) total);
+	if (tasks > 1)
+	{
+		for (int s = 0; s < ns; s++)
+		{
+			if (sparent[s] < 0)
+				candidates[count++] = s;
+		}
+
+		while (count > 0)
+		{
+			int biggest = 0;
+			for (int k = 1; k < count; k++)
+			{
+				if (subtree[candidates[k]] > subtree[candidates[biggest]])
+					biggest = k;
+			}
+
+			const int s = candidates[biggest];
+			if (head[s] < 0 || (count >= 2 * tasks && subtree[s] <= total / (2 * tasks)))
+				break;
+
+			candidates[biggest] = candidates[--count];
+			for (int c = head[s]; c >= 0; c = next[c])
+				candidates[count++] = c;
+		}
+
+		if (count < tasks)
+			tasks = count;
+	}
+
+	if (tasks <= 1)
+	{
+		tasks = 0;
+		count = 0;
+	}
+
+	// longest processing time first: the largest subtrees go to the least loaded tasks
+	load = (double*) calloc((size_t) tasks + 1, sizeof(double));
+	S->task_starts = (int*) calloc((size_t) tasks + 2, sizeof(int));
+	S->task_first = (int*) malloc(((size_t) count + 1) * sizeof(int));
+	S->task_last = (int*) malloc(((size_t) count + 1) * sizeof(int));
+	S->top = (int*) malloc(((size_t) ns + 1) * sizeof(int));
+	if (!load || !S->task_starts || !S->task_first || !S->task_last || !S->top)
+		goto out;
+
+	for (int k = 1; k < count; k++)
+	{
+		const int s = candidates[k];
+		int i = k;
+		while (i > 0 && subtree[candidates[i - 1]] < subtree[s])
+		{
+			candidates[i] = candidates[i - 1];
+			i--;
+		}
+		candidates[i] = s;
+	}
+	for (int k = 0; k < count; k++)
+	{
+		int t = 0;
+		for (int u = 1; u < tasks; u++)
+		{
+			if (load[u] < load[t])
+				t = u;
+		}
+		load[t] += subtree[candidates[k]];
+		owner[k] = t;
+		S->task_starts[t + 1]++;
+	}
+	for (int t = 0; t < tasks; t++)
+		S->task_starts[t + 1] += S->task_starts[t];
+	for (int t = 0, k = 0; t < tasks; t++)
+	{
+		for (int c = 0; c < count; c++)
+		{
+			if (owner[c] == t)
+			{
+				S->task_first[k] = first_desc[candidates[c]];
+				S->task_last[k] = candidates[c];
+				k++;
+			}
+		}
+	}
+	S->tasks = tasks;
+
+	for (int s = 0; s < ns; s++)
+		owner[s] = 0;
+	for (int k = 0; k < count; k++)
+	{
+		for (int s = first_desc[candidates[k]]; s <= candidates[k]; s++)
+			owner[s] = 1;
+	}
+	S->top_count = 0;
+	for (int s = 0; s < ns; s++)
+	{
+		if (!owner[s])
+			S->top[S->top_count++] = s;
+	}
+	ok = true;
+
+out:
+	free(sparent);
+	free(first_desc);
+	free(head);
+	free(next);
+	free(candidates);
+	free(owner);
+	free(subtree);
+	free(load);
+	return ok;
+}
+
+size_t sparse_numeric_layout(const struct sparse_symbolic* S, bool is_double, char* base)
+{
+	const size_t real = is_double ? sizeof(double) : sizeof(float);
+	const size_t n = (size_t) S->n;
+	struct sparse_layout layout = { base, 0 };
+	struct sparse_numeric* N = (struct sparse_numeric*) sparse_layout_take(&layout, sizeof(struct sparse_numeric));
+
+	if (S->type == SparseFactorizationQR)
+	{
+		long* v_starts = (long*) sparse_layout_take(&layout, (n + 1) * sizeof(long));
+		int* v_rows = (int*) sparse_layout_take(&layout, (size_t) S->v_count * sizeof(int));
+		void* v_values = sparse_layout_take(&layout, (size_t) S->v_count * real);
+		void* beta = sparse_layout_take(&layout, n * real);
+		long* r_starts = (long*) sparse_layout_take(&layout, (n + 1) * sizeof(long));
+		int* r_rows = (int*) sparse_layout_take(&layout, (size_t) S->r_count * sizeof(int));
+		void* r_values = sparse_layout_take(&layout, (size_t) S->r_count * real);
+
+		if (N)
+		{
+			memset(N, 0, sizeof(*N));
+			N->v_starts = v_starts;
+			N->v_rows = v_rows;
+			N->v_values = v_values;
+			N->beta = beta;
+			N->r_starts = r_starts;
+			N->r_rows = r_rows;
+			N->r_values = r_values;
+		}
+	}
+	else
+	{
+		void* values = sparse_layout_take(&layout, (size_t) S->super_value_starts[S->supernodes] * real);
+		void* lower_values = sparse_layout_take(&layout, (size_t) S->lower_starts[n] * real);
+		void* diagonal = NULL;
+		void* subdiagonal = NULL;
+		int* pivots = NULL;
+		void* matrix_values = NULL;
+
+		if (sparse_is_ldlt(S->type))
+		{
+			diagonal = sparse_layout_take(&layout, n * real);
+			subdiagonal = sparse_layout_take(&layout, n * real);
+			pivots = (int*) sparse_layout_take(&layout, n * sizeof(int));
+		}
+		if (S->type == SparseFactorizationCholeskyAtA)
+			matrix_values = sparse_layout_take(&layout, (size_t) S->matrix.starts[S->matrix.columns] * real);
+
+		if (N)
+		{
+			memset(N, 0, sizeof(*N));
+			N->values = values;
+			N->lower_values = lower_values;
+			N->diagonal = diagonal;
+			N->subdiagonal = subdiagonal;
+			N->pivots = pivots;
+			N->matrix_values = matrix_values;
+		}
+	}
+
+	return layout.size;
+}
+
+static void compute_sizes(struct sparse_symbolic* S)
+{
+	for (int d = 0; d < 2; d++)
+	{
+		const size_t real = d ? sizeof(double) : sizeof(float);
+		const size_t n = (size_t) S->n;
+
+		if (S->type == SparseFactorizationQR)
+		{
+			S->workspace_size[d] = SPARSE_ALIGN(((size_t) S->m2 + n) * sizeof(int)) + SPARSE_ALIGN((size_t) S->m2 * real);
+		}
+		else
+		{
+			const size_t tasks = S->tasks ? (size_t) S->tasks : 1;
+			size_t per_task = SPARSE_ALIGN(n * sizeof(int)) + SPARSE_ALIGN((size_t) S->max_columns * sizeof(int)) + 2 * SPARSE_ALIGN(S->max_update * real);
+
+			if (S->type == SparseFactorizationCholeskyAtA)
+				per_task += SPARSE_ALIGN(n * real);
+			S->workspace_size[d] = tasks * per_task;
+		}
+
+		S->factor_size[d] = sparse_numeric_layout(S, d, NULL);
+	}
+}
+
+// Everything the numeric factorization of a symmetric pattern (both triangles) needs
+static bool analyse_supernodal(struct sparse_symbolic* S, int n, const long* starts, const int* indices, const long* source)
+{
+	int* parent = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* counts = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	long* ustarts = NULL;
+	int* urows = NULL;
+	bool ok = parent && counts && find_ordering(S, n, starts, indices)
+		&& ordered_tree(S, n, starts, indices, parent, &ustarts, &urows)
+		&& column_counts(n, ustarts, urows, parent, counts)
+		&& find_supernodes(S, n, parent, counts)
+		&& permuted_lower(S, n, starts, indices, source)
+		&& supernode_rows(S, n, parent)
+		&& update_lists(S)
+		&& schedule(S, parent);
+
+	free(parent);
+	free(counts);
+	free(ustarts);
+	free(urows);
+	return ok;
+}
+
+// cs_vcount() of CSparse: the leftmost column of each row, and the rows that become the
+// pivotal rows of the Householder vectors, adding empty rows where there's none
+static bool householder_structure(struct sparse_symbolic* S)
+{
+	const struct sparse_points* A = &S->matrix;
+	const int m = A->rows, n = A->columns;
+	int* next = (int*) malloc(((size_t) m + 1) * sizeof(int));
+	int* head = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* tail = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	int* nque = (int*) calloc((size_t) n + 1, sizeof(int));
+	bool ok = false;
+
+	S->leftmost = (int*) malloc(((size_t) m + 1) * sizeof(int));
+	S->pinv = (int*) malloc(((size_t) m + (size_t) n + 1) * sizeof(int));
+	if (!next || !head || !tail || !nque || !S->leftmost || !S->pinv)
+		goto out;
+
+	for (int k = 0; k < n; k++)
+		head[k] = tail[k] = -1;
+	for (int i = 0; i < m; i++)
+		S->leftmost[i] = -1;
+	for (int k = n - 1; k >= 0; k--)
+	{
+		const int j = S->perm[k];
+		for (long p = A->starts[j]; p < A->starts[j + 1]; p++)
+			S->leftmost[A->indices[p]] = k;
+	}
+
+	for (int i = m - 1; i >= 0; i--)
+	{
+		const int k = S->leftmost[i];
+		S->pinv[i] = -1;
+		if (k == -1)
+			continue;
+		if (nque[k]++ == 0)
+			tail[k] = i;
+		next[i] = head[k];
+		head[k] = i;
+	}
+
+	S->v_count = 0;
+	S->m2 = m;
+	int k;
+	for (k = 0; k < n; k++)
+	{
+		int i = head[k];
+		S->v_count++;
+		if (i < 0)
+			i = S->m2++;
+		S->pinv[i] = k;
+		if (--nque[k] <= 0)
+			continue;
+		S->v_count += nque[k];
+
+		const int pa = S->parent[k];
+		if (pa != -1)
+		{
+			if (nque[pa] == 0)
+				tail[pa] = tail[k];
+			next[tail[k]] = head[pa];
+			head[pa] = next[i];
+			nque[pa] += nque[k];
+		}
+	}
+	for (int i = 0; i < m; i++)
+	{
+		if (S->pinv[i] < 0)
+			S->pinv[i] = k++;
+	}
+	ok = true;
+
+out:
+	free(next);
+	free(head);
+	free(tail);
+	free(nque);
+	return ok;
+}
+
+static bool analyse_qr(struct sparse_symbolic* S, int n, const long* starts, const int* indices)
+{
+	int* counts = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	long* ustarts = NULL;
+	int* urows = NULL;
+	bool ok;
+
+	S->parent = (int*) malloc(((size_t) n + 1) * sizeof(int));
+	ok = counts && S->parent && find_ordering(S, n, starts, indices)
+		&& ordered_tree(S, n, starts, indices, S->parent, &ustarts, &urows)
+		&& column_counts(n, ustarts, urows, S->parent, counts)
+		&& householder_structure(S);
+
+	if (ok)
+	{
+		S->r_count = 0;
+		for (int j = 0; j < n; j++)
+			S->r_count += counts[j];
+	}
+
+	free(counts);
+	free(ustarts);
+	free(urows);
+	return ok;
+}
+
+static bool structure_valid(const SparseMatrixStructure* structure, void (*report)(const char*))
+{
+	if (!structure || structure->rowCount < 0 || structure->columnCount < 0 || structure->blockSize < 1
+		|| (!structure->columnStarts && structure->columnCount > 0))
+	{
+		sparse_error(report, "invalid matrix structure");
+		return false;
+	}
+
+	for (int j = 0; j < structure->columnCount; j++)
+	{
+		if (structure->columnStarts[j + 1] < structure->columnStarts[j])
+		{
+			sparse_error(report, "columnStarts[%d] is smaller than columnStarts[%d]", j + 1, j);
+			return false;
+		}
+		for (long p = structure->columnStarts[j]; p < structure->columnStarts[j + 1]; p++)
+		{
+			if (structure->rowIndices[p] < 0 || structure->rowIndices[p] >= structure->rowCount)
+			{
+				sparse_error(report, "row index %d of column %d is out of range", structure->rowIndices[p], j);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static struct sparse_symbolic* symbolic_new(SparseFactorization_t type, const SparseSymbolicFactorOptions* options)
+{
+	struct sparse_symbolic* S = (struct sparse_symbolic*) calloc(1, sizeof(*S));
+	if (!S)
+		return NULL;
+
+	atomic_init(&S->refs, 1);
+	S->type = type;
+	if (options)
+		S->options = *options;
+	if (!S->options.malloc || !S->options.free)
+	{
+		S->options.malloc = default_malloc;
+		S->options.free = default_free;
+	}
+	return S;
+}
+
+static SparseOpaqueSymbolicFactorization symbolic_result(struct sparse_symbolic* S, const SparseMatrixStructure* structure, SparseFactorization_t type, SparseStatus_t status)
+{
+	SparseOpaqueSymbolicFactorization result = { 0 };
+
+	result.status = status;
+	result.type = type;
+	if (structure)
+	{
+		result.rowCount = structure->rowCount;
+		result.columnCount = structure->columnCount;
+		result.attributes = structure->attributes;
+		result.blockSize = structure->blockSize;
+	}
+	result.attributes._allocatedBySparse = false;
+
+	if (status != SparseStatusOK)
+	{
+		sparse_symbolic_release(S);
+		return result;
+	}
+
+	compute_sizes(S);
+	result.factorization = S;
+	result.workspaceSize_Float = S->workspace_size[0];
+	result.workspaceSize_Double = S->workspace_size[1];
+	result.factorSize_Float = S->factor_size[0];
+	result.factorSize_Double = S->factor_size[1];
+	return result;
+}
+
+SparseOpaqueSymbolicFactorization _SparseSymbolicFactorSymmetric(SparseFactorization_t __type, const SparseMatrixStructure *__Matrix, const SparseSymbolicFactorOptions *__options)
+{
+	void (*report)(const char*) = __options ? __options->reportError : NULL;
+	struct sparse_points points;
+
+	if (!sparse_is_symmetric_type(__type))
+	{
+		sparse_error(report, "factorization type %d isn't symmetric", __type);
+		return symbolic_result(NULL, __Matrix, __type, SparseParameterError);
+	}
+	if (!structure_valid(__Matrix, report))
+		return symbolic_result(NULL, __Matrix, __type, SparseParameterError);
+	if (__Matrix->attributes.kind != SparseSymmetric || __Matrix->rowCount != __Matrix->columnCount)
+	{
+		sparse_error(report, "a symmetric factorization needs a matrix of kind SparseSymmetric");
+		return symbolic_result(NULL, __Matrix, __type, SparseParameterError);
+	}
+
+	struct sparse_symbolic* S = symbolic_new(__type, __options);
+	if (!S || !sparse_points_build(__Matrix, false, &points))
+	{
+		sparse_symbolic_release(S);
+		return symbolic_result(NULL, __Matrix, __type, SparseInternalError);
+	}
+
+	S->m = S->n = points.columns;
+	S->values = __Matrix->columnStarts[__Matrix->columnCount] * __Matrix->blockSize * __Matrix->blockSize;
+
+	const bool ok = analyse_supernodal(S, points.columns, points.starts, points.indices, points.source);
+	sparse_points_free(&points);
+
+	return symbolic_result(S, __Matrix, __type, ok ? SparseStatusOK : SparseInternalError);
+}
+
+SparseOpaqueSymbolicFactorization _SparseSymbolicFactorQR(SparseFactorization_t __type, const SparseMatrixStructure *__Matrix, const SparseSymbolicFactorOptions *__options)
+{
+	void (*report)(const char*) = __options ? __options->reportError : NULL;
+
+	if (__type != SparseFactorizationQR && __type != SparseFactorizationCholeskyAtA)
+	{
+		sparse_error(report, "factorization type %d isn't QR or CholeskyAtA", __type);
+		return symbolic_result(NULL, __Matrix, __type, SparseParameterError);
+	}
+	if (!structure_valid(__Matrix, report))
+		return symbolic_result(NULL, __Matrix, __type, SparseParameterError);
+
+	struct sparse_symbolic* S = symbolic_new(__type, __options);
+	if (!S || !sparse_points_build(__Matrix, false, &S->matrix))
+	{
+		sparse_symbolic_release(S);
+		return symbolic_result(NULL, __Matrix, __type, SparseInternalError);
+	}
+
+	// QR of a wide matrix factors its transpose and finds the minimum norm solution
+	if (__type == SparseFactorizationQR && S->matrix.rows < S->matrix.columns)
+	{
+		sparse_points_free(&S->matrix);
+		S->transposed = true;
+		if (!sparse_points_build(__Matrix, true, &S->matrix))
+		{
+			sparse_symbolic_release(S);
+			return symbolic_result(NULL, __Matrix, __type, SparseInternalError);
+		}
+	}
+
+	S->m = S->matrix.rows;
+	S->n = S->matrix.columns;
+	S->values = __Matrix->columnStarts[__Matrix->columnCount] * __Matrix->blockSize * __Matrix->blockSize;
+
+	long* ata_starts = NULL;
+	int* ata_indices = NULL;
+	bool ok = sparse_points_rows(&S->matrix, &S->row_starts, &S->row_columns, &S->row_entries)
+		&& sparse_points_ata(&S->matrix, S->row_starts, S->row_columns, &ata_starts, &ata_indices);
+
+	if (ok)
+	{
+		if (__type == SparseFactorizationQR)
+			ok = analyse_qr(S, S->n, ata_starts, ata_indices);
+		else
+			ok = analyse_supernodal(S, S->n, ata_starts, ata_indices, NULL);
+	}
+
+	free(ata_starts);
+	free(ata_indices);
+	return symbolic_result(S, __Matrix, __type, ok ? SparseStatusOK : SparseInternalError);
+}
+
+void _SparseRetainSymbolic(SparseOpaqueSymbolicFactorization *__symbolic)
+{
+	struct sparse_symbolic* S = (struct sparse_symbolic*) __symbolic->factorization;
+
+	if (S)
+		atomic_fetch_add(&S->refs, 1);
+}
+
+void _SparseDestroyOpaqueSymbolic(SparseOpaqueSymbolicFactorization *__symbolic)
+{
+	sparse_symbolic_release((struct sparse_symbolic*) __symbolic->factorization);
+	__symbolic->factorization = NULL;
+	__symbolic->status = SparseStatusReleased;
+}
+
+SparseSymbolicFactorOptions _SparseGetOptionsFromSymbolicFactor(SparseOpaqueSymbolicFactorization *__factor)
+{
+	const struct sparse_symbolic* S = (const struct sparse_symbolic*) __factor->factorization;
+	SparseSymbolicFactorOptions options = { 0 };
+
+	if (S)
+		options = S->options;
+	return options;
+}
@@ -21,74 +21,142 @@
 #ifndef _SparseBLAS_H_
 #define _SparseBLAS_H_
 
-void* sparse_commit(void);
-void* sparse_elementwise_norm_double(void);
-void* sparse_elementwise_norm_float(void);
-void* sparse_extract_block_double(void);
-void* sparse_extract_block_float(void);
-void* sparse_extract_sparse_column_double(void);
-void* sparse_extract_sparse_column_float(void);
-void* sparse_extract_sparse_row_double(void);
-void* sparse_extract_sparse_row_float(void);
-void* sparse_get_block_dimension_for_col(void);
-void* sparse_get_block_dimension_for_row(void);
-void* sparse_get_matrix_nonzero_count(void);
-void* sparse_get_matrix_nonzero_count_for_column(void);
-void* sparse_get_matrix_nonzero_count_for_row(void);
-void* sparse_get_matrix_number_of_columns(void);
-void* sparse_get_matrix_number_of_rows(void);
-void* sparse_get_matrix_property(void);
-void* sparse_get_vector_nonzero_count_double(void);
-void* sparse_get_vector_nonzero_count_float(void);
-void* sparse_inner_product_dense_double(void);
-void* sparse_inner_product_dense_float(void);
-void* sparse_inner_product_sparse_double(void);
-void* sparse_inner_product_sparse_float(void);
-void* sparse_insert_block_double(void);
-void* sparse_insert_block_float(void);
-void* sparse_insert_col_double(void);
-void* sparse_insert_col_float(void);
-void* sparse_insert_entries_double(void);
-void* sparse_insert_entries_float(void);
-void* sparse_insert_entry_double(void);
-void* sparse_insert_entry_float(void);
-void* sparse_insert_row_double(void);
-void* sparse_insert_row_float(void);
-void* sparse_matrix_block_create_double(void);
-void* sparse_matrix_block_create_float(void);
-void* sparse_matrix_create_double(void);
-void* sparse_matrix_create_float(void);
-void* sparse_matrix_destroy(void);
-void* sparse_matrix_product_dense_double(void);
-void* sparse_matrix_product_dense_float(void);
-void* sparse_matrix_product_sparse_double(void);
-void* sparse_matrix_product_sparse_float(void);
-void* sparse_matrix_trace_double(void);
-void* sparse_matrix_trace_float(void);
-void* sparse_matrix_triangular_solve_dense_double(void);
-void* sparse_matrix_triangular_solve_dense_float(void);
-void* sparse_matrix_variable_block_create_double(void);
-void* sparse_matrix_variable_block_create_float(void);
-void* sparse_matrix_vector_product_dense_double(void);
-void* sparse_matrix_vector_product_dense_float(void);
-void* sparse_operator_norm_double(void);
-void* sparse_operator_norm_float(void);
-void* sparse_outer_product_dense_double(void);
-void* sparse_outer_product_dense_float(void);
-void* sparse_pack_vector_double(void);
-void* sparse_pack_vector_float(void);
-void* sparse_permute_cols_double(void);
-void* sparse_permute_cols_float(void);
-void* sparse_permute_rows_double(void);
-void* sparse_permute_rows_float(void);
-void* sparse_set_matrix_property(void);
-void* sparse_unpack_vector_double(void);
-void* sparse_unpack_vector_float(void);
-void* sparse_vector_add_with_scale_dense_double(void);
-void* sparse_vector_add_with_scale_dense_float(void);
-void* sparse_vector_norm_double(void);
-void* sparse_vector_norm_float(void);
-void* sparse_vector_triangular_solve_dense_double(void);
-void* sparse_vector_triangular_solve_dense_float(void);
+#include <BLAS/BLAS.h>
+#include <stdbool.h>
+
+typedef long sparse_index;
+typedef unsigned long sparse_dimension;
+typedef long sparse_stride;
+
+typedef enum
+{
+	SPARSE_SUCCESS = 0,
+	SPARSE_ILLEGAL_PARAMETER = -1000,
+	SPARSE_CANNOT_SET_PROPERTY = -1001,
+	SPARSE_SYSTEM_ERROR = -1002,
+} sparse_status;
+
+// Only one triangle of a triangular or symmetric matrix is referenced, properties can only
+// be set before the first entry is inserted
+typedef enum
+{
+	SPARSE_UPPER_TRIANGULAR = 1,
+	SPARSE_LOWER_TRIANGULAR = 2,
+	SPARSE_UPPER_SYMMETRIC = 4,
+	SPARSE_LOWER_SYMMETRIC = 8,
+} sparse_matrix_property;
+
+typedef enum
+{
+	SPARSE_NORM_ONE = 171,
+	SPARSE_NORM_TWO = 173,
+	SPARSE_NORM_INF = 175,
+	// the sum of the 2-norms of the rows
+	SPARSE_NORM_R1 = 179,
+} sparse_norm;
+
+typedef struct sparse_m_float* sparse_matrix_float;
+typedef struct sparse_m_double* sparse_matrix_double;
+
+// Level 1: a sparse vector is `nz` values with their indices, in increasing index order
+// where it matters. Dense vectors are accessed at y[index * incy], those with a length in
+// BLAS' convention for negative strides.
+
+float sparse_inner_product_dense_float(sparse_dimension __nz, const float *__x, const sparse_index *__indx, const float *__y, sparse_stride __incy);
+double sparse_inner_product_dense_double(sparse_dimension __nz, const double *__x, const sparse_index *__indx, const double *__y, sparse_stride __incy);
+float sparse_inner_product_sparse_float(sparse_dimension __nzx, sparse_dimension __nzy, const float *__x, const sparse_index *__indx, const float *__y, const sparse_index *__indy);
+double sparse_inner_product_sparse_double(sparse_dimension __nzx, sparse_dimension __nzy, const double *__x, const sparse_index *__indx, const double *__y, const sparse_index *__indy);
+// y += alpha * x
+void sparse_vector_add_with_scale_dense_float(sparse_dimension __nz, float __alpha, const float *__x, const sparse_index *__indx, float *__y, sparse_stride __incy);
+void sparse_vector_add_with_scale_dense_double(sparse_dimension __nz, double __alpha, const double *__x, const sparse_index *__indx, double *__y, sparse_stride __incy);
+float sparse_vector_norm_float(sparse_dimension __nz, const float *__x, const sparse_index *__indx, sparse_norm __norm);
+double sparse_vector_norm_double(sparse_dimension __nz, const double *__x, const sparse_index *__indx, sparse_norm __norm);
+
+// Level 2 and 3: y += alpha * op(A) * x, C += alpha * op(A) * B with B having n columns
+sparse_status sparse_matrix_vector_product_dense_float(enum CBLAS_TRANSPOSE __transa, float __alpha, sparse_matrix_float __A, const float *__x, sparse_stride __incx, float *__y, sparse_stride __incy);
+sparse_status sparse_matrix_vector_product_dense_double(enum CBLAS_TRANSPOSE __transa, double __alpha, sparse_matrix_double __A, const double *__x, sparse_stride __incx, double *__y, sparse_stride __incy);
+sparse_status sparse_matrix_product_dense_float(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transa, sparse_dimension __n, float __alpha, sparse_matrix_float __A, const float *__B, sparse_dimension __ldb, float *__C, sparse_dimension __ldc);
+sparse_status sparse_matrix_product_dense_double(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transa, sparse_dimension __n, double __alpha, sparse_matrix_double __A, const double *__B, sparse_dimension __ldb, double *__C, sparse_dimension __ldc);
+// A new matrix alpha * op(A) * B, NULL on error
+sparse_matrix_float sparse_matrix_product_sparse_float(enum CBLAS_TRANSPOSE __transa, float __alpha, sparse_matrix_float __A, sparse_matrix_float __B);
+sparse_matrix_double sparse_matrix_product_sparse_double(enum CBLAS_TRANSPOSE __transa, double __alpha, sparse_matrix_double __A, sparse_matrix_double __B);
+// C += alpha * x * y^T for a dense x of M values and a sparse y of nz values, C is M x N.
+// A new matrix is created if *C is NULL.
+sparse_status sparse_outer_product_dense_float(sparse_dimension __M, sparse_dimension __N, sparse_dimension __nz, float __alpha, const float *__x, sparse_stride __incx, const float *__y, const sparse_index *__indy, sparse_matrix_float *__C);
+sparse_status sparse_outer_product_dense_double(sparse_dimension __M, sparse_dimension __N, sparse_dimension __nz, double __alpha, const double *__x, sparse_stride __incx, const double *__y, const sparse_index *__indy, sparse_matrix_double *__C);
+// x = alpha * op(T)^-1 * x and B = alpha * op(T)^-1 * B for a matrix with a triangular property
+sparse_status sparse_vector_triangular_solve_dense_float(enum CBLAS_TRANSPOSE __transt, float __alpha, sparse_matrix_float __T, float *__x, sparse_stride __incx);
+sparse_status sparse_vector_triangular_solve_dense_double(enum CBLAS_TRANSPOSE __transt, double __alpha, sparse_matrix_double __T, double *__x, sparse_stride __incx);
+sparse_status sparse_matrix_triangular_solve_dense_float(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transt, sparse_dimension __nrhs, float __alpha, sparse_matrix_float __T, float *__B, sparse_dimension __ldb);
+sparse_status sparse_matrix_triangular_solve_dense_double(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transt, sparse_dimension __nrhs, double __alpha, sparse_matrix_double __T, double *__B, sparse_dimension __ldb);
+
+// Matrices. Insertions are collected until sparse_commit(), which the other operations call
+// when needed; inserting an existing entry replaces its value.
+sparse_matrix_float sparse_matrix_create_float(sparse_dimension __M, sparse_dimension __N);
+sparse_matrix_double sparse_matrix_create_double(sparse_dimension __M, sparse_dimension __N);
+// Mb x Nb blocks of k x l values
+sparse_matrix_float sparse_matrix_block_create_float(sparse_dimension __Mb, sparse_dimension __Nb, sparse_dimension __k, sparse_dimension __l);
+sparse_matrix_double sparse_matrix_block_create_double(sparse_dimension __Mb, sparse_dimension __Nb, sparse_dimension __k, sparse_dimension __l);
+// Block row i has K[i] rows, block column j has L[j] columns
+sparse_matrix_float sparse_matrix_variable_block_create_float(sparse_dimension __Mb, sparse_dimension __Nb, const sparse_dimension *__K, const sparse_dimension *__L);
+sparse_matrix_double sparse_matrix_variable_block_create_double(sparse_dimension __Mb, sparse_dimension __Nb, const sparse_dimension *__K, const sparse_dimension *__L);
+
+sparse_status sparse_insert_entry_float(sparse_matrix_float __A, float __val, sparse_index __i, sparse_index __j);
+sparse_status sparse_insert_entry_double(sparse_matrix_double __A, double __val, sparse_index __i, sparse_index __j);
+sparse_status sparse_insert_entries_float(sparse_matrix_float __A, sparse_dimension __N, const float *__val, const sparse_index *__indx, const sparse_index *__jndx);
+sparse_status sparse_insert_entries_double(sparse_matrix_double __A, sparse_dimension __N, const double *__val, const sparse_index *__indx, const sparse_index *__jndx);
+sparse_status sparse_insert_col_float(sparse_matrix_float __A, sparse_index __j, sparse_dimension __nz, const float *__val, const sparse_index *__indx);
+sparse_status sparse_insert_col_double(sparse_matrix_double __A, sparse_index __j, sparse_dimension __nz, const double *__val, const sparse_index *__indx);
+sparse_status sparse_insert_row_float(sparse_matrix_float __A, sparse_index __i, sparse_dimension __nz, const float *__val, const sparse_index *__jndx);
+sparse_status sparse_insert_row_double(sparse_matrix_double __A, sparse_index __i, sparse_dimension __nz, const double *__val, const sparse_index *__jndx);
+// Block (bi, bj) from val[i * row_stride + j * col_stride]
+sparse_status sparse_insert_block_float(sparse_matrix_float __A, const float *__val, sparse_dimension __row_stride, sparse_dimension __col_stride, sparse_index __bi, sparse_index __bj);
+sparse_status sparse_insert_block_double(sparse_matrix_double __A, const double *__val, sparse_dimension __row_stride, sparse_dimension __col_stride, sparse_index __bi, sparse_index __bj);
+
+// Up to nz entries of the row with column >= column_start. Returns how many were extracted
+// and sets *column_end to the column to continue from, or a negative sparse_status.
+sparse_index sparse_extract_sparse_row_float(sparse_matrix_float __A, sparse_index __row, sparse_index __column_start, sparse_index *__column_end, sparse_dimension __nz, float *__val, sparse_index *__jndx);
+sparse_index sparse_extract_sparse_row_double(sparse_matrix_double __A, sparse_index __row, sparse_index __column_start, sparse_index *__column_end, sparse_dimension __nz, double *__val, sparse_index *__jndx);
+sparse_index sparse_extract_sparse_column_float(sparse_matrix_float __A, sparse_index __column, sparse_index __row_start, sparse_index *__row_end, sparse_dimension __nz, float *__val, sparse_index *__indx);
+sparse_index sparse_extract_sparse_column_double(sparse_matrix_double __A, sparse_index __column, sparse_index __row_start, sparse_index *__row_end, sparse_dimension __nz, double *__val, sparse_index *__indx);
+sparse_status sparse_extract_block_float(sparse_matrix_float __A, sparse_index __bi, sparse_index __bj, sparse_dimension __row_stride, sparse_dimension __col_stride, float *__val);
+sparse_status sparse_extract_block_double(sparse_matrix_double __A, sparse_index __bi, sparse_index __bj, sparse_dimension __row_stride, sparse_dimension __col_stride, double *__val);
+
+// These take a sparse_matrix_float or a sparse_matrix_double
+sparse_status sparse_commit(void *__A);
+sparse_status sparse_matrix_destroy(void *__A);
+sparse_status sparse_set_matrix_property(void *__A, sparse_matrix_property __pname);
+long sparse_get_matrix_property(void *__A, sparse_matrix_property __pname);
+long sparse_get_matrix_nonzero_count(void *__A);
+long sparse_get_matrix_nonzero_count_for_row(void *__A, sparse_index __i);
+long sparse_get_matrix_nonzero_count_for_column(void *__A, sparse_index __j);
+sparse_dimension sparse_get_matrix_number_of_rows(void *__A);
+sparse_dimension sparse_get_matrix_number_of_columns(void *__A);
+sparse_index sparse_get_block_dimension_for_row(void *__A, sparse_index __i);
+sparse_index sparse_get_block_dimension_for_col(void *__A, sparse_index __j);
+
+float sparse_elementwise_norm_float(sparse_matrix_float __A, sparse_norm __norm);
+double sparse_elementwise_norm_double(sparse_matrix_double __A, sparse_norm __norm);
+// SPARSE_NORM_ONE and SPARSE_NORM_INF only
+float sparse_operator_norm_float(sparse_matrix_float __A, sparse_norm __norm);
+double sparse_operator_norm_double(sparse_matrix_double __A, sparse_norm __norm);
+// The sum of A[i, i + offset]
+float sparse_matrix_trace_float(sparse_matrix_float __A, sparse_index __offset);
+double sparse_matrix_trace_double(sparse_matrix_double __A, sparse_index __offset);
+// Row (column) i is moved to perm[i]
+sparse_status sparse_permute_rows_float(sparse_matrix_float __A, const sparse_index *__perm);
+sparse_status sparse_permute_rows_double(sparse_matrix_double __A, const sparse_index *__perm);
+sparse_status sparse_permute_cols_float(sparse_matrix_float __A, const sparse_index *__perm);
+sparse_status sparse_permute_cols_double(sparse_matrix_double __A, const sparse_index *__perm);
+
+// Dense <-> sparse vectors
+sparse_index sparse_get_vector_nonzero_count_float(sparse_dimension __N, const float *__x, sparse_stride __incx);
+sparse_index sparse_get_vector_nonzero_count_double(sparse_dimension __N, const double *__x, sparse_stride __incx);
+// Stores up to nz nonzeros of x in y and indy, returns how many
+sparse_dimension sparse_pack_vector_float(sparse_dimension __N, sparse_dimension __nz, const float *__x, sparse_stride __incx, float *__y, sparse_index *__indy);
+sparse_dimension sparse_pack_vector_double(sparse_dimension __N, sparse_dimension __nz, const double *__x, sparse_stride __incx, double *__y, sparse_index *__indy);
+// Scatters x into the N values of y, zeroing them first if `zero` is set
+void sparse_unpack_vector_float(sparse_dimension __N, sparse_dimension __nz, bool __zero, const float *__x, const sparse_index *__indx, float *__y, sparse_stride __incy);
+void sparse_unpack_vector_double(sparse_dimension __N, sparse_dimension __nz, bool __zero, const double *__x, const sparse_index *__indx, double *__y, sparse_stride __incy);
 
 #endif
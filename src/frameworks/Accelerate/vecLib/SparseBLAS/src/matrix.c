@@ -0,0 +1,430 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "sparseblas_internal.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPARSEBLAS_TEMPLATE "matrix_template.h"
+#include "sparseblas_instantiate.h"
+
+static size_t value_size(const struct sparse_matrix* A)
+{
+	return A->is_double ? sizeof(double) : sizeof(float);
+}
+
+struct sparse_matrix* sparse_matrix_new(bool is_double, sparse_dimension rows, sparse_dimension columns)
+{
+	if (rows == 0 || columns == 0 || rows > LONG_MAX / 2 || columns > LONG_MAX / 2)
+		return NULL;
+
+	struct sparse_matrix* A = (struct sparse_matrix*) calloc(1, sizeof(*A));
+	if (!A)
+		return NULL;
+
+	A->is_double = is_double;
+	A->rows = rows;
+	A->columns = columns;
+	return A;
+}
+
+bool sparse_reserve_pending(struct sparse_matrix* A, size_t count)
+{
+	if (A->pending_capacity - A->pending >= count)
+		return true;
+
+	size_t capacity = A->pending_capacity ? A->pending_capacity * 2 : 64;
+	while (capacity - A->pending < count)
+		capacity *= 2;
+
+	sparse_index* rows = (sparse_index*) realloc(A->pending_rows, capacity * sizeof(sparse_index));
+	if (!rows)
+		return false;
+	A->pending_rows = rows;
+
+	sparse_index* columns = (sparse_index*) realloc(A->pending_columns, capacity * sizeof(sparse_index));
+	if (!columns)
+		return false;
+	A->pending_columns = columns;
+
+	void* values = realloc(A->pending_values, capacity * value_size(A));
+	if (!values)
+		return false;
+	A->pending_values = values;
+
+	A->pending_capacity = capacity;
+	return true;
+}
+
+bool sparse_entry_referenced(const struct sparse_matrix* A, sparse_index i, sparse_index j)
+{
+	if (A->properties & (SPARSE_UPPER_TRIANGULAR | SPARSE_UPPER_SYMMETRIC))
+		return j >= i;
+	if (A->properties & (SPARSE_LOWER_TRIANGULAR | SPARSE_LOWER_SYMMETRIC))
+		return j <= i;
+	return true;
+}
+
+sparse_index sparse_find_entry(const struct sparse_matrix* A, sparse_index i, sparse_index j)
+{
+	sparse_index lo = A->row_starts[i], hi = A->row_starts[i + 1];
+
+	while (lo < hi)
+	{
+		const sparse_index mid = lo + (hi - lo) / 2;
+		if (A->column_indices[mid] < j)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return (lo < A->row_starts[i + 1] && A->column_indices[lo] == j) ? lo : -1;
+}
+
+void sparse_set_rows(struct sparse_matrix* A, sparse_index* row_starts, sparse_index* column_indices, void* values, size_t stored)
+{
+	free(A->row_starts);
+	free(A->column_indices);
+	free(A->values);
+
+	A->row_starts = row_starts;
+	A->column_indices = column_indices;
+	A->values = values;
+	A->stored = stored;
+}
+
+struct entry_order
+{
+	sparse_index column;
+	size_t position;
+};
+
+static int compare_entries(const void* a, const void* b)
+{
+	const struct entry_order* x = (const struct entry_order*) a;
+	const struct entry_order* y = (const struct entry_order*) b;
+
+	if (x->column != y->column)
+		return (x->column < y->column) ? -1 : 1;
+	return (x->position < y->position) ? -1 : (x->position > y->position);
+}
+
+// Sorts `count` entries into rows, of each set of entries at the same position only the last
+// one is kept. Returns false without memory.
+static bool rows_from_entries(const struct sparse_matrix* A, size_t count, const sparse_index* ri, const sparse_index* ci,
+	const char* values, sparse_index** starts_out, sparse_index** columns_out, void** values_out, size_t* count_out)
+{
+	const size_t size = value_size(A);
+	const sparse_index rows = (sparse_index) A->rows;
+	sparse_index* starts = (sparse_index*) calloc(rows + 1, sizeof(sparse_index));
+	struct entry_order* order = (struct entry_order*) malloc((count ? count : 1) * sizeof(*order));
+	sparse_index* columns = NULL;
+	char* out = NULL;
+
+	if (!starts || !order)
+		goto fail;
+
+	// bucket by row, keeping the insertion order within each row
+	for (size_t k = 0; k < count; k++)
+		starts[ri[k] + 1]++;
+	for (sparse_index i = 0; i < rows; i++)
+		starts[i + 1] += starts[i];
+	for (size_t k = 0; k < count; k++)
+	{
+		struct entry_order* e = &order[starts[ri[k]]++];
+		e->column = ci[k];
+		e->position = k;
+	}
+	for (sparse_index i = rows; i > 0; i--)
+		starts[i] = starts[i - 1];
+	starts[0] = 0;
+
+	columns = (sparse_index*) malloc((count ? count : 1) * sizeof(sparse_index));
+	out = (char*) malloc((count ? count : 1) * size);
+	if (!columns || !out)
+		goto fail;
+
+	size_t kept = 0;
+	for (sparse_index i = 0; i < rows; i++)
+	{
+		const sparse_index first = starts[i], last = starts[i + 1];
+
+		if (last - first > 1)
+			qsort(order + first, last - first, sizeof(*order), compare_entries);
+
+		starts[i] = kept;
+		for (sparse_index k = first; k < last; k++)
+		{
+			if (k + 1 < last && order[k + 1].column == order[k].column)
+				continue;
+
+			columns[kept] = order[k].column;
+			memcpy(out + kept * size, values + order[k].position * size, size);
+			kept++;
+		}
+	}
+	starts[rows] = kept;
+
+	free(order);
+	*starts_out = starts;
+	*columns_out = columns;
+	*values_out = out;
+	*count_out = kept;
+	return true;
+
+fail:
+	free(starts);
+	free(order);
+	free(columns);
+	free(out);
+	return false;
+}
+
+sparse_status sparse_commit(void *__A)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (A->row_starts && A->pending == 0)
+		return SPARSE_SUCCESS;
+
+	const size_t size = value_size(A);
+	const bool symmetric = (A->properties & SPARSE_SYMMETRIC) != 0;
+	const size_t existing = A->row_starts ? (size_t) A->row_starts[A->rows] : 0;
+	size_t count = 0;
+
+	// the committed entries go first so that pending ones replace them, a symmetric matrix
+	// contributes only the triangle that was stored
+	sparse_index* ri = (sparse_index*) malloc((existing + A->pending + 1) * sizeof(sparse_index));
+	sparse_index* ci = (sparse_index*) malloc((existing + A->pending + 1) * sizeof(sparse_index));
+	char* values = (char*) malloc((existing + A->pending + 1) * size);
+
+	if (!ri || !ci || !values)
+		goto fail;
+
+	for (sparse_index i = 0; A->row_starts && i < (sparse_index) A->rows; i++)
+	{
+		for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+		{
+			if (symmetric && !sparse_entry_referenced(A, i, A->column_indices[k]))
+				continue;
+			ri[count] = i;
+			ci[count] = A->column_indices[k];
+			memcpy(values + count * size, (const char*) A->values + k * size, size);
+			count++;
+		}
+	}
+	for (size_t k = 0; k < A->pending; k++)
+	{
+		if (!sparse_entry_referenced(A, A->pending_rows[k], A->pending_columns[k]))
+			continue;
+		ri[count] = A->pending_rows[k];
+		ci[count] = A->pending_columns[k];
+		memcpy(values + count * size, (const char*) A->pending_values + k * size, size);
+		count++;
+	}
+
+	sparse_index* starts;
+	sparse_index* columns;
+	void* merged;
+	size_t stored;
+
+	if (!rows_from_entries(A, count, ri, ci, values, &starts, &columns, &merged, &stored))
+		goto fail;
+
+	if (symmetric)
+	{
+		// add the mirror images of the off-diagonal entries
+		size_t full = 0;
+		for (sparse_index i = 0; i < (sparse_index) A->rows; i++)
+		{
+			for (sparse_index k = starts[i]; k < starts[i + 1]; k++)
+			{
+				ri[full] = i;
+				ci[full] = columns[k];
+				memcpy(values + full * size, (const char*) merged + k * size, size);
+				full++;
+			}
+		}
+
+		sparse_index* mirrored_ri = (sparse_index*) realloc(ri, (2 * full + 1) * sizeof(sparse_index));
+		sparse_index* mirrored_ci = mirrored_ri ? (sparse_index*) realloc(ci, (2 * full + 1) * sizeof(sparse_index)) : NULL;
+		char* mirrored_values = mirrored_ci ? (char*) realloc(values, (2 * full + 1) * size) : NULL;
+
+		if (mirrored_ri)
+			ri = mirrored_ri;
+		if (mirrored_ci)
+			ci = mirrored_ci;
+		if (mirrored_values)
+			values = mirrored_values;
+
+		free(starts);
+		free(columns);
+		free(merged);
+		if (!mirrored_values)
+			goto fail;
+
+		count = full;
+		for (size_t k = 0; k < full; k++)
+		{
+			if (ri[k] == ci[k])
+				continue;
+			ri[count] = ci[k];
+			ci[count] = ri[k];
+			memcpy(values + count * size, values + k * size, size);
+			count++;
+		}
+
+		size_t total;
+		if (!rows_from_entries(A, count, ri, ci, values, &starts, &columns, &merged, &total))
+			goto fail;
+		stored = full;
+	}
+
+	sparse_set_rows(A, starts, columns, merged, stored);
+	A->pending = 0;
+
+	free(ri);
+	free(ci);
+	free(values);
+	return SPARSE_SUCCESS;
+
+fail:
+	free(ri);
+	free(ci);
+	free(values);
+	return SPARSE_SYSTEM_ERROR;
+}
+
+sparse_status sparse_matrix_destroy(void *__A)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	free(A->row_block_starts);
+	free(A->column_block_starts);
+	free(A->row_starts);
+	free(A->column_indices);
+	free(A->values);
+	free(A->pending_rows);
+	free(A->pending_columns);
+	free(A->pending_values);
+	free(A);
+	return SPARSE_SUCCESS;
+}
+
+sparse_status sparse_set_matrix_property(void *__A, sparse_matrix_property __pname)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__pname != SPARSE_UPPER_TRIANGULAR && __pname != SPARSE_LOWER_TRIANGULAR
+		&& __pname != SPARSE_UPPER_SYMMETRIC && __pname != SPARSE_LOWER_SYMMETRIC)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	// the entries that were inserted may not fit the property, and a matrix has one shape
+	if (A->stored != 0 || A->pending != 0 || A->rows != A->columns)
+		return SPARSE_CANNOT_SET_PROPERTY;
+	if (A->properties != 0 && A->properties != (unsigned int) __pname)
+		return SPARSE_CANNOT_SET_PROPERTY;
+
+	A->properties = __pname;
+	return SPARSE_SUCCESS;
+}
+
+long sparse_get_matrix_property(void *__A, sparse_matrix_property __pname)
+{
+	const struct sparse_matrix* A = (const struct sparse_matrix*) __A;
+
+	if (!A)
+		return SPARSE_ILLEGAL_PARAMETER;
+	return (A->properties & __pname) ? 1 : 0;
+}
+
+long sparse_get_matrix_nonzero_count(void *__A)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+	return (long) A->stored;
+}
+
+long sparse_get_matrix_nonzero_count_for_row(void *__A, sparse_index __i)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A || __i < 0 || __i >= (sparse_index) A->rows)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+	return A->row_starts[__i + 1] - A->row_starts[__i];
+}
+
+long sparse_get_matrix_nonzero_count_for_column(void *__A, sparse_index __j)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) __A;
+
+	if (!A || __j < 0 || __j >= (sparse_index) A->columns)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+
+	long count = 0;
+	for (sparse_index i = 0; i < (sparse_index) A->rows; i++)
+		count += sparse_find_entry(A, i, __j) >= 0;
+	return count;
+}
+
+sparse_dimension sparse_get_matrix_number_of_rows(void *__A)
+{
+	const struct sparse_matrix* A = (const struct sparse_matrix*) __A;
+	return A ? A->rows : 0;
+}
+
+sparse_dimension sparse_get_matrix_number_of_columns(void *__A)
+{
+	const struct sparse_matrix* A = (const struct sparse_matrix*) __A;
+	return A ? A->columns : 0;
+}
+
+sparse_index sparse_get_block_dimension_for_row(void *__A, sparse_index __i)
+{
+	const struct sparse_matrix* A = (const struct sparse_matrix*) __A;
+
+	if (!A || A->block_rows == 0 || __i < 0 || __i >= (sparse_index) A->block_rows)
+		return SPARSE_ILLEGAL_PARAMETER;
+	return A->row_block_starts[__i + 1] - A->row_block_starts[__i];
+}
+
+sparse_index sparse_get_block_dimension_for_col(void *__A, sparse_index __j)
+{
+	const struct sparse_matrix* A = (const struct sparse_matrix*) __A;
+
+	if (!A || A->block_columns == 0 || __j < 0 || __j >= (sparse_index) A->block_columns)
+		return SPARSE_ILLEGAL_PARAMETER;
+	return A->column_block_starts[__j + 1] - A->column_block_starts[__j];
+}
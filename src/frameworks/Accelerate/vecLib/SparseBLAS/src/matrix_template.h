@@ -0,0 +1,540 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Creation, insertion, extraction and whole-matrix reductions, included by matrix.c through
+// sparseblas_instantiate.h
+
+// The matrix behind a client's handle if it holds REAL values
+static struct sparse_matrix* PFX(matrix)(MATRIX handle)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) handle;
+	return (A && A->is_double == IS_DOUBLE) ? A : NULL;
+}
+
+MATRIX F(sparse_matrix_create)(sparse_dimension __M, sparse_dimension __N)
+{
+	return (MATRIX) sparse_matrix_new(IS_DOUBLE, __M, __N);
+}
+
+// Sets up blocks of the given sizes, or of size k (l) if the sizes are NULL
+static MATRIX PFX(block_create)(sparse_dimension Mb, sparse_dimension Nb, sparse_dimension k, sparse_dimension l,
+	const sparse_dimension* K, const sparse_dimension* L)
+{
+	if (Mb == 0 || Nb == 0 || Mb > LONG_MAX / 2 || Nb > LONG_MAX / 2)
+		return NULL;
+
+	sparse_index* row_starts = (sparse_index*) malloc((Mb + 1) * sizeof(sparse_index));
+	sparse_index* column_starts = (sparse_index*) malloc((Nb + 1) * sizeof(sparse_index));
+	struct sparse_matrix* A = NULL;
+
+	if (!row_starts || !column_starts)
+		goto fail;
+
+	row_starts[0] = column_starts[0] = 0;
+	for (sparse_dimension i = 0; i < Mb; i++)
+	{
+		const sparse_dimension size = K ? K[i] : k;
+		if (size == 0 || size > (sparse_dimension) (LONG_MAX / 2 - row_starts[i]))
+			goto fail;
+		row_starts[i + 1] = row_starts[i] + (sparse_index) size;
+	}
+	for (sparse_dimension j = 0; j < Nb; j++)
+	{
+		const sparse_dimension size = L ? L[j] : l;
+		if (size == 0 || size > (sparse_dimension) (LONG_MAX / 2 - column_starts[j]))
+			goto fail;
+		column_starts[j + 1] = column_starts[j] + (sparse_index) size;
+	}
+
+	A = sparse_matrix_new(IS_DOUBLE, row_starts[Mb], column_starts[Nb]);
+	if (!A)
+		goto fail;
+
+	A->block_rows = Mb;
+	A->block_columns = Nb;
+	A->row_block_starts = row_starts;
+	A->column_block_starts = column_starts;
+	return (MATRIX) A;
+
+fail:
+	free(row_starts);
+	free(column_starts);
+	return NULL;
+}
+
+MATRIX F(sparse_matrix_block_create)(sparse_dimension __Mb, sparse_dimension __Nb, sparse_dimension __k, sparse_dimension __l)
+{
+	return PFX(block_create)(__Mb, __Nb, __k, __l, NULL, NULL);
+}
+
+MATRIX F(sparse_matrix_variable_block_create)(sparse_dimension __Mb, sparse_dimension __Nb, const sparse_dimension *__K, const sparse_dimension *__L)
+{
+	if (!__K || !__L)
+		return NULL;
+	return PFX(block_create)(__Mb, __Nb, 0, 0, __K, __L);
+}
+
+// Appends entries without checking them, space must have been reserved
+static inline void PFX(push)(struct sparse_matrix* A, REAL value, sparse_index i, sparse_index j)
+{
+	A->pending_rows[A->pending] = i;
+	A->pending_columns[A->pending] = j;
+	((REAL*) A->pending_values)[A->pending] = value;
+	A->pending++;
+}
+
+static inline bool PFX(in_range)(const struct sparse_matrix* A, sparse_index i, sparse_index j)
+{
+	return i >= 0 && j >= 0 && i < (sparse_index) A->rows && j < (sparse_index) A->columns;
+}
+
+sparse_status F(sparse_insert_entry)(MATRIX __A, REAL __val, sparse_index __i, sparse_index __j)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || !PFX(in_range)(A, __i, __j))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (!sparse_reserve_pending(A, 1))
+		return SPARSE_SYSTEM_ERROR;
+
+	PFX(push)(A, __val, __i, __j);
+	return SPARSE_SUCCESS;
+}
+
+sparse_status F(sparse_insert_entries)(MATRIX __A, sparse_dimension __N, const REAL *__val, const sparse_index *__indx, const sparse_index *__jndx)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || (__N && (!__val || !__indx || !__jndx)))
+		return SPARSE_ILLEGAL_PARAMETER;
+	for (sparse_dimension k = 0; k < __N; k++)
+	{
+		if (!PFX(in_range)(A, __indx[k], __jndx[k]))
+			return SPARSE_ILLEGAL_PARAMETER;
+	}
+	if (!sparse_reserve_pending(A, __N))
+		return SPARSE_SYSTEM_ERROR;
+
+	for (sparse_dimension k = 0; k < __N; k++)
+		PFX(push)(A, __val[k], __indx[k], __jndx[k]);
+	return SPARSE_SUCCESS;
+}
+
+sparse_status F(sparse_insert_col)(MATRIX __A, sparse_index __j, sparse_dimension __nz, const REAL *__val, const sparse_index *__indx)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || (__nz && (!__val || !__indx)))
+		return SPARSE_ILLEGAL_PARAMETER;
+	for (sparse_dimension k = 0; k < __nz; k++)
+	{
+		if (!PFX(in_range)(A, __indx[k], __j))
+			return SPARSE_ILLEGAL_PARAMETER;
+	}
+	if (!sparse_reserve_pending(A, __nz))
+		return SPARSE_SYSTEM_ERROR;
+
+	for (sparse_dimension k = 0; k < __nz; k++)
+		PFX(push)(A, __val[k], __indx[k], __j);
+	return SPARSE_SUCCESS;
+}
+
+sparse_status F(sparse_insert_row)(MATRIX __A, sparse_index __i, sparse_dimension __nz, const REAL *__val, const sparse_index *__jndx)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || (__nz && (!__val || !__jndx)))
+		return SPARSE_ILLEGAL_PARAMETER;
+	for (sparse_dimension k = 0; k < __nz; k++)
+	{
+		if (!PFX(in_range)(A, __i, __jndx[k]))
+			return SPARSE_ILLEGAL_PARAMETER;
+	}
+	if (!sparse_reserve_pending(A, __nz))
+		return SPARSE_SYSTEM_ERROR;
+
+	for (sparse_dimension k = 0; k < __nz; k++)
+		PFX(push)(A, __val[k], __i, __jndx[k]);
+	return SPARSE_SUCCESS;
+}
+
+sparse_status F(sparse_insert_block)(MATRIX __A, const REAL *__val, sparse_dimension __row_stride, sparse_dimension __col_stride, sparse_index __bi, sparse_index __bj)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || !__val || A->block_rows == 0)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__bi < 0 || __bj < 0 || __bi >= (sparse_index) A->block_rows || __bj >= (sparse_index) A->block_columns)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	const sparse_index r0 = A->row_block_starts[__bi], r1 = A->row_block_starts[__bi + 1];
+	const sparse_index c0 = A->column_block_starts[__bj], c1 = A->column_block_starts[__bj + 1];
+
+	if (!sparse_reserve_pending(A, (size_t) (r1 - r0) * (size_t) (c1 - c0)))
+		return SPARSE_SYSTEM_ERROR;
+
+	for (sparse_index i = r0; i < r1; i++)
+	{
+		for (sparse_index j = c0; j < c1; j++)
+			PFX(push)(A, __val[(i - r0) * __row_stride + (j - c0) * __col_stride], i, j);
+	}
+	return SPARSE_SUCCESS;
+}
+
+sparse_index F(sparse_extract_sparse_row)(MATRIX __A, sparse_index __row, sparse_index __column_start, sparse_index *__column_end, sparse_dimension __nz, REAL *__val, sparse_index *__jndx)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || !__column_end || __row < 0 || __row >= (sparse_index) A->rows || __column_start < 0)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__nz && (!__val || !__jndx))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+
+	const REAL* values = (const REAL*) A->values;
+	sparse_index k = A->row_starts[__row];
+	const sparse_index end = A->row_starts[__row + 1];
+	sparse_index count = 0;
+
+	while (k < end && A->column_indices[k] < __column_start)
+		k++;
+	for (; k < end && (sparse_dimension) count < __nz; k++, count++)
+	{
+		__val[count] = values[k];
+		__jndx[count] = A->column_indices[k];
+	}
+
+	*__column_end = (k < end) ? A->column_indices[k] : (sparse_index) A->columns;
+	return count;
+}
+
+sparse_index F(sparse_extract_sparse_column)(MATRIX __A, sparse_index __column, sparse_index __row_start, sparse_index *__row_end, sparse_dimension __nz, REAL *__val, sparse_index *__indx)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || !__row_end || __column < 0 || __column >= (sparse_index) A->columns || __row_start < 0)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__nz && (!__val || !__indx))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+
+	const REAL* values = (const REAL*) A->values;
+	sparse_index count = 0;
+	sparse_index i;
+
+	*__row_end = (sparse_index) A->rows;
+	for (i = __row_start; i < (sparse_index) A->rows; i++)
+	{
+		const sparse_index k = sparse_find_entry(A, i, __column);
+		if (k < 0)
+			continue;
+		if ((sparse_dimension) count == __nz)
+		{
+			*__row_end = i;
+			break;
+		}
+
+		__val[count] = values[k];
+		__indx[count] = i;
+		count++;
+	}
+
+	return count;
+}
+
+sparse_status F(sparse_extract_block)(MATRIX __A, sparse_index __bi, sparse_index __bj, sparse_dimension __row_stride, sparse_dimension __col_stride, REAL *__val)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || !__val || A->block_rows == 0)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__bi < 0 || __bj < 0 || __bi >= (sparse_index) A->block_rows || __bj >= (sparse_index) A->block_columns)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (sparse_commit(A) != SPARSE_SUCCESS)
+		return SPARSE_SYSTEM_ERROR;
+
+	const REAL* values = (const REAL*) A->values;
+	const sparse_index r0 = A->row_block_starts[__bi], r1 = A->row_block_starts[__bi + 1];
+	const sparse_index c0 = A->column_block_starts[__bj], c1 = A->column_block_starts[__bj + 1];
+
+	for (sparse_index i = r0; i < r1; i++)
+	{
+		for (sparse_index j = c0; j < c1; j++)
+			__val[(i - r0) * __row_stride + (j - c0) * __col_stride] = 0;
+
+		for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+		{
+			const sparse_index j = A->column_indices[k];
+			if (j >= c0 && j < c1)
+				__val[(i - r0) * __row_stride + (j - c0) * __col_stride] = values[k];
+		}
+	}
+
+	return SPARSE_SUCCESS;
+}
+
+// The 2-norm of n values without overflowing, scaled by their largest magnitude
+static REAL PFX(norm2)(const REAL* x, size_t n)
+{
+	REAL scale = 0, sum = 0;
+
+	for (size_t k = 0; k < n; k++)
+	{
+		const REAL a = ABS(x[k]);
+		if (a > scale)
+			scale = a;
+	}
+	if (scale == 0 || !isfinite(scale))
+		return scale;
+
+	for (size_t k = 0; k < n; k++)
+	{
+		const REAL a = x[k] / scale;
+		sum += a * a;
+	}
+	return scale * SQRT(sum);
+}
+
+REAL F(sparse_elementwise_norm)(MATRIX __A, sparse_norm __norm)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || sparse_commit(A) != SPARSE_SUCCESS)
+		return NAN;
+
+	const REAL* values = (const REAL*) A->values;
+	const size_t nnz = (size_t) A->row_starts[A->rows];
+	REAL result = 0;
+
+	switch (__norm)
+	{
+		case SPARSE_NORM_ONE:
+			for (size_t k = 0; k < nnz; k++)
+				result += ABS(values[k]);
+			return result;
+		case SPARSE_NORM_TWO:
+			return PFX(norm2)(values, nnz);
+		case SPARSE_NORM_INF:
+			for (size_t k = 0; k < nnz; k++)
+			{
+				if (ABS(values[k]) > result)
+					result = ABS(values[k]);
+			}
+			return result;
+		case SPARSE_NORM_R1:
+			for (sparse_dimension i = 0; i < A->rows; i++)
+				result += PFX(norm2)(values + A->row_starts[i], A->row_starts[i + 1] - A->row_starts[i]);
+			return result;
+		default:
+			return NAN;
+	}
+}
+
+REAL F(sparse_operator_norm)(MATRIX __A, sparse_norm __norm)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || sparse_commit(A) != SPARSE_SUCCESS)
+		return NAN;
+
+	const REAL* values = (const REAL*) A->values;
+	REAL result = 0;
+
+	if (__norm == SPARSE_NORM_INF)
+	{
+		// the largest absolute row sum
+		for (sparse_dimension i = 0; i < A->rows; i++)
+		{
+			REAL sum = 0;
+			for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+				sum += ABS(values[k]);
+			if (sum > result)
+				result = sum;
+		}
+		return result;
+	}
+	else if (__norm == SPARSE_NORM_ONE)
+	{
+		// the largest absolute column sum
+		REAL* sums = (REAL*) calloc(A->columns, sizeof(REAL));
+		if (!sums)
+			return NAN;
+
+		for (sparse_index k = 0; k < A->row_starts[A->rows]; k++)
+			sums[A->column_indices[k]] += ABS(values[k]);
+		for (sparse_dimension j = 0; j < A->columns; j++)
+		{
+			if (sums[j] > result)
+				result = sums[j];
+		}
+
+		free(sums);
+		return result;
+	}
+
+	return NAN;
+}
+
+REAL F(sparse_matrix_trace)(MATRIX __A, sparse_index __offset)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+
+	if (!A || sparse_commit(A) != SPARSE_SUCCESS)
+		return NAN;
+
+	const REAL* values = (const REAL*) A->values;
+	REAL result = 0;
+
+	for (sparse_index i = (__offset < 0) ? -__offset : 0; i < (sparse_index) A->rows; i++)
+	{
+		if (i + __offset >= (sparse_index) A->columns)
+			break;
+
+		const sparse_index k = sparse_find_entry(A, i, i + __offset);
+		if (k >= 0)
+			result += values[k];
+	}
+
+	return result;
+}
+
+// Whether perm is a permutation of [0, n)
+static bool PFX(is_permutation)(const sparse_index* perm, sparse_dimension n)
+{
+	bool* seen = (bool*) calloc(n, sizeof(bool));
+	bool ok = seen != NULL;
+
+	for (sparse_dimension i = 0; ok && i < n; i++)
+	{
+		if (perm[i] < 0 || perm[i] >= (sparse_index) n || seen[perm[i]])
+			ok = false;
+		else
+			seen[perm[i]] = true;
+	}
+
+	free(seen);
+	return ok;
+}
+
+// A triangular or symmetric matrix wouldn't be one after the permutation
+static sparse_status PFX(check_permutable)(struct sparse_matrix* A, const sparse_index* perm, sparse_dimension n)
+{
+	if (!A || !perm || (A->properties & (SPARSE_TRIANGULAR | SPARSE_SYMMETRIC)))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (!PFX(is_permutation)(perm, n))
+		return SPARSE_ILLEGAL_PARAMETER;
+	return sparse_commit(A);
+}
+
+sparse_status F(sparse_permute_rows)(MATRIX __A, const sparse_index *__perm)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+	sparse_status status = PFX(check_permutable)(A, __perm, A ? A->rows : 0);
+
+	if (status != SPARSE_SUCCESS)
+		return status;
+
+	const sparse_index rows = (sparse_index) A->rows;
+	const size_t nnz = (size_t) A->row_starts[rows];
+	sparse_index* starts = (sparse_index*) malloc((rows + 1) * sizeof(sparse_index));
+	sparse_index* columns = (sparse_index*) malloc((nnz ? nnz : 1) * sizeof(sparse_index));
+	REAL* values = (REAL*) malloc((nnz ? nnz : 1) * sizeof(REAL));
+
+	if (!starts || !columns || !values)
+	{
+		free(starts);
+		free(columns);
+		free(values);
+		return SPARSE_SYSTEM_ERROR;
+	}
+
+	// row i becomes row perm[i]
+	starts[0] = 0;
+	for (sparse_index i = 0; i < rows; i++)
+		starts[__perm[i] + 1] = A->row_starts[i + 1] - A->row_starts[i];
+	for (sparse_index i = 0; i < rows; i++)
+		starts[i + 1] += starts[i];
+	for (sparse_index i = 0; i < rows; i++)
+	{
+		const sparse_index first = A->row_starts[i], count = A->row_starts[i + 1] - first;
+		memcpy(columns + starts[__perm[i]], A->column_indices + first, count * sizeof(sparse_index));
+		memcpy(values + starts[__perm[i]], (const REAL*) A->values + first, count * sizeof(REAL));
+	}
+
+	sparse_set_rows(A, starts, columns, values, A->stored);
+	return SPARSE_SUCCESS;
+}
+
+struct PFX(column_value)
+{
+	sparse_index column;
+	REAL value;
+};
+
+static int PFX(compare_columns)(const void* a, const void* b)
+{
+	const sparse_index x = ((const struct PFX(column_value)*) a)->column;
+	const sparse_index y = ((const struct PFX(column_value)*) b)->column;
+	return (x > y) - (x < y);
+}
+
+sparse_status F(sparse_permute_cols)(MATRIX __A, const sparse_index *__perm)
+{
+	struct sparse_matrix* A = PFX(matrix)(__A);
+	sparse_status status = PFX(check_permutable)(A, __perm, A ? A->columns : 0);
+
+	if (status != SPARSE_SUCCESS)
+		return status;
+
+	REAL* values = (REAL*) A->values;
+	sparse_index longest = 0;
+
+	for (sparse_dimension i = 0; i < A->rows; i++)
+	{
+		if (A->row_starts[i + 1] - A->row_starts[i] > longest)
+			longest = A->row_starts[i + 1] - A->row_starts[i];
+	}
+
+	struct PFX(column_value)* row = (struct PFX(column_value)*) malloc((longest ? longest : 1) * sizeof(*row));
+	if (!row)
+		return SPARSE_SYSTEM_ERROR;
+
+	// column j becomes column perm[j], each row is sorted again
+	for (sparse_dimension i = 0; i < A->rows; i++)
+	{
+		const sparse_index first = A->row_starts[i], count = A->row_starts[i + 1] - first;
+
+		for (sparse_index k = 0; k < count; k++)
+		{
+			row[k].column = __perm[A->column_indices[first + k]];
+			row[k].value = values[first + k];
+		}
+		qsort(row, count, sizeof(*row), PFX(compare_columns));
+		for (sparse_index k = 0; k < count; k++)
+		{
+			A->column_indices[first + k] = row[k].column;
+			values[first + k] = row[k].value;
+		}
+	}
+
+	free(row);
+	return SPARSE_SUCCESS;
+}
@@ -0,0 +1,645 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Products with dense and sparse operands and triangular solves, included by product.c
+// through sparseblas_instantiate.h.
+//
+// Rows of A are split across threads so that each task gets about the same number of entries.
+// A product with A^T scatters into its output instead, each task into a private copy that is
+// summed up at the end, or goes through an explicit transpose when it has several columns.
+
+static struct sparse_matrix* PFX(product_matrix)(MATRIX handle)
+{
+	struct sparse_matrix* A = (struct sparse_matrix*) handle;
+
+	if (!A || A->is_double != IS_DOUBLE || sparse_commit(A) != SPARSE_SUCCESS)
+		return NULL;
+	return A;
+}
+
+struct PFX(spmv_job)
+{
+	const struct sparse_matrix* A;
+	REAL alpha;
+	const REAL* x;
+	ptrdiff_t incx;
+	REAL* y;
+	ptrdiff_t incy;
+	size_t tasks;
+	// transposed products: one row of A->columns partial sums per task
+	REAL* partial;
+};
+
+static void PFX(spmv_rows)(void* ctx, size_t task)
+{
+	const struct PFX(spmv_job)* job = (const struct PFX(spmv_job)*) ctx;
+	const struct sparse_matrix* A = job->A;
+	const REAL* values = (const REAL*) A->values;
+	const sparse_index first = sparse_task_first_row(A, task, job->tasks);
+	const sparse_index last = sparse_task_first_row(A, task + 1, job->tasks);
+
+	for (sparse_index i = first; i < last; i++)
+	{
+		REAL sum = 0;
+		for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+			sum += values[k] * job->x[A->column_indices[k] * job->incx];
+		job->y[i * job->incy] += job->alpha * sum;
+	}
+}
+
+static void PFX(spmv_scatter)(void* ctx, size_t task)
+{
+	const struct PFX(spmv_job)* job = (const struct PFX(spmv_job)*) ctx;
+	const struct sparse_matrix* A = job->A;
+	const REAL* values = (const REAL*) A->values;
+	const sparse_index first = sparse_task_first_row(A, task, job->tasks);
+	const sparse_index last = sparse_task_first_row(A, task + 1, job->tasks);
+	REAL* out = job->partial + task * A->columns;
+
+	memset(out, 0, A->columns * sizeof(REAL));
+	for (sparse_index i = first; i < last; i++)
+	{
+		const REAL xi = job->x[i * job->incx];
+		if (xi == 0)
+			continue;
+		for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+			out[A->column_indices[k]] += values[k] * xi;
+	}
+}
+
+static void PFX(spmv_reduce)(void* ctx, size_t task)
+{
+	const struct PFX(spmv_job)* job = (const struct PFX(spmv_job)*) ctx;
+	const size_t n = job->A->columns;
+	const size_t first = n * task / job->tasks, last = n * (task + 1) / job->tasks;
+
+	for (size_t j = first; j < last; j++)
+	{
+		REAL sum = 0;
+		for (size_t t = 0; t < job->tasks; t++)
+			sum += job->partial[t * n + j];
+		job->y[(ptrdiff_t) j * job->incy] += job->alpha * sum;
+	}
+}
+
+sparse_status F(sparse_matrix_vector_product_dense)(enum CBLAS_TRANSPOSE __transa, REAL __alpha, MATRIX __A, const REAL *__x, sparse_stride __incx, REAL *__y, sparse_stride __incy)
+{
+	struct sparse_matrix* A = PFX(product_matrix)(__A);
+
+	if (!A || !__x || !__y || __incx == 0 || __incy == 0)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__transa != CblasNoTrans && __transa != CblasTrans && __transa != CblasConjTrans)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	const bool trans = __transa != CblasNoTrans;
+	const size_t nnz = (size_t) A->row_starts[A->rows];
+	struct PFX(spmv_job) job = {
+		.A = A,
+		.alpha = __alpha,
+		.x = __x + sparse_stride_origin(trans ? A->rows : A->columns, __incx),
+		.incx = __incx,
+		.y = __y + sparse_stride_origin(trans ? A->columns : A->rows, __incy),
+		.incy = __incy,
+	};
+
+	if (__alpha == 0 || nnz == 0)
+		return SPARSE_SUCCESS;
+
+	if (!trans)
+	{
+		job.tasks = sparse_task_count(nnz);
+		sparse_parallel_for(job.tasks, &job, PFX(spmv_rows));
+		return SPARSE_SUCCESS;
+	}
+
+	// every task needs its own output, don't take more of them than there are entries to fill
+	job.tasks = sparse_task_count(nnz);
+	while (job.tasks > 1 && job.tasks * A->columns > 2 * nnz)
+		job.tasks--;
+
+	job.partial = (REAL*) malloc(job.tasks * A->columns * sizeof(REAL));
+	if (!job.partial)
+		return SPARSE_SYSTEM_ERROR;
+
+	sparse_parallel_for(job.tasks, &job, PFX(spmv_scatter));
+	sparse_parallel_for(job.tasks, &job, PFX(spmv_reduce));
+
+	free(job.partial);
+	return SPARSE_SUCCESS;
+}
+
+// The rows of A^T, for products that would otherwise scatter more than once
+static struct sparse_matrix* PFX(transpose)(const struct sparse_matrix* A)
+{
+	const size_t nnz = (size_t) A->row_starts[A->rows];
+	struct sparse_matrix* T = sparse_matrix_new(IS_DOUBLE, A->columns, A->rows);
+	sparse_index* starts = (sparse_index*) calloc(A->columns + 1, sizeof(sparse_index));
+	sparse_index* columns = (sparse_index*) malloc((nnz ? nnz : 1) * sizeof(sparse_index));
+	REAL* values = (REAL*) malloc((nnz ? nnz : 1) * sizeof(REAL));
+
+	if (!T || !starts || !columns || !values)
+	{
+		if (T)
+			sparse_matrix_destroy(T);
+		free(starts);
+		free(columns);
+		free(values);
+		return NULL;
+	}
+
+	for (size_t k = 0; k < nnz; k++)
+		starts[A->column_indices[k] + 1]++;
+	for (sparse_dimension j = 0; j < A->columns; j++)
+		starts[j + 1] += starts[j];
+
+	// going through the rows in order leaves the columns of T sorted
+	for (sparse_dimension i = 0; i < A->rows; i++)
+	{
+		for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+		{
+			const sparse_index dst = starts[A->column_indices[k]]++;
+			columns[dst] = (sparse_index) i;
+			values[dst] = ((const REAL*) A->values)[k];
+		}
+	}
+	for (sparse_dimension j = A->columns; j > 0; j--)
+		starts[j] = starts[j - 1];
+	starts[0] = 0;
+
+	sparse_set_rows(T, starts, columns, values, nnz);
+	return T;
+}
+
+struct PFX(spmm_job)
+{
+	const struct sparse_matrix* A;
+	bool row_major;
+	size_t n;
+	REAL alpha;
+	const REAL* B;
+	size_t ldb;
+	REAL* C;
+	size_t ldc;
+	size_t tasks;
+};
+
+// Columns of a column-major B handled together, so that A is read once per group
+#define SPARSEBLAS_SPMM_GROUP 8
+
+static void PFX(spmm_rows)(void* ctx, size_t task)
+{
+	const struct PFX(spmm_job)* job = (const struct PFX(spmm_job)*) ctx;
+	const struct sparse_matrix* A = job->A;
+	const REAL* values = (const REAL*) A->values;
+	const sparse_index first = sparse_task_first_row(A, task, job->tasks);
+	const sparse_index last = sparse_task_first_row(A, task + 1, job->tasks);
+	const size_t n = job->n;
+
+	for (sparse_index i = first; i < last; i++)
+	{
+		if (job->row_major)
+		{
+			REAL* c = job->C + i * job->ldc;
+			for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+			{
+				const REAL v = job->alpha * values[k];
+				const REAL* b = job->B + A->column_indices[k] * job->ldb;
+				for (size_t col = 0; col < n; col++)
+					c[col] += v * b[col];
+			}
+			continue;
+		}
+
+		for (size_t c0 = 0; c0 < n; c0 += SPARSEBLAS_SPMM_GROUP)
+		{
+			const size_t count = (n - c0 < SPARSEBLAS_SPMM_GROUP) ? n - c0 : SPARSEBLAS_SPMM_GROUP;
+			REAL sum[SPARSEBLAS_SPMM_GROUP] = { 0 };
+
+			for (sparse_index k = A->row_starts[i]; k < A->row_starts[i + 1]; k++)
+			{
+				const REAL v = values[k];
+				const REAL* b = job->B + A->column_indices[k] + c0 * job->ldb;
+				for (size_t col = 0; col < count; col++)
+					sum[col] += v * b[col * job->ldb];
+			}
+			for (size_t col = 0; col < count; col++)
+				job->C[i + (c0 + col) * job->ldc] += job->alpha * sum[col];
+		}
+	}
+}
+
+sparse_status F(sparse_matrix_product_dense)(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transa, sparse_dimension __n, REAL __alpha, MATRIX __A, const REAL *__B, sparse_dimension __ldb, REAL *__C, sparse_dimension __ldc)
+{
+	struct sparse_matrix* A = PFX(product_matrix)(__A);
+
+	if (!A || !__B || !__C || (__order != CblasRowMajor && __order != CblasColMajor))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__transa != CblasNoTrans && __transa != CblasTrans && __transa != CblasConjTrans)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	const bool trans = __transa != CblasNoTrans;
+	const sparse_dimension m = trans ? A->columns : A->rows, k = trans ? A->rows : A->columns;
+	const bool row_major = __order == CblasRowMajor;
+
+	if (row_major ? (__ldb < __n || __ldc < __n) : (__ldb < k || __ldc < m))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__n == 0 || __alpha == 0)
+		return SPARSE_SUCCESS;
+
+	struct sparse_matrix* T = NULL;
+	if (trans)
+	{
+		T = PFX(transpose)(A);
+		if (!T)
+			return SPARSE_SYSTEM_ERROR;
+	}
+
+	struct PFX(spmm_job) job = {
+		.A = T ? T : A,
+		.row_major = row_major,
+		.n = __n,
+		.alpha = __alpha,
+		.B = __B,
+		.ldb = __ldb,
+		.C = __C,
+		.ldc = __ldc,
+	};
+
+	job.tasks = sparse_task_count((size_t) A->row_starts[A->rows] * __n);
+	if (job.tasks > m)
+		job.tasks = m;
+	sparse_parallel_for(job.tasks, &job, PFX(spmm_rows));
+
+	if (T)
+		sparse_matrix_destroy(T);
+	return SPARSE_SUCCESS;
+}
+
+struct PFX(spgemm_job)
+{
+	const struct sparse_matrix* A;
+	const struct sparse_matrix* B;
+	REAL alpha;
+	size_t tasks;
+	// first pass: the number of entries of each row of the product, second pass: where they go
+	sparse_index* starts;
+	sparse_index* columns;
+	REAL* values;
+	bool failed;
+};
+
+static int PFX(compare_index)(const void* a, const void* b)
+{
+	const sparse_index x = *(const sparse_index*) a, y = *(const sparse_index*) b;
+	return (x > y) - (x < y);
+}
+
+// Counts (values == NULL) or computes the rows of A * B of this task, Gustavson's way
+static void PFX(spgemm_rows)(void* ctx, size_t task)
+{
+	struct PFX(spgemm_job)* job = (struct PFX(spgemm_job)*) ctx;
+	const struct sparse_matrix* A = job->A;
+	const struct sparse_matrix* B = job->B;
+	const REAL* a_values = (const REAL*) A->values;
+	const REAL* b_values = (const REAL*) B->values;
+	const sparse_index first = sparse_task_first_row(A, task, job->tasks);
+	const sparse_index last = sparse_task_first_row(A, task + 1, job->tasks);
+	const bool count_only = job->values == NULL;
+
+	// the row of the product that a column was last seen in, and its sum
+	sparse_index* seen = (sparse_index*) malloc(B->columns * sizeof(sparse_index));
+	REAL* sum = count_only ? NULL : (REAL*) malloc(B->columns * sizeof(REAL));
+
+	if (!seen || (!count_only && !sum))
+	{
+		job->failed = true;
+		free(seen);
+		free(sum);
+		return;
+	}
+	for (sparse_dimension j = 0; j < B->columns; j++)
+		seen[j] = -1;
+
+	for (sparse_index i = first; i < last; i++)
+	{
+		sparse_index count = 0;
+		sparse_index* row = count_only ? NULL : job->columns + job->starts[i];
+
+		for (sparse_index ka = A->row_starts[i]; ka < A->row_starts[i + 1]; ka++)
+		{
+			const sparse_index p = A->column_indices[ka];
+			for (sparse_index kb = B->row_starts[p]; kb < B->row_starts[p + 1]; kb++)
+			{
+				const sparse_index j = B->column_indices[kb];
+				if (seen[j] != i)
+				{
+					seen[j] = i;
+					if (!count_only)
+					{
+						row[count] = j;
+						sum[j] = 0;
+					}
+					count++;
+				}
+				if (!count_only)
+					sum[j] += a_values[ka] * b_values[kb];
+			}
+		}
+
+		if (count_only)
+		{
+			job->starts[i + 1] = count;
+			continue;
+		}
+
+		qsort(row, count, sizeof(sparse_index), PFX(compare_index));
+		for (sparse_index k = 0; k < count; k++)
+			job->values[job->starts[i] + k] = job->alpha * sum[row[k]];
+	}
+
+	free(seen);
+	free(sum);
+}
+
+MATRIX F(sparse_matrix_product_sparse)(enum CBLAS_TRANSPOSE __transa, REAL __alpha, MATRIX __A, MATRIX __B)
+{
+	struct sparse_matrix* A = PFX(product_matrix)(__A);
+	struct sparse_matrix* B = PFX(product_matrix)(__B);
+
+	if (!A || !B || (__transa != CblasNoTrans && __transa != CblasTrans && __transa != CblasConjTrans))
+		return NULL;
+
+	const bool trans = __transa != CblasNoTrans;
+	if ((trans ? A->rows : A->columns) != B->rows)
+		return NULL;
+
+	struct sparse_matrix* T = trans ? PFX(transpose)(A) : NULL;
+	struct sparse_matrix* C = sparse_matrix_new(IS_DOUBLE, trans ? A->columns : A->rows, B->columns);
+	struct PFX(spgemm_job) job = {
+		.A = T ? T : A,
+		.B = B,
+		.alpha = __alpha,
+	};
+
+	if ((trans && !T) || !C)
+		goto fail;
+
+	job.starts = (sparse_index*) calloc(C->rows + 1, sizeof(sparse_index));
+	if (!job.starts)
+		goto fail;
+
+	// the work of a row is about the entries of B it touches, A's entry count is a fair proxy
+	job.tasks = sparse_task_count((size_t) job.A->row_starts[job.A->rows] * 4);
+	sparse_parallel_for(job.tasks, &job, PFX(spgemm_rows));
+	if (job.failed)
+		goto fail;
+
+	for (sparse_dimension i = 0; i < C->rows; i++)
+		job.starts[i + 1] += job.starts[i];
+
+	const size_t nnz = (size_t) job.starts[C->rows];
+	job.columns = (sparse_index*) malloc((nnz ? nnz : 1) * sizeof(sparse_index));
+	job.values = (REAL*) malloc((nnz ? nnz : 1) * sizeof(REAL));
+	if (!job.columns || !job.values)
+		goto fail;
+
+	sparse_parallel_for(job.tasks, &job, PFX(spgemm_rows));
+	if (job.failed)
+		goto fail;
+
+	sparse_set_rows(C, job.starts, job.columns, job.values, nnz);
+	if (T)
+		sparse_matrix_destroy(T);
+	return (MATRIX) C;
+
+fail:
+	free(job.starts);
+	free(job.columns);
+	free(job.values);
+	if (C)
+		sparse_matrix_destroy(C);
+	if (T)
+		sparse_matrix_destroy(T);
+	return NULL;
+}
+
+sparse_status F(sparse_outer_product_dense)(sparse_dimension __M, sparse_dimension __N, sparse_dimension __nz, REAL __alpha, const REAL *__x, sparse_stride __incx, const REAL *__y, const sparse_index *__indy, MATRIX *__C)
+{
+	if (!__C || !__x || __incx == 0 || (__nz && (!__y || !__indy)))
+		return SPARSE_ILLEGAL_PARAMETER;
+	for (sparse_dimension k = 0; k < __nz; k++)
+	{
+		if (__indy[k] < 0 || (sparse_dimension) __indy[k] >= __N)
+			return SPARSE_ILLEGAL_PARAMETER;
+	}
+
+	const bool created = *__C == NULL;
+	struct sparse_matrix* C = created ? sparse_matrix_new(IS_DOUBLE, __M, __N) : PFX(product_matrix)(*__C);
+
+	if (!C)
+		return created ? SPARSE_SYSTEM_ERROR : SPARSE_ILLEGAL_PARAMETER;
+	if (C->rows != __M || C->columns != __N || (C->properties & SPARSE_SYMMETRIC))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (created && sparse_commit(C) != SPARSE_SUCCESS)
+	{
+		sparse_matrix_destroy(C);
+		return SPARSE_SYSTEM_ERROR;
+	}
+
+	const REAL* x = __x + sparse_stride_origin(__M, __incx);
+	REAL* values = (REAL*) C->values;
+
+	// existing entries are updated in place, the others are inserted
+	for (sparse_dimension i = 0; i < __M; i++)
+	{
+		const REAL xi = __alpha * x[(ptrdiff_t) i * __incx];
+		if (xi == 0)
+			continue;
+
+		for (sparse_dimension k = 0; k < __nz; k++)
+		{
+			if (!sparse_entry_referenced(C, (sparse_index) i, __indy[k]))
+				continue;
+
+			const sparse_index at = sparse_find_entry(C, (sparse_index) i, __indy[k]);
+			if (at >= 0)
+				values[at] += xi * __y[k];
+			else
+			{
+				if (!sparse_reserve_pending(C, 1))
+				{
+					if (created)
+						sparse_matrix_destroy(C);
+					return SPARSE_SYSTEM_ERROR;
+				}
+				C->pending_rows[C->pending] = (sparse_index) i;
+				C->pending_columns[C->pending] = __indy[k];
+				((REAL*) C->pending_values)[C->pending] = xi * __y[k];
+				C->pending++;
+			}
+		}
+	}
+
+	*__C = (MATRIX) C;
+	return SPARSE_SUCCESS;
+}
+
+// x = op(T)^-1 * x for the n values of x at stride inc
+static void PFX(triangular_solve)(const struct sparse_matrix* T, bool trans, REAL* x, ptrdiff_t inc)
+{
+	const REAL* values = (const REAL*) T->values;
+	const sparse_index n = (sparse_index) T->rows;
+	const bool lower = (T->properties & SPARSE_LOWER_TRIANGULAR) != 0;
+
+	// the diagonal is the last entry of a row of L and the first one of a row of U, rows
+	// without it have a zero there
+	#define DIAGONAL(i) (lower \
+		? ((T->row_starts[(i) + 1] > T->row_starts[i] && T->column_indices[T->row_starts[(i) + 1] - 1] == (i)) ? values[T->row_starts[(i) + 1] - 1] : 0) \
+		: ((T->row_starts[(i) + 1] > T->row_starts[i] && T->column_indices[T->row_starts[i]] == (i)) ? values[T->row_starts[i]] : 0))
+
+	if (lower != trans)
+	{
+		// L x = b or U^T x = b: forward
+		for (sparse_index i = 0; i < n; i++)
+		{
+			if (!trans)
+			{
+				REAL s = x[i * inc];
+				for (sparse_index k = T->row_starts[i]; k < T->row_starts[i + 1] && T->column_indices[k] < i; k++)
+					s -= values[k] * x[T->column_indices[k] * inc];
+				x[i * inc] = s / DIAGONAL(i);
+			}
+			else
+			{
+				const REAL xi = x[i * inc] / DIAGONAL(i);
+				x[i * inc] = xi;
+				for (sparse_index k = T->row_starts[i]; k < T->row_starts[i + 1]; k++)
+				{
+					if (T->column_indices[k] > i)
+						x[T->column_indices[k] * inc] -= values[k] * xi;
+				}
+			}
+		}
+	}
+	else
+	{
+		// U x = b or L^T x = b: backward
+		for (sparse_index i = n - 1; i >= 0; i--)
+		{
+			if (!trans)
+			{
+				REAL s = x[i * inc];
+				for (sparse_index k = T->row_starts[i + 1] - 1; k >= T->row_starts[i] && T->column_indices[k] > i; k--)
+					s -= values[k] * x[T->column_indices[k] * inc];
+				x[i * inc] = s / DIAGONAL(i);
+			}
+			else
+			{
+				const REAL xi = x[i * inc] / DIAGONAL(i);
+				x[i * inc] = xi;
+				for (sparse_index k = T->row_starts[i]; k < T->row_starts[i + 1]; k++)
+				{
+					if (T->column_indices[k] < i)
+						x[T->column_indices[k] * inc] -= values[k] * xi;
+				}
+			}
+		}
+	}
+
+	#undef DIAGONAL
+}
+
+sparse_status F(sparse_vector_triangular_solve_dense)(enum CBLAS_TRANSPOSE __transt, REAL __alpha, MATRIX __T, REAL *__x, sparse_stride __incx)
+{
+	struct sparse_matrix* T = PFX(product_matrix)(__T);
+
+	if (!T || !__x || __incx == 0 || !(T->properties & SPARSE_TRIANGULAR))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__transt != CblasNoTrans && __transt != CblasTrans && __transt != CblasConjTrans)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	REAL* x = __x + sparse_stride_origin(T->rows, __incx);
+
+	if (__alpha != 1)
+	{
+		for (sparse_dimension i = 0; i < T->rows; i++)
+			x[(ptrdiff_t) i * __incx] *= __alpha;
+	}
+	PFX(triangular_solve)(T, __transt != CblasNoTrans, x, __incx);
+	return SPARSE_SUCCESS;
+}
+
+struct PFX(trsm_job)
+{
+	const struct sparse_matrix* T;
+	bool trans;
+	REAL alpha;
+	REAL* B;
+	// between consecutive values of a right-hand side, and between right-hand sides
+	size_t inc;
+	size_t step;
+	size_t nrhs;
+	size_t tasks;
+};
+
+static void PFX(trsm_columns)(void* ctx, size_t task)
+{
+	const struct PFX(trsm_job)* job = (const struct PFX(trsm_job)*) ctx;
+	const size_t first = job->nrhs * task / job->tasks, last = job->nrhs * (task + 1) / job->tasks;
+
+	for (size_t c = first; c < last; c++)
+	{
+		REAL* x = job->B + c * job->step;
+		if (job->alpha != 1)
+		{
+			for (sparse_dimension i = 0; i < job->T->rows; i++)
+				x[i * job->inc] *= job->alpha;
+		}
+		PFX(triangular_solve)(job->T, job->trans, x, (ptrdiff_t) job->inc);
+	}
+}
+
+sparse_status F(sparse_matrix_triangular_solve_dense)(enum CBLAS_ORDER __order, enum CBLAS_TRANSPOSE __transt, sparse_dimension __nrhs, REAL __alpha, MATRIX __T, REAL *__B, sparse_dimension __ldb)
+{
+	struct sparse_matrix* T = PFX(product_matrix)(__T);
+
+	if (!T || !__B || !(T->properties & SPARSE_TRIANGULAR) || (__order != CblasRowMajor && __order != CblasColMajor))
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__transt != CblasNoTrans && __transt != CblasTrans && __transt != CblasConjTrans)
+		return SPARSE_ILLEGAL_PARAMETER;
+	if (__order == CblasRowMajor ? __ldb < __nrhs : __ldb < T->rows)
+		return SPARSE_ILLEGAL_PARAMETER;
+
+	// the solves are sequential, the right-hand sides are independent
+	struct PFX(trsm_job) job = {
+		.T = T,
+		.trans = __transt != CblasNoTrans,
+		.alpha = __alpha,
+		.B = __B,
+		.inc = (__order == CblasRowMajor) ? __ldb : 1,
+		.step = (__order == CblasRowMajor) ? 1 : __ldb,
+		.nrhs = __nrhs,
+	};
+
+	job.tasks = sparse_task_count((size_t) T->row_starts[T->rows] * __nrhs);
+	if (job.tasks > __nrhs)
+		job.tasks = __nrhs;
+	sparse_parallel_for(job.tasks, &job, PFX(trsm_columns));
+	return SPARSE_SUCCESS;
+}
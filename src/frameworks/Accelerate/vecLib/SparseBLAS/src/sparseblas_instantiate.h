@@ -0,0 +1,60 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Includes SPARSEBLAS_TEMPLATE once for float and once for double, with:
+//   REAL                  the element type
+//   F(name)               the exported name, name_float or name_double
+//   PFX(name)             internal names
+//   MATRIX                sparse_matrix_float or sparse_matrix_double
+//   IS_DOUBLE             whether REAL is double
+//   ABS(x), SQRT(x)
+
+#include <math.h>
+
+#define REAL float
+#define F(name) name##_float
+#define PFX(name) s##name
+#define MATRIX sparse_matrix_float
+#define IS_DOUBLE false
+#define ABS(x) fabsf(x)
+#define SQRT(x) sqrtf(x)
+#include SPARSEBLAS_TEMPLATE
+#undef REAL
+#undef F
+#undef PFX
+#undef MATRIX
+#undef IS_DOUBLE
+#undef ABS
+#undef SQRT
+
+#define REAL double
+#define F(name) name##_double
+#define PFX(name) d##name
+#define MATRIX sparse_matrix_double
+#define IS_DOUBLE true
+#define ABS(x) fabs(x)
+#define SQRT(x) sqrt(x)
+#include SPARSEBLAS_TEMPLATE
+#undef REAL
+#undef F
+#undef PFX
+#undef MATRIX
+#undef IS_DOUBLE
+#undef ABS
+#undef SQRT
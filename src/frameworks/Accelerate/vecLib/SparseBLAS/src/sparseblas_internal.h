@@ -0,0 +1,92 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SPARSEBLAS_INTERNAL_H_
+#define _SPARSEBLAS_INTERNAL_H_
+
+#include <SparseBLAS/SparseBLAS.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Matrices are kept in compressed sparse rows, so that products and solves run row by row
+// and the rows can be split across threads. Insertions go to a list of pending entries that
+// sparse_commit() merges into the rows. Symmetric matrices are kept with both triangles, the
+// one that wasn't stored is mirrored on commit.
+
+struct sparse_matrix
+{
+	bool is_double;
+	unsigned int properties;
+
+	sparse_dimension rows;
+	sparse_dimension columns;
+
+	// block matrices: the number of block rows and columns and the first row (column) of
+	// each of them, block_rows is 0 for matrices of single values
+	sparse_dimension block_rows;
+	sparse_dimension block_columns;
+	sparse_index* row_block_starts;
+	sparse_index* column_block_starts;
+
+	// committed entries, values are float or double
+	sparse_index* row_starts;
+	sparse_index* column_indices;
+	void* values;
+	// entries the client inserted, the mirrored ones of a symmetric matrix aren't counted
+	size_t stored;
+
+	// entries inserted since the last commit, later ones win
+	size_t pending;
+	size_t pending_capacity;
+	sparse_index* pending_rows;
+	sparse_index* pending_columns;
+	void* pending_values;
+};
+
+#define SPARSE_TRIANGULAR (SPARSE_UPPER_TRIANGULAR | SPARSE_LOWER_TRIANGULAR)
+#define SPARSE_SYMMETRIC (SPARSE_UPPER_SYMMETRIC | SPARSE_LOWER_SYMMETRIC)
+
+// matrix.c
+struct sparse_matrix* sparse_matrix_new(bool is_double, sparse_dimension rows, sparse_dimension columns);
+// Makes room for `count` more pending entries
+bool sparse_reserve_pending(struct sparse_matrix* A, size_t count);
+// Whether entry (i, j) is referenced by a matrix with these properties
+bool sparse_entry_referenced(const struct sparse_matrix* A, sparse_index i, sparse_index j);
+// The index in column_indices/values of committed entry (i, j), or -1
+sparse_index sparse_find_entry(const struct sparse_matrix* A, sparse_index i, sparse_index j);
+// Replaces the rows of A, taking ownership of the arrays
+void sparse_set_rows(struct sparse_matrix* A, sparse_index* row_starts, sparse_index* column_indices, void* values, size_t stored);
+
+// parallel.c
+// The number of threads to split work across, from VECLIB_MAXIMUM_THREADS or the CPU count
+size_t sparse_thread_count(void);
+// Runs fn(ctx, task) for task in [0, tasks), concurrently if there's more than one
+void sparse_parallel_for(size_t tasks, void* ctx, void (*fn)(void* ctx, size_t task));
+// How many tasks to split work on `nnz` entries into
+size_t sparse_task_count(size_t nnz);
+// The first row of task `task` out of `tasks` so that each gets about as many entries
+sparse_index sparse_task_first_row(const struct sparse_matrix* A, size_t task, size_t tasks);
+
+// Strided access in BLAS' convention, a negative stride walks the vector backwards
+static inline ptrdiff_t sparse_stride_origin(sparse_dimension n, sparse_stride inc)
+{
+	return (inc < 0) ? -(ptrdiff_t) (n - 1) * inc : 0;
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Operations on sparse vectors and the conversions to and from dense ones, included by
+// vector.c through sparseblas_instantiate.h
+
+REAL F(sparse_inner_product_dense)(sparse_dimension __nz, const REAL *__x, const sparse_index *__indx, const REAL *__y, sparse_stride __incy)
+{
+	REAL sum = 0;
+
+	for (sparse_dimension k = 0; k < __nz; k++)
+		sum += __x[k] * __y[__indx[k] * __incy];
+	return sum;
+}
+
+REAL F(sparse_inner_product_sparse)(sparse_dimension __nzx, sparse_dimension __nzy, const REAL *__x, const sparse_index *__indx, const REAL *__y, const sparse_index *__indy)
+{
+	sparse_dimension kx = 0, ky = 0;
+	REAL sum = 0;
+
+	// both index lists are increasing, walk them together
+	while (kx < __nzx && ky < __nzy)
+	{
+		if (__indx[kx] < __indy[ky])
+			kx++;
+		else if (__indx[kx] > __indy[ky])
+			ky++;
+		else
+			sum += __x[kx++] * __y[ky++];
+	}
+
+	return sum;
+}
+
+void F(sparse_vector_add_with_scale_dense)(sparse_dimension __nz, REAL __alpha, const REAL *__x, const sparse_index *__indx, REAL *__y, sparse_stride __incy)
+{
+	for (sparse_dimension k = 0; k < __nz; k++)
+		__y[__indx[k] * __incy] += __alpha * __x[k];
+}
+
+REAL F(sparse_vector_norm)(sparse_dimension __nz, const REAL *__x, const sparse_index *__indx, sparse_norm __norm)
+{
+	REAL result = 0, scale = 0;
+
+	switch (__norm)
+	{
+		case SPARSE_NORM_ONE:
+			for (sparse_dimension k = 0; k < __nz; k++)
+				result += ABS(__x[k]);
+			return result;
+		case SPARSE_NORM_TWO:
+		case SPARSE_NORM_R1:
+			// scaled by the largest magnitude so that the squares don't overflow
+			for (sparse_dimension k = 0; k < __nz; k++)
+			{
+				if (ABS(__x[k]) > scale)
+					scale = ABS(__x[k]);
+			}
+			if (scale == 0 || !isfinite(scale))
+				return scale;
+			for (sparse_dimension k = 0; k < __nz; k++)
+				result += (__x[k] / scale) * (__x[k] / scale);
+			return scale * SQRT(result);
+		case SPARSE_NORM_INF:
+			for (sparse_dimension k = 0; k < __nz; k++)
+			{
+				if (ABS(__x[k]) > result)
+					result = ABS(__x[k]);
+			}
+			return result;
+		default:
+			return NAN;
+	}
+}
+
+sparse_index F(sparse_get_vector_nonzero_count)(sparse_dimension __N, const REAL *__x, sparse_stride __incx)
+{
+	const REAL* x = __x + sparse_stride_origin(__N, __incx);
+	sparse_index count = 0;
+
+	for (sparse_dimension i = 0; i < __N; i++)
+		count += x[(ptrdiff_t) i * __incx] != 0;
+	return count;
+}
+
+sparse_dimension F(sparse_pack_vector)(sparse_dimension __N, sparse_dimension __nz, const REAL *__x, sparse_stride __incx, REAL *__y, sparse_index *__indy)
+{
+	const REAL* x = __x + sparse_stride_origin(__N, __incx);
+	sparse_dimension count = 0;
+
+	for (sparse_dimension i = 0; i < __N && count < __nz; i++)
+	{
+		const REAL value = x[(ptrdiff_t) i * __incx];
+		if (value != 0)
+		{
+			__y[count] = value;
+			__indy[count] = (sparse_index) i;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void F(sparse_unpack_vector)(sparse_dimension __N, sparse_dimension __nz, bool __zero, const REAL *__x, const sparse_index *__indx, REAL *__y, sparse_stride __incy)
+{
+	REAL* y = __y + sparse_stride_origin(__N, __incy);
+
+	if (__zero)
+	{
+		for (sparse_dimension i = 0; i < __N; i++)
+			y[(ptrdiff_t) i * __incy] = 0;
+	}
+	for (sparse_dimension k = 0; k < __nz; k++)
+	{
+		if (__indx[k] >= 0 && (sparse_dimension) __indx[k] < __N)
+			y[__indx[k] * __incy] = __x[k];
+	}
+}
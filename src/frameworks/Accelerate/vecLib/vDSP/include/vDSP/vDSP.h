@@ -24,18 +24,69 @@
 typedef unsigned long vDSP_Length;
 typedef long vDSP_Stride;
 
-void* vDSP_DCT_CreateSetup(void);
-void* vDSP_DCT_Execute(void);
-void* vDSP_DFT_CreateSetup(void);
-void* vDSP_DFT_DestroySetup(void);
-void* vDSP_DFT_DestroySetupD(void);
-void* vDSP_DFT_Execute(void);
-void* vDSP_DFT_ExecuteD(void);
-void* vDSP_DFT_zop(void);
-void* vDSP_DFT_zop_CreateSetup(void);
-void* vDSP_DFT_zop_CreateSetupD(void);
-void* vDSP_DFT_zrop_CreateSetup(void);
-void* vDSP_DFT_zrop_CreateSetupD(void);
+typedef struct DSPComplex {
+	float real;
+	float imag;
+} DSPComplex;
+
+typedef struct DSPSplitComplex {
+	float *realp;
+	float *imagp;
+} DSPSplitComplex;
+
+typedef struct DSPDoubleComplex {
+	double real;
+	double imag;
+} DSPDoubleComplex;
+
+typedef struct DSPDoubleSplitComplex {
+	double *realp;
+	double *imagp;
+} DSPDoubleSplitComplex;
+
+typedef struct OpaqueFFTSetup *FFTSetup;
+typedef struct OpaqueFFTSetupD *FFTSetupD;
+
+typedef int FFTDirection;
+typedef int FFTRadix;
+
+enum {
+	kFFTDirection_Forward = +1,
+	kFFTDirection_Inverse = -1
+};
+
+enum {
+	kFFTRadix2 = 0,
+	kFFTRadix3 = 1,
+	kFFTRadix5 = 2
+};
+
+typedef struct vDSP_DFT_SetupStruct *vDSP_DFT_Setup;
+typedef struct vDSP_DFT_SetupStructD *vDSP_DFT_SetupD;
+
+typedef enum {
+	vDSP_DFT_FORWARD = +1,
+	vDSP_DFT_INVERSE = -1
+} vDSP_DFT_Direction;
+
+typedef enum {
+	vDSP_DCT_II = 2,
+	vDSP_DCT_III = 3,
+	vDSP_DCT_IV = 4
+} vDSP_DCT_Type;
+
+vDSP_DFT_Setup vDSP_DCT_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length, vDSP_DCT_Type __Type);
+void vDSP_DCT_Execute(const struct vDSP_DFT_SetupStruct *__Setup, const float *__Input, float *__Output);
+vDSP_DFT_Setup vDSP_DFT_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length);
+void vDSP_DFT_DestroySetup(vDSP_DFT_Setup __Setup);
+void vDSP_DFT_DestroySetupD(vDSP_DFT_SetupD __Setup);
+void vDSP_DFT_Execute(const struct vDSP_DFT_SetupStruct *__Setup, const float *__Ir, const float *__Ii, float *__Or, float *__Oi);
+void vDSP_DFT_ExecuteD(const struct vDSP_DFT_SetupStructD *__Setup, const double *__Ir, const double *__Ii, double *__Or, double *__Oi);
+void vDSP_DFT_zop(const struct vDSP_DFT_SetupStruct *__Setup, const float *__Ir, const float *__Ii, vDSP_Stride __Is, float *__Or, float *__Oi, vDSP_Stride __Os, vDSP_DFT_Direction __Direction);
+vDSP_DFT_Setup vDSP_DFT_zop_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction);
+vDSP_DFT_SetupD vDSP_DFT_zop_CreateSetupD(vDSP_DFT_SetupD __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction);
+vDSP_DFT_Setup vDSP_DFT_zrop_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction);
+vDSP_DFT_SetupD vDSP_DFT_zrop_CreateSetupD(vDSP_DFT_SetupD __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction);
 void* vDSP_FFT16_copv(void);
 void* vDSP_FFT16_zopv(void);
 void* vDSP_FFT32_copv(void);
@@ -65,16 +116,16 @@ void* vDSP_blkman_window(void);
 void* vDSP_blkman_windowD(void);
 void* vDSP_conv(void);
 void* vDSP_convD(void);
-void* vDSP_create_fftsetup(void);
-void* vDSP_create_fftsetupD(void);
+FFTSetup vDSP_create_fftsetup(vDSP_Length __Log2n, FFTRadix __Radix);
+FFTSetupD vDSP_create_fftsetupD(vDSP_Length __Log2n, FFTRadix __Radix);
 void* vDSP_ctoz(void);
 void* vDSP_ctozD(void);
 void* vDSP_deq22(void);
 void* vDSP_deq22D(void);
 void* vDSP_desamp(void);
 void* vDSP_desampD(void);
-void* vDSP_destroy_fftsetup(void);
-void* vDSP_destroy_fftsetupD(void);
+void vDSP_destroy_fftsetup(FFTSetup __setup);
+void vDSP_destroy_fftsetupD(FFTSetupD __setup);
 void* vDSP_distancesq(void);
 void* vDSP_distancesqD(void);
 void* vDSP_dotpr(void);
@@ -105,42 +156,42 @@ void* vDSP_fft2d_zrop(void);
 void* vDSP_fft2d_zropD(void);
 void* vDSP_fft2d_zropt(void);
 void* vDSP_fft2d_zroptD(void);
-void* vDSP_fft3_zop(void);
-void* vDSP_fft3_zopD(void);
-void* vDSP_fft5_zop(void);
-void* vDSP_fft5_zopD(void);
-void* vDSP_fft_zip(void);
-void* vDSP_fft_zipD(void);
-void* vDSP_fft_zipt(void);
-void* vDSP_fft_ziptD(void);
-void* vDSP_fft_zop(void);
-void* vDSP_fft_zopD(void);
-void* vDSP_fft_zopt(void);
-void* vDSP_fft_zoptD(void);
-void* vDSP_fft_zrip(void);
-void* vDSP_fft_zripD(void);
-void* vDSP_fft_zript(void);
-void* vDSP_fft_zriptD(void);
-void* vDSP_fft_zrop(void);
-void* vDSP_fft_zropD(void);
-void* vDSP_fft_zropt(void);
-void* vDSP_fft_zroptD(void);
-void* vDSP_fftm_zip(void);
-void* vDSP_fftm_zipD(void);
-void* vDSP_fftm_zipt(void);
-void* vDSP_fftm_ziptD(void);
-void* vDSP_fftm_zop(void);
-void* vDSP_fftm_zopD(void);
-void* vDSP_fftm_zopt(void);
-void* vDSP_fftm_zoptD(void);
-void* vDSP_fftm_zrip(void);
-void* vDSP_fftm_zripD(void);
-void* vDSP_fftm_zript(void);
-void* vDSP_fftm_zriptD(void);
-void* vDSP_fftm_zrop(void);
-void* vDSP_fftm_zropD(void);
-void* vDSP_fftm_zropt(void);
-void* vDSP_fftm_zroptD(void);
+void vDSP_fft3_zop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft3_zopD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft5_zop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft5_zopD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zip(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zipD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zipt(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_ziptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zopD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zopt(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zoptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zrip(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zripD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zript(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zriptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zrop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zropD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zropt(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, const DSPSplitComplex *__C, vDSP_Stride __IC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fft_zroptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction);
+void vDSP_fftm_zip(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zipD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zipt(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_ziptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zopD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zopt(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zoptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zrip(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zripD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zript(FFTSetup __Setup, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zriptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IM, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zrop(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zropD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zropt(FFTSetup __Setup, const DSPSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const DSPSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
+void vDSP_fftm_zroptD(FFTSetupD __Setup, const DSPDoubleSplitComplex *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const DSPDoubleSplitComplex *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const DSPDoubleSplitComplex *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction);
 void* vDSP_hamm_window(void);
 void* vDSP_hamm_windowD(void);
 void* vDSP_hann_window(void);
@@ -0,0 +1,236 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vDSP/vDSP.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fft_engine.h"
+
+enum dft_kind
+{
+	dft_complex,
+	dft_real,
+	dft_dct2,
+	dft_dct3,
+	dft_dct4,
+};
+
+// Like Apple's implementation, DFT lengths are f*2^n with f being 1, 3, 5 or 15 and 2^n
+// at least `min_pow2`
+static bool dft_valid_length(vDSP_Length length, vDSP_Length min_pow2)
+{
+	return length % min_pow2 == 0 && fft_supported_length(length);
+}
+
+#define REAL float
+#define FN(name) name
+#define ENGINE(name) name##_f
+#define TABLE struct fft_table_f
+#define SETUP vDSP_DFT_Setup
+#define SETUP_STRUCT struct vDSP_DFT_SetupStruct
+#include "dft_template.h"
+#undef REAL
+#undef FN
+#undef ENGINE
+#undef TABLE
+#undef SETUP
+#undef SETUP_STRUCT
+
+#define REAL double
+#define FN(name) name##D
+#define ENGINE(name) name##_d
+#define TABLE struct fft_table_d
+#define SETUP vDSP_DFT_SetupD
+#define SETUP_STRUCT struct vDSP_DFT_SetupStructD
+#include "dft_template.h"
+#undef REAL
+#undef FN
+#undef ENGINE
+#undef TABLE
+#undef SETUP
+#undef SETUP_STRUCT
+
+vDSP_DFT_Setup vDSP_DFT_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length)
+{
+	return vDSP_DFT_zop_CreateSetup(__Previous, __Length, vDSP_DFT_FORWARD);
+}
+
+void vDSP_DFT_zop(const struct vDSP_DFT_SetupStruct *__Setup, const float *__Ir, const float *__Ii, vDSP_Stride __Is, float *__Or, float *__Oi, vDSP_Stride __Os, vDSP_DFT_Direction __Direction)
+{
+	if (__Setup->kind != dft_complex)
+		return;
+	dft_execute_complex(__Setup, __Ir, __Ii, __Is, __Or, __Oi, __Os, __Direction);
+}
+
+// DCTs of N points are computed with a real FFT of N points (DCT-II and DCT-III) or a complex
+// FFT of N/2 points (DCT-IV), plus pre- and post-twiddling. The setup's twiddle table is for
+// 8*N points, so that it also holds the twiddles w(j) = e^(-i*pi*j/(4*N)) these need.
+// The results aren't normalized:
+//   DCT-II:  Y[k] = sum x[n] * cos(pi * k * (n + 1/2) / N)
+//   DCT-III: Y[k] = x[0] / 2 + sum(n > 0) x[n] * cos(pi * n * (k + 1/2) / N)
+//   DCT-IV:  Y[k] = sum x[n] * cos(pi * (n + 1/2) * (k + 1/2) / N)
+
+vDSP_DFT_Setup vDSP_DCT_CreateSetup(vDSP_DFT_Setup __Previous, vDSP_Length __Length, vDSP_DCT_Type __Type)
+{
+	enum dft_kind kind;
+
+	(void)__Previous;
+
+	switch (__Type)
+	{
+		case vDSP_DCT_II: kind = dft_dct2; break;
+		case vDSP_DCT_III: kind = dft_dct3; break;
+		case vDSP_DCT_IV: kind = dft_dct4; break;
+		default: return NULL;
+	}
+
+	if (!dft_valid_length(__Length, 16))
+		return NULL;
+	return dft_create_setup(kind, __Length, vDSP_DFT_FORWARD, 8 * __Length);
+}
+
+// Makhoul's algorithm: the DFT V of v, which has the even samples of x in order followed
+// by the odd ones in reverse, gives Y[k] = Re(w(2k) * V[k]) and Y[N-k] = -Im(w(2k) * V[k])
+static void dct2(const struct vDSP_DFT_SetupStruct* setup, const float* in, float* out,
+	float* re, float* im, float* work_re, float* work_im)
+{
+	const vDSP_Length n = setup->length, half = n / 2;
+	const float* twr = setup->table.re;
+	const float* twi = setup->table.im;
+
+	// v[j] = in[2j], v[n-1-j] = in[2j+1], packed as re[j] = v[2j], im[j] = v[2j+1]
+	for (vDSP_Length j = 0; j < half; j++)
+	{
+		const vDSP_Length m0 = 2 * j, m1 = 2 * j + 1;
+		re[j] = (m0 < half) ? in[2 * m0] : in[2 * (n - 1 - m0) + 1];
+		im[j] = (m1 < half) ? in[2 * m1] : in[2 * (n - 1 - m1) + 1];
+	}
+
+	// this gives 2*V
+	fft_real_forward_f(&setup->table, n, re, im, re, im, work_re, work_im);
+
+	out[0] = 0.5f * re[0];
+	out[half] = 0.5f * (float) M_SQRT1_2 * im[0];
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length k = 1; k < half; k++)
+	{
+		const float wr = twr[2 * k], wi = twi[2 * k];
+		out[k] = 0.5f * (wr * re[k] - wi * im[k]);
+		out[n - k] = -0.5f * (wr * im[k] + wi * re[k]);
+	}
+}
+
+// The inverse of the above: V[k] = conj(w(2k)) * (X[k] - i*X[N-k]), transformed back
+static void dct3(const struct vDSP_DFT_SetupStruct* setup, const float* in, float* out,
+	float* re, float* im, float* work_re, float* work_im)
+{
+	const vDSP_Length n = setup->length, half = n / 2;
+	const float* twr = setup->table.re;
+	const float* twi = setup->table.im;
+
+	re[0] = in[0];
+	im[0] = (float) M_SQRT2 * in[half];
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length k = 1; k < half; k++)
+	{
+		const float wr = twr[2 * k], wi = -twi[2 * k];
+		const float xr = in[k], xi = -in[n - k];
+		re[k] = wr * xr - wi * xi;
+		im[k] = wr * xi + wi * xr;
+	}
+
+	// the unscaled inverse gives N*v, DCT-III is N/2 times the inverse of DCT-II
+	fft_real_inverse_f(&setup->table, n, re, im, re, im, work_re, work_im);
+
+	for (vDSP_Length j = 0; j < half; j++)
+	{
+		const vDSP_Length m0 = 2 * j, m1 = 2 * j + 1;
+		const float v0 = 0.5f * re[j], v1 = 0.5f * im[j];
+
+		if (m0 < half)
+			out[2 * m0] = v0;
+		else
+			out[2 * (n - 1 - m0) + 1] = v0;
+		if (m1 < half)
+			out[2 * m1] = v1;
+		else
+			out[2 * (n - 1 - m1) + 1] = v1;
+	}
+}
+
+// z[j] = (x[2j] + i*x[N-1-2j]) * w(4j+1), Z = DFT(z), then with U[k] = Z[k] * w(4k):
+// Y[2k] = Re U[k] and Y[N-1-2k] = -Im U[k]
+static void dct4(const struct vDSP_DFT_SetupStruct* setup, const float* in, float* out,
+	float* re, float* im, float* work_re, float* work_im)
+{
+	const vDSP_Length n = setup->length, half = n / 2;
+	const float* twr = setup->table.re;
+	const float* twi = setup->table.im;
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length j = 0; j < half; j++)
+	{
+		const float xr = in[2 * j], xi = in[n - 1 - 2 * j];
+		const float wr = twr[4 * j + 1], wi = twi[4 * j + 1];
+		re[j] = wr * xr - wi * xi;
+		im[j] = wr * xi + wi * xr;
+	}
+
+	fft_complex_f(&setup->table, half, re, im, re, im, work_re, work_im);
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length k = 0; k < half; k++)
+	{
+		const float wr = twr[4 * k], wi = twi[4 * k];
+		out[2 * k] = wr * re[k] - wi * im[k];
+		out[n - 1 - 2 * k] = -(wr * im[k] + wi * re[k]);
+	}
+}
+
+void vDSP_DCT_Execute(const struct vDSP_DFT_SetupStruct *__Setup, const float *__Input, float *__Output)
+{
+	const vDSP_Length n = __Setup->length;
+
+	// the input is read completely before the output is written, so they may be the same
+	float* scratch = (float*) fft_scratch(2 * n * sizeof(float));
+	if (!scratch)
+		return;
+
+	float* re = scratch;
+	float* im = scratch + n / 2;
+	float* work_re = scratch + n;
+	float* work_im = scratch + 3 * n / 2;
+
+	switch (__Setup->kind)
+	{
+		case dft_dct2:
+			dct2(__Setup, __Input, __Output, re, im, work_re, work_im);
+			break;
+		case dft_dct3:
+			dct3(__Setup, __Input, __Output, re, im, work_re, work_im);
+			break;
+		case dft_dct4:
+			dct4(__Setup, __Input, __Output, re, im, work_re, work_im);
+			break;
+		default:
+			break;
+	}
+}
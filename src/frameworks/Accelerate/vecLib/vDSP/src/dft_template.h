@@ -0,0 +1,148 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The vDSP_DFT* family, included by dft.c once for float and once for double.
+//
+// The includer defines REAL, FN(name) for the exported names, ENGINE(name) for the engine
+// functions of that element type, TABLE for its twiddle table and SETUP and SETUP_STRUCT
+// for the setup type.
+
+SETUP_STRUCT
+{
+	enum dft_kind kind;
+	vDSP_Length length;
+	vDSP_DFT_Direction direction;
+	TABLE table;
+};
+
+// __Previous only lets Apple's implementation share tables between setups, every setup gets its own here
+static SETUP FN(dft_create_setup)(enum dft_kind kind, vDSP_Length length, vDSP_DFT_Direction direction, vDSP_Length table_length)
+{
+	if (direction != vDSP_DFT_FORWARD && direction != vDSP_DFT_INVERSE)
+		return NULL;
+
+	SETUP setup = (SETUP) malloc(sizeof(*setup));
+	if (!setup)
+		return NULL;
+
+	setup->kind = kind;
+	setup->length = length;
+	setup->direction = direction;
+
+	if (!ENGINE(fft_table_init)(&setup->table, table_length))
+	{
+		free(setup);
+		return NULL;
+	}
+
+	return setup;
+}
+
+SETUP FN(vDSP_DFT_zop_CreateSetup)(SETUP __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction)
+{
+	(void)__Previous;
+
+	if (!dft_valid_length(__Length, 8))
+		return NULL;
+	return FN(dft_create_setup)(dft_complex, __Length, __Direction, __Length);
+}
+
+SETUP FN(vDSP_DFT_zrop_CreateSetup)(SETUP __Previous, vDSP_Length __Length, vDSP_DFT_Direction __Direction)
+{
+	(void)__Previous;
+
+	if (!dft_valid_length(__Length, 16))
+		return NULL;
+	return FN(dft_create_setup)(dft_real, __Length, __Direction, __Length);
+}
+
+void FN(vDSP_DFT_DestroySetup)(SETUP __Setup)
+{
+	if (!__Setup)
+		return;
+
+	ENGINE(fft_table_destroy)(&__Setup->table);
+	free(__Setup);
+}
+
+// Complex transforms of `length` points with a direction that may differ from the setup's
+static void FN(dft_execute_complex)(const SETUP_STRUCT* setup, const REAL* ir, const REAL* ii, vDSP_Stride is,
+	REAL* or, REAL* oi, vDSP_Stride os, vDSP_DFT_Direction direction)
+{
+	const vDSP_Length n = setup->length;
+	REAL* scratch = (REAL*) fft_scratch(4 * n * sizeof(REAL));
+	if (!scratch)
+		return;
+
+	REAL* work_re = scratch;
+	REAL* work_im = scratch + n;
+	REAL* data_re = scratch + 2 * n;
+	REAL* data_im = scratch + 3 * n;
+
+	const REAL* src_re = ir;
+	const REAL* src_im = ii;
+	REAL* dst_re = (os == 1) ? or : data_re;
+	REAL* dst_im = (os == 1) ? oi : data_im;
+
+	if (is != 1)
+	{
+		for (vDSP_Length i = 0; i < n; i++)
+		{
+			data_re[i] = ir[i * is];
+			data_im[i] = ii[i * is];
+		}
+		src_re = data_re;
+		src_im = data_im;
+	}
+
+	if (direction == vDSP_DFT_FORWARD)
+		ENGINE(fft_complex)(&setup->table, n, src_re, src_im, dst_re, dst_im, work_re, work_im);
+	else
+		ENGINE(fft_complex)(&setup->table, n, src_im, src_re, dst_im, dst_re, work_im, work_re);
+
+	if (os != 1)
+	{
+		for (vDSP_Length i = 0; i < n; i++)
+		{
+			or[i * os] = dst_re[i];
+			oi[i * os] = dst_im[i];
+		}
+	}
+}
+
+void FN(vDSP_DFT_Execute)(const SETUP_STRUCT *__Setup, const REAL *__Ir, const REAL *__Ii, REAL *__Or, REAL *__Oi)
+{
+	if (__Setup->kind == dft_complex)
+	{
+		FN(dft_execute_complex)(__Setup, __Ir, __Ii, 1, __Or, __Oi, 1, __Setup->direction);
+	}
+	else if (__Setup->kind == dft_real)
+	{
+		// packed like vDSP_fft_zrop, with the same scaling
+		const vDSP_Length half = __Setup->length / 2;
+		REAL* work = (REAL*) fft_scratch(2 * half * sizeof(REAL));
+		if (!work)
+			return;
+
+		if (__Setup->direction == vDSP_DFT_FORWARD)
+			ENGINE(fft_real_forward)(&__Setup->table, __Setup->length, __Ir, __Ii, __Or, __Oi, work, work + half);
+		else
+			ENGINE(fft_real_inverse)(&__Setup->table, __Setup->length, __Ir, __Ii, __Or, __Oi, work, work + half);
+	}
+}
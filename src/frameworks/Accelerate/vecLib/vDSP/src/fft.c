@@ -0,0 +1,54 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vDSP/vDSP.h>
+#include <stdlib.h>
+#include "fft_engine.h"
+
+#define REAL float
+#define FN(name) name
+#define ENGINE(name) name##_f
+#define TABLE struct fft_table_f
+#define SETUP FFTSetup
+#define SETUP_STRUCT struct OpaqueFFTSetup
+#define SPLIT DSPSplitComplex
+#include "fft_template.h"
+#undef REAL
+#undef FN
+#undef ENGINE
+#undef TABLE
+#undef SETUP
+#undef SETUP_STRUCT
+#undef SPLIT
+
+#define REAL double
+#define FN(name) name##D
+#define ENGINE(name) name##_d
+#define TABLE struct fft_table_d
+#define SETUP FFTSetupD
+#define SETUP_STRUCT struct OpaqueFFTSetupD
+#define SPLIT DSPDoubleSplitComplex
+#include "fft_template.h"
+#undef REAL
+#undef FN
+#undef ENGINE
+#undef TABLE
+#undef SETUP
+#undef SETUP_STRUCT
+#undef SPLIT
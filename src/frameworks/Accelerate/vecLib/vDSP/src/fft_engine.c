@@ -0,0 +1,284 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "fft_engine.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define FFT_HAVE_V256 1
+#endif
+
+static bool fft_have_avx = false;
+
+__attribute__((constructor))
+static void fft_detect_cpu(void)
+{
+#ifdef FFT_HAVE_V256
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return;
+
+	// the CPU has AVX and the OS saves the YMM registers
+	if ((ecx & bit_AVX) && (ecx & bit_OSXSAVE))
+	{
+		unsigned int xcr0_lo, xcr0_hi;
+		__asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+		fft_have_avx = (xcr0_lo & 6) == 6;
+	}
+#endif
+}
+
+bool fft_supported_length(vDSP_Length n)
+{
+	if (n == 0)
+		return false;
+	while (n % 2 == 0)
+		n /= 2;
+	return n == 1 || n == 3 || n == 5 || n == 15;
+}
+
+// Splits n into the radices of its passes: as many radix 4 passes as possible and a radix 2
+// pass if needed, then 3 and 5. Small radices go first so that the later passes, where s is
+// large, are the ones that get vectorized; the radix 2 pass goes second for the same reason.
+// Returns the number of passes.
+static int fft_factor(vDSP_Length n, unsigned char* radices)
+{
+	int twos = 0, count = 0;
+
+	while (n % 2 == 0)
+	{
+		n /= 2;
+		twos++;
+	}
+
+	if (twos >= 2)
+	{
+		radices[count++] = 4;
+		twos -= 2;
+	}
+	if (twos % 2)
+	{
+		radices[count++] = 2;
+		twos--;
+	}
+	for (; twos > 0; twos -= 2)
+		radices[count++] = 4;
+
+	if (n % 3 == 0)
+		radices[count++] = 3;
+	if (n % 5 == 0)
+		radices[count++] = 5;
+
+	return count;
+}
+
+// e^(-2*pi*i*j/n), reduced to an angle in [0, pi/4] first so that the symmetries of the
+// unit circle hold exactly (w^(n/4) is exactly -i and so on)
+static void fft_twiddle(vDSP_Length j, vDSP_Length n, double* re, double* im)
+{
+	// the angle is pi * a / b
+	unsigned long long a = 2 * (unsigned long long) j, b = n;
+	bool negate_sin = false, negate_cos = false, swap = false;
+
+	if (a > b)
+	{
+		a = 2 * b - a;
+		negate_sin = true;
+	}
+	if (2 * a > b)
+	{
+		a = b - a;
+		negate_cos = true;
+	}
+	if (4 * a > b)
+	{
+		a = b - 2 * a;
+		b *= 2;
+		swap = true;
+	}
+
+	const double angle = M_PI * (double) a / (double) b;
+	double c = cos(angle), s = sin(angle);
+
+	if (swap)
+	{
+		double t = c;
+		c = s;
+		s = t;
+	}
+
+	*re = negate_cos ? -c : c;
+	*im = negate_sin ? s : -s;
+}
+
+static pthread_key_t fft_scratch_key;
+static pthread_once_t fft_scratch_once = PTHREAD_ONCE_INIT;
+
+struct fft_scratch_block
+{
+	size_t size;
+	void* memory;
+};
+
+static void fft_scratch_free(void* ptr)
+{
+	struct fft_scratch_block* block = (struct fft_scratch_block*) ptr;
+	free(block->memory);
+	free(block);
+}
+
+static void fft_scratch_init(void)
+{
+	pthread_key_create(&fft_scratch_key, fft_scratch_free);
+}
+
+void* fft_scratch(size_t size)
+{
+	pthread_once(&fft_scratch_once, fft_scratch_init);
+
+	struct fft_scratch_block* block = (struct fft_scratch_block*) pthread_getspecific(fft_scratch_key);
+	if (!block)
+	{
+		block = (struct fft_scratch_block*) calloc(1, sizeof(*block));
+		if (!block)
+			return NULL;
+		pthread_setspecific(fft_scratch_key, block);
+	}
+
+	if (block->size < size)
+	{
+		void* memory;
+
+		if (posix_memalign(&memory, 32, size) != 0)
+			return NULL;
+		free(block->memory);
+		block->memory = memory;
+		block->size = size;
+	}
+
+	return block->memory;
+}
+
+// Kernel instances: scalar, 128-bit vectors (SSE) and 256-bit vectors (AVX)
+
+#define REAL float
+
+#define VW 1
+#define KFN(name) fft_scalar_f_##name
+#define KATTR
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#define VW 4
+#define KFN(name) fft_v128_f_##name
+#define KATTR
+#define KFIRST4
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#undef KFIRST4
+
+#ifdef FFT_HAVE_V256
+#define VW 8
+#define KFN(name) fft_v256_f_##name
+#define KATTR __attribute__((target("avx")))
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#endif
+
+#undef REAL
+#define REAL double
+
+#define VW 1
+#define KFN(name) fft_scalar_d_##name
+#define KATTR
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+
+#define VW 2
+#define KFN(name) fft_v128_d_##name
+#define KATTR
+#define KFIRST4
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#undef KFIRST4
+
+#ifdef FFT_HAVE_V256
+#define VW 4
+#define KFN(name) fft_v256_d_##name
+#define KATTR __attribute__((target("avx")))
+#include "fft_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#endif
+
+#undef REAL
+
+// Drivers
+
+#define REAL float
+#define SFX(name) name##_f
+#define TABLE struct fft_table_f
+#define SCALAR(name) fft_scalar_f_##name
+#define V128(name) fft_v128_f_##name
+#define V256(name) fft_v256_f_##name
+#define VW128 4
+#define VW256 8
+#include "fft_engine_template.h"
+#undef REAL
+#undef SFX
+#undef TABLE
+#undef SCALAR
+#undef V128
+#undef V256
+#undef VW128
+#undef VW256
+
+#define REAL double
+#define SFX(name) name##_d
+#define TABLE struct fft_table_d
+#define SCALAR(name) fft_scalar_d_##name
+#define V128(name) fft_v128_d_##name
+#define V256(name) fft_v256_d_##name
+#define VW128 2
+#define VW256 4
+#include "fft_engine_template.h"
+#undef REAL
+#undef SFX
+#undef TABLE
+#undef SCALAR
+#undef V128
+#undef V256
+#undef VW128
+#undef VW256
@@ -0,0 +1,81 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _vDSP_FFT_ENGINE_H_
+#define _vDSP_FFT_ENGINE_H_
+
+#include <vDSP/vDSP.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// The transform engine behind the FFT, DFT and DCT APIs.
+//
+// Data is always in split form. Transforms are mixed-radix Stockham passes (radix 4 and 2,
+// plus one pass of radix 3 and/or 5), so they need a work buffer but no bit reversal.
+// Inverse complex transforms are done by swapping the real and imaginary parts of the
+// input and output, so only forward kernels exist.
+
+// Forward twiddle factors for a transform of `length` points: e^(-2*pi*i*j/length), j < length.
+// Any transform whose size divides `length` can use the same table.
+struct fft_table_f
+{
+	vDSP_Length length;
+	float* re;
+	float* im;
+};
+
+struct fft_table_d
+{
+	vDSP_Length length;
+	double* re;
+	double* im;
+};
+
+// Sizes the engine can transform: 2^n, 3*2^n, 5*2^n and 15*2^n
+bool fft_supported_length(vDSP_Length n);
+
+bool fft_table_init_f(struct fft_table_f* table, vDSP_Length length);
+void fft_table_destroy_f(struct fft_table_f* table);
+bool fft_table_init_d(struct fft_table_d* table, vDSP_Length length);
+void fft_table_destroy_d(struct fft_table_d* table);
+
+// Forward complex transform of n points; n must divide the table's length.
+// `in` and `out` may be the same buffers, `work` must be n elements and distinct from both.
+void fft_complex_f(const struct fft_table_f* table, vDSP_Length n,
+	const float* in_re, const float* in_im, float* out_re, float* out_im, float* work_re, float* work_im);
+void fft_complex_d(const struct fft_table_d* table, vDSP_Length n,
+	const double* in_re, const double* in_im, double* out_re, double* out_im, double* work_re, double* work_im);
+
+// Real transforms of n points in vDSP's packed format: n/2 complex values holding the even
+// samples in the real part and the odd ones in the imaginary part. In the frequency domain,
+// re[0] is the DC term and im[0] the Nyquist term. Like vDSP_fft_zrip, the forward transform
+// is scaled by 2 and the inverse isn't scaled. n/2 must divide the table's length, n must be even.
+void fft_real_forward_f(const struct fft_table_f* table, vDSP_Length n,
+	const float* in_re, const float* in_im, float* out_re, float* out_im, float* work_re, float* work_im);
+void fft_real_inverse_f(const struct fft_table_f* table, vDSP_Length n,
+	const float* in_re, const float* in_im, float* out_re, float* out_im, float* work_re, float* work_im);
+void fft_real_forward_d(const struct fft_table_d* table, vDSP_Length n,
+	const double* in_re, const double* in_im, double* out_re, double* out_im, double* work_re, double* work_im);
+void fft_real_inverse_d(const struct fft_table_d* table, vDSP_Length n,
+	const double* in_re, const double* in_im, double* out_re, double* out_im, double* work_re, double* work_im);
+
+// Per-thread scratch memory, 32-byte aligned. Valid until the next call on the same thread.
+void* fft_scratch(size_t size);
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Transform drivers, included by fft_engine.c once per element type.
+//
+// The includer defines REAL, SFX(name) for the exported names, TABLE for the twiddle table
+// struct, and SCALAR(name), V128(name) and V256(name) for the kernel instances of fft_kernels.h
+// along with VW128 and VW256, their vector widths.
+
+bool SFX(fft_table_init)(TABLE* table, vDSP_Length length)
+{
+	table->length = length;
+	table->re = (REAL*) malloc(length * sizeof(REAL));
+	table->im = (REAL*) malloc(length * sizeof(REAL));
+
+	if (!table->re || !table->im)
+	{
+		SFX(fft_table_destroy)(table);
+		return false;
+	}
+
+	for (vDSP_Length j = 0; j < length; j++)
+	{
+		double re, im;
+
+		fft_twiddle(j, length, &re, &im);
+		table->re[j] = re;
+		table->im[j] = im;
+	}
+
+	return true;
+}
+
+void SFX(fft_table_destroy)(TABLE* table)
+{
+	free(table->re);
+	free(table->im);
+	table->re = table->im = NULL;
+	table->length = 0;
+}
+
+typedef void (*SFX(fft_pass))(vDSP_Length m, vDSP_Length s, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi);
+
+static void SFX(fft_run_pass)(int radix, vDSP_Length m, vDSP_Length s, const TABLE* table, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	static const SFX(fft_pass) scalar[] = { NULL, NULL, SCALAR(pass2), SCALAR(pass3), SCALAR(pass4), SCALAR(pass5) };
+	static const SFX(fft_pass) v128[] = { NULL, NULL, V128(pass2), V128(pass3), V128(pass4), V128(pass5) };
+#ifdef FFT_HAVE_V256
+	static const SFX(fft_pass) v256[] = { NULL, NULL, V256(pass2), V256(pass3), V256(pass4), V256(pass5) };
+
+	if (fft_have_avx && s % VW256 == 0)
+		v256[radix](m, s, table->re, table->im, tws, xr, xi, yr, yi);
+	else
+#endif
+	if (s % VW128 == 0)
+		v128[radix](m, s, table->re, table->im, tws, xr, xi, yr, yi);
+	else if (s == 1 && radix == 4)
+		V128(first4)(m, table->re, table->im, tws, xr, xi, yr, yi);
+	else
+		scalar[radix](m, s, table->re, table->im, tws, xr, xi, yr, yi);
+}
+
+void SFX(fft_complex)(const TABLE* table, vDSP_Length n,
+	const REAL* in_re, const REAL* in_im, REAL* out_re, REAL* out_im, REAL* work_re, REAL* work_im)
+{
+	unsigned char radices[64];
+	const int passes = fft_factor(n, radices);
+
+	if (passes == 0)
+	{
+		out_re[0] = in_re[0];
+		out_im[0] = in_im[0];
+		return;
+	}
+
+	// The passes alternate between `out` and `work` and the last one has to land in `out`.
+	// An in-place transform can't start by writing to `out`, so it starts from a copy.
+	const REAL* src_re = in_re;
+	const REAL* src_im = in_im;
+
+	if (in_re == out_re && passes % 2)
+	{
+		memcpy(work_re, in_re, n * sizeof(REAL));
+		memcpy(work_im, in_im, n * sizeof(REAL));
+		src_re = work_re;
+		src_im = work_im;
+	}
+
+	vDSP_Length length = n, s = 1;
+
+	for (int i = 0; i < passes; i++)
+	{
+		const int radix = radices[i];
+		REAL* dst_re = ((passes - 1 - i) % 2) ? work_re : out_re;
+		REAL* dst_im = ((passes - 1 - i) % 2) ? work_im : out_im;
+
+		// twiddles for a sub-transform of `length` points
+		SFX(fft_run_pass)(radix, length / radix, s, table, table->length / length, src_re, src_im, dst_re, dst_im);
+
+		src_re = dst_re;
+		src_im = dst_im;
+		length /= radix;
+		s *= radix;
+	}
+}
+
+void SFX(fft_real_forward)(const TABLE* table, vDSP_Length n,
+	const REAL* in_re, const REAL* in_im, REAL* out_re, REAL* out_im, REAL* work_re, REAL* work_im)
+{
+	const vDSP_Length half = n / 2;
+	const vDSP_Length tws = table->length / half / 2;
+	const REAL* twr = table->re;
+	const REAL* twi = table->im;
+
+	// Transform the even and odd samples as the real and imaginary parts of a complex signal,
+	// then separate the spectra of both and combine them with the twiddles w = e^(-2*pi*i*k/n):
+	//   X[k] = (Z[k] + conj(Z[half-k])) - i*w^k * (Z[k] - conj(Z[half-k]))
+	// which is twice the DFT of the real signal.
+	SFX(fft_complex)(table, half, in_re, in_im, out_re, out_im, work_re, work_im);
+
+	const REAL dc = out_re[0], nyquist = out_im[0];
+	out_re[0] = 2 * (dc + nyquist);
+	out_im[0] = 2 * (dc - nyquist);
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length k = 1; k <= half / 2; k++)
+	{
+		const REAL ar = out_re[k], ai = out_im[k];
+		const REAL br = out_re[half - k], bi = -out_im[half - k];
+		const REAL er = ar + br, ei = ai + bi;
+		const REAL dr = ar - br, di = ai - bi;
+		const REAL wr = twr[k * tws], wi = twi[k * tws];
+		const REAL wdr = wr * dr - wi * di, wdi = wr * di + wi * dr;
+
+		// the second store wins when k == half - k, and both give the same value
+		out_re[half - k] = er - wdi;
+		out_im[half - k] = -ei - wdr;
+		out_re[k] = er + wdi;
+		out_im[k] = ei - wdr;
+	}
+}
+
+void SFX(fft_real_inverse)(const TABLE* table, vDSP_Length n,
+	const REAL* in_re, const REAL* in_im, REAL* out_re, REAL* out_im, REAL* work_re, REAL* work_im)
+{
+	const vDSP_Length half = n / 2;
+	const vDSP_Length tws = table->length / half / 2;
+	const REAL* twr = table->re;
+	const REAL* twi = table->im;
+
+	// The reverse of the above: rebuild the spectrum of the complex signal
+	//   Z[k] = (X[k] + conj(X[half-k])) + i*conj(w^k) * (X[k] - conj(X[half-k]))
+	// and inverse transform it.
+	const REAL dc = in_re[0], nyquist = in_im[0];
+
+	#pragma clang loop vectorize(enable)
+	for (vDSP_Length k = 1; k <= half / 2; k++)
+	{
+		const REAL ar = in_re[k], ai = in_im[k];
+		const REAL br = in_re[half - k], bi = -in_im[half - k];
+		const REAL er = ar + br, ei = ai + bi;
+		const REAL dr = ar - br, di = ai - bi;
+		const REAL wr = twr[k * tws], wi = -twi[k * tws];
+		const REAL wdr = wr * dr - wi * di, wdi = wr * di + wi * dr;
+
+		out_re[half - k] = er + wdi;
+		out_im[half - k] = -ei + wdr;
+		out_re[k] = er - wdi;
+		out_im[k] = ei + wdr;
+	}
+
+	out_re[0] = dc + nyquist;
+	out_im[0] = dc - nyquist;
+
+	// inverse by swapping the real and imaginary parts
+	SFX(fft_complex)(table, half, out_im, out_re, out_im, out_re, work_im, work_re);
+}
@@ -0,0 +1,330 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Stockham FFT passes, included by fft_engine.c once per element type and vector width.
+//
+// The includer defines:
+//   REAL       float or double
+//   VW         number of REALs processed at once (1 for the scalar fallback)
+//   KFN(name)  mangles a kernel name for this instance
+//   KATTR      function attributes for this instance (e.g. target("avx"))
+//
+// A pass of radix r over a sub-transform of m*r points repeated s times reads
+//   a_j = x[q + s*(p + j*m)]
+// and writes
+//   y[q + s*(r*p + k)] = (sum_j a_j * e^(-2*pi*i*j*k/r)) * w^(k*p)
+// for all p < m and q < s, where w^i is table[i * tws]. Kernels vectorize over q,
+// so s must be a multiple of VW. If KFIRST4 is defined (VW must be 2 or 4), the instance also
+// gets first4, which handles s == 1 by vectorizing over p instead.
+
+#if VW > 1
+typedef REAL KFN(vec) __attribute__((vector_size(VW * sizeof(REAL))));
+#else
+typedef REAL KFN(vec);
+#endif
+
+#define VEC KFN(vec)
+
+KATTR static inline VEC KFN(load)(const REAL* p)
+{
+	VEC v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+KATTR static inline void KFN(store)(REAL* p, VEC v)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+KATTR static inline VEC KFN(splat)(REAL x)
+{
+#if VW > 1
+	VEC v = { 0 };
+	return v + x;
+#else
+	return x;
+#endif
+}
+
+// y = (br + i*bi) * (wr + i*wi)
+#define KFN_TWIDDLE(yr, yi, br, bi, wr, wi) \
+	do { \
+		KFN(store)(yr, (br) * (wr) - (bi) * (wi)); \
+		KFN(store)(yi, (br) * (wi) + (bi) * (wr)); \
+	} while (0)
+
+KATTR static void KFN(pass2)(vDSP_Length m, vDSP_Length s, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	for (vDSP_Length p = 0; p < m; p++)
+	{
+		const VEC w1r = KFN(splat)(twr[p * tws]), w1i = KFN(splat)(twi[p * tws]);
+		const REAL *x0r = xr + s * p, *x0i = xi + s * p;
+		const REAL *x1r = x0r + s * m, *x1i = x0i + s * m;
+		REAL *y0r = yr + s * 2 * p, *y0i = yi + s * 2 * p;
+		REAL *y1r = y0r + s, *y1i = y0i + s;
+
+		for (vDSP_Length q = 0; q < s; q += VW)
+		{
+			const VEC a0r = KFN(load)(x0r + q), a0i = KFN(load)(x0i + q);
+			const VEC a1r = KFN(load)(x1r + q), a1i = KFN(load)(x1i + q);
+
+			KFN(store)(y0r + q, a0r + a1r);
+			KFN(store)(y0i + q, a0i + a1i);
+			KFN_TWIDDLE(y1r + q, y1i + q, a0r - a1r, a0i - a1i, w1r, w1i);
+		}
+	}
+}
+
+KATTR static void KFN(pass3)(vDSP_Length m, vDSP_Length s, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	// sin(2*pi/3)
+	const VEC c = KFN(splat)(0.866025403784438646763723170752936183);
+	const VEC half = KFN(splat)(0.5);
+
+	for (vDSP_Length p = 0; p < m; p++)
+	{
+		const VEC w1r = KFN(splat)(twr[p * tws]), w1i = KFN(splat)(twi[p * tws]);
+		const VEC w2r = KFN(splat)(twr[2 * p * tws]), w2i = KFN(splat)(twi[2 * p * tws]);
+		const REAL *x0r = xr + s * p, *x0i = xi + s * p;
+		const REAL *x1r = x0r + s * m, *x1i = x0i + s * m;
+		const REAL *x2r = x1r + s * m, *x2i = x1i + s * m;
+		REAL *y0r = yr + s * 3 * p, *y0i = yi + s * 3 * p;
+		REAL *y1r = y0r + s, *y1i = y0i + s;
+		REAL *y2r = y1r + s, *y2i = y1i + s;
+
+		for (vDSP_Length q = 0; q < s; q += VW)
+		{
+			const VEC a0r = KFN(load)(x0r + q), a0i = KFN(load)(x0i + q);
+			const VEC a1r = KFN(load)(x1r + q), a1i = KFN(load)(x1i + q);
+			const VEC a2r = KFN(load)(x2r + q), a2i = KFN(load)(x2i + q);
+
+			const VEC tr = a1r + a2r, ti = a1i + a2i;
+			const VEC ur = (a1r - a2r) * c, ui = (a1i - a2i) * c;
+			const VEC mr = a0r - tr * half, mi = a0i - ti * half;
+
+			KFN(store)(y0r + q, a0r + tr);
+			KFN(store)(y0i + q, a0i + ti);
+			// m -/+ i*u
+			KFN_TWIDDLE(y1r + q, y1i + q, mr + ui, mi - ur, w1r, w1i);
+			KFN_TWIDDLE(y2r + q, y2i + q, mr - ui, mi + ur, w2r, w2i);
+		}
+	}
+}
+
+KATTR static void KFN(pass4)(vDSP_Length m, vDSP_Length s, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	for (vDSP_Length p = 0; p < m; p++)
+	{
+		const VEC w1r = KFN(splat)(twr[p * tws]), w1i = KFN(splat)(twi[p * tws]);
+		const VEC w2r = KFN(splat)(twr[2 * p * tws]), w2i = KFN(splat)(twi[2 * p * tws]);
+		const VEC w3r = KFN(splat)(twr[3 * p * tws]), w3i = KFN(splat)(twi[3 * p * tws]);
+		const REAL *x0r = xr + s * p, *x0i = xi + s * p;
+		const REAL *x1r = x0r + s * m, *x1i = x0i + s * m;
+		const REAL *x2r = x1r + s * m, *x2i = x1i + s * m;
+		const REAL *x3r = x2r + s * m, *x3i = x2i + s * m;
+		REAL *y0r = yr + s * 4 * p, *y0i = yi + s * 4 * p;
+		REAL *y1r = y0r + s, *y1i = y0i + s;
+		REAL *y2r = y1r + s, *y2i = y1i + s;
+		REAL *y3r = y2r + s, *y3i = y2i + s;
+
+		for (vDSP_Length q = 0; q < s; q += VW)
+		{
+			const VEC a0r = KFN(load)(x0r + q), a0i = KFN(load)(x0i + q);
+			const VEC a1r = KFN(load)(x1r + q), a1i = KFN(load)(x1i + q);
+			const VEC a2r = KFN(load)(x2r + q), a2i = KFN(load)(x2i + q);
+			const VEC a3r = KFN(load)(x3r + q), a3i = KFN(load)(x3i + q);
+
+			const VEC t0r = a0r + a2r, t0i = a0i + a2i;
+			const VEC t1r = a0r - a2r, t1i = a0i - a2i;
+			const VEC t2r = a1r + a3r, t2i = a1i + a3i;
+			const VEC t3r = a1r - a3r, t3i = a1i - a3i;
+
+			KFN(store)(y0r + q, t0r + t2r);
+			KFN(store)(y0i + q, t0i + t2i);
+			// t1 -/+ i*t3
+			KFN_TWIDDLE(y1r + q, y1i + q, t1r + t3i, t1i - t3r, w1r, w1i);
+			KFN_TWIDDLE(y2r + q, y2i + q, t0r - t2r, t0i - t2i, w2r, w2i);
+			KFN_TWIDDLE(y3r + q, y3i + q, t1r - t3i, t1i + t3r, w3r, w3i);
+		}
+	}
+}
+
+KATTR static void KFN(pass5)(vDSP_Length m, vDSP_Length s, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	// cos and sin of 2*pi/5 and 4*pi/5
+	const VEC c1 = KFN(splat)(0.309016994374947424102293417182819059);
+	const VEC c2 = KFN(splat)(-0.809016994374947424102293417182819059);
+	const VEC s1 = KFN(splat)(0.951056516295153572116439333379382143);
+	const VEC s2 = KFN(splat)(0.587785252292473129168705954639072769);
+
+	for (vDSP_Length p = 0; p < m; p++)
+	{
+		const VEC w1r = KFN(splat)(twr[p * tws]), w1i = KFN(splat)(twi[p * tws]);
+		const VEC w2r = KFN(splat)(twr[2 * p * tws]), w2i = KFN(splat)(twi[2 * p * tws]);
+		const VEC w3r = KFN(splat)(twr[3 * p * tws]), w3i = KFN(splat)(twi[3 * p * tws]);
+		const VEC w4r = KFN(splat)(twr[4 * p * tws]), w4i = KFN(splat)(twi[4 * p * tws]);
+		const REAL *x0r = xr + s * p, *x0i = xi + s * p;
+		const REAL *x1r = x0r + s * m, *x1i = x0i + s * m;
+		const REAL *x2r = x1r + s * m, *x2i = x1i + s * m;
+		const REAL *x3r = x2r + s * m, *x3i = x2i + s * m;
+		const REAL *x4r = x3r + s * m, *x4i = x3i + s * m;
+		REAL *y0r = yr + s * 5 * p, *y0i = yi + s * 5 * p;
+		REAL *y1r = y0r + s, *y1i = y0i + s;
+		REAL *y2r = y1r + s, *y2i = y1i + s;
+		REAL *y3r = y2r + s, *y3i = y2i + s;
+		REAL *y4r = y3r + s, *y4i = y3i + s;
+
+		for (vDSP_Length q = 0; q < s; q += VW)
+		{
+			const VEC a0r = KFN(load)(x0r + q), a0i = KFN(load)(x0i + q);
+			const VEC a1r = KFN(load)(x1r + q), a1i = KFN(load)(x1i + q);
+			const VEC a2r = KFN(load)(x2r + q), a2i = KFN(load)(x2i + q);
+			const VEC a3r = KFN(load)(x3r + q), a3i = KFN(load)(x3i + q);
+			const VEC a4r = KFN(load)(x4r + q), a4i = KFN(load)(x4i + q);
+
+			const VEC t1r = a1r + a4r, t1i = a1i + a4i;
+			const VEC t2r = a2r + a3r, t2i = a2i + a3i;
+			const VEC t3r = a1r - a4r, t3i = a1i - a4i;
+			const VEC t4r = a2r - a3r, t4i = a2i - a3i;
+
+			const VEC m1r = a0r + c1 * t1r + c2 * t2r, m1i = a0i + c1 * t1i + c2 * t2i;
+			const VEC m2r = a0r + c2 * t1r + c1 * t2r, m2i = a0i + c2 * t1i + c1 * t2i;
+			const VEC n1r = s1 * t3r + s2 * t4r, n1i = s1 * t3i + s2 * t4i;
+			const VEC n2r = s2 * t3r - s1 * t4r, n2i = s2 * t3i - s1 * t4i;
+
+			KFN(store)(y0r + q, a0r + t1r + t2r);
+			KFN(store)(y0i + q, a0i + t1i + t2i);
+			// m -/+ i*n
+			KFN_TWIDDLE(y1r + q, y1i + q, m1r + n1i, m1i - n1r, w1r, w1i);
+			KFN_TWIDDLE(y2r + q, y2i + q, m2r + n2i, m2i - n2r, w2r, w2i);
+			KFN_TWIDDLE(y3r + q, y3i + q, m2r - n2i, m2i + n2r, w3r, w3i);
+			KFN_TWIDDLE(y4r + q, y4i + q, m1r - n1i, m1i + n1r, w4r, w4i);
+		}
+	}
+}
+
+#ifdef KFIRST4
+
+KATTR static inline VEC KFN(gather)(const REAL* table, vDSP_Length index, vDSP_Length step)
+{
+#if VW == 2
+	VEC v = { table[index], table[index + step] };
+#else
+	VEC v = { table[index], table[index + step], table[index + 2 * step], table[index + 3 * step] };
+#endif
+	return v;
+}
+
+// Stores VW consecutive radix-4 butterflies (one per lane) to y[4*p + k]
+KATTR static inline void KFN(store4)(REAL* y, VEC b0, VEC b1, VEC b2, VEC b3)
+{
+#if VW == 2
+	KFN(store)(y, __builtin_shufflevector(b0, b1, 0, 2));
+	KFN(store)(y + 2, __builtin_shufflevector(b2, b3, 0, 2));
+	KFN(store)(y + 4, __builtin_shufflevector(b0, b1, 1, 3));
+	KFN(store)(y + 6, __builtin_shufflevector(b2, b3, 1, 3));
+#else
+	const VEC t0 = __builtin_shufflevector(b0, b1, 0, 4, 1, 5);
+	const VEC t1 = __builtin_shufflevector(b0, b1, 2, 6, 3, 7);
+	const VEC t2 = __builtin_shufflevector(b2, b3, 0, 4, 1, 5);
+	const VEC t3 = __builtin_shufflevector(b2, b3, 2, 6, 3, 7);
+
+	KFN(store)(y, __builtin_shufflevector(t0, t2, 0, 1, 4, 5));
+	KFN(store)(y + 4, __builtin_shufflevector(t0, t2, 2, 3, 6, 7));
+	KFN(store)(y + 8, __builtin_shufflevector(t1, t3, 0, 1, 4, 5));
+	KFN(store)(y + 12, __builtin_shufflevector(t1, t3, 2, 3, 6, 7));
+#endif
+}
+
+// The first radix-4 pass (s == 1): vectorized over p, with the outputs transposed on the way out
+KATTR static void KFN(first4)(vDSP_Length m, const REAL* twr, const REAL* twi, vDSP_Length tws,
+	const REAL* xr, const REAL* xi, REAL* yr, REAL* yi)
+{
+	vDSP_Length p = 0;
+
+	for (; p + VW <= m; p += VW)
+	{
+		const VEC w1r = KFN(gather)(twr, p * tws, tws), w1i = KFN(gather)(twi, p * tws, tws);
+		const VEC w2r = KFN(gather)(twr, 2 * p * tws, 2 * tws), w2i = KFN(gather)(twi, 2 * p * tws, 2 * tws);
+		const VEC w3r = KFN(gather)(twr, 3 * p * tws, 3 * tws), w3i = KFN(gather)(twi, 3 * p * tws, 3 * tws);
+
+		const VEC a0r = KFN(load)(xr + p), a0i = KFN(load)(xi + p);
+		const VEC a1r = KFN(load)(xr + p + m), a1i = KFN(load)(xi + p + m);
+		const VEC a2r = KFN(load)(xr + p + 2 * m), a2i = KFN(load)(xi + p + 2 * m);
+		const VEC a3r = KFN(load)(xr + p + 3 * m), a3i = KFN(load)(xi + p + 3 * m);
+
+		const VEC t0r = a0r + a2r, t0i = a0i + a2i;
+		const VEC t1r = a0r - a2r, t1i = a0i - a2i;
+		const VEC t2r = a1r + a3r, t2i = a1i + a3i;
+		const VEC t3r = a1r - a3r, t3i = a1i - a3i;
+
+		const VEC b1r = t1r + t3i, b1i = t1i - t3r;
+		const VEC b2r = t0r - t2r, b2i = t0i - t2i;
+		const VEC b3r = t1r - t3i, b3i = t1i + t3r;
+
+		KFN(store4)(yr + 4 * p, t0r + t2r,
+			b1r * w1r - b1i * w1i,
+			b2r * w2r - b2i * w2i,
+			b3r * w3r - b3i * w3i);
+		KFN(store4)(yi + 4 * p, t0i + t2i,
+			b1r * w1i + b1i * w1r,
+			b2r * w2i + b2i * w2r,
+			b3r * w3i + b3i * w3r);
+	}
+
+	// what's left doesn't fill a vector
+	for (; p < m; p++)
+	{
+		const REAL a0r = xr[p], a0i = xi[p];
+		const REAL a1r = xr[p + m], a1i = xi[p + m];
+		const REAL a2r = xr[p + 2 * m], a2i = xi[p + 2 * m];
+		const REAL a3r = xr[p + 3 * m], a3i = xi[p + 3 * m];
+
+		const REAL t0r = a0r + a2r, t0i = a0i + a2i;
+		const REAL t1r = a0r - a2r, t1i = a0i - a2i;
+		const REAL t2r = a1r + a3r, t2i = a1i + a3i;
+		const REAL t3r = a1r - a3r, t3i = a1i - a3i;
+
+		const REAL b1r = t1r + t3i, b1i = t1i - t3r;
+		const REAL b2r = t0r - t2r, b2i = t0i - t2i;
+		const REAL b3r = t1r - t3i, b3i = t1i + t3r;
+
+		const REAL w1r = twr[p * tws], w1i = twi[p * tws];
+		const REAL w2r = twr[2 * p * tws], w2i = twi[2 * p * tws];
+		const REAL w3r = twr[3 * p * tws], w3i = twi[3 * p * tws];
+
+		yr[4 * p] = t0r + t2r;
+		yi[4 * p] = t0i + t2i;
+		yr[4 * p + 1] = b1r * w1r - b1i * w1i;
+		yi[4 * p + 1] = b1r * w1i + b1i * w1r;
+		yr[4 * p + 2] = b2r * w2r - b2i * w2i;
+		yi[4 * p + 2] = b2r * w2i + b2i * w2r;
+		yr[4 * p + 3] = b3r * w3r - b3i * w3i;
+		yi[4 * p + 3] = b3r * w3i + b3i * w3r;
+	}
+}
+
+#endif
+
+#undef VEC
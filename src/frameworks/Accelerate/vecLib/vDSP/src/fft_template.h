@@ -0,0 +1,275 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2020 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// The vDSP_fft* family, included by fft.c once for float and once for double.
+//
+// The includer defines REAL, FN(name) for the exported names, ENGINE(name) for the engine
+// functions of that element type, TABLE for its twiddle table, SETUP and SETUP_STRUCT for the
+// setup type and SPLIT for the split complex type.
+
+SETUP_STRUCT
+{
+	TABLE table;
+	vDSP_Length log2n;
+};
+
+SETUP FN(vDSP_create_fftsetup)(vDSP_Length __Log2n, FFTRadix __Radix)
+{
+	vDSP_Length factor;
+
+	switch (__Radix)
+	{
+		case kFFTRadix2: factor = 1; break;
+		case kFFTRadix3: factor = 3; break;
+		case kFFTRadix5: factor = 5; break;
+		default: return NULL;
+	}
+
+	if (__Log2n > 8 * sizeof(vDSP_Length) - 4)
+		return NULL;
+
+	SETUP setup = (SETUP) malloc(sizeof(*setup));
+	if (!setup)
+		return NULL;
+
+	setup->log2n = __Log2n;
+	if (!ENGINE(fft_table_init)(&setup->table, factor << __Log2n))
+	{
+		free(setup);
+		return NULL;
+	}
+
+	return setup;
+}
+
+void FN(vDSP_destroy_fftsetup)(SETUP __setup)
+{
+	if (!__setup)
+		return;
+
+	ENGINE(fft_table_destroy)(&__setup->table);
+	free(__setup);
+}
+
+// Transforms one signal of n points (n real points for the real transforms) with any strides.
+// Strided data is gathered into scratch memory, transformed there and scattered back.
+static void FN(fft_execute)(SETUP setup, bool real, vDSP_Length n,
+	const REAL* ar, const REAL* ai, vDSP_Stride ia, REAL* cr, REAL* ci, vDSP_Stride ic, FFTDirection direction)
+{
+	const vDSP_Length count = real ? n / 2 : n;
+
+	if (count == 0 || setup->table.length % count != 0)
+		return;
+
+	REAL* scratch = (REAL*) fft_scratch(4 * count * sizeof(REAL));
+	if (!scratch)
+		return;
+
+	REAL* work_re = scratch;
+	REAL* work_im = scratch + count;
+	REAL* data_re = scratch + 2 * count;
+	REAL* data_im = scratch + 3 * count;
+
+	const REAL* src_re = ar;
+	const REAL* src_im = ai;
+	REAL* dst_re = (ic == 1) ? cr : data_re;
+	REAL* dst_im = (ic == 1) ? ci : data_im;
+
+	if (ia != 1)
+	{
+		for (vDSP_Length i = 0; i < count; i++)
+		{
+			data_re[i] = ar[i * ia];
+			data_im[i] = ai[i * ia];
+		}
+		src_re = data_re;
+		src_im = data_im;
+	}
+
+	if (real)
+	{
+		if (direction == kFFTDirection_Forward)
+			ENGINE(fft_real_forward)(&setup->table, n, src_re, src_im, dst_re, dst_im, work_re, work_im);
+		else
+			ENGINE(fft_real_inverse)(&setup->table, n, src_re, src_im, dst_re, dst_im, work_re, work_im);
+	}
+	else
+	{
+		if (direction == kFFTDirection_Forward)
+			ENGINE(fft_complex)(&setup->table, n, src_re, src_im, dst_re, dst_im, work_re, work_im);
+		else
+			ENGINE(fft_complex)(&setup->table, n, src_im, src_re, dst_im, dst_re, work_im, work_re);
+	}
+
+	if (ic != 1)
+	{
+		for (vDSP_Length i = 0; i < count; i++)
+		{
+			cr[i * ic] = dst_re[i];
+			ci[i * ic] = dst_im[i];
+		}
+	}
+}
+
+static void FN(fftm_execute)(SETUP setup, bool real, vDSP_Length n,
+	const SPLIT* a, vDSP_Stride ia, vDSP_Stride ima, const SPLIT* c, vDSP_Stride ic, vDSP_Stride imc,
+	vDSP_Length m, FFTDirection direction)
+{
+	for (vDSP_Length j = 0; j < m; j++)
+	{
+		FN(fft_execute)(setup, real, n, a->realp + j * ima, a->imagp + j * ima, ia,
+			c->realp + j * imc, c->imagp + j * imc, ic, direction);
+	}
+}
+
+// Complex transforms of 2^Log2N points
+
+void FN(vDSP_fft_zip)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 1ul << __Log2N, __C, __IC, 0, __C, __IC, 0, 1, __Direction);
+}
+
+// The temporary buffer isn't used, its size depends on what the caller thought our
+// implementation needs. We use our own per-thread scratch memory instead.
+void FN(vDSP_fft_zipt)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, const SPLIT *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fft_zip)(__Setup, __C, __IC, __Log2N, __Direction);
+}
+
+void FN(vDSP_fft_zop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 1ul << __Log2N, __A, __IA, 0, __C, __IC, 0, 1, __Direction);
+}
+
+void FN(vDSP_fft_zopt)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, const SPLIT *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fft_zop)(__Setup, __A, __IA, __C, __IC, __Log2N, __Direction);
+}
+
+// Complex transforms of 3*2^Log2N and 5*2^Log2N points, the setup must be for radix 3 or 5
+
+void FN(vDSP_fft3_zop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 3ul << __Log2N, __A, __IA, 0, __C, __IC, 0, 1, __Direction);
+}
+
+void FN(vDSP_fft5_zop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 5ul << __Log2N, __A, __IA, 0, __C, __IC, 0, 1, __Direction);
+}
+
+// Real transforms of 2^Log2N points in the packed format
+
+void FN(vDSP_fft_zrip)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, true, 1ul << __Log2N, __C, __IC, 0, __C, __IC, 0, 1, __Direction);
+}
+
+void FN(vDSP_fft_zript)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, const SPLIT *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fft_zrip)(__Setup, __C, __IC, __Log2N, __Direction);
+}
+
+void FN(vDSP_fft_zrop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, true, 1ul << __Log2N, __A, __IA, 0, __C, __IC, 0, 1, __Direction);
+}
+
+void FN(vDSP_fft_zropt)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, const SPLIT *__C, vDSP_Stride __IC, const SPLIT *__Buffer, vDSP_Length __Log2N, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fft_zrop)(__Setup, __A, __IA, __C, __IC, __Log2N, __Direction);
+}
+
+// M signals at a distance of IM elements
+
+void FN(vDSP_fftm_zip)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 1ul << __Log2N, __C, __IC, __IM, __C, __IC, __IM, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zipt)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IM, const SPLIT *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fftm_zip)(__Setup, __C, __IC, __IM, __Log2N, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, false, 1ul << __Log2N, __A, __IA, __IMA, __C, __IC, __IMC, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zopt)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const SPLIT *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fftm_zop)(__Setup, __A, __IA, __IMA, __C, __IC, __IMC, __Log2N, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zrip)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IM, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, true, 1ul << __Log2N, __C, __IC, __IM, __C, __IC, __IM, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zript)(SETUP __Setup, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IM, const SPLIT *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fftm_zrip)(__Setup, __C, __IC, __IM, __Log2N, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zrop)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IMC, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	if (__Log2N > __Setup->log2n)
+		return;
+	FN(fftm_execute)(__Setup, true, 1ul << __Log2N, __A, __IA, __IMA, __C, __IC, __IMC, __M, __Direction);
+}
+
+void FN(vDSP_fftm_zropt)(SETUP __Setup, const SPLIT *__A, vDSP_Stride __IA, vDSP_Stride __IMA, const SPLIT *__C, vDSP_Stride __IC, vDSP_Stride __IMC, const SPLIT *__Buffer, vDSP_Length __Log2N, vDSP_Length __M, FFTDirection __Direction)
+{
+	(void)__Buffer;
+
+	FN(vDSP_fftm_zrop)(__Setup, __A, __IA, __IMA, __C, __IC, __IMC, __Log2N, __M, __Direction);
+}
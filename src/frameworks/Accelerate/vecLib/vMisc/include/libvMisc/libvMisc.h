@@ -21,176 +21,180 @@
 #ifndef _libvMisc_H_
 #define _libvMisc_H_
 
-void* VVACOS(void);
-void* VVACOSF(void);
-void* VVACOSF_(void);
-void* VVACOSH(void);
-void* VVACOSHF(void);
-void* VVACOSHF_(void);
-void* VVACOSH_(void);
-void* VVACOS_(void);
-void* VVASIN(void);
-void* VVASINF(void);
-void* VVASINF_(void);
-void* VVASINH(void);
-void* VVASINHF(void);
-void* VVASINHF_(void);
-void* VVASINH_(void);
-void* VVASIN_(void);
-void* VVATAN(void);
-void* VVATAN2(void);
-void* VVATAN2F(void);
-void* VVATAN2F_(void);
-void* VVATAN2_(void);
-void* VVATANF(void);
-void* VVATANF_(void);
-void* VVATANH(void);
-void* VVATANHF(void);
-void* VVATANHF_(void);
-void* VVATANH_(void);
-void* VVATAN_(void);
-void* VVCBRT(void);
-void* VVCBRTF(void);
-void* VVCBRTF_(void);
-void* VVCBRT_(void);
-void* VVCEIL(void);
-void* VVCEILF(void);
-void* VVCEILF_(void);
-void* VVCEIL_(void);
-void* VVCOPYSIGN(void);
-void* VVCOPYSIGNF(void);
-void* VVCOPYSIGNF_(void);
-void* VVCOPYSIGN_(void);
-void* VVCOS(void);
-void* VVCOSF(void);
-void* VVCOSF_(void);
-void* VVCOSH(void);
-void* VVCOSHF(void);
-void* VVCOSHF_(void);
-void* VVCOSH_(void);
-void* VVCOSISIN(void);
-void* VVCOSISINF(void);
-void* VVCOSISINF_(void);
-void* VVCOSISIN_(void);
-void* VVCOSPI(void);
-void* VVCOSPIF(void);
-void* VVCOSPIF_(void);
-void* VVCOSPI_(void);
-void* VVCOS_(void);
-void* VVDIV(void);
-void* VVDIVF(void);
-void* VVDIVF_(void);
-void* VVDIV_(void);
-void* VVEXP(void);
-void* VVEXP2(void);
-void* VVEXP2F(void);
-void* VVEXP2F_(void);
-void* VVEXP2_(void);
-void* VVEXPF(void);
-void* VVEXPF_(void);
-void* VVEXPM1(void);
-void* VVEXPM1F(void);
-void* VVEXPM1F_(void);
-void* VVEXPM1_(void);
-void* VVEXP_(void);
-void* VVFABF(void);
-void* VVFABF_(void);
-void* VVFABS(void);
-void* VVFABSF(void);
-void* VVFABSF_(void);
-void* VVFABS_(void);
-void* VVFLOOR(void);
-void* VVFLOORF(void);
-void* VVFLOORF_(void);
-void* VVFLOOR_(void);
-void* VVFMOD(void);
-void* VVFMODF(void);
-void* VVFMODF_(void);
-void* VVFMOD_(void);
-void* VVINT(void);
-void* VVINTF(void);
-void* VVINTF_(void);
-void* VVINT_(void);
-void* VVLOG(void);
-void* VVLOG10(void);
-void* VVLOG10F(void);
-void* VVLOG10F_(void);
-void* VVLOG10_(void);
-void* VVLOG1P(void);
-void* VVLOG1PF(void);
-void* VVLOG1PF_(void);
-void* VVLOG1P_(void);
-void* VVLOG2(void);
-void* VVLOG2F(void);
-void* VVLOG2F_(void);
-void* VVLOG2_(void);
-void* VVLOGB(void);
-void* VVLOGBF(void);
-void* VVLOGBF_(void);
-void* VVLOGB_(void);
-void* VVLOGF(void);
-void* VVLOGF_(void);
-void* VVLOG_(void);
-void* VVNEXTAFTER(void);
-void* VVNEXTAFTERF(void);
-void* VVNEXTAFTERF_(void);
-void* VVNEXTAFTER_(void);
-void* VVNINT(void);
-void* VVNINTF(void);
-void* VVNINTF_(void);
-void* VVNINT_(void);
-void* VVPOW(void);
-void* VVPOWF(void);
-void* VVPOWF_(void);
-void* VVPOWS(void);
-void* VVPOWSF(void);
-void* VVPOWSF_(void);
-void* VVPOWS_(void);
-void* VVPOW_(void);
-void* VVREC(void);
-void* VVRECF(void);
-void* VVRECF_(void);
-void* VVREC_(void);
-void* VVREMAINDER(void);
-void* VVREMAINDERF(void);
-void* VVREMAINDERF_(void);
-void* VVREMAINDER_(void);
-void* VVRSQRT(void);
-void* VVRSQRTF(void);
-void* VVRSQRTF_(void);
-void* VVRSQRT_(void);
-void* VVSIN(void);
-void* VVSINCOS(void);
-void* VVSINCOSF(void);
-void* VVSINCOSF_(void);
-void* VVSINCOS_(void);
-void* VVSINF(void);
-void* VVSINF_(void);
-void* VVSINH(void);
-void* VVSINHF(void);
-void* VVSINHF_(void);
-void* VVSINH_(void);
-void* VVSINPI(void);
-void* VVSINPIF(void);
-void* VVSINPIF_(void);
-void* VVSINPI_(void);
-void* VVSIN_(void);
-void* VVSQRT(void);
-void* VVSQRTF(void);
-void* VVSQRTF_(void);
-void* VVSQRT_(void);
-void* VVTAN(void);
-void* VVTANF(void);
-void* VVTANF_(void);
-void* VVTANH(void);
-void* VVTANHF(void);
-void* VVTANHF_(void);
-void* VVTANH_(void);
-void* VVTANPI(void);
-void* VVTANPIF(void);
-void* VVTANPIF_(void);
-void* VVTANPI_(void);
-void* VVTAN_(void);
+// vForce
+typedef float _Complex __float_complex_t;
+typedef double _Complex __double_complex_t;
+
+void VVACOS(double *__y, const double *__x, const int *__n);
+void VVACOSF(float *__y, const float *__x, const int *__n);
+void VVACOSF_(float *__y, const float *__x, const int *__n);
+void VVACOSH(double *__y, const double *__x, const int *__n);
+void VVACOSHF(float *__y, const float *__x, const int *__n);
+void VVACOSHF_(float *__y, const float *__x, const int *__n);
+void VVACOSH_(double *__y, const double *__x, const int *__n);
+void VVACOS_(double *__y, const double *__x, const int *__n);
+void VVASIN(double *__y, const double *__x, const int *__n);
+void VVASINF(float *__y, const float *__x, const int *__n);
+void VVASINF_(float *__y, const float *__x, const int *__n);
+void VVASINH(double *__y, const double *__x, const int *__n);
+void VVASINHF(float *__y, const float *__x, const int *__n);
+void VVASINHF_(float *__y, const float *__x, const int *__n);
+void VVASINH_(double *__y, const double *__x, const int *__n);
+void VVASIN_(double *__y, const double *__x, const int *__n);
+void VVATAN(double *__y, const double *__x, const int *__n);
+void VVATAN2(double *__z, const double *__y, const double *__x, const int *__n);
+void VVATAN2F(float *__z, const float *__y, const float *__x, const int *__n);
+void VVATAN2F_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVATAN2_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVATANF(float *__y, const float *__x, const int *__n);
+void VVATANF_(float *__y, const float *__x, const int *__n);
+void VVATANH(double *__y, const double *__x, const int *__n);
+void VVATANHF(float *__y, const float *__x, const int *__n);
+void VVATANHF_(float *__y, const float *__x, const int *__n);
+void VVATANH_(double *__y, const double *__x, const int *__n);
+void VVATAN_(double *__y, const double *__x, const int *__n);
+void VVCBRT(double *__y, const double *__x, const int *__n);
+void VVCBRTF(float *__y, const float *__x, const int *__n);
+void VVCBRTF_(float *__y, const float *__x, const int *__n);
+void VVCBRT_(double *__y, const double *__x, const int *__n);
+void VVCEIL(double *__y, const double *__x, const int *__n);
+void VVCEILF(float *__y, const float *__x, const int *__n);
+void VVCEILF_(float *__y, const float *__x, const int *__n);
+void VVCEIL_(double *__y, const double *__x, const int *__n);
+void VVCOPYSIGN(double *__z, const double *__y, const double *__x, const int *__n);
+void VVCOPYSIGNF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVCOPYSIGNF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVCOPYSIGN_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVCOS(double *__y, const double *__x, const int *__n);
+void VVCOSF(float *__y, const float *__x, const int *__n);
+void VVCOSF_(float *__y, const float *__x, const int *__n);
+void VVCOSH(double *__y, const double *__x, const int *__n);
+void VVCOSHF(float *__y, const float *__x, const int *__n);
+void VVCOSHF_(float *__y, const float *__x, const int *__n);
+void VVCOSH_(double *__y, const double *__x, const int *__n);
+void VVCOSISIN(__double_complex_t *__z, const double *__x, const int *__n);
+void VVCOSISINF(__float_complex_t *__z, const float *__x, const int *__n);
+void VVCOSISINF_(__float_complex_t *__z, const float *__x, const int *__n);
+void VVCOSISIN_(__double_complex_t *__z, const double *__x, const int *__n);
+void VVCOSPI(double *__y, const double *__x, const int *__n);
+void VVCOSPIF(float *__y, const float *__x, const int *__n);
+void VVCOSPIF_(float *__y, const float *__x, const int *__n);
+void VVCOSPI_(double *__y, const double *__x, const int *__n);
+void VVCOS_(double *__y, const double *__x, const int *__n);
+void VVDIV(double *__z, const double *__y, const double *__x, const int *__n);
+void VVDIVF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVDIVF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVDIV_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVEXP(double *__y, const double *__x, const int *__n);
+void VVEXP2(double *__y, const double *__x, const int *__n);
+void VVEXP2F(float *__y, const float *__x, const int *__n);
+void VVEXP2F_(float *__y, const float *__x, const int *__n);
+void VVEXP2_(double *__y, const double *__x, const int *__n);
+void VVEXPF(float *__y, const float *__x, const int *__n);
+void VVEXPF_(float *__y, const float *__x, const int *__n);
+void VVEXPM1(double *__y, const double *__x, const int *__n);
+void VVEXPM1F(float *__y, const float *__x, const int *__n);
+void VVEXPM1F_(float *__y, const float *__x, const int *__n);
+void VVEXPM1_(double *__y, const double *__x, const int *__n);
+void VVEXP_(double *__y, const double *__x, const int *__n);
+void VVFABF(float *__y, const float *__x, const int *__n);
+void VVFABF_(float *__y, const float *__x, const int *__n);
+void VVFABS(double *__y, const double *__x, const int *__n);
+void VVFABSF(float *__y, const float *__x, const int *__n);
+void VVFABSF_(float *__y, const float *__x, const int *__n);
+void VVFABS_(double *__y, const double *__x, const int *__n);
+void VVFLOOR(double *__y, const double *__x, const int *__n);
+void VVFLOORF(float *__y, const float *__x, const int *__n);
+void VVFLOORF_(float *__y, const float *__x, const int *__n);
+void VVFLOOR_(double *__y, const double *__x, const int *__n);
+void VVFMOD(double *__z, const double *__y, const double *__x, const int *__n);
+void VVFMODF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVFMODF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVFMOD_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVINT(double *__y, const double *__x, const int *__n);
+void VVINTF(float *__y, const float *__x, const int *__n);
+void VVINTF_(float *__y, const float *__x, const int *__n);
+void VVINT_(double *__y, const double *__x, const int *__n);
+void VVLOG(double *__y, const double *__x, const int *__n);
+void VVLOG10(double *__y, const double *__x, const int *__n);
+void VVLOG10F(float *__y, const float *__x, const int *__n);
+void VVLOG10F_(float *__y, const float *__x, const int *__n);
+void VVLOG10_(double *__y, const double *__x, const int *__n);
+void VVLOG1P(double *__y, const double *__x, const int *__n);
+void VVLOG1PF(float *__y, const float *__x, const int *__n);
+void VVLOG1PF_(float *__y, const float *__x, const int *__n);
+void VVLOG1P_(double *__y, const double *__x, const int *__n);
+void VVLOG2(double *__y, const double *__x, const int *__n);
+void VVLOG2F(float *__y, const float *__x, const int *__n);
+void VVLOG2F_(float *__y, const float *__x, const int *__n);
+void VVLOG2_(double *__y, const double *__x, const int *__n);
+void VVLOGB(double *__y, const double *__x, const int *__n);
+void VVLOGBF(float *__y, const float *__x, const int *__n);
+void VVLOGBF_(float *__y, const float *__x, const int *__n);
+void VVLOGB_(double *__y, const double *__x, const int *__n);
+void VVLOGF(float *__y, const float *__x, const int *__n);
+void VVLOGF_(float *__y, const float *__x, const int *__n);
+void VVLOG_(double *__y, const double *__x, const int *__n);
+void VVNEXTAFTER(double *__z, const double *__y, const double *__x, const int *__n);
+void VVNEXTAFTERF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVNEXTAFTERF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVNEXTAFTER_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVNINT(double *__y, const double *__x, const int *__n);
+void VVNINTF(float *__y, const float *__x, const int *__n);
+void VVNINTF_(float *__y, const float *__x, const int *__n);
+void VVNINT_(double *__y, const double *__x, const int *__n);
+void VVPOW(double *__z, const double *__y, const double *__x, const int *__n);
+void VVPOWF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVPOWF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVPOWS(double *__z, const double *__y, const double *__x, const int *__n);
+void VVPOWSF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVPOWSF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVPOWS_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVPOW_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVREC(double *__y, const double *__x, const int *__n);
+void VVRECF(float *__y, const float *__x, const int *__n);
+void VVRECF_(float *__y, const float *__x, const int *__n);
+void VVREC_(double *__y, const double *__x, const int *__n);
+void VVREMAINDER(double *__z, const double *__y, const double *__x, const int *__n);
+void VVREMAINDERF(float *__z, const float *__y, const float *__x, const int *__n);
+void VVREMAINDERF_(float *__z, const float *__y, const float *__x, const int *__n);
+void VVREMAINDER_(double *__z, const double *__y, const double *__x, const int *__n);
+void VVRSQRT(double *__y, const double *__x, const int *__n);
+void VVRSQRTF(float *__y, const float *__x, const int *__n);
+void VVRSQRTF_(float *__y, const float *__x, const int *__n);
+void VVRSQRT_(double *__y, const double *__x, const int *__n);
+void VVSIN(double *__y, const double *__x, const int *__n);
+void VVSINCOS(double *__z, double *__y, const double *__x, const int *__n);
+void VVSINCOSF(float *__z, float *__y, const float *__x, const int *__n);
+void VVSINCOSF_(float *__z, float *__y, const float *__x, const int *__n);
+void VVSINCOS_(double *__z, double *__y, const double *__x, const int *__n);
+void VVSINF(float *__y, const float *__x, const int *__n);
+void VVSINF_(float *__y, const float *__x, const int *__n);
+void VVSINH(double *__y, const double *__x, const int *__n);
+void VVSINHF(float *__y, const float *__x, const int *__n);
+void VVSINHF_(float *__y, const float *__x, const int *__n);
+void VVSINH_(double *__y, const double *__x, const int *__n);
+void VVSINPI(double *__y, const double *__x, const int *__n);
+void VVSINPIF(float *__y, const float *__x, const int *__n);
+void VVSINPIF_(float *__y, const float *__x, const int *__n);
+void VVSINPI_(double *__y, const double *__x, const int *__n);
+void VVSIN_(double *__y, const double *__x, const int *__n);
+void VVSQRT(double *__y, const double *__x, const int *__n);
+void VVSQRTF(float *__y, const float *__x, const int *__n);
+void VVSQRTF_(float *__y, const float *__x, const int *__n);
+void VVSQRT_(double *__y, const double *__x, const int *__n);
+void VVTAN(double *__y, const double *__x, const int *__n);
+void VVTANF(float *__y, const float *__x, const int *__n);
+void VVTANF_(float *__y, const float *__x, const int *__n);
+void VVTANH(double *__y, const double *__x, const int *__n);
+void VVTANHF(float *__y, const float *__x, const int *__n);
+void VVTANHF_(float *__y, const float *__x, const int *__n);
+void VVTANH_(double *__y, const double *__x, const int *__n);
+void VVTANPI(double *__y, const double *__x, const int *__n);
+void VVTANPIF(float *__y, const float *__x, const int *__n);
+void VVTANPIF_(float *__y, const float *__x, const int *__n);
+void VVTANPI_(double *__y, const double *__x, const int *__n);
+void VVTAN_(double *__y, const double *__x, const int *__n);
 void* __cblas_isamax(void);
 void* __cblas_sasum(void);
 void* __cblas_saxpy(void);
@@ -443,175 +447,175 @@ void* vtanf(void);
 void* vtanhf(void);
 void* vtanpif(void);
 void* vtruncf(void);
-void* vvacos(void);
-void* vvacos_(void);
-void* vvacosf(void);
-void* vvacosf_(void);
-void* vvacosh(void);
-void* vvacosh_(void);
-void* vvacoshf(void);
-void* vvacoshf_(void);
-void* vvasin(void);
-void* vvasin_(void);
-void* vvasinf(void);
-void* vvasinf_(void);
-void* vvasinh(void);
-void* vvasinh_(void);
-void* vvasinhf(void);
-void* vvasinhf_(void);
-void* vvatan(void);
-void* vvatan2(void);
-void* vvatan2_(void);
-void* vvatan2f(void);
-void* vvatan2f_(void);
-void* vvatan_(void);
-void* vvatanf(void);
-void* vvatanf_(void);
-void* vvatanh(void);
-void* vvatanh_(void);
-void* vvatanhf(void);
-void* vvatanhf_(void);
-void* vvcbrt(void);
-void* vvcbrt_(void);
-void* vvcbrtf(void);
-void* vvcbrtf_(void);
-void* vvceil(void);
-void* vvceil_(void);
-void* vvceilf(void);
-void* vvceilf_(void);
-void* vvcopysign(void);
-void* vvcopysign_(void);
-void* vvcopysignf(void);
-void* vvcopysignf_(void);
-void* vvcos(void);
-void* vvcos_(void);
-void* vvcosf(void);
-void* vvcosf_(void);
-void* vvcosh(void);
-void* vvcosh_(void);
-void* vvcoshf(void);
-void* vvcoshf_(void);
-void* vvcosisin(void);
-void* vvcosisin_(void);
-void* vvcosisinf(void);
-void* vvcosisinf_(void);
-void* vvcospi(void);
-void* vvcospi_(void);
-void* vvcospif(void);
-void* vvcospif_(void);
-void* vvdiv(void);
-void* vvdiv_(void);
-void* vvdivf(void);
-void* vvdivf_(void);
-void* vvexp(void);
-void* vvexp2(void);
-void* vvexp2_(void);
-void* vvexp2f(void);
-void* vvexp2f_(void);
-void* vvexp_(void);
-void* vvexpf(void);
-void* vvexpf_(void);
-void* vvexpm1(void);
-void* vvexpm1_(void);
-void* vvexpm1f(void);
-void* vvexpm1f_(void);
-void* vvfabf(void);
-void* vvfabf_(void);
-void* vvfabs(void);
-void* vvfabs_(void);
-void* vvfabsf(void);
-void* vvfabsf_(void);
-void* vvfloor(void);
-void* vvfloor_(void);
-void* vvfloorf(void);
-void* vvfloorf_(void);
-void* vvfmod(void);
-void* vvfmod_(void);
-void* vvfmodf(void);
-void* vvfmodf_(void);
-void* vvint(void);
-void* vvint_(void);
-void* vvintf(void);
-void* vvintf_(void);
-void* vvlog(void);
-void* vvlog10(void);
-void* vvlog10_(void);
-void* vvlog10f(void);
-void* vvlog10f_(void);
-void* vvlog1p(void);
-void* vvlog1p_(void);
-void* vvlog1pf(void);
-void* vvlog1pf_(void);
-void* vvlog2(void);
-void* vvlog2_(void);
-void* vvlog2f(void);
-void* vvlog2f_(void);
-void* vvlog_(void);
-void* vvlogb(void);
-void* vvlogb_(void);
-void* vvlogbf(void);
-void* vvlogbf_(void);
-void* vvlogf(void);
-void* vvlogf_(void);
-void* vvnextafter(void);
-void* vvnextafter_(void);
-void* vvnextafterf(void);
-void* vvnextafterf_(void);
-void* vvnint(void);
-void* vvnint_(void);
-void* vvnintf(void);
-void* vvnintf_(void);
-void* vvpow(void);
-void* vvpow_(void);
-void* vvpowf(void);
-void* vvpowf_(void);
-void* vvpows(void);
-void* vvpows_(void);
-void* vvpowsf(void);
-void* vvpowsf_(void);
-void* vvrec(void);
-void* vvrec_(void);
-void* vvrecf(void);
-void* vvrecf_(void);
-void* vvremainder(void);
-void* vvremainder_(void);
-void* vvremainderf(void);
-void* vvremainderf_(void);
-void* vvrsqrt(void);
-void* vvrsqrt_(void);
-void* vvrsqrtf(void);
-void* vvrsqrtf_(void);
-void* vvsin(void);
-void* vvsin_(void);
-void* vvsincos(void);
-void* vvsincos_(void);
-void* vvsincosf(void);
-void* vvsincosf_(void);
-void* vvsinf(void);
-void* vvsinf_(void);
-void* vvsinh(void);
-void* vvsinh_(void);
-void* vvsinhf(void);
-void* vvsinhf_(void);
-void* vvsinpi(void);
-void* vvsinpi_(void);
-void* vvsinpif(void);
-void* vvsinpif_(void);
-void* vvsqrt(void);
-void* vvsqrt_(void);
-void* vvsqrtf(void);
-void* vvsqrtf_(void);
-void* vvtan(void);
-void* vvtan_(void);
-void* vvtanf(void);
-void* vvtanf_(void);
-void* vvtanh(void);
-void* vvtanh_(void);
-void* vvtanhf(void);
-void* vvtanhf_(void);
-void* vvtanpi(void);
-void* vvtanpi_(void);
-void* vvtanpif(void);
-void* vvtanpif_(void);
+void vvacos(double *__y, const double *__x, const int *__n);
+void vvacos_(double *__y, const double *__x, const int *__n);
+void vvacosf(float *__y, const float *__x, const int *__n);
+void vvacosf_(float *__y, const float *__x, const int *__n);
+void vvacosh(double *__y, const double *__x, const int *__n);
+void vvacosh_(double *__y, const double *__x, const int *__n);
+void vvacoshf(float *__y, const float *__x, const int *__n);
+void vvacoshf_(float *__y, const float *__x, const int *__n);
+void vvasin(double *__y, const double *__x, const int *__n);
+void vvasin_(double *__y, const double *__x, const int *__n);
+void vvasinf(float *__y, const float *__x, const int *__n);
+void vvasinf_(float *__y, const float *__x, const int *__n);
+void vvasinh(double *__y, const double *__x, const int *__n);
+void vvasinh_(double *__y, const double *__x, const int *__n);
+void vvasinhf(float *__y, const float *__x, const int *__n);
+void vvasinhf_(float *__y, const float *__x, const int *__n);
+void vvatan(double *__y, const double *__x, const int *__n);
+void vvatan2(double *__z, const double *__y, const double *__x, const int *__n);
+void vvatan2_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvatan2f(float *__z, const float *__y, const float *__x, const int *__n);
+void vvatan2f_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvatan_(double *__y, const double *__x, const int *__n);
+void vvatanf(float *__y, const float *__x, const int *__n);
+void vvatanf_(float *__y, const float *__x, const int *__n);
+void vvatanh(double *__y, const double *__x, const int *__n);
+void vvatanh_(double *__y, const double *__x, const int *__n);
+void vvatanhf(float *__y, const float *__x, const int *__n);
+void vvatanhf_(float *__y, const float *__x, const int *__n);
+void vvcbrt(double *__y, const double *__x, const int *__n);
+void vvcbrt_(double *__y, const double *__x, const int *__n);
+void vvcbrtf(float *__y, const float *__x, const int *__n);
+void vvcbrtf_(float *__y, const float *__x, const int *__n);
+void vvceil(double *__y, const double *__x, const int *__n);
+void vvceil_(double *__y, const double *__x, const int *__n);
+void vvceilf(float *__y, const float *__x, const int *__n);
+void vvceilf_(float *__y, const float *__x, const int *__n);
+void vvcopysign(double *__z, const double *__y, const double *__x, const int *__n);
+void vvcopysign_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvcopysignf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvcopysignf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvcos(double *__y, const double *__x, const int *__n);
+void vvcos_(double *__y, const double *__x, const int *__n);
+void vvcosf(float *__y, const float *__x, const int *__n);
+void vvcosf_(float *__y, const float *__x, const int *__n);
+void vvcosh(double *__y, const double *__x, const int *__n);
+void vvcosh_(double *__y, const double *__x, const int *__n);
+void vvcoshf(float *__y, const float *__x, const int *__n);
+void vvcoshf_(float *__y, const float *__x, const int *__n);
+void vvcosisin(__double_complex_t *__z, const double *__x, const int *__n);
+void vvcosisin_(__double_complex_t *__z, const double *__x, const int *__n);
+void vvcosisinf(__float_complex_t *__z, const float *__x, const int *__n);
+void vvcosisinf_(__float_complex_t *__z, const float *__x, const int *__n);
+void vvcospi(double *__y, const double *__x, const int *__n);
+void vvcospi_(double *__y, const double *__x, const int *__n);
+void vvcospif(float *__y, const float *__x, const int *__n);
+void vvcospif_(float *__y, const float *__x, const int *__n);
+void vvdiv(double *__z, const double *__y, const double *__x, const int *__n);
+void vvdiv_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvdivf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvdivf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvexp(double *__y, const double *__x, const int *__n);
+void vvexp2(double *__y, const double *__x, const int *__n);
+void vvexp2_(double *__y, const double *__x, const int *__n);
+void vvexp2f(float *__y, const float *__x, const int *__n);
+void vvexp2f_(float *__y, const float *__x, const int *__n);
+void vvexp_(double *__y, const double *__x, const int *__n);
+void vvexpf(float *__y, const float *__x, const int *__n);
+void vvexpf_(float *__y, const float *__x, const int *__n);
+void vvexpm1(double *__y, const double *__x, const int *__n);
+void vvexpm1_(double *__y, const double *__x, const int *__n);
+void vvexpm1f(float *__y, const float *__x, const int *__n);
+void vvexpm1f_(float *__y, const float *__x, const int *__n);
+void vvfabf(float *__y, const float *__x, const int *__n);
+void vvfabf_(float *__y, const float *__x, const int *__n);
+void vvfabs(double *__y, const double *__x, const int *__n);
+void vvfabs_(double *__y, const double *__x, const int *__n);
+void vvfabsf(float *__y, const float *__x, const int *__n);
+void vvfabsf_(float *__y, const float *__x, const int *__n);
+void vvfloor(double *__y, const double *__x, const int *__n);
+void vvfloor_(double *__y, const double *__x, const int *__n);
+void vvfloorf(float *__y, const float *__x, const int *__n);
+void vvfloorf_(float *__y, const float *__x, const int *__n);
+void vvfmod(double *__z, const double *__y, const double *__x, const int *__n);
+void vvfmod_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvfmodf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvfmodf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvint(double *__y, const double *__x, const int *__n);
+void vvint_(double *__y, const double *__x, const int *__n);
+void vvintf(float *__y, const float *__x, const int *__n);
+void vvintf_(float *__y, const float *__x, const int *__n);
+void vvlog(double *__y, const double *__x, const int *__n);
+void vvlog10(double *__y, const double *__x, const int *__n);
+void vvlog10_(double *__y, const double *__x, const int *__n);
+void vvlog10f(float *__y, const float *__x, const int *__n);
+void vvlog10f_(float *__y, const float *__x, const int *__n);
+void vvlog1p(double *__y, const double *__x, const int *__n);
+void vvlog1p_(double *__y, const double *__x, const int *__n);
+void vvlog1pf(float *__y, const float *__x, const int *__n);
+void vvlog1pf_(float *__y, const float *__x, const int *__n);
+void vvlog2(double *__y, const double *__x, const int *__n);
+void vvlog2_(double *__y, const double *__x, const int *__n);
+void vvlog2f(float *__y, const float *__x, const int *__n);
+void vvlog2f_(float *__y, const float *__x, const int *__n);
+void vvlog_(double *__y, const double *__x, const int *__n);
+void vvlogb(double *__y, const double *__x, const int *__n);
+void vvlogb_(double *__y, const double *__x, const int *__n);
+void vvlogbf(float *__y, const float *__x, const int *__n);
+void vvlogbf_(float *__y, const float *__x, const int *__n);
+void vvlogf(float *__y, const float *__x, const int *__n);
+void vvlogf_(float *__y, const float *__x, const int *__n);
+void vvnextafter(double *__z, const double *__y, const double *__x, const int *__n);
+void vvnextafter_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvnextafterf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvnextafterf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvnint(double *__y, const double *__x, const int *__n);
+void vvnint_(double *__y, const double *__x, const int *__n);
+void vvnintf(float *__y, const float *__x, const int *__n);
+void vvnintf_(float *__y, const float *__x, const int *__n);
+void vvpow(double *__z, const double *__y, const double *__x, const int *__n);
+void vvpow_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvpowf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvpowf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvpows(double *__z, const double *__y, const double *__x, const int *__n);
+void vvpows_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvpowsf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvpowsf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvrec(double *__y, const double *__x, const int *__n);
+void vvrec_(double *__y, const double *__x, const int *__n);
+void vvrecf(float *__y, const float *__x, const int *__n);
+void vvrecf_(float *__y, const float *__x, const int *__n);
+void vvremainder(double *__z, const double *__y, const double *__x, const int *__n);
+void vvremainder_(double *__z, const double *__y, const double *__x, const int *__n);
+void vvremainderf(float *__z, const float *__y, const float *__x, const int *__n);
+void vvremainderf_(float *__z, const float *__y, const float *__x, const int *__n);
+void vvrsqrt(double *__y, const double *__x, const int *__n);
+void vvrsqrt_(double *__y, const double *__x, const int *__n);
+void vvrsqrtf(float *__y, const float *__x, const int *__n);
+void vvrsqrtf_(float *__y, const float *__x, const int *__n);
+void vvsin(double *__y, const double *__x, const int *__n);
+void vvsin_(double *__y, const double *__x, const int *__n);
+void vvsincos(double *__z, double *__y, const double *__x, const int *__n);
+void vvsincos_(double *__z, double *__y, const double *__x, const int *__n);
+void vvsincosf(float *__z, float *__y, const float *__x, const int *__n);
+void vvsincosf_(float *__z, float *__y, const float *__x, const int *__n);
+void vvsinf(float *__y, const float *__x, const int *__n);
+void vvsinf_(float *__y, const float *__x, const int *__n);
+void vvsinh(double *__y, const double *__x, const int *__n);
+void vvsinh_(double *__y, const double *__x, const int *__n);
+void vvsinhf(float *__y, const float *__x, const int *__n);
+void vvsinhf_(float *__y, const float *__x, const int *__n);
+void vvsinpi(double *__y, const double *__x, const int *__n);
+void vvsinpi_(double *__y, const double *__x, const int *__n);
+void vvsinpif(float *__y, const float *__x, const int *__n);
+void vvsinpif_(float *__y, const float *__x, const int *__n);
+void vvsqrt(double *__y, const double *__x, const int *__n);
+void vvsqrt_(double *__y, const double *__x, const int *__n);
+void vvsqrtf(float *__y, const float *__x, const int *__n);
+void vvsqrtf_(float *__y, const float *__x, const int *__n);
+void vvtan(double *__y, const double *__x, const int *__n);
+void vvtan_(double *__y, const double *__x, const int *__n);
+void vvtanf(float *__y, const float *__x, const int *__n);
+void vvtanf_(float *__y, const float *__x, const int *__n);
+void vvtanh(double *__y, const double *__x, const int *__n);
+void vvtanh_(double *__y, const double *__x, const int *__n);
+void vvtanhf(float *__y, const float *__x, const int *__n);
+void vvtanhf_(float *__y, const float *__x, const int *__n);
+void vvtanpi(double *__y, const double *__x, const int *__n);
+void vvtanpi_(double *__y, const double *__x, const int *__n);
+void vvtanpif(float *__y, const float *__x, const int *__n);
+void vvtanpif_(float *__y, const float *__x, const int *__n);
 
 #endif
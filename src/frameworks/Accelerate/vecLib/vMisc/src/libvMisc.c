@@ -29,1025 +29,1365 @@ static void initme(void) {
     verbose = getenv("STUB_VERBOSE") != NULL;
 }
 
+/*
 void* VVACOS(void)
 {
     if (verbose) puts("STUB: VVACOS called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSF(void)
 {
     if (verbose) puts("STUB: VVACOSF called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSF_(void)
 {
     if (verbose) puts("STUB: VVACOSF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSH(void)
 {
     if (verbose) puts("STUB: VVACOSH called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSHF(void)
 {
     if (verbose) puts("STUB: VVACOSHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSHF_(void)
 {
     if (verbose) puts("STUB: VVACOSHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOSH_(void)
 {
     if (verbose) puts("STUB: VVACOSH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVACOS_(void)
 {
     if (verbose) puts("STUB: VVACOS_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVASIN(void)
 {
     if (verbose) puts("STUB: VVASIN called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINF(void)
 {
     if (verbose) puts("STUB: VVASINF called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINF_(void)
 {
     if (verbose) puts("STUB: VVASINF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINH(void)
 {
     if (verbose) puts("STUB: VVASINH called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINHF(void)
 {
     if (verbose) puts("STUB: VVASINHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINHF_(void)
 {
     if (verbose) puts("STUB: VVASINHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVASINH_(void)
 {
     if (verbose) puts("STUB: VVASINH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVASIN_(void)
 {
     if (verbose) puts("STUB: VVASIN_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN(void)
 {
     if (verbose) puts("STUB: VVATAN called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN2(void)
 {
     if (verbose) puts("STUB: VVATAN2 called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN2F(void)
 {
     if (verbose) puts("STUB: VVATAN2F called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN2F_(void)
 {
     if (verbose) puts("STUB: VVATAN2F_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN2_(void)
 {
     if (verbose) puts("STUB: VVATAN2_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANF(void)
 {
     if (verbose) puts("STUB: VVATANF called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANF_(void)
 {
     if (verbose) puts("STUB: VVATANF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANH(void)
 {
     if (verbose) puts("STUB: VVATANH called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANHF(void)
 {
     if (verbose) puts("STUB: VVATANHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANHF_(void)
 {
     if (verbose) puts("STUB: VVATANHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATANH_(void)
 {
     if (verbose) puts("STUB: VVATANH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVATAN_(void)
 {
     if (verbose) puts("STUB: VVATAN_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCBRT(void)
 {
     if (verbose) puts("STUB: VVCBRT called");
     return NULL;
 }
+*/
 
+/*
 void* VVCBRTF(void)
 {
     if (verbose) puts("STUB: VVCBRTF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCBRTF_(void)
 {
     if (verbose) puts("STUB: VVCBRTF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCBRT_(void)
 {
     if (verbose) puts("STUB: VVCBRT_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCEIL(void)
 {
     if (verbose) puts("STUB: VVCEIL called");
     return NULL;
 }
+*/
 
+/*
 void* VVCEILF(void)
 {
     if (verbose) puts("STUB: VVCEILF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCEILF_(void)
 {
     if (verbose) puts("STUB: VVCEILF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCEIL_(void)
 {
     if (verbose) puts("STUB: VVCEIL_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOPYSIGN(void)
 {
     if (verbose) puts("STUB: VVCOPYSIGN called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOPYSIGNF(void)
 {
     if (verbose) puts("STUB: VVCOPYSIGNF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOPYSIGNF_(void)
 {
     if (verbose) puts("STUB: VVCOPYSIGNF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOPYSIGN_(void)
 {
     if (verbose) puts("STUB: VVCOPYSIGN_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOS(void)
 {
     if (verbose) puts("STUB: VVCOS called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSF(void)
 {
     if (verbose) puts("STUB: VVCOSF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSF_(void)
 {
     if (verbose) puts("STUB: VVCOSF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSH(void)
 {
     if (verbose) puts("STUB: VVCOSH called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSHF(void)
 {
     if (verbose) puts("STUB: VVCOSHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSHF_(void)
 {
     if (verbose) puts("STUB: VVCOSHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSH_(void)
 {
     if (verbose) puts("STUB: VVCOSH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSISIN(void)
 {
     if (verbose) puts("STUB: VVCOSISIN called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSISINF(void)
 {
     if (verbose) puts("STUB: VVCOSISINF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSISINF_(void)
 {
     if (verbose) puts("STUB: VVCOSISINF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSISIN_(void)
 {
     if (verbose) puts("STUB: VVCOSISIN_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSPI(void)
 {
     if (verbose) puts("STUB: VVCOSPI called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSPIF(void)
 {
     if (verbose) puts("STUB: VVCOSPIF called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSPIF_(void)
 {
     if (verbose) puts("STUB: VVCOSPIF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOSPI_(void)
 {
     if (verbose) puts("STUB: VVCOSPI_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVCOS_(void)
 {
     if (verbose) puts("STUB: VVCOS_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVDIV(void)
 {
     if (verbose) puts("STUB: VVDIV called");
     return NULL;
 }
+*/
 
+/*
 void* VVDIVF(void)
 {
     if (verbose) puts("STUB: VVDIVF called");
     return NULL;
 }
+*/
 
+/*
 void* VVDIVF_(void)
 {
     if (verbose) puts("STUB: VVDIVF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVDIV_(void)
 {
     if (verbose) puts("STUB: VVDIV_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP(void)
 {
     if (verbose) puts("STUB: VVEXP called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP2(void)
 {
     if (verbose) puts("STUB: VVEXP2 called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP2F(void)
 {
     if (verbose) puts("STUB: VVEXP2F called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP2F_(void)
 {
     if (verbose) puts("STUB: VVEXP2F_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP2_(void)
 {
     if (verbose) puts("STUB: VVEXP2_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPF(void)
 {
     if (verbose) puts("STUB: VVEXPF called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPF_(void)
 {
     if (verbose) puts("STUB: VVEXPF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPM1(void)
 {
     if (verbose) puts("STUB: VVEXPM1 called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPM1F(void)
 {
     if (verbose) puts("STUB: VVEXPM1F called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPM1F_(void)
 {
     if (verbose) puts("STUB: VVEXPM1F_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXPM1_(void)
 {
     if (verbose) puts("STUB: VVEXPM1_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVEXP_(void)
 {
     if (verbose) puts("STUB: VVEXP_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABF(void)
 {
     if (verbose) puts("STUB: VVFABF called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABF_(void)
 {
     if (verbose) puts("STUB: VVFABF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABS(void)
 {
     if (verbose) puts("STUB: VVFABS called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABSF(void)
 {
     if (verbose) puts("STUB: VVFABSF called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABSF_(void)
 {
     if (verbose) puts("STUB: VVFABSF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFABS_(void)
 {
     if (verbose) puts("STUB: VVFABS_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFLOOR(void)
 {
     if (verbose) puts("STUB: VVFLOOR called");
     return NULL;
 }
+*/
 
+/*
 void* VVFLOORF(void)
 {
     if (verbose) puts("STUB: VVFLOORF called");
     return NULL;
 }
+*/
 
+/*
 void* VVFLOORF_(void)
 {
     if (verbose) puts("STUB: VVFLOORF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFLOOR_(void)
 {
     if (verbose) puts("STUB: VVFLOOR_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFMOD(void)
 {
     if (verbose) puts("STUB: VVFMOD called");
     return NULL;
 }
+*/
 
+/*
 void* VVFMODF(void)
 {
     if (verbose) puts("STUB: VVFMODF called");
     return NULL;
 }
+*/
 
+/*
 void* VVFMODF_(void)
 {
     if (verbose) puts("STUB: VVFMODF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVFMOD_(void)
 {
     if (verbose) puts("STUB: VVFMOD_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVINT(void)
 {
     if (verbose) puts("STUB: VVINT called");
     return NULL;
 }
+*/
 
+/*
 void* VVINTF(void)
 {
     if (verbose) puts("STUB: VVINTF called");
     return NULL;
 }
+*/
 
+/*
 void* VVINTF_(void)
 {
     if (verbose) puts("STUB: VVINTF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVINT_(void)
 {
     if (verbose) puts("STUB: VVINT_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG(void)
 {
     if (verbose) puts("STUB: VVLOG called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG10(void)
 {
     if (verbose) puts("STUB: VVLOG10 called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG10F(void)
 {
     if (verbose) puts("STUB: VVLOG10F called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG10F_(void)
 {
     if (verbose) puts("STUB: VVLOG10F_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG10_(void)
 {
     if (verbose) puts("STUB: VVLOG10_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG1P(void)
 {
     if (verbose) puts("STUB: VVLOG1P called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG1PF(void)
 {
     if (verbose) puts("STUB: VVLOG1PF called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG1PF_(void)
 {
     if (verbose) puts("STUB: VVLOG1PF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG1P_(void)
 {
     if (verbose) puts("STUB: VVLOG1P_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG2(void)
 {
     if (verbose) puts("STUB: VVLOG2 called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG2F(void)
 {
     if (verbose) puts("STUB: VVLOG2F called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG2F_(void)
 {
     if (verbose) puts("STUB: VVLOG2F_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG2_(void)
 {
     if (verbose) puts("STUB: VVLOG2_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGB(void)
 {
     if (verbose) puts("STUB: VVLOGB called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGBF(void)
 {
     if (verbose) puts("STUB: VVLOGBF called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGBF_(void)
 {
     if (verbose) puts("STUB: VVLOGBF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGB_(void)
 {
     if (verbose) puts("STUB: VVLOGB_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGF(void)
 {
     if (verbose) puts("STUB: VVLOGF called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOGF_(void)
 {
     if (verbose) puts("STUB: VVLOGF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVLOG_(void)
 {
     if (verbose) puts("STUB: VVLOG_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVNEXTAFTER(void)
 {
     if (verbose) puts("STUB: VVNEXTAFTER called");
     return NULL;
 }
+*/
 
+/*
 void* VVNEXTAFTERF(void)
 {
     if (verbose) puts("STUB: VVNEXTAFTERF called");
     return NULL;
 }
+*/
 
+/*
 void* VVNEXTAFTERF_(void)
 {
     if (verbose) puts("STUB: VVNEXTAFTERF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVNEXTAFTER_(void)
 {
     if (verbose) puts("STUB: VVNEXTAFTER_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVNINT(void)
 {
     if (verbose) puts("STUB: VVNINT called");
     return NULL;
 }
+*/
 
+/*
 void* VVNINTF(void)
 {
     if (verbose) puts("STUB: VVNINTF called");
     return NULL;
 }
+*/
 
+/*
 void* VVNINTF_(void)
 {
     if (verbose) puts("STUB: VVNINTF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVNINT_(void)
 {
     if (verbose) puts("STUB: VVNINT_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOW(void)
 {
     if (verbose) puts("STUB: VVPOW called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWF(void)
 {
     if (verbose) puts("STUB: VVPOWF called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWF_(void)
 {
     if (verbose) puts("STUB: VVPOWF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWS(void)
 {
     if (verbose) puts("STUB: VVPOWS called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWSF(void)
 {
     if (verbose) puts("STUB: VVPOWSF called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWSF_(void)
 {
     if (verbose) puts("STUB: VVPOWSF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOWS_(void)
 {
     if (verbose) puts("STUB: VVPOWS_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVPOW_(void)
 {
     if (verbose) puts("STUB: VVPOW_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVREC(void)
 {
     if (verbose) puts("STUB: VVREC called");
     return NULL;
 }
+*/
 
+/*
 void* VVRECF(void)
 {
     if (verbose) puts("STUB: VVRECF called");
     return NULL;
 }
+*/
 
+/*
 void* VVRECF_(void)
 {
     if (verbose) puts("STUB: VVRECF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVREC_(void)
 {
     if (verbose) puts("STUB: VVREC_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVREMAINDER(void)
 {
     if (verbose) puts("STUB: VVREMAINDER called");
     return NULL;
 }
+*/
 
+/*
 void* VVREMAINDERF(void)
 {
     if (verbose) puts("STUB: VVREMAINDERF called");
     return NULL;
 }
+*/
 
+/*
 void* VVREMAINDERF_(void)
 {
     if (verbose) puts("STUB: VVREMAINDERF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVREMAINDER_(void)
 {
     if (verbose) puts("STUB: VVREMAINDER_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVRSQRT(void)
 {
     if (verbose) puts("STUB: VVRSQRT called");
     return NULL;
 }
+*/
 
+/*
 void* VVRSQRTF(void)
 {
     if (verbose) puts("STUB: VVRSQRTF called");
     return NULL;
 }
+*/
 
+/*
 void* VVRSQRTF_(void)
 {
     if (verbose) puts("STUB: VVRSQRTF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVRSQRT_(void)
 {
     if (verbose) puts("STUB: VVRSQRT_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSIN(void)
 {
     if (verbose) puts("STUB: VVSIN called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINCOS(void)
 {
     if (verbose) puts("STUB: VVSINCOS called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINCOSF(void)
 {
     if (verbose) puts("STUB: VVSINCOSF called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINCOSF_(void)
 {
     if (verbose) puts("STUB: VVSINCOSF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINCOS_(void)
 {
     if (verbose) puts("STUB: VVSINCOS_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINF(void)
 {
     if (verbose) puts("STUB: VVSINF called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINF_(void)
 {
     if (verbose) puts("STUB: VVSINF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINH(void)
 {
     if (verbose) puts("STUB: VVSINH called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINHF(void)
 {
     if (verbose) puts("STUB: VVSINHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINHF_(void)
 {
     if (verbose) puts("STUB: VVSINHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINH_(void)
 {
     if (verbose) puts("STUB: VVSINH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINPI(void)
 {
     if (verbose) puts("STUB: VVSINPI called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINPIF(void)
 {
     if (verbose) puts("STUB: VVSINPIF called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINPIF_(void)
 {
     if (verbose) puts("STUB: VVSINPIF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSINPI_(void)
 {
     if (verbose) puts("STUB: VVSINPI_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSIN_(void)
 {
     if (verbose) puts("STUB: VVSIN_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSQRT(void)
 {
     if (verbose) puts("STUB: VVSQRT called");
     return NULL;
 }
+*/
 
+/*
 void* VVSQRTF(void)
 {
     if (verbose) puts("STUB: VVSQRTF called");
     return NULL;
 }
+*/
 
+/*
 void* VVSQRTF_(void)
 {
     if (verbose) puts("STUB: VVSQRTF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVSQRT_(void)
 {
     if (verbose) puts("STUB: VVSQRT_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTAN(void)
 {
     if (verbose) puts("STUB: VVTAN called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANF(void)
 {
     if (verbose) puts("STUB: VVTANF called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANF_(void)
 {
     if (verbose) puts("STUB: VVTANF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANH(void)
 {
     if (verbose) puts("STUB: VVTANH called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANHF(void)
 {
     if (verbose) puts("STUB: VVTANHF called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANHF_(void)
 {
     if (verbose) puts("STUB: VVTANHF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANH_(void)
 {
     if (verbose) puts("STUB: VVTANH_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANPI(void)
 {
     if (verbose) puts("STUB: VVTANPI called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANPIF(void)
 {
     if (verbose) puts("STUB: VVTANPIF called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANPIF_(void)
 {
     if (verbose) puts("STUB: VVTANPIF_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTANPI_(void)
 {
     if (verbose) puts("STUB: VVTANPI_ called");
     return NULL;
 }
+*/
 
+/*
 void* VVTAN_(void)
 {
     if (verbose) puts("STUB: VVTAN_ called");
     return NULL;
 }
+*/
 
 void* __cblas_isamax(void)
 {
@@ -2561,1022 +2901,1362 @@ void* vtruncf(void)
     return NULL;
 }
 
+/*
 void* vvacos(void)
 {
     if (verbose) puts("STUB: vvacos called");
     return NULL;
 }
+*/
 
+/*
 void* vvacos_(void)
 {
     if (verbose) puts("STUB: vvacos_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvacosf(void)
 {
     if (verbose) puts("STUB: vvacosf called");
     return NULL;
 }
+*/
 
+/*
 void* vvacosf_(void)
 {
     if (verbose) puts("STUB: vvacosf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvacosh(void)
 {
     if (verbose) puts("STUB: vvacosh called");
     return NULL;
 }
+*/
 
+/*
 void* vvacosh_(void)
 {
     if (verbose) puts("STUB: vvacosh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvacoshf(void)
 {
     if (verbose) puts("STUB: vvacoshf called");
     return NULL;
 }
+*/
 
+/*
 void* vvacoshf_(void)
 {
     if (verbose) puts("STUB: vvacoshf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvasin(void)
 {
     if (verbose) puts("STUB: vvasin called");
     return NULL;
 }
+*/
 
+/*
 void* vvasin_(void)
 {
     if (verbose) puts("STUB: vvasin_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinf(void)
 {
     if (verbose) puts("STUB: vvasinf called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinf_(void)
 {
     if (verbose) puts("STUB: vvasinf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinh(void)
 {
     if (verbose) puts("STUB: vvasinh called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinh_(void)
 {
     if (verbose) puts("STUB: vvasinh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinhf(void)
 {
     if (verbose) puts("STUB: vvasinhf called");
     return NULL;
 }
+*/
 
+/*
 void* vvasinhf_(void)
 {
     if (verbose) puts("STUB: vvasinhf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan(void)
 {
     if (verbose) puts("STUB: vvatan called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan2(void)
 {
     if (verbose) puts("STUB: vvatan2 called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan2_(void)
 {
     if (verbose) puts("STUB: vvatan2_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan2f(void)
 {
     if (verbose) puts("STUB: vvatan2f called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan2f_(void)
 {
     if (verbose) puts("STUB: vvatan2f_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatan_(void)
 {
     if (verbose) puts("STUB: vvatan_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanf(void)
 {
     if (verbose) puts("STUB: vvatanf called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanf_(void)
 {
     if (verbose) puts("STUB: vvatanf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanh(void)
 {
     if (verbose) puts("STUB: vvatanh called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanh_(void)
 {
     if (verbose) puts("STUB: vvatanh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanhf(void)
 {
     if (verbose) puts("STUB: vvatanhf called");
     return NULL;
 }
+*/
 
+/*
 void* vvatanhf_(void)
 {
     if (verbose) puts("STUB: vvatanhf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcbrt(void)
 {
     if (verbose) puts("STUB: vvcbrt called");
     return NULL;
 }
+*/
 
+/*
 void* vvcbrt_(void)
 {
     if (verbose) puts("STUB: vvcbrt_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcbrtf(void)
 {
     if (verbose) puts("STUB: vvcbrtf called");
     return NULL;
 }
+*/
 
+/*
 void* vvcbrtf_(void)
 {
     if (verbose) puts("STUB: vvcbrtf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvceil(void)
 {
     if (verbose) puts("STUB: vvceil called");
     return NULL;
 }
+*/
 
+/*
 void* vvceil_(void)
 {
     if (verbose) puts("STUB: vvceil_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvceilf(void)
 {
     if (verbose) puts("STUB: vvceilf called");
     return NULL;
 }
+*/
 
+/*
 void* vvceilf_(void)
 {
     if (verbose) puts("STUB: vvceilf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcopysign(void)
 {
     if (verbose) puts("STUB: vvcopysign called");
     return NULL;
 }
+*/
 
+/*
 void* vvcopysign_(void)
 {
     if (verbose) puts("STUB: vvcopysign_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcopysignf(void)
 {
     if (verbose) puts("STUB: vvcopysignf called");
     return NULL;
 }
+*/
 
+/*
 void* vvcopysignf_(void)
 {
     if (verbose) puts("STUB: vvcopysignf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcos(void)
 {
     if (verbose) puts("STUB: vvcos called");
     return NULL;
 }
+*/
 
+/*
 void* vvcos_(void)
 {
     if (verbose) puts("STUB: vvcos_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosf(void)
 {
     if (verbose) puts("STUB: vvcosf called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosf_(void)
 {
     if (verbose) puts("STUB: vvcosf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosh(void)
 {
     if (verbose) puts("STUB: vvcosh called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosh_(void)
 {
     if (verbose) puts("STUB: vvcosh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcoshf(void)
 {
     if (verbose) puts("STUB: vvcoshf called");
     return NULL;
 }
+*/
 
+/*
 void* vvcoshf_(void)
 {
     if (verbose) puts("STUB: vvcoshf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosisin(void)
 {
     if (verbose) puts("STUB: vvcosisin called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosisin_(void)
 {
     if (verbose) puts("STUB: vvcosisin_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosisinf(void)
 {
     if (verbose) puts("STUB: vvcosisinf called");
     return NULL;
 }
+*/
 
+/*
 void* vvcosisinf_(void)
 {
     if (verbose) puts("STUB: vvcosisinf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcospi(void)
 {
     if (verbose) puts("STUB: vvcospi called");
     return NULL;
 }
+*/
 
+/*
 void* vvcospi_(void)
 {
     if (verbose) puts("STUB: vvcospi_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvcospif(void)
 {
     if (verbose) puts("STUB: vvcospif called");
     return NULL;
 }
+*/
 
+/*
 void* vvcospif_(void)
 {
     if (verbose) puts("STUB: vvcospif_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvdiv(void)
 {
     if (verbose) puts("STUB: vvdiv called");
     return NULL;
 }
+*/
 
+/*
 void* vvdiv_(void)
 {
     if (verbose) puts("STUB: vvdiv_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvdivf(void)
 {
     if (verbose) puts("STUB: vvdivf called");
     return NULL;
 }
+*/
 
+/*
 void* vvdivf_(void)
 {
     if (verbose) puts("STUB: vvdivf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp(void)
 {
     if (verbose) puts("STUB: vvexp called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp2(void)
 {
     if (verbose) puts("STUB: vvexp2 called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp2_(void)
 {
     if (verbose) puts("STUB: vvexp2_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp2f(void)
 {
     if (verbose) puts("STUB: vvexp2f called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp2f_(void)
 {
     if (verbose) puts("STUB: vvexp2f_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexp_(void)
 {
     if (verbose) puts("STUB: vvexp_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpf(void)
 {
     if (verbose) puts("STUB: vvexpf called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpf_(void)
 {
     if (verbose) puts("STUB: vvexpf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpm1(void)
 {
     if (verbose) puts("STUB: vvexpm1 called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpm1_(void)
 {
     if (verbose) puts("STUB: vvexpm1_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpm1f(void)
 {
     if (verbose) puts("STUB: vvexpm1f called");
     return NULL;
 }
+*/
 
+/*
 void* vvexpm1f_(void)
 {
     if (verbose) puts("STUB: vvexpm1f_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabf(void)
 {
     if (verbose) puts("STUB: vvfabf called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabf_(void)
 {
     if (verbose) puts("STUB: vvfabf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabs(void)
 {
     if (verbose) puts("STUB: vvfabs called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabs_(void)
 {
     if (verbose) puts("STUB: vvfabs_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabsf(void)
 {
     if (verbose) puts("STUB: vvfabsf called");
     return NULL;
 }
+*/
 
+/*
 void* vvfabsf_(void)
 {
     if (verbose) puts("STUB: vvfabsf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfloor(void)
 {
     if (verbose) puts("STUB: vvfloor called");
     return NULL;
 }
+*/
 
+/*
 void* vvfloor_(void)
 {
     if (verbose) puts("STUB: vvfloor_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfloorf(void)
 {
     if (verbose) puts("STUB: vvfloorf called");
     return NULL;
 }
+*/
 
+/*
 void* vvfloorf_(void)
 {
     if (verbose) puts("STUB: vvfloorf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfmod(void)
 {
     if (verbose) puts("STUB: vvfmod called");
     return NULL;
 }
+*/
 
+/*
 void* vvfmod_(void)
 {
     if (verbose) puts("STUB: vvfmod_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvfmodf(void)
 {
     if (verbose) puts("STUB: vvfmodf called");
     return NULL;
 }
+*/
 
+/*
 void* vvfmodf_(void)
 {
     if (verbose) puts("STUB: vvfmodf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvint(void)
 {
     if (verbose) puts("STUB: vvint called");
     return NULL;
 }
+*/
 
+/*
 void* vvint_(void)
 {
     if (verbose) puts("STUB: vvint_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvintf(void)
 {
     if (verbose) puts("STUB: vvintf called");
     return NULL;
 }
+*/
 
+/*
 void* vvintf_(void)
 {
     if (verbose) puts("STUB: vvintf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog(void)
 {
     if (verbose) puts("STUB: vvlog called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog10(void)
 {
     if (verbose) puts("STUB: vvlog10 called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog10_(void)
 {
     if (verbose) puts("STUB: vvlog10_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog10f(void)
 {
     if (verbose) puts("STUB: vvlog10f called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog10f_(void)
 {
     if (verbose) puts("STUB: vvlog10f_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog1p(void)
 {
     if (verbose) puts("STUB: vvlog1p called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog1p_(void)
 {
     if (verbose) puts("STUB: vvlog1p_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog1pf(void)
 {
     if (verbose) puts("STUB: vvlog1pf called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog1pf_(void)
 {
     if (verbose) puts("STUB: vvlog1pf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog2(void)
 {
     if (verbose) puts("STUB: vvlog2 called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog2_(void)
 {
     if (verbose) puts("STUB: vvlog2_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog2f(void)
 {
     if (verbose) puts("STUB: vvlog2f called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog2f_(void)
 {
     if (verbose) puts("STUB: vvlog2f_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlog_(void)
 {
     if (verbose) puts("STUB: vvlog_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogb(void)
 {
     if (verbose) puts("STUB: vvlogb called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogb_(void)
 {
     if (verbose) puts("STUB: vvlogb_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogbf(void)
 {
     if (verbose) puts("STUB: vvlogbf called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogbf_(void)
 {
     if (verbose) puts("STUB: vvlogbf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogf(void)
 {
     if (verbose) puts("STUB: vvlogf called");
     return NULL;
 }
+*/
 
+/*
 void* vvlogf_(void)
 {
     if (verbose) puts("STUB: vvlogf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvnextafter(void)
 {
     if (verbose) puts("STUB: vvnextafter called");
     return NULL;
 }
+*/
 
+/*
 void* vvnextafter_(void)
 {
     if (verbose) puts("STUB: vvnextafter_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvnextafterf(void)
 {
     if (verbose) puts("STUB: vvnextafterf called");
     return NULL;
 }
+*/
 
+/*
 void* vvnextafterf_(void)
 {
     if (verbose) puts("STUB: vvnextafterf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvnint(void)
 {
     if (verbose) puts("STUB: vvnint called");
     return NULL;
 }
+*/
 
+/*
 void* vvnint_(void)
 {
     if (verbose) puts("STUB: vvnint_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvnintf(void)
 {
     if (verbose) puts("STUB: vvnintf called");
     return NULL;
 }
+*/
 
+/*
 void* vvnintf_(void)
 {
     if (verbose) puts("STUB: vvnintf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvpow(void)
 {
     if (verbose) puts("STUB: vvpow called");
     return NULL;
 }
+*/
 
+/*
 void* vvpow_(void)
 {
     if (verbose) puts("STUB: vvpow_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvpowf(void)
 {
     if (verbose) puts("STUB: vvpowf called");
     return NULL;
 }
+*/
 
+/*
 void* vvpowf_(void)
 {
     if (verbose) puts("STUB: vvpowf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvpows(void)
 {
     if (verbose) puts("STUB: vvpows called");
     return NULL;
 }
+*/
 
+/*
 void* vvpows_(void)
 {
     if (verbose) puts("STUB: vvpows_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvpowsf(void)
 {
     if (verbose) puts("STUB: vvpowsf called");
     return NULL;
 }
+*/
 
+/*
 void* vvpowsf_(void)
 {
     if (verbose) puts("STUB: vvpowsf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvrec(void)
 {
     if (verbose) puts("STUB: vvrec called");
     return NULL;
 }
+*/
 
+/*
 void* vvrec_(void)
 {
     if (verbose) puts("STUB: vvrec_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvrecf(void)
 {
     if (verbose) puts("STUB: vvrecf called");
     return NULL;
 }
+*/
 
+/*
 void* vvrecf_(void)
 {
     if (verbose) puts("STUB: vvrecf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvremainder(void)
 {
     if (verbose) puts("STUB: vvremainder called");
     return NULL;
 }
+*/
 
+/*
 void* vvremainder_(void)
 {
     if (verbose) puts("STUB: vvremainder_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvremainderf(void)
 {
     if (verbose) puts("STUB: vvremainderf called");
     return NULL;
 }
+*/
 
+/*
 void* vvremainderf_(void)
 {
     if (verbose) puts("STUB: vvremainderf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvrsqrt(void)
 {
     if (verbose) puts("STUB: vvrsqrt called");
     return NULL;
 }
+*/
 
+/*
 void* vvrsqrt_(void)
 {
     if (verbose) puts("STUB: vvrsqrt_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvrsqrtf(void)
 {
     if (verbose) puts("STUB: vvrsqrtf called");
     return NULL;
 }
+*/
 
+/*
 void* vvrsqrtf_(void)
 {
     if (verbose) puts("STUB: vvrsqrtf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsin(void)
 {
     if (verbose) puts("STUB: vvsin called");
     return NULL;
 }
+*/
 
+/*
 void* vvsin_(void)
 {
     if (verbose) puts("STUB: vvsin_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsincos(void)
 {
     if (verbose) puts("STUB: vvsincos called");
     return NULL;
 }
+*/
 
+/*
 void* vvsincos_(void)
 {
     if (verbose) puts("STUB: vvsincos_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsincosf(void)
 {
     if (verbose) puts("STUB: vvsincosf called");
     return NULL;
 }
+*/
 
+/*
 void* vvsincosf_(void)
 {
     if (verbose) puts("STUB: vvsincosf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinf(void)
 {
     if (verbose) puts("STUB: vvsinf called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinf_(void)
 {
     if (verbose) puts("STUB: vvsinf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinh(void)
 {
     if (verbose) puts("STUB: vvsinh called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinh_(void)
 {
     if (verbose) puts("STUB: vvsinh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinhf(void)
 {
     if (verbose) puts("STUB: vvsinhf called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinhf_(void)
 {
     if (verbose) puts("STUB: vvsinhf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinpi(void)
 {
     if (verbose) puts("STUB: vvsinpi called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinpi_(void)
 {
     if (verbose) puts("STUB: vvsinpi_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinpif(void)
 {
     if (verbose) puts("STUB: vvsinpif called");
     return NULL;
 }
+*/
 
+/*
 void* vvsinpif_(void)
 {
     if (verbose) puts("STUB: vvsinpif_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsqrt(void)
 {
     if (verbose) puts("STUB: vvsqrt called");
     return NULL;
 }
+*/
 
+/*
 void* vvsqrt_(void)
 {
     if (verbose) puts("STUB: vvsqrt_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvsqrtf(void)
 {
     if (verbose) puts("STUB: vvsqrtf called");
     return NULL;
 }
+*/
 
+/*
 void* vvsqrtf_(void)
 {
     if (verbose) puts("STUB: vvsqrtf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtan(void)
 {
     if (verbose) puts("STUB: vvtan called");
     return NULL;
 }
+*/
 
+/*
 void* vvtan_(void)
 {
     if (verbose) puts("STUB: vvtan_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanf(void)
 {
     if (verbose) puts("STUB: vvtanf called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanf_(void)
 {
     if (verbose) puts("STUB: vvtanf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanh(void)
 {
     if (verbose) puts("STUB: vvtanh called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanh_(void)
 {
     if (verbose) puts("STUB: vvtanh_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanhf(void)
 {
     if (verbose) puts("STUB: vvtanhf called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanhf_(void)
 {
     if (verbose) puts("STUB: vvtanhf_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanpi(void)
 {
     if (verbose) puts("STUB: vvtanpi called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanpi_(void)
 {
     if (verbose) puts("STUB: vvtanpi_ called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanpif(void)
 {
     if (verbose) puts("STUB: vvtanpif called");
     return NULL;
 }
+*/
 
+/*
 void* vvtanpif_(void)
 {
     if (verbose) puts("STUB: vvtanpif_ called");
     return NULL;
 }
+*/
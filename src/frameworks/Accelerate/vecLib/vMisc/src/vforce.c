@@ -0,0 +1,499 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libvMisc/libvMisc.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define VFORCE_HAVE_FMA 1
+#endif
+
+static bool vforce_have_fma = false;
+
+__attribute__((constructor))
+static void vforce_detect_cpu(void)
+{
+#ifdef VFORCE_HAVE_FMA
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return;
+
+	// the OS has to save the YMM registers too
+	if (!(ecx & bit_OSXSAVE) || !(ecx & bit_FMA))
+		return;
+
+	unsigned int xcr0_lo, xcr0_hi;
+	__asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+	if ((xcr0_lo & 6) != 6)
+		return;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return;
+
+	vforce_have_fma = (ebx & bit_AVX2) != 0;
+#endif
+}
+
+// Cody-Waite splits of ln(2), with ln2_hi*k exact for |k| < 2^21
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+#define LOG2E 0x1.71547652b82fep+0
+
+// 1/n!
+#define EXP_C3 0x1.5555555555555p-3
+#define EXP_C4 0x1.5555555555555p-5
+#define EXP_C5 0x1.1111111111111p-7
+#define EXP_C6 0x1.6c16c16c16c17p-10
+#define EXP_C7 0x1.a01a01a01a01ap-13
+#define EXP_C8 0x1.a01a01a01a01ap-16
+#define EXP_C9 0x1.71de3a556c734p-19
+#define EXP_C10 0x1.27e4fb7789f5cp-22
+#define EXP_C11 0x1.ae64567f544e4p-26
+#define EXP_C12 0x1.1eed8eff8d898p-29
+#define EXP_C13 0x1.6124613a86d09p-33
+
+// ln(2)^n/n!
+#define EXP2_C1 0x1.62e42fefa39efp-1
+#define EXP2_C2 0x1.ebfbdff82c58fp-3
+#define EXP2_C3 0x1.c6b08d704a0c0p-5
+#define EXP2_C4 0x1.3b2ab6fba4e77p-7
+#define EXP2_C5 0x1.5d87fe78a6731p-10
+#define EXP2_C6 0x1.430912f86c787p-13
+#define EXP2_C7 0x1.ffcbfc588b0c7p-17
+#define EXP2_C8 0x1.62c0223a5c824p-20
+#define EXP2_C9 0x1.b5253d395e7c4p-24
+#define EXP2_C10 0x1.e4cf5158b8ecap-28
+#define EXP2_C11 0x1.e8cac7351bb25p-32
+#define EXP2_C12 0x1.c3bd650fc2986p-36
+#define EXP2_C13 0x1.816193166d0f9p-40
+
+// fdlibm's log, log2 and log10
+#define LG1 6.666666666666735130e-01
+#define LG2 3.999999999940941908e-01
+#define LG3 2.857142874366239149e-01
+#define LG4 2.222219843214978396e-01
+#define LG5 1.818357216161805012e-01
+#define LG6 1.531383769920937332e-01
+#define LG7 1.479819860511658591e-01
+#define IVLN2_HI 1.44269504072144627571e+00
+#define IVLN2_LO 1.67517131648865118353e-10
+#define IVLN10_HI 4.34294481878168880939e-01
+#define IVLN10_LO 2.50829467116452752298e-11
+#define LOG10_2_HI 3.01029995663611771306e-01
+#define LOG10_2_LO 3.69423907715893078616e-13
+
+// fdlibm's sin, cos, tan and their argument reduction
+#define S1 -1.66666666666666324348e-01
+#define S2 8.33333333332248946124e-03
+#define S3 -1.98412698298579493134e-04
+#define S4 2.75573137070700676789e-06
+#define S5 -2.50507602534068634195e-08
+#define S6 1.58969099521155010221e-10
+#define C1 4.16666666666666019037e-02
+#define C2 -1.38888888888741095749e-03
+#define C3 2.48015872894767294178e-05
+#define C4 -2.75573143513906633035e-07
+#define C5 2.08757232129817482790e-09
+#define C6 -1.13596475577881948265e-11
+#define T0 3.33333333333334091986e-01
+#define T1 1.33333333333201242699e-01
+#define T2 5.39682539762260521377e-02
+#define T3 2.18694882948595424599e-02
+#define T4 8.86323982359930005737e-03
+#define T5 3.59207910759131235356e-03
+#define T6 1.45620945432529025516e-03
+#define T7 5.88041240820264096874e-04
+#define T8 2.46463134818469906812e-04
+#define T9 7.81794442939557092300e-05
+#define T10 7.14072491382608190305e-05
+#define T11 -1.85586374855275456654e-05
+#define T12 2.59073051863633712884e-05
+#define INVPIO2 6.36619772367581382433e-01
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624871116645580e-21
+#define PIO2_3T 8.47842766036889956997e-32
+#define PIO4 7.85398163397448278999e-01
+#define PIO4_LO 3.06161699786838301793e-17
+#define PIO2_HI 0x1.921fb54442d18p+0
+#define PIO2_LO 0x1.1a62633145c07p-54
+#define PI_HI 0x1.921fb54442d18p+1
+#define PI_LO 0x1.1a62633145c07p-53
+
+// Cephes' atan
+#define T3P8 2.41421356237309504880
+#define MOREBITS 6.123233995736765886130e-17
+#define ATAN_P0 -8.750608600031904122785e-01
+#define ATAN_P1 -1.615753718733365076637e+01
+#define ATAN_P2 -7.500855792314704667340e+01
+#define ATAN_P3 -1.228866684490136173410e+02
+#define ATAN_P4 -6.485021904942025371773e+01
+#define ATAN_Q0 2.485846490142306297962e+01
+#define ATAN_Q1 1.650270098316988542046e+02
+#define ATAN_Q2 4.328810604912902668951e+02
+#define ATAN_Q3 4.853903996359136964868e+02
+#define ATAN_Q4 1.945506571482613964425e+02
+
+// The log in pow splits [OFF, 2*OFF) into 128 subintervals by the leading mantissa bits.
+// Each has 1/c, rounded to 8 bits, for c near its middle, and log(c) = -log(1/c) in
+// double-double; the interval around 1 has c = 1. With k*ln2_hi exact for |k| < 2^11,
+// k*ln2_hi + log(c) is exact as well.
+#define POW_LOG_TABLE_BITS 7
+#define POW_LOG_OFF 0x3fe6955500000000LL
+#define POW_LN2_HI 0x1.62e42fefa3800p-1
+#define POW_LN2_LO 0x1.ef35793c76730p-45
+
+struct vforce_log_entry
+{
+	double invc, logc, logctail;
+};
+
+static const struct vforce_log_entry vforce_pow_log_table[1 << POW_LOG_TABLE_BITS] = {
+	{ 0x1.6a00000000000p+0, -0x1.62c82f2b9c795p-2, -0x1.7b7af915300e5p-57 },
+	{ 0x1.6800000000000p+0, -0x1.5d1bdbf5809cap-2, -0x1.4236383dc7fe1p-56 },
+	{ 0x1.6600000000000p+0, -0x1.5767717455a6cp-2, -0x1.526adb283660cp-56 },
+	{ 0x1.6400000000000p+0, -0x1.51aad872df82dp-2, -0x1.3927ac19f55e3p-59 },
+	{ 0x1.6200000000000p+0, -0x1.4be5f957778a1p-2, 0x1.259b35b04813dp-57 },
+	{ 0x1.6000000000000p+0, -0x1.4618bc21c5ec2p-2, -0x1.f42decdeccf1dp-56 },
+	{ 0x1.5e00000000000p+0, -0x1.404308686a7e4p-2, 0x1.0bcfb6082ce6dp-56 },
+	{ 0x1.5c00000000000p+0, -0x1.3a64c556945eap-2, 0x1.c68651945f97cp-57 },
+	{ 0x1.5a00000000000p+0, -0x1.347dd9a987d55p-2, 0x1.4dd4c580919f8p-57 },
+	{ 0x1.5800000000000p+0, -0x1.2e8e2bae11d31p-2, 0x1.8f4cdb95ebdf9p-56 },
+	{ 0x1.5600000000000p+0, -0x1.2895a13de86a3p-2, -0x1.7ad24c13f040ep-56 },
+	{ 0x1.5600000000000p+0, -0x1.2895a13de86a3p-2, -0x1.7ad24c13f040ep-56 },
+	{ 0x1.5400000000000p+0, -0x1.22941fbcf7966p-2, 0x1.76f5eb09628afp-56 },
+	{ 0x1.5200000000000p+0, -0x1.1c898c16999fbp-2, 0x1.0e5c62aff1c44p-60 },
+	{ 0x1.5000000000000p+0, -0x1.1675cababa60ep-2, -0x1.ce63eab883717p-61 },
+	{ 0x1.4e00000000000p+0, -0x1.1058bf9ae4ad5p-2, -0x1.89fa0ab4cb31dp-58 },
+	{ 0x1.4c00000000000p+0, -0x1.0a324e27390e3p-2, -0x1.7dcfde8061c03p-56 },
+	{ 0x1.4a00000000000p+0, -0x1.0402594b4d041p-2, 0x1.28ec217a5022dp-57 },
+	{ 0x1.4a00000000000p+0, -0x1.0402594b4d041p-2, 0x1.28ec217a5022dp-57 },
+	{ 0x1.4800000000000p+0, -0x1.fb9186d5e3e2bp-3, 0x1.caaae64f21acbp-57 },
+	{ 0x1.4600000000000p+0, -0x1.ef0adcbdc5936p-3, -0x1.48637950dc20dp-57 },
+	{ 0x1.4400000000000p+0, -0x1.e27076e2af2e6p-3, 0x1.61578001e0162p-59 },
+	{ 0x1.4200000000000p+0, -0x1.d5c216b4fbb91p-3, -0x1.6e443597e4d40p-57 },
+	{ 0x1.4000000000000p+0, -0x1.c8ff7c79a9a22p-3, 0x1.4f689f8434012p-57 },
+	{ 0x1.4000000000000p+0, -0x1.c8ff7c79a9a22p-3, 0x1.4f689f8434012p-57 },
+	{ 0x1.3e00000000000p+0, -0x1.bc286742d8cd6p-3, -0x1.4fce744870f55p-58 },
+	{ 0x1.3c00000000000p+0, -0x1.af3c94e80bff3p-3, 0x1.398cff3641985p-58 },
+	{ 0x1.3a00000000000p+0, -0x1.a23bc1fe2b563p-3, -0x1.93711b07a998cp-59 },
+	{ 0x1.3a00000000000p+0, -0x1.a23bc1fe2b563p-3, -0x1.93711b07a998cp-59 },
+	{ 0x1.3800000000000p+0, -0x1.9525a9cf456b4p-3, -0x1.d904c1d4e2e26p-57 },
+	{ 0x1.3600000000000p+0, -0x1.87fa06520c911p-3, 0x1.bf7fdbfa08d9ap-57 },
+	{ 0x1.3400000000000p+0, -0x1.7ab890210d909p-3, -0x1.be36b2d6a0608p-59 },
+	{ 0x1.3400000000000p+0, -0x1.7ab890210d909p-3, -0x1.be36b2d6a0608p-59 },
+	{ 0x1.3200000000000p+0, -0x1.6d60fe719d21dp-3, 0x1.caae268ecd179p-57 },
+	{ 0x1.3000000000000p+0, -0x1.5ff3070a793d4p-3, 0x1.bc60efafc6f6ep-58 },
+	{ 0x1.3000000000000p+0, -0x1.5ff3070a793d4p-3, 0x1.bc60efafc6f6ep-58 },
+	{ 0x1.2e00000000000p+0, -0x1.526e5e3a1b438p-3, 0x1.746ff8a470d3ap-57 },
+	{ 0x1.2c00000000000p+0, -0x1.44d2b6ccb7d1ep-3, -0x1.9f4f6543e1f88p-57 },
+	{ 0x1.2c00000000000p+0, -0x1.44d2b6ccb7d1ep-3, -0x1.9f4f6543e1f88p-57 },
+	{ 0x1.2a00000000000p+0, -0x1.371fc201e8f74p-3, -0x1.de6cb62af18a0p-58 },
+	{ 0x1.2800000000000p+0, -0x1.29552f81ff523p-3, -0x1.301771c407dbfp-57 },
+	{ 0x1.2600000000000p+0, -0x1.1b72ad52f67a0p-3, -0x1.483023472cd74p-58 },
+	{ 0x1.2600000000000p+0, -0x1.1b72ad52f67a0p-3, -0x1.483023472cd74p-58 },
+	{ 0x1.2400000000000p+0, -0x1.0d77e7cd08e59p-3, -0x1.9a5dc5e9030acp-57 },
+	{ 0x1.2400000000000p+0, -0x1.0d77e7cd08e59p-3, -0x1.9a5dc5e9030acp-57 },
+	{ 0x1.2200000000000p+0, -0x1.fec9131dbeabbp-4, 0x1.5746b9981b36cp-58 },
+	{ 0x1.2000000000000p+0, -0x1.e27076e2af2e6p-4, 0x1.61578001e0162p-60 },
+	{ 0x1.2000000000000p+0, -0x1.e27076e2af2e6p-4, 0x1.61578001e0162p-60 },
+	{ 0x1.1e00000000000p+0, -0x1.c5e548f5bc743p-4, -0x1.5d617ef8161b1p-60 },
+	{ 0x1.1c00000000000p+0, -0x1.a926d3a4ad563p-4, -0x1.942f48aa70ea9p-58 },
+	{ 0x1.1c00000000000p+0, -0x1.a926d3a4ad563p-4, -0x1.942f48aa70ea9p-58 },
+	{ 0x1.1a00000000000p+0, -0x1.8c345d6319b21p-4, 0x1.4a697ab3424a9p-61 },
+	{ 0x1.1a00000000000p+0, -0x1.8c345d6319b21p-4, 0x1.4a697ab3424a9p-61 },
+	{ 0x1.1800000000000p+0, -0x1.6f0d28ae56b4cp-4, 0x1.906d99184b992p-58 },
+	{ 0x1.1600000000000p+0, -0x1.51b073f06183fp-4, -0x1.a49e39a1a8be4p-58 },
+	{ 0x1.1600000000000p+0, -0x1.51b073f06183fp-4, -0x1.a49e39a1a8be4p-58 },
+	{ 0x1.1400000000000p+0, -0x1.341d7961bd1d1p-4, 0x1.b599f227becbbp-58 },
+	{ 0x1.1400000000000p+0, -0x1.341d7961bd1d1p-4, 0x1.b599f227becbbp-58 },
+	{ 0x1.1200000000000p+0, -0x1.16536eea37ae1p-4, 0x1.79da3e8c22cdap-60 },
+	{ 0x1.1000000000000p+0, -0x1.f0a30c01162a6p-5, -0x1.85f325c5bbacdp-59 },
+	{ 0x1.1000000000000p+0, -0x1.f0a30c01162a6p-5, -0x1.85f325c5bbacdp-59 },
+	{ 0x1.0e00000000000p+0, -0x1.b42dd711971bfp-5, 0x1.eb9759c130499p-60 },
+	{ 0x1.0e00000000000p+0, -0x1.b42dd711971bfp-5, 0x1.eb9759c130499p-60 },
+	{ 0x1.0c00000000000p+0, -0x1.77458f632dcfcp-5, -0x1.18d3ca87b9296p-59 },
+	{ 0x1.0c00000000000p+0, -0x1.77458f632dcfcp-5, -0x1.18d3ca87b9296p-59 },
+	{ 0x1.0a00000000000p+0, -0x1.39e87b9febd60p-5, 0x1.5bfa937f551bbp-59 },
+	{ 0x1.0a00000000000p+0, -0x1.39e87b9febd60p-5, 0x1.5bfa937f551bbp-59 },
+	{ 0x1.0800000000000p+0, -0x1.f829b0e783300p-6, -0x1.33e3f04f1ef23p-60 },
+	{ 0x1.0800000000000p+0, -0x1.f829b0e783300p-6, -0x1.33e3f04f1ef23p-60 },
+	{ 0x1.0600000000000p+0, -0x1.7b91b07d5b11bp-6, 0x1.5b602ace3a510p-60 },
+	{ 0x1.0400000000000p+0, -0x1.fc0a8b0fc03e4p-7, 0x1.83092c59642a1p-62 },
+	{ 0x1.0400000000000p+0, -0x1.fc0a8b0fc03e4p-7, 0x1.83092c59642a1p-62 },
+	{ 0x1.0200000000000p+0, -0x1.fe02a6b106789p-8, 0x1.e44b7e3711ebfp-67 },
+	{ 0x1.0200000000000p+0, -0x1.fe02a6b106789p-8, 0x1.e44b7e3711ebfp-67 },
+	{ 0x1.0000000000000p+0, 0x0.0p+0, 0x0.0p+0 },
+	{ 0x1.0000000000000p+0, 0x0.0p+0, 0x0.0p+0 },
+	{ 0x1.fc00000000000p-1, 0x1.010157588de71p-7, 0x1.46662d417ced0p-62 },
+	{ 0x1.f800000000000p-1, 0x1.0205658935847p-6, 0x1.27c8e8416e71fp-60 },
+	{ 0x1.f400000000000p-1, 0x1.8492528c8cabfp-6, -0x1.d192d0619fa67p-60 },
+	{ 0x1.f000000000000p-1, 0x1.0415d89e74444p-5, 0x1.c05cf1d753622p-59 },
+	{ 0x1.ec00000000000p-1, 0x1.466aed42de3eap-5, -0x1.cdd6f7f4a137ep-59 },
+	{ 0x1.e800000000000p-1, 0x1.894aa149fb343p-5, 0x1.a8be97660a23dp-60 },
+	{ 0x1.e400000000000p-1, 0x1.ccb73cdddb2ccp-5, -0x1.e48fb0500efd4p-59 },
+	{ 0x1.e200000000000p-1, 0x1.eea31c006b87cp-5, -0x1.3e4fc93b7b66cp-59 },
+	{ 0x1.de00000000000p-1, 0x1.1973bd1465567p-4, -0x1.7558367a6acf6p-59 },
+	{ 0x1.da00000000000p-1, 0x1.3bdf5a7d1ee64p-4, 0x1.7a976d3b5b45fp-59 },
+	{ 0x1.d600000000000p-1, 0x1.5e95a4d9791cbp-4, 0x1.f38745c5c450ap-58 },
+	{ 0x1.d400000000000p-1, 0x1.700d30aeac0e1p-4, -0x1.72566212cdd05p-61 },
+	{ 0x1.d000000000000p-1, 0x1.9335e5d594989p-4, -0x1.478a85704ccb7p-58 },
+	{ 0x1.cc00000000000p-1, 0x1.b6ac88dad5b1cp-4, -0x1.0057eed1ca59fp-59 },
+	{ 0x1.ca00000000000p-1, 0x1.c885801bc4b23p-4, 0x1.a38cb559a6706p-58 },
+	{ 0x1.c600000000000p-1, 0x1.ec739830a1120p-4, -0x1.a2bf991780d3fp-59 },
+	{ 0x1.c400000000000p-1, 0x1.fe89139dbd566p-4, -0x1.ac9f4215f9393p-58 },
+	{ 0x1.c000000000000p-1, 0x1.1178e8227e47cp-3, -0x1.0e63a5f01c691p-58 },
+	{ 0x1.be00000000000p-1, 0x1.1aa2b7e23f72ap-3, -0x1.c6ef1d9b2ef7ep-59 },
+	{ 0x1.ba00000000000p-1, 0x1.2d1610c86813ap-3, -0x1.499a3f25af95fp-58 },
+	{ 0x1.b800000000000p-1, 0x1.365fcb0159016p-3, 0x1.7d411a5b944adp-58 },
+	{ 0x1.b400000000000p-1, 0x1.4913d8333b561p-3, -0x1.0d5604930f135p-58 },
+	{ 0x1.b200000000000p-1, 0x1.527e5e4a1b58dp-3, -0x1.71a9682395bfdp-61 },
+	{ 0x1.ae00000000000p-1, 0x1.6574ebe8c133ap-3, -0x1.d34f0f4621bedp-60 },
+	{ 0x1.ac00000000000p-1, 0x1.6f0128b756abcp-3, -0x1.8de59c21e166cp-57 },
+	{ 0x1.aa00000000000p-1, 0x1.7898d85444c73p-3, 0x1.ef8f6ebcfb201p-58 },
+	{ 0x1.a600000000000p-1, 0x1.8beafeb38fe8cp-3, 0x1.55aa8b6997a40p-58 },
+	{ 0x1.a400000000000p-1, 0x1.95a5adcf7017fp-3, 0x1.142c507fb7a3dp-58 },
+	{ 0x1.a000000000000p-1, 0x1.a93ed3c8ad9e3p-3, 0x1.bcafa9de97203p-57 },
+	{ 0x1.9e00000000000p-1, 0x1.b31d8575bce3dp-3, -0x1.6353ab386a94dp-57 },
+	{ 0x1.9c00000000000p-1, 0x1.bd087383bd8adp-3, 0x1.dd355f6a516d7p-60 },
+	{ 0x1.9a00000000000p-1, 0x1.c6ffbc6f00f71p-3, -0x1.8e58b2c57a4a5p-57 },
+	{ 0x1.9600000000000p-1, 0x1.db13db0d48940p-3, 0x1.aa11d49f96cb9p-58 },
+	{ 0x1.9400000000000p-1, 0x1.e530effe71012p-3, 0x1.2276041f43042p-59 },
+	{ 0x1.9200000000000p-1, 0x1.ef5ade4dcffe6p-3, -0x1.08ab2ddc708a0p-58 },
+	{ 0x1.9000000000000p-1, 0x1.f991c6cb3b379p-3, 0x1.f665066f980a2p-57 },
+	{ 0x1.8c00000000000p-1, 0x1.07138604d5862p-2, 0x1.cdb16ed4e9138p-56 },
+	{ 0x1.8a00000000000p-1, 0x1.0c42d676162e3p-2, 0x1.162c79d5d11eep-58 },
+	{ 0x1.8800000000000p-1, 0x1.1178e8227e47cp-2, -0x1.0e63a5f01c691p-57 },
+	{ 0x1.8600000000000p-1, 0x1.16b5ccbacfb73p-2, 0x1.66fbd28b40935p-56 },
+	{ 0x1.8400000000000p-1, 0x1.1bf99635a6b95p-2, -0x1.12aeb84249223p-57 },
+	{ 0x1.8200000000000p-1, 0x1.214456d0eb8d4p-2, 0x1.f7ae91aeba60ap-57 },
+	{ 0x1.7e00000000000p-1, 0x1.2bef07cdc9354p-2, -0x1.82dad7fd86088p-56 },
+	{ 0x1.7c00000000000p-1, 0x1.314f1e1d35ce4p-2, -0x1.3d69909e5c3dcp-56 },
+	{ 0x1.7a00000000000p-1, 0x1.36b6776be1117p-2, -0x1.324f0e883858ep-58 },
+	{ 0x1.7800000000000p-1, 0x1.3c25277333184p-2, -0x1.2ad27e50a8ec6p-56 },
+	{ 0x1.7600000000000p-1, 0x1.419b423d5e8c7p-2, 0x1.0dbb243827392p-57 },
+	{ 0x1.7400000000000p-1, 0x1.4718dc271c41bp-2, 0x1.8fb4c14c56eefp-60 },
+	{ 0x1.7200000000000p-1, 0x1.4c9e09e172c3cp-2, -0x1.123615b147a5dp-58 },
+	{ 0x1.7000000000000p-1, 0x1.522ae0738a3d8p-2, -0x1.8f7e9b38a6979p-57 },
+	{ 0x1.6e00000000000p-1, 0x1.57bf753c8d1fbp-2, -0x1.0908d15f88b63p-57 },
+	{ 0x1.6c00000000000p-1, 0x1.5d5bddf595f30p-2, -0x1.6541148cbb8a2p-56 },
+};
+
+// Instances: 128-bit vectors (SSE2, the baseline on x86-64) and 256-bit vectors with
+// FMA for processors that have AVX2
+
+#define VW 2
+#define KFN(name) vforce_v128_##name
+#define KATTR
+#if defined(__x86_64__) || defined(__i386__)
+#define KSQRT(v) ((KFN(vd)) _mm_sqrt_pd(v))
+#else
+#define KSQRT(v) ({ KFN(vd) r_ = (v); for (int l_ = 0; l_ < VW; l_++) r_[l_] = sqrt(r_[l_]); r_; })
+#endif
+#include "vforce_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#undef KSQRT
+
+#ifdef VFORCE_HAVE_FMA
+#define VW 4
+#define KFN(name) vforce_fma_##name
+#define KATTR __attribute__((target("avx2,fma")))
+#define KSQRT(v) ((KFN(vd)) _mm256_sqrt_pd(v))
+#define KFMA(a, b, c) ((KFN(vd)) _mm256_fmadd_pd(a, b, c))
+#include "vforce_kernels.h"
+#undef VW
+#undef KFN
+#undef KATTR
+#undef KSQRT
+#undef KFMA
+#endif
+
+#ifdef VFORCE_HAVE_FMA
+#define VFORCE_DISPATCH(name, ...) \
+	do { \
+		if (vforce_have_fma) \
+			vforce_fma_##name(__VA_ARGS__); \
+		else \
+			vforce_v128_##name(__VA_ARGS__); \
+	} while (0)
+#else
+#define VFORCE_DISPATCH(name, ...) vforce_v128_##name(__VA_ARGS__)
+#endif
+
+// The Fortran spellings of every function: name_, NAME and NAME_
+#define VFORCE_FORTRAN(name, NAME, params, args) \
+	void name##_ params { name args; } \
+	void NAME params { name args; } \
+	void NAME##_ params { name args; }
+
+#define VFORCE_PARAMS1(REAL) (REAL *__y, const REAL *__x, const int *__n)
+#define VFORCE_PARAMS2(REAL) (REAL *__z, const REAL *__y, const REAL *__x, const int *__n)
+
+// y = f(x)
+#define VFORCE_UNARY(name, NAME) \
+	void vv##name VFORCE_PARAMS1(double) \
+	{ \
+		if (*__n > 0) \
+			VFORCE_DISPATCH(name##_d, __y, __x, *__n); \
+	} \
+	void vv##name##f VFORCE_PARAMS1(float) \
+	{ \
+		if (*__n > 0) \
+			VFORCE_DISPATCH(name##_f, __y, __x, *__n); \
+	} \
+	VFORCE_FORTRAN(vv##name, VV##NAME, VFORCE_PARAMS1(double), (__y, __x, __n)) \
+	VFORCE_FORTRAN(vv##name##f, VV##NAME##F, VFORCE_PARAMS1(float), (__y, __x, __n))
+
+// z = f(y, x), the kernel taking y every ys elements
+#define VFORCE_BINARY(name, NAME, kernel, ys) \
+	void vv##name VFORCE_PARAMS2(double) \
+	{ \
+		if (*__n > 0) \
+			VFORCE_DISPATCH(kernel##_d, __z, __y, ys, __x, *__n); \
+	} \
+	void vv##name##f VFORCE_PARAMS2(float) \
+	{ \
+		if (*__n > 0) \
+			VFORCE_DISPATCH(kernel##_f, __z, __y, ys, __x, *__n); \
+	} \
+	VFORCE_FORTRAN(vv##name, VV##NAME, VFORCE_PARAMS2(double), (__z, __y, __x, __n)) \
+	VFORCE_FORTRAN(vv##name##f, VV##NAME##F, VFORCE_PARAMS2(float), (__z, __y, __x, __n))
+
+// Exactly rounded functions whose libm versions are as fast as it gets
+#define VFORCE_LIBM1(name, NAME) \
+	void vv##name VFORCE_PARAMS1(double) \
+	{ \
+		for (int i = 0; i < *__n; i++) \
+			__y[i] = name(__x[i]); \
+	} \
+	void vv##name##f VFORCE_PARAMS1(float) \
+	{ \
+		for (int i = 0; i < *__n; i++) \
+			__y[i] = name##f(__x[i]); \
+	} \
+	VFORCE_FORTRAN(vv##name, VV##NAME, VFORCE_PARAMS1(double), (__y, __x, __n)) \
+	VFORCE_FORTRAN(vv##name##f, VV##NAME##F, VFORCE_PARAMS1(float), (__y, __x, __n))
+
+#define VFORCE_LIBM2(name, NAME) \
+	void vv##name VFORCE_PARAMS2(double) \
+	{ \
+		for (int i = 0; i < *__n; i++) \
+			__z[i] = name(__y[i], __x[i]); \
+	} \
+	void vv##name##f VFORCE_PARAMS2(float) \
+	{ \
+		for (int i = 0; i < *__n; i++) \
+			__z[i] = name##f(__y[i], __x[i]); \
+	} \
+	VFORCE_FORTRAN(vv##name, VV##NAME, VFORCE_PARAMS2(double), (__z, __y, __x, __n)) \
+	VFORCE_FORTRAN(vv##name##f, VV##NAME##F, VFORCE_PARAMS2(float), (__z, __y, __x, __n))
+
+VFORCE_UNARY(exp, EXP)
+VFORCE_UNARY(exp2, EXP2)
+VFORCE_UNARY(expm1, EXPM1)
+VFORCE_UNARY(log, LOG)
+VFORCE_UNARY(log2, LOG2)
+VFORCE_UNARY(log10, LOG10)
+VFORCE_UNARY(log1p, LOG1P)
+VFORCE_UNARY(logb, LOGB)
+VFORCE_UNARY(sin, SIN)
+VFORCE_UNARY(cos, COS)
+VFORCE_UNARY(tan, TAN)
+VFORCE_UNARY(sinpi, SINPI)
+VFORCE_UNARY(cospi, COSPI)
+VFORCE_UNARY(tanpi, TANPI)
+VFORCE_UNARY(asin, ASIN)
+VFORCE_UNARY(acos, ACOS)
+VFORCE_UNARY(atan, ATAN)
+VFORCE_UNARY(sinh, SINH)
+VFORCE_UNARY(cosh, COSH)
+VFORCE_UNARY(tanh, TANH)
+VFORCE_UNARY(asinh, ASINH)
+VFORCE_UNARY(acosh, ACOSH)
+VFORCE_UNARY(atanh, ATANH)
+VFORCE_UNARY(nint, NINT)
+VFORCE_UNARY(int, INT)
+VFORCE_UNARY(floor, FLOOR)
+VFORCE_UNARY(ceil, CEIL)
+VFORCE_UNARY(sqrt, SQRT)
+VFORCE_UNARY(rsqrt, RSQRT)
+VFORCE_UNARY(rec, REC)
+VFORCE_UNARY(fabs, FABS)
+
+// z = x^y and z = x^(*y)
+VFORCE_BINARY(pow, POW, pow_yx, 1)
+VFORCE_BINARY(pows, POWS, pow_yx, 0)
+VFORCE_BINARY(atan2, ATAN2, atan2, 1)
+VFORCE_BINARY(div, DIV, div, 1)
+VFORCE_BINARY(copysign, COPYSIGN, copysign, 1)
+
+VFORCE_LIBM1(cbrt, CBRT)
+VFORCE_LIBM2(fmod, FMOD)
+VFORCE_LIBM2(remainder, REMAINDER)
+VFORCE_LIBM2(nextafter, NEXTAFTER)
+
+// z = sin(x), y = cos(x)
+#define VFORCE_PARAMS_SINCOS(REAL) (REAL *__z, REAL *__y, const REAL *__x, const int *__n)
+
+void vvsincos VFORCE_PARAMS_SINCOS(double)
+{
+	if (*__n > 0)
+		VFORCE_DISPATCH(sincos_d, __z, __y, __x, *__n);
+}
+
+void vvsincosf VFORCE_PARAMS_SINCOS(float)
+{
+	if (*__n > 0)
+		VFORCE_DISPATCH(sincos_f, __z, __y, __x, *__n);
+}
+
+VFORCE_FORTRAN(vvsincos, VVSINCOS, VFORCE_PARAMS_SINCOS(double), (__z, __y, __x, __n))
+VFORCE_FORTRAN(vvsincosf, VVSINCOSF, VFORCE_PARAMS_SINCOS(float), (__z, __y, __x, __n))
+
+// z = cos(x) + i*sin(x)
+void vvcosisin(__double_complex_t *__z, const double *__x, const int *__n)
+{
+	if (*__n > 0)
+		VFORCE_DISPATCH(sincos_d, NULL, (double*) __z, __x, *__n);
+}
+
+void vvcosisinf(__float_complex_t *__z, const float *__x, const int *__n)
+{
+	if (*__n > 0)
+		VFORCE_DISPATCH(sincos_f, NULL, (float*) __z, __x, *__n);
+}
+
+VFORCE_FORTRAN(vvcosisin, VVCOSISIN, (__double_complex_t *__z, const double *__x, const int *__n), (__z, __x, __n))
+VFORCE_FORTRAN(vvcosisinf, VVCOSISINF, (__float_complex_t *__z, const float *__x, const int *__n), (__z, __x, __n))
+
+// vvfabf is an old misspelling of vvfabsf
+void vvfabf(float *__y, const float *__x, const int *__n)
+{
+	vvfabsf(__y, __x, __n);
+}
+
+VFORCE_FORTRAN(vvfabf, VVFABF, VFORCE_PARAMS1(float), (__y, __x, __n))
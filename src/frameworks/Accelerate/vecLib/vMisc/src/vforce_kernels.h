@@ -0,0 +1,1045 @@
+/*
+ This file is part of Darling.
+
+ Copyright (C) 2019 Lubos Dolezel
+
+ Darling is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ Darling is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// vForce kernels, included by vforce.c once per vector width.
+//
+// The includer defines:
+//   VW            number of doubles processed at once
+//   KFN(name)     mangles a kernel name for this instance
+//   KATTR         function attributes for this instance (e.g. target("avx2,fma"))
+//   KSQRT(v)      square root of a vector
+//   KFMA(a, b, c) fused a * b + c of vectors, only if the instance has it
+//
+// Everything is evaluated in double precision, the float entry points widen their inputs
+// and round the results. The algorithms are the usual ones (Cody-Waite reduction and
+// polynomials from fdlibm and Cephes), written branch-free with lane masks. Lanes that
+// the reductions can't handle accurately (|x| >= 2^20 for sin, cos and tan, pow with
+// x <= 0 or nonfinite arguments) are recomputed with libm.
+//
+// Worst errors seen against a long double reference over 10^7 random arguments per function,
+// with and without FMA, in ulps of the double result (rounded up to a tenth):
+//   exp, exp2, expm1                             1.4
+//   log, log2, log10, log1p                      0.9
+//   sin, cos, tan, sinpi, cospi, tanpi           1.0
+//   atan                                         1.0
+//   atan2                                        1.7
+//   asin, acos                                   2.5
+//   sinh, cosh, tanh                             1.6
+//   asinh, atanh                                 1.8
+//   acosh                                        2.1
+//   pow                                          0.9
+//   rsqrt                                        1.5
+//   sqrt, rec, div, rint-like and bit functions  correctly rounded
+// The float results are correctly rounded but for rare double rounding cases.
+
+typedef double KFN(vd) __attribute__((vector_size(VW * sizeof(double))));
+typedef int64_t KFN(vl) __attribute__((vector_size(VW * sizeof(int64_t))));
+typedef uint64_t KFN(vu) __attribute__((vector_size(VW * sizeof(uint64_t))));
+typedef float KFN(vf) __attribute__((vector_size(VW * sizeof(float))));
+
+#define VD KFN(vd)
+#define VL KFN(vl)
+#define VU KFN(vu)
+#define VF KFN(vf)
+
+KATTR static inline VD KFN(load)(const double* p)
+{
+	VD v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+KATTR static inline void KFN(store)(double* p, VD v)
+{
+	memcpy(p, &v, sizeof(v));
+}
+
+KATTR static inline VD KFN(loadf)(const float* p)
+{
+	VF v;
+	memcpy(&v, p, sizeof(v));
+	return __builtin_convertvector(v, VD);
+}
+
+KATTR static inline void KFN(storef)(float* p, VD v)
+{
+	VF f = __builtin_convertvector(v, VF);
+	memcpy(p, &f, sizeof(f));
+}
+
+KATTR static inline VD KFN(splat)(double x)
+{
+	VD v = { 0 };
+	return v + x;
+}
+
+// m ? a : b, m being all ones or all zeros in every lane
+KATTR static inline VD KFN(sel)(VL m, VD a, VD b)
+{
+	return (VD) (((VL) a & m) | ((VL) b & ~m));
+}
+
+KATTR static inline VD KFN(fabs)(VD x)
+{
+	return (VD) ((VL) x & INT64_MAX);
+}
+
+KATTR static inline VD KFN(copysign)(VD mag, VD sgn)
+{
+	return (VD) (((VL) mag & INT64_MAX) | ((VL) sgn & INT64_MIN));
+}
+
+KATTR static inline VD KFN(neg_if)(VD x, VL m)
+{
+	return (VD) ((VL) x ^ (m & INT64_MIN));
+}
+
+// Rounds to the nearest integer, ties to even
+KATTR static inline VD KFN(rint)(VD x)
+{
+	const VD ax = KFN(fabs)(x);
+	const VD r = (ax + 0x1p52) - 0x1p52;
+	return KFN(sel)((VL) (ax < 0x1p52), KFN(copysign)(r, x), x);
+}
+
+// Converts integers with |k| < 2^51
+KATTR static inline VD KFN(from_int)(VL k)
+{
+	return (VD) (k + (VL) KFN(splat)(0x1.8p52)) - 0x1.8p52;
+}
+
+// p * 2^k for -1080 < k < 1030, rounding once even when the result is subnormal
+KATTR static inline VD KFN(scale)(VD p, VL k)
+{
+	const VL k1 = k >> 1, k2 = k - k1;
+	return p * (VD) ((VU) (k1 + 1023) << 52) * (VD) ((VU) (k2 + 1023) << 52);
+}
+
+// hi + lo = a * b exactly
+KATTR static inline VD KFN(two_prod)(VD a, VD b, VD* lo)
+{
+	const VD hi = a * b;
+#ifdef KFMA
+	*lo = KFMA(a, b, -hi);
+#else
+	const VD ca = a * 0x1.0000002p27, cb = b * 0x1.0000002p27;
+	const VD ahi = ca - (ca - a), bhi = cb - (cb - b);
+	const VD alo = a - ahi, blo = b - bhi;
+	*lo = ((ahi * bhi - hi) + ahi * blo + alo * bhi) + alo * blo;
+#endif
+	return hi;
+}
+
+// hi + lo = a + b exactly
+KATTR static inline VD KFN(two_sum)(VD a, VD b, VD* lo)
+{
+	const VD hi = a + b;
+	const VD bb = hi - a;
+	*lo = (a - (hi - bb)) + (b - bb);
+	return hi;
+}
+
+#define KFN_FIXUP(res, mask, expr) \
+	for (int l = 0; l < VW; l++) \
+		if ((mask)[l]) \
+			(res)[l] = (expr)
+
+// exp
+
+// e^r - 1 - r for |r| <= ln(2)/2
+KATTR static inline VD KFN(expm1_poly)(VD r)
+{
+	VD q = KFN(splat)(EXP_C13);
+	q = q * r + EXP_C12;
+	q = q * r + EXP_C11;
+	q = q * r + EXP_C10;
+	q = q * r + EXP_C9;
+	q = q * r + EXP_C8;
+	q = q * r + EXP_C7;
+	q = q * r + EXP_C6;
+	q = q * r + EXP_C5;
+	q = q * r + EXP_C4;
+	q = q * r + EXP_C3;
+	q = q * r + 0.5;
+	return r * r * q;
+}
+
+// Splits x + xlo = k*ln(2) + r and returns e^r - 1 as hi + lo, hi being r
+KATTR static inline VD KFN(exp_reduce)(VD x, VD xlo, VL* k, VD* lo)
+{
+	const VD t = x * LOG2E + 0x1.8p52;
+	const VD kd = t - 0x1.8p52;
+	*k = (VL) t - (VL) KFN(splat)(0x1.8p52);
+
+	const VD rh = x - kd * LN2_HI;
+	const VD rl = xlo - kd * LN2_LO;
+	const VD r = rh + rl;
+	const VD c = (rh - r) + rl;
+
+	// e^(r+c) - 1 = r + p + c*(1 + r + p)
+	const VD p = KFN(expm1_poly)(r);
+	*lo = p + (c + c * (r + p));
+	return r;
+}
+
+// 2^k for -1023 < k < 1024
+KATTR static inline VD KFN(pow2)(VL k)
+{
+	return (VD) ((VU) (k + 1023) << 52);
+}
+
+// e^(x + xlo), xlo being a small correction to x
+KATTR static inline VD KFN(exp_core)(VD x, VD xlo)
+{
+	// the correction means nothing once x is clamped
+	xlo = KFN(sel)((VL) (x > 710.0) | (VL) (x < -746.0), KFN(splat)(0.0), xlo);
+	x = KFN(sel)((VL) (x > 710.0), KFN(splat)(710.0), x);
+	x = KFN(sel)((VL) (x < -746.0), KFN(splat)(-746.0), x);
+
+	VL k;
+	VD lo;
+	const VD hi = KFN(exp_reduce)(x, xlo, &k, &lo);
+	return KFN(scale)(1.0 + (hi + lo), k);
+}
+
+KATTR static inline VD KFN(exp)(VD x)
+{
+	return KFN(exp_core)(x, KFN(splat)(0.0));
+}
+
+KATTR static inline VD KFN(exp2)(VD x)
+{
+	x = KFN(sel)((VL) (x > 1025.0), KFN(splat)(1025.0), x);
+	x = KFN(sel)((VL) (x < -1080.0), KFN(splat)(-1080.0), x);
+
+	const VD t = x + 0x1.8p52;
+	const VD kd = t - 0x1.8p52;
+	const VL k = (VL) t - (VL) KFN(splat)(0x1.8p52);
+	const VD r = x - kd;
+
+	VD q = KFN(splat)(EXP2_C13);
+	q = q * r + EXP2_C12;
+	q = q * r + EXP2_C11;
+	q = q * r + EXP2_C10;
+	q = q * r + EXP2_C9;
+	q = q * r + EXP2_C8;
+	q = q * r + EXP2_C7;
+	q = q * r + EXP2_C6;
+	q = q * r + EXP2_C5;
+	q = q * r + EXP2_C4;
+	q = q * r + EXP2_C3;
+	q = q * r + EXP2_C2;
+	q = q * r + EXP2_C1;
+	return KFN(scale)(1.0 + r * q, k);
+}
+
+// e^x - 1 for |x| <= 40 from the parts of e^x
+KATTR static inline VD KFN(expm1_parts)(VD hi, VD lo, VL k)
+{
+	// 2^k*(e^r - 1) + (2^k - 1), the first two terms being exact for small k
+	const VD s = KFN(pow2)(k);
+	return ((s - 1.0) + s * hi) + s * lo;
+}
+
+// The same as hi + lo in double-double
+KATTR static inline VD KFN(expm1_parts_dd)(VD hi, VD lo, VL k, VD* tlo)
+{
+	const VD s = KFN(pow2)(k);
+	VD e1, e2;
+	const VD t1 = KFN(two_sum)(s - 1.0, s * hi, &e1);
+	const VD th = KFN(two_sum)(t1, s * lo, &e2);
+	*tlo = e1 + e2;
+	return th;
+}
+
+KATTR static inline VD KFN(expm1)(VD x)
+{
+	// e^x - 1 rounds to -1 below -40, and the -1 doesn't matter above 40
+	const VD xc = KFN(sel)((VL) (x < -40.0), KFN(splat)(-40.0),
+		KFN(sel)((VL) (x > 710.0), KFN(splat)(710.0), x));
+
+	VL k;
+	VD lo;
+	const VD hi = KFN(exp_reduce)(xc, KFN(splat)(0.0), &k, &lo);
+	VD res = KFN(expm1_parts)(hi, lo, k);
+
+	res = KFN(sel)((VL) (x > 40.0), KFN(scale)(1.0 + (hi + lo), k), res);
+	return KFN(sel)((VL) (x == 0.0), x, res);
+}
+
+// log
+
+// x = 2^k * (1 + f) with sqrt(2)/2 <= 1 + f < sqrt(2). The logarithm of 1 + f is
+// f - hfsq + s*(hfsq + R) with s = f/(2 + f), hfsq = f^2/2 and R the fdlibm polynomial.
+struct KFN(log_parts)
+{
+	VD k, f, s, hfsq, R;
+};
+
+KATTR static inline struct KFN(log_parts) KFN(log_reduce)(VD x)
+{
+	struct KFN(log_parts) p;
+
+	const VL sub = (VL) (x < 0x1p-1022);
+	x = KFN(sel)(sub, x * 0x1p54, x);
+
+	const VL ix = (VL) x;
+	const VL k = (ix - 0x3fe6a09e667f3bcd) >> 52;
+	const VD m = (VD) (ix - (VL) ((VU) k << 52));
+
+	p.k = KFN(from_int)(k) - KFN(sel)(sub, KFN(splat)(54.0), KFN(splat)(0.0));
+	p.f = m - 1.0;
+	p.s = p.f / (2.0 + p.f);
+
+	const VD z = p.s * p.s;
+	const VD w = z * z;
+	const VD t1 = w * (LG2 + w * (LG4 + w * LG6));
+	const VD t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+	p.R = t1 + t2;
+	p.hfsq = 0.5 * p.f * p.f;
+	return p;
+}
+
+// Results for arguments outside of (0, inf)
+KATTR static inline VD KFN(log_special)(VD x, VD res)
+{
+	const VL ok = (VL) (x > 0.0) & (VL) (x < INFINITY);
+	const VD special = KFN(sel)((VL) (x == 0.0), KFN(splat)(-INFINITY),
+		KFN(sel)((VL) (x < 0.0), KFN(splat)(NAN), x + x));
+	return KFN(sel)(ok, res, special);
+}
+
+KATTR static inline VD KFN(log)(VD x)
+{
+	const struct KFN(log_parts) p = KFN(log_reduce)(x);
+	const VD res = p.k * LN2_HI - ((p.hfsq - (p.s * (p.hfsq + p.R) + p.k * LN2_LO)) - p.f);
+	return KFN(log_special)(x, res);
+}
+
+// log(1 + f) = hi + lo, hi having its low 32 bits cleared
+KATTR static inline VD KFN(log_split)(const struct KFN(log_parts)* p, VD* lo)
+{
+	VD hi = p->f - p->hfsq;
+	hi = (VD) ((VL) hi & (int64_t) 0xffffffff00000000ULL);
+	*lo = (p->f - hi) - p->hfsq + p->s * (p->hfsq + p->R);
+	return hi;
+}
+
+KATTR static inline VD KFN(log2)(VD x)
+{
+	const struct KFN(log_parts) p = KFN(log_reduce)(x);
+	VD lo;
+	const VD hi = KFN(log_split)(&p, &lo);
+
+	VD val_hi = hi * IVLN2_HI;
+	VD val_lo = (lo + hi) * IVLN2_LO + lo * IVLN2_HI;
+	const VD w = p.k + val_hi;
+	val_lo += (p.k - w) + val_hi;
+	val_hi = w;
+
+	return KFN(log_special)(x, val_lo + val_hi);
+}
+
+KATTR static inline VD KFN(log10)(VD x)
+{
+	const struct KFN(log_parts) p = KFN(log_reduce)(x);
+	VD lo;
+	const VD hi = KFN(log_split)(&p, &lo);
+
+	VD val_hi = hi * IVLN10_HI;
+	const VD y2 = p.k * LOG10_2_HI;
+	VD val_lo = p.k * LOG10_2_LO + (lo + hi) * IVLN10_LO + lo * IVLN10_HI;
+	const VD w = y2 + val_hi;
+	val_lo += (y2 - w) + val_hi;
+	val_hi = w;
+
+	return KFN(log_special)(x, val_lo + val_hi);
+}
+
+KATTR static inline VD KFN(log1p)(VD x)
+{
+	// log(1 + x) = log(u) + c with c correcting for the rounding of u = 1 + x
+	const VD u = 1.0 + x;
+	const VD c = (x - (u - 1.0)) / u;
+
+	const struct KFN(log_parts) p = KFN(log_reduce)(u);
+	VD res = p.k * LN2_HI - ((p.hfsq - (p.s * (p.hfsq + p.R) + (p.k * LN2_LO + c))) - p.f);
+
+	res = KFN(log_special)(u, res);
+	return KFN(sel)((VL) (x == 0.0), x, res);
+}
+
+KATTR static inline VD KFN(logb)(VD x)
+{
+	const VD ax = KFN(fabs)(x);
+	const VL sub = (VL) (ax < 0x1p-1022);
+	const VD xs = KFN(sel)(sub, ax * 0x1p54, ax);
+
+	VD e = KFN(from_int)(((VL) xs >> 52) - 1023);
+	e = e - KFN(sel)(sub, KFN(splat)(54.0), KFN(splat)(0.0));
+
+	const VD special = KFN(sel)((VL) (ax == 0.0), KFN(splat)(-INFINITY), ax);
+	return KFN(sel)((VL) (ax < INFINITY) & (VL) (ax > 0.0), e, special);
+}
+
+// pow
+
+// log(x) = hi + lo with about 68 good bits for positive, finite x. Like the fdlibm and
+// ARM pow, x = 2^k * z and log(z) = log(c) + log(z/c) with 1/c from a table, so that
+// r = z/c - 1 is small and exact.
+KATTR static inline VD KFN(log_hilo)(VD x, VD* lo)
+{
+	const VL sub = (VL) (x < 0x1p-1022);
+	x = KFN(sel)(sub, x * 0x1p54, x);
+
+	const VL ix = (VL) x;
+	const VL tmp = ix - POW_LOG_OFF;
+	const VL i = (tmp >> (52 - POW_LOG_TABLE_BITS)) & ((1 << POW_LOG_TABLE_BITS) - 1);
+	const VL k = tmp >> 52;
+	const VL iz = ix - (tmp & (int64_t) 0xfff0000000000000ULL);
+	const VD z = (VD) iz;
+	const VD kd = KFN(from_int)(k) - KFN(sel)(sub, KFN(splat)(54.0), KFN(splat)(0.0));
+
+	VD invc, logc, logctail;
+	for (int l = 0; l < VW; l++)
+	{
+		invc[l] = vforce_pow_log_table[i[l]].invc;
+		logc[l] = vforce_pow_log_table[i[l]].logc;
+		logctail[l] = vforce_pow_log_table[i[l]].logctail;
+	}
+
+	// 1/c has few enough bits for this to be exact
+#ifdef KFMA
+	const VD r = KFMA(z, invc, KFN(splat)(-1.0));
+#else
+	const VD zhi = (VD) ((iz + (1LL << 31)) & (int64_t) 0xffffffff00000000ULL);
+	const VD zlo = z - zhi;
+	const VD rhi = zhi * invc - 1.0;
+	const VD rlo = zlo * invc;
+	const VD r = rhi + rlo;
+#endif
+
+	// k*ln2_hi + log(c) + r - r^2/2 in double-double, the rest in double
+	const VD a = kd * POW_LN2_HI;
+	const VD t1 = a + logc;
+	const VD e1 = (a - t1) + logc;
+	VD e2, e3, sqlo;
+	const VD t2 = KFN(two_sum)(t1, r, &e2);
+	const VD sq = KFN(two_prod)(r, r, &sqlo);
+	const VD t3 = KFN(two_sum)(t2, -0.5 * sq, &e3);
+
+	VD p = KFN(splat)(-1.0 / 12);
+	p = p * r + 1.0 / 11;
+	p = p * r - 1.0 / 10;
+	p = p * r + 1.0 / 9;
+	p = p * r - 1.0 / 8;
+	p = p * r + 1.0 / 7;
+	p = p * r - 1.0 / 6;
+	p = p * r + 1.0 / 5;
+	p = p * r - 1.0 / 4;
+	p = p * r + 1.0 / 3;
+
+	const VD tail = e1 + e2 + e3 - 0.5 * sqlo + kd * POW_LN2_LO + logctail + sq * r * p;
+	const VD hi = t3 + tail;
+	*lo = (t3 - hi) + tail;
+	return hi;
+}
+
+KATTR static inline VD KFN(pow)(VD x, VD y)
+{
+	VD llo, elo;
+	const VD lhi = KFN(log_hilo)(x, &llo);
+
+	// |log(x)| >= 2^-53 unless x is 1, so this still overflows or underflows where it should,
+	// and keeps y*log(x) from overflowing
+	const VD yc = KFN(sel)((VL) (KFN(fabs)(y) > 0x1p70), KFN(copysign)(KFN(splat)(0x1p70), y), y);
+	const VD ehi = KFN(two_prod)(yc, lhi, &elo);
+	VD res = KFN(exp_core)(ehi, elo + yc * llo);
+
+	// Negative and zero bases, infinities and NaNs
+	const VL ok = (VL) (x > 0.0) & (VL) (x < INFINITY) & (VL) (KFN(fabs)(y) < INFINITY);
+	const VL bad = ~ok;
+	KFN_FIXUP(res, bad, pow(x[l], y[l]));
+	return res;
+}
+
+// sin, cos, tan
+
+// x = k*pi/2 + hi + lo with |hi| <= pi/4, for |x| < 2^20. k*pio2_1, k*pio2_2 and k*pio2_3
+// are exact, so the reduction only loses the last k*pio2_3t rounding.
+KATTR static inline VD KFN(trig_reduce)(VD x, VL* q, VD* lo)
+{
+	const VD t = x * INVPIO2 + 0x1.8p52;
+	const VD kd = t - 0x1.8p52;
+	*q = (VL) t;
+
+	VD e2, e3;
+	const VD r1 = x - kd * PIO2_1;
+	const VD r2 = KFN(two_sum)(r1, -(kd * PIO2_2), &e2);
+	const VD r3 = KFN(two_sum)(r2, -(kd * PIO2_3), &e3);
+	const VD tail = (e2 + e3) - kd * PIO2_3T;
+	const VD hi = r3 + tail;
+	*lo = (r3 - hi) + tail;
+	return hi;
+}
+
+// fdlibm's kernels for |x| <= pi/4, y being a tail of x
+KATTR static inline VD KFN(sin_poly)(VD x, VD y)
+{
+	const VD z = x * x;
+	const VD w = z * z;
+	const VD r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+	const VD v = z * x;
+	return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+KATTR static inline VD KFN(cos_poly)(VD x, VD y)
+{
+	const VD z = x * x;
+	const VD w = z * z;
+	const VD r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+	const VD hz = 0.5 * z;
+	const VD v = 1.0 - hz;
+	return v + (((1.0 - v) - hz) + (z * r - x * y));
+}
+
+// tan(x + y), or -1/tan(x + y) in the odd lanes
+KATTR static inline VD KFN(tan_poly)(VD x, VD y, VL odd)
+{
+	// tan(pi/4 - x) = (1 - tan(x))/(1 + tan(x)) above 0.6744
+	const VL big = (VL) (KFN(fabs)(x) >= 0.6744);
+	const VL neg = big & (VL) (x < 0.0);
+	x = KFN(neg_if)(x, neg);
+	y = KFN(neg_if)(y, neg);
+	x = KFN(sel)(big, (PIO4 - x) + (PIO4_LO - y), x);
+	y = KFN(sel)(big, KFN(splat)(0.0), y);
+
+	const VD z = x * x;
+	const VD w = z * z;
+	VD r = T1 + w * (T3 + w * (T5 + w * (T7 + w * (T9 + w * T11))));
+	VD v = z * (T2 + w * (T4 + w * (T6 + w * (T8 + w * (T10 + w * T12)))));
+	const VD s = z * x;
+	r = y + z * (s * (r + v) + y);
+	r = r + T0 * s;
+	const VD tx = x + r;
+
+	const VD iv = KFN(sel)(odd, KFN(splat)(-1.0), KFN(splat)(1.0));
+	const VD big_res = KFN(neg_if)(iv - 2.0 * (x - (tx * tx / (tx + iv) - r)), neg);
+
+	// -1/(x + r) with the division's error compensated
+	const VD zh = (VD) ((VL) tx & (int64_t) 0xffffffff00000000ULL);
+	const VD vh = r - (zh - x);
+	const VD a = -1.0 / tx;
+	const VD th = (VD) ((VL) a & (int64_t) 0xffffffff00000000ULL);
+	const VD sh = 1.0 + th * zh;
+	const VD cot = th + a * (sh + th * vh);
+
+	return KFN(sel)(big, big_res, KFN(sel)(odd, cot, tx));
+}
+
+KATTR static inline VL KFN(trig_big)(VD x)
+{
+	return ~(VL) (KFN(fabs)(x) < 0x1p20);
+}
+
+// sin(x) and cos(x)
+KATTR static inline void KFN(sincos)(VD x, VD* s, VD* c)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trig_reduce)(x, &q, &lo);
+	const VD ps = KFN(sin_poly)(r, lo), pc = KFN(cos_poly)(r, lo);
+	const VL odd = -(q & 1);
+
+	VD sr = KFN(neg_if)(KFN(sel)(odd, pc, ps), (VL) ((VU) (q & 2) << 62));
+	VD cr = KFN(neg_if)(KFN(sel)(odd, ps, pc), (VL) ((VU) ((q + 1) & 2) << 62));
+	sr = KFN(sel)((VL) (x == 0.0), x, sr);
+
+	const VL big = KFN(trig_big)(x);
+	KFN_FIXUP(sr, big, sin(x[l]));
+	KFN_FIXUP(cr, big, cos(x[l]));
+	*s = sr;
+	*c = cr;
+}
+
+KATTR static inline VD KFN(sin)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trig_reduce)(x, &q, &lo);
+	const VL odd = -(q & 1);
+
+	VD res = KFN(sel)(odd, KFN(cos_poly)(r, lo), KFN(sin_poly)(r, lo));
+	res = KFN(neg_if)(res, (VL) ((VU) (q & 2) << 62));
+	res = KFN(sel)((VL) (x == 0.0), x, res);
+
+	const VL big = KFN(trig_big)(x);
+	KFN_FIXUP(res, big, sin(x[l]));
+	return res;
+}
+
+KATTR static inline VD KFN(cos)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trig_reduce)(x, &q, &lo);
+	const VL odd = -(q & 1);
+
+	VD res = KFN(sel)(odd, KFN(sin_poly)(r, lo), KFN(cos_poly)(r, lo));
+	res = KFN(neg_if)(res, (VL) ((VU) ((q + 1) & 2) << 62));
+
+	const VL big = KFN(trig_big)(x);
+	KFN_FIXUP(res, big, cos(x[l]));
+	return res;
+}
+
+KATTR static inline VD KFN(tan)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trig_reduce)(x, &q, &lo);
+
+	VD res = KFN(tan_poly)(r, lo, -(q & 1));
+	res = KFN(sel)((VL) (x == 0.0), x, res);
+
+	const VL big = KFN(trig_big)(x);
+	KFN_FIXUP(res, big, tan(x[l]));
+	return res;
+}
+
+// x*pi = 2*pi*n + q*pi/2 + pi*s with |s| <= 1/4, exact up to pi*s = hi + lo
+KATTR static inline VD KFN(trigpi_reduce)(VD x, VL* q, VD* lo)
+{
+	const VD r = x - 2.0 * KFN(rint)(0.5 * x);
+	const VD t = 2.0 * r + 0x1.8p52;
+	*q = (VL) t;
+
+	const VD s = r - 0.5 * (t - 0x1.8p52);
+	VD plo;
+	const VD hi = KFN(two_prod)(s, KFN(splat)(PI_HI), &plo);
+	*lo = plo + s * PI_LO;
+	return hi;
+}
+
+KATTR static inline VD KFN(sinpi)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trigpi_reduce)(x, &q, &lo);
+	const VL odd = -(q & 1);
+
+	VD res = KFN(sel)(odd, KFN(cos_poly)(r, lo), KFN(sin_poly)(r, lo));
+	res = KFN(neg_if)(res, (VL) ((VU) (q & 2) << 62));
+
+	// sinpi(n) is zero with the sign of n
+	return KFN(sel)((VL) (res == 0.0), KFN(copysign)(KFN(splat)(0.0), x), res);
+}
+
+KATTR static inline VD KFN(cospi)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trigpi_reduce)(x, &q, &lo);
+	const VL odd = -(q & 1);
+
+	VD res = KFN(sel)(odd, KFN(sin_poly)(r, lo), KFN(cos_poly)(r, lo));
+	res = KFN(neg_if)(res, (VL) ((VU) ((q + 1) & 2) << 62));
+
+	// cospi(n + 1/2) is +0
+	return res + 0.0;
+}
+
+KATTR static inline VD KFN(tanpi)(VD x)
+{
+	VL q;
+	VD lo;
+	const VD r = KFN(trigpi_reduce)(x, &q, &lo);
+	const VL odd = -(q & 1);
+
+	VD res = KFN(tan_poly)(r, lo, odd);
+
+	// like sinpi(x)/cospi(x): +-inf at n + 1/2 for even and odd n, and a zero at n with the
+	// sign of x flipped for odd n
+	const VL flip = (VL) ((VU) (q & 2) << 62);
+	const VL pole = odd & (VL) (r == 0.0);
+	res = KFN(sel)(pole, KFN(neg_if)(KFN(splat)(INFINITY), flip), res);
+	return KFN(sel)((VL) (res == 0.0), KFN(neg_if)(KFN(copysign)(KFN(splat)(0.0), x), flip), res);
+}
+
+// atan, atan2, asin, acos
+
+// atan(x) for x >= 0, from Cephes
+KATTR static inline VD KFN(atan_pos)(VD x)
+{
+	const VL big = (VL) (x > T3P8);
+	const VL mid = ~big & (VL) (x > 0.66);
+
+	// x, (x-1)/(x+1) or -1/x
+	const VD num = KFN(sel)(big, KFN(splat)(-1.0), KFN(sel)(mid, x - 1.0, x));
+	const VD den = KFN(sel)(big, x, KFN(sel)(mid, x + 1.0, KFN(splat)(1.0)));
+	const VD xr = num / den;
+	const VD y0 = KFN(sel)(big, KFN(splat)(M_PI_2), KFN(sel)(mid, KFN(splat)(M_PI_4), KFN(splat)(0.0)));
+	const VD corr = KFN(sel)(big, KFN(splat)(MOREBITS), KFN(sel)(mid, KFN(splat)(0.5 * MOREBITS), KFN(splat)(0.0)));
+
+	const VD z = xr * xr;
+	const VD p = (((ATAN_P0 * z + ATAN_P1) * z + ATAN_P2) * z + ATAN_P3) * z + ATAN_P4;
+	const VD qq = ((((z + ATAN_Q0) * z + ATAN_Q1) * z + ATAN_Q2) * z + ATAN_Q3) * z + ATAN_Q4;
+	return y0 + ((xr * (z * p / qq) + xr) + corr);
+}
+
+KATTR static inline VD KFN(atan)(VD x)
+{
+	return KFN(copysign)(KFN(atan_pos)(KFN(fabs)(x)), x);
+}
+
+KATTR static inline VD KFN(atan2)(VD y, VD x)
+{
+	const VD ax = KFN(fabs)(x), ay = KFN(fabs)(y);
+	const VL swap = (VL) (ay > ax);
+	const VD mn = KFN(sel)(swap, ax, ay), mx = KFN(sel)(swap, ay, ax);
+
+	// 0/0 and inf/inf
+	VD t = mn / mx;
+	t = KFN(sel)((VL) (mx == 0.0), KFN(splat)(0.0), t);
+	t = KFN(sel)((VL) (mn == INFINITY), KFN(splat)(1.0), t);
+
+	VD a = KFN(atan_pos)(t);
+	a = KFN(sel)(swap, (PIO2_HI - a) + PIO2_LO, a);
+	a = KFN(sel)((VL) x < 0, (PI_HI - a) + PI_LO, a);
+	a = KFN(copysign)(a, y);
+
+	const VL nan = (VL) (x != x) | (VL) (y != y);
+	return KFN(sel)(nan, x + y, a);
+}
+
+KATTR static inline VD KFN(asin)(VD x)
+{
+	return KFN(atan2)(x, KSQRT((1.0 - x) * (1.0 + x)));
+}
+
+KATTR static inline VD KFN(acos)(VD x)
+{
+	return KFN(atan2)(KSQRT((1.0 - x) * (1.0 + x)), x);
+}
+
+// hyperbolic functions
+
+KATTR static inline VD KFN(sinh)(VD x)
+{
+	const VD a = KFN(fabs)(x);
+	const VD ac = KFN(sel)((VL) (a > 712.0), KFN(splat)(712.0), a);
+
+	VL k;
+	VD lo, tl;
+	const VD hi = KFN(exp_reduce)(ac, KFN(splat)(0.0), &k, &lo);
+
+	// (t + t/(t+1))/2 with t = e^a - 1 in double-double up to 22, e^a/2 above
+	const VD th = KFN(expm1_parts_dd)(hi, lo, k, &tl);
+	const VD w = th + 1.0;
+	VD res = th + (th / w + tl * (1.0 + 1.0 / (w * w)));
+	res = KFN(sel)((VL) (a < 22.0), 0.5 * res, KFN(scale)(1.0 + (hi + lo), k - 1));
+	return KFN(copysign)(res, x);
+}
+
+KATTR static inline VD KFN(cosh)(VD x)
+{
+	const VD a = KFN(fabs)(x);
+	const VD ac = KFN(sel)((VL) (a > 712.0), KFN(splat)(712.0), a);
+
+	VL k;
+	VD lo;
+	const VD hi = KFN(exp_reduce)(ac, KFN(splat)(0.0), &k, &lo);
+
+	// (e^a + 1/e^a)/2, or e^a/2 from 22 on
+	const VD e = KFN(scale)(1.0 + (hi + lo), k);
+	const VD big = KFN(scale)(1.0 + (hi + lo), k - 1);
+	return KFN(sel)((VL) (a < 22.0), 0.5 * e + 0.5 / e, big);
+}
+
+KATTR static inline VD KFN(tanh)(VD x)
+{
+	const VD a = KFN(fabs)(x);
+	const VL small = (VL) (a < 0.55);
+	const VD ac = KFN(sel)(small, -2.0 * a, KFN(sel)((VL) (a > 22.0), KFN(splat)(44.0), 2.0 * a));
+
+	VL k;
+	VD lo, tl;
+	const VD hi = KFN(exp_reduce)(ac, KFN(splat)(0.0), &k, &lo);
+	const VD th = KFN(expm1_parts_dd)(hi, lo, k, &tl);
+
+	// -t/(t+2) with t = e^(-2a) - 1 for small a, 1 - 2/(t+2) with t = e^(2a) - 1 otherwise.
+	// The quotient is taken in double-double, the rounding of t costs a few ulps otherwise.
+	const VD nh = KFN(sel)(small, -th, KFN(splat)(2.0));
+	const VD nl = KFN(sel)(small, -tl, KFN(splat)(0.0));
+	const VD dh = 2.0 + th;
+	const VD dl = ((2.0 - dh) + th) + tl;
+
+	VD pl;
+	const VD q0 = nh / dh;
+	const VD ph = KFN(two_prod)(q0, dh, &pl);
+	const VD q = q0 + (((nh - ph) - pl) + nl - q0 * dl) / dh;
+
+	VD res = KFN(sel)(small, q, 1.0 - q);
+	res = KFN(sel)((VL) (a > 22.0), KFN(splat)(1.0), res);
+	return KFN(copysign)(res, x);
+}
+
+KATTR static inline VD KFN(asinh)(VD x)
+{
+	const VD a = KFN(fabs)(x);
+	const VL huge = (VL) (a > 0x1p28);
+	const VL big = (VL) (a >= 2.0);
+	const VD s = KSQRT(a * a + 1.0);
+
+	// log(2a) for huge a, log(2a + 1/(s+a)) for big a, log1p(a + a^2/(1+s)) otherwise
+	VD u = a + a * a / (1.0 + s);
+	u = KFN(sel)(big, 2.0 * a + 1.0 / (s + a) - 1.0, u);
+	u = KFN(sel)(huge, a - 1.0, u);
+
+	const VD res = KFN(log1p)(u) + KFN(sel)(huge, KFN(splat)(M_LN2), KFN(splat)(0.0));
+	return KFN(copysign)(res, x);
+}
+
+KATTR static inline VD KFN(acosh)(VD x)
+{
+	const VL huge = (VL) (x > 0x1p28);
+	const VL big = (VL) (x >= 2.0);
+	const VD t = x - 1.0;
+
+	// log(2x) for huge x, log(2x - 1/(x + sqrt(x^2-1))) for big x, log1p(t + sqrt(2t + t^2))
+	// otherwise
+	VD u = t + KSQRT(2.0 * t + t * t);
+	u = KFN(sel)(big, 2.0 * x - 1.0 / (x + KSQRT(x * x - 1.0)) - 1.0, u);
+	u = KFN(sel)(huge, t, u);
+
+	const VD res = KFN(log1p)(u) + KFN(sel)(huge, KFN(splat)(M_LN2), KFN(splat)(0.0));
+	return KFN(sel)((VL) (x < 1.0), KFN(splat)(NAN), res);
+}
+
+KATTR static inline VD KFN(atanh)(VD x)
+{
+	const VD a = KFN(fabs)(x);
+
+	// log1p(2a + 2a^2/(1-a))/2 for small a, log1p(2a/(1-a))/2 otherwise
+	const VD u = KFN(sel)((VL) (a < 0.5), 2.0 * a + 2.0 * a * a / (1.0 - a), 2.0 * a / (1.0 - a));
+	const VD res = 0.5 * KFN(log1p)(u);
+	return KFN(copysign)(res, x);
+}
+
+// rounding and arithmetic
+
+KATTR static inline VD KFN(nint)(VD x)
+{
+	return KFN(rint)(x);
+}
+
+KATTR static inline VD KFN(int)(VD x)
+{
+	const VD ax = KFN(fabs)(x);
+	const VD r = KFN(rint)(ax);
+	return KFN(copysign)(KFN(sel)((VL) (r > ax), r - 1.0, r), x);
+}
+
+KATTR static inline VD KFN(floor)(VD x)
+{
+	const VD r = KFN(rint)(x);
+	return KFN(sel)((VL) (r > x), r - 1.0, r);
+}
+
+KATTR static inline VD KFN(ceil)(VD x)
+{
+	const VD r = KFN(rint)(x);
+	return KFN(sel)((VL) (r < x), r + 1.0, r);
+}
+
+KATTR static inline VD KFN(sqrt)(VD x)
+{
+	return KSQRT(x);
+}
+
+KATTR static inline VD KFN(rsqrt)(VD x)
+{
+	return 1.0 / KSQRT(x);
+}
+
+KATTR static inline VD KFN(rec)(VD x)
+{
+	return 1.0 / x;
+}
+
+KATTR static inline VD KFN(div)(VD y, VD x)
+{
+	return y / x;
+}
+
+// Array drivers. The tail goes through a padded buffer, and every block is read
+// completely before it's written so that the arrays may be the same.
+
+#define KFN_ARRAY1(name) \
+	KATTR static void KFN(name##_d)(double* y, const double* x, int n) \
+	{ \
+		int i = 0; \
+		for (; i + VW <= n; i += VW) \
+			KFN(store)(y + i, KFN(name)(KFN(load)(x + i))); \
+		if (i < n) \
+		{ \
+			double in[VW] = { 0 }, out[VW]; \
+			memcpy(in, x + i, (n - i) * sizeof(double)); \
+			KFN(store)(out, KFN(name)(KFN(load)(in))); \
+			memcpy(y + i, out, (n - i) * sizeof(double)); \
+		} \
+	} \
+	KATTR static void KFN(name##_f)(float* y, const float* x, int n) \
+	{ \
+		int i = 0; \
+		for (; i + VW <= n; i += VW) \
+			KFN(storef)(y + i, KFN(name)(KFN(loadf)(x + i))); \
+		if (i < n) \
+		{ \
+			float in[VW] = { 0 }, out[VW]; \
+			memcpy(in, x + i, (n - i) * sizeof(float)); \
+			KFN(storef)(out, KFN(name)(KFN(loadf)(in))); \
+			memcpy(y + i, out, (n - i) * sizeof(float)); \
+		} \
+	}
+
+// z = f(y, x); with a scalar y if ys is 0
+#define KFN_ARRAY2(name) \
+	KATTR static void KFN(name##_d)(double* z, const double* y, int ys, const double* x, int n) \
+	{ \
+		int i = 0; \
+		for (; i + VW <= n; i += VW) \
+		{ \
+			const VD vy = ys ? KFN(load)(y + i) : KFN(splat)(*y); \
+			KFN(store)(z + i, KFN(name)(vy, KFN(load)(x + i))); \
+		} \
+		if (i < n) \
+		{ \
+			double iny[VW] = { 0 }, inx[VW] = { 0 }, out[VW]; \
+			for (int l = 0; l < n - i; l++) \
+			{ \
+				iny[l] = y[ys * (i + l)]; \
+				inx[l] = x[i + l]; \
+			} \
+			KFN(store)(out, KFN(name)(KFN(load)(iny), KFN(load)(inx))); \
+			memcpy(z + i, out, (n - i) * sizeof(double)); \
+		} \
+	} \
+	KATTR static void KFN(name##_f)(float* z, const float* y, int ys, const float* x, int n) \
+	{ \
+		int i = 0; \
+		for (; i + VW <= n; i += VW) \
+		{ \
+			const VD vy = ys ? KFN(loadf)(y + i) : KFN(splat)(*y); \
+			KFN(storef)(z + i, KFN(name)(vy, KFN(loadf)(x + i))); \
+		} \
+		if (i < n) \
+		{ \
+			float iny[VW] = { 0 }, inx[VW] = { 0 }, out[VW]; \
+			for (int l = 0; l < n - i; l++) \
+			{ \
+				iny[l] = y[ys * (i + l)]; \
+				inx[l] = x[i + l]; \
+			} \
+			KFN(storef)(out, KFN(name)(KFN(loadf)(iny), KFN(loadf)(inx))); \
+			memcpy(z + i, out, (n - i) * sizeof(float)); \
+		} \
+	}
+
+KFN_ARRAY1(exp)
+KFN_ARRAY1(exp2)
+KFN_ARRAY1(expm1)
+KFN_ARRAY1(log)
+KFN_ARRAY1(log2)
+KFN_ARRAY1(log10)
+KFN_ARRAY1(log1p)
+KFN_ARRAY1(logb)
+KFN_ARRAY1(sin)
+KFN_ARRAY1(cos)
+KFN_ARRAY1(tan)
+KFN_ARRAY1(sinpi)
+KFN_ARRAY1(cospi)
+KFN_ARRAY1(tanpi)
+KFN_ARRAY1(asin)
+KFN_ARRAY1(acos)
+KFN_ARRAY1(atan)
+KFN_ARRAY1(sinh)
+KFN_ARRAY1(cosh)
+KFN_ARRAY1(tanh)
+KFN_ARRAY1(asinh)
+KFN_ARRAY1(acosh)
+KFN_ARRAY1(atanh)
+KFN_ARRAY1(nint)
+KFN_ARRAY1(int)
+KFN_ARRAY1(floor)
+KFN_ARRAY1(ceil)
+KFN_ARRAY1(sqrt)
+KFN_ARRAY1(rsqrt)
+KFN_ARRAY1(rec)
+KFN_ARRAY1(fabs)
+
+// pow(x, y) takes its arguments the other way around
+KATTR static inline VD KFN(pow_yx)(VD y, VD x)
+{
+	return KFN(pow)(x, y);
+}
+
+KFN_ARRAY2(pow_yx)
+KFN_ARRAY2(atan2)
+KFN_ARRAY2(div)
+KFN_ARRAY2(copysign)
+
+// sin to s, cos to c; or interleaved cos and sin to c if s is NULL
+#define KFN_SINCOS(suffix, REAL, LOAD) \
+	KATTR static void KFN(sincos##suffix)(REAL* s, REAL* c, const REAL* x, int n) \
+	{ \
+		for (int i = 0; i < n; i += VW) \
+		{ \
+			const int len = (n - i < VW) ? n - i : VW; \
+			REAL in[VW] = { 0 }; \
+			VD vs, vc; \
+			memcpy(in, x + i, len * sizeof(REAL)); \
+			KFN(sincos)(LOAD(in), &vs, &vc); \
+			for (int l = 0; l < len; l++) \
+			{ \
+				if (s) \
+				{ \
+					s[i + l] = vs[l]; \
+					c[i + l] = vc[l]; \
+				} \
+				else \
+				{ \
+					c[2 * (i + l)] = vc[l]; \
+					c[2 * (i + l) + 1] = vs[l]; \
+				} \
+			} \
+		} \
+	}
+
+KFN_SINCOS(_d, double, KFN(load))
+KFN_SINCOS(_f, float, KFN(loadf))
+
+#undef VD
+#undef VL
+#undef VU
+#undef VF
+#undef KFN_FIXUP
+#undef KFN_ARRAY1
+#undef KFN_ARRAY2
+#undef KFN_SINCOS
@@ -34,7 +34,9 @@ FSEventStreamRef FSEventStreamCreate(
 	return (FSEventStreamRef) [[FSEventsImpl alloc] initWithPaths: (NSArray*)pathsToWatch
 									flags: flags
 									context: context
-									callback: callback];
+									callback: callback
+									sinceWhen: sinceWhen
+									latency: latency];
 }
 
 extern FSEventStreamRef FSEventStreamCreateRelativeToDevice(
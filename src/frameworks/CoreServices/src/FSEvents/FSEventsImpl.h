@@ -28,28 +28,45 @@
 @interface FSEventsImpl : NSObject
 {
 	NSArray<NSString*>* _pathsToWatch;
-	NSDictionary<NSNumber*, NSString*>* _wdMap;
+	// every watched directory (including the subdirectories of the watched paths), by watch descriptor
+	NSMutableDictionary<NSNumber*, NSString*>* _wdMap;
 
 	FSEventStreamCreateFlags _flags;
 	FSEventStreamContext _context;
 	FSEventStreamCallback _callback;
+	CFTimeInterval _latency;
+	FSEventStreamEventId _sinceWhen;
+	// events come from fseventsd (and `_fd` is our connection to it) rather than from our own inotify instance
+	bool _usesDaemon;
+	bool _started;
 	dispatch_source_t _source;
+	// fires `_latency` after the first event of a batch
+	dispatch_source_t _flushTimer;
 	dispatch_queue_t _queue;
 	CFMutableBagRef _runloops;
 	CFRunLoopSourceRef _rlSource;
 	int _fd;
 	FSEventStreamEventId _lastEventID;
 	bool _running;
+	void* _readBuffer;
 
+	// the pending batch; paths that show up again within the latency window are merged into their existing entry
 	NSMutableArray* _pathArray;
+	NSMutableDictionary<NSString*, NSNumber*>* _pathIndex;
 	FSEventStreamEventFlags* _flagArray;
 	FSEventStreamEventId* _idArray;
+	size_t _eventCapacity;
+	// a delivery of the pending batch has been scheduled (either the timer is armed or the callback is on its way)
+	bool _flushScheduled;
+	CFAbsoluteTime _lastDelivery;
 }
 
 -(instancetype)initWithPaths:(NSArray*)pathsToWatch
 						flags:(FSEventStreamCreateFlags)flags
 					context:(FSEventStreamContext*)context
-					callback:(FSEventStreamCallback)callback;
+					callback:(FSEventStreamCallback)callback
+					sinceWhen:(FSEventStreamEventId)sinceWhen
+					latency:(CFTimeInterval)latency;
 -(NSArray*)copyPathsToWatch;
 
 -(void)setDispatchQueue:(dispatch_queue_t)queue;
@@ -19,11 +19,26 @@
 
 #import "FSEventsImpl.h"
 #import <Foundation/NSDictionary.h>
+#include <CoreFoundation/CFDate.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <string.h>
+#include <fts.h>
+#include <limits.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <ext/sys/inotify.h>
+#include "fseventsd.h"
+
+#define WATCH_MASK (IN_ATTRIB | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE)
+// the directories below the watched paths
+#define SUBDIR_WATCH_MASK (WATCH_MASK | IN_ONLYDIR | IN_DONT_FOLLOW)
+
+// enough for a few hundred events per read()
+#define READ_BUFFER_SIZE (64 * 1024)
 
 static dispatch_queue_t g_fsEventsQueue = NULL;
 
@@ -33,17 +48,72 @@ static void rlPerform(void* info)
 	[fse _doCallback];
 }
 
+static NSString* stripTrailingSlashes(NSString* path)
+{
+	while ([path length] > 1 && [path hasSuffix: @"/"])
+		path = [path substringToIndex: [path length] - 1];
+	return path;
+}
+
+// connects to fseventsd and subscribes to `paths`; returns -1 if fseventsd isn't running
+static int connectToDaemon(NSArray<NSString*>* paths)
+{
+	struct sockaddr_un sa = { .sun_family = AF_UNIX };
+	fseventsd_monitor_t cmd;
+
+	strcpy(sa.sun_path, FSEVENTSD_SOCKET_PATH);
+
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+	if (fd == -1)
+		return -1;
+
+	if (connect(fd, (const struct sockaddr*) &sa, sizeof(sa)) == -1)
+		goto fail;
+
+	for (NSString* path in paths)
+	{
+		// fseventsd reports canonical paths
+		char resolved[PATH_MAX];
+		const char* cpath = realpath([path UTF8String], resolved) ? resolved : [stripTrailingSlashes(path) UTF8String];
+
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.command = FSEVENTSD_CMD_WATCH;
+		strlcpy(cmd.path, cpath, sizeof(cmd.path));
+
+		if (send(fd, &cmd, sizeof(cmd), 0) != sizeof(cmd))
+			goto fail;
+	}
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	fcntl(fd, F_SETFD, FD_CLOEXEC);
+	return fd;
+
+fail:
+	close(fd);
+	return -1;
+}
+
 @implementation FSEventsImpl
 
 -(instancetype)initWithPaths:(NSArray*)pathsToWatch
 					flags:(FSEventStreamCreateFlags)flags
 					context:(FSEventStreamContext*)context
 					callback:(FSEventStreamCallback)callback
+					sinceWhen:(FSEventStreamEventId)sinceWhen
+					latency:(CFTimeInterval)latency
 {
 	_pathsToWatch = [[NSArray alloc] initWithArray:pathsToWatch];
 	_flags = flags;
 	_callback = callback;
-	_fd = inotify_init1(IN_NONBLOCK);
+	_latency = (latency > 0) ? latency : 0;
+	_sinceWhen = sinceWhen;
+
+	// fseventsd sees every change in the system and keeps a journal of them, so it's the preferred source;
+	// without it, we watch the paths ourselves (and can't replay anything that happened before)
+	_fd = connectToDaemon(_pathsToWatch);
+	_usesDaemon = _fd != -1;
+	if (!_usesDaemon)
+		_fd = inotify_init1(IN_NONBLOCK);
 
 	if (_fd == -1)
 	{
@@ -63,16 +133,16 @@ static void rlPerform(void* info)
 	rlcontext.perform = rlPerform;
 
 	_rlSource = CFRunLoopSourceCreate(NULL, 0, &rlcontext);
-	NSMutableDictionary* wdmap = [[NSMutableDictionary alloc] initWithCapacity: [_pathsToWatch count]];
 
-	for (NSString* path in _pathsToWatch)
+	_pathArray = [[NSMutableArray alloc] init];
+	_pathIndex = [[NSMutableDictionary alloc] init];
+	_wdMap = [[NSMutableDictionary alloc] initWithCapacity: [_pathsToWatch count]];
+
+	if (!_usesDaemon)
 	{
-		int wd = inotify_add_watch(_fd, [path UTF8String], IN_ATTRIB | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE);
-		[wdmap setObject: path
-				forKey: [NSNumber numberWithInt: wd]];
+		for (NSString* path in _pathsToWatch)
+			[self _watchTree: stripTrailingSlashes(path) report: NO];
 	}
-	_wdMap = [[NSDictionary alloc] initWithDictionary: wdmap];
-	[wdmap release];
 
 	static dispatch_once_t once;
 	dispatch_once(&once, ^{
@@ -84,7 +154,13 @@ static void rlPerform(void* info)
 		[self _readEvents];
 	});
 
-	_pathArray = [[NSMutableArray alloc] init];
+	_flushTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, g_fsEventsQueue);
+	dispatch_source_set_timer(_flushTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+	dispatch_source_set_event_handler(_flushTimer, ^{
+		[self _dispatchEvents];
+	});
+	dispatch_resume(_flushTimer);
+
 	_runloops = CFBagCreateMutable(NULL, 0, &kCFTypeBagCallBacks);
 
 	return self;
@@ -100,6 +176,11 @@ static void rlPerform(void* info)
 		dispatch_suspend(_source);
 		dispatch_release(_source);
 	}
+	if (_flushTimer)
+	{
+		dispatch_source_cancel(_flushTimer);
+		dispatch_release(_flushTimer);
+	}
 	if (_rlSource)
 		CFRelease(_rlSource);
 	if (_runloops)
@@ -112,9 +193,11 @@ static void rlPerform(void* info)
 
 	[_pathsToWatch release];
 	[_pathArray release];
+	[_pathIndex release];
 	[_wdMap release];
 	free(_flagArray);
 	free(_idArray);
+	free(_readBuffer);
 	[super dealloc];
 }
 
@@ -165,6 +248,29 @@ static void rlPerform(void* info)
 
 -(void)start
 {
+	if (!_started)
+	{
+		_started = TRUE;
+
+		if (_usesDaemon)
+		{
+			fseventsd_monitor_t cmd;
+
+			memset(&cmd, 0, sizeof(cmd));
+			cmd.command = FSEVENTSD_CMD_START;
+			cmd.since_when = _sinceWhen;
+			send(_fd, &cmd, sizeof(cmd), 0);
+		}
+		else if (_sinceWhen != kFSEventStreamEventIdSinceNow)
+		{
+			// there's no history to replay without fseventsd
+			dispatch_async(g_fsEventsQueue, ^{
+				[self _queuePath: @"" flags: kFSEventStreamEventFlagHistoryDone eventID: _lastEventID];
+				[self _scheduleFlush];
+			});
+		}
+	}
+
 	if (!_running)
 	{
 		dispatch_resume(_source);
@@ -186,14 +292,100 @@ static void rlPerform(void* info)
 	return _lastEventID;
 }
 
+// Watches `path` and every directory below it.
+// With `report`, everything below `path` is reported as created: that's used for new directories,
+// whose contents may have been created before we got to add a watch for them.
+-(void)_watchTree:(NSString*)path
+			report:(BOOL)report
+{
+	char* paths[] = { (char*) [path UTF8String], NULL };
+	FTS* fts = fts_open(paths, FTS_PHYSICAL | FTS_COMFOLLOW | FTS_NOCHDIR, NULL);
+	FTSENT* ent;
+
+	if (!fts)
+		return;
+
+	while ((ent = fts_read(fts)) != NULL)
+	{
+		const bool isRoot = ent->fts_level == FTS_ROOTLEVEL;
+		FSEventStreamEventFlags flags = kFSEventStreamEventFlagItemCreated;
+
+		switch (ent->fts_info)
+		{
+			case FTS_D:
+				flags |= kFSEventStreamEventFlagItemIsDir;
+				break;
+			case FTS_F:
+				flags |= kFSEventStreamEventFlagItemIsFile;
+				break;
+			case FTS_SL:
+			case FTS_SLNONE:
+				flags |= kFSEventStreamEventFlagItemIsSymlink;
+				break;
+			default:
+				// postorder visits, cycles and entries we can't read
+				continue;
+		}
+
+		NSString* entPath = isRoot ? path : [NSString stringWithUTF8String: ent->fts_path];
+
+		if (ent->fts_info == FTS_D || (isRoot && !report))
+		{
+			// the watched paths themselves may also be files
+			int wd = inotify_add_watch(_fd, ent->fts_path, (isRoot && !report) ? WATCH_MASK : SUBDIR_WATCH_MASK);
+			if (wd != -1)
+			{
+				// a directory that was moved within the tree keeps its watch descriptor; this updates its path
+				[_wdMap setObject: entPath
+						forKey: [NSNumber numberWithInt: wd]];
+			}
+			else if (!isRoot)
+			{
+				// most likely out of watches; let the client know it has to look for itself
+				[self _queuePath: entPath flags: kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped];
+				fts_set(fts, ent, FTS_SKIP);
+			}
+		}
+
+		if (!report)
+			continue;
+
+		if (_flags & kFSEventStreamCreateFlagFileEvents)
+		{
+			if (!isRoot)
+				[self _queuePath: entPath flags: flags];
+		}
+		else if (ent->fts_info == FTS_D)
+		{
+			// without file events, changes are reported on the directory that contains them
+			[self _queuePath: entPath flags: kFSEventStreamEventFlagNone];
+		}
+	}
+
+	fts_close(fts);
+}
+
 -(void)_readEvents
 {
-	const size_t bytes = sizeof(struct inotify_event) + 4096 + 1;
-	struct inotify_event* evt = (struct inotify_event*) malloc(bytes);
+	if (_usesDaemon)
+	{
+		[self _readDaemonEvents];
+		return;
+	}
+
+	if (!_readBuffer)
+	{
+		_readBuffer = malloc(READ_BUFFER_SIZE);
+		if (!_readBuffer)
+		{
+			[self stop];
+			return;
+		}
+	}
 
 	while (1)
 	{
-		int rd = read(_fd, evt, bytes);
+		ssize_t rd = read(_fd, _readBuffer, READ_BUFFER_SIZE);
 		if (rd < 0)
 		{
 			if (errno == EINTR)
@@ -206,14 +398,72 @@ static void rlPerform(void* info)
 				break;
 			}
 		}
+		else if (rd == 0)
+		{
+			break;
+		}
 		else
 		{
-			[self _processSingleEvent: evt];
+			@autoreleasepool
+			{
+				for (char* p = (char*) _readBuffer; p < (char*) _readBuffer + rd; )
+				{
+					struct inotify_event* evt = (struct inotify_event*) p;
+					[self _processSingleEvent: evt];
+					p += sizeof(struct inotify_event) + evt->len;
+				}
+			}
 		}
 	}
 
-	free(evt);
-	[self _dispatchEvents];
+	if ([_pathArray count] > 0)
+		[self _scheduleFlush];
+}
+
+-(void)_readDaemonEvents
+{
+	fseventsd_event_t evt;
+
+	while (1)
+	{
+		ssize_t rd = recv(_fd, &evt, sizeof(evt), 0);
+		if (rd < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			else if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+		}
+		if (rd < (ssize_t) offsetof(fseventsd_event_t, path))
+		{
+			// fseventsd is gone; whatever happens from now on, the client won't hear about it
+			for (NSString* path in _pathsToWatch)
+				[self _queuePath: stripTrailingSlashes(path) flags: kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped eventID: _lastEventID];
+			[self stop];
+			break;
+		}
+
+		@autoreleasepool
+		{
+			NSString* path = [[[NSString alloc] initWithBytes: evt.path
+													length: evt.path_length
+												encoding: NSUTF8StringEncoding] autorelease];
+			FSEventStreamEventFlags flags = evt.flags;
+
+			if (!(_flags & kFSEventStreamCreateFlagFileEvents) && !(flags & kFSEventStreamEventFlagHistoryDone))
+			{
+				// without file events, changes are reported on the directory that contains them
+				if (!(flags & kFSEventStreamEventFlagItemIsDir) && [path length] > 1)
+					path = [path stringByDeletingLastPathComponent];
+				flags &= kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped | kFSEventStreamEventFlagKernelDropped;
+			}
+
+			[self _queuePath: path flags: flags eventID: evt.id];
+		}
+	}
+
+	if ([_pathArray count] > 0)
+		[self _scheduleFlush];
 }
 
 -(void)_processSingleEvent:(struct inotify_event*)evt
@@ -221,10 +471,28 @@ static void rlPerform(void* info)
 	FSEventStreamEventFlags flags = 0;
 	NSString* fullPath;
 
-	NSString* watchPath = [_wdMap objectForKey: [NSNumber numberWithInt: evt->wd]];
+	if (evt->mask & IN_Q_OVERFLOW)
+	{
+		// events were lost; all we can do is to tell the client to rescan everything
+		for (NSString* path in _pathsToWatch)
+			[self _queuePath: stripTrailingSlashes(path) flags: kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagKernelDropped];
+		return;
+	}
+
+	NSNumber* wdKey = [NSNumber numberWithInt: evt->wd];
+	NSString* watchPath = [_wdMap objectForKey: wdKey];
 	if (!watchPath)
 		return;
 
+	if (evt->mask & IN_IGNORED)
+	{
+		// the directory is gone (IN_DELETE_SELF has already been reported)
+		[_wdMap removeObjectForKey: wdKey];
+		return;
+	}
+
+	NSString* itemPath = (evt->len == 0) ? watchPath : [NSString stringWithFormat: @"%@/%s", watchPath, evt->name];
+
 	if (!(_flags & kFSEventStreamCreateFlagFileEvents))
 	{
 		fullPath = watchPath;
@@ -247,20 +515,69 @@ static void rlPerform(void* info)
 		if (evt->mask & IN_ATTRIB)
 			flags |= kFSEventStreamEventFlagItemChangeOwner | kFSEventStreamEventFlagItemXattrMod;
 
-		if (evt->len == 0)
-			fullPath = watchPath;
-		else
-			fullPath = [NSString stringWithFormat: @"%s/%s", [watchPath UTF8String], evt->name];
+		fullPath = itemPath;
 	}
 
-	[_pathArray addObject: fullPath];
-	const int newCount = [_pathArray count];
+	[self _queuePath: fullPath flags: flags];
 
-	_flagArray = (FSEventStreamEventFlags*) realloc(_flagArray, sizeof(*_flagArray) * newCount);
-	_flagArray[newCount-1] = flags;
+	// new directories need watches of their own
+	if ((evt->mask & IN_ISDIR) && (evt->mask & (IN_CREATE | IN_MOVED_TO)))
+		[self _watchTree: itemPath report: (evt->mask & IN_CREATE) != 0];
+}
 
-	_idArray = (FSEventStreamEventId*) realloc(_idArray, sizeof(*_idArray) * newCount);
-	_idArray[newCount-1] = ++_lastEventID;
+-(void)_queuePath:(NSString*)path
+			flags:(FSEventStreamEventFlags)flags
+{
+	[self _queuePath: path flags: flags eventID: _lastEventID + 1];
+}
+
+// adds an event to the pending batch, or merges it into the pending event for the same path
+-(void)_queuePath:(NSString*)path
+			flags:(FSEventStreamEventFlags)flags
+			eventID:(FSEventStreamEventId)eventID
+{
+	NSNumber* index = [_pathIndex objectForKey: path];
+	if (index != nil)
+	{
+		_flagArray[[index unsignedLongValue]] |= flags;
+		return;
+	}
+
+	const size_t count = [_pathArray count];
+	if (count == _eventCapacity)
+	{
+		_eventCapacity = _eventCapacity ? (_eventCapacity * 2) : 64;
+		_flagArray = (FSEventStreamEventFlags*) realloc(_flagArray, sizeof(*_flagArray) * _eventCapacity);
+		_idArray = (FSEventStreamEventId*) realloc(_idArray, sizeof(*_idArray) * _eventCapacity);
+	}
+
+	[_pathArray addObject: path];
+	[_pathIndex setObject: [NSNumber numberWithUnsignedLong: count]
+				forKey: path];
+
+	_flagArray[count] = flags;
+	_idArray[count] = eventID;
+	if (eventID > _lastEventID)
+		_lastEventID = eventID;
+}
+
+-(void)_scheduleFlush
+{
+	if (_flushScheduled)
+		return;
+	_flushScheduled = true;
+
+	if ((_flags & kFSEventStreamCreateFlagNoDefer) && CFAbsoluteTimeGetCurrent() - _lastDelivery >= _latency)
+	{
+		// the stream has been quiet for longer than the latency, so the first event goes out right away;
+		// anything that follows it is batched as usual
+		[self _dispatchEvents];
+	}
+	else
+	{
+		const uint64_t latencyNsec = (uint64_t) (_latency * NSEC_PER_SEC);
+		dispatch_source_set_timer(_flushTimer, dispatch_time(DISPATCH_TIME_NOW, latencyNsec), DISPATCH_TIME_FOREVER, latencyNsec / 10);
+	}
 }
 
 -(void)_dispatchEvents
@@ -286,62 +603,62 @@ static void rlPerform(void* info)
 
 -(void)_doCallback
 {
-	void* ptrToPass = _pathArray;
-	char** cpathArray = NULL;
-	NSArray<NSDictionary*>* dicts = NULL;
-
 	dispatch_suspend(_source);
 	dispatch_sync(g_fsEventsQueue, ^{});
-	
-	if (!(_flags & kFSEventStreamCreateFlagUseCFTypes))
-	{
-		@autoreleasepool
-		{
-			cpathArray = (char**) malloc(sizeof(char*) * [_pathArray count]);
-			for (int i = 0; i < [_pathArray count]; i++)
-				cpathArray[i] = strdup([[_pathArray objectAtIndex: i] UTF8String]);
-		}
-		ptrToPass = cpathArray;
-	}
-	else if (_flags & kFSEventStreamCreateFlagUseExtendedData)
+
+	const size_t count = [_pathArray count];
+
+	@autoreleasepool
 	{
-		NSDictionary** dd = (NSDictionary**) malloc(sizeof(NSDictionary*) * [_pathArray count]);
+		void* ptrToPass = _pathArray;
+		const char** cpathArray = NULL;
+		NSArray<NSDictionary*>* dicts = NULL;
 
-		for (int i = 0; i < [_pathArray count]; i++)
+		if (!(_flags & kFSEventStreamCreateFlagUseCFTypes))
 		{
-			dd[i] = @{
-				((NSString*) kFSEventStreamEventExtendedDataPathKey) : [_pathArray objectAtIndex: i]
-			};
+			// the strings live until the pool is drained, which is after the callback returns
+			cpathArray = (const char**) malloc(sizeof(char*) * count);
+			for (size_t i = 0; i < count; i++)
+				cpathArray[i] = [[_pathArray objectAtIndex: i] UTF8String];
+			ptrToPass = cpathArray;
 		}
+		else if (_flags & kFSEventStreamCreateFlagUseExtendedData)
+		{
+			NSDictionary** dd = (NSDictionary**) malloc(sizeof(NSDictionary*) * count);
 
-		dicts = [[NSArray alloc] initWithObjects:dd
-										count: [_pathArray count]];
-		free(dd);
-		ptrToPass = dicts;
-	}
-
-	_callback((ConstFSEventStreamRef) self, _context.info,
-		[_pathArray count],
-		ptrToPass,
-		_flagArray, _idArray);
+			for (size_t i = 0; i < count; i++)
+			{
+				dd[i] = @{
+					((NSString*) kFSEventStreamEventExtendedDataPathKey) : [_pathArray objectAtIndex: i]
+				};
+			}
 
-	if (cpathArray != NULL)
-	{
-		for (int i = 0; i < [_pathArray count]; i++)
-			free(cpathArray[i]);
-		free(cpathArray);
-	}
+			dicts = [[NSArray alloc] initWithObjects:dd
+											count: count];
+			free(dd);
+			ptrToPass = dicts;
+		}
 
-	if (dicts)
-		[dicts release];
+		if (count > 0)
+		{
+			_callback((ConstFSEventStreamRef) self, _context.info,
+				count,
+				ptrToPass,
+				_flagArray, _idArray);
+		}
 
-	free(_flagArray);
-	_flagArray = NULL;
+		free(cpathArray);
 
-	free(_idArray);
-	_idArray = NULL;
+		if (dicts)
+			[dicts release];
+	}
 
+	// the flag and ID arrays are kept for the next batch
 	[_pathArray removeAllObjects];
+	[_pathIndex removeAllObjects];
+	_flushScheduled = false;
+	_lastDelivery = CFAbsoluteTimeGetCurrent();
+
 	dispatch_resume(_source);
 	[self release];
 }
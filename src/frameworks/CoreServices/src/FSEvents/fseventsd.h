@@ -20,18 +20,36 @@
 #ifndef FSEVENTSD_H_
 #define FSEVENTSD_H_
 
+#include <stdint.h>
+
 #define FSEVENTSD_SOCKET_PATH "/var/run/fseventsd.sock"
+#define FSEVENTSD_JOURNAL_PATH "/var/db/fseventsd/journal"
+
+// Clients connect to FSEVENTSD_SOCKET_PATH (SOCK_SEQPACKET), send FSEVENTSD_CMD_WATCH for every path they're interested in
+// and then FSEVENTSD_CMD_START. fseventsd replies with one fseventsd_event_t packet per event, starting with the
+// journaled events after `since_when` (followed by an event with kFSEventStreamEventFlagHistoryDone) unless `since_when`
+// is kFSEventStreamEventIdSinceNow.
+//
+// Events are reported per item (the item that was modified, created, removed or renamed).
+
+enum {
+	FSEVENTSD_CMD_WATCH = 1,
+	FSEVENTSD_CMD_START = 2,
+};
 
 typedef struct fseventsd_monitor {
-	int id;
+	uint32_t command;
+	uint32_t flags;
+	uint64_t since_when;
 	char path[4096];
-	int flags;
 } fseventsd_monitor_t;
 
+// only `path_length` bytes of `path` are sent and there's no terminating NUL
 typedef struct fseventsd_event {
-	int id;
+	uint64_t id;
+	uint32_t flags;
+	uint32_t path_length;
 	char path[4096];
-	int flags;
 } fseventsd_event_t;
 
 #endif
@@ -19,26 +19,131 @@
 
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/mount.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <fts.h>
 #include <ext/fanotify.h>
 #include <ext/file_handle.h>
+#include <ext/sys/inotify.h>
 #include "./linux/fanotify.h"
 #include <dispatch/dispatch.h>
 #include <CoreServices/FileManager.h>
+#include <FSEvents/FSEvents.h>
 #import <Foundation/NSObjCRuntime.h>
 #import <Foundation/NSDictionary.h>
+#import <Foundation/NSArray.h>
+#import <Foundation/NSString.h>
+#import <Foundation/NSAutoreleasePool.h>
 #include "fseventsd.h"
 
-int g_listenSocket, g_fanotify;
+// The journal is a ring of records in a file that we keep mapped.
+// Record positions only ever grow; a record lives at (position % capacity) in the ring and never wraps around its end.
+#define JOURNAL_MAGIC 0x4a455346 // "FSEJ"
+#define JOURNAL_VERSION 1
+#define JOURNAL_CAPACITY (32 * 1024 * 1024)
+
+typedef struct journal_header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t capacity;
+	// the ID of the next event
+	uint64_t next_id;
+	// the position of the oldest record and the end of the newest one
+	uint64_t begin;
+	uint64_t end;
+} journal_header_t;
+
+typedef struct journal_record {
+	// 0 for the padding that skips to the start of the ring
+	uint64_t id;
+	uint32_t flags;
+	uint32_t path_length;
+	char path[];
+} journal_record_t;
+
+#define JOURNAL_RECORD_SIZE(path_length) ((sizeof(journal_record_t) + (path_length) + 7) & ~(uint64_t)7)
+
+// how much we hold back for a client that isn't reading (e.g. because it's stopped) before we drop it all and make it rescan
+#define CLIENT_QUEUE_MAX (8 * 1024 * 1024)
+// how many journal records a replay goes through before it lets the other clients have their turn
+#define REPLAY_CHUNK 256
+
+#define FANOTIFY_MASK (FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_MODIFY | FAN_ONDIR)
+// the same events; each of these bits has the same value as its fanotify counterpart
+#define INOTIFY_MASK (IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE | IN_MODIFY)
+
+typedef struct fseventsd_packet {
+	struct fseventsd_packet* next;
+	size_t size;
+	char data[];
+} fseventsd_packet_t;
+
+typedef struct fseventsd_client {
+	struct fseventsd_client* next;
+	int fd;
+	dispatch_source_t source;
+	bool started;
+	// the client is gone; it's removed once we're done with the current batch
+	bool dead;
+	size_t path_count;
+	char** paths;
+
+	// events the socket had no room for, oldest first; `write_source` sends them once it does
+	fseventsd_packet_t* queue_head;
+	fseventsd_packet_t* queue_tail;
+	size_t queued_bytes;
+	dispatch_source_t write_source;
+	// the queue was dropped; once it's caught up, the client is told to rescan its paths
+	bool overflowed;
+
+	// the client is being sent the history; `write_source` goes on with it whenever the socket has room
+	bool replaying;
+	// the position of the next record to replay, and the ID of the last event the client has had (or asked not to get)
+	uint64_t replay_position;
+	uint64_t replay_last_id;
+} fseventsd_client_t;
+
+// a filesystem marked for fanotify; the events only tell us its fsid, but resolving a handle needs a reference to the mount
+typedef struct fseventsd_filesystem {
+	fsid_t fsid;
+	FSRef root;
+} fseventsd_filesystem_t;
+
+// the events of one read, merged by path
+typedef struct fseventsd_batch {
+	NSMutableArray<NSString*>* paths;
+	NSMutableDictionary<NSString*, NSNumber*>* flags;
+} fseventsd_batch_t;
+
+int g_listenSocket, g_fanotify = -1, g_inotify = -1;
+static journal_header_t* g_journal;
+static char* g_journalData;
+static fseventsd_client_t* g_clients;
+static fseventsd_filesystem_t* g_filesystems;
+static size_t g_filesystemCount;
+// inotify fallback: watch descriptor -> directory
+static NSMutableDictionary<NSNumber*, NSString*>* g_inotifyWatches;
+// inotify fallback: watched path -> how many times clients are watching it
+static NSMutableDictionary<NSString*, NSNumber*>* g_inotifyRoots;
 
 void setupListenSocket(void);
 void handleNewConnection(int fd);
 void setupFANotify(void);
+void setupINotify(void);
+void setupJournal(void);
 
 int main()
 {
+	setupJournal();
 	setupListenSocket();
 	setupFANotify();
 
@@ -46,6 +151,385 @@ int main()
 	return 0;
 }
 
+void setupJournal(void)
+{
+	mkdir("/var/db", 0755);
+	mkdir("/var/db/fseventsd", 0755);
+
+	int fd = open(FSEVENTSD_JOURNAL_PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd == -1)
+	{
+		perror("open journal");
+		exit(EXIT_FAILURE);
+	}
+
+	const size_t size = sizeof(journal_header_t) + JOURNAL_CAPACITY;
+	if (ftruncate(fd, size) == -1)
+	{
+		perror("ftruncate journal");
+		exit(EXIT_FAILURE);
+	}
+
+	void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+	{
+		perror("mmap journal");
+		exit(EXIT_FAILURE);
+	}
+	close(fd);
+
+	g_journal = (journal_header_t*) map;
+	g_journalData = (char*) map + sizeof(journal_header_t);
+
+	if (g_journal->magic != JOURNAL_MAGIC || g_journal->version != JOURNAL_VERSION || g_journal->capacity != JOURNAL_CAPACITY
+		|| g_journal->end < g_journal->begin || g_journal->end - g_journal->begin > JOURNAL_CAPACITY || g_journal->next_id == 0)
+	{
+		// new or unusable; start over (event IDs start at 1 so that 0 can be used as "everything")
+		g_journal->magic = JOURNAL_MAGIC;
+		g_journal->version = JOURNAL_VERSION;
+		g_journal->capacity = JOURNAL_CAPACITY;
+		g_journal->next_id = 1;
+		g_journal->begin = g_journal->end = 0;
+	}
+}
+
+// returns NULL for padding
+static journal_record_t* journalRecordAt(uint64_t position, uint64_t* next)
+{
+	const uint64_t offset = position % JOURNAL_CAPACITY;
+	const uint64_t remaining = JOURNAL_CAPACITY - offset;
+
+	if (remaining < sizeof(journal_record_t))
+	{
+		*next = position + remaining;
+		return NULL;
+	}
+
+	journal_record_t* record = (journal_record_t*) (g_journalData + offset);
+	if (record->id == 0)
+	{
+		*next = position + remaining;
+		return NULL;
+	}
+
+	*next = position + JOURNAL_RECORD_SIZE(record->path_length);
+	return record;
+}
+
+// drops the oldest records until `size` more bytes fit
+static void journalReserve(uint64_t size)
+{
+	while (g_journal->end + size - g_journal->begin > JOURNAL_CAPACITY)
+	{
+		uint64_t next;
+		journalRecordAt(g_journal->begin, &next);
+		g_journal->begin = next;
+	}
+}
+
+static uint64_t journalAppend(const char* path, uint32_t pathLength, uint32_t flags)
+{
+	const uint64_t size = JOURNAL_RECORD_SIZE(pathLength);
+	uint64_t offset = g_journal->end % JOURNAL_CAPACITY;
+
+	if (JOURNAL_CAPACITY - offset < size)
+	{
+		const uint64_t padding = JOURNAL_CAPACITY - offset;
+
+		journalReserve(padding);
+		if (padding >= sizeof(journal_record_t))
+			((journal_record_t*) (g_journalData + offset))->id = 0;
+		g_journal->end += padding;
+		offset = 0;
+	}
+
+	journalReserve(size);
+
+	journal_record_t* record = (journal_record_t*) (g_journalData + offset);
+	record->id = g_journal->next_id++;
+	record->flags = flags;
+	record->path_length = pathLength;
+	memcpy(record->path, path, pathLength);
+
+	// the header is updated last, so that a record is only ever visible once it's complete
+	__atomic_store_n(&g_journal->end, g_journal->end + size, __ATOMIC_RELEASE);
+
+	return record->id;
+}
+
+static bool pathIsUnder(const char* path, size_t pathLength, const char* root, size_t rootLength)
+{
+	if (rootLength == 1 && root[0] == '/')
+		return true;
+	if (pathLength < rootLength || memcmp(path, root, rootLength) != 0)
+		return false;
+	return pathLength == rootLength || path[rootLength] == '/';
+}
+
+static void flushClientQueue(fseventsd_client_t* client);
+static void replayJournal(fseventsd_client_t* client);
+static void removeDeadClients(void);
+static void unwatchPath(const char* path);
+
+static void dropClientQueue(fseventsd_client_t* client)
+{
+	while (client->queue_head != NULL)
+	{
+		fseventsd_packet_t* packet = client->queue_head;
+		client->queue_head = packet->next;
+		free(packet);
+	}
+	client->queue_tail = NULL;
+	client->queued_bytes = 0;
+}
+
+// returns false if the client has to be dropped
+static bool sendPacket(fseventsd_client_t* client, const void* data, size_t size, bool* sent)
+{
+	*sent = send(client->fd, data, size, MSG_NOSIGNAL | MSG_DONTWAIT) != -1;
+	return *sent || errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ENOBUFS;
+}
+
+// the source sends the queued events (and goes on with a replay) whenever the socket has room again
+static void startWriteSource(fseventsd_client_t* client)
+{
+	if (client->write_source != NULL)
+		return;
+
+	// a source of its own (on a descriptor of its own, so that it can be cancelled independently of the read source)
+	int fd = dup(client->fd);
+	if (fd == -1)
+	{
+		client->dead = true;
+		return;
+	}
+
+	client->write_source = dispatch_source_create(DISPATCH_SOURCE_TYPE_WRITE, fd, 0, dispatch_get_main_queue());
+	dispatch_source_set_event_handler(client->write_source, ^{
+		flushClientQueue(client);
+		if (client->replaying && client->queue_head == NULL && !client->dead)
+			replayJournal(client);
+		if (client->dead)
+			removeDeadClients();
+	});
+	dispatch_source_set_cancel_handler(client->write_source, ^{
+		close(fd);
+	});
+	dispatch_resume(client->write_source);
+}
+
+static void queuePacket(fseventsd_client_t* client, const void* data, size_t size)
+{
+	if (client->queued_bytes + size > CLIENT_QUEUE_MAX)
+	{
+		dropClientQueue(client);
+		client->overflowed = true;
+	}
+	else
+	{
+		fseventsd_packet_t* packet = (fseventsd_packet_t*) malloc(sizeof(fseventsd_packet_t) + size);
+		if (packet == NULL)
+		{
+			dropClientQueue(client);
+			client->overflowed = true;
+		}
+		else
+		{
+			packet->next = NULL;
+			packet->size = size;
+			memcpy(packet->data, data, size);
+
+			if (client->queue_tail != NULL)
+				client->queue_tail->next = packet;
+			else
+				client->queue_head = packet;
+			client->queue_tail = packet;
+			client->queued_bytes += size;
+		}
+	}
+
+	startWriteSource(client);
+}
+
+static void sendEvent(fseventsd_client_t* client, uint64_t id, uint32_t flags, const char* path, uint32_t pathLength)
+{
+	fseventsd_event_t evt;
+	const size_t size = offsetof(fseventsd_event_t, path) + pathLength;
+	bool sent = false;
+
+	// after an overflow, the client gets to rescan everything anyway (but it still has to know when the history is done)
+	if (client->dead || (client->overflowed && !(flags & kFSEventStreamEventFlagHistoryDone)))
+		return;
+
+	evt.id = id;
+	evt.flags = flags;
+	evt.path_length = pathLength;
+	memcpy(evt.path, path, pathLength);
+
+	// a client that isn't reading (e.g. because it's stopped) mustn't stall everybody else, so events it has no room for are queued
+	if (client->queue_head == NULL && !client->overflowed)
+	{
+		if (!sendPacket(client, &evt, size, &sent))
+		{
+			client->dead = true;
+			return;
+		}
+		if (sent)
+			return;
+	}
+
+	queuePacket(client, &evt, size);
+}
+
+static void flushClientQueue(fseventsd_client_t* client)
+{
+	while (client->queue_head != NULL)
+	{
+		fseventsd_packet_t* packet = client->queue_head;
+		bool sent;
+
+		if (!sendPacket(client, packet->data, packet->size, &sent))
+		{
+			client->dead = true;
+			return;
+		}
+		if (!sent)
+			return;
+
+		client->queue_head = packet->next;
+		if (client->queue_head == NULL)
+			client->queue_tail = NULL;
+		client->queued_bytes -= packet->size;
+		free(packet);
+	}
+
+	if (client->overflowed)
+	{
+		client->overflowed = false;
+
+		for (size_t i = 0; i < client->path_count; i++)
+		{
+			sendEvent(client, g_journal->next_id - 1, kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped,
+				client->paths[i], strlen(client->paths[i]));
+		}
+
+		if (client->queue_head != NULL || client->overflowed)
+			return;
+	}
+
+	// the source is still needed to go on with the history
+	if (client->replaying)
+		return;
+
+	dispatch_source_cancel(client->write_source);
+	dispatch_release(client->write_source);
+	client->write_source = NULL;
+}
+
+// sends an event to a client if it's interested in it
+static void deliverEvent(fseventsd_client_t* client, uint64_t id, uint32_t flags, const char* path, uint32_t pathLength)
+{
+	for (size_t i = 0; i < client->path_count; i++)
+	{
+		const char* root = client->paths[i];
+		const size_t rootLength = strlen(root);
+
+		if (pathIsUnder(path, pathLength, root, rootLength))
+		{
+			sendEvent(client, id, flags, path, pathLength);
+			return;
+		}
+
+		// a rescan of a directory above the watched path means that the watched path has to be rescanned
+		if ((flags & kFSEventStreamEventFlagMustScanSubDirs) && pathIsUnder(root, rootLength, path, pathLength))
+			sendEvent(client, id, flags, root, rootLength);
+	}
+}
+
+static void closeClient(fseventsd_client_t* client)
+{
+	if (client->write_source != NULL)
+	{
+		dispatch_source_cancel(client->write_source);
+		dispatch_release(client->write_source);
+	}
+	dropClientQueue(client);
+
+	dispatch_source_cancel(client->source);
+	dispatch_release(client->source);
+
+	for (size_t i = 0; i < client->path_count; i++)
+	{
+		unwatchPath(client->paths[i]);
+		free(client->paths[i]);
+	}
+	free(client->paths);
+	free(client);
+}
+
+static void removeDeadClients(void)
+{
+	fseventsd_client_t** link = &g_clients;
+
+	while (*link != NULL)
+	{
+		fseventsd_client_t* client = *link;
+		if (client->dead)
+		{
+			*link = client->next;
+			closeClient(client);
+		}
+		else
+			link = &client->next;
+	}
+}
+
+// sends the client the next REPLAY_CHUNK records of the history, or fewer if the socket runs out of room;
+// the client only gets live events once it has caught up with the journal
+static void replayJournal(fseventsd_client_t* client)
+{
+	// records the replay hasn't got to yet may have been overwritten in the meantime; that shows as a gap in the IDs
+	if (client->replay_position < g_journal->begin)
+		client->replay_position = g_journal->begin;
+
+	for (int n = 0; n < REPLAY_CHUNK; n++)
+	{
+		if (client->dead || client->queue_head != NULL)
+			return;
+
+		if (client->replay_position >= g_journal->end)
+		{
+			client->replaying = false;
+			client->started = true;
+			sendEvent(client, g_journal->next_id - 1, kFSEventStreamEventFlagHistoryDone, "", 0);
+			return;
+		}
+
+		uint64_t next;
+		journal_record_t* record = journalRecordAt(client->replay_position, &next);
+		client->replay_position = next;
+
+		if (record == NULL)
+			continue;
+
+		if (record->id > client->replay_last_id + 1)
+		{
+			// the events the client wants are no longer in the journal
+			for (size_t i = 0; i < client->path_count; i++)
+			{
+				sendEvent(client, record->id - 1, kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped,
+					client->paths[i], strlen(client->paths[i]));
+			}
+		}
+
+		if (record->id > client->replay_last_id)
+		{
+			deliverEvent(client, record->id, record->flags, record->path, record->path_length);
+			client->replay_last_id = record->id;
+		}
+	}
+}
+
 void setupListenSocket(void)
 {
 	struct sockaddr_un sa;
@@ -89,106 +573,483 @@ void setupListenSocket(void)
 	dispatch_resume(listenerSource);
 }
 
-void handleClientCommand(int fd, const fseventsd_monitor_t* cmd)
+static void watchPath(const char* path);
+
+void handleClientCommand(fseventsd_client_t* client, const fseventsd_monitor_t* cmd)
 {
+	switch (cmd->command)
+	{
+		case FSEVENTSD_CMD_WATCH:
+		{
+			char** paths = (char**) realloc(client->paths, sizeof(char*) * (client->path_count + 1));
+			if (!paths)
+			{
+				client->dead = true;
+				break;
+			}
+			client->paths = paths;
+			client->paths[client->path_count++] = strndup(cmd->path, sizeof(cmd->path));
+			watchPath(client->paths[client->path_count - 1]);
+			break;
+		}
+		case FSEVENTSD_CMD_START:
+			if (client->started || client->replaying)
+				break;
+			if (cmd->since_when == kFSEventStreamEventIdSinceNow)
+			{
+				client->started = true;
+				break;
+			}
 
+			// the history may be long, so it's sent bit by bit from the write source instead of in one go
+			client->replaying = true;
+			client->replay_position = g_journal->begin;
+			client->replay_last_id = cmd->since_when;
+			startWriteSource(client);
+			break;
+		default:
+			client->dead = true;
+			break;
+	}
 }
 
 void handleNewConnection(int fd)
 {
-	dispatch_source_t socketSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, fd, 0, dispatch_get_main_queue());
+	fseventsd_client_t* client = (fseventsd_client_t*) calloc(1, sizeof(fseventsd_client_t));
+	if (!client)
+	{
+		close(fd);
+		return;
+	}
 
-	dispatch_source_set_event_handler(socketSource, ^{
-		fseventsd_monitor_t cmd;
-		struct msghdr msg;
-		struct iovec iov = {
-			.iov_base = &cmd,
-			.iov_len = sizeof(cmd)
-		};
+	client->fd = fd;
+	client->source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, fd, 0, dispatch_get_main_queue());
+	client->next = g_clients;
+	g_clients = client;
 
-		memset(&msg, 0, sizeof(msg));
-		msg.msg_iov = &iov;
-		msg.msg_iovlen = 1;
+	dispatch_source_set_event_handler(client->source, ^{
+		fseventsd_monitor_t cmd;
 
-		recvmsg(fd, &msg, 0);
-		int rv = read(fd, &cmd, sizeof(cmd));
+		int rv = recv(fd, &cmd, sizeof(cmd), 0);
 
 		if (rv == sizeof(cmd))
-			handleClientCommand(fd, &cmd);
+		{
+			@autoreleasepool
+			{
+				handleClientCommand(client, &cmd);
+			}
+		}
+		else if (rv == 0 || (rv == -1 && errno != EINTR && errno != EAGAIN))
+			client->dead = true;
+
+		if (client->dead)
+			removeDeadClients();
+	});
+	dispatch_source_set_cancel_handler(client->source, ^{
+		close(fd);
 	});
 
-	dispatch_resume(socketSource);
+	dispatch_resume(client->source);
 }
 
-void fileHandleToFSRef(const struct file_handle* fh, FSRef* ref)
+static void fileHandleToFSRef(const struct file_handle* fh, const FSRef* mountRef, FSRef* ref)
 {
-	static FSRef rootRef;
-	static dispatch_once_t once;
-
-	dispatch_once(&once, ^{
-		FSPathMakeRef((const UInt8*) "/", &rootRef, NULL);
-	});
-
 	RefData* refData = (RefData*) ref;
-	refData->mount_id = ((RefData*)&rootRef)->mount_id;
+	refData->mount_id = ((const RefData*) mountRef)->mount_id;
 
 	memcpy(&refData->fh, fh, sizeof(FSRef) - sizeof(refData->mount_id));
 }
 
-void setupFANotify(void)
+static FSEventStreamEventFlags flagsForMask(uint64_t mask)
 {
-	// FAN_REPORT_FID = provide file handles
-	// Linux file handle = FSRef in Darling
-	g_fanotify = fanotify_init(FAN_REPORT_FID, 0);
-	if (g_fanotify == -1)
+	FSEventStreamEventFlags flags = (mask & FAN_ONDIR) ? kFSEventStreamEventFlagItemIsDir : kFSEventStreamEventFlagItemIsFile;
+
+	if (mask & FAN_CREATE)
+		flags |= kFSEventStreamEventFlagItemCreated;
+	if (mask & (FAN_DELETE | FAN_DELETE_SELF))
+		flags |= kFSEventStreamEventFlagItemRemoved;
+	if (mask & (FAN_MOVED_FROM | FAN_MOVED_TO))
+		flags |= kFSEventStreamEventFlagItemRenamed;
+	if (mask & FAN_MODIFY)
+		flags |= kFSEventStreamEventFlagItemModified;
+
+	return flags;
+}
+
+static void batchAdd(fseventsd_batch_t* batch, NSString* path, FSEventStreamEventFlags flags)
+{
+	NSNumber* existing = [batch->flags objectForKey: path];
+	if (existing == nil)
+		[batch->paths addObject: path];
+	else
+		flags |= [existing unsignedIntValue];
+	[batch->flags setObject: [NSNumber numberWithUnsignedInt: flags] forKey: path];
+}
+
+// journals the events and passes them on
+static void batchPublish(fseventsd_batch_t* batch)
+{
+	for (NSString* path in batch->paths)
 	{
-		perror("fanotify_init");
-		exit(EXIT_FAILURE);
+		const char* cpath = [path UTF8String];
+		const uint32_t pathLength = strlen(cpath);
+		const FSEventStreamEventFlags flags = [[batch->flags objectForKey: path] unsignedIntValue];
+
+		if (pathLength > sizeof(((fseventsd_event_t*) NULL)->path))
+			continue;
+
+		const uint64_t id = journalAppend(cpath, pathLength, flags);
+
+		for (fseventsd_client_t* client = g_clients; client != NULL; client = client->next)
+		{
+			if (client->started)
+				deliverEvent(client, id, flags, cpath, pathLength);
+		}
 	}
 
-	int rv = fanotify_mark(g_fanotify, FAN_MARK_ADD | FAN_MARK_FILESYSTEM,
-		FAN_CREATE | FAN_DELETE | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_MODIFY | FAN_ONDIR, AT_FDCWD, "/");
-	if (rv == -1)
+	if ([batch->paths count] > 0)
+		msync(g_journal, sizeof(journal_header_t) + JOURNAL_CAPACITY, MS_ASYNC);
+
+	removeDeadClients();
+}
+
+static const fseventsd_filesystem_t* filesystemForFsid(const void* fsid)
+{
+	for (size_t i = 0; i < g_filesystemCount; i++)
+	{
+		if (memcmp(&g_filesystems[i].fsid, fsid, sizeof(fsid_t)) == 0)
+			return &g_filesystems[i];
+	}
+	return NULL;
+}
+
+// marks the whole filesystem `path` is on, unless that has already happened
+static bool watchFilesystem(const char* path)
+{
+	fseventsd_filesystem_t fs;
+	struct statfs st;
+
+	if (statfs(path, &st) == -1)
+		return false;
+	if (filesystemForFsid(&st.f_fsid) != NULL)
+		return true;
+	if (FSPathMakeRef((const UInt8*) path, &fs.root, NULL) != 0)
+		return false;
+
+	if (fanotify_mark(g_fanotify, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, FANOTIFY_MASK, AT_FDCWD, path) == -1)
 	{
 		perror("fanotify_mark");
-		exit(EXIT_FAILURE);
+		return false;
 	}
 
-	dispatch_source_t faSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, g_fanotify, 0, dispatch_get_main_queue());
+	fseventsd_filesystem_t* filesystems = (fseventsd_filesystem_t*) realloc(g_filesystems, sizeof(*filesystems) * (g_filesystemCount + 1));
+	if (!filesystems)
+		return false;
 
-	dispatch_source_set_event_handler(faSource, ^{
-		char events_buf[4096];
-		int len = read(g_fanotify, events_buf, sizeof(events_buf));
-		printf("Read %d bytes of event data\n", len);
+	fs.fsid = st.f_fsid;
+	filesystems[g_filesystemCount++] = fs;
+	g_filesystems = filesystems;
+	return true;
+}
+
+// resolves the directory handle and name of a FAN_EVENT_INFO_TYPE_DFID_NAME record;
+// unlike the item itself, the directory is still there when the item has been deleted or moved away
+static NSString* pathForDirectoryAndName(const struct fanotify_event_info_fid* fid)
+{
+	const struct file_handle* fh = (const struct file_handle *) fid->handle;
+	const char* name = (const char*) fh->f_handle + fh->handle_bytes;
+	const fseventsd_filesystem_t* fs = filesystemForFsid(&fid->fsid);
+	char pathbuf[4096];
+	FSRef fsref;
+
+	if (fs == NULL)
+		return nil;
+
+	fileHandleToFSRef(fh, &fs->root, &fsref);
+
+	// this fails for directories that are already gone again
+	if (FSRefMakePath(&fsref, (UInt8*)pathbuf, sizeof(pathbuf)) != 0)
+		return nil;
+
+	NSString* directory = [NSString stringWithUTF8String: pathbuf];
+
+	// events on the directory itself
+	if (strcmp(name, ".") == 0)
+		return directory;
+
+	return [directory stringByAppendingPathComponent: [NSString stringWithUTF8String: name]];
+}
+
+// drains the fanotify queue, merges the events for the same path, journals them and passes them on
+static void processFANotifyEvents(void)
+{
+	static char events_buf[64 * 1024] __attribute__((aligned(8)));
+	fseventsd_batch_t batch = { [NSMutableArray array], [NSMutableDictionary dictionary] };
+
+	while (1)
+	{
+		ssize_t len = read(g_fanotify, events_buf, sizeof(events_buf));
+		if (len == -1 && errno == EINTR)
+			continue;
+		if (len <= 0)
+			break;
 
 		for (struct fanotify_event_metadata* metadata = (struct fanotify_event_metadata *) events_buf;
-            FAN_EVENT_OK(metadata, len);
-            metadata = FAN_EVENT_NEXT(metadata, len))
+			FAN_EVENT_OK(metadata, len);
+			metadata = FAN_EVENT_NEXT(metadata, len))
+		{
+			if (metadata->mask & FAN_Q_OVERFLOW)
+			{
+				batchAdd(&batch, @"/", kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagKernelDropped);
+				continue;
+			}
+
+			for (uint32_t offset = metadata->metadata_len; offset + sizeof(struct fanotify_event_info_header) <= metadata->event_len; )
+			{
+				const struct fanotify_event_info_fid* fid = (const struct fanotify_event_info_fid *) ((const char*) metadata + offset);
+
+				if (fid->hdr.len == 0)
+					break;
+				offset += fid->hdr.len;
+
+				if (fid->hdr.info_type != FAN_EVENT_INFO_TYPE_DFID_NAME)
+					continue;
+
+				NSString* path = pathForDirectoryAndName(fid);
+				if (path != nil)
+					batchAdd(&batch, path, flagsForMask(metadata->mask));
+			}
+		}
+	}
+
+	batchPublish(&batch);
+}
+
+// inotify fallback: adds watches for `path` and all the directories below it; with a `batch`, everything found is reported as created
+static void inotifyWatchTree(NSString* path, fseventsd_batch_t* batch)
+{
+	char* paths[] = { (char*) [path UTF8String], NULL };
+	FTS* fts = fts_open(paths, FTS_PHYSICAL | FTS_COMFOLLOW | FTS_NOCHDIR, NULL);
+	FTSENT* ent;
+
+	if (!fts)
+		return;
+
+	while ((ent = fts_read(fts)) != NULL)
+	{
+		const bool isRoot = ent->fts_level == FTS_ROOTLEVEL;
+
+		if (ent->fts_info != FTS_D && ent->fts_info != FTS_F && ent->fts_info != FTS_SL && ent->fts_info != FTS_SLNONE)
+			continue;
+
+		NSString* entPath = isRoot ? path : [NSString stringWithUTF8String: ent->fts_path];
+
+		if (ent->fts_info == FTS_D || isRoot)
 		{
-			printf("Event mask: 0x%x\n", metadata->mask);
-			struct fanotify_event_info_fid* fid = (struct fanotify_event_info_fid *) (metadata + 1);
-			if (fid->hdr.info_type == FAN_EVENT_INFO_TYPE_FID)
+			// the watched paths themselves may also be files
+			int wd = inotify_add_watch(g_inotify, ent->fts_path, isRoot ? INOTIFY_MASK : (INOTIFY_MASK | IN_ONLYDIR | IN_DONT_FOLLOW));
+			if (wd != -1)
 			{
-				struct file_handle* fh = (struct file_handle *) fid->handle;
-				FSRef fsref;
-
-				printf("fileHandleToFSRef: bytes: %d, type: %d\n", fh->handle_bytes, fh->handle_type);
-				fileHandleToFSRef(fh, &fsref);
-
-				char pathbuf[1024];
-				printf("FSRefMakePath\n");
-				if (FSRefMakePath(&fsref, (UInt8*)pathbuf, sizeof(pathbuf)) != 0)
-					puts("FSRefMakePath failed");
-				else
-					printf("Event on %s\n", pathbuf);
+				// a directory that was moved within the tree keeps its watch descriptor; this updates its path
+				[g_inotifyWatches setObject: entPath forKey: [NSNumber numberWithInt: wd]];
 			}
 			else
 			{
-				puts("Not a FID");
+				// most likely out of watches
+				if (batch)
+					batchAdd(batch, entPath, kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagUserDropped);
+				fts_set(fts, ent, FTS_SKIP);
+			}
+		}
+
+		if (batch && !isRoot)
+			batchAdd(batch, entPath, kFSEventStreamEventFlagItemCreated | ((ent->fts_info == FTS_D) ? kFSEventStreamEventFlagItemIsDir : kFSEventStreamEventFlagItemIsFile));
+	}
+
+	fts_close(fts);
+}
+
+static void processINotifyEvents(void)
+{
+	static char events_buf[64 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+	fseventsd_batch_t batch = { [NSMutableArray array], [NSMutableDictionary dictionary] };
+
+	while (1)
+	{
+		ssize_t len = read(g_inotify, events_buf, sizeof(events_buf));
+		if (len == -1 && errno == EINTR)
+			continue;
+		if (len <= 0)
+			break;
+
+		for (char* p = events_buf; p < events_buf + len; )
+		{
+			struct inotify_event* evt = (struct inotify_event*) p;
+			p += sizeof(struct inotify_event) + evt->len;
+
+			if (evt->mask & IN_Q_OVERFLOW)
+			{
+				batchAdd(&batch, @"/", kFSEventStreamEventFlagMustScanSubDirs | kFSEventStreamEventFlagKernelDropped);
+				continue;
 			}
-			printf("---\n");
+
+			NSNumber* wdKey = [NSNumber numberWithInt: evt->wd];
+			NSString* directory = [g_inotifyWatches objectForKey: wdKey];
+			if (!directory)
+				continue;
+
+			if (evt->mask & IN_IGNORED)
+			{
+				[g_inotifyWatches removeObjectForKey: wdKey];
+				continue;
+			}
+
+			NSString* path = (evt->len == 0) ? directory : [directory stringByAppendingPathComponent: [NSString stringWithUTF8String: evt->name]];
+
+			batchAdd(&batch, path, flagsForMask(evt->mask));
+
+			// new directories need watches of their own
+			if ((evt->mask & IN_ISDIR) && (evt->mask & (IN_CREATE | IN_MOVED_TO)))
+				inotifyWatchTree(path, (evt->mask & IN_CREATE) ? &batch : NULL);
+		}
+	}
+
+	batchPublish(&batch);
+}
+
+// inotify fallback: removes the watches for `path` and the directories below it, except for those another watched path still needs
+static void inotifyUnwatchTree(NSString* path)
+{
+	const char* cpath = [path UTF8String];
+	const size_t cpathLength = strlen(cpath);
+
+	for (NSNumber* wdKey in [g_inotifyWatches allKeys])
+	{
+		const char* directory = [[g_inotifyWatches objectForKey: wdKey] UTF8String];
+		const size_t directoryLength = strlen(directory);
+		bool needed = false;
+
+		if (!pathIsUnder(directory, directoryLength, cpath, cpathLength))
+			continue;
+
+		for (NSString* root in g_inotifyRoots)
+		{
+			const char* croot = [root UTF8String];
+			if (pathIsUnder(directory, directoryLength, croot, strlen(croot)))
+			{
+				needed = true;
+				break;
+			}
+		}
+		if (needed)
+			continue;
+
+		// the IN_IGNORED that follows is skipped, since the descriptor is no longer known
+		inotify_rm_watch(g_inotify, [wdKey intValue]);
+		[g_inotifyWatches removeObjectForKey: wdKey];
+	}
+}
+
+static void watchPath(const char* path)
+{
+	if (g_fanotify != -1)
+		watchFilesystem(path);
+	else if (g_inotify != -1)
+	{
+		NSString* root = [NSString stringWithUTF8String: path];
+		if (root == nil)
+			return;
+
+		const NSUInteger count = [[g_inotifyRoots objectForKey: root] unsignedIntegerValue];
+		if (count == 0)
+			inotifyWatchTree(root, NULL);
+		[g_inotifyRoots setObject: [NSNumber numberWithUnsignedInteger: count + 1] forKey: root];
+	}
+}
+
+// the counterpart of watchPath() for a client that is going away; a filesystem stays marked for fanotify
+static void unwatchPath(const char* path)
+{
+	if (g_inotify == -1)
+		return;
+
+	// clients are also closed outside of the event handlers' pools
+	@autoreleasepool
+	{
+		NSString* root = [NSString stringWithUTF8String: path];
+		if (root == nil)
+			return;
+
+		const NSUInteger count = [[g_inotifyRoots objectForKey: root] unsignedIntegerValue];
+		if (count > 1)
+		{
+			[g_inotifyRoots setObject: [NSNumber numberWithUnsignedInteger: count - 1] forKey: root];
+			return;
+		}
+
+		[g_inotifyRoots removeObjectForKey: root];
+		if (count == 1)
+			inotifyUnwatchTree(root);
+	}
+}
+
+void setupFANotify(void)
+{
+	// FAN_REPORT_DFID_NAME = provide the handle of the directory and the name of the item;
+	// Linux file handle = FSRef in Darling
+	g_fanotify = fanotify_init(FAN_REPORT_DFID_NAME | FAN_CLOEXEC | FAN_NONBLOCK, 0);
+	if (g_fanotify == -1)
+	{
+		// most likely no CAP_SYS_ADMIN, or a kernel older than 5.9
+		perror("fanotify_init");
+		setupINotify();
+		return;
+	}
+
+	// the other filesystems are marked as clients start watching paths on them
+	if (!watchFilesystem("/"))
+	{
+		close(g_fanotify);
+		g_fanotify = -1;
+		setupINotify();
+		return;
+	}
+
+	dispatch_source_t faSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, g_fanotify, 0, dispatch_get_main_queue());
+
+	dispatch_source_set_event_handler(faSource, ^{
+		@autoreleasepool
+		{
+			processFANotifyEvents();
 		}
 	});
 
 	dispatch_resume(faSource);
 }
+
+// without fanotify, we only see what happens below the paths clients are watching (and only while they are)
+void setupINotify(void)
+{
+	fprintf(stderr, "fseventsd: fanotify is not available, falling back to inotify\n");
+
+	g_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (g_inotify == -1)
+	{
+		perror("inotify_init1");
+		exit(EXIT_FAILURE);
+	}
+
+	g_inotifyWatches = [[NSMutableDictionary alloc] init];
+	g_inotifyRoots = [[NSMutableDictionary alloc] init];
+
+	dispatch_source_t inSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, g_inotify, 0, dispatch_get_main_queue());
+
+	dispatch_source_set_event_handler(inSource, ^{
+		@autoreleasepool
+		{
+			processINotifyEvents();
+		}
+	});
+
+	dispatch_resume(inSource);
+}
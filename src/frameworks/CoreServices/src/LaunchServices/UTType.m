@@ -23,9 +23,120 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 #import <Foundation/NSArray.h>
 #import <Foundation/NSNumber.h>
 #import <fmdb/FMDatabaseQueue.h>
+#include "UTTypeSnapshot.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
 
 extern FMDatabaseQueue* getDatabaseQueue(void);
-extern NSString* escape(NSString* str);
+
+// how often (in seconds) we look for a new snapshot when there isn't a usable one
+#define SNAPSHOT_RETRY_INTERVAL 5
+
+static const struct ls_uti_snapshot* g_snapshot;
+static pthread_mutex_t g_snapshotLock = PTHREAD_MUTEX_INITIALIZER;
+static time_t g_snapshotLastAttempt;
+
+static const struct ls_uti_snapshot* mapSnapshot(void)
+{
+	int fd = open(LS_UTI_SNAPSHOT_PATH, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return NULL;
+
+	struct stat st;
+	void* mem = MAP_FAILED;
+
+	if (fstat(fd, &st) == 0 && st.st_size >= sizeof(struct ls_uti_snapshot))
+		mem = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (mem == MAP_FAILED)
+		return NULL;
+
+	const struct ls_uti_snapshot* snapshot = (const struct ls_uti_snapshot*) mem;
+
+	if (memcmp(snapshot->magic, LS_UTI_SNAPSHOT_MAGIC, sizeof(snapshot->magic)) != 0
+		|| snapshot->version != LS_UTI_SNAPSHOT_VERSION
+		|| snapshot->size != st.st_size
+		|| (uint64_t) snapshot->strings_offset + snapshot->strings_size != snapshot->size
+		|| snapshot->type_slot_count == 0 || snapshot->tag_slot_count == 0)
+	{
+		munmap(mem, st.st_size);
+		return NULL;
+	}
+
+	return snapshot;
+}
+
+// Returns the UTI snapshot written by launchservicesd, or NULL if there isn't one (then we go to the database).
+// This doesn't take any locks unless launchservicesd has replaced the snapshot since we last looked.
+// Replaced snapshots are never unmapped, as other threads may still be reading them.
+static const struct ls_uti_snapshot* getSnapshot(void)
+{
+	const struct ls_uti_snapshot* snapshot = __atomic_load_n(&g_snapshot, __ATOMIC_ACQUIRE);
+
+	if (snapshot != NULL && !__atomic_load_n(&snapshot->stale, __ATOMIC_RELAXED))
+		return snapshot;
+
+	// a stale snapshot is still consistent, so use it until the new one can be mapped
+	const time_t now = time(NULL);
+	if (now - __atomic_load_n(&g_snapshotLastAttempt, __ATOMIC_RELAXED) < SNAPSHOT_RETRY_INTERVAL)
+		return snapshot;
+
+	pthread_mutex_lock(&g_snapshotLock);
+
+	snapshot = g_snapshot;
+	if (snapshot == NULL || snapshot->stale)
+	{
+		const struct ls_uti_snapshot* newSnapshot = mapSnapshot();
+
+		if (newSnapshot != NULL)
+		{
+			__atomic_store_n(&g_snapshot, newSnapshot, __ATOMIC_RELEASE);
+			snapshot = newSnapshot;
+		}
+		else
+			__atomic_store_n(&g_snapshotLastAttempt, now, __ATOMIC_RELAXED);
+	}
+
+	pthread_mutex_unlock(&g_snapshotLock);
+	return snapshot;
+}
+
+// Gets a UTF-8 representation of `str` without allocating; fails if it doesn't fit in `buffer`
+static bool getUTF8(CFStringRef str, char* buffer, size_t size, const char** out, size_t* length)
+{
+	const char* ptr = CFStringGetCStringPtr(str, kCFStringEncodingUTF8);
+
+	if (ptr == NULL)
+	{
+		if (!CFStringGetCString(str, buffer, size, kCFStringEncodingUTF8))
+			return false;
+		ptr = buffer;
+	}
+
+	*out = ptr;
+	*length = strlen(ptr);
+	return true;
+}
+
+// LS_UTI_NONE if the type is unknown; `found` is false if the snapshot couldn't be used
+static uint32_t findSnapshotType(const struct ls_uti_snapshot* snapshot, CFStringRef inUTI, bool* found)
+{
+	char buffer[256];
+	const char* uti;
+	size_t length;
+
+	*found = getUTF8(inUTI, buffer, sizeof(buffer), &uti, &length);
+	if (!*found)
+		return LS_UTI_NONE;
+
+	return ls_uti_find_type(snapshot, uti, length);
+}
 
 _Nullable CFStringRef
 UTTypeCreatePreferredIdentifierForTag(
@@ -63,34 +174,98 @@ static CFArrayRef arrayForStringColumn0(FMResultSet* rs)
 		return NULL;
 }
 
+static bool snapshotIdentifiersForTag(const struct ls_uti_snapshot* snapshot, CFStringRef inTagClass, CFStringRef inTag,
+	_Nullable CFStringRef inConformingToUTI, CFArrayRef* retval)
+{
+	char tagClassBuffer[64], tagBuffer[256];
+	const char *tagClass, *tag;
+	size_t tagClassLength, tagLength;
+	uint32_t conformingTo = LS_UTI_NONE;
+
+	if (!getUTF8(inTagClass, tagClassBuffer, sizeof(tagClassBuffer), &tagClass, &tagClassLength)
+		|| !getUTF8(inTag, tagBuffer, sizeof(tagBuffer), &tag, &tagLength))
+	{
+		return false;
+	}
+
+	*retval = NULL;
+
+	if (inConformingToUTI != NULL)
+	{
+		bool found;
+
+		conformingTo = findSnapshotType(snapshot, inConformingToUTI, &found);
+		if (!found)
+			return false;
+		if (conformingTo == LS_UTI_NONE)
+			return true;
+	}
+
+	const struct ls_uti_tag* first;
+	const uint32_t count = ls_uti_find_tags(snapshot, tagClass, tagClassLength, tag, tagLength, &first);
+	const struct ls_uti_type* types = ls_uti_types(snapshot);
+	NSMutableArray* array = nil;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (conformingTo != LS_UTI_NONE && !ls_uti_conforms(snapshot, first[i].type, conformingTo))
+			continue;
+
+		if (array == nil)
+			array = [[NSMutableArray alloc] initWithCapacity: count];
+		[array addObject: [NSString stringWithUTF8String: ls_uti_string(snapshot, types[first[i].type].identifier)]];
+	}
+
+	if (array != nil)
+	{
+		*retval = (CFArrayRef) [[NSArray alloc] initWithArray:array];
+		[array release];
+	}
+
+	return true;
+}
+
 _Nullable CFArrayRef
 UTTypeCreateAllIdentifiersForTag(
   CFStringRef inTagClass,
   CFStringRef inTag,
   _Nullable CFStringRef inConformingToUTI)
 {
+	const struct ls_uti_snapshot* snapshot = getSnapshot();
+	CFArrayRef retval;
+
+	if (snapshot != NULL && snapshotIdentifiersForTag(snapshot, inTagClass, inTag, inConformingToUTI, &retval))
+		return retval;
+
 	FMDatabaseQueue* dq = getDatabaseQueue();
 	if (!dq)
 		return NULL;
 
-	__block CFArrayRef retval;
+	__block CFArrayRef candidates;
 	[dq inDatabase:^(FMDatabase* db) {
-		NSString* query = @"select type_identifier from uti inner join uti_tag UT on UT.uti=uti.id "
-			@"where UT.tag = ? and UT.value = ?";
+		FMResultSet* rs = [db executeQuery:@"select type_identifier from uti inner join uti_tag UT on UT.uti=uti.id "
+			@"where UT.tag = ? and UT.value = ?", inTagClass, inTag];
 
-		if (inConformingToUTI != NULL)
-		{
-			query = [query stringByAppendingFormat:@" and uti.id in (select uti from uti_conforms where conforms_to='%@')",
-				escape((NSString*) inConformingToUTI)];
-		}
-
-		FMResultSet* rs = [db executeQuery:query, inTagClass, inTag];
-
-		retval = arrayForStringColumn0(rs);
+		candidates = arrayForStringColumn0(rs);
 
 		[rs close];
 	}];
 
+	if (candidates == NULL || inConformingToUTI == NULL)
+		return candidates;
+
+	// UTTypeConformsTo() needs the database queue, too, so this can't be done in the block above
+	NSMutableArray* array = [[NSMutableArray alloc] initWithCapacity: CFArrayGetCount(candidates)];
+	for (NSString* uti in (NSArray*) candidates)
+	{
+		if (UTTypeConformsTo((CFStringRef) uti, inConformingToUTI))
+			[array addObject: uti];
+	}
+	CFRelease(candidates);
+
+	retval = ([array count] > 0) ? (CFArrayRef) [[NSArray alloc] initWithArray:array] : NULL;
+	[array release];
+
 	return retval;
 }
 
@@ -144,13 +319,30 @@ UTTypeConformsTo(
   CFStringRef inUTI,
   CFStringRef inConformsToUTI)
 {
+	if (UTTypeEqual(inUTI, inConformsToUTI))
+		return TRUE;
+
+	const struct ls_uti_snapshot* snapshot = getSnapshot();
+	if (snapshot != NULL)
+	{
+		bool found, parentFound;
+		const uint32_t type = findSnapshotType(snapshot, inUTI, &found);
+		const uint32_t parent = findSnapshotType(snapshot, inConformsToUTI, &parentFound);
+
+		if (found && parentFound)
+			return type != LS_UTI_NONE && parent != LS_UTI_NONE && ls_uti_conforms(snapshot, type, parent);
+	}
+
 	FMDatabaseQueue* dq = getDatabaseQueue();
 	if (!dq)
 		return FALSE;
 
 	__block Boolean retval;
 	[dq inDatabase:^(FMDatabase* db) {
-		FMResultSet* rs = [db executeQuery:@"select UC.conforms_to from uti inner join uti_conforms UC on UC.uti=uti.id where type_identifier=? and UC.conforms_to=?",
+		FMResultSet* rs = [db executeQuery:@"with recursive parents(identifier) as ("
+			@"select ? union "
+			@"select UC.conforms_to from parents inner join uti on uti.type_identifier=parents.identifier inner join uti_conforms UC on UC.uti=uti.id) "
+			@"select 1 from parents where identifier=? collate nocase limit 1",
 			inUTI, inConformsToUTI];
 
 		retval = [rs next];
@@ -163,6 +355,25 @@ UTTypeConformsTo(
 _Nullable CFStringRef
 UTTypeCopyDescription(CFStringRef inUTI)
 {
+	const struct ls_uti_snapshot* snapshot = getSnapshot();
+	if (snapshot != NULL)
+	{
+		bool found;
+		const uint32_t type = findSnapshotType(snapshot, inUTI, &found);
+
+		if (found)
+		{
+			if (type == LS_UTI_NONE || ls_uti_types(snapshot)[type].description == LS_UTI_NONE)
+				return NULL;
+
+			const char* description = ls_uti_string(snapshot, ls_uti_types(snapshot)[type].description);
+			if (description[0] == '\0')
+				return NULL;
+
+			return CFStringCreateWithCString(NULL, description, kCFStringEncodingUTF8);
+		}
+	}
+
 	FMDatabaseQueue* dq = getDatabaseQueue();
 	if (!dq)
 		return NULL;
@@ -183,6 +394,16 @@ UTTypeCopyDescription(CFStringRef inUTI)
 Boolean
 UTTypeIsDeclared(CFStringRef inUTI)
 {
+	const struct ls_uti_snapshot* snapshot = getSnapshot();
+	if (snapshot != NULL)
+	{
+		bool found;
+		const uint32_t type = findSnapshotType(snapshot, inUTI, &found);
+
+		if (found)
+			return type != LS_UTI_NONE && ls_uti_types(snapshot)[type].description != LS_UTI_NONE;
+	}
+
 	CFStringRef str = UTTypeCopyDescription(inUTI);
 	if (str != NULL)
 	{
@@ -284,6 +505,28 @@ UTTypeCopyDeclaringBundleURL(CFStringRef inUTI)
 CFArrayRef
 UTTypeCopyParentIdentifiers(CFStringRef inUTI)
 {
+	const struct ls_uti_snapshot* snapshot = getSnapshot();
+	if (snapshot != NULL)
+	{
+		bool found;
+		const uint32_t index = findSnapshotType(snapshot, inUTI, &found);
+
+		if (found)
+		{
+			if (index == LS_UTI_NONE || ls_uti_types(snapshot)[index].description == LS_UTI_NONE)
+				return NULL;
+
+			NSMutableArray* conformsTo = [[NSMutableArray alloc] init];
+			for (const uint32_t* parent = ls_uti_parents(snapshot, &ls_uti_types(snapshot)[index]); *parent != LS_UTI_NONE; parent++)
+				[conformsTo addObject: [NSString stringWithUTF8String: ls_uti_string(snapshot, ls_uti_types(snapshot)[*parent].identifier)]];
+
+			CFArrayRef retval = (CFArrayRef)[[NSArray alloc] initWithArray: conformsTo];
+			[conformsTo release];
+
+			return retval;
+		}
+	}
+
 	FMDatabaseQueue* dq = getDatabaseQueue();
 	if (!dq)
 		return NULL;
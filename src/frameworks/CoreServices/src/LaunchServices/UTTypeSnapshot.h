@@ -0,0 +1,190 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2020 Lubos Dolezel
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _LS_UTTYPE_SNAPSHOT_H
+#define _LS_UTTYPE_SNAPSHOT_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+
+// An immutable snapshot of the UTI tables in launchservices.db, written by launchservicesd every time they change.
+// Clients map it read-only and answer UTType queries without going through the database:
+//  - every type (including the ones that are only named as something to conform to) has an index,
+//    and identifiers are found through an open-addressing hash table;
+//  - each type has a row in a bitmap that has the bits of all the types it conforms to, directly or not (and its own);
+//  - tags are grouped by (tag class, value) and found through a second hash table.
+//
+// When launchservicesd replaces the snapshot, it sets `stale` in the old one, so clients know they should map the new file.
+//
+// Identifiers and tag values are compared case-insensitively (like in the database), so they're hashed in lowercase.
+// All offsets are relative to the start of the header.
+
+#define LS_UTI_SNAPSHOT_PATH "/private/var/db/launchservices.uti"
+#define LS_UTI_SNAPSHOT_MAGIC "LSUTI001"
+#define LS_UTI_SNAPSHOT_VERSION 1
+
+#define LS_UTI_NONE 0xffffffffu
+
+struct ls_uti_snapshot {
+	char magic[8];
+	uint32_t version;
+	uint32_t stale;
+	uint32_t size;
+
+	uint32_t type_count;
+	uint32_t types_offset;
+	// LS_UTI_NONE-terminated type indices, referenced by ls_uti_type::parents
+	uint32_t parents_offset;
+	// type_count rows of `conformance_words` 32-bit words
+	uint32_t conformance_offset;
+	uint32_t conformance_words;
+
+	// power of two; entries are type index + 1 (0 means empty)
+	uint32_t type_slot_count;
+	uint32_t type_slots_offset;
+
+	uint32_t tag_count;
+	uint32_t tags_offset;
+	// power of two; entries are the index of the first tag of the group + 1 (0 means empty)
+	uint32_t tag_slot_count;
+	uint32_t tag_slots_offset;
+
+	uint32_t strings_offset;
+	uint32_t strings_size;
+};
+
+struct ls_uti_type {
+	// string offsets
+	uint32_t identifier;
+	// LS_UTI_NONE if the type is only known as a parent of other types
+	uint32_t description;
+	// offset of the type's first parent in the parents array
+	uint32_t parents;
+	uint32_t reserved;
+};
+
+// tags with the same class and value are adjacent; `group_count` is set on the first tag of a group
+struct ls_uti_tag {
+	// string offsets
+	uint32_t tag_class;
+	uint32_t value;
+	uint32_t type;
+	uint32_t group_count;
+};
+
+static inline uint32_t ls_uti_hash_step(uint32_t hash, unsigned char c)
+{
+	if (c >= 'A' && c <= 'Z')
+		c += 'a' - 'A';
+	return (hash ^ c) * 16777619u;
+}
+
+static inline uint32_t ls_uti_hash(const char* str, size_t length)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < length; i++)
+		hash = ls_uti_hash_step(hash, (unsigned char) str[i]);
+	return hash;
+}
+
+// the tag class is case-sensitive, but hashing it in lowercase doesn't hurt
+static inline uint32_t ls_uti_tag_hash(const char* tagClass, size_t tagClassLength, const char* value, size_t valueLength)
+{
+	uint32_t hash = ls_uti_hash(tagClass, tagClassLength);
+	hash = ls_uti_hash_step(hash, 0);
+	for (size_t i = 0; i < valueLength; i++)
+		hash = ls_uti_hash_step(hash, (unsigned char) value[i]);
+	return hash;
+}
+
+static inline const char* ls_uti_string(const struct ls_uti_snapshot* snapshot, uint32_t offset)
+{
+	return (const char*) snapshot + snapshot->strings_offset + offset;
+}
+
+static inline const struct ls_uti_type* ls_uti_types(const struct ls_uti_snapshot* snapshot)
+{
+	return (const struct ls_uti_type*) ((const char*) snapshot + snapshot->types_offset);
+}
+
+static inline const uint32_t* ls_uti_parents(const struct ls_uti_snapshot* snapshot, const struct ls_uti_type* type)
+{
+	return (const uint32_t*) ((const char*) snapshot + snapshot->parents_offset) + type->parents;
+}
+
+static inline const struct ls_uti_tag* ls_uti_tags(const struct ls_uti_snapshot* snapshot)
+{
+	return (const struct ls_uti_tag*) ((const char*) snapshot + snapshot->tags_offset);
+}
+
+static inline bool ls_uti_string_equal(const char* stored, const char* str, size_t length)
+{
+	return strncasecmp(stored, str, length) == 0 && stored[length] == '\0';
+}
+
+// returns LS_UTI_NONE if the identifier is unknown
+static inline uint32_t ls_uti_find_type(const struct ls_uti_snapshot* snapshot, const char* identifier, size_t length)
+{
+	const uint32_t* slots = (const uint32_t*) ((const char*) snapshot + snapshot->type_slots_offset);
+	const struct ls_uti_type* types = ls_uti_types(snapshot);
+	const uint32_t mask = snapshot->type_slot_count - 1;
+
+	for (uint32_t slot = ls_uti_hash(identifier, length) & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+	{
+		const uint32_t index = slots[slot] - 1;
+		if (ls_uti_string_equal(ls_uti_string(snapshot, types[index].identifier), identifier, length))
+			return index;
+	}
+
+	return LS_UTI_NONE;
+}
+
+static inline bool ls_uti_conforms(const struct ls_uti_snapshot* snapshot, uint32_t type, uint32_t parent)
+{
+	const uint32_t* row = (const uint32_t*) ((const char*) snapshot + snapshot->conformance_offset) + (size_t) type * snapshot->conformance_words;
+	return (row[parent / 32] >> (parent % 32)) & 1;
+}
+
+// returns the number of tags in the group and points `first` at the first one
+static inline uint32_t ls_uti_find_tags(const struct ls_uti_snapshot* snapshot, const char* tagClass, size_t tagClassLength,
+	const char* value, size_t valueLength, const struct ls_uti_tag** first)
+{
+	const uint32_t* slots = (const uint32_t*) ((const char*) snapshot + snapshot->tag_slots_offset);
+	const struct ls_uti_tag* tags = ls_uti_tags(snapshot);
+	const uint32_t mask = snapshot->tag_slot_count - 1;
+
+	for (uint32_t slot = ls_uti_tag_hash(tagClass, tagClassLength, value, valueLength) & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+	{
+		const struct ls_uti_tag* tag = &tags[slots[slot] - 1];
+		const char* storedClass = ls_uti_string(snapshot, tag->tag_class);
+
+		if (strncmp(storedClass, tagClass, tagClassLength) == 0 && storedClass[tagClassLength] == '\0'
+			&& ls_uti_string_equal(ls_uti_string(snapshot, tag->value), value, valueLength))
+		{
+			*first = tag;
+			return tag->group_count;
+		}
+	}
+
+	return 0;
+}
+
+#endif
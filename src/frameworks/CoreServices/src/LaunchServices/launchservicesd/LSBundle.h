@@ -26,13 +26,19 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 {
 	CFBundleRef _bundle;
 	int _bundleId;
+	uint32_t _checksum;
+	// Info.plist's modification time, see +infoPlistStampForBundleAtPath:
+	int64_t _infoStamp;
 }
 -(id) initWithBundle:(CFBundleRef) bundle;
 -(void)dealloc;
+// computes everything that doesn't need the database; this may be called on any thread
+-(void)prepare;
 -(void)process;
 
 @property (readonly) int bundleId;
 
++(int64_t)infoPlistStampForBundleAtPath:(NSString*)path;
 +(void)scanForBundles;
 +(void)watchForBundles;
 @end
@@ -18,14 +18,16 @@ along with Darling.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include "LSBundle.h"
+#include "UTTypeSnapshotWriter.h"
 #include <FSEvents/FSEvents.h>
 #include <sqlite3.h>
 #import <Foundation/Foundation.h>
 #import <fmdb/FMDatabase.h>
 #include <zlib.h>
+#include <sys/stat.h>
 #include <LaunchServices/UTType.h>
 
-#define DATABASE_VERSION 1
+#define DATABASE_VERSION 2
 
 static FMDatabase* g_database;
 extern dispatch_queue_t g_serverQueue;
@@ -62,6 +64,17 @@ static FSEventStreamRef g_eventStream;
 	[super dealloc];
 }
 
+-(void)prepare
+{
+	NSURL* url = (NSURL*) CFBundleCopyBundleURL(_bundle);
+	NSDictionary* infoDict = (NSDictionary*) CFBundleGetInfoDictionary(_bundle);
+
+	_checksum = [[infoDict description] crc32];
+	_infoStamp = [LSBundle infoPlistStampForBundleAtPath: [url path]];
+
+	[url release];
+}
+
 -(void)processUTIs:(NSArray<NSDictionary<NSString*,id>*>*)utis
 {
 	NSNumber* ourBundleId = [NSNumber numberWithInt: _bundleId];
@@ -308,10 +321,11 @@ static FSEventStreamRef g_eventStream;
 	NSURL* url = (NSURL*) CFBundleCopyBundleURL(_bundle);
 	NSString* path = [url path];
 	NSDictionary* infoDict = (NSDictionary*) CFBundleGetInfoDictionary(_bundle);
-	const uint32_t newChecksum = [[infoDict description] crc32];
+	const uint32_t newChecksum = _checksum;
+	NSNumber* infoStamp = [NSNumber numberWithLongLong: _infoStamp];
 
 	[url release];
-	FMResultSet* rs = [g_database executeQuery:@"select id, checksum from bundle where path = ?", path];
+	FMResultSet* rs = [g_database executeQuery:@"select id, checksum, info_mtime from bundle where path = ?", path];
 
 	if ([rs next])
 	{
@@ -322,6 +336,16 @@ static FSEventStreamRef g_eventStream;
 		if (dbChecksum == newChecksum)
 		{
 			NSLog(@"Bundle at '%@' hasn't changed\n", path);
+
+			// Info.plist was touched without being changed; remember that, so that it's skipped up front next time
+			if ([rs longLongIntForColumn:@"info_mtime"] != _infoStamp)
+			{
+				[rs close];
+				[g_database executeUpdate:@"update bundle set info_mtime = ? where id = ?",
+					infoStamp, [NSNumber numberWithInt: _bundleId]];
+				return FALSE;
+			}
+
 			[rs close];
 			return FALSE;
 		}
@@ -347,8 +371,8 @@ static FSEventStreamRef g_eventStream;
 
 		NSLog(@"Registering new bundle at '%@', identifier '%@'\n", path, identifier);
 
-		[g_database executeUpdate:@"insert into bundle (path, bundle_id, checksum, package_type, creator, signature) values (?,?,?,?,?,?)",
-			path, identifier, [NSNumber numberWithInt:newChecksum], packageTypeStr, packageCreatorStr, bundleSignature];
+		[g_database executeUpdate:@"insert into bundle (path, bundle_id, checksum, info_mtime, package_type, creator, signature) values (?,?,?,?,?,?,?)",
+			path, identifier, [NSNumber numberWithInt:newChecksum], infoStamp, packageTypeStr, packageCreatorStr, bundleSignature];
 			
 		_bundleId = [g_database lastInsertRowId];
 	}
@@ -357,26 +381,19 @@ static FSEventStreamRef g_eventStream;
 		NSLog(@"Updating bundle at '%@'\n", path);
 
 		// We're in a transaction, so it's OK to set the new checksum now
-		[g_database executeUpdate:@"update bundle set checksum = ?, package_type = ?, creator = ?, signature = ? where id = ?",
-			[NSNumber numberWithInt:newChecksum], packageTypeStr, packageCreatorStr,
+		[g_database executeUpdate:@"update bundle set checksum = ?, info_mtime = ?, package_type = ?, creator = ?, signature = ? where id = ?",
+			[NSNumber numberWithInt:newChecksum], infoStamp, packageTypeStr, packageCreatorStr,
 			bundleSignature, [NSNumber numberWithInt: _bundleId]];
 	}
 
 	return TRUE;
 }
 
--(void)process
+// the caller is responsible for the transaction; `prepare` must have been called
+-(void)processInTransaction
 {
-	BOOL needsProcessing;
-
-	[g_database beginTransaction];
-	needsProcessing = [self setupBundleID];
-
-	if (!needsProcessing)
-	{
-		[g_database rollback];
+	if (![self setupBundleID])
 		return;
-	}
 
 	NSDictionary<NSString*,id>* infoDict = (NSDictionary*) CFBundleGetInfoDictionary(_bundle);
 
@@ -388,6 +405,14 @@ static FSEventStreamRef g_eventStream;
 
 	[self processFileAssociations];
 	[self processURLTypes];
+}
+
+-(void)process
+{
+	[self prepare];
+
+	[g_database beginTransaction];
+	[self processInTransaction];
 	[g_database commit];
 }
 
@@ -411,6 +436,9 @@ static FSEventStreamRef g_eventStream;
 		}
 		g_database = [db retain];
 
+		// WAL lets clients keep reading while we write, and makes our commits a lot cheaper
+		sqlite3_exec(g_database.sqliteHandle, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL; PRAGMA foreign_keys=ON;", NULL, NULL, NULL);
+
 		setupDBSchema();
 	}
 }
@@ -426,29 +454,113 @@ static FSEventStreamRef g_eventStream;
 	return [NSString stringWithCString:str encoding:NSASCIIStringEncoding];
 }
 
+// Returns the modification time of the bundle's Info.plist (in nanoseconds), or 0 if there's no Info.plist.
+// If this matches what we've stored, the bundle hasn't changed and we don't even need to parse it.
++(int64_t)infoPlistStampForBundleAtPath:(NSString*)path
+{
+	static NSString* const locations[] = {
+		@"Contents/Info.plist",
+		@"Resources/Info.plist",
+		@"Info.plist",
+	};
+
+	for (size_t i = 0; i < sizeof(locations) / sizeof(locations[0]); i++)
+	{
+		struct stat st;
+
+		if (stat([[path stringByAppendingPathComponent: locations[i]] fileSystemRepresentation], &st) == 0)
+			return (int64_t) st.st_mtimespec.tv_sec * NSEC_PER_SEC + st.st_mtimespec.tv_nsec;
+	}
+
+	return 0;
+}
+
 +(void)scanForBundles:(NSString*)dir
 {
 	@autoreleasepool
 	{
-		NSURL* url = [NSURL fileURLWithPath:dir isDirectory:YES];
-		NSArray* bundles = (NSArray*) CFBundleCreateBundlesFromDirectory(NULL, (CFURLRef) url, NULL);
+		NSArray<NSString*>* names = [[NSFileManager defaultManager] contentsOfDirectoryAtPath: dir error: nil];
+		NSMutableDictionary<NSString*, NSNumber*>* knownStamps = [NSMutableDictionary dictionary];
+		NSMutableArray<NSString*>* changed = [NSMutableArray array];
+		NSMutableSet<NSString*>* present = [NSMutableSet set];
+
+		FMResultSet* rs = [g_database executeQuery:@"select path, info_mtime from bundle where path like ?",
+			[dir stringByAppendingString: @"/%"]];
+		while ([rs next])
+		{
+			NSString* path = [rs stringForColumn: @"path"];
+			if ([[path stringByDeletingLastPathComponent] isEqualToString: dir])
+				knownStamps[path] = [NSNumber numberWithLongLong: [rs longLongIntForColumn: @"info_mtime"]];
+		}
+		[rs close];
+
+		for (NSString* name in names)
+		{
+			NSString* path = [dir stringByAppendingPathComponent: name];
+			const int64_t stamp = [LSBundle infoPlistStampForBundleAtPath: path];
+
+			// CFBundle would give us bundles for any directory, but without an Info.plist there's nothing to register
+			if (stamp == 0)
+				continue;
+
+			[present addObject: path];
+
+			NSNumber* knownStamp = knownStamps[path];
+			if (knownStamp == nil || [knownStamp longLongValue] != stamp)
+				[changed addObject: path];
+		}
+
+		// Info.plist parsing is what takes time, and it doesn't need the database, so it's done in parallel;
+		// the results are then written in one transaction
+		const size_t count = [changed count];
+		LSBundle** prepared = (LSBundle**) calloc(count, sizeof(LSBundle*));
+
+		dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+			@autoreleasepool
+			{
+				NSURL* url = [NSURL fileURLWithPath: changed[i] isDirectory: YES];
+				CFBundleRef bundle = CFBundleCreate(NULL, (CFURLRef) url);
+
+				if (bundle == NULL)
+					return;
+
+				if (CFBundleGetIdentifier(bundle) != NULL)
+				{
+					prepared[i] = [[LSBundle alloc] initWithBundle: bundle];
+					[prepared[i] prepare];
+				}
+
+				CFRelease(bundle);
+			}
+		});
 
-		for (id bundle in bundles)
+		[g_database beginTransaction];
+
+		for (size_t i = 0; i < count; i++)
 		{
-			// CFBundle is not exactly clever and gives us CFBundles of empty directories
-			if (CFBundleGetIdentifier((CFBundleRef) bundle) == NULL)
+			if (prepared[i] == nil)
 				continue;
 
 			@autoreleasepool
 			{
-				LSBundle* b = [[[LSBundle alloc] initWithBundle: (CFBundleRef) bundle] autorelease];
-				[b process];
+				[prepared[i] processInTransaction];
 			}
+			[prepared[i] release];
+		}
 
-			CFRelease((CFBundleRef) bundle);
+		for (NSString* path in knownStamps)
+		{
+			if (![present containsObject: path])
+			{
+				NSLog(@"Bundle at '%@' is gone\n", path);
+				[g_database executeUpdate: @"delete from bundle where path = ?", path];
+			}
 		}
 
-		[bundles release];
+		[g_database commit];
+		free(prepared);
+
+		NSLog(@"Scanned %lu bundles in '%@', %lu of them changed\n", (unsigned long) [present count], dir, (unsigned long) count);
 	}
 }
 
@@ -456,6 +568,7 @@ static FSEventStreamRef g_eventStream;
 {
 	for (NSString* dir in MONITORED_DIRECTORIES)
 		[LSBundle scanForBundles: dir];
+	writeUTTypeSnapshot(g_database);
 	NSLog(@"scanForBundles done\n");
 }
 
@@ -472,7 +585,7 @@ static FSEventStreamRef g_eventStream;
 {
 	// Delete DB entries referring to path
 	[g_database beginTransaction];
-	[g_database executeQuery: @"delete from bundle where path = ?", path];
+	[g_database executeUpdate: @"delete from bundle where path = ?", path];
 	[g_database commit];
 }
 
@@ -508,11 +621,21 @@ static void setupDBSchema(void)
 	}
 	else
 	{
-		if ([rs intForColumn: @"value"] != DATABASE_VERSION)
+		const int version = [rs intForColumn: @"value"];
+		[rs close];
+
+		if (version == 1)
+		{
+			// version 2 added bundle.info_mtime; existing bundles get 0, so they're checked once more by their checksum
+			[g_database beginTransaction];
+			[g_database executeUpdate: @"alter table bundle add column info_mtime INTEGER NOT NULL DEFAULT 0"];
+			[g_database executeUpdate: @"update globals set value = ? where key = ?", @"2", @"version"];
+			[g_database commit];
+		}
+		else if (version != DATABASE_VERSION)
 		{
 			// TODO: This is where we'll do DB schema updates or possibly just delete everything and index from scratch
 		}
-		[rs close];
 	}
 }
 
@@ -521,6 +644,7 @@ static void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBac
 {
 	NSArray<NSString*>* changes = (NSArray*) eventPaths;
 	int index = 0;
+	BOOL changed = NO;
 	for (NSString* change in changes)
 	{
 		@autoreleasepool
@@ -543,6 +667,7 @@ static void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBac
 					{
 						[LSBundle deleteBundleAtPath:bundlePath];
 					}
+					changed = YES;
 				}
 
 				// TODO: If somebody renames the bundle's directory, we still need to pick it up
@@ -550,4 +675,7 @@ static void fsEventCallback(ConstFSEventStreamRef streamRef, void *clientCallBac
 		}
 		index++;
 	}
+
+	if (changed)
+		writeUTTypeSnapshot(g_database);
 }
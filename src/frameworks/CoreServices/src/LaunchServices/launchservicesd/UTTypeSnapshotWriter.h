@@ -0,0 +1,28 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2020 Lubos Dolezel
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _LSD_UTTYPE_SNAPSHOT_WRITER_H
+#define _LSD_UTTYPE_SNAPSHOT_WRITER_H
+#import <fmdb/FMDatabase.h>
+
+// Builds a snapshot of the UTI tables (see UTTypeSnapshot.h) and atomically replaces LS_UTI_SNAPSHOT_PATH with it.
+// Call this after committing changes to UTIs.
+void writeUTTypeSnapshot(FMDatabase* db);
+
+#endif
@@ -0,0 +1,389 @@
+/*
+This file is part of Darling.
+
+Copyright (C) 2020 Lubos Dolezel
+
+Darling is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Darling is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Darling.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "UTTypeSnapshotWriter.h"
+#include "../UTTypeSnapshot.h"
+#import <Foundation/Foundation.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SNAPSHOT_TEMP_PATH LS_UTI_SNAPSHOT_PATH ".new"
+
+// The database compares identifiers and tag values with COLLATE NOCASE, which only folds ASCII; so does the snapshot
+static NSString* foldedString(NSString* str)
+{
+	const char* utf8 = [str UTF8String];
+	const size_t length = strlen(utf8);
+	char* folded = (char*) malloc(length);
+
+	for (size_t i = 0; i < length; i++)
+		folded[i] = (utf8[i] >= 'A' && utf8[i] <= 'Z') ? (utf8[i] + 'a' - 'A') : utf8[i];
+
+	return [[[NSString alloc] initWithBytesNoCopy: folded length: length encoding: NSUTF8StringEncoding freeWhenDone: YES] autorelease];
+}
+
+static uint32_t nextPowerOfTwo(uint32_t min)
+{
+	uint32_t value = 16;
+	while (value < min)
+		value <<= 1;
+	return value;
+}
+
+@interface UTTypeSnapshotTypes : NSObject
+{
+@public
+	NSMutableArray<NSString*>* identifiers;
+	// NSNull for types that aren't declared by any bundle
+	NSMutableArray* descriptions;
+	NSMutableArray<NSMutableOrderedSet<NSNumber*>*>* parents;
+	NSMutableDictionary<NSString*, NSNumber*>* indices;
+}
+-(uint32_t)intern:(NSString*)identifier;
+@end
+
+@implementation UTTypeSnapshotTypes
+-(id)init
+{
+	self = [super init];
+	identifiers = [NSMutableArray new];
+	descriptions = [NSMutableArray new];
+	parents = [NSMutableArray new];
+	indices = [NSMutableDictionary new];
+	return self;
+}
+
+-(void)dealloc
+{
+	[identifiers release];
+	[descriptions release];
+	[parents release];
+	[indices release];
+	[super dealloc];
+}
+
+-(uint32_t)intern:(NSString*)identifier
+{
+	NSString* key = foldedString(identifier);
+	NSNumber* index = indices[key];
+
+	if (index != nil)
+		return [index unsignedIntValue];
+
+	const uint32_t newIndex = [identifiers count];
+	[identifiers addObject: identifier];
+	[descriptions addObject: [NSNull null]];
+	[parents addObject: [NSMutableOrderedSet orderedSet]];
+	indices[key] = [NSNumber numberWithUnsignedInt: newIndex];
+
+	return newIndex;
+}
+@end
+
+static uint32_t addString(NSMutableData* strings, NSMutableDictionary<NSString*, NSNumber*>* offsets, NSString* str)
+{
+	NSNumber* known = offsets[str];
+	if (known != nil)
+		return [known unsignedIntValue];
+
+	const char* utf8 = [str UTF8String];
+	const uint32_t offset = [strings length];
+
+	[strings appendBytes: utf8 length: strlen(utf8) + 1];
+	offsets[str] = [NSNumber numberWithUnsignedInt: offset];
+
+	return offset;
+}
+
+// Propagates every type's parents' rows into its own row until nothing changes.
+// Hierarchies are shallow, so this only takes a few passes, and it copes with cycles, too.
+static void computeConformance(uint32_t* rows, uint32_t words, const struct ls_uti_type* types, uint32_t typeCount, const uint32_t* parents)
+{
+	bool changed;
+
+	for (uint32_t i = 0; i < typeCount; i++)
+	{
+		uint32_t* row = rows + (size_t) i * words;
+
+		row[i / 32] |= 1u << (i % 32);
+		for (const uint32_t* parent = parents + types[i].parents; *parent != LS_UTI_NONE; parent++)
+			row[*parent / 32] |= 1u << (*parent % 32);
+	}
+
+	do
+	{
+		changed = false;
+
+		for (uint32_t i = 0; i < typeCount; i++)
+		{
+			uint32_t* row = rows + (size_t) i * words;
+
+			for (const uint32_t* parent = parents + types[i].parents; *parent != LS_UTI_NONE; parent++)
+			{
+				const uint32_t* parentRow = rows + (size_t) *parent * words;
+
+				for (uint32_t k = 0; k < words; k++)
+				{
+					const uint32_t merged = row[k] | parentRow[k];
+					if (merged != row[k])
+					{
+						row[k] = merged;
+						changed = true;
+					}
+				}
+			}
+		}
+	}
+	while (changed);
+}
+
+static NSData* buildSnapshot(FMDatabase* db)
+{
+	UTTypeSnapshotTypes* types = [[[UTTypeSnapshotTypes alloc] init] autorelease];
+	FMResultSet* rs;
+
+	rs = [db executeQuery: @"select type_identifier, description from uti order by id"];
+	while ([rs next])
+	{
+		const uint32_t index = [types intern: [rs stringForColumnIndex: 0]];
+		NSString* description = [rs stringForColumnIndex: 1];
+
+		if (types->descriptions[index] == [NSNull null])
+			types->descriptions[index] = (description != nil) ? description : @"";
+	}
+	[rs close];
+
+	rs = [db executeQuery: @"select U.type_identifier, UC.conforms_to from uti_conforms UC inner join uti U on U.id = UC.uti order by UC.id"];
+	while ([rs next])
+	{
+		const uint32_t index = [types intern: [rs stringForColumnIndex: 0]];
+		const uint32_t parent = [types intern: [rs stringForColumnIndex: 1]];
+
+		if (parent != index)
+			[types->parents[index] addObject: [NSNumber numberWithUnsignedInt: parent]];
+	}
+	[rs close];
+
+	// tags with the same class and (folded) value end up in one group
+	NSMutableDictionary<NSString*, NSMutableArray<NSArray*>*>* tagGroups = [NSMutableDictionary dictionary];
+	NSMutableArray<NSString*>* tagGroupOrder = [NSMutableArray array];
+	uint32_t tagCount = 0;
+
+	rs = [db executeQuery: @"select U.type_identifier, UT.tag, UT.value from uti_tag UT inner join uti U on U.id = UT.uti order by UT.id"];
+	while ([rs next])
+	{
+		NSNumber* index = [NSNumber numberWithUnsignedInt: [types intern: [rs stringForColumnIndex: 0]]];
+		NSString* tagClass = [rs stringForColumnIndex: 1];
+		NSString* value = [rs stringForColumnIndex: 2];
+		NSString* key = [NSString stringWithFormat: @"%@\n%@", tagClass, foldedString(value)];
+		NSMutableArray<NSArray*>* group = tagGroups[key];
+
+		if (group == nil)
+		{
+			group = [NSMutableArray array];
+			tagGroups[key] = group;
+			[tagGroupOrder addObject: key];
+		}
+
+		BOOL duplicate = NO;
+		for (NSArray* tag in group)
+		{
+			if ([tag[2] isEqual: index])
+			{
+				duplicate = YES;
+				break;
+			}
+		}
+
+		if (!duplicate)
+		{
+			[group addObject: @[tagClass, value, index]];
+			tagCount++;
+		}
+	}
+	[rs close];
+
+	const uint32_t typeCount = [types->identifiers count];
+	uint32_t parentCount = typeCount;
+
+	for (NSOrderedSet* parents in types->parents)
+		parentCount += [parents count];
+
+	const uint32_t words = (typeCount + 31) / 32;
+	const uint32_t typeSlotCount = nextPowerOfTwo(typeCount * 2);
+	const uint32_t tagSlotCount = nextPowerOfTwo([tagGroupOrder count] * 2);
+
+	NSMutableData* strings = [NSMutableData data];
+	NSMutableDictionary<NSString*, NSNumber*>* stringOffsets = [NSMutableDictionary dictionary];
+
+	// the string section goes last, so its size doesn't need to be known before the other sections are filled in
+	struct ls_uti_snapshot header = {
+		.version = LS_UTI_SNAPSHOT_VERSION,
+		.type_count = typeCount,
+		.conformance_words = words,
+		.type_slot_count = typeSlotCount,
+		.tag_count = tagCount,
+		.tag_slot_count = tagSlotCount,
+	};
+	uint64_t offset = sizeof(header);
+
+	memcpy(header.magic, LS_UTI_SNAPSHOT_MAGIC, sizeof(header.magic));
+
+	header.types_offset = offset;
+	offset += (uint64_t) typeCount * sizeof(struct ls_uti_type);
+	header.parents_offset = offset;
+	offset += (uint64_t) parentCount * sizeof(uint32_t);
+	header.conformance_offset = offset;
+	offset += (uint64_t) typeCount * words * sizeof(uint32_t);
+	header.type_slots_offset = offset;
+	offset += (uint64_t) typeSlotCount * sizeof(uint32_t);
+	header.tags_offset = offset;
+	offset += (uint64_t) tagCount * sizeof(struct ls_uti_tag);
+	header.tag_slots_offset = offset;
+	offset += (uint64_t) tagSlotCount * sizeof(uint32_t);
+	header.strings_offset = offset;
+
+	if (offset > UINT32_MAX / 2)
+	{
+		NSLog(@"launchservicesd: too many UTIs (%u) for a snapshot\n", typeCount);
+		return nil;
+	}
+
+	NSMutableData* data = [NSMutableData dataWithLength: offset];
+	char* base = (char*) [data mutableBytes];
+	struct ls_uti_type* outTypes = (struct ls_uti_type*) (base + header.types_offset);
+	uint32_t* outParents = (uint32_t*) (base + header.parents_offset);
+	uint32_t* typeSlots = (uint32_t*) (base + header.type_slots_offset);
+	struct ls_uti_tag* outTags = (struct ls_uti_tag*) (base + header.tags_offset);
+	uint32_t* tagSlots = (uint32_t*) (base + header.tag_slots_offset);
+	uint32_t parentPos = 0;
+
+	for (uint32_t i = 0; i < typeCount; i++)
+	{
+		NSString* identifier = types->identifiers[i];
+		id description = types->descriptions[i];
+
+		outTypes[i].identifier = addString(strings, stringOffsets, identifier);
+		outTypes[i].description = (description != [NSNull null]) ? addString(strings, stringOffsets, description) : LS_UTI_NONE;
+		outTypes[i].parents = parentPos;
+
+		for (NSNumber* parent in types->parents[i])
+			outParents[parentPos++] = [parent unsignedIntValue];
+		outParents[parentPos++] = LS_UTI_NONE;
+
+		const char* utf8 = [identifier UTF8String];
+		uint32_t slot = ls_uti_hash(utf8, strlen(utf8)) & (typeSlotCount - 1);
+
+		while (typeSlots[slot] != 0)
+			slot = (slot + 1) & (typeSlotCount - 1);
+		typeSlots[slot] = i + 1;
+	}
+
+	computeConformance((uint32_t*) (base + header.conformance_offset), words, outTypes, typeCount, outParents);
+
+	uint32_t tagPos = 0;
+	for (NSString* key in tagGroupOrder)
+	{
+		NSArray<NSArray*>* group = tagGroups[key];
+		const uint32_t first = tagPos;
+
+		for (NSArray* tag in group)
+		{
+			outTags[tagPos].tag_class = addString(strings, stringOffsets, tag[0]);
+			outTags[tagPos].value = addString(strings, stringOffsets, tag[1]);
+			outTags[tagPos].type = [tag[2] unsignedIntValue];
+			outTags[tagPos].group_count = 0;
+			tagPos++;
+		}
+		outTags[first].group_count = tagPos - first;
+
+		const char* tagClass = [group[0][0] UTF8String];
+		const char* value = [group[0][1] UTF8String];
+		uint32_t slot = ls_uti_tag_hash(tagClass, strlen(tagClass), value, strlen(value)) & (tagSlotCount - 1);
+
+		while (tagSlots[slot] != 0)
+			slot = (slot + 1) & (tagSlotCount - 1);
+		tagSlots[slot] = first + 1;
+	}
+
+	header.strings_size = [strings length];
+	header.size = offset + header.strings_size;
+	memcpy(base, &header, sizeof(header));
+	[data appendData: strings];
+
+	return data;
+}
+
+void writeUTTypeSnapshot(FMDatabase* db)
+{
+	@autoreleasepool
+	{
+		NSData* data = buildSnapshot(db);
+		if (data == nil)
+			return;
+
+		int fd = open(SNAPSHOT_TEMP_PATH, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd == -1)
+		{
+			NSLog(@"launchservicesd: cannot create %s: %s\n", SNAPSHOT_TEMP_PATH, strerror(errno));
+			return;
+		}
+
+		const char* bytes = (const char*) [data bytes];
+		size_t remaining = [data length];
+
+		while (remaining > 0)
+		{
+			ssize_t written = write(fd, bytes, remaining);
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+
+				NSLog(@"launchservicesd: cannot write %s: %s\n", SNAPSHOT_TEMP_PATH, strerror(errno));
+				close(fd);
+				unlink(SNAPSHOT_TEMP_PATH);
+				return;
+			}
+			bytes += written;
+			remaining -= written;
+		}
+		close(fd);
+
+		// clients keep the old file mapped; once the new one is in place, tell them to switch
+		int oldFd = open(LS_UTI_SNAPSHOT_PATH, O_RDWR | O_CLOEXEC);
+
+		if (rename(SNAPSHOT_TEMP_PATH, LS_UTI_SNAPSHOT_PATH) != 0)
+		{
+			NSLog(@"launchservicesd: cannot replace %s: %s\n", LS_UTI_SNAPSHOT_PATH, strerror(errno));
+			unlink(SNAPSHOT_TEMP_PATH);
+		}
+		else if (oldFd != -1)
+		{
+			const uint32_t stale = 1;
+			pwrite(oldFd, &stale, sizeof(stale), offsetof(struct ls_uti_snapshot, stale));
+		}
+
+		if (oldFd != -1)
+			close(oldFd);
+	}
+}
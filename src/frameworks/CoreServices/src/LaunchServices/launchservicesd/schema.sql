@@ -1,11 +1,12 @@
 CREATE TABLE `globals` (`key` TEXT PRIMARY KEY, `value` TEXT);
-INSERT INTO `globals` (`key`, `value`) VALUES ('version', '1');
+INSERT INTO `globals` (`key`, `value`) VALUES ('version', '2');
 
 CREATE TABLE `bundle` (
 	`id` INTEGER PRIMARY KEY AUTOINCREMENT,
 	`path` TEXT NOT NULL,
 	`bundle_id` TEXT NOT NULL,
 	`checksum` INTEGER NOT NULL,
+	`info_mtime` INTEGER NOT NULL DEFAULT 0, -- lets us skip bundles without even parsing their Info.plist
 	'package_type' TEXT,
 	'creator' TEXT,
 	'signature' TEXT
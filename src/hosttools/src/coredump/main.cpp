@@ -1,4 +1,7 @@
 #include <filesystem>
+#include <thread>
+#include <vector>
+#include <atomic>
 
 #include <stdio.h>
 #include <unistd.h>
@@ -11,6 +14,7 @@
 #include <sys/stat.h>
 #include <pwd.h>
 #include <libgen.h>
+#include <getopt.h>
 
 #include <mach-o/loader.h>
 #include <elf.h>
@@ -198,6 +202,13 @@ struct coredump_params {
 	const char* main_executable_path;
 	size_t main_executable_path_length;
 	bool is_64_bit;
+	// end of the last region in the output file; computed while writing the load commands
+	uint64_t output_size;
+	// leave zero-filled space as holes instead of allocating it
+	bool sparse;
+	// the filesystem couldn't preallocate the non-sparse output, so zeros have to be written out
+	bool zero_fill;
+	unsigned int jobs;
 };
 
 static char default_output_name[4096];
@@ -207,10 +218,6 @@ static uint64_t round_up_pow2(uint64_t number, uint64_t multiple) {
 	return (number + (multiple - 1)) & -multiple;
 };
 
-static uint64_t round_down_pow2(uint64_t number, uint64_t multiple) {
-	return (number) & -multiple;
-};
-
 static const char* note_name(const struct coredump_params* cprm, const union Elf_Nhdr* note) {
 	return (const char*)note + (cprm->is_64_bit ? sizeof(note->elf64) : sizeof(note->elf64));
 };
@@ -274,14 +281,54 @@ static int open_file(struct coredump_params* cprm, const char* filename, size_t
 
 void macho_coredump(struct coredump_params* cprm);
 
+static void usage(const char* argv0) {
+	fprintf(stderr, "Usage: %s [--lldb-compat] [--jobs <count>] <input-coredump> [output-coredump]\n", argv0);
+	fprintf(stderr, "  --lldb-compat      allocate zero-filled regions instead of leaving holes in the output\n");
+	fprintf(stderr, "  -j, --jobs <count> number of threads used to write the memory regions\n");
+};
+
 int main(int argc, char** argv) {
-	if (argc < 2) {
-		fprintf(stderr, "Usage: %s <input-coredump> [output-coredump]\n", (argc > 0 ? argv[0] : "darling-coredump"));
+	const char* argv0 = (argc > 0 ? argv[0] : "darling-coredump");
+	bool lldb_compat = false;
+	long jobs = sysconf(_SC_NPROCESSORS_ONLN);
+
+	static const struct option long_options[] = {
+		{ "lldb-compat", no_argument, NULL, 'L' },
+		{ "jobs", required_argument, NULL, 'j' },
+		{ NULL, 0, NULL, 0 },
+	};
+
+	int opt;
+	while ((opt = getopt_long(argc, argv, "j:", long_options, NULL)) != -1) {
+		switch (opt) {
+			case 'L':
+				lldb_compat = true;
+				break;
+			case 'j': {
+				char* end = NULL;
+				jobs = strtol(optarg, &end, 10);
+				if (*end != '\0' || jobs < 1) {
+					fprintf(stderr, "Invalid job count: %s\n", optarg);
+					return 1;
+				}
+				break;
+			}
+			default:
+				usage(argv0);
+				return 1;
+		}
+	}
+
+	if (argc - optind < 1 || argc - optind > 2) {
+		usage(argv0);
 		return 1;
 	}
 
-	char *tmp_output_dirname = strdup(argv[1]);
-	char *tmp_output_basename = strdup(argv[1]);
+	const char* input_path = argv[optind];
+	const char* output_path = (argc - optind > 1) ? argv[optind + 1] : NULL;
+
+	char *tmp_output_dirname = strdup(input_path);
+	char *tmp_output_basename = strdup(input_path);
 	if (snprintf(default_output_name, sizeof(default_output_name), "%s/darlingcore-%s", dirname(tmp_output_dirname), basename(tmp_output_basename)) < 0) {
 		perror("snprintf");
 		return 1;
@@ -312,8 +359,10 @@ int main(int argc, char** argv) {
 	}
 
 	cprm.prefix_length = strlen(cprm.prefix);
+	cprm.sparse = !lldb_compat;
+	cprm.jobs = (jobs < 1) ? 1 : jobs;
 
-	cprm.input_corefile = open(argv[1], O_RDONLY);
+	cprm.input_corefile = open(input_path, O_RDONLY);
 	if (cprm.input_corefile < 0) {
 		perror("open input");
 		return 1;
@@ -327,7 +376,7 @@ int main(int argc, char** argv) {
 	cprm.input_corefile_size = input_corefile_stats.st_size;
 	cprm.input_corefile_mapping = mmap(NULL, cprm.input_corefile_size, PROT_READ, MAP_PRIVATE, cprm.input_corefile, 0);
 
-	cprm.output_corefile = open((argc > 2 ? argv[2] : default_output_name), O_WRONLY | O_TRUNC | O_CREAT, 0644);
+	cprm.output_corefile = open((output_path ? output_path : default_output_name), O_WRONLY | O_TRUNC | O_CREAT, 0644);
 	if (cprm.output_corefile < 0) {
 		perror("open output");
 		return 1;
@@ -654,23 +703,21 @@ static bool dump_emit(struct coredump_params* cprm, const void* buffer, size_t b
 	return true;
 };
 
-static bool dump_skip(struct coredump_params* cprm, size_t size) {
-	// leaving holes seems to confuse LLDB
-#if 0
-	if (lseek(cprm->output_corefile, size, SEEK_CUR) < 0) {
-		perror("lseek");
-		return false;
-	}
-#else
-	static char zeros[4096];
-	while (sizeof(zeros) < size) {
-		if (!dump_emit(cprm, zeros, sizeof(zeros)))
-			return false;
-		size -= sizeof(zeros);
+static bool dump_pwrite(struct coredump_params* cprm, const void* buffer, size_t buffer_size, uint64_t offset) {
+	while (buffer_size > 0) {
+		ssize_t written = pwrite(cprm->output_corefile, buffer, buffer_size, offset);
+		if (written < 0) {
+			if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+				continue;
+			} else {
+				return false;
+			}
+		} else {
+			buffer_size -= written;
+			buffer = (const char*)buffer + written;
+			offset += written;
+		}
 	}
-	if (!dump_emit(cprm, zeros, size))
-		return false;
-#endif
 	return true;
 };
 
@@ -678,10 +725,196 @@ static uint64_t dump_offset_get(struct coredump_params* cprm) {
 	return lseek(cprm->output_corefile, 0, SEEK_CUR);
 };
 
-static bool dump_align(struct coredump_params* cprm, size_t alignment) {
-	uint64_t offset = dump_offset_get(cprm);
-	uint64_t aligned = round_up_pow2(offset, alignment);
-	return dump_skip(cprm, aligned - offset);
+// the output is extended to its full size before any region is written, so unwritten space already reads as zeros.
+// we only need to write them out if the output has to be non-sparse and the filesystem can't preallocate it.
+static bool dump_zero(struct coredump_params* cprm, uint64_t offset, uint64_t size) {
+	static const char zeros[64 * 1024] = {0};
+
+	if (!cprm->zero_fill) {
+		return true;
+	}
+
+	while (size > 0) {
+		size_t count = (size < sizeof(zeros)) ? size : sizeof(zeros);
+		if (!dump_pwrite(cprm, zeros, count, offset)) {
+			perror("pwrite");
+			return false;
+		}
+		offset += count;
+		size -= count;
+	}
+	return true;
+};
+
+#define DUMP_COPY_BUFFER_SIZE (1024 * 1024)
+
+// copies `size` bytes at `input_offset` in `fd` to `output_offset` in the output, stopping early if `fd` ends first.
+// the kernel does the copy if it can (which may just share the blocks on filesystems like btrfs or XFS);
+// otherwise we fall back to reading and writing it ourselves.
+static bool dump_copy_range(struct coredump_params* cprm, int fd, uint64_t input_offset, uint64_t output_offset, uint64_t size, uint64_t* copied) {
+	loff_t input_position = input_offset;
+	loff_t output_position = output_offset;
+	char* buffer = NULL;
+	bool ok = true;
+
+	*copied = 0;
+
+	while (*copied < size) {
+		ssize_t count;
+
+		if (!buffer) {
+			count = copy_file_range(fd, &input_position, cprm->output_corefile, &output_position, size - *copied, 0);
+			if (count < 0) {
+				if (errno == EINTR) {
+					continue;
+				} else if (errno == EXDEV || errno == ENOSYS || errno == EOPNOTSUPP || errno == EINVAL) {
+					// e.g. the files are on different filesystems
+					buffer = (char*)malloc(DUMP_COPY_BUFFER_SIZE);
+					if (!buffer) {
+						perror("malloc");
+						return false;
+					}
+					continue;
+				} else {
+					perror("copy_file_range");
+					ok = false;
+					break;
+				}
+			}
+		} else {
+			uint64_t remaining = size - *copied;
+			count = pread(fd, buffer, (remaining < DUMP_COPY_BUFFER_SIZE) ? remaining : DUMP_COPY_BUFFER_SIZE, input_position);
+			if (count < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				perror("pread");
+				ok = false;
+				break;
+			}
+			if (!dump_pwrite(cprm, buffer, count, output_position)) {
+				perror("pwrite");
+				ok = false;
+				break;
+			}
+			input_position += count;
+			output_position += count;
+		}
+
+		if (count == 0) {
+			// end of file
+			break;
+		}
+
+		*copied += count;
+	}
+
+	free(buffer);
+	return ok;
+};
+
+// copies a region's contents from `fd` to the output. anything past the end of `fd` reads as zeros.
+// when writing a sparse output, holes in `fd` (e.g. pages the kernel skipped in the ELF core) stay holes.
+static bool dump_copy(struct coredump_params* cprm, int fd, uint64_t input_offset, uint64_t output_offset, uint64_t size) {
+	uint64_t done = 0;
+
+	while (done < size) {
+		uint64_t data_start = done;
+		uint64_t data_end = size;
+		uint64_t copied;
+
+		if (cprm->sparse) {
+			off_t data = lseek(fd, input_offset + done, SEEK_DATA);
+			if (data < 0) {
+				if (errno == ENXIO) {
+					// only holes from here to the end of the file
+					break;
+				} else if (errno != EINVAL) {
+					perror("lseek");
+					return false;
+				}
+				// no SEEK_DATA support; treat everything as data
+			} else {
+				if ((uint64_t)data >= input_offset + size) {
+					break;
+				}
+				data_start = data - input_offset;
+
+				off_t hole = lseek(fd, data, SEEK_HOLE);
+				if (hole >= 0 && (uint64_t)hole < input_offset + size) {
+					data_end = hole - input_offset;
+				}
+			}
+		}
+
+		if (!dump_copy_range(cprm, fd, input_offset + data_start, output_offset + data_start, data_end - data_start, &copied)) {
+			return false;
+		}
+
+		if (copied < data_end - data_start) {
+			// the file is shorter than the region (e.g. the last page of a mapped file)
+			return dump_zero(cprm, output_offset + data_start + copied, size - data_start - copied);
+		}
+
+		done = data_end;
+	}
+
+	return true;
+};
+
+// regions are split into pieces of at most this size so that a single huge region gets spread across threads
+#define DUMP_CHUNK_SIZE (64ull * 1024 * 1024)
+
+enum dump_source {
+	DUMP_SOURCE_ZERO,
+	DUMP_SOURCE_COREFILE,
+	DUMP_SOURCE_FILE,
+};
+
+struct dump_task {
+	enum dump_source source;
+	// the region being copied; NULL for zeros
+	const struct vm_area* vma;
+	uint64_t input_offset;
+	uint64_t output_offset;
+	uint64_t size;
+};
+
+static void dump_plan(struct coredump_params* cprm, std::vector<struct dump_task>& tasks, enum dump_source source, const struct vm_area* vma, uint64_t input_offset, uint64_t output_offset, uint64_t size) {
+	if (source == DUMP_SOURCE_ZERO && !cprm->zero_fill) {
+		return;
+	}
+
+	while (size > 0) {
+		uint64_t chunk = (size < DUMP_CHUNK_SIZE) ? size : DUMP_CHUNK_SIZE;
+		tasks.push_back({ source, vma, input_offset, output_offset, chunk });
+		input_offset += chunk;
+		output_offset += chunk;
+		size -= chunk;
+	}
+};
+
+static bool dump_run_task(struct coredump_params* cprm, const struct dump_task* task) {
+	switch (task->source) {
+		case DUMP_SOURCE_ZERO:
+			return dump_zero(cprm, task->output_offset, task->size);
+
+		case DUMP_SOURCE_COREFILE:
+			return dump_copy(cprm, cprm->input_corefile, task->input_offset, task->output_offset, task->size);
+
+		case DUMP_SOURCE_FILE: {
+			int fd = open_file(cprm, task->vma->filename, task->vma->filename_length);
+			if (fd < 0) {
+				fprintf(stderr, "Failed to reopen %s: %d (%s)\n", task->vma->filename, errno, strerror(errno));
+				return false;
+			}
+			bool ok = dump_copy(cprm, fd, task->input_offset, task->output_offset, task->size);
+			close(fd);
+			return ok;
+		}
+	}
+
+	return false;
 };
 
 // the following coredump code has been imported from the LKM and adapted for use in userspace
@@ -857,6 +1090,8 @@ bool macho_dump_headers32(struct coredump_params* cprm)
 		file_offset += round_up_pow2(sc.filesize, align_page_size);
 	}
 
+	cprm->output_size = file_offset;
+
 	const int memsize = sizeof(struct thread_command) + statesize;
 	uint8_t* buffer = (uint8_t*)malloc(memsize);
 
@@ -1003,6 +1238,8 @@ bool macho_dump_headers64(struct coredump_params* cprm)
 		file_offset += round_up_pow2(sc.filesize, align_page_size);
 	}
 
+	cprm->output_size = file_offset;
+
 	const int memsize = sizeof(struct thread_command) + statesize;
 	uint8_t* buffer = (uint8_t*)malloc(memsize);
 
@@ -1066,88 +1303,119 @@ void macho_coredump(struct coredump_params* cprm)
 	}
 
 	// Dump memory contents
+	//
+	// every region's offset in the output was decided while writing the load commands (`expected_offset`),
+	// so the regions can be written in any order and by several threads at once.
 
 	uint64_t align_page_size = ALIGN_REGIONS ? sysconf(_SC_PAGESIZE) : 1;
-
-	if (!dump_align(cprm, align_page_size))
+	uint64_t header_end = dump_offset_get(cprm);
+
+	// extend the output to its final size up-front; everything we don't write reads as zeros.
+	// LLDB used to get confused by the holes left by seeking past regions, most likely because a trailing
+	// zero-filled region left the file shorter than the load commands said it was. that can't happen now,
+	// but --lldb-compat still allocates all of the zero-filled space in case something relies on it.
+	if (ftruncate(cprm->output_corefile, cprm->output_size) < 0) {
+		perror("ftruncate");
 		exit(EXIT_FAILURE);
+	}
+
+	if (!cprm->sparse && cprm->output_size > header_end) {
+		if (fallocate(cprm->output_corefile, 0, header_end, cprm->output_size - header_end) < 0) {
+			if (errno != EOPNOTSUPP) {
+				perror("fallocate");
+				exit(EXIT_FAILURE);
+			}
+			cprm->zero_fill = true;
+		}
+	}
 
 	// Inspired by elf_core_dump()
+	std::vector<struct dump_task> tasks;
+	uint64_t zero_start = header_end;
+
 	for (size_t i = 0; i < cprm->vm_area_count; ++i) {
 		const struct vm_area* vma = &cprm->vm_areas[i];
-		unsigned long addr;
 
 		if (!vma->valid) {
 			continue;
 		}
 
-		uint64_t curr = dump_offset_get(cprm);
-		if (curr != vma->expected_offset) {
-			fprintf(stderr, "Expected offset %lx, got offset %lx\n", vma->expected_offset, curr);
+		if (vma->expected_offset < zero_start || vma->expected_offset != round_up_pow2(vma->expected_offset, align_page_size)) {
+			fprintf(stderr, "Unexpected offset %lx for region at %lx\n", vma->expected_offset, vma->memory_address);
 			exit(EXIT_FAILURE);
 		}
 
+		// anything between the previous region (or the load commands) and this one is alignment padding
+		dump_plan(cprm, tasks, DUMP_SOURCE_ZERO, NULL, 0, zero_start, vma->expected_offset - zero_start);
+		zero_start = vma->expected_offset;
+
 		if (vma->file_size == 0) {
 			// this region needs to be zeroed out
 			//
 			// it's likely a region that was allocated with mmap but never accessed,
 			// so it remained zero-filled and there was no need to include it in the ELF core file.
-			if (!dump_skip(cprm, vma->memory_size))
-				exit(EXIT_FAILURE);
+			zero_start += vma->memory_size;
 			continue;
 		}
 
+		// the load commands always give the memory size as the file size, so never copy more than that
+		uint64_t data_size = (vma->file_size < vma->memory_size) ? vma->file_size : vma->memory_size;
+
 		if (vma->filename) {
 			if (vma->filename_length >= sizeof("/dev/") - 1 && strncmp(vma->filename, "/dev/", sizeof("/dev/") - 1) == 0) {
 				printf("Warning: skipping device \"%s\"\n", vma->filename);
-				if (!dump_skip(cprm, vma->file_size)) {
-					exit(EXIT_FAILURE);
-				}
+				zero_start += vma->memory_size;
 				continue;
 			}
 
+			// the file is opened again by whichever thread copies each chunk; this is just so we warn once
 			int fd = open_file(cprm, vma->filename, vma->filename_length);
 			if (fd < 0) {
 				fprintf(stderr, "Warning: failed to open %s: %d (%s)\n", vma->filename, errno, strerror(errno));
 				//exit(EXIT_FAILURE);
 				// just zero it out
-				if (!dump_skip(cprm, vma->file_size)) {
-					exit(EXIT_FAILURE);
-				}
+				zero_start += vma->memory_size;
 				continue;
 			}
-
-			uintptr_t aligned_offset = round_down_pow2(vma->file_offset, sysconf(_SC_PAGESIZE));
-			size_t aligned_size = round_up_pow2(vma->file_size + (vma->file_offset - aligned_offset), sysconf(_SC_PAGESIZE));
-			void* mapping = mmap(NULL, aligned_size, PROT_READ, MAP_PRIVATE, fd, aligned_offset);
-			if (mapping == MAP_FAILED) {
-				perror("mmap");
-				exit(EXIT_FAILURE);
-			}
-			const void* start = (const char*)mapping + (vma->file_offset - aligned_offset);
-
-			if (!dump_emit(cprm, start, vma->file_size))
-				exit(EXIT_FAILURE);
-
-			if (munmap(mapping, aligned_size) < 0) {
-				perror("munmap");
-				exit(EXIT_FAILURE);
-			}
-
 			close(fd);
+
+			dump_plan(cprm, tasks, DUMP_SOURCE_FILE, vma, vma->file_offset, vma->expected_offset, data_size);
 		} else {
-			if (!dump_emit(cprm, (const char*)cprm->input_corefile_mapping + vma->file_offset, vma->file_size))
-				exit(EXIT_FAILURE);
+			dump_plan(cprm, tasks, DUMP_SOURCE_COREFILE, vma, vma->file_offset, vma->expected_offset, data_size);
 		}
 
 		// LLDB assumes that contiguous memory regions are written to the file as contiguous memory regions, even if they're written as separate segments,
 		// and (notably) even if their file sizes differ from their memory sizes (which would mean they're not actually fully contiguous in the file).
-		// this is a fairly reasonable assumption, but this means that, in cases where the memory size is greater than the file size, we have to manually
-		// zero-out the extra region space so LLDB will read them properly.
-		if (!dump_skip(cprm, vma->memory_size - vma->file_size))
-			exit(EXIT_FAILURE);
+		// this is a fairly reasonable assumption, but this means that, in cases where the memory size is greater than the file size, we have to
+		// zero-out the extra region space so LLDB will read them properly. that space is covered by the next padding (or the end of the file).
+		zero_start += data_size;
+	}
 
-		if (!dump_align(cprm, align_page_size))
-			exit(EXIT_FAILURE);
+	dump_plan(cprm, tasks, DUMP_SOURCE_ZERO, NULL, 0, zero_start, cprm->output_size - zero_start);
+
+	std::atomic<size_t> next_task(0);
+	std::atomic<bool> failed(false);
+
+	auto worker = [&]() {
+		for (size_t i = next_task++; i < tasks.size() && !failed; i = next_task++) {
+			if (!dump_run_task(cprm, &tasks[i])) {
+				failed = true;
+			}
+		}
+	};
+
+	size_t thread_count = (cprm->jobs < tasks.size()) ? cprm->jobs : tasks.size();
+	std::vector<std::thread> threads;
+
+	for (size_t i = 1; i < thread_count; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	if (failed) {
+		exit(EXIT_FAILURE);
 	}
 }
@@ -18,241 +18,1104 @@
  */
 
 #include <cache/cache.h>
+#include <os/lock.h>
+#include <mach/mach.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
 
-static int verbose = 0;
+/*
+ * The cache is split into CACHE_STRIPES independently locked stripes, chosen
+ * by the high bits of the (mixed) key hash, so that threads working on
+ * different keys rarely contend. Each stripe owns a chained hash table and
+ * an LRU list of the entries nobody has retained; only those can be evicted
+ * and only those are ever made purgeable.
+ *
+ * cache_release_value() is handed only the value, so every stripe also
+ * keeps a small table mapping values (by pointer) back to key hashes. Locks
+ * are only ever nested key stripe first, value table second.
+ *
+ * Cost and count limits are enforced after every insertion by evicting
+ * from the stripes' LRU heads in round-robin order, which approximates a
+ * global LRU without a global lock. The key and value release callbacks
+ * run after the stripe locks have been dropped; the purgeability callbacks
+ * run with the entry's stripe locked.
+ */
 
-// can't use an initializer because we're part of libSystem
-//__attribute__((constructor))
-static void initme(void) {
-	static int inited = 0;
-	if (!inited) {
-		inited = 1;
-		verbose = getenv("STUB_VERBOSE") != NULL;
-	}
+#define CACHE_STRIPES         16
+#define CACHE_STRIPE_SHIFT    (64 - 4)
+#define CACHE_INITIAL_BUCKETS 8
+#define CACHE_LINE_SIZE       64
+
+struct cache_entry
+{
+	// hash chain, zombie list or free list
+	struct cache_entry* next;
+	// LRU list, only while retain_count == 0
+	struct cache_entry* lru_prev;
+	struct cache_entry* lru_next;
+
+	void* key;
+	void* value;
+	size_t cost;
+	uint64_t hash;
+	size_t retain_count;
+	bool purgeable;
+	// removed from the cache while still retained by clients
+	bool removed;
+};
+
+struct cache_value_ref
+{
+	struct cache_value_ref* next;
+	void* value;
+	uint64_t hash;
+};
+
+struct cache_stats
+{
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t sets;
+	uint64_t removals;
+	uint64_t evictions;
+	uint64_t purged;
+};
+
+struct cache_stripe
+{
+	os_unfair_lock lock;
+	struct cache_entry** buckets;
+	size_t bucket_count;
+	size_t count;
+	struct cache_entry* lru_head;
+	struct cache_entry* lru_tail;
+	struct cache_entry* zombies;
+	struct cache_stats stats;
+
+	os_unfair_lock value_lock;
+	struct cache_value_ref** value_buckets;
+	size_t value_bucket_count;
+	size_t value_count;
+} __attribute__((aligned(CACHE_LINE_SIZE)));
+
+struct cache_s
+{
+	struct cache_stripe stripes[CACHE_STRIPES];
+
+	cache_attributes_t attrs;
+	os_unfair_lock name_lock;
+	char* name;
+
+	_Atomic(size_t) total_cost;
+	_Atomic(size_t) total_count;
+	_Atomic(size_t) cost_hint;
+	_Atomic(size_t) count_hint;
+	_Atomic(size_t) minimum_values_hint;
+	_Atomic(unsigned int) evict_hand;
+
+	struct cache_s* registry_next;
+};
+
+// every live cache, for memory pressure events
+static os_unfair_lock registry_lock = OS_UNFAIR_LOCK_INIT;
+static struct cache_s* registry_head;
+
+static inline uint64_t cache_mix(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
 }
 
-void* cache_create(void)
+static inline uint64_t cache_key_hash(cache_t* cache, void* key)
 {
-	initme();
-	if (verbose) puts("STUB: cache_create called");
-	return NULL;
+	return cache_mix(cache->attrs.key_hash_cb(key, cache->attrs.user_data));
 }
 
-void* cache_destroy(void)
+static inline struct cache_stripe* cache_stripe_for_hash(cache_t* cache, uint64_t hash)
 {
-	initme();
-	if (verbose) puts("STUB: cache_destroy called");
-	return NULL;
+	return &cache->stripes[hash >> CACHE_STRIPE_SHIFT];
 }
 
-void* cache_get(void)
+static inline struct cache_stripe* cache_stripe_for_value(cache_t* cache, void* value)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get called");
-	return NULL;
+	return &cache->stripes[cache_mix((uintptr_t)value) >> CACHE_STRIPE_SHIFT];
 }
 
-void* cache_get_and_retain(void)
+static inline bool cache_keys_equal(cache_t* cache, void* key1, void* key2)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_and_retain called");
-	return NULL;
+	return key1 == key2 || cache->attrs.key_is_equal_cb(key1, key2, cache->attrs.user_data);
 }
 
-void* cache_get_cost_hint(void)
+/* Stripe tables; all of these expect the stripe lock to be held */
+
+static struct cache_entry** cache_find_slot(cache_t* cache, struct cache_stripe* stripe, void* key, uint64_t hash)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_cost_hint called");
+	struct cache_entry** slot;
+
+	if (!stripe->bucket_count)
+		return NULL;
+
+	for (slot = &stripe->buckets[hash & (stripe->bucket_count - 1)]; *slot; slot = &(*slot)->next)
+	{
+		if ((*slot)->hash == hash && cache_keys_equal(cache, (*slot)->key, key))
+			return slot;
+	}
 	return NULL;
 }
 
-void* cache_get_count_hint(void)
+static struct cache_entry** cache_slot_of(struct cache_stripe* stripe, struct cache_entry* entry)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_count_hint called");
-	return NULL;
+	struct cache_entry** slot = &stripe->buckets[entry->hash & (stripe->bucket_count - 1)];
+
+	while (*slot != entry)
+		slot = &(*slot)->next;
+	return slot;
 }
 
-void* cache_get_info(void)
+static bool cache_insert_entry(struct cache_stripe* stripe, struct cache_entry* entry)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_info called");
-	return NULL;
+	struct cache_entry** bucket;
+
+	if (stripe->count >= stripe->bucket_count)
+	{
+		size_t new_count = stripe->bucket_count ? stripe->bucket_count * 2 : CACHE_INITIAL_BUCKETS;
+		struct cache_entry** new_buckets = calloc(new_count, sizeof(*new_buckets));
+
+		if (!new_buckets)
+		{
+			if (!stripe->bucket_count)
+				return false;
+			// keep going with longer chains
+		}
+		else
+		{
+			for (size_t i = 0; i < stripe->bucket_count; i++)
+			{
+				struct cache_entry* e = stripe->buckets[i];
+				while (e)
+				{
+					struct cache_entry* next = e->next;
+					e->next = new_buckets[e->hash & (new_count - 1)];
+					new_buckets[e->hash & (new_count - 1)] = e;
+					e = next;
+				}
+			}
+			free(stripe->buckets);
+			stripe->buckets = new_buckets;
+			stripe->bucket_count = new_count;
+		}
+	}
+
+	bucket = &stripe->buckets[entry->hash & (stripe->bucket_count - 1)];
+	entry->next = *bucket;
+	*bucket = entry;
+	stripe->count++;
+	return true;
 }
 
-void* cache_get_info_for_key(void)
+static void cache_lru_append(struct cache_stripe* stripe, struct cache_entry* entry)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_info_for_key called");
-	return NULL;
+	entry->lru_next = NULL;
+	entry->lru_prev = stripe->lru_tail;
+	if (stripe->lru_tail)
+		stripe->lru_tail->lru_next = entry;
+	else
+		stripe->lru_head = entry;
+	stripe->lru_tail = entry;
 }
 
-void* cache_get_info_for_keys(void)
+static void cache_lru_unlink(struct cache_stripe* stripe, struct cache_entry* entry)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_info_for_keys called");
-	return NULL;
+	if (entry->lru_prev)
+		entry->lru_prev->lru_next = entry->lru_next;
+	else
+		stripe->lru_head = entry->lru_next;
+	if (entry->lru_next)
+		entry->lru_next->lru_prev = entry->lru_prev;
+	else
+		stripe->lru_tail = entry->lru_prev;
+	entry->lru_prev = entry->lru_next = NULL;
 }
 
-void* cache_get_minimum_values_hint(void)
+/* Value tables; these take the value lock of the value's stripe */
+
+static bool cache_value_map_add(cache_t* cache, void* value, uint64_t hash)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_minimum_values_hint called");
-	return NULL;
+	struct cache_stripe* stripe = cache_stripe_for_value(cache, value);
+	struct cache_value_ref* ref = malloc(sizeof(*ref));
+	uint64_t vhash = cache_mix((uintptr_t)value);
+
+	if (!ref)
+		return false;
+	ref->value = value;
+	ref->hash = hash;
+
+	os_unfair_lock_lock(&stripe->value_lock);
+	if (stripe->value_count >= stripe->value_bucket_count)
+	{
+		size_t new_count = stripe->value_bucket_count ? stripe->value_bucket_count * 2 : CACHE_INITIAL_BUCKETS;
+		struct cache_value_ref** new_buckets = calloc(new_count, sizeof(*new_buckets));
+
+		if (new_buckets)
+		{
+			for (size_t i = 0; i < stripe->value_bucket_count; i++)
+			{
+				struct cache_value_ref* r = stripe->value_buckets[i];
+				while (r)
+				{
+					struct cache_value_ref* next = r->next;
+					size_t b = cache_mix((uintptr_t)r->value) & (new_count - 1);
+					r->next = new_buckets[b];
+					new_buckets[b] = r;
+					r = next;
+				}
+			}
+			free(stripe->value_buckets);
+			stripe->value_buckets = new_buckets;
+			stripe->value_bucket_count = new_count;
+		}
+		else if (!stripe->value_bucket_count)
+		{
+			os_unfair_lock_unlock(&stripe->value_lock);
+			free(ref);
+			return false;
+		}
+	}
+
+	ref->next = stripe->value_buckets[vhash & (stripe->value_bucket_count - 1)];
+	stripe->value_buckets[vhash & (stripe->value_bucket_count - 1)] = ref;
+	stripe->value_count++;
+	os_unfair_lock_unlock(&stripe->value_lock);
+	return true;
 }
 
-void* cache_get_name(void)
+static void cache_value_map_remove(cache_t* cache, void* value, uint64_t hash)
 {
-	initme();
-	if (verbose) puts("STUB: cache_get_name called");
-	return NULL;
+	struct cache_stripe* stripe = cache_stripe_for_value(cache, value);
+	uint64_t vhash = cache_mix((uintptr_t)value);
+	struct cache_value_ref** slot;
+
+	os_unfair_lock_lock(&stripe->value_lock);
+	if (stripe->value_bucket_count)
+	{
+		for (slot = &stripe->value_buckets[vhash & (stripe->value_bucket_count - 1)]; *slot; slot = &(*slot)->next)
+		{
+			if ((*slot)->value == value && (*slot)->hash == hash)
+			{
+				struct cache_value_ref* ref = *slot;
+				*slot = ref->next;
+				stripe->value_count--;
+				free(ref);
+				break;
+			}
+		}
+	}
+	os_unfair_lock_unlock(&stripe->value_lock);
 }
 
-void* cache_hash_byte_string(void)
+static bool cache_value_map_lookup(cache_t* cache, void* value, uint64_t* hash_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_hash_byte_string called");
-	return NULL;
+	struct cache_stripe* stripe = cache_stripe_for_value(cache, value);
+	uint64_t vhash = cache_mix((uintptr_t)value);
+	struct cache_value_ref* ref = NULL;
+
+	os_unfair_lock_lock(&stripe->value_lock);
+	if (stripe->value_bucket_count)
+	{
+		for (ref = stripe->value_buckets[vhash & (stripe->value_bucket_count - 1)]; ref; ref = ref->next)
+		{
+			if (ref->value == value)
+			{
+				*hash_out = ref->hash;
+				break;
+			}
+		}
+	}
+	os_unfair_lock_unlock(&stripe->value_lock);
+	return ref != NULL;
 }
 
-void* cache_invoke(void)
+/* Entry lifetime */
+
+// Unlinks the entry at *slot from its stripe. Retained entries become
+// zombies until their last release; the rest are queued on *dead to be
+// released once the caller has dropped the stripe lock.
+static void cache_detach(cache_t* cache, struct cache_stripe* stripe, struct cache_entry** slot, struct cache_entry** dead)
 {
-	initme();
-	if (verbose) puts("STUB: cache_invoke called");
-	return NULL;
+	struct cache_entry* entry = *slot;
+
+	*slot = entry->next;
+	stripe->count--;
+	atomic_fetch_sub_explicit(&cache->total_count, 1, memory_order_relaxed);
+	atomic_fetch_sub_explicit(&cache->total_cost, entry->cost, memory_order_relaxed);
+
+	if (entry->retain_count)
+	{
+		entry->removed = true;
+		entry->next = stripe->zombies;
+		stripe->zombies = entry;
+	}
+	else
+	{
+		cache_lru_unlink(stripe, entry);
+		cache_value_map_remove(cache, entry->value, entry->hash);
+		entry->next = *dead;
+		*dead = entry;
+	}
 }
 
-void* cache_key_hash_cb_cstring(void)
+static void cache_release_entries(cache_t* cache, struct cache_entry* dead)
 {
-	initme();
-	if (verbose) puts("STUB: cache_key_hash_cb_cstring called");
-	return NULL;
+	while (dead)
+	{
+		struct cache_entry* next = dead->next;
+
+		if (cache->attrs.key_release_cb)
+			cache->attrs.key_release_cb(dead->key, cache->attrs.user_data);
+		if (cache->attrs.value_release_cb)
+			cache->attrs.value_release_cb(dead->value, cache->attrs.user_data);
+		free(dead);
+		dead = next;
+	}
 }
 
-void* cache_key_hash_cb_integer(void)
+// Evicts unretained entries, least recently used first, until the cache
+// fits both limits or only minimum_values_hint values are left
+static void cache_trim(cache_t* cache, size_t max_count, size_t max_cost)
 {
-	initme();
-	if (verbose) puts("STUB: cache_key_hash_cb_integer called");
-	return NULL;
+	size_t min_values = atomic_load_explicit(&cache->minimum_values_hint, memory_order_relaxed);
+	unsigned int hand = atomic_fetch_add_explicit(&cache->evict_hand, 1, memory_order_relaxed);
+	unsigned int empty_stripes = 0;
+	struct cache_entry* dead = NULL;
+
+	while (empty_stripes < CACHE_STRIPES)
+	{
+		size_t count = atomic_load_explicit(&cache->total_count, memory_order_relaxed);
+		size_t cost = atomic_load_explicit(&cache->total_cost, memory_order_relaxed);
+		struct cache_stripe* stripe;
+
+		if (count <= min_values || (count <= max_count && cost <= max_cost))
+			break;
+
+		stripe = &cache->stripes[hand++ % CACHE_STRIPES];
+
+		os_unfair_lock_lock(&stripe->lock);
+		if (stripe->lru_head)
+		{
+			cache_detach(cache, stripe, cache_slot_of(stripe, stripe->lru_head), &dead);
+			stripe->stats.evictions++;
+			empty_stripes = 0;
+		}
+		else
+			empty_stripes++;
+		os_unfair_lock_unlock(&stripe->lock);
+	}
+
+	cache_release_entries(cache, dead);
 }
 
-void* cache_key_is_equal_cb_cstring(void)
+static void cache_enforce_limits(cache_t* cache)
 {
-	initme();
-	if (verbose) puts("STUB: cache_key_is_equal_cb_cstring called");
-	return NULL;
+	size_t count_hint = atomic_load_explicit(&cache->count_hint, memory_order_relaxed);
+	size_t cost_hint = atomic_load_explicit(&cache->cost_hint, memory_order_relaxed);
+
+	// a hint of 0 means no limit
+	if (count_hint || cost_hint)
+		cache_trim(cache, count_hint ? count_hint : SIZE_MAX, cost_hint ? cost_hint : SIZE_MAX);
 }
 
-void* cache_key_is_equal_cb_integer(void)
+/* Public API */
+
+int cache_create(const char* name, cache_attributes_t* attrs, cache_t** cache_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_key_is_equal_cb_integer called");
-	return NULL;
+	cache_t* cache;
+
+	if (!attrs || !cache_out || !attrs->key_hash_cb || !attrs->key_is_equal_cb)
+		return EINVAL;
+	if (attrs->version != CACHE_ATTRIBUTES_VERSION_1 && attrs->version != CACHE_ATTRIBUTES_VERSION_2)
+		return EINVAL;
+
+	if (posix_memalign((void**) &cache, CACHE_LINE_SIZE, sizeof(*cache)) != 0)
+		return ENOMEM;
+	memset(cache, 0, sizeof(*cache));
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		cache->stripes[i].lock = OS_UNFAIR_LOCK_INIT;
+		cache->stripes[i].value_lock = OS_UNFAIR_LOCK_INIT;
+	}
+	cache->name_lock = OS_UNFAIR_LOCK_INIT;
+
+	// version 1 callers don't have the trailing fields
+	if (attrs->version == CACHE_ATTRIBUTES_VERSION_1)
+		memcpy(&cache->attrs, attrs, offsetof(cache_attributes_t, value_retain_cb));
+	else
+		cache->attrs = *attrs;
+
+	if (name)
+		cache->name = strdup(name);
+
+	os_unfair_lock_lock(&registry_lock);
+	cache->registry_next = registry_head;
+	registry_head = cache;
+	os_unfair_lock_unlock(&registry_lock);
+
+	*cache_out = cache;
+	return 0;
 }
 
-void* cache_print(void)
+int cache_destroy(cache_t* cache)
 {
-	initme();
-	if (verbose) puts("STUB: cache_print called");
-	return NULL;
+	struct cache_s** link;
+
+	if (!cache)
+		return EINVAL;
+
+	os_unfair_lock_lock(&registry_lock);
+	for (link = &registry_head; *link; link = &(*link)->registry_next)
+	{
+		if (*link == cache)
+		{
+			*link = cache->registry_next;
+			break;
+		}
+	}
+	os_unfair_lock_unlock(&registry_lock);
+
+	cache_remove_all(cache);
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+
+		// values still retained by clients go away with the cache
+		while (stripe->zombies)
+		{
+			struct cache_entry* entry = stripe->zombies;
+			stripe->zombies = entry->next;
+			cache_value_map_remove(cache, entry->value, entry->hash);
+			entry->next = NULL;
+			cache_release_entries(cache, entry);
+		}
+		free(stripe->buckets);
+		free(stripe->value_buckets);
+	}
+
+	free(cache->name);
+	free(cache);
+	return 0;
 }
 
-void* cache_print_stats(void)
+int cache_set_and_retain(cache_t* cache, void* key, void* value, size_t cost)
 {
-	initme();
-	if (verbose) puts("STUB: cache_print_stats called");
-	return NULL;
+	struct cache_entry* entry;
+	struct cache_entry* dead = NULL;
+	struct cache_entry** slot;
+	struct cache_stripe* stripe;
+
+	if (!cache)
+		return EINVAL;
+
+	entry = calloc(1, sizeof(*entry));
+	if (!entry)
+		return ENOMEM;
+
+	entry->hash = cache_key_hash(cache, key);
+	entry->value = value;
+	entry->cost = cost;
+	entry->retain_count = 1;
+
+	if (cache->attrs.key_retain_cb)
+		cache->attrs.key_retain_cb(key, &entry->key, cache->attrs.user_data);
+	else
+		entry->key = key;
+	if (cache->attrs.value_retain_cb)
+		cache->attrs.value_retain_cb(value, cache->attrs.user_data);
+
+	stripe = cache_stripe_for_hash(cache, entry->hash);
+	os_unfair_lock_lock(&stripe->lock);
+
+	slot = cache_find_slot(cache, stripe, key, entry->hash);
+	if (slot)
+		cache_detach(cache, stripe, slot, &dead);
+
+	if (!cache_value_map_add(cache, value, entry->hash) || !cache_insert_entry(stripe, entry))
+	{
+		os_unfair_lock_unlock(&stripe->lock);
+		cache_value_map_remove(cache, value, entry->hash);
+		cache_release_entries(cache, dead);
+
+		// the value was never ours unless we retained it
+		if (cache->attrs.key_release_cb)
+			cache->attrs.key_release_cb(entry->key, cache->attrs.user_data);
+		if (cache->attrs.value_retain_cb && cache->attrs.value_release_cb)
+			cache->attrs.value_release_cb(value, cache->attrs.user_data);
+		free(entry);
+		return ENOMEM;
+	}
+	stripe->stats.sets++;
+	atomic_fetch_add_explicit(&cache->total_count, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&cache->total_cost, cost, memory_order_relaxed);
+
+	os_unfair_lock_unlock(&stripe->lock);
+
+	cache_release_entries(cache, dead);
+	cache_enforce_limits(cache);
+	return 0;
 }
 
-void* cache_release_cb_free(void)
+static int cache_lookup(cache_t* cache, void* key, void** value_out, bool retain)
 {
-	initme();
-	if (verbose) puts("STUB: cache_release_cb_free called");
-	return NULL;
+	uint64_t hash;
+	struct cache_stripe* stripe;
+	struct cache_entry** slot;
+	struct cache_entry* entry;
+	struct cache_entry* dead = NULL;
+	int ret = 0;
+
+	if (!cache || !value_out)
+		return EINVAL;
+
+	hash = cache_key_hash(cache, key);
+	stripe = cache_stripe_for_hash(cache, hash);
+	os_unfair_lock_lock(&stripe->lock);
+
+	slot = cache_find_slot(cache, stripe, key, hash);
+	if (!slot)
+	{
+		stripe->stats.misses++;
+		ret = ENOENT;
+		goto out;
+	}
+	entry = *slot;
+
+	if (entry->retain_count == 0)
+	{
+		// get the contents back before anybody looks at them; if the
+		// system has already reclaimed them, the entry is gone
+		if (entry->purgeable && cache->attrs.value_make_nonpurgeable_cb
+			&& !cache->attrs.value_make_nonpurgeable_cb(entry->value, cache->attrs.user_data))
+		{
+			entry->purgeable = false;
+			cache_detach(cache, stripe, slot, &dead);
+			stripe->stats.purged++;
+			stripe->stats.misses++;
+			ret = ENOENT;
+			goto out;
+		}
+		entry->purgeable = false;
+		cache_lru_unlink(stripe, entry);
+
+		if (!retain)
+		{
+			if (cache->attrs.value_make_purgeable_cb)
+			{
+				cache->attrs.value_make_purgeable_cb(entry->value, cache->attrs.user_data);
+				entry->purgeable = true;
+			}
+			cache_lru_append(stripe, entry);
+		}
+	}
+	if (retain)
+		entry->retain_count++;
+
+	stripe->stats.hits++;
+	*value_out = entry->value;
+
+out:
+	os_unfair_lock_unlock(&stripe->lock);
+	cache_release_entries(cache, dead);
+	return ret;
 }
 
-void* cache_release_value(void)
+int cache_get_and_retain(cache_t* cache, void* key, void** value_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_release_value called");
-	return NULL;
+	return cache_lookup(cache, key, value_out, true);
 }
 
-void* cache_remove(void)
+int cache_get(cache_t* cache, void* key, void** value_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_remove called");
-	return NULL;
+	return cache_lookup(cache, key, value_out, false);
 }
 
-void* cache_remove_all(void)
+int cache_release_value(cache_t* cache, void* value)
 {
-	initme();
-	if (verbose) puts("STUB: cache_remove_all called");
-	return NULL;
+	uint64_t hash;
+	struct cache_stripe* stripe;
+	struct cache_entry* entry = NULL;
+	struct cache_entry** zslot = NULL;
+	struct cache_entry* dead = NULL;
+
+	if (!cache)
+		return EINVAL;
+	if (!cache_value_map_lookup(cache, value, &hash))
+		return ENOENT;
+
+	stripe = cache_stripe_for_hash(cache, hash);
+	os_unfair_lock_lock(&stripe->lock);
+
+	if (stripe->bucket_count)
+	{
+		for (entry = stripe->buckets[hash & (stripe->bucket_count - 1)]; entry; entry = entry->next)
+		{
+			if (entry->hash == hash && entry->value == value && entry->retain_count)
+				break;
+		}
+	}
+	if (!entry)
+	{
+		for (zslot = &stripe->zombies; *zslot; zslot = &(*zslot)->next)
+		{
+			if ((*zslot)->value == value)
+				break;
+		}
+		entry = *zslot;
+	}
+	if (!entry)
+	{
+		os_unfair_lock_unlock(&stripe->lock);
+		return EINVAL;
+	}
+
+	if (--entry->retain_count == 0)
+	{
+		if (entry->removed)
+		{
+			*zslot = entry->next;
+			cache_value_map_remove(cache, entry->value, entry->hash);
+			entry->next = NULL;
+			dead = entry;
+		}
+		else
+		{
+			if (cache->attrs.value_make_purgeable_cb)
+			{
+				cache->attrs.value_make_purgeable_cb(entry->value, cache->attrs.user_data);
+				entry->purgeable = true;
+			}
+			cache_lru_append(stripe, entry);
+		}
+	}
+
+	os_unfair_lock_unlock(&stripe->lock);
+
+	cache_release_entries(cache, dead);
+	// the entry may have just become evictable
+	cache_enforce_limits(cache);
+	return 0;
 }
 
-void* cache_remove_with_block(void)
+int cache_remove(cache_t* cache, void* key)
 {
-	initme();
-	if (verbose) puts("STUB: cache_remove_with_block called");
-	return NULL;
+	uint64_t hash;
+	struct cache_stripe* stripe;
+	struct cache_entry** slot;
+	struct cache_entry* dead = NULL;
+
+	if (!cache)
+		return EINVAL;
+
+	hash = cache_key_hash(cache, key);
+	stripe = cache_stripe_for_hash(cache, hash);
+	os_unfair_lock_lock(&stripe->lock);
+
+	slot = cache_find_slot(cache, stripe, key, hash);
+	if (slot)
+	{
+		cache_detach(cache, stripe, slot, &dead);
+		stripe->stats.removals++;
+	}
+
+	os_unfair_lock_unlock(&stripe->lock);
+
+	cache_release_entries(cache, dead);
+	return slot ? 0 : ENOENT;
 }
 
-void* cache_set_and_retain(void)
+// Removes every entry for which predicate returns true (or all of them if
+// predicate is NULL)
+static int cache_remove_matching(cache_t* cache, bool (^predicate)(void* key, void* value))
 {
-	initme();
-	if (verbose) puts("STUB: cache_set_and_retain called");
-	return NULL;
+	if (!cache)
+		return EINVAL;
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+		struct cache_entry* dead = NULL;
+
+		os_unfair_lock_lock(&stripe->lock);
+		for (size_t b = 0; b < stripe->bucket_count; b++)
+		{
+			struct cache_entry** slot = &stripe->buckets[b];
+			while (*slot)
+			{
+				if (!predicate || predicate((*slot)->key, (*slot)->value))
+				{
+					cache_detach(cache, stripe, slot, &dead);
+					stripe->stats.removals++;
+				}
+				else
+					slot = &(*slot)->next;
+			}
+		}
+		os_unfair_lock_unlock(&stripe->lock);
+
+		cache_release_entries(cache, dead);
+	}
+	return 0;
 }
 
-void* cache_set_cost_hint(void)
+int cache_remove_all(cache_t* cache)
 {
-	initme();
-	if (verbose) puts("STUB: cache_set_cost_hint called");
-	return NULL;
+	return cache_remove_matching(cache, NULL);
 }
 
-void* cache_set_count_hint(void)
+int cache_remove_with_block(cache_t* cache, bool (^predicate)(void* key, void* value))
 {
-	initme();
-	if (verbose) puts("STUB: cache_set_count_hint called");
-	return NULL;
+	if (!predicate)
+		return EINVAL;
+	return cache_remove_matching(cache, predicate);
 }
 
-void* cache_set_minimum_values_hint(void)
+int cache_invoke(cache_t* cache, void (^block)(void* key, void* value))
 {
-	initme();
-	if (verbose) puts("STUB: cache_set_minimum_values_hint called");
-	return NULL;
+	if (!cache || !block)
+		return EINVAL;
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+
+		os_unfair_lock_lock(&stripe->lock);
+		for (size_t b = 0; b < stripe->bucket_count; b++)
+		{
+			for (struct cache_entry* e = stripe->buckets[b]; e; e = e->next)
+				block(e->key, e->value);
+		}
+		os_unfair_lock_unlock(&stripe->lock);
+	}
+	return 0;
 }
 
-void* cache_set_name(void)
+/* Hints */
+
+int cache_set_cost_hint(cache_t* cache, size_t cost)
 {
-	initme();
-	if (verbose) puts("STUB: cache_set_name called");
-	return NULL;
+	if (!cache)
+		return EINVAL;
+	atomic_store_explicit(&cache->cost_hint, cost, memory_order_relaxed);
+	cache_enforce_limits(cache);
+	return 0;
 }
 
-void* cache_simulate_memory_warning_event(void)
+int cache_get_cost_hint(cache_t* cache, size_t* cost_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_simulate_memory_warning_event called");
-	return NULL;
+	if (!cache || !cost_out)
+		return EINVAL;
+	*cost_out = atomic_load_explicit(&cache->cost_hint, memory_order_relaxed);
+	return 0;
 }
 
-void* cache_value_make_nonpurgeable_cb(void)
+int cache_set_count_hint(cache_t* cache, size_t count)
 {
-	initme();
-	if (verbose) puts("STUB: cache_value_make_nonpurgeable_cb called");
-	return NULL;
+	if (!cache)
+		return EINVAL;
+	atomic_store_explicit(&cache->count_hint, count, memory_order_relaxed);
+	cache_enforce_limits(cache);
+	return 0;
 }
 
-void* cache_value_make_purgeable_cb(void)
+int cache_get_count_hint(cache_t* cache, size_t* count_out)
 {
-	initme();
-	if (verbose) puts("STUB: cache_value_make_purgeable_cb called");
-	return NULL;
+	if (!cache || !count_out)
+		return EINVAL;
+	*count_out = atomic_load_explicit(&cache->count_hint, memory_order_relaxed);
+	return 0;
+}
+
+int cache_set_minimum_values_hint(cache_t* cache, size_t count)
+{
+	if (!cache)
+		return EINVAL;
+	atomic_store_explicit(&cache->minimum_values_hint, count, memory_order_relaxed);
+	return 0;
+}
+
+int cache_get_minimum_values_hint(cache_t* cache, size_t* count_out)
+{
+	if (!cache || !count_out)
+		return EINVAL;
+	*count_out = atomic_load_explicit(&cache->minimum_values_hint, memory_order_relaxed);
+	return 0;
+}
+
+int cache_set_name(cache_t* cache, const char* name)
+{
+	char* copy = NULL;
+	char* old;
+
+	if (!cache)
+		return EINVAL;
+	if (name && !(copy = strdup(name)))
+		return ENOMEM;
+
+	os_unfair_lock_lock(&cache->name_lock);
+	old = cache->name;
+	cache->name = copy;
+	os_unfair_lock_unlock(&cache->name_lock);
+
+	free(old);
+	return 0;
+}
+
+int cache_get_name(cache_t* cache, const char** name_out)
+{
+	if (!cache || !name_out)
+		return EINVAL;
+
+	os_unfair_lock_lock(&cache->name_lock);
+	*name_out = cache->name;
+	os_unfair_lock_unlock(&cache->name_lock);
+	return 0;
+}
+
+/* Introspection */
+
+static void cache_fill_info(struct cache_entry* entry, cache_info_t* info)
+{
+	info->key = entry->key;
+	info->value = entry->value;
+	info->cost = entry->cost;
+	info->retain_count = entry->retain_count;
+	info->is_purgeable = entry->purgeable;
+}
+
+int cache_get_info(cache_t* cache, cache_info_t** info_out, size_t* count_out)
+{
+	cache_info_t* info = NULL;
+	size_t count = 0, capacity = 0;
+
+	if (!cache || !info_out || !count_out)
+		return EINVAL;
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+
+		os_unfair_lock_lock(&stripe->lock);
+		if (count + stripe->count > capacity)
+		{
+			size_t new_capacity = (count + stripe->count) * 2;
+			cache_info_t* p = realloc(info, new_capacity * sizeof(*info));
+			if (!p)
+			{
+				os_unfair_lock_unlock(&stripe->lock);
+				free(info);
+				return ENOMEM;
+			}
+			info = p;
+			capacity = new_capacity;
+		}
+		for (size_t b = 0; b < stripe->bucket_count; b++)
+		{
+			for (struct cache_entry* e = stripe->buckets[b]; e; e = e->next)
+				cache_fill_info(e, &info[count++]);
+		}
+		os_unfair_lock_unlock(&stripe->lock);
+	}
+
+	*info_out = info;
+	*count_out = count;
+	return 0;
+}
+
+int cache_get_info_for_key(cache_t* cache, void* key, cache_info_t* info_out)
+{
+	uint64_t hash;
+	struct cache_stripe* stripe;
+	struct cache_entry** slot;
+
+	if (!cache || !info_out)
+		return EINVAL;
+
+	hash = cache_key_hash(cache, key);
+	stripe = cache_stripe_for_hash(cache, hash);
+	os_unfair_lock_lock(&stripe->lock);
+	slot = cache_find_slot(cache, stripe, key, hash);
+	if (slot)
+		cache_fill_info(*slot, info_out);
+	os_unfair_lock_unlock(&stripe->lock);
+
+	return slot ? 0 : ENOENT;
+}
+
+int cache_get_info_for_keys(cache_t* cache, void** keys, size_t count, cache_info_t* infos_out)
+{
+	if (!cache || (count && (!keys || !infos_out)))
+		return EINVAL;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (cache_get_info_for_key(cache, keys[i], &infos_out[i]) != 0)
+		{
+			memset(&infos_out[i], 0, sizeof(infos_out[i]));
+			infos_out[i].key = keys[i];
+		}
+	}
+	return 0;
+}
+
+int cache_print(cache_t* cache)
+{
+	const char* name;
+
+	if (!cache)
+		return EINVAL;
+
+	cache_get_name(cache, &name);
+	fprintf(stderr, "cache %p (%s): %zu values, cost %zu\n", cache, name ? name : "unnamed",
+		atomic_load(&cache->total_count), atomic_load(&cache->total_cost));
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+
+		os_unfair_lock_lock(&stripe->lock);
+		for (size_t b = 0; b < stripe->bucket_count; b++)
+		{
+			for (struct cache_entry* e = stripe->buckets[b]; e; e = e->next)
+			{
+				fprintf(stderr, "\tkey %p value %p cost %zu retained %zu%s\n", e->key, e->value,
+					e->cost, e->retain_count, e->purgeable ? " purgeable" : "");
+			}
+		}
+		os_unfair_lock_unlock(&stripe->lock);
+	}
+	return 0;
+}
+
+int cache_print_stats(cache_t* cache)
+{
+	struct cache_stats total = { 0 };
+	const char* name;
+	uint64_t lookups;
+
+	if (!cache)
+		return EINVAL;
+
+	for (int i = 0; i < CACHE_STRIPES; i++)
+	{
+		struct cache_stripe* stripe = &cache->stripes[i];
+
+		os_unfair_lock_lock(&stripe->lock);
+		total.hits += stripe->stats.hits;
+		total.misses += stripe->stats.misses;
+		total.sets += stripe->stats.sets;
+		total.removals += stripe->stats.removals;
+		total.evictions += stripe->stats.evictions;
+		total.purged += stripe->stats.purged;
+		os_unfair_lock_unlock(&stripe->lock);
+	}
+
+	cache_get_name(cache, &name);
+	lookups = total.hits + total.misses;
+
+	fprintf(stderr, "cache %p (%s)\n", cache, name ? name : "unnamed");
+	fprintf(stderr, "\tvalues: %zu, cost: %zu (count hint %zu, cost hint %zu, minimum %zu)\n",
+		atomic_load(&cache->total_count), atomic_load(&cache->total_cost),
+		atomic_load(&cache->count_hint), atomic_load(&cache->cost_hint),
+		atomic_load(&cache->minimum_values_hint));
+	fprintf(stderr, "\tlookups: %llu, hits: %llu, misses: %llu, hit rate: %.1f%%\n",
+		(unsigned long long) lookups, (unsigned long long) total.hits, (unsigned long long) total.misses,
+		lookups ? 100.0 * total.hits / lookups : 0.0);
+	fprintf(stderr, "\tsets: %llu, removals: %llu, evictions: %llu, purged: %llu\n",
+		(unsigned long long) total.sets, (unsigned long long) total.removals,
+		(unsigned long long) total.evictions, (unsigned long long) total.purged);
+	return 0;
+}
+
+/* Memory pressure */
+
+int cache_simulate_memory_warning_event(uint64_t level)
+{
+	// Release callbacks run with the registry lock held, so they must not
+	// create or destroy caches.
+	os_unfair_lock_lock(&registry_lock);
+	for (cache_t* cache = registry_head; cache; cache = cache->registry_next)
+	{
+		// under critical pressure drop everything that isn't retained (down
+		// to the minimum), otherwise give back half
+		if (level >= CACHE_MEMORY_PRESSURE_CRITICAL)
+			cache_trim(cache, 0, SIZE_MAX);
+		else
+			cache_trim(cache, atomic_load_explicit(&cache->total_count, memory_order_relaxed) / 2, SIZE_MAX);
+	}
+	os_unfair_lock_unlock(&registry_lock);
+	return 0;
+}
+
+/* Stock callbacks */
+
+uintptr_t cache_hash_byte_string(const char* data, size_t bytes)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for (size_t i = 0; i < bytes; i++)
+	{
+		hash ^= (unsigned char) data[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return (uintptr_t) hash;
+}
+
+uintptr_t cache_key_hash_cb_cstring(void* key, void* unused)
+{
+	return cache_hash_byte_string(key, strlen(key));
+}
+
+uintptr_t cache_key_hash_cb_integer(void* key, void* unused)
+{
+	return (uintptr_t) key;
+}
+
+bool cache_key_is_equal_cb_cstring(void* key1, void* key2, void* unused)
+{
+	return strcmp(key1, key2) == 0;
+}
+
+bool cache_key_is_equal_cb_integer(void* key1, void* key2, void* unused)
+{
+	return key1 == key2;
+}
+
+void cache_release_cb_free(void* key_or_value, void* unused)
+{
+	free(key_or_value);
+}
+
+bool cache_value_make_nonpurgeable_cb(void* value, void* unused)
+{
+	int state = VM_PURGABLE_NONVOLATILE;
+
+	if (vm_purgable_control(mach_task_self(), (vm_address_t) value, VM_PURGABLE_SET_STATE, &state) != KERN_SUCCESS)
+	{
+		// not purgeable memory, so it cannot have been reclaimed
+		return true;
+	}
+	return (state & VM_PURGABLE_STATE_MASK) != VM_PURGABLE_EMPTY;
+}
+
+void cache_value_make_purgeable_cb(void* value, void* unused)
+{
+	int state = VM_PURGABLE_VOLATILE;
+	vm_purgable_control(mach_task_self(), (vm_address_t) value, VM_PURGABLE_SET_STATE, &state);
 }
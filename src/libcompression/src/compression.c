@@ -1,8 +1,79 @@
 #include <compression.h>
+#include <stdlib.h>
+#include "compression_internal.h"
+
+#define SCRATCH_ALIGN 16
+
+static const struct algorithm_ops *
+lookup_algorithm(compression_algorithm algorithm) {
+    switch (algorithm) {
+        case COMPRESSION_ZLIB:    return &zlib_ops;
+        case COMPRESSION_LZMA:    return &lzma_ops;
+        case COMPRESSION_LZ4:     return &lz4_ops;
+        case COMPRESSION_LZ4_RAW: return &lz4_raw_ops;
+        case COMPRESSION_LZFSE:   return &lzfse_ops;
+        default:                  return NULL;
+    }
+}
+
+void
+scratch_arena_init(struct scratch_arena * arena, void * buffer, size_t size) {
+    arena->base = buffer;
+    arena->size = buffer ? size : 0;
+    arena->used = 0;
+}
+
+void *
+scratch_alloc(struct scratch_arena * arena, size_t count, size_t size) {
+    size_t bytes;
+
+    if (__builtin_mul_overflow(count, size, &bytes))
+        return NULL;
+    bytes = (bytes + SCRATCH_ALIGN - 1) & ~(size_t)(SCRATCH_ALIGN - 1);
+
+    if (arena->size - arena->used >= bytes) {
+        void * p = arena->base + arena->used;
+        arena->used += bytes;
+        return p;
+    }
+    return malloc(bytes);
+}
+
+void
+scratch_free(struct scratch_arena * arena, void * ptr) {
+    uint8_t * p = ptr;
+
+    // memory from the arena is released all at once by the caller
+    if (p >= arena->base && p < arena->base + arena->size)
+        return;
+    free(ptr);
+}
+
+// Runs a buffer operation, allocating the scratch buffer ourselves if the
+// caller did not provide one
+static size_t
+run_buffer_op(size_t (*op)(uint8_t *, size_t, const uint8_t *, size_t, void *),
+              size_t scratch_size,
+              uint8_t * dst_buffer, size_t dst_size,
+              const uint8_t * src_buffer, size_t src_size,
+              void * scratch_buffer) {
+    size_t ret;
+
+    if (scratch_buffer || scratch_size == 0)
+        return op(dst_buffer, dst_size, src_buffer, src_size, scratch_buffer);
+
+    scratch_buffer = malloc(scratch_size);
+    if (!scratch_buffer)
+        return 0;
+    ret = op(dst_buffer, dst_size, src_buffer, src_size, scratch_buffer);
+    free(scratch_buffer);
+    return ret;
+}
 
 size_t
 compression_encode_scratch_buffer_size(compression_algorithm algorithm) {
-    return 0;
+    const struct algorithm_ops * ops = lookup_algorithm(algorithm);
+    return ops ? ops->encode_scratch_size() : 0;
 }
 
 size_t
@@ -10,12 +81,18 @@ compression_encode_buffer(uint8_t * __restrict dst_buffer, size_t dst_size,
                           const uint8_t * __restrict src_buffer, size_t src_size,
                           void * __restrict __nullable scratch_buffer,
                           compression_algorithm algorithm) {
-    return 0;
+    const struct algorithm_ops * ops = lookup_algorithm(algorithm);
+
+    if (!ops || dst_size == 0)
+        return 0;
+    return run_buffer_op(ops->encode_buffer, ops->encode_scratch_size(),
+                         dst_buffer, dst_size, src_buffer, src_size, scratch_buffer);
 }
 
 size_t
 compression_decode_scratch_buffer_size(compression_algorithm algorithm) {
-    return 0;
+    const struct algorithm_ops * ops = lookup_algorithm(algorithm);
+    return ops ? ops->decode_scratch_size() : 0;
 }
 
 size_t
@@ -23,24 +100,45 @@ compression_decode_buffer(uint8_t * __restrict dst_buffer, size_t dst_size,
                           const uint8_t * __restrict src_buffer, size_t src_size,
                           void * __restrict __nullable scratch_buffer,
                           compression_algorithm algorithm) {
-    return 0;
+    const struct algorithm_ops * ops = lookup_algorithm(algorithm);
+
+    if (!ops || dst_size == 0 || src_size == 0)
+        return 0;
+    return run_buffer_op(ops->decode_buffer, ops->decode_scratch_size(),
+                         dst_buffer, dst_size, src_buffer, src_size, scratch_buffer);
 }
 
 compression_status
 compression_stream_init(compression_stream * stream,
                         compression_stream_operation operation,
                         compression_algorithm algorithm) {
-    return COMPRESSION_STATUS_ERROR;
+    const struct algorithm_ops * ops = lookup_algorithm(algorithm);
+
+    stream->state = NULL;
+    if (!ops || !ops->stream_init)
+        return COMPRESSION_STATUS_ERROR;
+    if (operation != COMPRESSION_STREAM_ENCODE && operation != COMPRESSION_STREAM_DECODE)
+        return COMPRESSION_STATUS_ERROR;
+    return ops->stream_init(stream, operation);
 }
 
 compression_status
 compression_stream_process(compression_stream * stream,
                            int flags) {
-    return COMPRESSION_STATUS_ERROR;
+    struct stream_state * state = stream->state;
+
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+    return state->process(stream, flags);
 }
 
 compression_status
 compression_stream_destroy(compression_stream * stream) {
-    return COMPRESSION_STATUS_ERROR;
-}
+    struct stream_state * state = stream->state;
 
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+    state->destroy(stream);
+    stream->state = NULL;
+    return COMPRESSION_STATUS_OK;
+}
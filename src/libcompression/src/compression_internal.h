@@ -0,0 +1,93 @@
+#ifndef _COMPRESSION_INTERNAL_H_
+#define _COMPRESSION_INTERNAL_H_
+
+#include <compression.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Scratch buffers
+//
+// The buffer API lets callers hand us a scratch buffer of the size we
+// report from compression_*_scratch_buffer_size, so that the codecs never
+// have to touch the heap on the hot path. Codec libraries that allocate
+// internally (zlib, liblzma) are pointed at a bump allocator over that
+// buffer; should a particular input need more than we estimated, we fall
+// back to malloc instead of failing.
+
+struct scratch_arena {
+    uint8_t * base;
+    size_t    size;
+    size_t    used;
+};
+
+void
+scratch_arena_init(struct scratch_arena * arena, void * buffer, size_t size);
+
+void *
+scratch_alloc(struct scratch_arena * arena, size_t count, size_t size);
+
+void
+scratch_free(struct scratch_arena * arena, void * ptr);
+
+// Streams
+//
+// compression_stream.state points to a codec-specific structure whose first
+// member is a struct stream_state.
+
+struct stream_state {
+    compression_status (*process)(compression_stream * stream, int flags);
+    void (*destroy)(compression_stream * stream);
+};
+
+// Algorithms
+
+struct algorithm_ops {
+    size_t (*encode_scratch_size)(void);
+    size_t (*encode_buffer)(uint8_t * dst, size_t dst_size,
+                            const uint8_t * src, size_t src_size, void * scratch);
+    size_t (*decode_scratch_size)(void);
+    size_t (*decode_buffer)(uint8_t * dst, size_t dst_size,
+                            const uint8_t * src, size_t src_size, void * scratch);
+    compression_status (*stream_init)(compression_stream * stream,
+                                      compression_stream_operation operation);
+};
+
+extern const struct algorithm_ops zlib_ops;
+extern const struct algorithm_ops lzma_ops;
+extern const struct algorithm_ops lz4_ops;
+extern const struct algorithm_ops lz4_raw_ops;
+extern const struct algorithm_ops lzfse_ops;
+
+// Helpers shared by the block-framed (LZ4 and LZFSE) streams
+
+static inline uint32_t
+load_le32(const uint8_t * p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void
+store_le32(uint8_t * p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+// Copies as much of [*src, src_end) as fits into the stream's destination.
+// Returns true once everything has been copied.
+static inline bool
+stream_drain(compression_stream * stream, const uint8_t ** src, const uint8_t * src_end) {
+    size_t n = src_end - *src;
+    if (n > stream->dst_size)
+        n = stream->dst_size;
+    if (n) {
+        __builtin_memcpy(stream->dst_ptr, *src, n);
+        stream->dst_ptr += n;
+        stream->dst_size -= n;
+        *src += n;
+    }
+    return *src == src_end;
+}
+
+#endif
@@ -0,0 +1,600 @@
+#include <stdlib.h>
+#include <string.h>
+#include "compression_internal.h"
+
+// LZ4
+//
+// COMPRESSION_LZ4_RAW is a bare LZ4 block. COMPRESSION_LZ4 wraps LZ4 blocks
+// in Apple's framing:
+//
+//   "bv41" n_raw_bytes n_payload_bytes <payload>   LZ4-compressed block
+//   "bv4-" n_raw_bytes <raw bytes>                  uncompressed block
+//   "bv4$"                                          end of stream
+//
+// with all sizes stored as 32-bit little endian. Matches in a compressed
+// block may reach back into the output of previous blocks, so decoders keep
+// LZ4_HISTORY_SIZE bytes of history around. Our encoder never relies on that
+// and compresses every block independently.
+
+#define LZ4_COMPRESSED_MAGIC   0x31347662 // "bv41"
+#define LZ4_UNCOMPRESSED_MAGIC 0x2d347662 // "bv4-"
+#define LZ4_END_MAGIC          0x24347662 // "bv4$"
+
+#define LZ4_MIN_MATCH     4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MFLIMIT       12
+#define LZ4_MAX_DISTANCE  0xffff
+#define LZ4_HISTORY_SIZE  (1 << 16)
+
+#define LZ4_HASH_LOG  12
+#define LZ4_HASH_SIZE (1 << LZ4_HASH_LOG)
+
+#define LZ4_BLOCK_SIZE (1 << 16)
+// sanity limit on block sizes we accept from a stream
+#define LZ4_BLOCK_SIZE_MAX (1 << 26)
+
+// the largest framed block we can produce out of n input bytes
+#define LZ4_FRAME_BOUND(n) ((n) + 12)
+
+static inline uint32_t
+load32(const uint8_t * p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t
+lz4_hash(uint32_t seq) {
+    return (seq * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+static uint8_t *
+lz4_put_length(uint8_t * op, size_t len) {
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+// Emits one sequence. match_len is 0 for the final, literal-only sequence.
+static uint8_t *
+lz4_emit_sequence(uint8_t * op, uint8_t * dst_end,
+                  const uint8_t * literals, size_t lit_len,
+                  size_t match_len, size_t offset) {
+    size_t worst = 1 + lit_len / 255 + 1 + lit_len + 2 + match_len / 255 + 1;
+    uint8_t * token = op;
+
+    if ((size_t)(dst_end - op) < worst)
+        return NULL;
+
+    op++;
+    *token = (uint8_t)((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15)
+        op = lz4_put_length(op, lit_len - 15);
+    memcpy(op, literals, lit_len);
+    op += lit_len;
+
+    if (match_len == 0)
+        return op;
+
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+    match_len -= LZ4_MIN_MATCH;
+    *token |= match_len >= 15 ? 15 : match_len;
+    if (match_len >= 15)
+        op = lz4_put_length(op, match_len - 15);
+    return op;
+}
+
+// Greedy single-pass LZ4 block encoder. table must hold LZ4_HASH_SIZE
+// entries. Returns the encoded size, or 0 if it does not fit in dst_size.
+static size_t
+lz4_encode_block(uint8_t * dst, size_t dst_size,
+                 const uint8_t * src, size_t src_size, uint32_t * table) {
+    const uint8_t * const src_end = src + src_size;
+    const uint8_t * ip = src, * anchor = src;
+    uint8_t * op = dst, * const dst_end = dst + dst_size;
+
+    if (src_size > LZ4_MFLIMIT) {
+        const uint8_t * const ip_limit = src_end - LZ4_MFLIMIT;
+        const uint8_t * const match_limit = src_end - LZ4_LAST_LITERALS;
+
+        memset(table, 0, LZ4_HASH_SIZE * sizeof(*table));
+
+        while (ip <= ip_limit) {
+            uint32_t seq = load32(ip);
+            uint32_t h = lz4_hash(seq);
+            const uint8_t * ref = src + table[h];
+            const uint8_t * mp, * rp;
+
+            table[h] = (uint32_t)(ip - src);
+
+            if (ref >= ip || ip - ref > LZ4_MAX_DISTANCE || load32(ref) != seq) {
+                // skip ahead faster through incompressible data
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+            for (mp = ip + LZ4_MIN_MATCH, rp = ref + LZ4_MIN_MATCH; mp < match_limit && *mp == *rp; mp++, rp++)
+                ;
+
+            op = lz4_emit_sequence(op, dst_end, anchor, ip - anchor, mp - ip, ip - ref);
+            if (!op)
+                return 0;
+            ip = anchor = mp;
+        }
+    }
+
+    op = lz4_emit_sequence(op, dst_end, anchor, src_end - anchor, 0, 0);
+    return op ? op - dst : 0;
+}
+
+// Decodes one LZ4 block from [src, src_end) into [dst, dst_end); matches may
+// reach back as far as dst_begin. Output that does not fit is dropped.
+// Returns the end of the decoded data, or NULL if the block is corrupt.
+static uint8_t *
+lz4_decode_block(uint8_t * dst_begin, uint8_t * dst, uint8_t * dst_end,
+                 const uint8_t * src, const uint8_t * src_end) {
+    while (src < src_end) {
+        uint8_t token = *src++;
+        size_t lit_len = token >> 4, match_len = token & 15, offset;
+
+        if (lit_len == 15) {
+            uint8_t b;
+            do {
+                if (src == src_end)
+                    return NULL;
+                lit_len += b = *src++;
+            } while (b == 255);
+        }
+        if (lit_len > (size_t)(src_end - src))
+            return NULL;
+        if (lit_len > (size_t)(dst_end - dst)) {
+            memcpy(dst, src, dst_end - dst);
+            return dst_end;
+        }
+        memcpy(dst, src, lit_len);
+        dst += lit_len;
+        src += lit_len;
+
+        // the last sequence carries literals only
+        if (src == src_end)
+            break;
+        if (src_end - src < 2)
+            return NULL;
+        offset = src[0] | (src[1] << 8);
+        src += 2;
+        // a zero offset is Apple's explicit end-of-block marker
+        if (offset == 0)
+            break;
+
+        if (match_len == 15) {
+            uint8_t b;
+            do {
+                if (src == src_end)
+                    return NULL;
+                match_len += b = *src++;
+            } while (b == 255);
+        }
+        match_len += LZ4_MIN_MATCH;
+
+        if (offset > (size_t)(dst - dst_begin))
+            return NULL;
+        if (match_len > (size_t)(dst_end - dst))
+            match_len = dst_end - dst;
+
+        if (offset >= match_len) {
+            memcpy(dst, dst - offset, match_len);
+            dst += match_len;
+        } else {
+            const uint8_t * ref = dst - offset;
+            for (size_t i = 0; i < match_len; i++)
+                *dst++ = *ref++;
+        }
+        if (dst == dst_end)
+            break;
+    }
+    return dst;
+}
+
+// Writes one framed block (compressed, or stored if that is not smaller).
+// Returns the number of bytes written, or 0 if dst_size is too small.
+static size_t
+lz4_frame_block(uint8_t * dst, size_t dst_size,
+                const uint8_t * src, size_t src_size, uint32_t * table) {
+    if (dst_size > 12) {
+        size_t limit = dst_size - 12 < src_size ? dst_size - 12 : src_size - 1;
+        size_t n = src_size > 1 ? lz4_encode_block(dst + 12, limit, src, src_size, table) : 0;
+
+        if (n) {
+            store_le32(dst, LZ4_COMPRESSED_MAGIC);
+            store_le32(dst + 4, (uint32_t)src_size);
+            store_le32(dst + 8, (uint32_t)n);
+            return 12 + n;
+        }
+    }
+
+    if (dst_size < 8 + src_size)
+        return 0;
+    store_le32(dst, LZ4_UNCOMPRESSED_MAGIC);
+    store_le32(dst + 4, (uint32_t)src_size);
+    memcpy(dst + 8, src, src_size);
+    return 8 + src_size;
+}
+
+static size_t
+lz4_encode_scratch_size(void) {
+    return LZ4_HASH_SIZE * sizeof(uint32_t);
+}
+
+static size_t
+lz4_decode_scratch_size(void) {
+    return 0;
+}
+
+static size_t
+lz4_raw_encode_buffer(uint8_t * dst, size_t dst_size,
+                      const uint8_t * src, size_t src_size, void * scratch) {
+    return lz4_encode_block(dst, dst_size, src, src_size, scratch);
+}
+
+static size_t
+lz4_raw_decode_buffer(uint8_t * dst, size_t dst_size,
+                      const uint8_t * src, size_t src_size, void * scratch) {
+    uint8_t * end = lz4_decode_block(dst, dst, dst + dst_size, src, src + src_size);
+    return end ? end - dst : 0;
+}
+
+static size_t
+lz4_encode_buffer(uint8_t * dst, size_t dst_size,
+                  const uint8_t * src, size_t src_size, void * scratch) {
+    uint8_t * const dst_start = dst;
+
+    while (src_size) {
+        size_t n = src_size < LZ4_BLOCK_SIZE ? src_size : LZ4_BLOCK_SIZE;
+        size_t written = lz4_frame_block(dst, dst_size, src, n, scratch);
+
+        if (!written)
+            return 0;
+        dst += written;
+        dst_size -= written;
+        src += n;
+        src_size -= n;
+    }
+
+    if (dst_size < 4)
+        return 0;
+    store_le32(dst, LZ4_END_MAGIC);
+    return dst + 4 - dst_start;
+}
+
+static size_t
+lz4_decode_buffer(uint8_t * dst, size_t dst_size,
+                  const uint8_t * src, size_t src_size, void * scratch) {
+    uint8_t * const dst_start = dst, * const dst_end = dst + dst_size;
+    const uint8_t * const src_end = src + src_size;
+
+    while (src_end - src >= 4) {
+        uint32_t magic = load_le32(src), n_raw, n_payload;
+        uint8_t * limit;
+
+        if (magic == LZ4_END_MAGIC)
+            break;
+
+        if (magic == LZ4_UNCOMPRESSED_MAGIC) {
+            if (src_end - src < 8)
+                return 0;
+            n_raw = load_le32(src + 4);
+            src += 8;
+            if (n_raw > (size_t)(src_end - src))
+                return 0;
+            if (n_raw >= (size_t)(dst_end - dst)) {
+                memcpy(dst, src, dst_end - dst);
+                return dst_size;
+            }
+            memcpy(dst, src, n_raw);
+            dst += n_raw;
+            src += n_raw;
+        } else if (magic == LZ4_COMPRESSED_MAGIC) {
+            if (src_end - src < 12)
+                return 0;
+            n_raw = load_le32(src + 4);
+            n_payload = load_le32(src + 8);
+            src += 12;
+            if (n_payload > (size_t)(src_end - src))
+                return 0;
+
+            limit = n_raw < (size_t)(dst_end - dst) ? dst + n_raw : dst_end;
+            dst = lz4_decode_block(dst_start, dst, limit, src, src + n_payload);
+            if (!dst)
+                return 0;
+            if (dst == dst_end)
+                return dst_size;
+            if (dst != limit)
+                return 0;
+            src += n_payload;
+        } else {
+            return 0;
+        }
+    }
+
+    return dst - dst_start;
+}
+
+// Streams
+
+enum lz4_stream_phase {
+    LZ4_PHASE_HEADER,
+    LZ4_PHASE_PAYLOAD,
+    LZ4_PHASE_END,
+};
+
+struct lz4_stream_state {
+    struct stream_state base;
+    enum lz4_stream_phase phase;
+
+    // encoder: input gathered into the next block
+    // decoder: payload of the current block, when it is split across calls
+    uint8_t * in;
+    size_t in_size, in_used;
+
+    // encoder: framed output not yet handed to the caller
+    uint8_t * out;
+    const uint8_t * out_ptr, * out_end;
+    uint32_t * table;
+
+    // decoder: current block header
+    uint8_t header[12];
+    size_t header_used;
+    uint32_t magic, n_raw, n_payload;
+
+    // decoder: decoded output, preceded by up to LZ4_HISTORY_SIZE bytes of history
+    uint8_t * window;
+    size_t window_size, window_pos, window_out;
+};
+
+// Frames src_size bytes, writing straight into the caller's buffer when it
+// can take the worst case and into our own pending buffer otherwise
+static void
+lz4_stream_emit_block(struct lz4_stream_state * state, compression_stream * stream,
+                      const uint8_t * src, size_t src_size) {
+    if (stream->dst_size >= LZ4_FRAME_BOUND(src_size)) {
+        size_t n = lz4_frame_block(stream->dst_ptr, stream->dst_size, src, src_size, state->table);
+        stream->dst_ptr += n;
+        stream->dst_size -= n;
+    } else {
+        size_t n = lz4_frame_block(state->out, LZ4_FRAME_BOUND(LZ4_BLOCK_SIZE), src, src_size, state->table);
+        state->out_ptr = state->out;
+        state->out_end = state->out + n;
+    }
+}
+
+static compression_status
+lz4_stream_encode(compression_stream * stream, int flags) {
+    struct lz4_stream_state * state = stream->state;
+    bool finalize = flags & COMPRESSION_STREAM_FINALIZE;
+
+    for (;;) {
+        if (!stream_drain(stream, &state->out_ptr, state->out_end))
+            return COMPRESSION_STATUS_OK;
+        if (state->phase == LZ4_PHASE_END)
+            return COMPRESSION_STATUS_END;
+
+        // whole blocks are compressed directly out of the caller's buffer
+        if (state->in_used == 0 && stream->src_size >= LZ4_BLOCK_SIZE) {
+            lz4_stream_emit_block(state, stream, stream->src_ptr, LZ4_BLOCK_SIZE);
+            stream->src_ptr += LZ4_BLOCK_SIZE;
+            stream->src_size -= LZ4_BLOCK_SIZE;
+            continue;
+        }
+
+        if (stream->src_size) {
+            size_t n = LZ4_BLOCK_SIZE - state->in_used;
+            if (n > stream->src_size)
+                n = stream->src_size;
+            memcpy(state->in + state->in_used, stream->src_ptr, n);
+            state->in_used += n;
+            stream->src_ptr += n;
+            stream->src_size -= n;
+        }
+
+        if (state->in_used == LZ4_BLOCK_SIZE || (finalize && state->in_used)) {
+            lz4_stream_emit_block(state, stream, state->in, state->in_used);
+            state->in_used = 0;
+            continue;
+        }
+
+        if (!finalize)
+            return COMPRESSION_STATUS_OK;
+
+        store_le32(state->out, LZ4_END_MAGIC);
+        state->out_ptr = state->out;
+        state->out_end = state->out + 4;
+        state->phase = LZ4_PHASE_END;
+    }
+}
+
+static bool
+lz4_stream_reserve(uint8_t ** buffer, size_t * size, size_t needed) {
+    uint8_t * p;
+
+    if (needed <= *size)
+        return true;
+    if (!(p = realloc(*buffer, needed)))
+        return false;
+    *buffer = p;
+    *size = needed;
+    return true;
+}
+
+static compression_status
+lz4_stream_decode(compression_stream * stream, int flags) {
+    struct lz4_stream_state * state = stream->state;
+    bool finalize = flags & COMPRESSION_STREAM_FINALIZE;
+
+    for (;;) {
+        const uint8_t * payload;
+        size_t payload_size, keep;
+
+        if (state->window_out < state->window_pos) {
+            const uint8_t * p = state->window + state->window_out;
+            stream_drain(stream, &p, state->window + state->window_pos);
+            state->window_out = p - state->window;
+            if (state->window_out < state->window_pos)
+                return COMPRESSION_STATUS_OK;
+        }
+
+        switch (state->phase) {
+            case LZ4_PHASE_END:
+                return COMPRESSION_STATUS_END;
+
+            case LZ4_PHASE_HEADER: {
+                size_t needed = 4;
+
+                if (state->header_used >= 4) {
+                    state->magic = load_le32(state->header);
+                    needed = state->magic == LZ4_END_MAGIC ? 4
+                           : state->magic == LZ4_UNCOMPRESSED_MAGIC ? 8
+                           : state->magic == LZ4_COMPRESSED_MAGIC ? 12 : 0;
+                    if (!needed)
+                        return COMPRESSION_STATUS_ERROR;
+                }
+
+                if (state->header_used < needed) {
+                    size_t n = needed - state->header_used;
+                    if (n > stream->src_size)
+                        n = stream->src_size;
+                    memcpy(state->header + state->header_used, stream->src_ptr, n);
+                    state->header_used += n;
+                    stream->src_ptr += n;
+                    stream->src_size -= n;
+
+                    // out of input; with FINALIZE, a partial header means truncation
+                    if (state->header_used < needed)
+                        return (finalize && state->header_used) ? COMPRESSION_STATUS_ERROR : COMPRESSION_STATUS_OK;
+                    // once the magic is in, the header may turn out to be longer
+                    continue;
+                }
+
+                state->header_used = 0;
+                if (state->magic == LZ4_END_MAGIC) {
+                    state->phase = LZ4_PHASE_END;
+                    continue;
+                }
+
+                state->n_raw = load_le32(state->header + 4);
+                state->n_payload = state->magic == LZ4_COMPRESSED_MAGIC ? load_le32(state->header + 8) : state->n_raw;
+                if (state->n_raw > LZ4_BLOCK_SIZE_MAX || state->n_payload > LZ4_BLOCK_SIZE_MAX)
+                    return COMPRESSION_STATUS_ERROR;
+                state->phase = LZ4_PHASE_PAYLOAD;
+                continue;
+            }
+
+            case LZ4_PHASE_PAYLOAD:
+                break;
+        }
+
+        // take the payload straight from the caller's buffer if it is all there
+        if (state->in_used == 0 && stream->src_size >= state->n_payload) {
+            payload = stream->src_ptr;
+            stream->src_ptr += state->n_payload;
+            stream->src_size -= state->n_payload;
+        } else {
+            size_t n = state->n_payload - state->in_used;
+
+            if (!lz4_stream_reserve(&state->in, &state->in_size, state->n_payload))
+                return COMPRESSION_STATUS_ERROR;
+            if (n > stream->src_size)
+                n = stream->src_size;
+            memcpy(state->in + state->in_used, stream->src_ptr, n);
+            state->in_used += n;
+            stream->src_ptr += n;
+            stream->src_size -= n;
+            if (state->in_used < state->n_payload)
+                return finalize ? COMPRESSION_STATUS_ERROR : COMPRESSION_STATUS_OK;
+            payload = state->in;
+        }
+        payload_size = state->n_payload;
+        state->in_used = 0;
+
+        // slide the window so that only the history precedes the new block
+        keep = state->window_pos < LZ4_HISTORY_SIZE ? state->window_pos : LZ4_HISTORY_SIZE;
+        if (keep)
+            memmove(state->window, state->window + state->window_pos - keep, keep);
+        state->window_pos = state->window_out = keep;
+        if (!lz4_stream_reserve(&state->window, &state->window_size, keep + state->n_raw))
+            return COMPRESSION_STATUS_ERROR;
+
+        if (state->magic == LZ4_UNCOMPRESSED_MAGIC) {
+            memcpy(state->window + keep, payload, payload_size);
+        } else {
+            uint8_t * end = lz4_decode_block(state->window, state->window + keep,
+                                             state->window + keep + state->n_raw,
+                                             payload, payload + payload_size);
+            if (end != state->window + keep + state->n_raw)
+                return COMPRESSION_STATUS_ERROR;
+        }
+        state->window_pos = keep + state->n_raw;
+        state->phase = LZ4_PHASE_HEADER;
+    }
+}
+
+static void
+lz4_stream_destroy(compression_stream * stream) {
+    struct lz4_stream_state * state = stream->state;
+
+    free(state->in);
+    free(state->out);
+    free(state->table);
+    free(state->window);
+    free(state);
+}
+
+static compression_status
+lz4_stream_init(compression_stream * stream, compression_stream_operation operation) {
+    struct lz4_stream_state * state = calloc(1, sizeof(*state));
+
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+
+    state->base.destroy = lz4_stream_destroy;
+    state->phase = LZ4_PHASE_HEADER;
+
+    if (operation == COMPRESSION_STREAM_ENCODE) {
+        state->base.process = lz4_stream_encode;
+        state->in_size = LZ4_BLOCK_SIZE;
+        state->in = malloc(state->in_size);
+        state->out = malloc(LZ4_FRAME_BOUND(LZ4_BLOCK_SIZE));
+        state->table = malloc(lz4_encode_scratch_size());
+        if (!state->in || !state->out || !state->table) {
+            lz4_stream_destroy(&(compression_stream){ .state = state });
+            return COMPRESSION_STATUS_ERROR;
+        }
+    } else {
+        state->base.process = lz4_stream_decode;
+    }
+
+    stream->state = state;
+    return COMPRESSION_STATUS_OK;
+}
+
+const struct algorithm_ops lz4_ops = {
+    .encode_scratch_size = lz4_encode_scratch_size,
+    .encode_buffer       = lz4_encode_buffer,
+    .decode_scratch_size = lz4_decode_scratch_size,
+    .decode_buffer       = lz4_decode_buffer,
+    .stream_init         = lz4_stream_init,
+};
+
+const struct algorithm_ops lz4_raw_ops = {
+    .encode_scratch_size = lz4_encode_scratch_size,
+    .encode_buffer       = lz4_raw_encode_buffer,
+    .decode_scratch_size = lz4_decode_scratch_size,
+    .decode_buffer       = lz4_raw_decode_buffer,
+};
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <string.h>
+#include "compression_internal.h"
+#include "lzfse_internal.h"
+
+// LZFSE
+//
+// The buffer API maps directly onto the reference implementation, which
+// shares libcompression's scratch buffer contract.
+//
+// For streams, the encoder compresses the input in LZFSE_STREAM_BLOCK_SIZE
+// pieces and drops the end-of-stream marker lzfse_encode_buffer appends to
+// all but the last one. The decoder frames the input into whole blocks
+// itself and runs the reference block decoder over each of them in turn,
+// writing into a window that keeps LZFSE_HISTORY_SIZE bytes of previous
+// output for matches that reach back across blocks.
+
+#define LZFSE_STREAM_BLOCK_SIZE (1 << 20)
+// comfortably above the largest match distance the format can encode
+#define LZFSE_HISTORY_SIZE      (1 << 20)
+#define LZFSE_WINDOW_SIZE       (LZFSE_HISTORY_SIZE + LZFSE_STREAM_BLOCK_SIZE)
+// sanity limit on compressed block sizes we accept from a stream
+#define LZFSE_BLOCK_SIZE_MAX    (1 << 26)
+
+// stored blocks plus end of stream are never larger than this
+#define LZFSE_ENCODE_BOUND(n) ((n) + 64)
+
+#define LZFSE_MAGIC_HEADER_SIZE 4
+
+static size_t
+lzfse_ops_encode_scratch_size(void) {
+    return lzfse_encode_scratch_size();
+}
+
+static size_t
+lzfse_ops_encode_buffer(uint8_t * dst, size_t dst_size,
+                        const uint8_t * src, size_t src_size, void * scratch) {
+    return lzfse_encode_buffer(dst, dst_size, src, src_size, scratch);
+}
+
+static size_t
+lzfse_ops_decode_scratch_size(void) {
+    return lzfse_decode_scratch_size();
+}
+
+static size_t
+lzfse_ops_decode_buffer(uint8_t * dst, size_t dst_size,
+                        const uint8_t * src, size_t src_size, void * scratch) {
+    return lzfse_decode_buffer(dst, dst_size, src, src_size, scratch);
+}
+
+// Streams
+
+struct lzfse_stream_state {
+    struct stream_state base;
+    bool end;
+
+    // encoder: input gathered into the next block, and its encoded form
+    // decoder: the current block, gathered from the input
+    uint8_t * in;
+    size_t in_size, in_used;
+    uint8_t * out;
+    const uint8_t * out_ptr, * out_end;
+    void * scratch;
+
+    // decoder: block decoder and its output window
+    lzfse_decoder_state * decoder;
+    bool in_block, window_full;
+    uint8_t * window;
+    size_t window_out;
+};
+
+// Compresses one piece of input, writing into the caller's buffer when the
+// worst case fits and into our pending buffer otherwise
+static compression_status
+lzfse_stream_emit(struct lzfse_stream_state * state, compression_stream * stream,
+                  const uint8_t * src, size_t src_size, bool last) {
+    uint8_t * dst = state->out;
+    size_t n;
+
+    if (stream->dst_size >= LZFSE_ENCODE_BOUND(src_size))
+        dst = stream->dst_ptr;
+
+    if (src_size == 0) {
+        // nothing left but the end-of-stream marker
+        store_le32(dst, LZFSE_ENDOFSTREAM_BLOCK_MAGIC);
+        n = LZFSE_MAGIC_HEADER_SIZE;
+    } else {
+        n = lzfse_encode_buffer(dst, LZFSE_ENCODE_BOUND(src_size), src, src_size, state->scratch);
+        if (n < LZFSE_MAGIC_HEADER_SIZE)
+            return COMPRESSION_STATUS_ERROR;
+    }
+    // every piece but the last continues the same stream
+    if (!last)
+        n -= LZFSE_MAGIC_HEADER_SIZE;
+
+    if (dst == stream->dst_ptr) {
+        stream->dst_ptr += n;
+        stream->dst_size -= n;
+    } else {
+        state->out_ptr = state->out;
+        state->out_end = state->out + n;
+    }
+    return COMPRESSION_STATUS_OK;
+}
+
+static compression_status
+lzfse_stream_encode(compression_stream * stream, int flags) {
+    struct lzfse_stream_state * state = stream->state;
+    bool finalize = flags & COMPRESSION_STREAM_FINALIZE;
+
+    for (;;) {
+        if (!stream_drain(stream, &state->out_ptr, state->out_end))
+            return COMPRESSION_STATUS_OK;
+        if (state->end)
+            return COMPRESSION_STATUS_END;
+
+        // whole blocks are compressed directly out of the caller's buffer
+        if (state->in_used == 0 && stream->src_size > LZFSE_STREAM_BLOCK_SIZE) {
+            if (lzfse_stream_emit(state, stream, stream->src_ptr, LZFSE_STREAM_BLOCK_SIZE, false))
+                return COMPRESSION_STATUS_ERROR;
+            stream->src_ptr += LZFSE_STREAM_BLOCK_SIZE;
+            stream->src_size -= LZFSE_STREAM_BLOCK_SIZE;
+            continue;
+        }
+
+        if (stream->src_size) {
+            size_t n = LZFSE_STREAM_BLOCK_SIZE - state->in_used;
+            if (n > stream->src_size)
+                n = stream->src_size;
+            memcpy(state->in + state->in_used, stream->src_ptr, n);
+            state->in_used += n;
+            stream->src_ptr += n;
+            stream->src_size -= n;
+        }
+
+        // hold on to a full block until we know whether more input follows,
+        // so that the last piece can carry the end-of-stream marker
+        if (state->in_used == LZFSE_STREAM_BLOCK_SIZE && stream->src_size) {
+            if (lzfse_stream_emit(state, stream, state->in, state->in_used, false))
+                return COMPRESSION_STATUS_ERROR;
+            state->in_used = 0;
+            continue;
+        }
+
+        if (!finalize)
+            return COMPRESSION_STATUS_OK;
+
+        if (lzfse_stream_emit(state, stream, state->in, state->in_used, true))
+            return COMPRESSION_STATUS_ERROR;
+        state->in_used = 0;
+        state->end = true;
+    }
+}
+
+// Returns the total size of the block starting with the in_used bytes we
+// have gathered, 0 if more header bytes are needed to tell, or -1 if the
+// block is not valid.
+static ssize_t
+lzfse_block_size(const uint8_t * p, size_t available) {
+    uint32_t magic;
+
+    if (available < 4)
+        return 0;
+    magic = load_le32(p);
+
+    switch (magic) {
+        case LZFSE_ENDOFSTREAM_BLOCK_MAGIC:
+            return 4;
+        case LZFSE_UNCOMPRESSED_BLOCK_MAGIC:
+            if (available < sizeof(uncompressed_block_header))
+                return 0;
+            return sizeof(uncompressed_block_header)
+                + load_le32(p + offsetof(uncompressed_block_header, n_raw_bytes));
+        case LZFSE_COMPRESSEDLZVN_BLOCK_MAGIC:
+            if (available < sizeof(lzvn_compressed_block_header))
+                return 0;
+            return sizeof(lzvn_compressed_block_header)
+                + load_le32(p + offsetof(lzvn_compressed_block_header, n_payload_bytes));
+        case LZFSE_COMPRESSEDV1_BLOCK_MAGIC:
+            if (available < sizeof(lzfse_compressed_block_header_v1))
+                return 0;
+            return sizeof(lzfse_compressed_block_header_v1)
+                + load_le32(p + offsetof(lzfse_compressed_block_header_v1, n_literal_payload_bytes))
+                + load_le32(p + offsetof(lzfse_compressed_block_header_v1, n_lmd_payload_bytes));
+        case LZFSE_COMPRESSEDV2_BLOCK_MAGIC: {
+            uint64_t v0, v1, v2;
+
+            if (available < offsetof(lzfse_compressed_block_header_v2, freq))
+                return 0;
+            memcpy(&v0, p + offsetof(lzfse_compressed_block_header_v2, packed_fields), 8);
+            memcpy(&v1, p + offsetof(lzfse_compressed_block_header_v2, packed_fields) + 8, 8);
+            memcpy(&v2, p + offsetof(lzfse_compressed_block_header_v2, packed_fields) + 16, 8);
+            // header size, literal payload and L/M/D payload sizes
+            return (v2 & 0xffffffff) + ((v0 >> 20) & 0xfffff) + ((v1 >> 40) & 0xfffff);
+        }
+        default:
+            return -1;
+    }
+}
+
+static compression_status
+lzfse_stream_decode(compression_stream * stream, int flags) {
+    struct lzfse_stream_state * state = stream->state;
+    lzfse_decoder_state * s = state->decoder;
+    bool finalize = flags & COMPRESSION_STREAM_FINALIZE;
+
+    for (;;) {
+        int status;
+
+        if (state->window_out < (size_t)(s->dst - state->window)) {
+            const uint8_t * p = state->window + state->window_out;
+            stream_drain(stream, &p, s->dst);
+            state->window_out = p - state->window;
+            if (p < s->dst)
+                return COMPRESSION_STATUS_OK;
+        }
+        if (state->end)
+            return COMPRESSION_STATUS_END;
+
+        if (!state->in_block) {
+            // gather the header four bytes at a time until we know the size
+            // of the block, then the rest of it
+            for (;;) {
+                ssize_t size = lzfse_block_size(state->in, state->in_used);
+                size_t wanted = size ? (size_t)size : state->in_used + 4;
+                size_t n;
+
+                if (size < 0 || size > LZFSE_BLOCK_SIZE_MAX || (size && (size_t)size < state->in_used))
+                    return COMPRESSION_STATUS_ERROR;
+                if (size && state->in_used == (size_t)size)
+                    break;
+
+                if (wanted > state->in_size) {
+                    uint8_t * p = realloc(state->in, wanted);
+                    if (!p)
+                        return COMPRESSION_STATUS_ERROR;
+                    state->in = p;
+                    state->in_size = wanted;
+                }
+
+                n = size ? wanted - state->in_used : 4 - (state->in_used & 3);
+                if (n > stream->src_size)
+                    n = stream->src_size;
+                if (n == 0)
+                    return (finalize && state->in_used) ? COMPRESSION_STATUS_ERROR : COMPRESSION_STATUS_OK;
+                memcpy(state->in + state->in_used, stream->src_ptr, n);
+                state->in_used += n;
+                stream->src_ptr += n;
+                stream->src_size -= n;
+            }
+
+            s->src = s->src_begin = state->in;
+            s->src_end = state->in + state->in_used;
+            state->in_block = true;
+        }
+
+        // once the window fills up, keep only the history in front of the
+        // output position; everything before window_out has been delivered
+        if (state->window_full) {
+            size_t keep = s->dst - state->window;
+            if (keep > LZFSE_HISTORY_SIZE)
+                keep = LZFSE_HISTORY_SIZE;
+            memmove(state->window, s->dst - keep, keep);
+            s->dst = state->window + keep;
+            state->window_out = keep;
+            state->window_full = false;
+        }
+        s->dst_begin = state->window;
+        s->dst_end = state->window + LZFSE_WINDOW_SIZE;
+
+        status = lzfse_decode(s);
+        switch (status) {
+            case LZFSE_STATUS_OK:
+                // end-of-stream block
+                state->end = s->end_of_stream;
+                state->in_block = false;
+                state->in_used = 0;
+                break;
+            case LZFSE_STATUS_SRC_EMPTY:
+                // the block is done and the decoder wants the next one
+                if (s->src != s->src_end)
+                    return COMPRESSION_STATUS_ERROR;
+                state->in_block = false;
+                state->in_used = 0;
+                break;
+            case LZFSE_STATUS_DST_FULL:
+                state->window_full = true;
+                break;
+            default:
+                return COMPRESSION_STATUS_ERROR;
+        }
+    }
+}
+
+static void
+lzfse_stream_destroy(compression_stream * stream) {
+    struct lzfse_stream_state * state = stream->state;
+
+    free(state->in);
+    free(state->out);
+    free(state->scratch);
+    free(state->decoder);
+    free(state->window);
+    free(state);
+}
+
+static compression_status
+lzfse_stream_init(compression_stream * stream, compression_stream_operation operation) {
+    struct lzfse_stream_state * state = calloc(1, sizeof(*state));
+    bool ok;
+
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+
+    state->base.destroy = lzfse_stream_destroy;
+
+    if (operation == COMPRESSION_STREAM_ENCODE) {
+        state->base.process = lzfse_stream_encode;
+        state->in_size = LZFSE_STREAM_BLOCK_SIZE;
+        state->in = malloc(state->in_size);
+        state->out = malloc(LZFSE_ENCODE_BOUND(LZFSE_STREAM_BLOCK_SIZE));
+        state->scratch = malloc(lzfse_encode_scratch_size());
+        ok = state->in && state->out && state->scratch;
+    } else {
+        state->base.process = lzfse_stream_decode;
+        state->decoder = calloc(1, sizeof(*state->decoder));
+        state->window = malloc(LZFSE_WINDOW_SIZE);
+        ok = state->decoder && state->window;
+        if (ok)
+            state->decoder->dst = state->decoder->dst_begin = state->window;
+    }
+
+    if (!ok) {
+        lzfse_stream_destroy(&(compression_stream){ .state = state });
+        return COMPRESSION_STATUS_ERROR;
+    }
+
+    stream->state = state;
+    return COMPRESSION_STATUS_OK;
+}
+
+const struct algorithm_ops lzfse_ops = {
+    .encode_scratch_size = lzfse_ops_encode_scratch_size,
+    .encode_buffer       = lzfse_ops_encode_buffer,
+    .decode_scratch_size = lzfse_ops_decode_scratch_size,
+    .decode_buffer       = lzfse_ops_decode_buffer,
+    .stream_init         = lzfse_stream_init,
+};
@@ -0,0 +1,154 @@
+#include <stdlib.h>
+#include <lzma.h>
+#include "compression_internal.h"
+
+// COMPRESSION_LZMA is an .xz container holding a single LZMA2 filter at preset 6
+
+#define XZ_PRESET 6
+
+// slack for the arena's alignment padding on top of liblzma's own estimates
+#define XZ_SCRATCH_SLACK (1 << 16)
+
+struct xz_stream_state {
+    struct stream_state base;
+    lzma_stream ls;
+};
+
+static void *
+xz_scratch_alloc(void * opaque, size_t nmemb, size_t size) {
+    return scratch_alloc(opaque, nmemb, size);
+}
+
+static void
+xz_scratch_free(void * opaque, void * ptr) {
+    scratch_free(opaque, ptr);
+}
+
+static size_t
+xz_encode_scratch_size(void) {
+    return lzma_easy_encoder_memusage(XZ_PRESET) + XZ_SCRATCH_SLACK;
+}
+
+static size_t
+xz_encode_buffer(uint8_t * dst, size_t dst_size,
+                 const uint8_t * src, size_t src_size, void * scratch) {
+    struct scratch_arena arena;
+    lzma_allocator allocator = { xz_scratch_alloc, xz_scratch_free, &arena };
+    lzma_options_lzma options;
+    lzma_filter filters[] = {
+        { .id = LZMA_FILTER_LZMA2, .options = &options },
+        { .id = LZMA_VLI_UNKNOWN },
+    };
+    size_t out_pos = 0;
+
+    scratch_arena_init(&arena, scratch, xz_encode_scratch_size());
+    if (lzma_lzma_preset(&options, XZ_PRESET))
+        return 0;
+    if (lzma_stream_buffer_encode(filters, LZMA_CHECK_CRC64, &allocator,
+                                  src, src_size, dst, &out_pos, dst_size) != LZMA_OK)
+        return 0;
+    return out_pos;
+}
+
+static size_t
+xz_decode_scratch_size(void) {
+    return lzma_easy_decoder_memusage(XZ_PRESET) + XZ_SCRATCH_SLACK;
+}
+
+static size_t
+xz_decode_buffer(uint8_t * dst, size_t dst_size,
+                 const uint8_t * src, size_t src_size, void * scratch) {
+    struct scratch_arena arena;
+    lzma_allocator allocator = { xz_scratch_alloc, xz_scratch_free, &arena };
+    lzma_stream ls = LZMA_STREAM_INIT;
+    lzma_ret ret;
+
+    // Not lzma_stream_buffer_decode: that one discards the output when the
+    // destination is too small, and we must return it truncated instead
+    scratch_arena_init(&arena, scratch, xz_decode_scratch_size());
+    ls.allocator = &allocator;
+    if (lzma_stream_decoder(&ls, UINT64_MAX, 0) != LZMA_OK)
+        return 0;
+
+    ls.next_in = src;
+    ls.avail_in = src_size;
+    ls.next_out = dst;
+    ls.avail_out = dst_size;
+    ret = lzma_code(&ls, LZMA_FINISH);
+    lzma_end(&ls);
+
+    if (ret != LZMA_OK && ret != LZMA_STREAM_END && ret != LZMA_BUF_ERROR)
+        return 0;
+    return dst_size - ls.avail_out;
+}
+
+static compression_status
+xz_stream_process(compression_stream * stream, int flags) {
+    struct xz_stream_state * state = stream->state;
+    lzma_ret ret;
+
+    state->ls.next_in = stream->src_ptr;
+    state->ls.avail_in = stream->src_size;
+    state->ls.next_out = stream->dst_ptr;
+    state->ls.avail_out = stream->dst_size;
+
+    ret = lzma_code(&state->ls, (flags & COMPRESSION_STREAM_FINALIZE) ? LZMA_FINISH : LZMA_RUN);
+
+    stream->src_ptr = state->ls.next_in;
+    stream->src_size = state->ls.avail_in;
+    stream->dst_ptr = state->ls.next_out;
+    stream->dst_size = state->ls.avail_out;
+
+    switch (ret) {
+        case LZMA_STREAM_END:
+            return COMPRESSION_STATUS_END;
+        case LZMA_OK:
+        case LZMA_BUF_ERROR:
+            return COMPRESSION_STATUS_OK;
+        default:
+            return COMPRESSION_STATUS_ERROR;
+    }
+}
+
+static void
+xz_stream_destroy(compression_stream * stream) {
+    struct xz_stream_state * state = stream->state;
+
+    lzma_end(&state->ls);
+    free(state);
+}
+
+static compression_status
+xz_stream_init(compression_stream * stream, compression_stream_operation operation) {
+    struct xz_stream_state * state = malloc(sizeof(*state));
+    lzma_stream init = LZMA_STREAM_INIT;
+    lzma_ret ret;
+
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+
+    state->base.process = xz_stream_process;
+    state->base.destroy = xz_stream_destroy;
+    state->ls = init;
+
+    if (operation == COMPRESSION_STREAM_ENCODE)
+        ret = lzma_easy_encoder(&state->ls, XZ_PRESET, LZMA_CHECK_CRC64);
+    else
+        ret = lzma_stream_decoder(&state->ls, UINT64_MAX, 0);
+
+    if (ret != LZMA_OK) {
+        free(state);
+        return COMPRESSION_STATUS_ERROR;
+    }
+
+    stream->state = state;
+    return COMPRESSION_STATUS_OK;
+}
+
+const struct algorithm_ops lzma_ops = {
+    .encode_scratch_size = xz_encode_scratch_size,
+    .encode_buffer       = xz_encode_buffer,
+    .decode_scratch_size = xz_decode_scratch_size,
+    .decode_buffer       = xz_decode_buffer,
+    .stream_init         = xz_stream_init,
+};
@@ -0,0 +1,189 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <zlib.h>
+#include "compression_internal.h"
+
+// COMPRESSION_ZLIB is raw DEFLATE (RFC 1951) without the zlib header, at level 5
+
+#define ZLIB_LEVEL     5
+#define ZLIB_MEM_LEVEL 8
+
+// deflate needs (1 << (windowBits + 2)) + (1 << (memLevel + 9)) bytes plus its
+// state, inflate needs its state plus the window; round both up generously
+#define ZLIB_ENCODE_SCRATCH_SIZE ((1 << (MAX_WBITS + 2)) + (1 << (ZLIB_MEM_LEVEL + 9)) + (1 << 16))
+#define ZLIB_DECODE_SCRATCH_SIZE ((1 << MAX_WBITS) + (1 << 14))
+
+struct zlib_stream_state {
+    struct stream_state base;
+    compression_stream_operation operation;
+    z_stream zs;
+};
+
+static voidpf
+zlib_scratch_alloc(voidpf opaque, uInt items, uInt size) {
+    return scratch_alloc(opaque, items, size);
+}
+
+static void
+zlib_scratch_free(voidpf opaque, voidpf address) {
+    scratch_free(opaque, address);
+}
+
+static inline uInt
+clamp_uint(size_t size) {
+    return size > UINT_MAX ? UINT_MAX : (uInt)size;
+}
+
+// Runs deflate/inflate on a z_stream over size_t-sized buffers, feeding zlib
+// at most UINT_MAX bytes at a time
+static int
+zlib_run(z_stream * zs, int (*code)(z_streamp, int), int flush,
+         uint8_t ** dst, size_t * dst_size, const uint8_t ** src, size_t * src_size) {
+    int ret;
+
+    do {
+        uInt avail_in = clamp_uint(*src_size), avail_out = clamp_uint(*dst_size);
+        int pass_flush = (avail_in == *src_size) ? flush : Z_NO_FLUSH;
+
+        zs->next_in = (Bytef *) *src;
+        zs->avail_in = avail_in;
+        zs->next_out = *dst;
+        zs->avail_out = avail_out;
+
+        ret = code(zs, pass_flush);
+
+        *src += avail_in - zs->avail_in;
+        *src_size -= avail_in - zs->avail_in;
+        *dst += avail_out - zs->avail_out;
+        *dst_size -= avail_out - zs->avail_out;
+    } while (ret == Z_OK && *dst_size > 0 && (*src_size > 0 || flush == Z_FINISH));
+
+    return ret;
+}
+
+static size_t
+zlib_encode_scratch_size(void) {
+    return ZLIB_ENCODE_SCRATCH_SIZE;
+}
+
+static size_t
+zlib_encode_buffer(uint8_t * dst, size_t dst_size,
+                   const uint8_t * src, size_t src_size, void * scratch) {
+    struct scratch_arena arena;
+    z_stream zs = { .zalloc = zlib_scratch_alloc, .zfree = zlib_scratch_free, .opaque = &arena };
+    uint8_t * dst_start = dst;
+    int ret;
+
+    scratch_arena_init(&arena, scratch, ZLIB_ENCODE_SCRATCH_SIZE);
+    if (deflateInit2(&zs, ZLIB_LEVEL, Z_DEFLATED, -MAX_WBITS, ZLIB_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK)
+        return 0;
+
+    ret = zlib_run(&zs, deflate, Z_FINISH, &dst, &dst_size, &src, &src_size);
+    deflateEnd(&zs);
+
+    // anything short of Z_STREAM_END means the output did not fit
+    return ret == Z_STREAM_END ? dst - dst_start : 0;
+}
+
+static size_t
+zlib_decode_scratch_size(void) {
+    return ZLIB_DECODE_SCRATCH_SIZE;
+}
+
+static size_t
+zlib_decode_buffer(uint8_t * dst, size_t dst_size,
+                   const uint8_t * src, size_t src_size, void * scratch) {
+    struct scratch_arena arena;
+    z_stream zs = { .zalloc = zlib_scratch_alloc, .zfree = zlib_scratch_free, .opaque = &arena };
+    uint8_t * dst_start = dst;
+    int ret;
+
+    scratch_arena_init(&arena, scratch, ZLIB_DECODE_SCRATCH_SIZE);
+    if (inflateInit2(&zs, -MAX_WBITS) != Z_OK)
+        return 0;
+
+    ret = zlib_run(&zs, inflate, Z_NO_FLUSH, &dst, &dst_size, &src, &src_size);
+    inflateEnd(&zs);
+
+    // a full destination buffer is not an error: the output is truncated
+    if (ret != Z_STREAM_END && ret != Z_OK && ret != Z_BUF_ERROR)
+        return 0;
+    return dst - dst_start;
+}
+
+static compression_status
+zlib_stream_process(compression_stream * stream, int flags) {
+    struct zlib_stream_state * state = stream->state;
+    bool finalize = flags & COMPRESSION_STREAM_FINALIZE;
+    bool encode = state->operation == COMPRESSION_STREAM_ENCODE;
+    size_t src_before = stream->src_size, dst_before = stream->dst_size;
+    int ret;
+
+    if (encode)
+        ret = zlib_run(&state->zs, deflate, finalize ? Z_FINISH : Z_NO_FLUSH,
+                       &stream->dst_ptr, &stream->dst_size, &stream->src_ptr, &stream->src_size);
+    else
+        ret = zlib_run(&state->zs, inflate, Z_NO_FLUSH,
+                       &stream->dst_ptr, &stream->dst_size, &stream->src_ptr, &stream->src_size);
+
+    switch (ret) {
+        case Z_STREAM_END:
+            return COMPRESSION_STATUS_END;
+        case Z_OK:
+            return COMPRESSION_STATUS_OK;
+        case Z_BUF_ERROR:
+            // no progress was possible; for a finalized decode with no more
+            // input coming and room left for output, the stream is truncated
+            if (!encode && finalize && stream->src_size == 0 && stream->dst_size != 0
+                && src_before == stream->src_size && dst_before == stream->dst_size)
+                return COMPRESSION_STATUS_ERROR;
+            return COMPRESSION_STATUS_OK;
+        default:
+            return COMPRESSION_STATUS_ERROR;
+    }
+}
+
+static void
+zlib_stream_destroy(compression_stream * stream) {
+    struct zlib_stream_state * state = stream->state;
+
+    if (state->operation == COMPRESSION_STREAM_ENCODE)
+        deflateEnd(&state->zs);
+    else
+        inflateEnd(&state->zs);
+    free(state);
+}
+
+static compression_status
+zlib_stream_init(compression_stream * stream, compression_stream_operation operation) {
+    struct zlib_stream_state * state = calloc(1, sizeof(*state));
+    int ret;
+
+    if (!state)
+        return COMPRESSION_STATUS_ERROR;
+
+    state->base.process = zlib_stream_process;
+    state->base.destroy = zlib_stream_destroy;
+    state->operation = operation;
+
+    if (operation == COMPRESSION_STREAM_ENCODE)
+        ret = deflateInit2(&state->zs, ZLIB_LEVEL, Z_DEFLATED, -MAX_WBITS, ZLIB_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+    else
+        ret = inflateInit2(&state->zs, -MAX_WBITS);
+
+    if (ret != Z_OK) {
+        free(state);
+        return COMPRESSION_STATUS_ERROR;
+    }
+
+    stream->state = state;
+    return COMPRESSION_STATUS_OK;
+}
+
+const struct algorithm_ops zlib_ops = {
+    .encode_scratch_size = zlib_encode_scratch_size,
+    .encode_buffer       = zlib_encode_buffer,
+    .decode_scratch_size = zlib_decode_scratch_size,
+    .decode_buffer       = zlib_decode_buffer,
+    .stream_init         = zlib_stream_init,
+};
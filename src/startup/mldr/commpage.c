@@ -8,6 +8,13 @@
 #include <cpuid.h>
 #include <unistd.h>
 #include <sys/sysinfo.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <pthread.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <x86intrin.h>
+#include <linux/perf_event.h>
 
 // Include commpage definitions
 #define PRIVATE
@@ -17,6 +24,7 @@ static const char* SIGNATURE32 = "commpage 32-bit";
 static const char* SIGNATURE64 = "commpage 64-bit";
 
 static uint64_t get_cpu_caps(void);
+static void time_setup(uint8_t* commpage);
 
 #define CGET(p) (commpage + ((p)-_COMM_PAGE_START_ADDRESS))
 
@@ -80,6 +88,8 @@ void commpage_setup(bool _64bit)
 		uint64_t* memsize = (uint64_t*)CGET(_COMM_PAGE_MEMORY_SIZE);
 		*memsize = si.totalram * si.mem_unit;
 	}
+
+	time_setup(commpage);
 }
 
 uint64_t get_cpu_caps(void)
@@ -159,3 +169,334 @@ unsigned long commpage_address(bool _64bit)
 	return _64bit ? _COMM_PAGE64_BASE_ADDRESS : _COMM_PAGE32_BASE_ADDRESS;
 }
 
+
+//
+// time data
+//
+// Darwin's libsystem_kernel computes mach_absolute_time(), gettimeofday() and mach_continuous_time() from the commpage
+// without entering the kernel, as long as the kernel keeps the data below up to date. There's no kernel doing that for us,
+// so we publish the same data from here: mach_absolute_time() is CLOCK_MONOTONIC in nanoseconds (our timebase is 1/1),
+// computed from the TSC. A thread re-anchors everything every TIME_REFRESH_INTERVAL_NS; in between, it slews the TSC
+// scale so that we follow CLOCK_MONOTONIC (including NTP adjustments) without ever going backwards.
+//
+
+// gettimeofday() readers stop trusting the data once it's a second old
+#define TIME_REFRESH_INTERVAL_NS 500000000ULL
+// how much faster or slower than the measured TSC frequency we're willing to run to catch up with CLOCK_MONOTONIC
+#define TIME_MAX_SLEW_PPM 500
+// if we're further behind than this (e.g. after a suspend), just jump ahead
+#define TIME_MAX_SLEW_NS 10000000LL
+// how long to measure the TSC frequency for when the kernel can't tell us
+#define TIME_CALIBRATION_NS 500000ULL
+
+// this mirrors xnu's new_commpage_timeofday_data_t
+struct commpage_timeofday_data {
+	uint64_t TimeStamp_tick;
+	uint64_t TimeStamp_sec;
+	uint64_t TimeStamp_frac;
+	uint64_t Ticks_scale;
+	uint64_t Ticks_per_sec;
+};
+
+static uint8_t* time_commpage = NULL;
+
+// nanoseconds per TSC tick, as a 32.32 fixed point number, before any slewing
+static double time_tsc_scale;
+// false if time_tsc_scale was measured by us and should be refined as we go
+static bool time_tsc_scale_exact;
+// the first sample, for refining time_tsc_scale
+static uint64_t time_first_tsc, time_first_ns;
+
+// what's currently published
+static uint64_t time_tsc_base, time_ns_base;
+static uint32_t time_scale;
+
+// the process the refresh thread was started in; a forked child needs its own
+static pid_t time_refresh_pid;
+
+static uint64_t read_tsc(void)
+{
+	_mm_lfence();
+	uint64_t tsc = __rdtsc();
+	_mm_lfence();
+	return tsc;
+}
+
+static uint64_t clock_ns(clockid_t clock)
+{
+	struct timespec ts;
+	clock_gettime(clock, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// reads `clock` and the TSC value closest to that moment
+static void time_sample(clockid_t clock, uint64_t* tsc, uint64_t* ns)
+{
+	uint64_t best_window = UINT64_MAX;
+
+	for (int i = 0; i < 3; i++)
+	{
+		uint64_t before = read_tsc();
+		uint64_t sample = clock_ns(clock);
+		uint64_t after = read_tsc();
+
+		if (after - before < best_window)
+		{
+			best_window = after - before;
+			*tsc = before + (after - before) / 2;
+			*ns = sample;
+		}
+	}
+}
+
+// (a * b) >> 32, without overflowing for any `a` we'll see
+static uint64_t mul_shift32(uint64_t a, uint32_t b)
+{
+	return (a >> 32) * b + (((a & 0xffffffff) * b) >> 32);
+}
+
+static uint64_t time_absolute(uint64_t tsc)
+{
+	return time_ns_base + mul_shift32(tsc - time_tsc_base, time_scale);
+}
+
+// the TSC is only good enough if Linux itself uses it for CLOCK_MONOTONIC
+static bool tsc_is_usable(void)
+{
+	char name[16] = {0};
+	int fd = open("/sys/devices/system/clocksource/clocksource0/current_clocksource", O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	ssize_t len = read(fd, name, sizeof(name) - 1);
+	close(fd);
+
+	return len >= 3 && strncmp(name, "tsc", 3) == 0 && (name[3] == '\n' || name[3] == '\0');
+}
+
+// the kernel's own TSC to nanoseconds conversion, from the perf_event user page
+static bool tsc_scale_from_perf(double* scale)
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_SOFTWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_SW_DUMMY;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	int fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	long page_size = sysconf(_SC_PAGESIZE);
+	volatile struct perf_event_mmap_page* page = mmap(NULL, page_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (page == MAP_FAILED)
+		return false;
+
+	bool ok = false;
+	uint32_t seq;
+	do
+	{
+		seq = page->lock;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (page->cap_user_time && page->time_shift < 64)
+		{
+			*scale = (double)page->time_mult * 4294967296.0 / (double)(1ULL << page->time_shift);
+			ok = true;
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	}
+	while (page->lock != seq);
+
+	munmap((void*)page, page_size);
+	return ok;
+}
+
+static void publish_nanotime(uint64_t tsc_base, uint32_t scale, uint64_t ns_base)
+{
+	uint8_t* commpage = time_commpage;
+	volatile uint32_t* generation = (volatile uint32_t*)CGET(_COMM_PAGE_NT_GENERATION);
+	uint32_t next = *generation + 1;
+	if (next == 0)
+		next = 1;
+
+	// readers wait while the generation is 0, and retry if it changed while they were reading
+	*generation = 0;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	*(volatile uint64_t*)CGET(_COMM_PAGE_NT_TSC_BASE) = tsc_base;
+	*(volatile uint32_t*)CGET(_COMM_PAGE_NT_SCALE) = scale;
+	*(volatile uint32_t*)CGET(_COMM_PAGE_NT_SHIFT) = 32;
+	*(volatile uint64_t*)CGET(_COMM_PAGE_NT_NS_BASE) = ns_base;
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	*generation = next;
+
+	time_tsc_base = tsc_base;
+	time_scale = scale;
+	time_ns_base = ns_base;
+}
+
+static void publish_timeofday(uint64_t abstime, uint64_t realtime_ns)
+{
+	uint8_t* commpage = time_commpage;
+	uint64_t remainder = realtime_ns % 1000000000ULL;
+	volatile struct commpage_timeofday_data* data = (volatile struct commpage_timeofday_data*)CGET(_COMM_PAGE_NEWTIMEOFDAY_DATA);
+
+	// a zero timestamp makes readers fall back to the syscall until we're done
+	data->TimeStamp_tick = 0;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	data->TimeStamp_sec = realtime_ns / 1000000000ULL;
+	// the fraction of a second, as a 0.64 fixed point number (computed 32 bits at a time)
+	data->TimeStamp_frac = (((remainder << 32) / 1000000000ULL) << 32) | ((((remainder << 32) % 1000000000ULL) << 32) / 1000000000ULL);
+	// the same for one tick (i.e. one nanosecond): 2^64 / 10^9
+	data->Ticks_scale = 18446744073ULL;
+	data->Ticks_per_sec = 1000000000ULL;
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	data->TimeStamp_tick = abstime;
+}
+
+static void publish_time(bool initial)
+{
+	uint8_t* commpage = time_commpage;
+	uint64_t tsc, monotonic_ns;
+
+	time_sample(CLOCK_MONOTONIC, &tsc, &monotonic_ns);
+
+	if (!time_tsc_scale_exact && tsc > time_first_tsc && monotonic_ns > time_first_ns)
+		time_tsc_scale = (double)(monotonic_ns - time_first_ns) * 4294967296.0 / (double)(tsc - time_first_tsc);
+
+	if (initial)
+	{
+		publish_nanotime(tsc, (uint32_t)time_tsc_scale, monotonic_ns);
+	}
+	else
+	{
+		// continue from where the current data says we are, but adjust the rate so that we reach CLOCK_MONOTONIC
+		// by the next refresh
+		uint64_t current = time_absolute(tsc);
+		int64_t behind = (int64_t)(monotonic_ns - current);
+		double scale = time_tsc_scale;
+
+		if (behind > TIME_MAX_SLEW_NS)
+		{
+			current = monotonic_ns;
+		}
+		else
+		{
+			double slew = (double)behind / TIME_REFRESH_INTERVAL_NS;
+			if (slew > TIME_MAX_SLEW_PPM / 1e6)
+				slew = TIME_MAX_SLEW_PPM / 1e6;
+			else if (slew < -TIME_MAX_SLEW_PPM / 1e6)
+				slew = -TIME_MAX_SLEW_PPM / 1e6;
+			scale *= 1.0 + slew;
+		}
+
+		publish_nanotime(tsc, (uint32_t)scale, current);
+	}
+
+	uint64_t realtime_tsc, realtime_ns;
+	time_sample(CLOCK_REALTIME, &realtime_tsc, &realtime_ns);
+	publish_timeofday(time_absolute(realtime_tsc), realtime_ns);
+
+	// mach_continuous_time() adds this to mach_absolute_time(); it's the time spent suspended
+	uint64_t boottime_ns = clock_ns(CLOCK_BOOTTIME);
+	uint64_t suspended_ns = boottime_ns - clock_ns(CLOCK_MONOTONIC);
+	*(volatile uint64_t*)CGET(_COMM_PAGE_CONT_TIMEBASE) = (int64_t)suspended_ns > 0 ? suspended_ns : 0;
+
+	if (initial)
+		*(volatile uint64_t*)CGET(_COMM_PAGE_BOOTTIME_USEC) = (clock_ns(CLOCK_REALTIME) - boottime_ns) / 1000;
+}
+
+static void* time_refresh_thread(void* arg)
+{
+	struct timespec interval = {
+		.tv_sec = TIME_REFRESH_INTERVAL_NS / 1000000000ULL,
+		.tv_nsec = TIME_REFRESH_INTERVAL_NS % 1000000000ULL,
+	};
+
+	(void)arg;
+
+	while (true)
+	{
+		while (nanosleep(&interval, NULL) != 0 && errno == EINTR);
+		publish_time(false);
+	}
+
+	return NULL;
+}
+
+static void start_time_refresh_thread(void)
+{
+	pthread_t thread;
+	pthread_attr_t attr;
+	sigset_t all, old;
+
+	// this thread isn't known to darlingserver and mustn't run any signal handlers meant for Darwin threads
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &old);
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	pthread_attr_setstacksize(&attr, 64 * 1024);
+
+	if (pthread_create(&thread, &attr, time_refresh_thread, NULL) != 0)
+		fprintf(stderr, "mldr: failed to start commpage time thread; time data will become stale\n");
+	else
+		time_refresh_pid = getpid();
+
+	pthread_attr_destroy(&attr);
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+
+static void time_setup(uint8_t* commpage)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	// we need an invariant TSC and a kernel that agrees
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1 << 8)) || !tsc_is_usable())
+		return;
+
+	time_commpage = commpage;
+	time_sample(CLOCK_MONOTONIC, &time_first_tsc, &time_first_ns);
+
+	time_tsc_scale_exact = tsc_scale_from_perf(&time_tsc_scale);
+	if (!time_tsc_scale_exact)
+	{
+		uint64_t tsc, ns;
+
+		do
+			time_sample(CLOCK_MONOTONIC, &tsc, &ns);
+		while (ns - time_first_ns < TIME_CALIBRATION_NS);
+
+		time_tsc_scale = (double)(ns - time_first_ns) * 4294967296.0 / (double)(tsc - time_first_tsc);
+	}
+
+	// readers assume a shift of 32, which only works if a tick is shorter than a nanosecond
+	if (time_tsc_scale <= 0 || time_tsc_scale >= 4294967296.0)
+	{
+		time_commpage = NULL;
+		return;
+	}
+
+	publish_time(true);
+	start_time_refresh_thread();
+
+	// Darwin forks go through libsystem_kernel, which lets us know via the process lifetime pipe refresh (see elfcalls.c);
+	// this covers forks on the ELF side
+	pthread_atfork(NULL, NULL, commpage_postfork_child);
+}
+
+void commpage_postfork_child(void)
+{
+	// the child got a copy of the data, but not the thread that keeps it up to date;
+	// both of the paths that call this may see the same fork, so only start one thread per process
+	if (time_commpage != NULL && time_refresh_pid != getpid())
+		start_time_refresh_thread();
+}
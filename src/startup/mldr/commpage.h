@@ -9,6 +9,8 @@ extern "C" {
 
 void commpage_setup(bool _64bit);
 unsigned long commpage_address(bool _64bit);
+// restarts the thread that keeps the time data up to date
+void commpage_postfork_child(void);
 
 union cpu_flags1 {
   struct {
@@ -8,6 +8,7 @@
 #include <unistd.h>
 #include "elfcalls.h"
 #include "threads.h"
+#include "../commpage.h"
 #include <sys/un.h>
 #include <sys/socket.h>
 #include <fcntl.h>
@@ -81,6 +82,10 @@ static int __dserver_process_lifetime_pipe_refresh() {
 	}
 
 	__dserver_process_lifetime_pipe_fd = pipe[1];
+
+	// libsystem_kernel only refreshes the pipe in a freshly forked child, so this is our chance to fix up the rest of the process
+	commpage_postfork_child();
+
 	return pipe[0];
 }
 
@@ -126,4 +131,6 @@ void elfcalls_make(struct elf_calls* calls)
 	calls->dserver_get_process_lifetime_pipe = __dserver_get_process_lifetime_pipe;
 	calls->dserver_process_lifetime_pipe_refresh = __dserver_process_lifetime_pipe_refresh;
 	calls->dserver_close_process_lifetime_pipe = __mldr_close_process_lifetime_pipe;
+
+	calls->commpage_postfork_child = commpage_postfork_child;
 }
@@ -71,6 +71,9 @@ struct elf_calls
 	int (*dserver_get_process_lifetime_pipe)(void);
 	int (*dserver_process_lifetime_pipe_refresh)(void);
 	void (*dserver_close_process_lifetime_pipe)(int fd);
+
+	// commpage time data (must be called in the child after a fork)
+	void (*commpage_postfork_child)(void);
 };
 
 #endif
@@ -535,159 +535,95 @@ static void unset_special_env() {
 	unsetenv("__mldr_lifetime_pipe");
 };
 
+typedef unsigned long socket_bitmap_word_t;
+
+#define SOCKET_BITMAP_WORD_BITS (sizeof(socket_bitmap_word_t) * 8)
+
 typedef struct socket_bitmap {
-	pthread_mutex_t mutex;
+	pthread_once_t once;
 	/**
-	 * This is always next lowest available index.
-	 * If this is equal to #bit_length, then the bitmap is full.
+	 * One bit per descriptor, counting down from #highest.
+	 * This is allocated once for the whole descriptor range, so it's never resized or locked;
+	 * entries are claimed and released with atomic operations on whole words.
 	 */
-	size_t next_index;
-	uint8_t* bits;
+	socket_bitmap_word_t* words;
+	size_t word_count;
 	size_t bit_length;
 	int highest;
 } socket_bitmap_t;
 
 static socket_bitmap_t socket_bitmap = {
-	.mutex = PTHREAD_MUTEX_INITIALIZER,
-	.next_index = 0,
-	.bits = NULL,
+	.once = PTHREAD_ONCE_INIT,
+	.words = NULL,
+	.word_count = 0,
 	.bit_length = 0,
 	.highest = -1,
 };
 
-static int socket_bitmap_get(socket_bitmap_t* bitmap) {
-	int fd = -1;
-	bool updated = false;
-
-	pthread_mutex_lock(&bitmap->mutex);
-
-	if (bitmap->highest == -1) {
-		// we need to initialize this bitmap
-		struct rlimit limit;
-
-		if (getrlimit(RLIMIT_NOFILE, &limit) < 0) {
-			goto out;
-		}
-
-		if (limit.rlim_cur == RLIM_INFINITY) {
-			// just default to 1024
-			limit.rlim_cur = 1024;
-		}
+static void socket_bitmap_init(void) {
+	socket_bitmap_t* bitmap = &socket_bitmap;
+	struct rlimit limit;
 
-		bitmap->highest = limit.rlim_cur - 1;
+	if (getrlimit(RLIMIT_NOFILE, &limit) < 0) {
+		return;
 	}
 
-	if (bitmap->next_index >= bitmap->bit_length) {
-		// we need to grow the bitmap
-
-		if ((bitmap->bit_length % 8) == 0) {
-			// we need to allocate an additional byte
-
-			void* ptr = realloc(bitmap->bits, (bitmap->bit_length / 8) + 1);
-			if (!ptr) {
-				goto out;
-			}
-
-			bitmap->bits = ptr;
-
-			bitmap->bits[bitmap->bit_length / 8] = 0;
-		} else {
-			// we just need to increment the bit length
-		}
-
-		++bitmap->bit_length;
+	if (limit.rlim_cur == RLIM_INFINITY) {
+		// just default to 1024
+		limit.rlim_cur = 1024;
 	}
 
-	fd = bitmap->highest - bitmap->next_index;
+	size_t word_count = (limit.rlim_cur + SOCKET_BITMAP_WORD_BITS - 1) / SOCKET_BITMAP_WORD_BITS;
 
-	bitmap->bits[bitmap->next_index / 8] |= 1 << (bitmap->next_index % 8);
-
-	// update the next available index
-	for (size_t i = bitmap->next_index + 1; i < bitmap->bit_length; ++i) {
-		size_t byte = i / 8;
-		uint8_t bit = i % 8;
-
-		if (bit == 0) {
-			// check the entire byte at once so we can avoid unnecessary iteration
-			if (bitmap->bits[byte] == 0xff) {
-				// this byte is full, skip it
-				i += 7;
-				continue;
-			}
-		}
-
-		if ((bitmap->bits[byte] & (1 << bit)) == 0) {
-			// this index is unused
-			bitmap->next_index = i;
-			updated = true;
-			break;
-		}
-	}
-
-	if (!updated) {
-		// all of our entries are currently in-use
-		bitmap->next_index = bitmap->bit_length;
+	// mmap'd so that the untouched part of a large range costs nothing
+	void* words = mmap(NULL, word_count * sizeof(socket_bitmap_word_t), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (words == MAP_FAILED) {
+		return;
 	}
 
-out:
-	pthread_mutex_unlock(&bitmap->mutex);
-
-	return fd;
+	bitmap->words = words;
+	bitmap->word_count = word_count;
+	bitmap->bit_length = limit.rlim_cur;
+	bitmap->highest = limit.rlim_cur - 1;
 };
 
-static void socket_bitmap_put(socket_bitmap_t* bitmap, int socket) {
-	size_t index;
-
-	pthread_mutex_lock(&bitmap->mutex);
-
-	index = bitmap->highest - socket;
-
-	bitmap->bits[index / 8] &= ~(1 << (index % 8));
+static int socket_bitmap_get(socket_bitmap_t* bitmap) {
+	pthread_once(&bitmap->once, socket_bitmap_init);
 
-	if (index < bitmap->next_index) {
-		bitmap->next_index = index;
+	if (bitmap->words == NULL) {
+		return -1;
 	}
 
-	if (index == bitmap->bit_length - 1) {
-		// we can shrink the bitmap
-		size_t old_byte_size = (bitmap->bit_length + 7) / 8;
-		size_t new_byte_size = old_byte_size;
-
-		while (bitmap->bit_length > 0) {
-			size_t index = bitmap->bit_length - 1;
+	// we always hand out the lowest free index (i.e. the highest free descriptor),
+	// so the used entries stay packed at the start of the bitmap and this scan is short
+	for (size_t i = 0; i < bitmap->word_count; ++i) {
+		socket_bitmap_word_t word = __atomic_load_n(&bitmap->words[i], __ATOMIC_RELAXED);
 
-			if ((bitmap->bit_length % 8) == 0) {
-				// check the entire byte at once to avoid unnecessary iteration
-				if (bitmap->bits[(bitmap->bit_length / 8) - 1] == 0) {
-					// remove this entire byte
-					bitmap->bit_length -= 8;
-					continue;
-				}
-			}
+		while (~word != 0) {
+			unsigned int bit = __builtin_ctzl(~word);
+			size_t index = i * SOCKET_BITMAP_WORD_BITS + bit;
 
-			if ((bitmap->bits[index / 8] & (1 << (index % 8))) == 0) {
-				// this bit is in-use, so we can't shrink any further
+			if (index >= bitmap->bit_length) {
+				// the rest of the last word lies outside the descriptor range
 				break;
 			}
 
-			--bitmap->bit_length;
-		}
-
-		new_byte_size = (bitmap->bit_length + 7) / 8;
-
-		if (old_byte_size != new_byte_size) {
-			// we can free one or more bytes from the bitmap
-			void* ptr = realloc(bitmap->bits, new_byte_size);
-			if (!ptr) {
-				goto out;
+			// on failure, `word` is updated with the current value and we try again with the next free bit in it
+			if (__atomic_compare_exchange_n(&bitmap->words[i], &word, word | ((socket_bitmap_word_t)1 << bit), true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+				return bitmap->highest - index;
 			}
-
-			bitmap->bits = ptr;
 		}
 	}
 
-out:
-	pthread_mutex_unlock(&bitmap->mutex);
+	// all of our entries are currently in-use
+	errno = EMFILE;
+	return -1;
+};
+
+static void socket_bitmap_put(socket_bitmap_t* bitmap, int socket) {
+	size_t index = bitmap->highest - socket;
+
+	__atomic_fetch_and(&bitmap->words[index / SOCKET_BITMAP_WORD_BITS], ~((socket_bitmap_word_t)1 << (index % SOCKET_BITMAP_WORD_BITS)), __ATOMIC_RELEASE);
 };
 
 int __mldr_create_rpc_socket(void) {
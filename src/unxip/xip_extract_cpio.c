@@ -10,12 +10,17 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <xar/xar.h>
 #include <lzma.h>
 #define min(A,B) ({ __typeof__(A) __a = (A); __typeof__(B) __b = (B); __a < __b ? __a : __b; })
 #define err(c, m) if (c) { fprintf(stderr, m"\n"); exit(__COUNTER__ + 1); }
 #define XBSZ 4 * 1024
 #define ZBSZ 1024 * XBSZ
+// pbzx chunks are at most this large, both compressed and uncompressed
+#define CHUNK_MAX 0x1000000
+#define THREADS_MAX 256
 
 static inline void xar_read(char *buffer, uint32_t size, xar_stream *stream) {
     stream->next_out = buffer;
@@ -37,33 +42,17 @@ static inline uint64_t xar_read_64(xar_stream *stream) {
     return __builtin_bswap64(*(uint64_t *)t);
 }
 
-int main(int argc, const char * argv[])
-{
+// Streaming single-threaded decoder; never holds more than one 4 KiB block of input
+static void extract_serial(xar_stream *xs, uint64_t flags) {
     char xbuf[XBSZ], *zbuf = malloc(ZBSZ);
-    xar_t x;
-    err(argc < 2, "No file specified");
-    err(!(x = xar_open(argv[1], READ)), "XAR open failure");
-    xar_iter_t i = xar_iter_new();
-    xar_file_t f = xar_file_first(x, i);
-    char *path;
-    while (strncmp((path = xar_get_path(f)), "Content", 7) && (f = xar_file_next(i)))
-        free(path);
-    free(path);
-    xar_iter_free(i);
-    err(!f, "No payload");
-    err(xar_verify(x, f) != XAR_STREAM_OK, "File verification failed");
-    xar_stream xs;
-    err(xar_extract_tostream_init(x, f, &xs) != XAR_STREAM_OK, "XAR init failed");
-    xar_read(xbuf, 4, &xs);
-    err(strncmp(xbuf, "pbzx", 4), "Not a pbzx stream");
-    uint64_t length = 0, flags = xar_read_64(&xs), last = 0;
+    uint64_t length = 0, last = 0;
     lzma_stream zs = LZMA_STREAM_INIT;
     err(lzma_stream_decoder(&zs, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK, "LZMA init failed");
     while (flags & 1 << 24) {
-        flags = xar_read_64(&xs);
-        length = xar_read_64(&xs);
+        flags = xar_read_64(xs);
+        length = xar_read_64(xs);
         char plain = length == 0x1000000;
-        xar_read(xbuf, min(XBSZ, (uint32_t)length), &xs);
+        xar_read(xbuf, min(XBSZ, (uint32_t)length), xs);
         err(!plain && strncmp(xbuf, "\xfd""7zXZ\0", 6), "Header is not <FD>7zXZ<00>");
         while (length) {
             if (plain)
@@ -79,13 +68,204 @@ int main(int argc, const char * argv[])
                 }
             }
             length -= last = min(XBSZ, length);
-            xar_read(xbuf, min(XBSZ, (uint32_t)length), &xs);
+            xar_read(xbuf, min(XBSZ, (uint32_t)length), xs);
         }
         err(!plain && strncmp(xbuf + last - 2, "YZ", 2), "Footer is not YZ");
     }
-    xar_extract_tostream_end(&xs);
     free(zbuf);
     lzma_end(&zs);
+}
+
+// Parallel decoder
+//
+// Every pbzx chunk is an independent XZ stream whose compressed and
+// uncompressed sizes are known up front, so the main thread reads whole
+// chunks into a ring of slots, a pool of workers decodes them concurrently,
+// and a writer thread emits the slots strictly in chunk order. The ring is
+// the reorder buffer: the reader stalls once it gets a full ring ahead of
+// the writer, which bounds memory to nslots * 2 * CHUNK_MAX.
+
+enum slot_state { SLOT_FREE, SLOT_READ, SLOT_DECODING, SLOT_DONE, SLOT_EOF };
+
+struct slot {
+    enum slot_state state;
+    char plain;
+    char *in, *out;
+    uint64_t in_size, out_size;
+};
+
+struct pipeline {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct slot *slots;
+    unsigned nslots;
+    // next chunk index to be read, decoded and written, respectively
+    uint64_t next_read, next_decode, next_write;
+};
+
+static void* decode_worker(void *arg) {
+    struct pipeline *p = arg;
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        struct slot *s = &p->slots[p->next_decode % p->nslots];
+        if (s->state == SLOT_EOF)
+            break;
+        if (s->state != SLOT_READ) {
+            pthread_cond_wait(&p->cond, &p->lock);
+            continue;
+        }
+        s->state = SLOT_DECODING;
+        p->next_decode++;
+        pthread_mutex_unlock(&p->lock);
+
+        if (!s->plain) {
+            uint64_t memlimit = UINT64_MAX;
+            size_t in_pos = 0, out_pos = 0;
+            err(lzma_stream_buffer_decode(&memlimit, 0, NULL, (uint8_t *)s->in, &in_pos, s->in_size,
+                (uint8_t *)s->out, &out_pos, s->out_size) != LZMA_OK, "LZMA failure");
+            err(out_pos != s->out_size, "LZMA chunk size mismatch");
+        }
+
+        pthread_mutex_lock(&p->lock);
+        s->state = SLOT_DONE;
+        pthread_cond_broadcast(&p->cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+static void* write_worker(void *arg) {
+    struct pipeline *p = arg;
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        struct slot *s = &p->slots[p->next_write % p->nslots];
+        if (s->state == SLOT_EOF)
+            break;
+        if (s->state != SLOT_DONE) {
+            pthread_cond_wait(&p->cond, &p->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&p->lock);
+
+        cpio_out(s->plain ? s->in : s->out, s->out_size);
+
+        pthread_mutex_lock(&p->lock);
+        s->state = SLOT_FREE;
+        p->next_write++;
+        pthread_cond_broadcast(&p->cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+static void extract_parallel(xar_stream *xs, uint64_t flags, unsigned nthreads) {
+    struct pipeline p = {
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER,
+        .nslots = nthreads * 2,
+    };
+    pthread_t writer, workers[THREADS_MAX];
+
+    err(!(p.slots = calloc(p.nslots, sizeof(*p.slots))), "Out of memory");
+    for (unsigned i = 0; i < nthreads; i++)
+        err(pthread_create(&workers[i], NULL, decode_worker, &p), "Failed to create decoder thread");
+    err(pthread_create(&writer, NULL, write_worker, &p), "Failed to create writer thread");
+
+    while (flags & 1 << 24) {
+        flags = xar_read_64(xs);
+        uint64_t length = xar_read_64(xs);
+        err(length > CHUNK_MAX || flags > CHUNK_MAX, "Chunk too large");
+
+        struct slot *s = &p.slots[p.next_read % p.nslots];
+        pthread_mutex_lock(&p.lock);
+        while (s->state != SLOT_FREE)
+            pthread_cond_wait(&p.cond, &p.lock);
+        pthread_mutex_unlock(&p.lock);
+
+        // buffers are allocated lazily and then reused for the lifetime of the slot
+        if (!s->in)
+            err(!(s->in = malloc(CHUNK_MAX)) || !(s->out = malloc(CHUNK_MAX)), "Out of memory");
+        s->plain = length == 0x1000000;
+        s->in_size = length;
+        s->out_size = s->plain ? length : flags;
+        xar_read(s->in, (uint32_t)length, xs);
+        err(!s->plain && (length < 8 || strncmp(s->in, "\xfd""7zXZ\0", 6)), "Header is not <FD>7zXZ<00>");
+        err(!s->plain && strncmp(s->in + length - 2, "YZ", 2), "Footer is not YZ");
+
+        pthread_mutex_lock(&p.lock);
+        s->state = SLOT_READ;
+        p.next_read++;
+        pthread_cond_broadcast(&p.cond);
+        pthread_mutex_unlock(&p.lock);
+    }
+
+    // the EOF marker takes the place of the chunk after the last one
+    struct slot *s = &p.slots[p.next_read % p.nslots];
+    pthread_mutex_lock(&p.lock);
+    while (s->state != SLOT_FREE)
+        pthread_cond_wait(&p.cond, &p.lock);
+    s->state = SLOT_EOF;
+    pthread_cond_broadcast(&p.cond);
+    pthread_mutex_unlock(&p.lock);
+
+    for (unsigned i = 0; i < nthreads; i++)
+        pthread_join(workers[i], NULL);
+    pthread_join(writer, NULL);
+
+    for (unsigned i = 0; i < p.nslots; i++) {
+        free(p.slots[i].in);
+        free(p.slots[i].out);
+    }
+    free(p.slots);
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "Usage: %s [-j threads] <xip-file>\n", argv0);
+    exit(1);
+}
+
+int main(int argc, char * const argv[])
+{
+    char xbuf[XBSZ];
+    xar_t x;
+    long nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int c;
+
+    while ((c = getopt(argc, argv, "j:")) != -1) {
+        switch (c) {
+            case 'j':
+                nthreads = strtol(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    err(optind >= argc, "No file specified");
+    if (nthreads < 1)
+        nthreads = 1;
+    else if (nthreads > THREADS_MAX)
+        nthreads = THREADS_MAX;
+
+    err(!(x = xar_open(argv[optind], READ)), "XAR open failure");
+    xar_iter_t i = xar_iter_new();
+    xar_file_t f = xar_file_first(x, i);
+    char *path;
+    while (strncmp((path = xar_get_path(f)), "Content", 7) && (f = xar_file_next(i)))
+        free(path);
+    free(path);
+    xar_iter_free(i);
+    err(!f, "No payload");
+    err(xar_verify(x, f) != XAR_STREAM_OK, "File verification failed");
+    xar_stream xs;
+    err(xar_extract_tostream_init(x, f, &xs) != XAR_STREAM_OK, "XAR init failed");
+    xar_read(xbuf, 4, &xs);
+    err(strncmp(xbuf, "pbzx", 4), "Not a pbzx stream");
+    uint64_t flags = xar_read_64(&xs);
+    if (nthreads == 1)
+        extract_serial(&xs, flags);
+    else
+        extract_parallel(&xs, flags, (unsigned)nthreads);
+    xar_extract_tostream_end(&xs);
     xar_close(x);
     return 0;
 }
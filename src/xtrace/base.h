@@ -19,4 +19,11 @@
 	#define XTRACE_DECLARATIONS_C_END
 #endif
 
+// cheap timestamp for measuring calls; only meaningful relative to other timestamps
+// (callers relate it to mach_absolute_time themselves)
+XTRACE_INLINE
+unsigned long long xtrace_read_timestamp(void) {
+	return __builtin_ia32_rdtsc();
+};
+
 #endif // _XTRACE_BASE_H_
@@ -0,0 +1,743 @@
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+
+#include <darling/emulation/simple.h>
+#include <darling/emulation/ext/for-xtrace.h>
+#include <darling/emulation/ext/futex.h>
+
+#include "xtracelib.h"
+#include "binary_trace.h"
+#include "mach_trace.h"
+#include "bsd_trace.h"
+#include "mig_trace.h"
+#include "tls.h"
+#include "lock.h"
+#include "memory.h"
+#include "string.h"
+
+//
+// binary trace mode (XTRACE_BINARY)
+//
+// instead of formatting every call in the traced thread, we just copy the raw call number, arguments and return value
+// into a per-thread single-producer/single-consumer ring buffer. a background thread drains all the rings into
+// `${XTRACE_LOG_FILE}.${PID}.bin` and `xtrace --decode` turns that into the normal xtrace output later on.
+//
+
+extern "C" int sys_thread_selfid(void);
+
+// number of events per ring; must be a power of two (events are 64 bytes, so this is 1MiB per thread)
+#define RING_EVENTS 16384
+// the writer is woken up early when a ring becomes this full
+#define RING_WAKE_THRESHOLD (RING_EVENTS / 2)
+// otherwise, it drains the rings at this interval
+#define WRITER_INTERVAL_NS (50 * 1000 * 1000)
+
+// how many nested calls we remember call numbers for
+#define NESTING_MAX 64
+
+#define NR_UNKNOWN 0xffff
+
+enum ring_state {
+	// owned by a live thread
+	ring_state_live,
+	// the thread has exited; the writer still has to drain it
+	ring_state_dead,
+	// drained and ready to be reused by a new thread
+	ring_state_free,
+};
+
+struct ring {
+	// only written by the owning thread
+	uint64_t head __attribute__((aligned(64)));
+	uint64_t lost;
+	int depth;
+	bool flushing;
+	uint32_t tid;
+	uint16_t nrs[NESTING_MAX];
+	// for mach_msg: where to find the received message on exit and which port the request went to
+	const mach_msg_header_t* rcv_msg[NESTING_MAX];
+	mach_port_name_t request_port[NESTING_MAX];
+
+	// only written with flush_lock held
+	uint64_t tail __attribute__((aligned(64)));
+
+	uint32_t state;
+	struct ring* next;
+
+	struct xtrace_binary_event* events;
+};
+
+#define RING_HEADER_SIZE ((sizeof(struct ring) + 4095) & ~4095UL)
+#define RING_MAPPING_SIZE (RING_HEADER_SIZE + RING_EVENTS * sizeof(struct xtrace_binary_event))
+
+// the writer thread doesn't record anything; it gets this instead of a real ring
+#define RING_IGNORED ((struct ring*)1)
+
+int xtrace_binary = 0;
+
+static struct ring* rings = NULL;
+
+static xtrace_lock_t flush_lock = XTRACE_LOCK_INITIALIZER;
+static int output_fd = -1;
+static char output_base[PATH_MAX];
+
+static bool writer_running = false;
+static uint32_t writer_wakeup = 0;
+
+static void binary_ring_destroy(struct ring** ptr);
+
+DEFINE_XTRACE_TLS_VAR(struct ring*, binary_ring, NULL, binary_ring_destroy);
+
+static void binary_ring_destroy(struct ring** ptr) {
+	if (*ptr != NULL && *ptr != RING_IGNORED) {
+		__atomic_store_n(&(*ptr)->state, ring_state_dead, __ATOMIC_RELEASE);
+	}
+};
+
+static struct ring* ring_acquire(void) {
+	struct ring* ring;
+
+	// reuse the ring of an exited thread if the writer is done with it
+	for (ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+		uint32_t expected = ring_state_free;
+		if (__atomic_compare_exchange_n(&ring->state, &expected, ring_state_live, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+			break;
+		}
+	}
+
+	if (ring == NULL) {
+		void* mapping = _mmap_for_xtrace(NULL, RING_MAPPING_SIZE, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+		if ((uintptr_t)mapping > (uintptr_t)-4096) {
+			xtrace_abort("xtrace: failed to allocate binary trace buffer");
+		}
+
+		ring = (struct ring*)mapping;
+		ring->events = (struct xtrace_binary_event*)((char*)mapping + RING_HEADER_SIZE);
+		ring->state = ring_state_live;
+
+		struct ring* head = __atomic_load_n(&rings, __ATOMIC_RELAXED);
+		do {
+			ring->next = head;
+		} while (!__atomic_compare_exchange_n(&rings, &head, ring, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	ring->lost = 0;
+	ring->depth = 0;
+	ring->flushing = false;
+	ring->tid = sys_thread_selfid();
+
+	set_binary_ring(ring);
+	return ring;
+};
+
+XTRACE_INLINE
+struct ring* current_ring(void) {
+	struct ring* ring = get_binary_ring();
+
+	if (ring == NULL) {
+		ring = ring_acquire();
+	}
+
+	if (ring == RING_IGNORED || ring->flushing) {
+		return NULL;
+	}
+
+	return ring;
+};
+
+static void write_all(const void* buffer, size_t size) {
+	const char* ptr = (const char*)buffer;
+
+	while (size > 0) {
+		long written = __write_for_xtrace(output_fd, ptr, size);
+		if (written <= 0) {
+			// nothing sensible we can do about it; the rest of this chunk is lost
+			return;
+		}
+		ptr += written;
+		size -= written;
+	}
+};
+
+static void ring_drain(struct ring* ring) {
+	// read the state before the head; if the thread is dead, the head we see is final
+	uint32_t state = __atomic_load_n(&ring->state, __ATOMIC_ACQUIRE);
+	uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	uint64_t tail = ring->tail;
+
+	while (tail != head) {
+		size_t index = tail & (RING_EVENTS - 1);
+		size_t count = head - tail;
+
+		if (count > RING_EVENTS - index) {
+			count = RING_EVENTS - index;
+		}
+
+		write_all(&ring->events[index], count * sizeof(struct xtrace_binary_event));
+		tail += count;
+	}
+
+	__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+	if (state == ring_state_dead) {
+		__atomic_store_n(&ring->state, ring_state_free, __ATOMIC_RELEASE);
+	}
+};
+
+static void flush_all(void) {
+	struct xtrace_binary_event clock = {0};
+
+	xtrace_lock_lock(&flush_lock);
+
+	clock.timestamp = xtrace_read_timestamp();
+	clock.tid = 0;
+	clock.type = xtrace_binary_event_clock;
+	clock.payload[0] = mach_absolute_time();
+	write_all(&clock, sizeof(clock));
+
+	for (struct ring* ring = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); ring != NULL; ring = ring->next) {
+		ring_drain(ring);
+	}
+
+	xtrace_lock_unlock(&flush_lock);
+};
+
+// flushes from a traced thread (e.g. right before it exits)
+static void flush_all_from(struct ring* ring) {
+	ring->flushing = true;
+	flush_all();
+	ring->flushing = false;
+};
+
+static void wake_writer(void) {
+	__atomic_store_n(&writer_wakeup, 1, __ATOMIC_RELEASE);
+	__linux_futex_reterr((int*)&writer_wakeup, FUTEX_WAKE, 1, NULL, 0, 0);
+};
+
+static void ring_record(struct ring* ring, uint16_t type, uint16_t nr, const uint64_t* payload, int payload_cnt) {
+	uint64_t head = ring->head;
+	uint64_t used = head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+	if (used >= RING_WAKE_THRESHOLD) {
+		if (!writer_running) {
+			// e.g. in a forked child; there's nobody else to do it
+			flush_all_from(ring);
+			used = head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+		} else if (used == RING_WAKE_THRESHOLD) {
+			wake_writer();
+		}
+	}
+
+	if (used + (ring->lost ? 2 : 1) > RING_EVENTS) {
+		++ring->lost;
+		return;
+	}
+
+	uint64_t timestamp = xtrace_read_timestamp();
+	struct xtrace_binary_event* event;
+
+	if (ring->lost) {
+		event = &ring->events[head++ & (RING_EVENTS - 1)];
+		event->timestamp = timestamp;
+		event->tid = ring->tid;
+		event->type = xtrace_binary_event_lost;
+		event->nr = 0;
+		event->payload[0] = ring->lost;
+		for (int i = 1; i < XTRACE_BINARY_PAYLOAD_COUNT; i++)
+			event->payload[i] = 0;
+		ring->lost = 0;
+	}
+
+	event = &ring->events[head++ & (RING_EVENTS - 1)];
+	event->timestamp = timestamp;
+	event->tid = ring->tid;
+	event->type = type;
+	event->nr = nr;
+	for (int i = 0; i < XTRACE_BINARY_PAYLOAD_COUNT; i++)
+		event->payload[i] = (i < payload_cnt) ? payload[i] : 0;
+
+	__atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+};
+
+static void record_entry(struct ring* ring, uint16_t type, int nr, void* args[]) {
+	uint64_t payload[XTRACE_BINARY_PAYLOAD_COUNT];
+
+	for (int i = 0; i < XTRACE_BINARY_PAYLOAD_COUNT; i++)
+		payload[i] = (uintptr_t)args[i];
+
+	if (ring->depth < NESTING_MAX) {
+		ring->nrs[ring->depth] = nr;
+		ring->rcv_msg[ring->depth] = NULL;
+		ring->request_port[ring->depth] = MACH_PORT_NULL;
+	}
+	++ring->depth;
+
+	ring_record(ring, type, nr, payload, XTRACE_BINARY_PAYLOAD_COUNT);
+};
+
+// returns the call number of the call that just returned
+static int record_exit(struct ring* ring, uint16_t type, uintptr_t retval) {
+	int nr = NR_UNKNOWN;
+	uint64_t payload = retval;
+
+	if (ring->depth > 0) {
+		--ring->depth;
+		if (ring->depth < NESTING_MAX)
+			nr = ring->nrs[ring->depth];
+	}
+
+	ring_record(ring, type, nr, &payload, 1);
+	return nr;
+};
+
+static void record_mach_msg(struct ring* ring, uint16_t type, const mach_msg_header_t* message, mach_port_name_t request_port) {
+	uint64_t payload[XTRACE_BINARY_PAYLOAD_COUNT] = {
+		message->msgh_bits,
+		message->msgh_remote_port,
+		message->msgh_local_port,
+		(uint64_t)(uint32_t)message->msgh_id,
+		message->msgh_size,
+		(uint64_t)xtrace_mig_port_kind(request_port),
+	};
+
+	ring_record(ring, type, 0, payload, XTRACE_BINARY_PAYLOAD_COUNT);
+};
+
+extern "C"
+void xtrace_binary_mach_entry(int nr, void* args[]) {
+	struct ring* ring = current_ring();
+	if (ring == NULL)
+		return;
+
+	record_entry(ring, xtrace_binary_event_mach_entry, nr, args);
+
+	if ((nr == 31 || nr == 32) && ring->depth <= NESTING_MAX) {
+		// mach_msg_trap or mach_msg_overwrite_trap
+		const mach_msg_header_t* message = (const mach_msg_header_t*)args[0];
+		mach_msg_option_t options = (mach_msg_option_t)(long)args[1];
+		int level = ring->depth - 1;
+
+		if ((options & MACH_SEND_MSG) && message != NULL) {
+			ring->request_port[level] = message->msgh_remote_port;
+			record_mach_msg(ring, xtrace_binary_event_mach_msg_send, message, message->msgh_remote_port);
+		}
+
+		if (options & MACH_RCV_MSG) {
+			ring->rcv_msg[level] = message;
+			if (nr == 32 && args[7] != NULL)
+				ring->rcv_msg[level] = (const mach_msg_header_t*)args[7];
+		}
+	}
+};
+
+extern "C"
+void xtrace_binary_mach_exit(uintptr_t retval) {
+	struct ring* ring = current_ring();
+	if (ring == NULL)
+		return;
+
+	int nr = record_exit(ring, xtrace_binary_event_mach_exit, retval);
+
+	if ((nr == 31 || nr == 32) && retval == KERN_SUCCESS && ring->depth < NESTING_MAX && ring->rcv_msg[ring->depth] != NULL) {
+		record_mach_msg(ring, xtrace_binary_event_mach_msg_receive, ring->rcv_msg[ring->depth], ring->request_port[ring->depth]);
+	}
+};
+
+extern "C"
+void xtrace_binary_bsd_entry(int nr, void* args[]) {
+	struct ring* ring = current_ring();
+	if (ring == NULL)
+		return;
+
+	record_entry(ring, xtrace_binary_event_bsd_entry, nr, args);
+
+	// for exit(), execve(), terminate_with_payload() and abort_with_payload(),
+	// write out everything now, as we're likely not going to see the return
+	if (nr == 1 || nr == 59 || nr == 520 || nr == 521) {
+		flush_all_from(ring);
+	}
+};
+
+extern "C"
+void xtrace_binary_bsd_exit(uintptr_t retval) {
+	struct ring* ring = current_ring();
+	if (ring == NULL)
+		return;
+
+	record_exit(ring, xtrace_binary_event_bsd_exit, retval);
+};
+
+static bool open_output(int pid) {
+	char path[PATH_MAX];
+	char append[32];
+	struct xtrace_binary_header header;
+
+	strlcpy(path, output_base, sizeof(path));
+	__simple_snprintf(append, sizeof(append), ".%d.bin", pid);
+	strlcat(path, append, sizeof(path));
+
+	// exec() keeps the PID, so the new image appends its own header and events to the same file
+	output_fd = _open_for_xtrace(path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+	if (output_fd < 0) {
+		return false;
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, XTRACE_BINARY_MAGIC, sizeof(header.magic));
+	header.version = XTRACE_BINARY_VERSION;
+	header.event_size = sizeof(struct xtrace_binary_event);
+	header.pid = pid;
+	write_all(&header, sizeof(header));
+
+	return true;
+};
+
+static void* writer_main(void* unused) {
+	// anything pthread did on this thread before we got here isn't interesting
+	binary_ring_destroy(get_ptr_binary_ring());
+	set_binary_ring(RING_IGNORED);
+
+	while (true) {
+		struct timespec timeout = {
+			.tv_sec = 0,
+			.tv_nsec = WRITER_INTERVAL_NS,
+		};
+
+		__linux_futex_reterr((int*)&writer_wakeup, FUTEX_WAIT, 0, &timeout, 0, 0);
+		__atomic_store_n(&writer_wakeup, 0, __ATOMIC_RELAXED);
+
+		flush_all();
+	}
+
+	return NULL;
+};
+
+extern "C"
+void xtrace_setup_binary_tracing(const char* path_base) {
+	pthread_t writer;
+
+	// this runs before the syscall tracing is enabled, so we can freely use libSystem and make syscalls
+
+	strlcpy(output_base, (path_base != NULL && path_base[0] != '\0') ? path_base : "xtrace", sizeof(output_base));
+
+	if (!open_output(getpid())) {
+		xtrace_error("xtrace: failed to open binary trace output; falling back to normal tracing\n");
+		return;
+	}
+
+	// write a clock event right away, so that the decoder has one from the very start
+	flush_all();
+
+	if (pthread_create(&writer, NULL, writer_main, NULL) != 0) {
+		xtrace_abort("xtrace: failed to start binary trace writer thread");
+	}
+	pthread_detach(writer);
+	writer_running = true;
+
+	xtrace_binary = 1;
+};
+
+extern "C"
+void xtrace_binary_postfork_child(void) {
+	if (!xtrace_binary) {
+		return;
+	}
+
+	struct ring* self = get_binary_ring();
+
+	// the writer thread does not exist in the child (and may have been holding the lock when we forked).
+	// the parent still writes out everything that was recorded before the fork, so just forget about it.
+	writer_running = false;
+	xtrace_lock_init(&flush_lock);
+
+	for (struct ring* ring = rings; ring != NULL; ring = ring->next) {
+		ring->tail = ring->head;
+		if (ring != self) {
+			ring->state = ring_state_free;
+		}
+	}
+
+	if (self != NULL && self != RING_IGNORED) {
+		self->lost = 0;
+		self->tid = sys_thread_selfid();
+	}
+
+	_close_for_xtrace(output_fd);
+
+	// after a fork, the calling thread is the main thread of the child, so its thread ID is also the new PID
+	if (!open_output(sys_thread_selfid())) {
+		xtrace_abort("xtrace: failed to open binary trace output in child");
+	}
+};
+
+//
+// decoder
+//
+
+struct decode_thread {
+	uint32_t tid;
+	int depth;
+	// the entry of the current call, waiting for its exit to be printed on the same line
+	xtrace::String* pending;
+};
+
+struct decode_state {
+	struct decode_thread* threads;
+	size_t threads_cnt;
+
+	// used to convert timestamps to mach_absolute_time
+	uint64_t first_timestamp;
+	uint64_t first_clock;
+	double clock_per_tick;
+};
+
+static struct decode_thread* decode_thread_for(struct decode_state* state, uint32_t tid) {
+	for (size_t i = 0; i < state->threads_cnt; i++) {
+		if (state->threads[i].tid == tid) {
+			return &state->threads[i];
+		}
+	}
+
+	state->threads = (struct decode_thread*)xtrace_realloc(state->threads, (state->threads_cnt + 1) * sizeof(struct decode_thread));
+	if (state->threads == NULL) {
+		xtrace_abort("xtrace: failed to allocate decoder state");
+	}
+
+	struct decode_thread* thread = &state->threads[state->threads_cnt++];
+	thread->tid = tid;
+	thread->depth = 0;
+	thread->pending = NULL;
+	return thread;
+};
+
+static void decode_flush_pending(struct decode_thread* thread) {
+	if (thread->pending == NULL) {
+		return;
+	}
+
+	xtrace_log("%s\n", thread->pending->c_str());
+	xtrace::String::free_ptr(thread->pending);
+	thread->pending = NULL;
+};
+
+static void decode_start_line(struct decode_state* state, xtrace::String* log, const struct xtrace_binary_event* event, int indent) {
+	xtrace_set_gray_color(log);
+
+	if (state->clock_per_tick > 0) {
+		uint64_t clock = state->first_clock + (uint64_t)((double)(event->timestamp - state->first_timestamp) * state->clock_per_tick);
+		log->append_format("[%u +%lluus]", event->tid, (unsigned long long)((clock - state->first_clock) / 1000));
+	} else {
+		log->append_format("[%u]", event->tid);
+	}
+
+	for (int i = 0; i < indent + 1; i++)
+		log->append(" ");
+
+	xtrace_reset_color(log);
+};
+
+static void decode_call(struct decode_state* state, xtrace::String* log, const struct xtrace_binary_event* event, const uint64_t* args) {
+	bool is_mach = event->type == xtrace_binary_event_mach_entry || event->type == xtrace_binary_event_mach_exit;
+
+	if (is_mach)
+		xtrace_print_mach_call_raw(log, event->nr, args, XTRACE_BINARY_PAYLOAD_COUNT);
+	else
+		xtrace_print_bsd_call_raw(log, event->nr, args, XTRACE_BINARY_PAYLOAD_COUNT);
+};
+
+static void decode_mach_msg(struct decode_state* state, const struct xtrace_binary_event* event, int indent) {
+	xtrace::String log;
+	mach_msg_bits_t bits = (mach_msg_bits_t)event->payload[0];
+
+	decode_start_line(state, &log, event, indent);
+
+	log.append("{");
+	if (MACH_MSGH_BITS_HAS_REMOTE(bits))
+		log.append_format("remote = %s %u, ", xtrace_msg_type_to_str(MACH_MSGH_BITS_REMOTE(bits), 0), (unsigned int)event->payload[1]);
+	if (MACH_MSGH_BITS_HAS_LOCAL(bits))
+		log.append_format("local = %s %u, ", xtrace_msg_type_to_str(MACH_MSGH_BITS_LOCAL(bits), 0), (unsigned int)event->payload[2]);
+	if (MACH_MSGH_BITS_IS_COMPLEX(bits))
+		log.append("complex, ");
+	log.append_format("id = %d}, %u bytes", (int)(uint32_t)event->payload[3], (unsigned int)event->payload[4]);
+	xtrace_log("%s\n", log.c_str());
+	log.clear();
+
+	decode_start_line(state, &log, event, indent);
+	xtrace_print_mig_routine_name(&log, (mach_msg_id_t)(uint32_t)event->payload[3], (int)event->payload[5]);
+	xtrace_log("%s\n", log.c_str());
+};
+
+static void decode_event(struct decode_state* state, const struct xtrace_binary_event* event) {
+	struct decode_thread* thread;
+
+	if (memcmp(event, XTRACE_BINARY_MAGIC, sizeof(((struct xtrace_binary_header*)NULL)->magic)) == 0) {
+		// the header of the next image after an exec(); nothing that was in progress is ever going to return
+		for (size_t i = 0; i < state->threads_cnt; i++) {
+			decode_flush_pending(&state->threads[i]);
+			state->threads[i].depth = 0;
+		}
+		return;
+	}
+
+	if (event->type == xtrace_binary_event_clock) {
+		return;
+	}
+
+	thread = decode_thread_for(state, event->tid);
+
+	switch (event->type) {
+		case xtrace_binary_event_mach_entry:
+		case xtrace_binary_event_bsd_entry: {
+			decode_flush_pending(thread);
+
+			thread->pending = xtrace::String::new_ptr();
+			decode_start_line(state, thread->pending, event, 4 * thread->depth);
+			decode_call(state, thread->pending, event, event->payload);
+
+			++thread->depth;
+		} break;
+
+		case xtrace_binary_event_mach_exit:
+		case xtrace_binary_event_bsd_exit: {
+			xtrace::String* log = thread->pending;
+
+			if (thread->depth > 0)
+				--thread->depth;
+
+			if (log == NULL) {
+				// the entry was split off by something else; print the call again like XTRACE_SPLIT_ENTRY_AND_EXIT would
+				log = xtrace::String::new_ptr();
+				decode_start_line(state, log, event, 4 * thread->depth);
+				xtrace_set_gray_color(log);
+				decode_call(state, log, event, NULL);
+			}
+			thread->pending = NULL;
+
+			xtrace_set_gray_color(log);
+			log->append(" -> ");
+			xtrace_reset_color(log);
+
+			if (event->type == xtrace_binary_event_mach_exit)
+				xtrace_print_mach_retval_raw(log, event->nr, event->payload[0]);
+			else
+				xtrace_print_bsd_retval_raw(log, event->nr, event->payload[0]);
+
+			xtrace_log("%s\n", log->c_str());
+			xtrace::String::free_ptr(log);
+		} break;
+
+		case xtrace_binary_event_mach_msg_send:
+		case xtrace_binary_event_mach_msg_receive: {
+			decode_flush_pending(thread);
+			decode_mach_msg(state, event, 4 * thread->depth + 4);
+		} break;
+
+		case xtrace_binary_event_lost: {
+			xtrace::String log;
+
+			decode_flush_pending(thread);
+			decode_start_line(state, &log, event, 4 * thread->depth);
+			log.append_format("<%llu events lost>", (unsigned long long)event->payload[0]);
+			xtrace_log("%s\n", log.c_str());
+		} break;
+
+		default: {
+			xtrace_error("xtrace: unknown binary trace event type %u\n", event->type);
+		} break;
+	}
+};
+
+// calls `callback` for every event in the file; returns false on a read error
+static bool decode_read_events(int fd, struct decode_state* state, void (*callback)(struct decode_state* state, const struct xtrace_binary_event* event)) {
+	struct xtrace_binary_event events[256];
+	size_t buffered = 0;
+
+	if (lseek(fd, sizeof(struct xtrace_binary_header), SEEK_SET) < 0) {
+		return false;
+	}
+
+	while (true) {
+		ssize_t count = read(fd, (char*)events + buffered, sizeof(events) - buffered);
+
+		if (count < 0) {
+			return false;
+		}
+		if (count == 0) {
+			// a trailing partial event means the process died in the middle of a write; just ignore it
+			return true;
+		}
+
+		buffered += count;
+
+		size_t complete = buffered / sizeof(struct xtrace_binary_event);
+		for (size_t i = 0; i < complete; i++) {
+			callback(state, &events[i]);
+		}
+
+		buffered -= complete * sizeof(struct xtrace_binary_event);
+		memmove(events, &events[complete], buffered);
+	}
+};
+
+static void decode_calibrate(struct decode_state* state, const struct xtrace_binary_event* event) {
+	if (event->type != xtrace_binary_event_clock) {
+		return;
+	}
+
+	if (state->first_timestamp == 0) {
+		state->first_timestamp = event->timestamp;
+		state->first_clock = event->payload[0];
+		return;
+	}
+
+	// the longer the interval, the better the estimate, so the last clock event wins
+	if (event->timestamp > state->first_timestamp && event->payload[0] > state->first_clock) {
+		state->clock_per_tick = (double)(event->payload[0] - state->first_clock) / (double)(event->timestamp - state->first_timestamp);
+	}
+};
+
+extern "C"
+bool xtrace_binary_decode(const char* path) {
+	struct xtrace_binary_header header;
+	struct decode_state state;
+	bool ok = false;
+
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		xtrace_error("xtrace: failed to open %s\n", path);
+		return false;
+	}
+
+	if (read(fd, &header, sizeof(header)) != sizeof(header)
+		|| memcmp(header.magic, XTRACE_BINARY_MAGIC, sizeof(header.magic)) != 0
+		|| header.version != XTRACE_BINARY_VERSION
+		|| header.event_size != sizeof(struct xtrace_binary_event))
+	{
+		xtrace_error("xtrace: %s is not a binary trace this version of xtrace understands\n", path);
+		close(fd);
+		return false;
+	}
+
+	memset(&state, 0, sizeof(state));
+
+	// first pass: find the relation between timestamps and real time; second pass: print everything
+	if (decode_read_events(fd, &state, decode_calibrate) && decode_read_events(fd, &state, decode_event)) {
+		ok = true;
+	} else {
+		xtrace_error("xtrace: failed to read %s\n", path);
+	}
+
+	for (size_t i = 0; i < state.threads_cnt; i++) {
+		decode_flush_pending(&state.threads[i]);
+	}
+
+	xtrace_free(state.threads);
+	close(fd);
+	return ok;
+};
@@ -0,0 +1,74 @@
+#ifndef XTRACE_BINARY_TRACE
+#define XTRACE_BINARY_TRACE
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "base.h"
+
+// binary trace files start with this header, followed by a stream of `struct xtrace_binary_event`s
+// (all fields are in the byte order of the traced process). the header is the same size as an event;
+// when a process calls exec(), the new image appends another header to the same file.
+
+#define XTRACE_BINARY_MAGIC "XTRCBIN1"
+#define XTRACE_BINARY_VERSION 1
+
+struct xtrace_binary_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t event_size;
+	uint32_t pid;
+	uint8_t reserved[44];
+};
+
+enum xtrace_binary_event_type {
+	xtrace_binary_event_mach_entry = 1,
+	xtrace_binary_event_mach_exit,
+	xtrace_binary_event_bsd_entry,
+	xtrace_binary_event_bsd_exit,
+
+	// a summary of a Mach message header that was sent or received
+	// payload: bits, remote port, local port, msgh_id, size, xtrace_mig_port_kind
+	xtrace_binary_event_mach_msg_send,
+	xtrace_binary_event_mach_msg_receive,
+
+	// written by the writer thread to relate timestamps to mach_absolute_time
+	// payload: mach_absolute_time
+	xtrace_binary_event_clock,
+
+	// the ring buffer of the thread was full and this many events were dropped
+	// payload: count
+	xtrace_binary_event_lost,
+};
+
+#define XTRACE_BINARY_PAYLOAD_COUNT 6
+
+struct xtrace_binary_event {
+	// TSC value at the time of the event
+	uint64_t timestamp;
+	uint32_t tid;
+	uint16_t type;
+	uint16_t nr;
+	// raw arguments for entries, the return value for exits
+	uint64_t payload[XTRACE_BINARY_PAYLOAD_COUNT];
+};
+
+XTRACE_DECLARATIONS_C_BEGIN
+
+extern int xtrace_binary;
+
+// `path_base` is XTRACE_LOG_FILE; the trace goes to `${path_base}.${PID}.bin`
+void xtrace_setup_binary_tracing(const char* path_base);
+void xtrace_binary_postfork_child(void);
+
+void xtrace_binary_mach_entry(int nr, void* args[]);
+void xtrace_binary_mach_exit(uintptr_t retval);
+void xtrace_binary_bsd_entry(int nr, void* args[]);
+void xtrace_binary_bsd_exit(uintptr_t retval);
+
+// decodes the binary trace at `path` into the normal xtrace output format;
+// returns false if the file could not be read
+bool xtrace_binary_decode(const char* path);
+
+XTRACE_DECLARATIONS_C_END
+
+#endif // XTRACE_BINARY_TRACE
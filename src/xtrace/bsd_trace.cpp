@@ -11,6 +11,10 @@
 
 #include "xtracelib.h"
 #include "bsd_trace.h"
+#include "mig_trace.h"
+#include "binary_trace.h"
+#include "summary.h"
+#include "filter.h"
 #include "tls.h"
 
 static void print_errno(xtrace::String* log, int nr, uintptr_t rv);
@@ -1052,9 +1056,84 @@ static void print_args(xtrace::String* log, int nr, void* args[])
 }
 
 
+extern "C"
+const char* xtrace_bsd_call_name(int nr)
+{
+	if (nr < 0 || nr >= sizeof(bsd_defs) / sizeof(bsd_defs[0]))
+		return NULL;
+	return bsd_defs[nr].name;
+}
+
+void xtrace_print_bsd_call_raw(xtrace::String* log, int nr, const uint64_t args[], int args_cnt)
+{
+	if (nr < 0 || nr >= sizeof(bsd_defs) / sizeof(bsd_defs[0]) || bsd_defs[nr].name == NULL)
+	{
+		log->append_format("bsd %d(...)", nr);
+		return;
+	}
+
+	log->append_format("%s(", bsd_defs[nr].name);
+
+	if (args != NULL && nr < sizeof(args_info) / sizeof(args_info[0]))
+	{
+		for (int i = 0; i < args_info[nr].args_cnt; i++)
+		{
+			void (*print_arg)(xtrace::String* log, void* arg) = args_info[nr].print_arg[i];
+
+			if (i > 0)
+				log->append(", ");
+
+			if (i >= args_cnt)
+				log->append("?");
+			else if (print_arg == print_arg_int || print_arg == print_arg_prot || print_arg == print_mmap_flags || print_arg == print_open_flags)
+				(*print_arg)(log, (void*) (uintptr_t) args[i]);
+			else
+				// the memory it points to is long gone
+				print_arg_ptr(log, (void*) (uintptr_t) args[i]);
+		}
+	}
+
+	log->append(")");
+}
+
+void xtrace_print_bsd_retval_raw(xtrace::String* log, int nr, uintptr_t rv)
+{
+	if (nr < 0 || nr >= sizeof(bsd_defs) / sizeof(bsd_defs[0]) || bsd_defs[nr].name == NULL)
+		log->append_format("0x%lx", rv);
+	else if (bsd_defs[nr].print_retval == print_errno_ptr || bsd_defs[nr].print_retval == print_errno)
+		bsd_defs[nr].print_retval(log, nr, rv);
+	else
+		print_errno_num(log, nr, rv);
+}
+
 extern "C"
 void darling_bsd_syscall_entry_print(int nr, void* args[])
 {
+	if (xtrace_mig_loading())
+		return;
+
+	if (xtrace_filter && !xtrace_filter_bsd_entry(nr, args))
+		return;
+
+	if (xtrace_binary)
+	{
+		xtrace_binary_bsd_entry(nr, args);
+		return;
+	}
+
+	if (xtrace_summary)
+	{
+		xtrace_summary_bsd_entry(nr, args);
+		return;
+	}
+
+	if (xtrace_filter_failed_only)
+	{
+		// we don't know yet whether this is worth printing
+		xtrace_filter_save_entry(nr, args);
+		return;
+	}
+
 	xtrace::String log;
 #if __i386__
 	// get rid of some info in the upper bytes that we don't need
@@ -1077,8 +1156,42 @@ void darling_bsd_syscall_entry_print(int nr, void* args[])
 }
 
 extern "C"
-void darling_bsd_syscall_exit_print(uintptr_t retval)
+void darling_bsd_syscall_exit_print(uintptr_t retval, void* frame[])
 {
+	if (xtrace_mig_loading())
+		return;
+
+	if (xtrace_filter && !xtrace_filter_exit(xtrace_filter_token(frame)))
+		return;
+
+	if (xtrace_binary)
+	{
+		xtrace_binary_bsd_exit(retval);
+		return;
+	}
+
+	if (xtrace_summary)
+	{
+		xtrace_summary_bsd_exit(retval);
+		return;
+	}
+
+	if (xtrace_filter_failed_only)
+	{
+		void* args[8];
+		int nr = xtrace_filter_restore_entry(args);
+		intptr_t v = (intptr_t) retval;
+
+		// print the entry and the exit as one line
+		if (nr >= 0 && v < 0 && v >= -4095)
+		{
+			xtrace::String log;
+			handle_generic_entry(&log, bsd_defs, "bsd", nr, args);
+			handle_generic_exit(&log, bsd_defs, "bsd", retval, 0);
+		}
+		return;
+	}
+
 	xtrace::String log;
 	handle_generic_exit(&log, bsd_defs, "bsd", retval, 0);
 
@@ -1,12 +1,23 @@
 #ifndef XTRACE_BSD_TRACE
 #define XTRACE_BSD_TRACE
 
+#include <stdint.h>
 #include "base.h"
 #include "string.h"
 
 #ifdef XTRACE_CPP
 extern void print_open_flags(xtrace::String* log, void* arg);
 extern void xtrace_print_string_literal(xtrace::String* log, const char* str);
+
+// for decoding binary traces: only the raw argument values are available, so
+// anything that would have to be dereferenced is printed as a plain pointer
+extern void xtrace_print_bsd_call_raw(xtrace::String* log, int nr, const uint64_t args[], int args_cnt);
+extern void xtrace_print_bsd_retval_raw(xtrace::String* log, int nr, uintptr_t rv);
 #endif
 
+XTRACE_DECLARATIONS_C_BEGIN
+// NULL for calls xtrace doesn't know about
+const char* xtrace_bsd_call_name(int nr);
+XTRACE_DECLARATIONS_C_END
+
 #endif // XTRACE_BSD_TRACE
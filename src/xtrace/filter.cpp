@@ -0,0 +1,459 @@
+#include <stdlib.h>
+#include <string.h>
+#include <mach/mach.h>
+
+#include <darling/emulation/simple.h>
+
+#include "xtracelib.h"
+#include "filter.h"
+#include "mach_trace.h"
+#include "bsd_trace.h"
+#include "mig_trace.h"
+#include "tls.h"
+#include "memory.h"
+
+//
+// XTRACE_FILTER
+//
+// the expression is a comma-separated list of terms, applied from left to right:
+//
+//   <name>                     a BSD syscall or Mach trap by name (e.g. `open`, `mach_msg_trap`)
+//   bsd:<nr>, mach:<nr>        a BSD syscall or Mach trap by number
+//   bsd, mach, all             every BSD syscall, every Mach trap, everything
+//   mig:<subsystem>            mach_msg calls sending a message of this MIG subsystem
+//   mig:<subsystem>::<routine> mach_msg calls sending this MIG routine's request (or reply)
+//   tid:<tid>                  only calls made by this thread (may be given multiple times)
+//   failed                     only calls that return an error
+//
+// any term except `failed` can be prefixed with `!` to exclude instead of include. if the first term
+// that selects calls is an include, we start out with nothing selected; otherwise, with everything.
+// MIG terms are tracked separately from the traps: sending mach_msg calls are only narrowed down by
+// message ID once a `mig:` term is given, and then start out with nothing selected if that term
+// (or `mach`/`all` before it) is an include.
+//
+// all of this is compiled into bitmaps indexed by call number (plus a sorted table of MIG message IDs),
+// so a call that is filtered out only costs a bit test and never gets anywhere near xtrace::String.
+//
+
+extern "C" int sys_thread_selfid(void);
+
+#define BSD_CALLS_MAX 1024
+#define MACH_CALLS_MAX 256
+#define TIDS_MAX 16
+#define NESTING_MAX 64
+
+#define MACH_MSG_TRAP 31
+#define MACH_MSG_OVERWRITE_TRAP 32
+
+struct mig_decision {
+	mach_msg_id_t id;
+	bool selected;
+};
+
+int xtrace_filter = 0;
+int xtrace_filter_failed_only = 0;
+
+static uint64_t bsd_bits[BSD_CALLS_MAX / 64];
+static uint64_t mach_bits[MACH_CALLS_MAX / 64];
+
+// set once a `mig:` term is given; until then, mach_msg only depends on the trap bits
+static bool mig_filter = false;
+// set once a term has decided what to do with messages without an entry in `mig_decisions`
+static bool mig_default_set = false;
+// messages without an entry in `mig_decisions` use this
+static bool mig_default = true;
+static struct mig_decision* mig_decisions = NULL;
+static size_t mig_decisions_cnt = 0;
+static size_t mig_decisions_capacity = 0;
+
+static int tids_included[TIDS_MAX];
+static size_t tids_included_cnt = 0;
+static int tids_excluded[TIDS_MAX];
+static size_t tids_excluded_cnt = 0;
+
+XTRACE_INLINE
+bool bit_test(const uint64_t* bits, int nr) {
+	return (bits[nr / 64] >> (nr % 64)) & 1;
+};
+
+XTRACE_INLINE
+void bit_assign(uint64_t* bits, int nr, bool value) {
+	if (value)
+		bits[nr / 64] |= 1ULL << (nr % 64);
+	else
+		bits[nr / 64] &= ~(1ULL << (nr % 64));
+};
+
+//
+// compilation
+//
+
+static void select_all_bsd(bool selected) {
+	memset(bsd_bits, selected ? 0xff : 0, sizeof(bsd_bits));
+};
+
+static void select_all_mig(bool selected) {
+	mig_default = selected;
+	mig_default_set = true;
+	for (size_t i = 0; i < mig_decisions_cnt; i++)
+		mig_decisions[i].selected = selected;
+};
+
+// only the traps; `mach` and `all` also select (or deselect) all MIG messages
+static void select_all_mach(bool selected) {
+	memset(mach_bits, selected ? 0xff : 0, sizeof(mach_bits));
+};
+
+static void mig_decide(mach_msg_id_t id, void* context) {
+	bool selected = *(bool*)context;
+
+	for (size_t i = 0; i < mig_decisions_cnt; i++) {
+		if (mig_decisions[i].id == id) {
+			mig_decisions[i].selected = selected;
+			return;
+		}
+	}
+
+	if (mig_decisions_cnt == mig_decisions_capacity) {
+		mig_decisions_capacity = mig_decisions_capacity ? mig_decisions_capacity * 2 : 64;
+		mig_decisions = (struct mig_decision*)xtrace_realloc(mig_decisions, mig_decisions_capacity * sizeof(struct mig_decision));
+		if (mig_decisions == NULL) {
+			xtrace_abort("xtrace: failed to allocate filter");
+		}
+	}
+
+	mig_decisions[mig_decisions_cnt].id = id;
+	mig_decisions[mig_decisions_cnt].selected = selected;
+	++mig_decisions_cnt;
+};
+
+static int compare_mig_decisions(const void* a, const void* b) {
+	mach_msg_id_t id_a = ((const struct mig_decision*)a)->id;
+	mach_msg_id_t id_b = ((const struct mig_decision*)b)->id;
+	return (id_a < id_b) ? -1 : (id_a > id_b);
+};
+
+static bool parse_number(const char* string, int* out) {
+	char* end;
+	long value = strtol(string, &end, 0);
+
+	if (*string == '\0' || *end != '\0' || value < 0 || value > INT32_MAX) {
+		return false;
+	}
+
+	*out = (int)value;
+	return true;
+};
+
+static bool select_by_name(const char* name, bool selected) {
+	bool found = false;
+
+	for (int nr = 0; nr < BSD_CALLS_MAX; nr++) {
+		const char* call_name = xtrace_bsd_call_name(nr);
+		if (call_name != NULL && strcmp(call_name, name) == 0) {
+			bit_assign(bsd_bits, nr, selected);
+			found = true;
+		}
+	}
+
+	for (int nr = 0; nr < MACH_CALLS_MAX; nr++) {
+		const char* call_name = xtrace_mach_call_name(nr);
+		if (call_name != NULL && strcmp(call_name, name) == 0) {
+			bit_assign(mach_bits, nr, selected);
+			found = true;
+		}
+	}
+
+	return found;
+};
+
+// `term` has already been stripped of its `!`
+static bool apply_term(char* term, bool selected, bool* seen_call_term) {
+	int number;
+
+	if (strncmp(term, "tid:", 4) == 0) {
+		size_t* cnt = selected ? &tids_included_cnt : &tids_excluded_cnt;
+		int* tids = selected ? tids_included : tids_excluded;
+
+		if (!parse_number(term + 4, &number)) {
+			xtrace_error("xtrace: XTRACE_FILTER: invalid thread ID in \"%s\"\n", term);
+			return false;
+		}
+		if (*cnt == TIDS_MAX) {
+			xtrace_error("xtrace: XTRACE_FILTER: too many thread IDs\n");
+			return false;
+		}
+
+		tids[(*cnt)++] = number;
+		return true;
+	}
+
+	if (strcmp(term, "failed") == 0) {
+		if (!selected) {
+			xtrace_error("xtrace: XTRACE_FILTER: \"failed\" can't be negated\n");
+			return false;
+		}
+
+		xtrace_filter_failed_only = 1;
+		return true;
+	}
+
+	// everything else selects calls
+	if (!*seen_call_term) {
+		*seen_call_term = true;
+		if (selected) {
+			select_all_bsd(false);
+			select_all_mach(false);
+		}
+	}
+
+	if (strcmp(term, "all") == 0) {
+		select_all_bsd(selected);
+		select_all_mach(selected);
+		select_all_mig(selected);
+	} else if (strcmp(term, "bsd") == 0) {
+		select_all_bsd(selected);
+	} else if (strcmp(term, "mach") == 0) {
+		select_all_mach(selected);
+		select_all_mig(selected);
+	} else if (strncmp(term, "bsd:", 4) == 0) {
+		if (!parse_number(term + 4, &number) || number >= BSD_CALLS_MAX) {
+			xtrace_error("xtrace: XTRACE_FILTER: invalid syscall number in \"%s\"\n", term);
+			return false;
+		}
+		bit_assign(bsd_bits, number, selected);
+	} else if (strncmp(term, "mach:", 5) == 0) {
+		if (!parse_number(term + 5, &number) || number >= MACH_CALLS_MAX) {
+			xtrace_error("xtrace: XTRACE_FILTER: invalid trap number in \"%s\"\n", term);
+			return false;
+		}
+		bit_assign(mach_bits, number, selected);
+	} else if (strncmp(term, "mig:", 4) == 0) {
+		char* subsystem_name = term + 4;
+		char* routine_name = strstr(subsystem_name, "::");
+
+		if (routine_name != NULL) {
+			*routine_name = '\0';
+			routine_name += 2;
+		}
+
+		// `mig:foo` on its own means "only foo", but `mach,mig:foo` still means all of them
+		if (!mig_default_set)
+			select_all_mig(!selected);
+		mig_filter = true;
+
+		if (xtrace_mig_for_each_id(subsystem_name, routine_name, mig_decide, &selected) == 0) {
+			xtrace_error("xtrace: XTRACE_FILTER: unknown MIG subsystem or routine \"%s%s%s\"\n",
+				subsystem_name, routine_name ? "::" : "", routine_name ? routine_name : "");
+			return false;
+		}
+
+		// the messages have to go through mach_msg to be seen at all
+		if (selected) {
+			bit_assign(mach_bits, MACH_MSG_TRAP, true);
+			bit_assign(mach_bits, MACH_MSG_OVERWRITE_TRAP, true);
+		}
+	} else if (!select_by_name(term, selected)) {
+		xtrace_error("xtrace: XTRACE_FILTER: unknown call \"%s\"\n", term);
+		return false;
+	}
+
+	return true;
+};
+
+extern "C"
+bool xtrace_setup_filter(const char* expression) {
+	// this runs before the syscall tracing is enabled, so we can freely use libSystem
+
+	size_t length = strlen(expression);
+	char* copy = (char*)xtrace_malloc(length + 1);
+	bool seen_call_term = false;
+	bool ok = true;
+
+	memcpy(copy, expression, length + 1);
+
+	select_all_bsd(true);
+	select_all_mach(true);
+
+	for (char* state = copy; ok && state != NULL; ) {
+		char* term = strsep(&state, ",");
+		bool selected = true;
+
+		while (*term == ' ')
+			++term;
+		for (char* end = term + strlen(term); end > term && end[-1] == ' '; --end)
+			end[-1] = '\0';
+
+		if (*term == '\0')
+			continue;
+
+		if (*term == '!') {
+			selected = false;
+			++term;
+		}
+
+		ok = apply_term(term, selected, &seen_call_term);
+	}
+
+	xtrace_free(copy);
+
+	if (!ok) {
+		return false;
+	}
+
+	if (mig_decisions_cnt > 0)
+		qsort(mig_decisions, mig_decisions_cnt, sizeof(struct mig_decision), compare_mig_decisions);
+
+	xtrace_filter = 1;
+	return true;
+};
+
+//
+// evaluation
+//
+
+static bool mig_selected(mach_msg_id_t id) {
+	size_t low = 0;
+	size_t high = mig_decisions_cnt;
+
+	while (low < high) {
+		size_t middle = (low + high) / 2;
+
+		if (mig_decisions[middle].id == id)
+			return mig_decisions[middle].selected;
+
+		if (mig_decisions[middle].id < id)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return mig_default;
+};
+
+static bool tid_selected(void) {
+	int tid = sys_thread_selfid();
+
+	for (size_t i = 0; i < tids_excluded_cnt; i++) {
+		if (tids_excluded[i] == tid)
+			return false;
+	}
+
+	if (tids_included_cnt == 0)
+		return true;
+
+	for (size_t i = 0; i < tids_included_cnt; i++) {
+		if (tids_included[i] == tid)
+			return true;
+	}
+
+	return false;
+};
+
+// only traced calls are remembered, so calls that are filtered out never touch the TLS on entry
+XTRACE_INLINE
+xtrace_filter_token_t remember(void* args[]) {
+	xtrace_tls_fast_t* fast = xtrace_tls_fast();
+
+	if (fast->traced_depth == XTRACE_TLS_TRACED_CALLS_MAX) {
+		// the oldest calls are the likeliest to have been abandoned (e.g. by a signal handler that longjmp()ed out)
+		memmove(&fast->traced_calls[0], &fast->traced_calls[1], sizeof(fast->traced_calls) - sizeof(fast->traced_calls[0]));
+		--fast->traced_depth;
+	}
+
+	xtrace_filter_token_t token = xtrace_filter_token(args);
+	fast->traced_calls[fast->traced_depth++] = token;
+	return token;
+};
+
+extern "C"
+xtrace_filter_token_t xtrace_filter_mach_entry(int nr, void* args[]) {
+	bool traced = nr >= 0 && nr < MACH_CALLS_MAX && bit_test(mach_bits, nr);
+
+	if (traced && mig_filter && (nr == MACH_MSG_TRAP || nr == MACH_MSG_OVERWRITE_TRAP)) {
+		const mach_msg_header_t* message = (const mach_msg_header_t*)args[0];
+		mach_msg_option_t options = (mach_msg_option_t)(long)args[1];
+
+		// receive-only calls don't have a message yet, so they only depend on the trap itself
+		if ((options & MACH_SEND_MSG) && message != NULL)
+			traced = mig_selected(message->msgh_id);
+	}
+
+	if (traced && (tids_included_cnt > 0 || tids_excluded_cnt > 0))
+		traced = tid_selected();
+
+	if (!traced)
+		return 0;
+
+	return remember(args);
+};
+
+extern "C"
+xtrace_filter_token_t xtrace_filter_bsd_entry(int nr, void* args[]) {
+	bool traced = nr >= 0 && nr < BSD_CALLS_MAX && bit_test(bsd_bits, nr);
+
+	if (traced && (tids_included_cnt > 0 || tids_excluded_cnt > 0))
+		traced = tid_selected();
+
+	if (!traced)
+		return 0;
+
+	return remember(args);
+};
+
+extern "C"
+bool xtrace_filter_exit(xtrace_filter_token_t token) {
+	// a thread without traced calls in flight (or without a TLS table at all) only pays for reading its own TSD slot
+	xtrace_tls_fast_t* fast = xtrace_tls_fast_if_present();
+	if (fast == NULL || fast->traced_depth == 0)
+		return false;
+
+	// no ordering by address here: a call on the signal stack isn't above or below anything on the thread's stack
+	for (uint32_t i = fast->traced_depth; i > 0; --i) {
+		if (fast->traced_calls[i - 1] == token) {
+			// anything remembered after this call was nested inside it and never returned (e.g. a signal handler that longjmp()ed out)
+			fast->traced_depth = i - 1;
+			return true;
+		}
+	}
+
+	// a call that was filtered out
+	return false;
+};
+
+//
+// `failed`
+//
+
+struct saved_entries {
+	int depth;
+	struct {
+		int nr;
+		void* args[8];
+	} entries[NESTING_MAX];
+};
+
+DEFINE_XTRACE_TLS_VAR(struct saved_entries, saved_entries, (struct saved_entries) {0}, NULL);
+
+extern "C"
+void xtrace_filter_save_entry(int nr, void* args[]) {
+	struct saved_entries* saved = get_ptr_saved_entries();
+
+	if (saved->depth < NESTING_MAX) {
+		saved->entries[saved->depth].nr = nr;
+		memcpy(saved->entries[saved->depth].args, args, sizeof(saved->entries[0].args));
+	}
+	++saved->depth;
+};
+
+extern "C"
+int xtrace_filter_restore_entry(void* args[]) {
+	struct saved_entries* saved = get_ptr_saved_entries();
+
+	if (saved->depth == 0 || --saved->depth >= NESTING_MAX) {
+		return -1;
+	}
+
+	memcpy(args, saved->entries[saved->depth].args, sizeof(saved->entries[0].args));
+	return saved->entries[saved->depth].nr;
+};
@@ -0,0 +1,41 @@
+#ifndef XTRACE_FILTER
+#define XTRACE_FILTER
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "base.h"
+
+XTRACE_DECLARATIONS_C_BEGIN
+
+// nonzero once an XTRACE_FILTER expression has been compiled
+extern int xtrace_filter;
+// the expression contained `failed`: only print calls that return an error
+extern int xtrace_filter_failed_only;
+
+// returns false (after printing why) if the expression is invalid
+bool xtrace_setup_filter(const char* expression);
+
+// identifies a traced call from its entry to its exit; 0 for calls that are filtered out
+typedef uintptr_t xtrace_filter_token_t;
+
+// the token of the call a trampoline was entered for: the hook sites of a syscall stub are at the same stack depth,
+// so the entry and exit trampolines of a call lay out their argument areas at the same address
+XTRACE_INLINE
+xtrace_filter_token_t xtrace_filter_token(void* args[]) {
+	return (xtrace_filter_token_t)args;
+};
+
+// these decide whether the call is traced and return its token (0 if it isn't), which is remembered for the matching exit;
+// they must be called for every entry/exit while xtrace_filter is set
+xtrace_filter_token_t xtrace_filter_mach_entry(int nr, void* args[]);
+xtrace_filter_token_t xtrace_filter_bsd_entry(int nr, void* args[]);
+bool xtrace_filter_exit(xtrace_filter_token_t token);
+
+// with `failed`, entries are only saved and printed together with the exit if the call failed
+void xtrace_filter_save_entry(int nr, void* args[]);
+// returns the saved call number and copies the saved arguments into `args` (8 of them)
+int xtrace_filter_restore_entry(void* args[]);
+
+XTRACE_DECLARATIONS_C_END
+
+#endif // XTRACE_FILTER
@@ -11,6 +11,9 @@
 #include "xtracelib.h"
 #include "mach_trace.h"
 #include "mig_trace.h"
+#include "binary_trace.h"
+#include "summary.h"
+#include "filter.h"
 #include "tls.h"
 #include "string.h"
 
@@ -210,12 +213,38 @@ static const char* const bootstrap_errors[] = {
 extern "C"
 void darling_mach_syscall_entry_print(int nr, void* args[])
 {
-	xtrace::String log;
+	if (xtrace_mig_loading())
+		return;
+
 #if __i386__
 	// get rid of some info in the upper bytes that we don't need
 	nr = (int)((unsigned int)nr & 0xffff);
 #endif
 
+	if (xtrace_filter && !xtrace_filter_mach_entry(nr, args))
+		return;
+
+	if (xtrace_binary)
+	{
+		xtrace_binary_mach_entry(nr, args);
+		return;
+	}
+
+	if (xtrace_summary)
+	{
+		xtrace_summary_mach_entry(nr, args);
+		return;
+	}
+
+	if (xtrace_filter_failed_only)
+	{
+		// we don't know yet whether this is worth printing
+		xtrace_filter_save_entry(nr, args);
+		return;
+	}
+
+	xtrace::String log;
+
 	set_mach_call_nr(nr);
 	handle_generic_entry(&log, mach_defs, "mach", nr, args);
 	if (nr == 31 || nr == 32)
@@ -228,8 +257,41 @@ void darling_mach_syscall_entry_print(int nr, void* args[])
 }
 
 extern "C"
-void darling_mach_syscall_exit_print(uintptr_t retval)
+void darling_mach_syscall_exit_print(uintptr_t retval, void* frame[])
 {
+	if (xtrace_mig_loading())
+		return;
+
+	if (xtrace_filter && !xtrace_filter_exit(xtrace_filter_token(frame)))
+		return;
+
+	if (xtrace_binary)
+	{
+		xtrace_binary_mach_exit(retval);
+		return;
+	}
+
+	if (xtrace_summary)
+	{
+		xtrace_summary_mach_exit(retval);
+		return;
+	}
+
+	if (xtrace_filter_failed_only)
+	{
+		void* args[8];
+		int nr = xtrace_filter_restore_entry(args);
+
+		// print the entry and the exit as one line, but leave out the message contents
+		if (nr >= 0 && xtrace_mach_call_failed(nr, retval))
+		{
+			xtrace::String log;
+			handle_generic_entry(&log, mach_defs, "mach", nr, args);
+			handle_generic_exit(&log, mach_defs, "mach", retval, 0);
+		}
+		return;
+	}
+
 	xtrace::String log;
 	int nr = get_mach_call_nr();
 	int is_msg = nr == 31 || nr == 32;
@@ -260,6 +322,57 @@ void xtrace_print_kern_return(xtrace::String* log, kern_return_t kr)
 		log->append_format("(kern_return_t) %x", kr);
 }
 
+extern "C"
+const char* xtrace_mach_call_name(int nr)
+{
+	if (nr < 0 || nr >= sizeof(mach_defs) / sizeof(mach_defs[0]))
+		return NULL;
+	return mach_defs[nr].name;
+}
+
+extern "C"
+bool xtrace_mach_call_failed(int nr, uintptr_t rv)
+{
+	// the traps that return port names instead of a kern_return_t can't fail
+	if (nr >= 0 && nr < sizeof(mach_defs) / sizeof(mach_defs[0]) && mach_defs[nr].print_retval == print_port_return)
+		return false;
+	return (kern_return_t) rv != KERN_SUCCESS;
+}
+
+void xtrace_print_mach_call_raw(xtrace::String* log, int nr, const uint64_t args[], int args_cnt)
+{
+	if (nr < 0 || nr >= sizeof(mach_defs) / sizeof(mach_defs[0]) || mach_defs[nr].name == NULL)
+	{
+		log->append_format("mach %d(...)", nr);
+		return;
+	}
+
+	log->append_format("%s(", mach_defs[nr].name);
+
+	// print_mach_msg_args is the only one that doesn't look at memory (or TLS) behind the arguments
+	if (args != NULL && mach_defs[nr].print_args == print_mach_msg_args && args_cnt >= 7)
+	{
+		void* raw_args[7];
+		for (int i = 0; i < 7; i++)
+			raw_args[i] = (void*) (uintptr_t) args[i];
+		print_mach_msg_args(log, nr, raw_args);
+	}
+	else if (args != NULL && mach_defs[nr].print_args != print_empty)
+		log->append("...");
+
+	log->append(")");
+}
+
+void xtrace_print_mach_retval_raw(xtrace::String* log, int nr, uintptr_t rv)
+{
+	if (nr < 0 || nr >= sizeof(mach_defs) / sizeof(mach_defs[0]) || mach_defs[nr].name == NULL)
+		log->append_format("0x%lx", rv);
+	else if (mach_defs[nr].print_retval == print_port_return)
+		print_port_return(log, nr, rv);
+	else
+		xtrace_print_kern_return(log, (kern_return_t) rv);
+}
+
 static void print_kern_return(xtrace::String* log, int nr, uintptr_t rv)
 {
 	xtrace_print_kern_return(log, (kern_return_t) rv);
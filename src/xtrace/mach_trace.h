@@ -5,10 +5,17 @@
 
 #ifdef XTRACE_CPP
 void xtrace_print_kern_return(xtrace::String* log, kern_return_t kr);
+
+// for decoding binary traces (see xtrace_print_bsd_call_raw)
+void xtrace_print_mach_call_raw(xtrace::String* log, int nr, const uint64_t args[], int args_cnt);
+void xtrace_print_mach_retval_raw(xtrace::String* log, int nr, uintptr_t rv);
 #endif
 
 XTRACE_DECLARATIONS_C_BEGIN
 const char* xtrace_msg_type_to_str(mach_msg_type_name_t type_name, int full);
+// NULL for traps xtrace doesn't know about
+const char* xtrace_mach_call_name(int nr);
+bool xtrace_mach_call_failed(int nr, uintptr_t rv);
 XTRACE_DECLARATIONS_C_END
 
 #endif // XTRACE_MACH_TRACE
@@ -0,0 +1,415 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mig_index.h"
+
+// everything in here runs during setup, before the syscall tracing is enabled, so we can freely use libSystem.
+// it's also built into the host tool that generates the index, so stick to plain POSIX.
+
+// how many IDs share a bucket on average
+#define IDS_PER_BUCKET 4
+// give up on a slot table size after trying this many displacements for a bucket
+#define DISPLACEMENT_MAX (1U << 16)
+
+struct pending_candidate {
+	int32_t id;
+	struct xtrace_mig_index_candidate candidate;
+};
+
+struct string_table {
+	char* data;
+	size_t size;
+	size_t capacity;
+};
+
+static bool string_table_add(struct string_table* table, const char* string, uint32_t* offset) {
+	size_t length = strlen(string) + 1;
+
+	if (table->size + length > table->capacity) {
+		size_t capacity = table->capacity ? table->capacity * 2 : 4096;
+		while (capacity < table->size + length)
+			capacity *= 2;
+
+		char* data = (char*)realloc(table->data, capacity);
+		if (data == NULL)
+			return false;
+
+		table->data = data;
+		table->capacity = capacity;
+	}
+
+	memcpy(table->data + table->size, string, length);
+	*offset = (uint32_t)table->size;
+	table->size += length;
+	return true;
+};
+
+static int compare_pending_candidates(const void* a, const void* b) {
+	const struct pending_candidate* ca = (const struct pending_candidate*)a;
+	const struct pending_candidate* cb = (const struct pending_candidate*)b;
+
+	if (ca->id != cb->id)
+		return (ca->id < cb->id) ? -1 : 1;
+
+	// keep the subsystems in directory order, like a linear search would see them
+	return (ca->candidate.subsystem < cb->candidate.subsystem) ? -1 : (ca->candidate.subsystem > cb->candidate.subsystem);
+};
+
+struct bucket {
+	uint32_t index;
+	uint32_t key_cnt;
+	// index of the first key in the list of keys sorted by bucket
+	uint32_t first_key;
+};
+
+static int compare_buckets_by_size(const void* a, const void* b) {
+	const struct bucket* ba = (const struct bucket*)a;
+	const struct bucket* bb = (const struct bucket*)b;
+
+	// place the biggest buckets first, while there's still lots of room
+	if (ba->key_cnt != bb->key_cnt)
+		return (ba->key_cnt > bb->key_cnt) ? -1 : 1;
+	return (ba->index < bb->index) ? -1 : (ba->index > bb->index);
+};
+
+// fills in `displacements` and `slot_of_key` so that every key gets its own slot; returns false if it didn't work out
+static bool place_keys(const int32_t* keys, uint32_t key_cnt, uint32_t bucket_cnt, uint32_t slot_cnt, uint32_t* displacements, uint32_t* slot_of_key) {
+	struct bucket* buckets = (struct bucket*)calloc(bucket_cnt, sizeof(struct bucket));
+	uint32_t* keys_by_bucket = (uint32_t*)malloc(key_cnt * sizeof(uint32_t));
+	uint8_t* used = (uint8_t*)calloc(slot_cnt, 1);
+	uint32_t* attempt = (uint32_t*)malloc(IDS_PER_BUCKET * 8 * sizeof(uint32_t));
+	bool ok = buckets != NULL && keys_by_bucket != NULL && used != NULL && attempt != NULL;
+
+	if (ok) {
+		for (uint32_t i = 0; i < bucket_cnt; i++)
+			buckets[i].index = i;
+		for (uint32_t k = 0; k < key_cnt; k++)
+			buckets[xtrace_mig_index_hash((uint32_t)keys[k], 0) % bucket_cnt].key_cnt++;
+
+		uint32_t next = 0;
+		for (uint32_t i = 0; i < bucket_cnt; i++) {
+			buckets[i].first_key = next;
+			next += buckets[i].key_cnt;
+			buckets[i].key_cnt = 0;
+		}
+		for (uint32_t k = 0; k < key_cnt; k++) {
+			struct bucket* b = &buckets[xtrace_mig_index_hash((uint32_t)keys[k], 0) % bucket_cnt];
+			keys_by_bucket[b->first_key + b->key_cnt++] = k;
+		}
+
+		qsort(buckets, bucket_cnt, sizeof(struct bucket), compare_buckets_by_size);
+	}
+
+	for (uint32_t i = 0; ok && i < bucket_cnt; i++) {
+		const struct bucket* b = &buckets[i];
+		bool placed = false;
+
+		if (b->key_cnt == 0) {
+			displacements[b->index] = 0;
+			continue;
+		}
+
+		// a huge bucket means the hash is doing something silly; let the caller retry with more slots
+		if (b->key_cnt > IDS_PER_BUCKET * 8) {
+			ok = false;
+			break;
+		}
+
+		for (uint32_t d = 0; !placed && d < DISPLACEMENT_MAX; d++) {
+			uint32_t j;
+
+			for (j = 0; j < b->key_cnt; j++) {
+				uint32_t slot = xtrace_mig_index_hash((uint32_t)keys[keys_by_bucket[b->first_key + j]], d + 1) & (slot_cnt - 1);
+
+				if (used[slot])
+					break;
+
+				// also check against the other keys of this bucket
+				bool taken = false;
+				for (uint32_t l = 0; l < j; l++) {
+					if (attempt[l] == slot) {
+						taken = true;
+						break;
+					}
+				}
+				if (taken)
+					break;
+
+				attempt[j] = slot;
+			}
+
+			if (j == b->key_cnt) {
+				for (j = 0; j < b->key_cnt; j++) {
+					used[attempt[j]] = 1;
+					slot_of_key[keys_by_bucket[b->first_key + j]] = attempt[j];
+				}
+				displacements[b->index] = d;
+				placed = true;
+			}
+		}
+
+		if (!placed)
+			ok = false;
+	}
+
+	free(buckets);
+	free(keys_by_bucket);
+	free(used);
+	free(attempt);
+	return ok;
+};
+
+static int compare_file_inputs(const void* a, const void* b) {
+	return strcmp((*(const struct xtrace_mig_index_file_input* const*)a)->name, (*(const struct xtrace_mig_index_file_input* const*)b)->name);
+};
+
+extern "C"
+const struct xtrace_mig_index_header* xtrace_mig_index_build(const struct xtrace_mig_index_subsystem_input* subsystems, size_t cnt, const struct xtrace_mig_index_file_input* files, size_t file_cnt) {
+	struct xtrace_mig_index_subsystem* index_subsystems = (struct xtrace_mig_index_subsystem*)malloc((cnt ? cnt : 1) * sizeof(struct xtrace_mig_index_subsystem));
+	// sorted by name, for xtrace_mig_index_find_file()
+	const struct xtrace_mig_index_file_input** sorted_files = (const struct xtrace_mig_index_file_input**)malloc((file_cnt ? file_cnt : 1) * sizeof(*sorted_files));
+	struct xtrace_mig_index_file* index_files = (struct xtrace_mig_index_file*)calloc(file_cnt ? file_cnt : 1, sizeof(struct xtrace_mig_index_file));
+	struct pending_candidate* pending = NULL;
+	size_t pending_cnt = 0;
+	size_t pending_capacity = 0;
+	struct string_table strings = { NULL, 0, 0 };
+	uint32_t subsystem_cnt = 0;
+
+	int32_t* keys = NULL;
+	uint32_t* key_first = NULL;
+	uint32_t* slot_of_key = NULL;
+	uint32_t* displacements = NULL;
+	uint32_t key_cnt = 0;
+	uint32_t bucket_cnt = 0;
+	uint32_t slot_cnt = 0;
+
+	struct xtrace_mig_index_header* index = NULL;
+	bool ok = index_subsystems != NULL && sorted_files != NULL && index_files != NULL;
+
+	if (ok) {
+		for (size_t i = 0; i < file_cnt; i++)
+			sorted_files[i] = &files[i];
+		qsort(sorted_files, file_cnt, sizeof(*sorted_files), compare_file_inputs);
+	}
+
+	for (size_t i = 0; ok && i < file_cnt; i++) {
+		ok = string_table_add(&strings, sorted_files[i]->name, &index_files[i].name);
+		index_files[i].size = sorted_files[i]->size;
+		index_files[i].mtime = sorted_files[i]->mtime;
+	}
+
+	for (size_t i = 0; ok && i < cnt; i++) {
+		const struct xtrace_mig_index_subsystem_input* s = &subsystems[i];
+		struct xtrace_mig_index_subsystem* is = &index_subsystems[subsystem_cnt];
+
+		if (!string_table_add(&strings, s->name, &is->name) || !string_table_add(&strings, s->file_name, &is->file_name)) {
+			ok = false;
+			break;
+		}
+		is->base = s->base;
+		is->routine_cnt = s->routine_cnt;
+
+		// same rules as a lookup in the subsystem itself: the request range takes precedence over the reply range,
+		// and replies only count if the routine has one
+		for (unsigned long j = 0; ok && j < 2 * s->routine_cnt; j++) {
+			bool is_reply = j >= s->routine_cnt;
+			unsigned long routine = is_reply ? j - s->routine_cnt : j;
+			const struct xtrace_mig_index_routine_input* r = &s->routines[routine];
+
+			if (!r->present)
+				continue;
+			if (is_reply && (!r->reply_present || 100 + routine < s->routine_cnt))
+				continue;
+
+			if (pending_cnt == pending_capacity) {
+				pending_capacity = pending_capacity ? pending_capacity * 2 : 1024;
+				struct pending_candidate* new_pending = (struct pending_candidate*)realloc(pending, pending_capacity * sizeof(struct pending_candidate));
+				if (new_pending == NULL) {
+					ok = false;
+					break;
+				}
+				pending = new_pending;
+			}
+
+			struct pending_candidate* p = &pending[pending_cnt++];
+			memset(p, 0, sizeof(*p));
+			p->id = s->base + (is_reply ? 100 : 0) + (int32_t)routine;
+			p->candidate.subsystem = subsystem_cnt;
+			p->candidate.routine = (uint32_t)routine;
+			p->candidate.is_reply = is_reply;
+			p->candidate.reply_present = r->reply_present;
+			ok = string_table_add(&strings, r->name, &p->candidate.routine_name);
+		}
+
+		++subsystem_cnt;
+	}
+
+	if (ok && pending_cnt > 0)
+		qsort(pending, pending_cnt, sizeof(struct pending_candidate), compare_pending_candidates);
+
+	// collect the distinct IDs
+	if (ok) {
+		keys = (int32_t*)malloc((pending_cnt ? pending_cnt : 1) * sizeof(int32_t));
+		key_first = (uint32_t*)malloc((pending_cnt ? pending_cnt : 1) * sizeof(uint32_t));
+		slot_of_key = (uint32_t*)malloc((pending_cnt ? pending_cnt : 1) * sizeof(uint32_t));
+		ok = keys != NULL && key_first != NULL && slot_of_key != NULL;
+	}
+
+	for (size_t i = 0; ok && i < pending_cnt; i++) {
+		if (i == 0 || pending[i].id != pending[i - 1].id) {
+			keys[key_cnt] = pending[i].id;
+			key_first[key_cnt] = (uint32_t)i;
+			++key_cnt;
+		}
+	}
+
+	if (ok) {
+		bucket_cnt = key_cnt / IDS_PER_BUCKET + 1;
+		displacements = (uint32_t*)malloc(bucket_cnt * sizeof(uint32_t));
+		ok = displacements != NULL;
+
+		// start at a load factor of at most 0.8, and make the table bigger until every key finds a slot
+		for (slot_cnt = 1; slot_cnt < key_cnt + key_cnt / 4 + 1; slot_cnt *= 2);
+		while (ok && !place_keys(keys, key_cnt, bucket_cnt, slot_cnt, displacements, slot_of_key)) {
+			slot_cnt *= 2;
+			if (slot_cnt > 16 * (key_cnt + 1))
+				ok = false;
+		}
+	}
+
+	if (ok) {
+		uint32_t files_offset = sizeof(struct xtrace_mig_index_header);
+		uint32_t subsystems_offset = files_offset + file_cnt * sizeof(struct xtrace_mig_index_file);
+		uint32_t candidates_offset = subsystems_offset + subsystem_cnt * sizeof(struct xtrace_mig_index_subsystem);
+		uint32_t buckets_offset = candidates_offset + pending_cnt * sizeof(struct xtrace_mig_index_candidate);
+		uint32_t slots_offset = buckets_offset + bucket_cnt * sizeof(uint32_t);
+		uint32_t strings_offset = slots_offset + slot_cnt * sizeof(struct xtrace_mig_index_slot);
+		uint32_t size = strings_offset + strings.size;
+
+		index = (struct xtrace_mig_index_header*)calloc(1, size);
+		ok = index != NULL;
+
+		if (ok) {
+			memcpy(index->magic, XTRACE_MIG_INDEX_MAGIC, sizeof(index->magic));
+			index->version = XTRACE_MIG_INDEX_VERSION;
+			index->size = size;
+			index->file_cnt = file_cnt;
+			index->subsystem_cnt = subsystem_cnt;
+			index->candidate_cnt = pending_cnt;
+			index->bucket_cnt = bucket_cnt;
+			index->slot_cnt = slot_cnt;
+			index->files_offset = files_offset;
+			index->subsystems_offset = subsystems_offset;
+			index->candidates_offset = candidates_offset;
+			index->buckets_offset = buckets_offset;
+			index->slots_offset = slots_offset;
+			index->strings_offset = strings_offset;
+			index->strings_size = strings.size;
+
+			char* base = (char*)index;
+			if (file_cnt > 0)
+				memcpy(base + files_offset, index_files, file_cnt * sizeof(struct xtrace_mig_index_file));
+			if (subsystem_cnt > 0)
+				memcpy(base + subsystems_offset, index_subsystems, subsystem_cnt * sizeof(struct xtrace_mig_index_subsystem));
+
+			struct xtrace_mig_index_candidate* candidates = (struct xtrace_mig_index_candidate*)(base + candidates_offset);
+			for (size_t i = 0; i < pending_cnt; i++)
+				candidates[i] = pending[i].candidate;
+
+			memcpy(base + buckets_offset, displacements, bucket_cnt * sizeof(uint32_t));
+
+			struct xtrace_mig_index_slot* slots = (struct xtrace_mig_index_slot*)(base + slots_offset);
+			for (uint32_t k = 0; k < key_cnt; k++) {
+				struct xtrace_mig_index_slot* slot = &slots[slot_of_key[k]];
+				uint32_t end = (k + 1 < key_cnt) ? key_first[k + 1] : pending_cnt;
+
+				slot->id = keys[k];
+				slot->first_candidate = key_first[k];
+				slot->candidate_cnt = end - key_first[k];
+			}
+
+			if (strings.size > 0)
+				memcpy(base + strings_offset, strings.data, strings.size);
+		}
+	}
+
+	free(index_subsystems);
+	free(sorted_files);
+	free(index_files);
+	free(pending);
+	free(strings.data);
+	free(keys);
+	free(key_first);
+	free(slot_of_key);
+	free(displacements);
+
+	return index;
+};
+
+static bool section_fits(uint32_t size, uint32_t offset, uint64_t length) {
+	return offset <= size && length <= size - offset;
+};
+
+extern "C"
+const struct xtrace_mig_index_header* xtrace_mig_index_open(const char* path) {
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return NULL;
+
+	struct stat st;
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(struct xtrace_mig_index_header) || st.st_size > UINT32_MAX) {
+		close(fd);
+		return NULL;
+	}
+
+	void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return NULL;
+
+	const struct xtrace_mig_index_header* index = (const struct xtrace_mig_index_header*)mapping;
+	uint32_t size = (uint32_t)st.st_size;
+
+	bool valid = memcmp(index->magic, XTRACE_MIG_INDEX_MAGIC, sizeof(index->magic)) == 0
+		&& index->version == XTRACE_MIG_INDEX_VERSION
+		&& index->size == size
+		&& index->bucket_cnt > 0
+		&& index->slot_cnt > 0 && (index->slot_cnt & (index->slot_cnt - 1)) == 0
+		&& section_fits(size, index->files_offset, (uint64_t)index->file_cnt * sizeof(struct xtrace_mig_index_file))
+		&& section_fits(size, index->subsystems_offset, (uint64_t)index->subsystem_cnt * sizeof(struct xtrace_mig_index_subsystem))
+		&& section_fits(size, index->candidates_offset, (uint64_t)index->candidate_cnt * sizeof(struct xtrace_mig_index_candidate))
+		&& section_fits(size, index->buckets_offset, (uint64_t)index->bucket_cnt * sizeof(uint32_t))
+		&& section_fits(size, index->slots_offset, (uint64_t)index->slot_cnt * sizeof(struct xtrace_mig_index_slot))
+		&& section_fits(size, index->strings_offset, index->strings_size);
+
+	if (!valid) {
+		munmap(mapping, st.st_size);
+		return NULL;
+	}
+
+	return index;
+};
+
+extern "C"
+const struct xtrace_mig_index_file* xtrace_mig_index_find_file(const struct xtrace_mig_index_header* index, const char* name) {
+	const struct xtrace_mig_index_file* files = xtrace_mig_index_files(index);
+	uint32_t low = 0, high = index->file_cnt;
+
+	while (low < high) {
+		uint32_t middle = low + (high - low) / 2;
+		int result = strcmp(name, xtrace_mig_index_string(index, files[middle].name));
+
+		if (result == 0)
+			return &files[middle];
+		if (result < 0)
+			high = middle;
+		else
+			low = middle + 1;
+	}
+
+	return NULL;
+};
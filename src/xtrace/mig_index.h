@@ -0,0 +1,164 @@
+#ifndef XTRACE_MIG_INDEX
+#define XTRACE_MIG_INDEX
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "base.h"
+
+// an index of every message ID known to the MIG subsystems in the xtrace-mig directory,
+// so that we can identify messages without having to dlopen every subsystem in every traced process.
+//
+// the index is generated at build time by src/buildtools/xtrace-mig-index (which reads the subsystems out of the dylibs
+// without loading them) and installed next to the directory; traced processes only ever map it read-only.
+// if it's missing or doesn't match the directory, a process builds one in memory for itself.
+// message IDs are looked up with a perfect hash (hash and displace): the ID picks a bucket,
+// and the bucket's displacement picks a slot that no other ID uses.
+//
+// this header is also built for the host (for the build tool), so it mustn't depend on any Darwin headers.
+// all offsets are relative to the start of the header.
+
+#define XTRACE_MIG_INDEX_MAGIC "XTRCMIG1"
+#define XTRACE_MIG_INDEX_VERSION 2
+
+struct xtrace_mig_index_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t size;
+
+	// the files in the directory the index was built from
+	uint32_t file_cnt;
+	uint32_t subsystem_cnt;
+	uint32_t candidate_cnt;
+	uint32_t bucket_cnt;
+	// always a power of two
+	uint32_t slot_cnt;
+
+	uint32_t files_offset;
+	uint32_t subsystems_offset;
+	uint32_t candidates_offset;
+	uint32_t buckets_offset;
+	uint32_t slots_offset;
+	uint32_t strings_offset;
+	uint32_t strings_size;
+};
+
+// a file of the xtrace-mig directory, identified by its size and modification time;
+// the time only has a resolution of seconds, because that's all that survives packaging
+struct xtrace_mig_index_file {
+	// string offset
+	uint32_t name;
+	uint32_t reserved;
+	uint64_t size;
+	int64_t mtime;
+};
+
+struct xtrace_mig_index_subsystem {
+	// string offsets
+	uint32_t name;
+	uint32_t file_name;
+	int32_t base;
+	uint32_t routine_cnt;
+};
+
+// a routine of a subsystem that a message ID could belong to
+struct xtrace_mig_index_candidate {
+	uint32_t subsystem;
+	uint32_t routine;
+	// string offset
+	uint32_t routine_name;
+	uint8_t is_reply;
+	uint8_t reply_present;
+	uint16_t reserved;
+};
+
+struct xtrace_mig_index_slot {
+	int32_t id;
+	// the candidates for the ID, in the order of the subsystems (0 candidates means the slot is empty)
+	uint32_t first_candidate;
+	uint32_t candidate_cnt;
+};
+
+// what the index needs to know about a subsystem (the same fields as in struct xtrace_mig_subsystem)
+struct xtrace_mig_index_routine_input {
+	const char* name;
+	bool present;
+	bool reply_present;
+};
+
+struct xtrace_mig_index_subsystem_input {
+	const char* name;
+	const char* file_name;
+	int32_t base;
+	uint32_t routine_cnt;
+	const struct xtrace_mig_index_routine_input* routines;
+};
+
+struct xtrace_mig_index_file_input {
+	const char* name;
+	uint64_t size;
+	int64_t mtime;
+};
+
+XTRACE_DECLARATIONS_C_BEGIN
+
+// returns NULL if there's no (well-formed) index at `path`; whether it matches the directory is up to the caller
+const struct xtrace_mig_index_header* xtrace_mig_index_open(const char* path);
+
+// the files are recorded for checking the index against the directory later on; an index that's only used in memory doesn't need any.
+// the result is allocated with malloc.
+const struct xtrace_mig_index_header* xtrace_mig_index_build(const struct xtrace_mig_index_subsystem_input* subsystems, size_t subsystem_cnt, const struct xtrace_mig_index_file_input* files, size_t file_cnt);
+
+// returns NULL if the index doesn't know a file by that name
+const struct xtrace_mig_index_file* xtrace_mig_index_find_file(const struct xtrace_mig_index_header* index, const char* name);
+
+XTRACE_INLINE
+uint32_t xtrace_mig_index_hash(uint32_t key, uint32_t seed) {
+	uint32_t h = (key * 0x9e3779b1u) ^ (seed * 0x85ebca6bu);
+	h ^= h >> 16;
+	h *= 0x7feb352du;
+	h ^= h >> 15;
+	h *= 0x846ca68bu;
+	h ^= h >> 16;
+	return h;
+};
+
+XTRACE_INLINE
+const char* xtrace_mig_index_string(const struct xtrace_mig_index_header* index, uint32_t offset) {
+	return (const char*)index + index->strings_offset + offset;
+};
+
+XTRACE_INLINE
+const struct xtrace_mig_index_file* xtrace_mig_index_files(const struct xtrace_mig_index_header* index) {
+	return (const struct xtrace_mig_index_file*)((const char*)index + index->files_offset);
+};
+
+XTRACE_INLINE
+const struct xtrace_mig_index_subsystem* xtrace_mig_index_subsystems(const struct xtrace_mig_index_header* index) {
+	return (const struct xtrace_mig_index_subsystem*)((const char*)index + index->subsystems_offset);
+};
+
+XTRACE_INLINE
+const struct xtrace_mig_index_candidate* xtrace_mig_index_candidates(const struct xtrace_mig_index_header* index) {
+	return (const struct xtrace_mig_index_candidate*)((const char*)index + index->candidates_offset);
+};
+
+// returns the number of candidates for `id` and points `candidates` at the first one
+XTRACE_INLINE
+size_t xtrace_mig_index_lookup(const struct xtrace_mig_index_header* index, int32_t id, const struct xtrace_mig_index_candidate** candidates) {
+	const uint32_t* buckets = (const uint32_t*)((const char*)index + index->buckets_offset);
+	const struct xtrace_mig_index_slot* slots = (const struct xtrace_mig_index_slot*)((const char*)index + index->slots_offset);
+
+	uint32_t bucket = xtrace_mig_index_hash((uint32_t)id, 0) % index->bucket_cnt;
+	const struct xtrace_mig_index_slot* slot = &slots[xtrace_mig_index_hash((uint32_t)id, buckets[bucket] + 1) & (index->slot_cnt - 1)];
+
+	if (slot->candidate_cnt == 0 || slot->id != id)
+		return 0;
+
+	*candidates = xtrace_mig_index_candidates(index) + slot->first_candidate;
+	return slot->candidate_cnt;
+};
+
+XTRACE_DECLARATIONS_C_END
+
+#endif // XTRACE_MIG_INDEX
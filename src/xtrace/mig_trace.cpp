@@ -5,6 +5,9 @@
 #include <dlfcn.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include <mach/mach.h>
 
@@ -12,34 +15,69 @@
 #include "xtracelib.h"
 #include "mach_trace.h"
 #include "bsd_trace.h"
+#include "mig_trace.h"
+#include "mig_index.h"
 #include "xtrace/xtrace-mig-types.h"
 #include "tls.h"
 #include "string.h"
 
 #define XTRACE_MIG_DIR_PATH "/usr/lib/darling/xtrace-mig"
+// generated at build time (see mig_index.h); inside of the directory, it would be taken for one of the subsystems
+#define XTRACE_MIG_INDEX_PATH "/usr/lib/darling/xtrace-mig.index"
 
-static size_t subsystems_cnt = 0;
-static struct xtrace_mig_subsystem** subsystems = NULL;
+static const struct xtrace_mig_index_header* mig_index = NULL;
+// the subsystems in the index, once they're loaded (or `failed_subsystem` if they can't be)
+static const struct xtrace_mig_subsystem** loaded_subsystems = NULL;
+static const struct xtrace_mig_subsystem failed_subsystem = { "", 0, 0, NULL };
+
+int xtrace_mig_loads_in_progress = 0;
 
 static mach_port_name_t host_port;
 
-extern "C"
-void xtrace_setup_mig_tracing(void)
+static const struct xtrace_mig_subsystem* open_subsystem(const char* file_name)
 {
-	// This runs before the syscall tracing is enabled, so we can
-	// freely use libSystem and make syscalls.
+	size_t path_size = strlen(XTRACE_MIG_DIR_PATH) + 1 + strlen(file_name) + 1;
+	char path[path_size];
+	strcpy(path, XTRACE_MIG_DIR_PATH "/");
+	strcat(path, file_name);
 
-	host_port = mach_host_self();
+	void* dylib_handle = dlopen(path, RTLD_LOCAL);
+	if (dylib_handle == NULL)
+	{
+		xtrace_error("xtrace: failed to dlopen %s: %s\n", path, dlerror());
+		return NULL;
+	}
+
+	const struct xtrace_mig_subsystem* s = (const struct xtrace_mig_subsystem*) dlsym(dylib_handle, "xtrace_mig_subsystem");
+	if (s == NULL)
+		xtrace_error("xtrace: failed to dlsym(%s, \"xtrace_mig_subsystem\"): %s\n", path, dlerror());
+
+	return s;
+}
 
+// loads every subsystem in the directory and indexes them in memory; used when the installed index is missing or out of date
+static void build_index(void)
+{
 	DIR* xtrace_mig_dir = opendir(XTRACE_MIG_DIR_PATH);
 	if (xtrace_mig_dir == NULL)
 	{
 		perror("xtrace: failed to open " XTRACE_MIG_DIR_PATH);
 		return;
 	}
+
+	size_t subsystems_cnt = 0;
 	// Count the number of files, and allocate this many subsystem pointers;
 	for (struct dirent* dirent; (dirent = readdir(xtrace_mig_dir)) != NULL; subsystems_cnt++);
-	subsystems = (xtrace_mig_subsystem**)malloc(subsystems_cnt * sizeof(struct xtrace_mig_subsystem*));
+	const struct xtrace_mig_subsystem** subsystems = (const struct xtrace_mig_subsystem**)calloc(subsystems_cnt ? subsystems_cnt : 1, sizeof(struct xtrace_mig_subsystem*));
+	char** file_names = (char**)calloc(subsystems_cnt ? subsystems_cnt : 1, sizeof(char*));
+	if (subsystems == NULL || file_names == NULL)
+	{
+		xtrace_error("xtrace: failed to allocate MIG subsystem list\n");
+		free(subsystems);
+		free(file_names);
+		closedir(xtrace_mig_dir);
+		return;
+	}
 
 	rewinddir(xtrace_mig_dir);
 	for (size_t i = 0; i < subsystems_cnt; i++)
@@ -52,31 +90,165 @@ void xtrace_setup_mig_tracing(void)
 			break;
 		}
 		if (dirent->d_type != DT_REG)
-		{
-			subsystems[i] = NULL;
 			continue;
-		}
-		size_t path_size = strlen(XTRACE_MIG_DIR_PATH) + 1 + strlen(dirent->d_name) + 1;
-		char path[path_size];
-		strcpy(path, XTRACE_MIG_DIR_PATH "/");
-		strcat(path, dirent->d_name);
 
-		void* dylib_handle = dlopen(path, RTLD_LOCAL);
-		if (dylib_handle == NULL)
-		{
-			xtrace_error("xtrace: failed to dlopen %s: %s\n", path, dlerror());
-			subsystems[i] = NULL;
+		file_names[i] = strdup(dirent->d_name);
+		if (file_names[i] != NULL)
+			subsystems[i] = open_subsystem(dirent->d_name);
+		// Leave NULL subsystems in place and continue.
+	}
+
+	closedir(xtrace_mig_dir);
+
+	// the index only needs to know the names of the routines
+	size_t inputs_cnt = 0, routines_cnt = 0;
+	for (size_t i = 0; i < subsystems_cnt; i++)
+	{
+		if (subsystems[i] != NULL)
+			routines_cnt += subsystems[i]->routine_cnt;
+	}
+
+	struct xtrace_mig_index_subsystem_input* inputs = (struct xtrace_mig_index_subsystem_input*)calloc(subsystems_cnt ? subsystems_cnt : 1, sizeof(struct xtrace_mig_index_subsystem_input));
+	struct xtrace_mig_index_routine_input* routines = (struct xtrace_mig_index_routine_input*)calloc(routines_cnt ? routines_cnt : 1, sizeof(struct xtrace_mig_index_routine_input));
+	for (size_t i = 0, r = 0; i < subsystems_cnt && inputs != NULL && routines != NULL; i++)
+	{
+		const struct xtrace_mig_subsystem* s = subsystems[i];
+		if (s == NULL)
 			continue;
+
+		inputs[inputs_cnt].name = s->name;
+		inputs[inputs_cnt].file_name = file_names[i];
+		inputs[inputs_cnt].base = s->base;
+		inputs[inputs_cnt].routine_cnt = (uint32_t)s->routine_cnt;
+		inputs[inputs_cnt].routines = &routines[r];
+		inputs_cnt++;
+
+		for (unsigned long j = 0; j < s->routine_cnt; j++, r++)
+		{
+			routines[r].name = s->routines[j].name;
+			routines[r].present = s->routines[j].present != 0;
+			routines[r].reply_present = s->routines[j].reply_present != 0;
 		}
-		subsystems[i] = (struct xtrace_mig_subsystem*) dlsym(dylib_handle, "xtrace_mig_subsystem");
-		if (subsystems[i] == NULL)
+	}
+
+	if (inputs != NULL && routines != NULL)
+		mig_index = xtrace_mig_index_build(inputs, inputs_cnt, NULL, 0);
+	free(inputs);
+	free(routines);
+
+	if (mig_index == NULL)
+	{
+		xtrace_error("xtrace: failed to build the MIG index\n");
+	}
+	else
+	{
+		// we've already loaded all of them; the index skips the ones that failed, just like we do here
+		loaded_subsystems = (const struct xtrace_mig_subsystem**)calloc(mig_index->subsystem_cnt ? mig_index->subsystem_cnt : 1, sizeof(struct xtrace_mig_subsystem*));
+		for (size_t i = 0, j = 0; i < subsystems_cnt && loaded_subsystems != NULL; i++)
 		{
-			xtrace_error("xtrace: failed to dlsym(%s, \"xtrace_mig_subsystem\"): %s\n", path, dlerror());
-			// Leave NULL subsystem in place and continue.
+			if (subsystems[i] != NULL)
+				loaded_subsystems[j++] = subsystems[i];
 		}
 	}
 
+	for (size_t i = 0; i < subsystems_cnt; i++)
+		free(file_names[i]);
+	free(file_names);
+	free(subsystems);
+}
+
+// checks that the directory holds exactly the files the index was built from, with the same sizes and modification times
+static bool index_matches_directory(const struct xtrace_mig_index_header* index)
+{
+	DIR* xtrace_mig_dir = opendir(XTRACE_MIG_DIR_PATH);
+	if (xtrace_mig_dir == NULL)
+		return false;
+
+	int dir_fd = dirfd(xtrace_mig_dir);
+	uint32_t files_cnt = 0;
+	bool matches = true;
+
+	for (struct dirent* dirent; matches && (dirent = readdir(xtrace_mig_dir)) != NULL; )
+	{
+		if (dirent->d_type != DT_REG)
+			continue;
+
+		const struct xtrace_mig_index_file* file = xtrace_mig_index_find_file(index, dirent->d_name);
+		struct stat st;
+
+		matches = file != NULL
+			&& fstatat(dir_fd, dirent->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0
+			&& (uint64_t)st.st_size == file->size
+			&& (int64_t)st.st_mtimespec.tv_sec == file->mtime;
+		files_cnt++;
+	}
+
 	closedir(xtrace_mig_dir);
+	return matches && files_cnt == index->file_cnt;
+}
+
+extern "C"
+void xtrace_setup_mig_tracing(void)
+{
+	// This runs before the syscall tracing is enabled, so we can
+	// freely use libSystem and make syscalls.
+
+	host_port = mach_host_self();
+
+	// a subsystem that was added, removed or replaced since the index was generated means we can't use it
+	mig_index = xtrace_mig_index_open(XTRACE_MIG_INDEX_PATH);
+	if (mig_index != NULL && !index_matches_directory(mig_index))
+	{
+		munmap((void*)mig_index, mig_index->size);
+		mig_index = NULL;
+	}
+
+	if (mig_index == NULL)
+	{
+		build_index();
+		return;
+	}
+
+	// the subsystems themselves are only loaded once we see one of their messages
+	loaded_subsystems = (const struct xtrace_mig_subsystem**)calloc(mig_index->subsystem_cnt ? mig_index->subsystem_cnt : 1, sizeof(struct xtrace_mig_subsystem*));
+	if (loaded_subsystems == NULL)
+		mig_index = NULL;
+}
+
+extern "C"
+void xtrace_mig_postfork_child(void)
+{
+	// a thread that was in the middle of loading a subsystem doesn't exist anymore
+	xtrace_mig_loads_in_progress = 0;
+	xtrace_tls_fast()->mig_loading = 0;
+}
+
+static const struct xtrace_mig_subsystem* load_subsystem(uint32_t index)
+{
+	const struct xtrace_mig_subsystem* s = __atomic_load_n(&loaded_subsystems[index], __ATOMIC_ACQUIRE);
+
+	if (s == NULL)
+	{
+		const struct xtrace_mig_index_subsystem* is = &xtrace_mig_index_subsystems(mig_index)[index];
+
+		// dlopen() makes plenty of calls of its own, which we don't want to show up in the middle of this one's output.
+		// we don't take a lock here: if two threads race to load the same subsystem, dlopen() just hands both the same one.
+		__atomic_add_fetch(&xtrace_mig_loads_in_progress, 1, __ATOMIC_RELAXED);
+		xtrace_tls_fast()->mig_loading++;
+
+		s = open_subsystem(xtrace_mig_index_string(mig_index, is->file_name));
+
+		xtrace_tls_fast()->mig_loading--;
+		__atomic_sub_fetch(&xtrace_mig_loads_in_progress, 1, __ATOMIC_RELAXED);
+
+		// checking the files should catch a replaced subsystem, but don't trust the index blindly
+		if (s == NULL || s->base != is->base || s->routine_cnt != is->routine_cnt || strcmp(s->name, xtrace_mig_index_string(mig_index, is->name)) != 0)
+			s = &failed_subsystem;
+
+		__atomic_store_n(&loaded_subsystems[index], s, __ATOMIC_RELEASE);
+	}
+
+	return (s == &failed_subsystem) ? NULL : s;
 }
 
 DEFINE_XTRACE_TLS_VAR(bool, is_first_arg, false, NULL);
@@ -253,94 +425,68 @@ const struct xtrace_mig_callbacks callbacks = {
 	.xtrace_log = xtrace_log
 };
 
-static const struct xtrace_mig_routine_desc* find_routine(mach_msg_id_t id, const struct xtrace_mig_subsystem* s, int* out_is_reply)
+static int filter(const char* subsystem_name, int port_kind)
 {
-	if (s == NULL)
-		return NULL;
-
-	const struct xtrace_mig_routine_desc* r = NULL;
-	int is_reply;
-
-	if (s->base <= id && id < (s->base + s->routine_cnt))
-	{
-		r = &s->routines[id - s->base];
-		is_reply = 0;
-	}
-	else if (s->base + 100 <= id && id < (s->base + 100 + s->routine_cnt))
-	{
-		r = &s->routines[id - (s->base + 100)];
-		is_reply = 1;
-	}
-
-	if (r == NULL)
-		return NULL;
-	if (!r->present)
-		return NULL;
-	if (is_reply && !r->reply_present)
-		return NULL;
+	// mach_host.defs and job.defs use the same msgids,
+	// so use the request port to distinguish them.
+	if (port_kind == xtrace_mig_port_bootstrap)
+		return strncmp(subsystem_name, "job", 3) == 0;
+	if (port_kind == xtrace_mig_port_host)
+		return strncmp(subsystem_name, "host", 4) == 0;
 
-	*out_is_reply = is_reply;
-	return r;
+	return 1;
 }
 
-static int filter(const struct xtrace_mig_subsystem* s, mach_port_name_t request_port)
+extern "C"
+int xtrace_mig_port_kind(mach_port_name_t request_port)
 {
-	if (s == NULL)
-		return 0;
-
-	// mach_host.defs and job.defs use the same msgids,
-	// so use the request port to distinguish them.
 	if (request_port == bootstrap_port)
-		return strncmp(s->name, "job", 3) == 0;
+		return xtrace_mig_port_bootstrap;
 	if (request_port == host_port)
-		return strncmp(s->name, "host", 4) == 0;
-
-	return 1;
+		return xtrace_mig_port_host;
+	return xtrace_mig_port_other;
 }
 
-static int find_subsystem(
-	mach_msg_id_t id,
-	mach_port_name_t request_port,
-	int do_filter,
-	const struct xtrace_mig_subsystem** out_s,
-	const struct xtrace_mig_routine_desc** out_r,
-	int* out_is_reply
-)
+static const struct xtrace_mig_index_candidate* find_candidate(mach_msg_id_t id, int port_kind, int do_filter)
 {
+	const struct xtrace_mig_index_subsystem* subsystems = xtrace_mig_index_subsystems(mig_index);
+	const struct xtrace_mig_index_candidate* candidates;
+	size_t candidates_cnt = xtrace_mig_index_lookup(mig_index, id, &candidates);
+
 	// First, check if it matches any routine that has both a request and a reply.
 	// The reason for doing it like this is that many subsystems are actually
 	// "reply" and "forward" versions of other subsystems/routines, consisting only
 	// of simpleroutines; and we want to find the original ones if possible.
-	for (size_t i = 0; i < subsystems_cnt; i++)
+	for (size_t i = 0; i < candidates_cnt; i++)
 	{
-		if (do_filter && !filter(subsystems[i], request_port))
+		if (do_filter && !filter(xtrace_mig_index_string(mig_index, subsystems[candidates[i].subsystem].name), port_kind))
 			continue;
 
-		const struct xtrace_mig_routine_desc* r = find_routine(id, subsystems[i], out_is_reply);
-		if (r != NULL && r->reply_present)
-		{
-			*out_s = subsystems[i];
-			*out_r = r;
-			return 1;
-		}
+		if (candidates[i].reply_present)
+			return &candidates[i];
 	}
 
 	// Now, just see if it matches anything.
-	for (size_t i = 0; i < subsystems_cnt; i++)
+	for (size_t i = 0; i < candidates_cnt; i++)
 	{
-		if (do_filter && !filter(subsystems[i], request_port))
+		if (do_filter && !filter(xtrace_mig_index_string(mig_index, subsystems[candidates[i].subsystem].name), port_kind))
 			continue;
 
-		const struct xtrace_mig_routine_desc* r = find_routine(id, subsystems[i], out_is_reply);
-		if (r != NULL)
-		{
-			*out_s = subsystems[i];
-			*out_r = r;
-			return 1;
-		}
+		return &candidates[i];
 	}
 
-	return 0;
+	return NULL;
+}
+
+static const struct xtrace_mig_index_candidate* find_routine(mach_msg_id_t id, int port_kind)
+{
+	if (mig_index == NULL)
+		return NULL;
+
+	const struct xtrace_mig_index_candidate* c = find_candidate(id, port_kind, 1);
+	if (c == NULL)
+		c = find_candidate(id, port_kind, 0);
+	return c;
 }
 
 void xtrace_print_mig_message(xtrace::String* log, const mach_msg_header_t* message, mach_port_name_t request_port)
@@ -348,16 +494,17 @@ void xtrace_print_mig_message(xtrace::String* log, const mach_msg_header_t* mess
 	if (message == NULL)
 		return;
 
-	const struct xtrace_mig_subsystem* s;
-	const struct xtrace_mig_routine_desc* r;
-	int is_reply;
+	const struct xtrace_mig_index_candidate* c = find_routine(message->msgh_id, xtrace_mig_port_kind(request_port));
+	if (c == NULL)
+		return;
 
-	int res = find_subsystem(message->msgh_id, request_port, 1, &s, &r, &is_reply);
-	if (!res)
-		res = find_subsystem(message->msgh_id, request_port, 0, &s, &r, &is_reply);
-	if (!res)
+	const struct xtrace_mig_subsystem* s = load_subsystem(c->subsystem);
+	if (s == NULL)
 		return;
 
+	const struct xtrace_mig_routine_desc* r = &s->routines[c->routine];
+	int is_reply = c->is_reply;
+
 	if (!is_reply)
 		log->append_format("%s::%s(", s->name, r->name);
 	else
@@ -375,3 +522,64 @@ void xtrace_print_mig_message(xtrace::String* log, const mach_msg_header_t* mess
 	else
 		log->append(" ");
 }
+
+extern "C"
+size_t xtrace_mig_for_each_id(const char* subsystem_name, const char* routine_name, void (*callback)(mach_msg_id_t id, void* context), void* context)
+{
+	if (mig_index == NULL)
+		return 0;
+
+	const struct xtrace_mig_index_subsystem* subsystems = xtrace_mig_index_subsystems(mig_index);
+	const struct xtrace_mig_index_candidate* candidates = xtrace_mig_index_candidates(mig_index);
+	size_t matched = 0;
+
+	// the candidates are sorted by ID, and we don't keep the ID itself around, so reconstruct it from the subsystem
+	for (uint32_t i = 0; i < mig_index->candidate_cnt; i++)
+	{
+		const struct xtrace_mig_index_candidate* c = &candidates[i];
+		const struct xtrace_mig_index_subsystem* is = &subsystems[c->subsystem];
+
+		if (strcmp(xtrace_mig_index_string(mig_index, is->name), subsystem_name) != 0)
+			continue;
+		if (routine_name != NULL && strcmp(xtrace_mig_index_string(mig_index, c->routine_name), routine_name) != 0)
+			continue;
+
+		callback(is->base + (c->is_reply ? 100 : 0) + (mach_msg_id_t)c->routine, context);
+		++matched;
+	}
+
+	return matched;
+}
+
+bool xtrace_find_mig_routine(mach_msg_id_t id, int port_kind, const char** subsystem_name, const char** routine_name, int* is_reply)
+{
+	// the names are in the index, so there's no need to load the subsystem
+	const struct xtrace_mig_index_candidate* c = find_routine(id, port_kind);
+	if (c == NULL)
+		return false;
+
+	*subsystem_name = xtrace_mig_index_string(mig_index, xtrace_mig_index_subsystems(mig_index)[c->subsystem].name);
+	*routine_name = xtrace_mig_index_string(mig_index, c->routine_name);
+	*is_reply = c->is_reply;
+	return true;
+}
+
+void xtrace_print_mig_routine_name(xtrace::String* log, mach_msg_id_t id, int port_kind)
+{
+	const char* subsystem_name;
+	const char* routine_name;
+	int is_reply;
+
+	if (!xtrace_find_mig_routine(id, port_kind, &subsystem_name, &routine_name, &is_reply))
+		return;
+
+	if (!is_reply)
+		log->append_format("%s::%s(...)", subsystem_name, routine_name);
+	else
+	{
+		xtrace_set_gray_color(log);
+		log->append_format("%s::%s() -> ", subsystem_name, routine_name);
+		xtrace_reset_color(log);
+		log->append("...");
+	}
+}
@@ -1,15 +1,44 @@
 #ifndef XTRACE_MIG_TRACE
 #define XTRACE_MIG_TRACE
 
+#include <stddef.h>
 #include <mach/message.h>
 #include "base.h"
+#include "tls.h"
 
 #ifdef XTRACE_CPP
 void xtrace_print_mig_message(xtrace::String* log, const mach_msg_header_t* message, mach_port_name_t request_port);
+// like xtrace_print_mig_message, but for when only the message ID is known
+void xtrace_print_mig_routine_name(xtrace::String* log, mach_msg_id_t id, int port_kind);
+bool xtrace_find_mig_routine(mach_msg_id_t id, int port_kind, const char** subsystem_name, const char** routine_name, int* is_reply);
 #endif
 
 XTRACE_DECLARATIONS_C_BEGIN
+
+// the request ports that are needed to tell apart subsystems with overlapping message IDs
+enum xtrace_mig_port_kind {
+	xtrace_mig_port_other,
+	xtrace_mig_port_bootstrap,
+	xtrace_mig_port_host,
+};
+
 void xtrace_setup_mig_tracing(void);
+void xtrace_mig_postfork_child(void);
+int xtrace_mig_port_kind(mach_port_name_t request_port);
+
+// calls `callback` with the request and reply IDs of every routine matching the given names
+// (`routine_name` may be NULL to match all routines of the subsystem); returns the number of IDs matched
+size_t xtrace_mig_for_each_id(const char* subsystem_name, const char* routine_name, void (*callback)(mach_msg_id_t id, void* context), void* context);
+
+// subsystems are loaded the first time one of their messages is printed;
+// the calls dlopen() makes while doing that shouldn't be traced
+extern int xtrace_mig_loads_in_progress;
+
+XTRACE_INLINE
+bool xtrace_mig_loading(void) {
+	return __atomic_load_n(&xtrace_mig_loads_in_progress, __ATOMIC_RELAXED) && xtrace_tls_fast()->mig_loading;
+};
+
 XTRACE_DECLARATIONS_C_END
 
 #endif // XTRACE_MIG_TRACE
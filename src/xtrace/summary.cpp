@@ -0,0 +1,607 @@
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+
+#include <darling/emulation/simple.h>
+#include <darling/emulation/ext/for-xtrace.h>
+
+#include "xtracelib.h"
+#include "summary.h"
+#include "mach_trace.h"
+#include "bsd_trace.h"
+#include "mig_trace.h"
+#include "tls.h"
+#include "lock.h"
+#include "memory.h"
+#include "string.h"
+
+//
+// summary mode (XTRACE_SUMMARY)
+//
+// like `strace -c`: nothing is printed while the program runs; instead, every thread counts calls, errors and time spent
+// per call number (and per MIG routine for mach_msg) in its own stats block. the blocks are summed up and printed
+// when the process exits or execs, or whenever the signal given in XTRACE_SUMMARY_SIGNAL arrives.
+//
+
+extern "C" int sys_thread_selfid(void);
+
+#define BSD_CALLS_MAX 600
+#define MACH_CALLS_MAX 128
+
+// call durations are counted in buckets by the log2 of their length in timestamp ticks
+#define HISTOGRAM_BUCKETS 48
+
+// MIG routines are kept in a small open-addressing table per thread;
+// anything that doesn't fit is only counted in the mach_msg totals
+#define MIG_SLOTS 512
+
+#define NESTING_MAX 64
+
+struct call_stats {
+	uint64_t count;
+	uint64_t errors;
+	uint64_t ticks;
+	uint32_t histogram[HISTOGRAM_BUCKETS];
+} __attribute__((aligned(64)));
+
+struct frame {
+	uint64_t start;
+	int nr;
+	bool is_mach;
+	// for mach_msg: the request's MIG key, or where to find the reply to compute it on exit
+	uint32_t mig_key;
+	const mach_msg_header_t* rcv_msg;
+};
+
+struct thread_stats {
+	struct call_stats bsd[BSD_CALLS_MAX];
+	struct call_stats mach[MACH_CALLS_MAX];
+	struct call_stats mig[MIG_SLOTS];
+	// (msgh_id << 2 | port kind) + 1 for each MIG slot; 0 means the slot is unused
+	uint32_t mig_keys[MIG_SLOTS];
+
+	struct frame frames[NESTING_MAX];
+	int depth;
+	bool dumping;
+
+	uint32_t in_use;
+	struct thread_stats* next;
+};
+
+int xtrace_summary = 0;
+
+static struct thread_stats* all_stats = NULL;
+static xtrace_lock_t dump_lock = XTRACE_LOCK_INITIALIZER;
+static int summary_pid = 0;
+static int dump_requested = 0;
+
+// used to convert timestamp ticks to nanoseconds at dump time
+static uint64_t start_timestamp;
+static uint64_t start_time;
+static mach_timebase_info_data_t timebase;
+
+static void summary_stats_destroy(struct thread_stats** ptr);
+
+DEFINE_XTRACE_TLS_VAR(struct thread_stats*, summary_stats, NULL, summary_stats_destroy);
+
+static void summary_stats_destroy(struct thread_stats** ptr) {
+	// the counts stay where they are (they're still part of the summary); another thread can just keep adding to them
+	if (*ptr != NULL) {
+		__atomic_store_n(&(*ptr)->in_use, 0, __ATOMIC_RELEASE);
+	}
+};
+
+static struct thread_stats* stats_acquire(void) {
+	struct thread_stats* stats;
+
+	for (stats = __atomic_load_n(&all_stats, __ATOMIC_ACQUIRE); stats != NULL; stats = stats->next) {
+		uint32_t expected = 0;
+		if (__atomic_compare_exchange_n(&stats->in_use, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+			break;
+		}
+	}
+
+	if (stats == NULL) {
+		// mmap instead of xtrace_malloc, so that only the pages that are actually used get backed by memory
+		void* mapping = _mmap_for_xtrace(NULL, sizeof(struct thread_stats), PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+		if ((uintptr_t)mapping > (uintptr_t)-4096) {
+			xtrace_abort("xtrace: failed to allocate summary stats");
+		}
+
+		stats = (struct thread_stats*)mapping;
+		stats->in_use = 1;
+
+		struct thread_stats* head = __atomic_load_n(&all_stats, __ATOMIC_RELAXED);
+		do {
+			stats->next = head;
+		} while (!__atomic_compare_exchange_n(&all_stats, &head, stats, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	stats->depth = 0;
+	stats->dumping = false;
+
+	set_summary_stats(stats);
+	return stats;
+};
+
+XTRACE_INLINE
+struct thread_stats* current_stats(void) {
+	struct thread_stats* stats = get_summary_stats();
+
+	if (stats == NULL) {
+		stats = stats_acquire();
+	}
+
+	return stats->dumping ? NULL : stats;
+};
+
+XTRACE_INLINE
+uint32_t mig_key(mach_msg_id_t id, int port_kind) {
+	return (((uint32_t)id << 2) | (uint32_t)port_kind) + 1;
+};
+
+static struct call_stats* mig_stats(struct thread_stats* stats, uint32_t key) {
+	uint32_t slot = (key * 2654435761u) % MIG_SLOTS;
+
+	for (int i = 0; i < MIG_SLOTS; i++) {
+		uint32_t* slot_key = &stats->mig_keys[(slot + i) % MIG_SLOTS];
+
+		if (*slot_key == key) {
+			return &stats->mig[(slot + i) % MIG_SLOTS];
+		}
+
+		if (*slot_key == 0) {
+			// the owning thread is the only writer; the dumping thread just reads the key
+			__atomic_store_n(slot_key, key, __ATOMIC_RELEASE);
+			return &stats->mig[(slot + i) % MIG_SLOTS];
+		}
+	}
+
+	return NULL;
+};
+
+// only ever called by the owning thread; the counters are read (but never written) concurrently by dumps
+static void stats_add(struct call_stats* call, uint64_t ticks, bool failed) {
+	int bucket = (ticks == 0) ? 0 : (63 - __builtin_clzll(ticks));
+
+	if (bucket >= HISTOGRAM_BUCKETS) {
+		bucket = HISTOGRAM_BUCKETS - 1;
+	}
+
+	__atomic_store_n(&call->count, call->count + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&call->ticks, call->ticks + ticks, __ATOMIC_RELAXED);
+	if (failed) {
+		__atomic_store_n(&call->errors, call->errors + 1, __ATOMIC_RELAXED);
+	}
+	__atomic_store_n(&call->histogram[bucket], call->histogram[bucket] + 1, __ATOMIC_RELAXED);
+};
+
+static struct frame* push_frame(struct thread_stats* stats, int nr, bool is_mach) {
+	if (stats->depth >= NESTING_MAX) {
+		++stats->depth;
+		return NULL;
+	}
+
+	struct frame* frame = &stats->frames[stats->depth++];
+	frame->nr = nr;
+	frame->is_mach = is_mach;
+	frame->mig_key = 0;
+	frame->rcv_msg = NULL;
+	frame->start = xtrace_read_timestamp();
+	return frame;
+};
+
+static struct frame* pop_frame(struct thread_stats* stats) {
+	if (stats->depth == 0) {
+		// e.g. the entry happened before we were set up
+		return NULL;
+	}
+
+	if (--stats->depth >= NESTING_MAX) {
+		return NULL;
+	}
+
+	return &stats->frames[stats->depth];
+};
+
+//
+// output
+//
+
+struct summary_row {
+	// NULL for calls xtrace doesn't know the name of; they're printed as `${kind} ${nr}`
+	const char* name;
+	const char* kind;
+	int nr;
+	// for MIG routines
+	const char* subsystem_name;
+	struct call_stats stats;
+};
+
+static double ns_per_tick(void) {
+	uint64_t ticks = xtrace_read_timestamp() - start_timestamp;
+	uint64_t time = mach_absolute_time() - start_time;
+
+	if (ticks == 0 || timebase.denom == 0) {
+		return 0;
+	}
+
+	return (double)time * timebase.numer / timebase.denom / ticks;
+};
+
+static void sum_stats(struct call_stats* total, const struct call_stats* call) {
+	total->count += __atomic_load_n(&call->count, __ATOMIC_RELAXED);
+	total->errors += __atomic_load_n(&call->errors, __ATOMIC_RELAXED);
+	total->ticks += __atomic_load_n(&call->ticks, __ATOMIC_RELAXED);
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		total->histogram[i] += __atomic_load_n(&call->histogram[i], __ATOMIC_RELAXED);
+	}
+};
+
+static int compare_rows(const void* a, const void* b) {
+	const struct summary_row* row_a = (const struct summary_row*)a;
+	const struct summary_row* row_b = (const struct summary_row*)b;
+
+	if (row_a->stats.ticks != row_b->stats.ticks) {
+		return (row_a->stats.ticks < row_b->stats.ticks) ? 1 : -1;
+	}
+
+	if (row_a->stats.count != row_b->stats.count) {
+		return (row_a->stats.count < row_b->stats.count) ? 1 : -1;
+	}
+
+	return 0;
+};
+
+// upper bound of the histogram bucket containing the 99th percentile, in ticks
+static uint64_t percentile_99(const struct call_stats* call) {
+	uint64_t threshold = call->count - call->count / 100;
+	uint64_t seen = 0;
+
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += call->histogram[i];
+		if (seen >= threshold) {
+			return 2ULL << i;
+		}
+	}
+
+	return 2ULL << (HISTOGRAM_BUCKETS - 1);
+};
+
+// __simple_snprintf doesn't do field widths
+static void append_column(xtrace::String* line, const char* text, int width) {
+	for (int i = __simple_strlen(text); i < width; i++) {
+		line->append(" ");
+	}
+	line->append(text);
+	line->append(" ");
+};
+
+static void append_number_column(xtrace::String* line, unsigned long long value, int width) {
+	char text[32];
+	__simple_snprintf(text, sizeof(text), "%llu", value);
+	append_column(line, text, width);
+};
+
+static void print_table(const char* title, struct summary_row* rows, size_t count, double tick_ns) {
+	struct call_stats total;
+	xtrace::String line;
+
+	memset(&total, 0, sizeof(total));
+	for (size_t i = 0; i < count; i++) {
+		sum_stats(&total, &rows[i].stats);
+	}
+
+	if (total.count == 0) {
+		return;
+	}
+
+	qsort(rows, count, sizeof(struct summary_row), compare_rows);
+
+	xtrace_error("%s\n", title);
+	xtrace_error("%% time   total (us)  us/call  p99 (us)      calls   errors  name\n");
+	xtrace_error("------ ------------ -------- --------- ---------- -------- ----------------\n");
+
+	for (size_t i = 0; i < count; i++) {
+		const struct call_stats* call = &rows[i].stats;
+		char percent[16];
+
+		if (call->count == 0) {
+			continue;
+		}
+
+		uint64_t permille = (total.ticks == 0) ? 0 : (call->ticks * 1000 / total.ticks);
+		__simple_snprintf(percent, sizeof(percent), "%llu.%llu", (unsigned long long)(permille / 10), (unsigned long long)(permille % 10));
+
+		line.clear();
+		append_column(&line, percent, 6);
+		append_number_column(&line, (unsigned long long)(call->ticks * tick_ns / 1000), 12);
+		append_number_column(&line, (unsigned long long)(call->ticks * tick_ns / 1000 / call->count), 8);
+		append_number_column(&line, (unsigned long long)(percentile_99(call) * tick_ns / 1000), 9);
+		append_number_column(&line, call->count, 10);
+		append_number_column(&line, call->errors, 8);
+
+		if (rows[i].subsystem_name != NULL) {
+			line.append_format(" %s::%s", rows[i].subsystem_name, rows[i].name);
+		} else if (rows[i].name != NULL) {
+			line.append_format(" %s", rows[i].name);
+		} else {
+			line.append_format(" %s %d", rows[i].kind, rows[i].nr);
+		}
+
+		xtrace_error("%s\n", line.c_str());
+	}
+
+	line.clear();
+	append_column(&line, "100.0", 6);
+	append_number_column(&line, (unsigned long long)(total.ticks * tick_ns / 1000), 12);
+	append_column(&line, "", 8);
+	append_column(&line, "", 9);
+	append_number_column(&line, total.count, 10);
+	append_number_column(&line, total.errors, 8);
+	line.append(" total");
+
+	xtrace_error("------ ------------ -------- --------- ---------- -------- ----------------\n");
+	xtrace_error("%s\n\n", line.c_str());
+};
+
+static void dump_calls(double tick_ns) {
+	size_t rows_cnt = BSD_CALLS_MAX + MACH_CALLS_MAX;
+	struct summary_row* rows = (struct summary_row*)xtrace_malloc(rows_cnt * sizeof(struct summary_row));
+
+	if (rows == NULL) {
+		return;
+	}
+
+	memset(rows, 0, rows_cnt * sizeof(struct summary_row));
+
+	for (int nr = 0; nr < BSD_CALLS_MAX; nr++) {
+		rows[nr].name = xtrace_bsd_call_name(nr);
+		rows[nr].kind = "bsd";
+		rows[nr].nr = nr;
+	}
+
+	for (int nr = 0; nr < MACH_CALLS_MAX; nr++) {
+		struct summary_row* row = &rows[BSD_CALLS_MAX + nr];
+		row->name = xtrace_mach_call_name(nr);
+		row->kind = "mach";
+		row->nr = nr;
+	}
+
+	for (struct thread_stats* stats = __atomic_load_n(&all_stats, __ATOMIC_ACQUIRE); stats != NULL; stats = stats->next) {
+		for (int nr = 0; nr < BSD_CALLS_MAX; nr++) {
+			sum_stats(&rows[nr].stats, &stats->bsd[nr]);
+		}
+		for (int nr = 0; nr < MACH_CALLS_MAX; nr++) {
+			sum_stats(&rows[BSD_CALLS_MAX + nr].stats, &stats->mach[nr]);
+		}
+	}
+
+	print_table("calls:", rows, rows_cnt, tick_ns);
+	xtrace_free(rows);
+};
+
+static void dump_mig(double tick_ns) {
+	size_t rows_max = 0;
+	size_t rows_cnt = 0;
+	struct summary_row* rows = NULL;
+	uint32_t* keys = NULL;
+
+	for (struct thread_stats* stats = __atomic_load_n(&all_stats, __ATOMIC_ACQUIRE); stats != NULL; stats = stats->next) {
+		for (int slot = 0; slot < MIG_SLOTS; slot++) {
+			uint32_t key = __atomic_load_n(&stats->mig_keys[slot], __ATOMIC_ACQUIRE);
+			size_t index;
+
+			if (key == 0) {
+				continue;
+			}
+
+			for (index = 0; index < rows_cnt; index++) {
+				if (keys[index] == key) {
+					break;
+				}
+			}
+
+			if (index == rows_cnt) {
+				if (rows_cnt == rows_max) {
+					rows_max = rows_max ? rows_max * 2 : 64;
+					rows = (struct summary_row*)xtrace_realloc(rows, rows_max * sizeof(struct summary_row));
+					keys = (uint32_t*)xtrace_realloc(keys, rows_max * sizeof(uint32_t));
+					if (rows == NULL || keys == NULL) {
+						xtrace_abort("xtrace: failed to allocate summary");
+					}
+				}
+
+				int is_reply;
+				memset(&rows[index], 0, sizeof(rows[index]));
+				keys[index] = key;
+				if (!xtrace_find_mig_routine((mach_msg_id_t)((key - 1) >> 2), (key - 1) & 3, &rows[index].subsystem_name, &rows[index].name, &is_reply)) {
+					rows[index].subsystem_name = "unknown";
+					rows[index].name = "unknown";
+				}
+				++rows_cnt;
+			}
+
+			sum_stats(&rows[index].stats, &stats->mig[slot]);
+		}
+	}
+
+	if (rows_cnt > 0) {
+		print_table("MIG routines (time spent in mach_msg, by request message):", rows, rows_cnt, tick_ns);
+	}
+
+	xtrace_free(rows);
+	xtrace_free(keys);
+};
+
+static void summary_dump(struct thread_stats* self) {
+	if (self != NULL) {
+		self->dumping = true;
+	}
+
+	xtrace_lock_lock(&dump_lock);
+
+	double tick_ns = ns_per_tick();
+
+	xtrace_error("\nxtrace: summary for process %d\n\n", summary_pid);
+	dump_calls(tick_ns);
+	dump_mig(tick_ns);
+
+	xtrace_lock_unlock(&dump_lock);
+
+	if (self != NULL) {
+		self->dumping = false;
+	}
+};
+
+static void summary_signal_handler(int signum) {
+	// nothing here is async-signal-safe, so leave the dump to the next call that returns
+	__atomic_store_n(&dump_requested, 1, __ATOMIC_RELAXED);
+};
+
+XTRACE_INLINE
+void check_dump_requested(struct thread_stats* stats) {
+	if (__builtin_expect(__atomic_load_n(&dump_requested, __ATOMIC_RELAXED), 0) && __atomic_exchange_n(&dump_requested, 0, __ATOMIC_ACQ_REL)) {
+		summary_dump(stats);
+	}
+};
+
+//
+// hooks
+//
+
+extern "C"
+void xtrace_summary_mach_entry(int nr, void* args[]) {
+	struct thread_stats* stats = current_stats();
+	if (stats == NULL)
+		return;
+
+	struct frame* frame = push_frame(stats, nr, true);
+	if (frame == NULL || (nr != 31 && nr != 32))
+		return;
+
+	// mach_msg_trap or mach_msg_overwrite_trap
+	const mach_msg_header_t* message = (const mach_msg_header_t*)args[0];
+	mach_msg_option_t options = (mach_msg_option_t)(long)args[1];
+
+	if ((options & MACH_SEND_MSG) && message != NULL) {
+		frame->mig_key = mig_key(message->msgh_id, xtrace_mig_port_kind(message->msgh_remote_port));
+	} else if (options & MACH_RCV_MSG) {
+		// a server waiting for requests; attribute the time to whatever it receives
+		frame->rcv_msg = (nr == 32 && args[7] != NULL) ? (const mach_msg_header_t*)args[7] : message;
+	}
+};
+
+extern "C"
+void xtrace_summary_mach_exit(uintptr_t retval) {
+	uint64_t now = xtrace_read_timestamp();
+	struct thread_stats* stats = current_stats();
+	if (stats == NULL)
+		return;
+
+	struct frame* frame = pop_frame(stats);
+	if (frame != NULL && frame->nr >= 0 && frame->nr < MACH_CALLS_MAX) {
+		bool failed = xtrace_mach_call_failed(frame->nr, retval);
+		uint32_t key = frame->mig_key;
+
+		stats_add(&stats->mach[frame->nr], now - frame->start, failed);
+
+		if (key == 0 && frame->rcv_msg != NULL && !failed) {
+			key = mig_key(frame->rcv_msg->msgh_id, xtrace_mig_port_kind(MACH_PORT_NULL));
+		}
+
+		if (key != 0) {
+			struct call_stats* call = mig_stats(stats, key);
+			if (call != NULL)
+				stats_add(call, now - frame->start, failed);
+		}
+	}
+
+	check_dump_requested(stats);
+};
+
+extern "C"
+void xtrace_summary_bsd_entry(int nr, void* args[]) {
+	struct thread_stats* stats = current_stats();
+	if (stats == NULL)
+		return;
+
+	// exit() and execve() (usually) don't return, so this is the last chance to print anything for this image
+	if (nr == 1 || nr == 59) {
+		summary_dump(stats);
+	}
+
+	push_frame(stats, nr, false);
+};
+
+extern "C"
+void xtrace_summary_bsd_exit(uintptr_t retval) {
+	uint64_t now = xtrace_read_timestamp();
+	struct thread_stats* stats = current_stats();
+	if (stats == NULL)
+		return;
+
+	struct frame* frame = pop_frame(stats);
+	if (frame != NULL && frame->nr >= 0 && frame->nr < BSD_CALLS_MAX) {
+		intptr_t v = (intptr_t)retval;
+		stats_add(&stats->bsd[frame->nr], now - frame->start, v < 0 && v >= -4095);
+	}
+
+	check_dump_requested(stats);
+};
+
+//
+// setup
+//
+
+extern "C"
+void xtrace_setup_summary(int dump_signal) {
+	// this runs before the syscall tracing is enabled, so we can freely use libSystem and make syscalls
+
+	summary_pid = getpid();
+	mach_timebase_info(&timebase);
+	start_timestamp = xtrace_read_timestamp();
+	start_time = mach_absolute_time();
+
+	if (dump_signal > 0) {
+		struct sigaction action;
+
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = summary_signal_handler;
+		action.sa_flags = SA_RESTART;
+		sigemptyset(&action.sa_mask);
+
+		if (sigaction(dump_signal, &action, NULL) < 0) {
+			xtrace_error("xtrace: failed to install summary signal handler for signal %d\n", dump_signal);
+		}
+	}
+
+	xtrace_summary = 1;
+};
+
+extern "C"
+void xtrace_summary_postfork_child(void) {
+	if (!xtrace_summary) {
+		return;
+	}
+
+	struct thread_stats* self = get_summary_stats();
+
+	// the child only reports what it does itself; everything before the fork belongs to the parent
+	xtrace_lock_init(&dump_lock);
+	summary_pid = sys_thread_selfid();
+
+	for (struct thread_stats* stats = all_stats; stats != NULL; stats = stats->next) {
+		memset(stats->bsd, 0, sizeof(stats->bsd));
+		memset(stats->mach, 0, sizeof(stats->mach));
+		memset(stats->mig, 0, sizeof(stats->mig));
+		memset(stats->mig_keys, 0, sizeof(stats->mig_keys));
+		if (stats != self) {
+			stats->in_use = 0;
+		}
+	}
+};
@@ -0,0 +1,22 @@
+#ifndef XTRACE_SUMMARY
+#define XTRACE_SUMMARY
+
+#include <stdint.h>
+#include "base.h"
+
+XTRACE_DECLARATIONS_C_BEGIN
+
+extern int xtrace_summary;
+
+// `dump_signal` is the signal that requests an intermediate dump (0 for none)
+void xtrace_setup_summary(int dump_signal);
+void xtrace_summary_postfork_child(void);
+
+void xtrace_summary_mach_entry(int nr, void* args[]);
+void xtrace_summary_mach_exit(uintptr_t retval);
+void xtrace_summary_bsd_entry(int nr, void* args[]);
+void xtrace_summary_bsd_exit(uintptr_t retval);
+
+XTRACE_DECLARATIONS_C_END
+
+#endif // XTRACE_SUMMARY
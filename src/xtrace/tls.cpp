@@ -23,6 +23,7 @@
 typedef struct tls_table* tls_table_t;
 struct tls_table {
 	size_t size;
+	xtrace_tls_fast_t fast;
 	void* table[TLS_TABLE_MAX_SIZE][3];
 };
 
@@ -45,19 +46,17 @@ void xtrace_tls_thread_cleanup(void) {
 	for (size_t i = 0; i < table->size; ++i) {
 		if (table->table[i][2]) {
 			xtrace_tls_debug("destroying value %p for key %p", table->table[i][1], table->table[i][0]);
-			((xtrace_tls_destructor_f)table->table[i][2])(table->table[1]);
+			((xtrace_tls_destructor_f)table->table[i][2])(table->table[i][1]);
 		}
 		xtrace_tls_debug("freeing value %p for key %p", table->table[i][1], table->table[i][0]);
 		xtrace_free(table->table[i][1]);
 	}
 	xtrace_tls_debug("freeing table %p", table);
 	xtrace_free(table);
+	_pthread_setspecific_direct(__PTK_DARLING_XTRACE_TLS, NULL);
 };
 
-extern "C"
-void* xtrace_tls(void* key, size_t size, bool* created, xtrace_tls_destructor_f destructor) {
-	xtrace_tls_debug("looking up tls variable for key %p", key);
-
+static tls_table_t xtrace_tls_table(void) {
 	tls_table_t table = (tls_table_t)_pthread_getspecific_direct(__PTK_DARLING_XTRACE_TLS);
 
 	xtrace_tls_debug("got %p as table pointer from pthread", table);
@@ -70,9 +69,31 @@ void* xtrace_tls(void* key, size_t size, bool* created, xtrace_tls_destructor_f
 			xtrace_abort("xtrace: failed TLS table memory allocation");
 		}
 		table->size = 0;
+		table->fast.traced_depth = 0;
+		table->fast.mig_loading = 0;
 		_pthread_setspecific_direct(__PTK_DARLING_XTRACE_TLS, table);
 	}
 
+	return table;
+};
+
+extern "C"
+xtrace_tls_fast_t* xtrace_tls_fast(void) {
+	return &xtrace_tls_table()->fast;
+};
+
+extern "C"
+xtrace_tls_fast_t* xtrace_tls_fast_if_present(void) {
+	tls_table_t table = (tls_table_t)_pthread_getspecific_direct(__PTK_DARLING_XTRACE_TLS);
+	return table ? &table->fast : NULL;
+};
+
+extern "C"
+void* xtrace_tls(void* key, size_t size, bool* created, xtrace_tls_destructor_f destructor) {
+	xtrace_tls_debug("looking up tls variable for key %p", key);
+
+	tls_table_t table = xtrace_tls_table();
+
 	// check if the key is already present
 	for (size_t i = 0; i < table->size; ++i) {
 		if (table->table[i][0] == key) {
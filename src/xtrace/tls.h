@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <mach/port.h>
 #include "base.h"
 
@@ -47,6 +48,21 @@ typedef void (*xtrace_tls_destructor_f)(void* value);
 void* xtrace_tls(void* key, size_t size, bool* created, xtrace_tls_destructor_f destructor);
 void xtrace_tls_thread_cleanup(void);
 
+#define XTRACE_TLS_TRACED_CALLS_MAX 16
+
+// per-thread state that lives at a fixed spot in the TLS table, for paths that can't afford a key lookup
+typedef struct xtrace_tls_fast {
+	// XTRACE_FILTER: tokens of the traced calls that haven't returned yet, innermost last
+	uintptr_t traced_calls[XTRACE_TLS_TRACED_CALLS_MAX];
+	uint32_t traced_depth;
+	// nonzero while this thread is loading a MIG subsystem
+	uint32_t mig_loading;
+} xtrace_tls_fast_t;
+
+xtrace_tls_fast_t* xtrace_tls_fast(void);
+// like xtrace_tls_fast(), but returns NULL instead of creating the table if this thread doesn't have one yet
+xtrace_tls_fast_t* xtrace_tls_fast_if_present(void);
+
 XTRACE_DECLARATIONS_C_END
 
 #endif // _XTRACE_TLS_H_
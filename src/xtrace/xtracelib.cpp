@@ -7,6 +7,9 @@
 #include <darling/emulation/simple.h>
 #include "xtracelib.h"
 #include "mig_trace.h"
+#include "binary_trace.h"
+#include "summary.h"
+#include "filter.h"
 #include "tls.h"
 #include "lock.h"
 #include "memory.h"
@@ -61,6 +64,19 @@ static void xtrace_setup_misc_hooks(void);
 
 static int xtrace_ignore = 1;
 
+static int xtrace_split_entry_and_exit = 0;
+int xtrace_no_color = 0;
+int xtrace_kprintf = 0;
+
+static int xtrace_use_logfile = 0;
+static int xtrace_use_per_thread_logfile = 0;
+static int xtrace_use_binary = 0;
+static int xtrace_use_summary = 0;
+static char xtrace_summary_signal[16] = {0};
+static char xtrace_filter_expression[1024] = {0};
+
+static char xtrace_logfile_base[PATH_MAX] = {0};
+
 // whether to use a sigaltstack guard page below the stack
 // (this should probably be left on)
 #define SIGALTSTACK_GUARD 1
@@ -70,7 +86,21 @@ extern "C"
 void xtrace_setup()
 {
 	xtrace_setup_options();
+
+	const char* decode_path = getenv("XTRACE_DECODE");
+	if (decode_path != NULL && decode_path[0] != '\0') {
+		// `xtrace --decode`: print a binary trace and exit without tracing anything
+		xtrace_setup_mig_tracing();
+		_exit(xtrace_binary_decode(decode_path) ? 0 : 1);
+	}
+
 	xtrace_setup_mig_tracing();
+
+	// this needs the MIG subsystems to resolve `mig:` terms
+	if (xtrace_filter_expression[0] != '\0' && !xtrace_setup_filter(xtrace_filter_expression)) {
+		xtrace_abort("xtrace: invalid XTRACE_FILTER");
+	}
+
 	xtrace_setup_mach();
 	xtrace_setup_bsd();
 	xtrace_setup_misc_hooks();
@@ -104,18 +134,15 @@ void xtrace_setup()
 	// and set the size to allocate for future threads
 	_sigaltstack_set_default_size_for_xtrace(custom_altstack.ss_size);
 
+	if (xtrace_use_binary) {
+		xtrace_setup_binary_tracing(xtrace_logfile_base);
+	} else if (xtrace_use_summary) {
+		xtrace_setup_summary(atoi(xtrace_summary_signal));
+	}
+
 	xtrace_ignore = 0;
 }
 
-static int xtrace_split_entry_and_exit = 0;
-int xtrace_no_color = 0;
-int xtrace_kprintf = 0;
-
-static int xtrace_use_logfile = 0;
-static int xtrace_use_per_thread_logfile = 0;
-
-static char xtrace_logfile_base[PATH_MAX] = {0};
-
 static xtrace_once_t xtrace_common_logfile_once = XTRACE_ONCE_INITIALIZER;
 int xtrace_common_logfile = -1;
 
@@ -139,6 +166,20 @@ static void xtrace_setup_options(void)
 	xtrace_no_color = string_is_truthy(getenv("XTRACE_NO_COLOR"));
 	xtrace_kprintf = string_is_truthy(getenv("XTRACE_KPRINTF"));
 	xtrace_use_per_thread_logfile = string_is_truthy(getenv("XTRACE_LOG_FILE_PER_THREAD"));
+	xtrace_use_binary = string_is_truthy(getenv("XTRACE_BINARY"));
+	xtrace_use_summary = string_is_truthy(getenv("XTRACE_SUMMARY"));
+
+	const char* summary_signal = getenv("XTRACE_SUMMARY_SIGNAL");
+	if (summary_signal != NULL) {
+		strlcpy(xtrace_summary_signal, summary_signal, sizeof(xtrace_summary_signal));
+	}
+
+	const char* filter_expression = getenv("XTRACE_FILTER");
+	if (filter_expression != NULL) {
+		if (strlcpy(xtrace_filter_expression, filter_expression, sizeof(xtrace_filter_expression)) >= sizeof(xtrace_filter_expression)) {
+			xtrace_abort("xtrace: XTRACE_FILTER is too long");
+		}
+	}
 
 	if (xtrace_log_file != NULL && xtrace_log_file[0] != '\0') {
 		xtrace_use_logfile = 1;
@@ -551,6 +592,10 @@ static void xtrace_execve_inject_hook(const char*** envp_ptr) {
 	envp_set(envp_ptr, "XTRACE_KPRINTF",              xtrace_kprintf                ? "1" : "0", &allocated);
 	envp_set(envp_ptr, "XTRACE_LOG_FILE_PER_THREAD",  xtrace_use_per_thread_logfile ? "1" : "0", &allocated);
 	envp_set(envp_ptr, "XTRACE_LOG_FILE",             xtrace_use_logfile            ? xtrace_logfile_base : "", &allocated);
+	envp_set(envp_ptr, "XTRACE_BINARY",               xtrace_use_binary             ? "1" : "0", &allocated);
+	envp_set(envp_ptr, "XTRACE_SUMMARY",              xtrace_use_summary            ? "1" : "0", &allocated);
+	envp_set(envp_ptr, "XTRACE_SUMMARY_SIGNAL",       xtrace_summary_signal,                     &allocated);
+	envp_set(envp_ptr, "XTRACE_FILTER",               xtrace_filter_expression,                  &allocated);
 
 	const char* insert_libraries = envp_get(*envp_ptr, "DYLD_INSERT_LIBRARIES");
 	size_t insert_libraries_length = insert_libraries ? strlen(insert_libraries) : 0;
@@ -584,4 +629,8 @@ static void xtrace_postfork_child_hook(void) {
 		}
 		set_xtrace_per_thread_logfile(-1);
 	}
+
+	xtrace_mig_postfork_child();
+	xtrace_binary_postfork_child();
+	xtrace_summary_postfork_child();
 };
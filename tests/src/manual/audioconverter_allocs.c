@@ -0,0 +1,186 @@
+// CFLAGS: -O2 -framework audiotoolbox -framework coreaudio
+// Converts minutes of audio through AudioConverters that go through libavcodec (a float
+// encoder with a sample rate change, and a decoder) and counts the heap allocations made
+// once the converters are warmed up. A realtime-safe fillComplex() makes none of its own.
+// Usage: audioconverter_allocs [minutes]
+#include <AudioToolbox/AudioConverter.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// libmalloc calls this for every allocation and deallocation while it is set
+typedef void (malloc_logger_t)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t num_hot_frames_to_skip);
+extern malloc_logger_t* malloc_logger;
+
+#define MALLOC_LOG_TYPE_ALLOCATE 2
+
+#define INPUT_FRAMES 4096
+#define OUTPUT_PACKETS 1024
+
+static atomic_long allocations;
+
+static void count_allocations(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t skip)
+{
+	(void) arg1;
+	(void) arg2;
+	(void) arg3;
+	(void) result;
+	(void) skip;
+
+	if (type & MALLOC_LOG_TYPE_ALLOCATE)
+		atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+}
+
+struct source
+{
+	void* data;
+	UInt32 bytes_per_frame;
+	UInt32 channels;
+};
+
+static OSStatus input_proc(AudioConverterRef converter, UInt32* ioNumberDataPackets, AudioBufferList* ioData,
+	AudioStreamPacketDescription** outDataPacketDescription, void* inUserData)
+{
+	const struct source* src = (const struct source*) inUserData;
+
+	(void) converter;
+	if (outDataPacketDescription)
+		*outDataPacketDescription = NULL;
+
+	// the same block over and over, there's no end of input
+	if (*ioNumberDataPackets > INPUT_FRAMES)
+		*ioNumberDataPackets = INPUT_FRAMES;
+
+	ioData->mNumberBuffers = 1;
+	ioData->mBuffers[0].mNumberChannels = src->channels;
+	ioData->mBuffers[0].mDataByteSize = *ioNumberDataPackets * src->bytes_per_frame;
+	ioData->mBuffers[0].mData = src->data;
+	return noErr;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void run(const char* name, const AudioStreamBasicDescription* in, const AudioStreamBasicDescription* out,
+	struct source* src, double seconds)
+{
+	AudioConverterRef converter;
+	OSStatus status = AudioConverterNew(in, out, &converter);
+
+	if (status != noErr)
+	{
+		printf("%-28s AudioConverterNew failed: %d\n", name, (int) status);
+		return;
+	}
+
+	const UInt32 out_bytes = OUTPUT_PACKETS * (out->mBytesPerPacket ? out->mBytesPerPacket : 4096);
+	void* out_data = malloc(out_bytes);
+	const long total_packets = (long) (seconds * out->mSampleRate);
+	long packets = 0, calls = 0, steady_allocations = 0;
+	double elapsed = 0;
+
+	// the first second of audio warms the converter up
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const long target = pass ? total_packets : (long) out->mSampleRate;
+		long done = 0;
+
+		atomic_store(&allocations, 0);
+		malloc_logger = pass ? count_allocations : NULL;
+		const double start = now();
+
+		while (done < target)
+		{
+			AudioBufferList list;
+			UInt32 n = OUTPUT_PACKETS;
+
+			list.mNumberBuffers = 1;
+			list.mBuffers[0].mNumberChannels = out->mChannelsPerFrame;
+			list.mBuffers[0].mDataByteSize = out_bytes;
+			list.mBuffers[0].mData = out_data;
+
+			status = AudioConverterFillComplexBuffer(converter, input_proc, src, &n, &list, NULL);
+			if (status != noErr || n == 0)
+				break;
+			done += n;
+			if (pass)
+				calls++;
+		}
+
+		elapsed = now() - start;
+		malloc_logger = NULL;
+		if (pass)
+		{
+			packets = done;
+			steady_allocations = atomic_load(&allocations);
+		}
+	}
+
+	printf("%-28s %7.1f s of audio in %6.2f s (%6.0fx realtime), %ld allocations in %ld calls (%.3f per call)%s\n",
+		name, packets / out->mSampleRate, elapsed, packets / out->mSampleRate / elapsed,
+		steady_allocations, calls, calls ? (double) steady_allocations / calls : 0.0,
+		status != noErr ? "  FAILED" : "");
+
+	AudioConverterDispose(converter);
+	free(out_data);
+}
+
+int main(int argc, const char** argv)
+{
+	const double seconds = ((argc > 1) ? atof(argv[1]) : 5) * 60;
+
+	const AudioStreamBasicDescription float_stereo = {
+		.mSampleRate = 44100,
+		.mFormatID = kAudioFormatLinearPCM,
+		.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked,
+		.mBytesPerPacket = 8,
+		.mFramesPerPacket = 1,
+		.mBytesPerFrame = 8,
+		.mChannelsPerFrame = 2,
+		.mBitsPerChannel = 32,
+	};
+	const AudioStreamBasicDescription int16_stereo = {
+		.mSampleRate = 44100,
+		.mFormatID = kAudioFormatLinearPCM,
+		.mFormatFlags = kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+		.mBytesPerPacket = 4,
+		.mFramesPerPacket = 1,
+		.mBytesPerFrame = 4,
+		.mChannelsPerFrame = 2,
+		.mBitsPerChannel = 16,
+	};
+	const AudioStreamBasicDescription ulaw_mono = {
+		.mSampleRate = 8000,
+		.mFormatID = kAudioFormatULaw,
+		.mBytesPerPacket = 1,
+		.mFramesPerPacket = 1,
+		.mBytesPerFrame = 1,
+		.mChannelsPerFrame = 1,
+		.mBitsPerChannel = 8,
+	};
+
+	float* sine = malloc(INPUT_FRAMES * 2 * sizeof(float));
+	uint8_t* ulaw = malloc(INPUT_FRAMES);
+	for (int i = 0; i < INPUT_FRAMES; i++)
+	{
+		sine[2 * i] = sine[2 * i + 1] = 0.5f * sinf(2 * (float) M_PI * 440 * i / 44100);
+		ulaw[i] = (uint8_t) (0x80 | (i & 0x7f));
+	}
+
+	struct source float_source = { sine, 8, 2 };
+	struct source ulaw_source = { ulaw, 1, 1 };
+
+	run("float 44.1k -> u-law 8k", &float_stereo, &ulaw_mono, &float_source, seconds);
+	run("u-law 8k -> int16 44.1k", &ulaw_mono, &int16_stereo, &ulaw_source, seconds);
+
+	free(sine);
+	free(ulaw);
+	return 0;
+}
@@ -0,0 +1,163 @@
+// CFLAGS: -O2 -framework audiotoolbox -framework coreaudio -framework corefoundation
+// Plays int16 44.1 kHz audio through an AudioQueue rendered offline as float32 48 kHz, so no
+// sound server is needed. Reports the CPU time spent per second of audio and the round trip of
+// a buffer from AudioQueueEnqueueBuffer() to its output callback.
+// Usage: audioqueue_offline_bench [seconds of audio] [frames per render call]
+#include <AudioToolbox/AudioQueue.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sys/resource.h>
+
+#define BUFFERS 3
+#define BUFFER_FRAMES 4096
+
+struct buffer_info
+{
+	double enqueued;
+};
+
+struct stats
+{
+	long callbacks;
+	double total_round_trip, max_round_trip;
+};
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_time(void)
+{
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+static void enqueue(AudioQueueRef queue, AudioQueueBufferRef buffer)
+{
+	int16_t* samples = (int16_t*) buffer->mAudioData;
+
+	// a sawtooth, the content doesn't matter
+	for (int i = 0; i < BUFFER_FRAMES * 2; i++)
+		samples[i] = (int16_t) (i * 64);
+	buffer->mAudioDataByteSize = BUFFER_FRAMES * 4;
+
+	((struct buffer_info*) buffer->mUserData)->enqueued = now();
+	AudioQueueEnqueueBuffer(queue, buffer, 0, NULL);
+}
+
+static void output_callback(void* inUserData, AudioQueueRef inAQ, AudioQueueBufferRef inBuffer)
+{
+	struct stats* stats = (struct stats*) inUserData;
+	const double round_trip = now() - ((struct buffer_info*) inBuffer->mUserData)->enqueued;
+
+	stats->callbacks++;
+	stats->total_round_trip += round_trip;
+	if (round_trip > stats->max_round_trip)
+		stats->max_round_trip = round_trip;
+
+	enqueue(inAQ, inBuffer);
+}
+
+int main(int argc, const char** argv)
+{
+	const double seconds = (argc > 1) ? atof(argv[1]) : 600;
+	const UInt32 render_frames = (argc > 2) ? (UInt32) atoi(argv[2]) : 512;
+
+	AudioStreamBasicDescription source, render;
+
+	memset(&source, 0, sizeof(source));
+	source.mSampleRate = 44100;
+	source.mFormatID = kAudioFormatLinearPCM;
+	source.mFormatFlags = kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked;
+	source.mBytesPerPacket = 4;
+	source.mFramesPerPacket = 1;
+	source.mBytesPerFrame = 4;
+	source.mChannelsPerFrame = 2;
+	source.mBitsPerChannel = 16;
+
+	render = source;
+	render.mSampleRate = 48000;
+	render.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
+	render.mBytesPerPacket = 8;
+	render.mBytesPerFrame = 8;
+	render.mBitsPerChannel = 32;
+
+	AudioChannelLayout layout;
+	struct stats stats;
+	struct buffer_info infos[BUFFERS];
+	AudioQueueRef queue;
+	AudioQueueBufferRef render_buffer;
+	OSStatus status;
+
+	memset(&layout, 0, sizeof(layout));
+	layout.mChannelLayoutTag = kAudioChannelLayoutTag_Stereo;
+	memset(&stats, 0, sizeof(stats));
+
+	status = AudioQueueNewOutput(&source, output_callback, &stats, NULL, NULL, 0, &queue);
+	if (status != noErr)
+	{
+		fprintf(stderr, "AudioQueueNewOutput failed: %d\n", (int) status);
+		return 1;
+	}
+
+	status = AudioQueueSetOfflineRenderFormat(queue, &render, &layout);
+	if (status != noErr)
+	{
+		fprintf(stderr, "AudioQueueSetOfflineRenderFormat failed: %d\n", (int) status);
+		return 1;
+	}
+
+	for (int i = 0; i < BUFFERS; i++)
+	{
+		AudioQueueBufferRef buffer;
+		AudioQueueAllocateBuffer(queue, BUFFER_FRAMES * source.mBytesPerFrame, &buffer);
+		buffer->mUserData = &infos[i];
+		enqueue(queue, buffer);
+	}
+	AudioQueueAllocateBuffer(queue, render_frames * render.mBytesPerFrame, &render_buffer);
+
+	status = AudioQueueStart(queue, NULL);
+	if (status != noErr)
+	{
+		fprintf(stderr, "AudioQueueStart failed: %d\n", (int) status);
+		return 1;
+	}
+
+	AudioTimeStamp ts;
+	memset(&ts, 0, sizeof(ts));
+	ts.mFlags = kAudioTimeStampSampleTimeValid;
+
+	const double start = now(), start_cpu = cpu_time();
+	const double total_frames = seconds * render.mSampleRate;
+	double silent_frames = 0;
+
+	while (ts.mSampleTime < total_frames)
+	{
+		status = AudioQueueOfflineRender(queue, &ts, render_buffer, render_frames);
+		if (status != noErr)
+			break;
+
+		const UInt32 frames = render_buffer->mAudioDataByteSize / render.mBytesPerFrame;
+		silent_frames += render_frames - frames;
+		ts.mSampleTime += render_frames;
+	}
+
+	const double elapsed = now() - start, cpu = cpu_time() - start_cpu;
+	const double rendered = ts.mSampleTime / render.mSampleRate;
+
+	printf("%.0f s of audio rendered in %.2f s (%.0fx realtime)%s\n", rendered, elapsed, rendered / elapsed,
+		status != noErr ? ", AudioQueueOfflineRender FAILED" : "");
+	printf("CPU: %.3f ms per second of audio\n", rendered ? cpu / rendered * 1e3 : 0.0);
+	printf("%ld buffers returned, round trip %.1f us average, %.1f us worst, %.0f frames short\n", stats.callbacks,
+		stats.callbacks ? stats.total_round_trip / stats.callbacks * 1e6 : 0.0, stats.max_round_trip * 1e6, silent_frames);
+
+	AudioQueueStop(queue, true);
+	AudioQueueDispose(queue, true);
+	return 0;
+}
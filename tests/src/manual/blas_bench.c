@@ -0,0 +1,142 @@
+// CFLAGS: -O2 -framework accelerate
+// GFLOP/s of cblas_sgemm and cblas_dgemm on square matrices and on the skinny shapes that
+// blocked kernels tend to handle badly, each result checked against a plain triple loop.
+// VECLIB_MAXIMUM_THREADS limits the number of threads as usual.
+// Usage: blas_bench [largest square size]
+#include <Accelerate/Accelerate.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void gemm(int dbl, enum CBLAS_TRANSPOSE ta, enum CBLAS_TRANSPOSE tb, int m, int n, int k,
+	const void* a, int lda, const void* b, int ldb, void* c, int ldc)
+{
+	if (dbl)
+		cblas_dgemm(CblasColMajor, ta, tb, m, n, k, 1.0, a, lda, b, ldb, 0.0, c, ldc);
+	else
+		cblas_sgemm(CblasColMajor, ta, tb, m, n, k, 1.0f, a, lda, b, ldb, 0.0f, c, ldc);
+}
+
+static double get(int dbl, const void* p, size_t i)
+{
+	return dbl ? ((const double*) p)[i] : ((const float*) p)[i];
+}
+
+// The largest error relative to sum |a| |b| over the entry, which is what the rounding error
+// of any summation order is bounded by. Big products are checked on a subset of the rows.
+static double check(int dbl, int ta, int tb, int m, int n, int k, const void* a, int lda, const void* b, int ldb,
+	const void* c)
+{
+	const int step = ((double) m * n * k > (1 << 27)) ? (m + 31) / 32 : 1;
+	double worst = 0;
+
+	for (int i = 0; i < m; i += step)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			long double sum = 0, scale = 0;
+
+			for (int l = 0; l < k; l++)
+			{
+				const double x = get(dbl, a, ta ? (size_t) i * lda + l : (size_t) l * lda + i);
+				const double y = get(dbl, b, tb ? (size_t) l * ldb + j : (size_t) j * ldb + l);
+				sum += (long double) x * y;
+				scale += fabs(x * y);
+			}
+
+			const double err = fabs(get(dbl, c, (size_t) j * m + i) - (double) sum) / (double) scale;
+			if (err > worst)
+				worst = err;
+		}
+	}
+	return worst;
+}
+
+static void run(int dbl, int ta, int tb, int m, int n, int k)
+{
+	const size_t size = dbl ? sizeof(double) : sizeof(float);
+	const int lda = ta ? k : m, ldb = tb ? n : k;
+	void* a = malloc((size_t) m * k * size);
+	void* b = malloc((size_t) k * n * size);
+	void* c = malloc((size_t) m * n * size);
+	const enum CBLAS_TRANSPOSE cta = ta ? CblasTrans : CblasNoTrans, ctb = tb ? CblasTrans : CblasNoTrans;
+	const double flops = 2.0 * m * n * k;
+	double best = 0, elapsed = 0;
+
+	for (size_t i = 0; i < (size_t) m * k; i++)
+	{
+		const double v = rand() / (double) RAND_MAX - 0.5;
+		if (dbl)
+			((double*) a)[i] = v;
+		else
+			((float*) a)[i] = (float) v;
+	}
+	for (size_t i = 0; i < (size_t) k * n; i++)
+	{
+		const double v = rand() / (double) RAND_MAX - 0.5;
+		if (dbl)
+			((double*) b)[i] = v;
+		else
+			((float*) b)[i] = (float) v;
+	}
+
+	// one call to warm up, then the best of the calls made in at least half a second
+	gemm(dbl, cta, ctb, m, n, k, a, lda, b, ldb, c, m);
+	for (int reps = 0; reps < 3 || elapsed < 0.5; reps++)
+	{
+		const double start = now();
+		gemm(dbl, cta, ctb, m, n, k, a, lda, b, ldb, c, m);
+		const double t = now() - start;
+
+		elapsed += t;
+		if (best == 0 || t < best)
+			best = t;
+	}
+
+	// a generous multiple of the worst case bound for a dot product of length k
+	const double err = check(dbl, ta, tb, m, n, k, a, lda, b, ldb, c);
+	const double limit = 2.0 * k * (dbl ? DBL_EPSILON : FLT_EPSILON);
+
+	printf("%cgemm %c%c %5d x %5d x %5d  %8.2f GFLOP/s  %9.3f ms  error %.2e%s\n", dbl ? 'd' : 's',
+		ta ? 'T' : 'N', tb ? 'T' : 'N', m, n, k, flops / best / 1e9, best * 1e3, err, err > limit ? "  FAILED" : "");
+
+	free(a);
+	free(b);
+	free(c);
+}
+
+int main(int argc, const char** argv)
+{
+	const int largest = (argc > 1) ? atoi(argv[1]) : 2048;
+
+	srand(1);
+	for (int dbl = 0; dbl < 2; dbl++)
+	{
+		for (int size = 64; size <= largest; size *= 2)
+			run(dbl, 0, 0, size, size, size);
+
+		// odd sizes, so that the edges of the blocks get used
+		run(dbl, 0, 0, 1000, 1000, 1000);
+		run(dbl, 1, 0, 1000, 1000, 1000);
+		run(dbl, 0, 1, 1000, 1000, 1000);
+		run(dbl, 1, 1, 1000, 1000, 1000);
+
+		// tall and skinny, short and wide, a rank-k update and an inner product shaped one
+		run(dbl, 0, 0, 4096, 16, 4096);
+		run(dbl, 0, 0, 16, 4096, 4096);
+		run(dbl, 0, 0, 4096, 4096, 16);
+		run(dbl, 1, 0, 64, 64, 65536);
+		run(dbl, 0, 0, 100000, 4, 4);
+	}
+
+	return 0;
+}
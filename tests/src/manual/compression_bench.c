@@ -0,0 +1,213 @@
+// CFLAGS: -O2 -lcompression -lz
+// Round-trips a buffer through every libcompression algorithm, in one call and as a stream,
+// and prints the encode/decode throughput next to the host's zlib.
+// Usage: compression_bench [file], a 4 MB synthetic text is used without a file.
+#include <compression.h>
+#include <zlib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define ROUNDS 3
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint8_t* load(const char* path, size_t* size)
+{
+	if (path)
+	{
+		FILE* f = fopen(path, "rb");
+		if (!f)
+		{
+			perror(path);
+			exit(1);
+		}
+		fseek(f, 0, SEEK_END);
+		*size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+
+		uint8_t* data = malloc(*size);
+		if (fread(data, 1, *size, f) != *size)
+		{
+			perror(path);
+			exit(1);
+		}
+		fclose(f);
+		return data;
+	}
+
+	// words picked at random from a small vocabulary compress roughly like text
+	static const char* words[] = { "the ", "darling ", "compression ", "buffer ", "of ", "stream ",
+		"and ", "block ", "window ", "match ", "literal ", "\n", "a ", "to ", "scratch ", "0x1f ", };
+	uint8_t* data = malloc(4 << 20);
+	size_t pos = 0;
+
+	srand(1);
+	while (pos < (4 << 20) - 16)
+	{
+		const char* w = words[rand() % (sizeof(words) / sizeof(words[0]))];
+		memcpy(data + pos, w, strlen(w));
+		pos += strlen(w);
+	}
+
+	*size = pos;
+	return data;
+}
+
+// Runs the whole input through a stream, handing it over in_chunk bytes at a time
+// and taking the output in 32 kB windows. Returns the status of the last call.
+static compression_status stream_run(compression_stream_operation op, compression_algorithm algo,
+	const uint8_t* in, size_t in_size, size_t in_chunk, uint8_t* out, size_t out_cap, size_t* out_size)
+{
+	compression_stream s;
+	compression_status st;
+	size_t fed = 0;
+
+	*out_size = 0;
+	if (compression_stream_init(&s, op, algo) != COMPRESSION_STATUS_OK)
+		return COMPRESSION_STATUS_ERROR;
+
+	s.src_ptr = in;
+	s.src_size = 0;
+	do
+	{
+		const size_t more = (in_size - fed < in_chunk) ? in_size - fed : in_chunk;
+		s.src_size += more;
+		fed += more;
+		s.dst_ptr = out + *out_size;
+		s.dst_size = (out_cap - *out_size < 32768) ? out_cap - *out_size : 32768;
+
+		const size_t src_before = s.src_size, dst_before = s.dst_size;
+		st = compression_stream_process(&s, (op == COMPRESSION_STREAM_ENCODE && fed == in_size) ? COMPRESSION_STREAM_FINALIZE : 0);
+		*out_size += dst_before - s.dst_size;
+
+		// no input left to give and no progress made
+		if (st == COMPRESSION_STATUS_OK && more == 0 && src_before == s.src_size && dst_before == s.dst_size)
+			st = COMPRESSION_STATUS_ERROR;
+	}
+	while (st == COMPRESSION_STATUS_OK);
+
+	compression_stream_destroy(&s);
+	return st;
+}
+
+static int stream_roundtrip(compression_algorithm algo, const uint8_t* src, size_t size, uint8_t* enc, size_t enc_cap, uint8_t* dec)
+{
+	size_t enc_size, dec_size;
+
+	if (stream_run(COMPRESSION_STREAM_ENCODE, algo, src, size, 65536, enc, enc_cap, &enc_size) != COMPRESSION_STATUS_END)
+		return 0;
+	if (stream_run(COMPRESSION_STREAM_DECODE, algo, enc, enc_size, 4096, dec, size, &dec_size) != COMPRESSION_STATUS_END)
+		return 0;
+
+	return dec_size == size && memcmp(src, dec, size) == 0;
+}
+
+static void report(const char* name, size_t size, size_t enc_size, double t_enc, double t_dec, int ok, int stream_ok)
+{
+	printf("%-10s ratio %6.3f  encode %8.1f MB/s  decode %8.1f MB/s  buffer %s  stream %s\n", name,
+		(double) enc_size / size, size / t_enc / 1e6, size / t_dec / 1e6,
+		ok ? "ok" : "MISMATCH", stream_ok < 0 ? "-" : stream_ok ? "ok" : "MISMATCH");
+}
+
+int main(int argc, const char** argv)
+{
+	static const struct { compression_algorithm algo; const char* name; } algos[] = {
+		{ COMPRESSION_LZ4, "lz4" },
+		{ COMPRESSION_LZ4_RAW, "lz4_raw" },
+		{ COMPRESSION_ZLIB, "zlib" },
+		{ COMPRESSION_LZMA, "lzma" },
+		{ COMPRESSION_LZFSE, "lzfse" },
+	};
+	size_t size;
+	uint8_t* src = load(argc > 1 ? argv[1] : NULL, &size);
+	const size_t cap = size + size / 8 + 4096;
+	uint8_t* enc = malloc(cap);
+	uint8_t* dec = malloc(size);
+
+	printf("%zu bytes, best of %d rounds\n", size, ROUNDS);
+
+	for (size_t i = 0; i < sizeof(algos) / sizeof(algos[0]); i++)
+	{
+		void* enc_scratch = malloc(compression_encode_scratch_buffer_size(algos[i].algo));
+		void* dec_scratch = malloc(compression_decode_scratch_buffer_size(algos[i].algo));
+		double t_enc = 1e9, t_dec = 1e9;
+		size_t enc_size = 0, dec_size = 0;
+
+		for (int r = 0; r < ROUNDS; r++)
+		{
+			double t = now();
+			enc_size = compression_encode_buffer(enc, cap, src, size, enc_scratch, algos[i].algo);
+			t = now() - t;
+			if (t < t_enc)
+				t_enc = t;
+
+			memset(dec, 0, size);
+			t = now();
+			dec_size = compression_decode_buffer(dec, size, enc, enc_size, dec_scratch, algos[i].algo);
+			t = now() - t;
+			if (t < t_dec)
+				t_dec = t;
+		}
+
+		const int ok = enc_size != 0 && dec_size == size && memcmp(src, dec, size) == 0;
+		const int stream_ok = (algos[i].algo == COMPRESSION_LZ4_RAW) ? -1 : stream_roundtrip(algos[i].algo, src, size, enc, cap, dec);
+		report(algos[i].name, size, enc_size, t_enc, t_dec, ok, stream_ok);
+
+		free(enc_scratch);
+		free(dec_scratch);
+	}
+
+	// the host's zlib producing the same raw deflate stream as COMPRESSION_ZLIB
+	{
+		double t_enc = 1e9, t_dec = 1e9;
+		size_t enc_size = 0;
+		int ok = 0;
+
+		for (int r = 0; r < ROUNDS; r++)
+		{
+			z_stream z;
+			memset(&z, 0, sizeof(z));
+
+			double t = now();
+			deflateInit2(&z, 5, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+			z.next_in = src;
+			z.avail_in = size;
+			z.next_out = enc;
+			z.avail_out = cap;
+			deflate(&z, Z_FINISH);
+			enc_size = z.total_out;
+			deflateEnd(&z);
+			t = now() - t;
+			if (t < t_enc)
+				t_enc = t;
+
+			memset(&z, 0, sizeof(z));
+			t = now();
+			inflateInit2(&z, -15);
+			z.next_in = enc;
+			z.avail_in = enc_size;
+			z.next_out = dec;
+			z.avail_out = size;
+			ok = inflate(&z, Z_FINISH) == Z_STREAM_END && z.total_out == size;
+			inflateEnd(&z);
+			t = now() - t;
+			if (t < t_dec)
+				t_dec = t;
+		}
+
+		report("host zlib", size, enc_size, t_enc, t_dec, ok && memcmp(src, dec, size) == 0, -1);
+	}
+
+	free(src);
+	free(enc);
+	free(dec);
+	return 0;
+}
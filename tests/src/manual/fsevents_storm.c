@@ -0,0 +1,132 @@
+// CFLAGS: -O2 -framework coreservices -framework corefoundation
+// Creates a tree of files under a watched root as fast as possible, like untarring an archive,
+// and reports how the FSEventStream keeps up: events delivered, callbacks made and how long
+// the last event takes to arrive after the writes are done.
+// Usage: fsevents_storm [directories] [files per directory]
+#include <CoreServices/CoreServices.h>
+#include <dispatch/dispatch.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static atomic_long events, callbacks, files_created;
+static atomic_long last_event_ns;
+
+static long now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000l + ts.tv_nsec;
+}
+
+static void callback(ConstFSEventStreamRef stream, void* info, size_t count, void* paths,
+	const FSEventStreamEventFlags flags[], const FSEventStreamEventId ids[])
+{
+	long created = 0;
+
+	(void) stream;
+	(void) info;
+	(void) paths;
+	(void) ids;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if ((flags[i] & kFSEventStreamEventFlagItemCreated) && (flags[i] & kFSEventStreamEventFlagItemIsFile))
+			created++;
+	}
+
+	atomic_fetch_add(&events, count);
+	atomic_fetch_add(&callbacks, 1);
+	atomic_fetch_add(&files_created, created);
+	atomic_store(&last_event_ns, now_ns());
+}
+
+static int remove_entry(const char* path, const struct stat* st, int type, struct FTW* ftw)
+{
+	(void) st;
+	(void) type;
+	(void) ftw;
+	return remove(path);
+}
+
+int main(int argc, const char** argv)
+{
+	const int dirs = (argc > 1) ? atoi(argv[1]) : 100;
+	const int files = (argc > 2) ? atoi(argv[2]) : 1000;
+	char tmpl[] = "/tmp/fsevents_storm.XXXXXX";
+	char root[PATH_MAX];
+
+	if (!mkdtemp(tmpl) || !realpath(tmpl, root))
+	{
+		perror("mkdtemp");
+		return 1;
+	}
+
+	CFStringRef path = CFStringCreateWithCString(NULL, root, kCFStringEncodingUTF8);
+	CFArrayRef paths = CFArrayCreate(NULL, (const void**) &path, 1, &kCFTypeArrayCallBacks);
+	FSEventStreamRef stream = FSEventStreamCreate(NULL, callback, NULL, paths, kFSEventStreamEventIdSinceNow,
+		0.05, kFSEventStreamCreateFlagFileEvents);
+
+	FSEventStreamSetDispatchQueue(stream, dispatch_queue_create("fsevents_storm", DISPATCH_QUEUE_SERIAL));
+	if (!FSEventStreamStart(stream))
+	{
+		fprintf(stderr, "FSEventStreamStart failed\n");
+		return 1;
+	}
+	usleep(200000);
+
+	const long start = now_ns();
+	for (int d = 0; d < dirs; d++)
+	{
+		char name[PATH_MAX];
+
+		snprintf(name, sizeof(name), "%s/d%d", root, d);
+		mkdir(name, 0755);
+
+		for (int f = 0; f < files; f++)
+		{
+			snprintf(name, sizeof(name), "%s/d%d/f%d", root, d, f);
+			int fd = open(name, O_CREAT | O_WRONLY | O_TRUNC, 0644);
+			if (fd == -1 || write(fd, name, strlen(name)) < 0)
+			{
+				perror(name);
+				return 1;
+			}
+			close(fd);
+		}
+	}
+	const long written = now_ns();
+
+	// until every file has been reported, or nothing has arrived for two seconds
+	while (atomic_load(&files_created) < (long) dirs * files)
+	{
+		const long last = atomic_load(&last_event_ns);
+		if (now_ns() - (last > written ? last : written) > 2000000000l)
+			break;
+		usleep(10000);
+	}
+
+	FSEventStreamStop(stream);
+	FSEventStreamInvalidate(stream);
+	FSEventStreamRelease(stream);
+
+	const long n_events = atomic_load(&events), n_callbacks = atomic_load(&callbacks);
+	const long last = atomic_load(&last_event_ns);
+
+	printf("%d files in %d directories written in %.1f ms\n", dirs * files, dirs, (written - start) / 1e6);
+	printf("%ld of them reported as created, %ld events in %ld callbacks (%.1f per callback)\n",
+		atomic_load(&files_created), n_events, n_callbacks, n_callbacks ? (double) n_events / n_callbacks : 0.0);
+	printf("last event %.1f ms after the writes were done\n", last > written ? (last - written) / 1e6 : 0.0);
+
+	nftw(root, remove_entry, 64, FTW_DEPTH | FTW_PHYS);
+	CFRelease(paths);
+	CFRelease(path);
+	return 0;
+}
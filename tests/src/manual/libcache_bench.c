@@ -0,0 +1,124 @@
+// CFLAGS: -O2 -lcache
+// Hammers one cache from 1, 2, 4... threads with a read-heavy mix of lookups and inserts
+// over more keys than the cache may hold, then prints the throughput and cache_print_stats().
+// Usage: libcache_bench [max threads] [percentage of sets]
+#include <cache/cache.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KEYS 65536
+#define COUNT_HINT 16384
+#define OPS_PER_THREAD 1000000
+
+static cache_t* cache;
+static int set_percent = 10;
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// on its own cache line, so that the counters don't add contention of their own
+struct worker
+{
+	pthread_t thread;
+	uint32_t seed;
+	unsigned long lookups, hits;
+} __attribute__((aligned(64)));
+
+static void* worker(void* arg)
+{
+	struct worker* w = (struct worker*) arg;
+	// xorshift, seeded per thread
+	uint32_t x = w->seed * 2654435761u + 1;
+
+	for (int i = 0; i < OPS_PER_THREAD; i++)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+
+		// a skewed key distribution, low keys are looked up far more often
+		const uintptr_t key = ((x % KEYS) & ((x >> 16) % KEYS)) + 1;
+		void* value;
+
+		if ((int) ((x >> 8) % 100) < set_percent)
+		{
+			value = malloc(64);
+			if (cache_set_and_retain(cache, (void*) key, value, 64) == 0)
+				cache_release_value(cache, value);
+			else
+				free(value);
+		}
+		else
+		{
+			w->lookups++;
+			if (cache_get_and_retain(cache, (void*) key, &value) == 0)
+			{
+				w->hits++;
+				cache_release_value(cache, value);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+int main(int argc, const char** argv)
+{
+	int max_threads = (argc > 1) ? atoi(argv[1]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+	cache_attributes_t attrs = {
+		.version = CACHE_ATTRIBUTES_VERSION_2,
+		.key_hash_cb = cache_key_hash_cb_integer,
+		.key_is_equal_cb = cache_key_is_equal_cb_integer,
+		.value_release_cb = cache_release_cb_free,
+	};
+
+	if (argc > 2)
+		set_percent = atoi(argv[2]);
+
+	printf("%d keys, count hint %d, %d%% sets\n", KEYS, COUNT_HINT, set_percent);
+
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		struct worker workers[threads];
+		unsigned long lookups = 0, hits = 0;
+
+		if (cache_create("bench", &attrs, &cache) != 0)
+		{
+			fprintf(stderr, "cache_create failed\n");
+			return 1;
+		}
+		cache_set_count_hint(cache, COUNT_HINT);
+
+		const double start = now();
+		for (int i = 0; i < threads; i++)
+		{
+			workers[i] = (struct worker) { .seed = i + 1 };
+			pthread_create(&workers[i].thread, NULL, worker, &workers[i]);
+		}
+		for (int i = 0; i < threads; i++)
+		{
+			pthread_join(workers[i].thread, NULL);
+			lookups += workers[i].lookups;
+			hits += workers[i].hits;
+		}
+		const double elapsed = now() - start;
+
+		printf("%3d threads: %8.2f Mops/s, %5.1f%% of lookups hit\n", threads,
+			(double) threads * OPS_PER_THREAD / elapsed / 1e6,
+			lookups ? 100.0 * hits / lookups : 0.0);
+
+		if (threads * 2 > max_threads)
+			cache_print_stats(cache);
+		cache_destroy(cache);
+	}
+
+	return 0;
+}
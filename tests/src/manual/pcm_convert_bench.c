@@ -0,0 +1,176 @@
+// CFLAGS: -O2 -framework audiotoolbox -framework coreaudio
+// Throughput of LinearPCM to LinearPCM conversions through AudioConverter, one line per
+// format change: sample formats, byte order, (de)interleaving, channel counts and sample rates.
+// Usage: pcm_convert_bench [seconds of audio per conversion]
+#include <AudioToolbox/AudioConverter.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BLOCK_FRAMES 4096
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static AudioStreamBasicDescription pcm(Float64 rate, UInt32 channels, UInt32 bits, AudioFormatFlags flags)
+{
+	const UInt32 bytes = ((flags & kAudioFormatFlagIsNonInterleaved) ? 1 : channels) * (bits / 8);
+	AudioStreamBasicDescription desc = {
+		.mSampleRate = rate,
+		.mFormatID = kAudioFormatLinearPCM,
+		.mFormatFlags = flags | kAudioFormatFlagIsPacked,
+		.mBytesPerPacket = bytes,
+		.mFramesPerPacket = 1,
+		.mBytesPerFrame = bytes,
+		.mChannelsPerFrame = channels,
+		.mBitsPerChannel = bits,
+	};
+	return desc;
+}
+
+// A buffer list for BLOCK_FRAMES frames, with one buffer per channel if the format is non-interleaved
+static AudioBufferList* buffer_list(const AudioStreamBasicDescription* desc)
+{
+	const UInt32 buffers = (desc->mFormatFlags & kAudioFormatFlagIsNonInterleaved) ? desc->mChannelsPerFrame : 1;
+	AudioBufferList* list = malloc(offsetof(AudioBufferList, mBuffers) + buffers * sizeof(AudioBuffer));
+
+	list->mNumberBuffers = buffers;
+	for (UInt32 i = 0; i < buffers; i++)
+	{
+		list->mBuffers[i].mNumberChannels = desc->mChannelsPerFrame / buffers;
+		list->mBuffers[i].mDataByteSize = BLOCK_FRAMES * desc->mBytesPerFrame;
+		list->mBuffers[i].mData = calloc(BLOCK_FRAMES, desc->mBytesPerFrame);
+	}
+	return list;
+}
+
+static void free_buffer_list(AudioBufferList* list)
+{
+	for (UInt32 i = 0; i < list->mNumberBuffers; i++)
+		free(list->mBuffers[i].mData);
+	free(list);
+}
+
+struct source
+{
+	const AudioStreamBasicDescription* desc;
+	AudioBufferList* data;
+};
+
+static OSStatus input_proc(AudioConverterRef converter, UInt32* ioNumberDataPackets, AudioBufferList* ioData,
+	AudioStreamPacketDescription** outDataPacketDescription, void* inUserData)
+{
+	const struct source* src = (const struct source*) inUserData;
+
+	(void) converter;
+	(void) outDataPacketDescription;
+
+	// the same block over and over, there's no end of input
+	if (*ioNumberDataPackets > BLOCK_FRAMES)
+		*ioNumberDataPackets = BLOCK_FRAMES;
+
+	ioData->mNumberBuffers = src->data->mNumberBuffers;
+	for (UInt32 i = 0; i < src->data->mNumberBuffers; i++)
+	{
+		ioData->mBuffers[i] = src->data->mBuffers[i];
+		ioData->mBuffers[i].mDataByteSize = *ioNumberDataPackets * src->desc->mBytesPerFrame;
+	}
+	return noErr;
+}
+
+static void run(const char* name, AudioStreamBasicDescription in, AudioStreamBasicDescription out, double seconds)
+{
+	AudioConverterRef converter;
+	OSStatus status = AudioConverterNew(&in, &out, &converter);
+
+	if (status != noErr)
+	{
+		printf("%-34s AudioConverterNew failed: %d\n", name, (int) status);
+		return;
+	}
+
+	AudioBufferList* in_data = buffer_list(&in);
+	AudioBufferList* out_data = buffer_list(&out);
+	struct source src = { &in, in_data };
+	const long target = (long) (seconds * out.mSampleRate);
+	long frames = 0;
+
+	// a deterministic, non-silent input
+	for (UInt32 i = 0; i < in_data->mNumberBuffers; i++)
+	{
+		uint8_t* p = (uint8_t*) in_data->mBuffers[i].mData;
+		for (UInt32 j = 0; j < in_data->mBuffers[i].mDataByteSize; j++)
+			p[j] = (uint8_t) (j * 2654435761u >> 24);
+	}
+	if (in.mFormatFlags & kAudioFormatFlagIsFloat)
+	{
+		// keep floats finite and in range
+		for (UInt32 i = 0; i < in_data->mNumberBuffers; i++)
+		{
+			uint32_t* p = (uint32_t*) in_data->mBuffers[i].mData;
+			for (UInt32 j = 0; j < in_data->mBuffers[i].mDataByteSize / sizeof(float); j++)
+			{
+				const float v = (float) ((j * 37) % 200) / 100.0f - 1.0f;
+				memcpy(&p[j], &v, sizeof(v));
+				if (in.mFormatFlags & kAudioFormatFlagIsBigEndian)
+					p[j] = __builtin_bswap32(p[j]);
+			}
+		}
+	}
+
+	const double start = now();
+	while (frames < target)
+	{
+		UInt32 n = BLOCK_FRAMES;
+
+		for (UInt32 i = 0; i < out_data->mNumberBuffers; i++)
+			out_data->mBuffers[i].mDataByteSize = BLOCK_FRAMES * out.mBytesPerFrame;
+
+		status = AudioConverterFillComplexBuffer(converter, input_proc, &src, &n, out_data, NULL);
+		if (status != noErr || n == 0)
+			break;
+		frames += n;
+	}
+	const double elapsed = now() - start;
+
+	const double samples = (double) frames * out.mChannelsPerFrame;
+	printf("%-34s %8.1f Msamples/s  %8.0fx realtime%s\n", name, samples / elapsed / 1e6,
+		frames / out.mSampleRate / elapsed, status != noErr ? "  FAILED" : "");
+
+	AudioConverterDispose(converter);
+	free_buffer_list(in_data);
+	free_buffer_list(out_data);
+}
+
+int main(int argc, const char** argv)
+{
+	const double seconds = (argc > 1) ? atof(argv[1]) : 600;
+	const AudioFormatFlags f32 = kAudioFormatFlagIsFloat;
+	const AudioFormatFlags s16 = kAudioFormatFlagIsSignedInteger;
+	const AudioFormatFlags be = kAudioFormatFlagIsBigEndian;
+	const AudioFormatFlags ni = kAudioFormatFlagIsNonInterleaved;
+
+	run("int16 -> float32", pcm(44100, 2, 16, s16), pcm(44100, 2, 32, f32), seconds);
+	run("float32 -> int16", pcm(44100, 2, 32, f32), pcm(44100, 2, 16, s16), seconds);
+	run("int24 -> float32", pcm(44100, 2, 24, s16), pcm(44100, 2, 32, f32), seconds);
+	run("int32 -> int16", pcm(44100, 2, 32, s16), pcm(44100, 2, 16, s16), seconds);
+	run("int16 big endian -> int16", pcm(44100, 2, 16, s16 | be), pcm(44100, 2, 16, s16), seconds);
+	run("float32 big endian -> float32", pcm(44100, 2, 32, f32 | be), pcm(44100, 2, 32, f32), seconds);
+	run("float32 interleaved -> planar", pcm(44100, 2, 32, f32), pcm(44100, 2, 32, f32 | ni), seconds);
+	run("float32 planar -> interleaved", pcm(44100, 2, 32, f32 | ni), pcm(44100, 2, 32, f32), seconds);
+	run("int16 planar 6ch -> float32", pcm(48000, 6, 16, s16 | ni), pcm(48000, 6, 32, f32), seconds);
+	run("float32 stereo -> mono", pcm(44100, 2, 32, f32), pcm(44100, 1, 32, f32), seconds);
+	run("int16 mono -> stereo", pcm(44100, 1, 16, s16), pcm(44100, 2, 16, s16), seconds);
+	run("float32 44.1k -> 48k", pcm(44100, 2, 32, f32), pcm(48000, 2, 32, f32), seconds);
+	run("int16 48k -> 44.1k", pcm(48000, 2, 16, s16), pcm(44100, 2, 16, s16), seconds);
+	run("int16 44.1k -> float32 16k mono", pcm(44100, 2, 16, s16), pcm(16000, 1, 32, f32), seconds);
+
+	return 0;
+}
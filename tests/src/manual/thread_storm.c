@@ -0,0 +1,113 @@
+// CFLAGS: -O2
+// Stresses per-thread setup and teardown: several spawners creating and joining threads
+// as fast as they can, then a burst of thousands of threads alive at the same time.
+// Usage: thread_storm [spawners] [threads in the burst]
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHURN_PER_SPAWNER 2000
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int arrived, released;
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* short_lived(void* arg)
+{
+	(void) arg;
+	// a system call, so that the thread's kernel side has to be set up
+	return (void*) (long) getpid();
+}
+
+static void* spawner(void* arg)
+{
+	long failures = 0;
+
+	(void) arg;
+	for (int i = 0; i < CHURN_PER_SPAWNER; i++)
+	{
+		pthread_t t;
+		if (pthread_create(&t, NULL, short_lived, NULL) != 0)
+			failures++;
+		else
+			pthread_join(t, NULL);
+	}
+
+	return (void*) failures;
+}
+
+static void* waiter(void* arg)
+{
+	(void) arg;
+	getpid();
+
+	pthread_mutex_lock(&mutex);
+	arrived++;
+	pthread_cond_broadcast(&cond);
+	while (!released)
+		pthread_cond_wait(&cond, &mutex);
+	pthread_mutex_unlock(&mutex);
+
+	return NULL;
+}
+
+int main(int argc, const char** argv)
+{
+	const int spawners = (argc > 1) ? atoi(argv[1]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+	const int burst = (argc > 2) ? atoi(argv[2]) : 2000;
+	pthread_t* threads = malloc(sizeof(pthread_t) * (spawners > burst ? spawners : burst));
+	long failures = 0;
+	int created = 0;
+
+	double t = now();
+	for (int i = 0; i < spawners; i++)
+		pthread_create(&threads[i], NULL, spawner, NULL);
+	for (int i = 0; i < spawners; i++)
+	{
+		void* f;
+		pthread_join(threads[i], &f);
+		failures += (long) f;
+	}
+	t = now() - t;
+	printf("churn: %d spawners, %.0f threads/s created and joined, %ld failures\n",
+		spawners, spawners * CHURN_PER_SPAWNER / t, failures);
+
+	// small stacks, so that thousands of threads fit
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, 64 * 1024);
+
+	t = now();
+	for (; created < burst; created++)
+	{
+		if (pthread_create(&threads[created], &attr, waiter, NULL) != 0)
+			break;
+	}
+
+	pthread_mutex_lock(&mutex);
+	while (arrived < created)
+		pthread_cond_wait(&cond, &mutex);
+	const double t_up = now() - t;
+	released = 1;
+	pthread_cond_broadcast(&cond);
+	pthread_mutex_unlock(&mutex);
+
+	for (int i = 0; i < created; i++)
+		pthread_join(threads[i], NULL);
+	t = now() - t;
+
+	printf("burst: %d of %d threads alive at once, up in %.1f ms, all joined after %.1f ms\n",
+		created, burst, t_up * 1e3, t * 1e3);
+
+	free(threads);
+	return created == burst && failures == 0 ? 0 : 1;
+}
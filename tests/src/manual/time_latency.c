@@ -0,0 +1,97 @@
+// CFLAGS: -O2
+// Per-call latency of the time functions that read the commpage, next to the gettimeofday
+// system call they used to fall back to. Also checks that the results don't go backwards
+// and that the commpage gettimeofday() agrees with the system call.
+#include <mach/mach_time.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CALLS 5000000
+
+static volatile uint64_t sink;
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint64_t call_mach_absolute_time(void)
+{
+	return mach_absolute_time();
+}
+
+static uint64_t call_mach_continuous_time(void)
+{
+	return mach_continuous_time();
+}
+
+static uint64_t call_gettimeofday(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000ull + tv.tv_usec;
+}
+
+static uint64_t call_clock_gettime(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint64_t call_gettimeofday_syscall(void)
+{
+	struct timeval tv;
+	syscall(SYS_gettimeofday, &tv, NULL, NULL);
+	return tv.tv_sec * 1000000ull + tv.tv_usec;
+}
+
+static void measure(const char* name, uint64_t (*fn)(void), int calls)
+{
+	uint64_t prev = fn(), backwards = 0;
+	const uint64_t start = now_ns();
+
+	for (int i = 0; i < calls; i++)
+	{
+		const uint64_t v = fn();
+		if (v < prev)
+			backwards++;
+		prev = v;
+	}
+
+	const uint64_t elapsed = now_ns() - start;
+	sink = prev;
+	printf("%-26s %8.1f ns/call%s\n", name, (double) elapsed / calls, backwards ? "  WENT BACKWARDS" : "");
+}
+
+int main(void)
+{
+	measure("mach_absolute_time", call_mach_absolute_time, CALLS);
+	measure("mach_continuous_time", call_mach_continuous_time, CALLS);
+	measure("gettimeofday", call_gettimeofday, CALLS);
+	measure("clock_gettime(MONOTONIC)", call_clock_gettime, CALLS);
+	measure("gettimeofday system call", call_gettimeofday_syscall, CALLS / 10);
+
+	// the commpage and the kernel have to agree, to within a scheduling hiccup
+	uint64_t worst = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		const uint64_t a = call_gettimeofday_syscall();
+		const uint64_t b = call_gettimeofday();
+		const uint64_t c = call_gettimeofday_syscall();
+
+		const uint64_t off = (b < a) ? a - b : (b > c) ? b - c : 0;
+		if (off > worst)
+			worst = off;
+		usleep(100);
+	}
+	printf("gettimeofday vs system call: worst offset %llu us\n", (unsigned long long) worst);
+
+	return 0;
+}
@@ -0,0 +1,263 @@
+// CFLAGS: -O2 -framework accelerate
+// Speed and accuracy of the vDSP FFTs at 2^4 ... 2^20 points: complex FFTs in single and double
+// precision, the packed real FFT, the DFT API and DCT-II. Results are compared with a double
+// precision reference, a direct DFT up to 2^12 points and a plain radix-2 FFT above that.
+// Usage: vdsp_fft_bench [min log2n] [max log2n]
+#include <Accelerate/Accelerate.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DIRECT_MAX_LOG2N 12
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Forward transform X[k] = sum x[j] * e^(-2 pi i j k / n) in double precision
+static void reference_dft(const double* xr, const double* xi, double* yr, double* yi, int log2n)
+{
+	const size_t n = (size_t) 1 << log2n;
+
+	if (log2n <= DIRECT_MAX_LOG2N)
+	{
+		for (size_t k = 0; k < n; k++)
+		{
+			long double sr = 0, si = 0;
+			for (size_t j = 0; j < n; j++)
+			{
+				// j * k mod n keeps the angle exact
+				const long double a = -2 * M_PI * (long double) ((j * k) & (n - 1)) / n;
+				sr += xr[j] * cosl(a) - xi[j] * sinl(a);
+				si += xr[j] * sinl(a) + xi[j] * cosl(a);
+			}
+			yr[k] = (double) sr;
+			yi[k] = (double) si;
+		}
+		return;
+	}
+
+	// bit-reversed copy, then iterative radix-2 butterflies with directly computed twiddles
+	for (size_t i = 0; i < n; i++)
+	{
+		size_t r = 0;
+		for (int b = 0; b < log2n; b++)
+			r |= ((i >> b) & 1) << (log2n - 1 - b);
+		yr[r] = xr[i];
+		yi[r] = xi[i];
+	}
+
+	for (size_t len = 2; len <= n; len <<= 1)
+	{
+		for (size_t j = 0; j < len / 2; j++)
+		{
+			const double wr = cos(-2 * M_PI * j / len), wi = sin(-2 * M_PI * j / len);
+			for (size_t i = 0; i < n; i += len)
+			{
+				double* ar = &yr[i + j], * ai = &yi[i + j];
+				double* br = &yr[i + j + len / 2], * bi = &yi[i + j + len / 2];
+				const double tr = *br * wr - *bi * wi, ti = *br * wi + *bi * wr;
+
+				*br = *ar - tr;
+				*bi = *ai - ti;
+				*ar += tr;
+				*ai += ti;
+			}
+		}
+	}
+}
+
+struct error
+{
+	double sum_sq_err, sum_sq_ref, max_err, max_ref;
+};
+
+static void accumulate(struct error* e, double got, double want)
+{
+	const double d = fabs(got - want);
+
+	e->sum_sq_err += d * d;
+	e->sum_sq_ref += want * want;
+	if (d > e->max_err)
+		e->max_err = d;
+	if (fabs(want) > e->max_ref)
+		e->max_ref = fabs(want);
+}
+
+// MFLOPS is the usual 5 n log2 n for a complex transform, half that for a real one. The errors
+// are the relative RMS error, and the largest error relative to the largest value.
+static void report(const char* name, int log2n, int real, double seconds, int reps, const struct error* e)
+{
+	const double n = (double) ((size_t) 1 << log2n);
+
+	printf("%-12s 2^%-2d %10.2f us %9.0f MFLOPS   rms %.2e  max %.2e\n", name, log2n, seconds / reps * 1e6,
+		(real ? 2.5 : 5) * n * log2n / (seconds / reps) / 1e6, sqrt(e->sum_sq_err / e->sum_sq_ref), e->max_err / e->max_ref);
+}
+
+// Runs stmt until at least 0.2 s have passed, storing the count and the time taken
+#define TIME(reps, seconds, stmt) \
+	do { \
+		const double _start = now(); \
+		reps = 0; \
+		do { stmt; reps++; } while ((seconds = now() - _start) < 0.2); \
+	} while (0)
+
+int main(int argc, const char** argv)
+{
+	const int min_log2n = (argc > 1) ? atoi(argv[1]) : 4;
+	const int max_log2n = (argc > 2) ? atoi(argv[2]) : 20;
+	const size_t max_n = (size_t) 1 << max_log2n;
+
+	double* xr = malloc(max_n * sizeof(double));
+	double* xi = malloc(max_n * sizeof(double));
+	double* zero = calloc(max_n, sizeof(double));
+	double* yr = malloc(max_n * sizeof(double));
+	double* yi = malloc(max_n * sizeof(double));
+	double* rr = malloc(max_n * sizeof(double));
+	double* ri = malloc(max_n * sizeof(double));
+	float* fr = malloc(max_n * sizeof(float));
+	float* fi = malloc(max_n * sizeof(float));
+	float* gr = malloc(max_n * sizeof(float));
+	float* gi = malloc(max_n * sizeof(float));
+	double* dr = malloc(max_n * sizeof(double));
+	double* di = malloc(max_n * sizeof(double));
+	double* er = malloc(max_n * sizeof(double));
+	double* ei = malloc(max_n * sizeof(double));
+
+	FFTSetup setup = vDSP_create_fftsetup(max_log2n, kFFTRadix2);
+	FFTSetupD setupD = vDSP_create_fftsetupD(max_log2n, kFFTRadix2);
+
+	srand(1);
+	for (size_t i = 0; i < max_n; i++)
+	{
+		// values that are exact in single precision, so the reference sees the same input
+		xr[i] = (float) (rand() / (double) RAND_MAX - 0.5);
+		xi[i] = (float) (rand() / (double) RAND_MAX - 0.5);
+	}
+
+	for (int log2n = min_log2n; log2n <= max_log2n; log2n++)
+	{
+		const size_t n = (size_t) 1 << log2n;
+		struct error e;
+		double seconds;
+		int reps;
+
+		reference_dft(xr, xi, yr, yi, log2n);
+		for (size_t i = 0; i < n; i++)
+		{
+			fr[i] = (float) xr[i];
+			fi[i] = (float) xi[i];
+			dr[i] = xr[i];
+			di[i] = xi[i];
+		}
+
+		// complex, single precision
+		{
+			DSPSplitComplex in = { fr, fi }, out = { gr, gi };
+
+			TIME(reps, seconds, vDSP_fft_zop(setup, &in, 1, &out, 1, log2n, kFFTDirection_Forward));
+			memset(&e, 0, sizeof(e));
+			for (size_t k = 0; k < n; k++)
+			{
+				accumulate(&e, gr[k], yr[k]);
+				accumulate(&e, gi[k], yi[k]);
+			}
+			report("fft_zop", log2n, 0, seconds, reps, &e);
+		}
+
+		// complex, double precision
+		{
+			DSPDoubleSplitComplex in = { dr, di }, out = { er, ei };
+
+			TIME(reps, seconds, vDSP_fft_zopD(setupD, &in, 1, &out, 1, log2n, kFFTDirection_Forward));
+			memset(&e, 0, sizeof(e));
+			for (size_t k = 0; k < n; k++)
+			{
+				accumulate(&e, er[k], yr[k]);
+				accumulate(&e, ei[k], yi[k]);
+			}
+			report("fft_zopD", log2n, 0, seconds, reps, &e);
+		}
+
+		// complex, through the DFT API
+		{
+			vDSP_DFT_Setup dft = vDSP_DFT_zop_CreateSetup(NULL, n, vDSP_DFT_FORWARD);
+
+			if (dft)
+			{
+				TIME(reps, seconds, vDSP_DFT_Execute(dft, fr, fi, gr, gi));
+				memset(&e, 0, sizeof(e));
+				for (size_t k = 0; k < n; k++)
+				{
+					accumulate(&e, gr[k], yr[k]);
+					accumulate(&e, gi[k], yi[k]);
+				}
+				report("DFT_zop", log2n, 0, seconds, reps, &e);
+				vDSP_DFT_DestroySetup(dft);
+			}
+		}
+
+		// real: the reference of the real part alone, which the packed result holds at twice the scale
+		reference_dft(xr, zero, rr, ri, log2n);
+		{
+			DSPSplitComplex packed = { gr, gi };
+
+			// even samples into realp, odd ones into imagp; the transform is in place, so every run
+			// starts from a fresh copy, and the copy is part of the time
+			for (size_t i = 0; i < n / 2; i++)
+			{
+				gr[i] = (float) xr[2 * i];
+				gi[i] = (float) xr[2 * i + 1];
+			}
+			memcpy(fr, gr, n / 2 * sizeof(float));
+			memcpy(fi, gi, n / 2 * sizeof(float));
+
+			TIME(reps, seconds,
+				memcpy(gr, fr, n / 2 * sizeof(float));
+				memcpy(gi, fi, n / 2 * sizeof(float));
+				vDSP_fft_zrip(setup, &packed, 1, log2n, kFFTDirection_Forward));
+			memset(&e, 0, sizeof(e));
+			accumulate(&e, gr[0], 2 * rr[0]);
+			accumulate(&e, gi[0], 2 * rr[n / 2]);
+			for (size_t k = 1; k < n / 2; k++)
+			{
+				accumulate(&e, gr[k], 2 * rr[k]);
+				accumulate(&e, gi[k], 2 * ri[k]);
+			}
+			report("fft_zrip", log2n, 1, seconds, reps, &e);
+		}
+
+		// DCT-II, against a direct sum at the sizes where that is affordable
+		if (log2n <= DIRECT_MAX_LOG2N)
+		{
+			vDSP_DFT_Setup dct = vDSP_DCT_CreateSetup(NULL, n, vDSP_DCT_II);
+
+			if (dct)
+			{
+				for (size_t i = 0; i < n; i++)
+					fr[i] = (float) xr[i];
+
+				TIME(reps, seconds, vDSP_DCT_Execute(dct, fr, gr));
+				memset(&e, 0, sizeof(e));
+				for (size_t k = 0; k < n; k++)
+				{
+					long double s = 0;
+					for (size_t j = 0; j < n; j++)
+						s += xr[j] * cosl(M_PI * k * (j + 0.5L) / n);
+					accumulate(&e, gr[k], (double) s);
+				}
+				report("DCT_II", log2n, 1, seconds, reps, &e);
+				vDSP_DFT_DestroySetup(dct);
+			}
+		}
+	}
+
+	vDSP_destroy_fftsetup(setup);
+	vDSP_destroy_fftsetupD(setupD);
+	return 0;
+}